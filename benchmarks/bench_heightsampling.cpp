@@ -0,0 +1,320 @@
+/*
+ Copyright (C) 2026 Wolf Alexander
+
+ This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.                                          */
+
+//Measures terrain height sampling on the same generated map data through
+//  - the MapEntry pointers of the level file (pMap[x][z]->m_Height)
+//  - the TerrainTileData records with the layout they had before the TerrainTileStore existed,
+//    the heights were stored inline between the colors, normals, UVs and vectors of the record
+//  - the TerrainTileStore
+//  bench-heightsampling [number of samples]
+
+#include "../src/models/terraintilestore.h"
+#include "../src/resources/mapentry.h"
+#include "../src/resources/levelfile.h"
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <vector>
+
+//each access pattern is run this often,
+//the fastest run is taken
+#define BENCH_NRRUNS 10
+
+#define BENCH_DEF_NRSAMPLES 4000000
+
+//the TerrainTileData record before the vertex heights, the averaged tile height
+//and the dirty flags were moved into the TerrainTileStore
+struct OldTerrainTileData {
+    irr::video::S3DVertex *vert1 = nullptr;
+    irr::video::S3DVertex *vert2 = nullptr;
+    irr::video::S3DVertex *vert3 = nullptr;
+    irr::video::S3DVertex *vert4 = nullptr;
+
+    irr::video::SColor vert1Color;
+    irr::video::SColor vert2Color;
+    irr::video::SColor vert3Color;
+    irr::video::SColor vert4Color;
+
+    irr::video::SColor vert1ColorInitial;
+    irr::video::SColor vert2ColorInitial;
+    irr::video::SColor vert3ColorInitial;
+    irr::video::SColor vert4ColorInitial;
+
+    std::vector<irr::u32> myMeshBufVertexId1;
+
+    irr::f32 vert1CurrPositionY = 0.0f;
+    irr::f32 vert2CurrPositionY = 0.0f;
+    irr::f32 vert3CurrPositionY = 0.0f;
+    irr::f32 vert4CurrPositionY = 0.0f;
+
+    bool vert1CurrPositionYDirty = false;
+    bool vert2CurrPositionYDirty = false;
+    bool vert3CurrPositionYDirty = false;
+    bool vert4CurrPositionYDirty = false;
+
+    irr::core::vector3d<irr::f32> vert1CurrNormal;
+    irr::core::vector3d<irr::f32> vert2CurrNormal;
+    irr::core::vector3d<irr::f32> vert3CurrNormal;
+    irr::core::vector3d<irr::f32> vert4CurrNormal;
+
+    bool RefreshNormals = false;
+
+    irr::core::vector2d<irr::f32> vert1UVcoord;
+    irr::core::vector2d<irr::f32> vert2UVcoord;
+    irr::core::vector2d<irr::f32> vert3UVcoord;
+    irr::core::vector2d<irr::f32> vert4UVcoord;
+
+    bool VertUpdatedUVScoord = false;
+
+    float m_optimization_cnt = 0.0f;
+    bool m_draw_in_mesh = true;
+    bool dynamicMesh = false;
+
+    std::vector<irr::scene::SMeshBuffer*> myMeshBuffers;
+
+    irr::f32 currTileHeight = 0.0f;
+};
+
+//the same arrays the game uses, static because they
+//are too large for the stack
+static OldTerrainTileData oldTiles[LEVELFILE_WIDTH][LEVELFILE_HEIGHT];
+static MapEntry* pMap[LEVELFILE_WIDTH][LEVELFILE_HEIGHT];
+
+//simple deterministic random numbers, so that
+//all runs read exactly the same tiles
+static uint32_t rndState = 0x12345678;
+
+uint32_t NextRandom() {
+    rndState = rndState * 1664525 + 1013904223;
+    return (rndState >> 8);
+}
+
+//creates the map entries (stored the same way as in LevelFile), the old
+//records and the TerrainTileStore from the same generated level file bytes
+void CreateMap(std::vector<MapEntry>& mapEntryVec, TerrainTileStore& store) {
+    std::vector<ColumnDefinition*> noColumns;
+    uint8_t bytes[MAPENTRY_SIZE_BYTES] = {};
+
+    mapEntryVec.reserve(LEVELFILE_WIDTH * LEVELFILE_HEIGHT);
+
+    for (int z = 0; z < LEVELFILE_HEIGHT; z++) {
+        for (int x = 0; x < LEVELFILE_WIDTH; x++) {
+            //hills with some noise, no columns
+            bytes[2] = (uint8_t)(NextRandom());
+            bytes[3] = (uint8_t)(((x / 8) + (z / 5)) % 12 + (NextRandom() % 2));
+
+            mapEntryVec.emplace_back(x, z, 0, bytes, noColumns);
+            pMap[x][z] = &mapEntryVec.back();
+        }
+    }
+
+    //the vertices are at the tile corners, the game uses negative heights
+    for (int x = 0; x < LEVELFILE_WIDTH; x++) {
+        for (int z = 0; z < LEVELFILE_HEIGHT; z++) {
+            int xPlusOne = (x + 1) % LEVELFILE_WIDTH;
+            int zPlusOne = (z + 1) % LEVELFILE_HEIGHT;
+
+            irr::f32 vertHeight[4] = {-pMap[x][z]->m_Height, -pMap[xPlusOne][z]->m_Height,
+                                     -pMap[xPlusOne][zPlusOne]->m_Height, -pMap[x][zPlusOne]->m_Height};
+
+            OldTerrainTileData& tile = oldTiles[x][z];
+            tile.vert1CurrPositionY = vertHeight[0];
+            tile.vert2CurrPositionY = vertHeight[1];
+            tile.vert3CurrPositionY = vertHeight[2];
+            tile.vert4CurrPositionY = vertHeight[3];
+            tile.currTileHeight = pMap[x][z]->m_Height;
+
+            for (irr::u8 vertex = 1; vertex <= 4; vertex++) {
+                store.SetVertexHeight(x, z, vertex, vertHeight[vertex - 1]);
+            }
+
+            store.SetTileHeight(x, z, pMap[x][z]->m_Height);
+        }
+    }
+}
+
+//one height query, the same as the callers in physics, computer players and
+//world awareness: either the averaged tile height, or the vertex heights of a
+//tile and the first vertex of the 3 neighbors for the interpolation
+#define BENCH_ACCESS_TILEHEIGHT 0
+#define BENCH_ACCESS_INTERPOLATE 1
+
+irr::f32 SampleMapEntry(const std::vector<irr::s32>& sampleX, const std::vector<irr::s32>& sampleZ, irr::u8 access) {
+    irr::f32 sum = 0.0f;
+    size_t nrSamples = sampleX.size();
+
+    for (size_t idx = 0; idx < nrSamples; idx++) {
+        irr::s32 x = sampleX[idx];
+        irr::s32 z = sampleZ[idx];
+
+        if (access == BENCH_ACCESS_TILEHEIGHT) {
+            sum += pMap[x][z]->m_Height;
+        } else {
+            irr::s32 xPlusOne = (x + 1) % LEVELFILE_WIDTH;
+            irr::s32 zPlusOne = (z + 1) % LEVELFILE_HEIGHT;
+            irr::s32 xPlusTwo = (x + 2) % LEVELFILE_WIDTH;
+            irr::s32 zPlusTwo = (z + 2) % LEVELFILE_HEIGHT;
+
+            sum -= pMap[x][z]->m_Height + pMap[xPlusOne][z]->m_Height + pMap[xPlusOne][zPlusOne]->m_Height +
+                   pMap[x][zPlusOne]->m_Height + pMap[xPlusTwo][z]->m_Height + pMap[xPlusTwo][zPlusTwo]->m_Height +
+                   pMap[x][zPlusTwo]->m_Height;
+        }
+    }
+
+    return sum;
+}
+
+irr::f32 SampleOldTiles(const std::vector<irr::s32>& sampleX, const std::vector<irr::s32>& sampleZ, irr::u8 access) {
+    irr::f32 sum = 0.0f;
+    size_t nrSamples = sampleX.size();
+
+    for (size_t idx = 0; idx < nrSamples; idx++) {
+        irr::s32 x = sampleX[idx];
+        irr::s32 z = sampleZ[idx];
+
+        if (access == BENCH_ACCESS_TILEHEIGHT) {
+            sum += oldTiles[x][z].currTileHeight;
+        } else {
+            irr::s32 xPlusOne = (x + 1) % LEVELFILE_WIDTH;
+            irr::s32 zPlusOne = (z + 1) % LEVELFILE_HEIGHT;
+
+            const OldTerrainTileData& tile = oldTiles[x][z];
+
+            sum += tile.vert1CurrPositionY + tile.vert2CurrPositionY + tile.vert3CurrPositionY + tile.vert4CurrPositionY +
+                   oldTiles[xPlusOne][z].vert2CurrPositionY + oldTiles[xPlusOne][zPlusOne].vert3CurrPositionY +
+                   oldTiles[x][zPlusOne].vert4CurrPositionY;
+        }
+    }
+
+    return sum;
+}
+
+irr::f32 SampleStore(TerrainTileStore& store, const std::vector<irr::s32>& sampleX, const std::vector<irr::s32>& sampleZ,
+                     irr::u8 access) {
+    irr::f32 sum = 0.0f;
+    size_t nrSamples = sampleX.size();
+
+    for (size_t idx = 0; idx < nrSamples; idx++) {
+        irr::s32 x = sampleX[idx];
+        irr::s32 z = sampleZ[idx];
+
+        if (access == BENCH_ACCESS_TILEHEIGHT) {
+            sum += store.GetTileHeight(x, z);
+        } else {
+            irr::s32 xPlusOne = (x + 1) % LEVELFILE_WIDTH;
+            irr::s32 zPlusOne = (z + 1) % LEVELFILE_HEIGHT;
+
+            const irr::f32* vertHeight = store.GetVertexHeights(x, z);
+
+            sum += vertHeight[0] + vertHeight[1] + vertHeight[2] + vertHeight[3] +
+                   store.GetVertexHeight(xPlusOne, z, 2) + store.GetVertexHeight(xPlusOne, zPlusOne, 3) +
+                   store.GetVertexHeight(x, zPlusOne, 4);
+        }
+    }
+
+    return sum;
+}
+
+//returns the fastest run in ns per sample, and the checksum of the heights
+template <typename Func>
+double Measure(Func sample, size_t nrSamples, irr::f32& checksum) {
+    double best = 1e9;
+
+    for (uint32_t run = 0; run < BENCH_NRRUNS; run++) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        checksum = sample();
+
+        std::chrono::duration<double, std::nano> duration = std::chrono::steady_clock::now() - start;
+
+        if (duration.count() < best)
+            best = duration.count();
+    }
+
+    return best / (double)(nrSamples);
+}
+
+//returns false if the old records and the
+//store do not return the same heights
+bool BenchmarkAccess(const char* name, TerrainTileStore& store, const std::vector<irr::s32>& sampleX,
+                     const std::vector<irr::s32>& sampleZ, irr::u8 access) {
+    size_t nrSamples = sampleX.size();
+    irr::f32 sumMapEntry;
+    irr::f32 sumOld;
+    irr::f32 sumStore;
+
+    double nsMapEntry = Measure([&]() { return SampleMapEntry(sampleX, sampleZ, access); }, nrSamples, sumMapEntry);
+    double nsOld = Measure([&]() { return SampleOldTiles(sampleX, sampleZ, access); }, nrSamples, sumOld);
+    double nsStore = Measure([&]() { return SampleStore(store, sampleX, sampleZ, access); }, nrSamples, sumStore);
+
+    printf("%-28s MapEntry %6.2lf ns  old TerrainTileData %6.2lf ns  TerrainTileStore %6.2lf ns  (per sample, checksums %.1f %.1f %.1f)\n",
+           name, nsMapEntry, nsOld, nsStore, sumMapEntry, sumOld, sumStore);
+
+    return (sumOld == sumStore);
+}
+
+int main(int argc, char** argv) {
+    size_t nrSamples = BENCH_DEF_NRSAMPLES;
+
+    if (argc > 1) {
+        nrSamples = (size_t)(atol(argv[1]));
+
+        if (nrSamples == 0) {
+            printf("usage: bench-heightsampling [number of samples]\n");
+            return 1;
+        }
+    }
+
+    std::vector<MapEntry> mapEntryVec;
+    TerrainTileStore* store = new TerrainTileStore(LEVELFILE_WIDTH, LEVELFILE_HEIGHT);
+
+    CreateMap(mapEntryVec, *store);
+
+    printf("TerrainTileData record before: %zu bytes, TerrainTileStore: %zu bytes per tile\n",
+           sizeof(OldTerrainTileData), 5 * sizeof(irr::f32) + sizeof(irr::u8));
+
+    //random tiles all over the map, like the queries of the computer players and missiles
+    std::vector<irr::s32> sampleX(nrSamples);
+    std::vector<irr::s32> sampleZ(nrSamples);
+
+    for (size_t idx = 0; idx < nrSamples; idx++) {
+        sampleX[idx] = (irr::s32)(NextRandom() % LEVELFILE_WIDTH);
+        sampleZ[idx] = (irr::s32)(NextRandom() % LEVELFILE_HEIGHT);
+    }
+
+    bool ok = BenchmarkAccess("random tile height", *store, sampleX, sampleZ, BENCH_ACCESS_TILEHEIGHT);
+    ok &= BenchmarkAccess("random interpolation", *store, sampleX, sampleZ, BENCH_ACCESS_INTERPOLATE);
+
+    //tiles close to each other, like the height map collision of a craft
+    //that reads the tiles around it while it moves over the map
+    irr::s32 x = LEVELFILE_WIDTH / 2;
+    irr::s32 z = LEVELFILE_HEIGHT / 2;
+
+    for (size_t idx = 0; idx < nrSamples; idx++) {
+        if ((idx % 16) == 0) {
+            x = (x + LEVELFILE_WIDTH + (irr::s32)(NextRandom() % 3) - 1) % LEVELFILE_WIDTH;
+            z = (z + LEVELFILE_HEIGHT + (irr::s32)(NextRandom() % 3) - 1) % LEVELFILE_HEIGHT;
+        }
+
+        sampleX[idx] = (x + (irr::s32)(NextRandom() % 5)) % LEVELFILE_WIDTH;
+        sampleZ[idx] = (z + (irr::s32)(NextRandom() % 5)) % LEVELFILE_HEIGHT;
+    }
+
+    ok &= BenchmarkAccess("local tile height", *store, sampleX, sampleZ, BENCH_ACCESS_TILEHEIGHT);
+    ok &= BenchmarkAccess("local interpolation", *store, sampleX, sampleZ, BENCH_ACCESS_INTERPOLATE);
+
+    delete store;
+
+    if (!ok) {
+        printf("old TerrainTileData records and TerrainTileStore returned different heights\n");
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,145 @@
+/*
+ Copyright (C) 2026 Wolf Alexander
+
+ This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.                                          */
+
+//Measures the unpack speed of RncDecoder and of the decoder in dernc.cpp
+//  bench-rncdecoder [RNC packed file] ...
+//Without files (for example the packed files of the original game) generated data is packed first
+
+#include "../src/resources/readgamedata/rncdecoder.h"
+#include "../src/resources/readgamedata/dernc.h"
+#include "../tests/rncpack.h"
+#include <cstdio>
+#include <cstring>
+#include <chrono>
+#include <string>
+#include <algorithm>
+
+//each decoder unpacks the data this often, the
+//fastest run is taken
+#define BENCH_NRRUNS 20
+
+//unpacks with the decoder in dernc.cpp; The copy of the input buffer is part of using
+//the reference decoder, as it needs 8 additional bytes behind the data
+long ReferenceUnpack(const std::vector<unsigned char>& packed, std::vector<unsigned char>& unpacked) {
+    std::vector<unsigned char> packedCopy(packed);
+    packedCopy.resize(packed.size() + 8, 0);
+
+    unpacked.assign(rnc_ulen(packedCopy.data()) + 8, 0);
+
+    return rnc_unpack(packedCopy.data(), unpacked.data(), 0, nullptr);
+}
+
+double MeasureRun(bool reference, const std::vector<unsigned char>& packed, std::vector<unsigned char>& unpacked) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    long result = reference ? ReferenceUnpack(packed, unpacked) : RncDecoder::Unpack(packed.data(), packed.size(), unpacked);
+
+    std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+
+    if (result < 0)
+        return -1.0;
+
+    return duration.count();
+}
+
+//returns false if one of the decoders failed
+bool BenchmarkData(const char* name, const std::vector<unsigned char>& packed) {
+    long unpackedLen = RncDecoder::GetUnpackedLength(packed.data(), packed.size());
+
+    if (unpackedLen <= 0) {
+        printf("%s: not RNC packed, or empty\n", name);
+        return true;
+    }
+
+    std::vector<unsigned char> unpacked;
+    double best = 1e9;
+    double refBest = 1e9;
+
+    for (uint32_t run = 0; run < BENCH_NRRUNS; run++) {
+        double duration = MeasureRun(false, packed, unpacked);
+        double refDuration = MeasureRun(true, packed, unpacked);
+
+        if ((duration < 0.0) || (refDuration < 0.0)) {
+            printf("%s: unpacking failed\n", name);
+            return false;
+        }
+
+        if (duration < best)
+            best = duration;
+
+        if (refDuration < refBest)
+            refBest = refDuration;
+    }
+
+    double megaBytes = (double)(unpackedLen) / (1024.0 * 1024.0);
+
+    printf("%-32s %9ld bytes  RncDecoder %8.1lf MB/s  dernc %8.1lf MB/s  speedup %5.2lf\n", name, unpackedLen,
+           megaBytes / std::max(best, 1e-9), megaBytes / std::max(refBest, 1e-9), refBest / std::max(best, 1e-9));
+
+    return true;
+}
+
+std::vector<unsigned char> LoadFile(const char* fileName) {
+    std::vector<unsigned char> data;
+    FILE* file = fopen(fileName, "rb");
+
+    if (file == nullptr)
+        return data;
+
+    unsigned char buffer[65536];
+    size_t nrRead;
+
+    while ((nrRead = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        data.insert(data.end(), buffer, buffer + nrRead);
+    }
+
+    fclose(file);
+    return data;
+}
+
+int main(int argc, char** argv) {
+    bool ok = true;
+
+    if (argc > 1) {
+        for (int idx = 1; idx < argc; idx++) {
+            std::vector<unsigned char> packed = LoadFile(argv[idx]);
+
+            if (packed.empty()) {
+                printf("%s: could not be read\n", argv[idx]);
+                ok = false;
+                continue;
+            }
+
+            ok &= BenchmarkData(argv[idx], packed);
+        }
+
+        return ok ? 0 : 1;
+    }
+
+    //image like data, similar to the textures and sprites of the game
+    std::vector<unsigned char> imageData;
+    uint32_t rndState = 0x2545F491;
+    for (uint32_t idx = 0; idx < 1024 * 1024; idx++) {
+        rndState = rndState * 1664525 + 1013904223;
+        imageData.push_back((unsigned char)(((idx % 256) / 8) + ((rndState >> 24) % 4)));
+    }
+
+    ok &= BenchmarkData("generated image data", RncPack(imageData));
+
+    //text with a lot of long matches
+    const char* text = "The quick hover craft races through the level, and collects all the ammo. ";
+    std::vector<unsigned char> textData;
+    while (textData.size() < 1024 * 1024) {
+        textData.insert(textData.end(), text, text + strlen(text));
+    }
+
+    ok &= BenchmarkData("generated text", RncPack(textData));
+
+    return ok ? 0 : 1;
+}
@@ -14,6 +14,7 @@
 #include "ail/format_wohlstand_opl3.h"
 #include "ail/format_ail2_gtl.h"
 #include "../utils/fileutils.h"
+#include <cstring>
 
 bool MyMusicStream::getInitOk() {
     return mInitOk;
@@ -165,7 +166,6 @@ MyMusicStream::MyMusicStream(Game* gamePnter, unsigned int sampleRate) {
     mSampleRate = sampleRate;
 
     //allocate buffer
-    buffer = new uint8_t[MUSIC_BUFSIZE];
     sfBuffer = new int16_t[MUSIC_BUFSIZE / 2];
 
     //configure SFML audio output settings
@@ -180,51 +180,18 @@ MyMusicStream::MyMusicStream(Game* gamePnter, unsigned int sampleRate) {
     this->setDirectionalAttenuationFactor(0.0f);
     this->setSpatializationEnabled(false);
 
-    /* Initialize ADLMIDI */
-    midi_player = adl_init(mSampleRate);
+    //ADLMIDI renders the music on its own thread, with the
+    //Dosbox OPL3 emulator and endless looping of the game music
+    mSynth = new MusicSynth(mSampleRate);
 
-    if (!midi_player)
-    {
-        std::string errMsg("Couldn't initialize ADLMIDI: ");
-        errMsg.append(adl_errorString());
-        //fprintf(stderr, "Couldn't initialize ADLMIDI: %s\n", adl_errorString());
+    std::string errMsg("");
+    if (!mSynth->Init(MUSIC_INSTRFILE_PATH, errMsg)) {
         logging::Error(errMsg);
         mInitOk = false;
         return;
     }
 
-    //select OPL emulator
-
-    //adl_switchEmulator(midi_player, ADLMIDI_EMU_NUKED);  NUKED emulator gives best emu quality according to i-net,
-                                                           //but takes 10% CPU load on my computer
-    adl_switchEmulator(midi_player, ADLMIDI_EMU_DOSBOX);   //Dosbox emu takes 1% on my computer, and I can not hear
-                                                           //much difference => take as default right now
-
-    //configure the audio format we want to get from ADLMIDI
-    s_audioFormat.type = ADLMIDI_SampleType_S16;
-    s_audioFormat.containerSize = sizeof(int16_t);
-    s_audioFormat.sampleOffset = sizeof(int16_t) * 2;
-
-    /* Optionally Setup ADLMIDI as you want */
-
-    //enable endless looping of game music
-
-    //loopEn 0 - disabled, 1 - enabled
-    adl_setLoopEnabled(midi_player, 1);
-
-    //I would also like to activate the next line, but
-    //the problem is my linked does not find adl_setLoopCount, even
-    //though it is mentioned in the header file
-    //the good thing is the default value seems to be already
-    //loop infinitely :)
-    //so keep the next line commented out right now
-    //loopCount Number of loops or -1 to loop infinitely
-    //adl_setLoopCount(midi_player, -1);
-
-    /* Set using of custom bank (WOPL format) loaded from a file */
-    //if we do not setup the OPL instruments correctly
-    //the player music will sound completely wrong
-    adl_openBankFile(midi_player, (char*)(MUSIC_INSTRFILE_PATH));
+    mSynth->Start();
 
     mInitOk = true;
 }
@@ -232,13 +199,13 @@ MyMusicStream::MyMusicStream(Game* gamePnter, unsigned int sampleRate) {
 //loads an original game XMID file (extended midi file)
 //returns true in case of success, false otherwise
 bool MyMusicStream::loadGameMusicFile(const char* fileName) {
+    if (!mInitOk)
+        return false;
+
     /* Open the MIDI (or MUS, IMF or CMF) file to play */
-    if (adl_openFile(midi_player, fileName) < 0)
+    std::string errMsg("");
+    if (!mSynth->LoadFile(fileName, errMsg))
         {
-            std::string errMsg("Couldn't open music file ");
-            errMsg.append(fileName);
-            errMsg.append(" :");
-            errMsg.append(adl_errorInfo(midi_player));
             logging::Error(errMsg);
 
             this->mMusicLoaded = false;
@@ -293,37 +260,29 @@ MyMusicStream::~MyMusicStream() {
         this->StopPlay();
     }
 
-    adl_close(midi_player);
+    //the stream does not read samples anymore,
+    //we can stop the synth thread now
+    delete mSynth;
 
-    //delete midi_player;
-    //delete sfBuffer;
-    //delete buffer;
+    delete[] sfBuffer;
 }
 
 bool MyMusicStream::onGetData(Chunk& data)
 {
-    struct ADL_MIDIPlayer* p = (struct ADL_MIDIPlayer*)midi_player;
-
-    /* Convert bytes length into total count of samples in all channels */
-    int samples_count = MUSIC_BUFSIZE / s_audioFormat.containerSize;
-
-    /* Take some samples from the ADLMIDI */
-    samples_count = adl_playFormat(p, samples_count,
-                                   buffer,
-                                   buffer + s_audioFormat.containerSize,
-                                   &s_audioFormat);
-
-    if(samples_count <= 0) {
-       //no more samples to play, stop playing
-       return false;
-    }
-
-    int idxSource = 0;
+    //the samples are already rendered by the
+    //synth thread, we only need to copy them
+    uint32_t samples_count = mSynth->ReadSamples(sfBuffer, MUSIC_BUFSIZE / 2);
+
+    if (samples_count == 0) {
+        if (mSynth->HasEnded()) {
+           //no more samples to play, stop playing
+           return false;
+        }
 
-    //convert from one buffer to the other
-    for (int idx = 0; idx < samples_count; idx++) {
-        sfBuffer[idx] = int16_t(buffer[idxSource]) + (((int16_t)(buffer[idxSource + 1])) << 8);
-        idxSource += 2;
+        //the synth thread is behind, play a short silence
+        //instead of stopping the music stream
+        memset(sfBuffer, 0, MUSIC_UNDERRUN_SAMPLES * sizeof(int16_t));
+        samples_count = MUSIC_UNDERRUN_SAMPLES;
     }
 
     /* Send buffer to the audio device */
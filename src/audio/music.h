@@ -11,10 +11,15 @@
 #define MUSIC_H
 
 #include "SFML/Audio.hpp"
-#include "adlmidi.h"
+#include "musicsynth.h"
 #include <cstdint>
 
 #define MUSIC_BUFSIZE 8192
+
+//number of silent samples the stream gets if the
+//synth thread could not deliver music in time
+#define MUSIC_UNDERRUN_SAMPLES 1024
+
 #define MUSIC_INSTRFILE_PATH "extract/InstrOPL.wopl"
 
 /************************
@@ -49,14 +54,11 @@ private:
     //pointer to game
     Game* mGame = nullptr;
 
-    //Its kind of dirty that we used two buffers
-    //but leave it like this right now
-    uint8_t *buffer = nullptr; /* Audio buffer */
+    //the music is rendered by ADLMIDI on the synth thread, the
+    //stream callback only copies the samples into sfBuffer
+    MusicSynth* mSynth = nullptr;
     int16_t *sfBuffer = nullptr;
 
-    struct ADL_MIDIPlayer *midi_player = nullptr;
-    struct ADLMIDI_AudioFormat s_audioFormat;
-
     uint32_t mSampleRate;
 
     bool mMusicLoaded = false;
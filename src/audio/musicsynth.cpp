@@ -0,0 +1,294 @@
+/*
+ Copyright (C) 2026 Wolf Alexander
+
+ This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.                                          */
+
+#include "musicsynth.h"
+#include <cstring>
+#include <chrono>
+
+MusicRingBuffer::MusicRingBuffer() {
+    mBuffer.resize(MUSICSYNTH_RINGBUFFER_SAMPLES, 0);
+}
+
+uint32_t MusicRingBuffer::GetFreeSamples() {
+    //discarded samples only become free after the consumer skipped them (and stored the new
+    //read position); before that a Read that is running right now could still copy them
+    uint64_t used = mWritePos.load(std::memory_order_relaxed) - mReadPos.load(std::memory_order_acquire);
+
+    return (uint32_t)(MUSICSYNTH_RINGBUFFER_SAMPLES - used);
+}
+
+void MusicRingBuffer::Write(const int16_t* src, uint32_t nrSamples) {
+    uint64_t writePos = mWritePos.load(std::memory_order_relaxed);
+    uint32_t idx = (uint32_t)(writePos & (MUSICSYNTH_RINGBUFFER_SAMPLES - 1));
+
+    //copy in two parts if we reach the end of the buffer
+    uint32_t firstPart = MUSICSYNTH_RINGBUFFER_SAMPLES - idx;
+    if (firstPart > nrSamples)
+        firstPart = nrSamples;
+
+    memcpy(&mBuffer[idx], src, firstPart * sizeof(int16_t));
+    memcpy(&mBuffer[0], src + firstPart, (nrSamples - firstPart) * sizeof(int16_t));
+
+    mWritePos.store(writePos + nrSamples, std::memory_order_release);
+}
+
+void MusicRingBuffer::DiscardWritten() {
+    mDiscardPos.store(mWritePos.load(std::memory_order_relaxed), std::memory_order_release);
+}
+
+uint32_t MusicRingBuffer::Read(int16_t* dest, uint32_t nrSamples) {
+    uint64_t readPos = mReadPos.load(std::memory_order_relaxed);
+
+    //the discard position must be read before the write position,
+    //because samples after it could already be written
+    uint64_t discardPos = mDiscardPos.load(std::memory_order_acquire);
+    if (discardPos > readPos)
+        readPos = discardPos;
+
+    uint64_t available = mWritePos.load(std::memory_order_acquire) - readPos;
+    if (available < nrSamples)
+        nrSamples = (uint32_t)(available);
+
+    uint32_t idx = (uint32_t)(readPos & (MUSICSYNTH_RINGBUFFER_SAMPLES - 1));
+
+    uint32_t firstPart = MUSICSYNTH_RINGBUFFER_SAMPLES - idx;
+    if (firstPart > nrSamples)
+        firstPart = nrSamples;
+
+    memcpy(dest, &mBuffer[idx], firstPart * sizeof(int16_t));
+    memcpy(dest + firstPart, &mBuffer[0], (nrSamples - firstPart) * sizeof(int16_t));
+
+    //also stored if nothing was copied, this way the producer
+    //knows that the discarded samples were skipped
+    mReadPos.store(readPos + nrSamples, std::memory_order_release);
+
+    return nrSamples;
+}
+
+uint32_t MusicRingBuffer::GetAvailableSamples() {
+    uint64_t readPos = mReadPos.load(std::memory_order_relaxed);
+    uint64_t discardPos = mDiscardPos.load(std::memory_order_acquire);
+    if (discardPos > readPos)
+        readPos = discardPos;
+
+    return (uint32_t)(mWritePos.load(std::memory_order_acquire) - readPos);
+}
+
+MusicSynth::MusicSynth(uint32_t sampleRate) {
+    mSampleRate = sampleRate;
+    mRenderBuffer.resize(MUSICSYNTH_RENDER_SAMPLES, 0);
+}
+
+MusicSynth::~MusicSynth() {
+    Stop();
+
+    if (mMidiPlayer != nullptr) {
+        adl_close(mMidiPlayer);
+    }
+}
+
+struct ADL_MIDIPlayer* MusicSynth::CreatePlayer(uint32_t sampleRate, const char* bankFile,
+                                                struct ADLMIDI_AudioFormat& audioFormat, std::string& errorMsg) {
+    struct ADL_MIDIPlayer* player = adl_init(sampleRate);
+
+    if (player == nullptr) {
+        errorMsg.assign("Couldn't initialize ADLMIDI: ");
+        errorMsg.append(adl_errorString());
+        return nullptr;
+    }
+
+    //Dosbox emu takes 1% CPU on my computer, the NUKED emulator has
+    //a better quality, but takes 10% => take Dosbox as default
+    adl_switchEmulator(player, ADLMIDI_EMU_DOSBOX);
+
+    //we want interleaved 16 bit stereo samples, the same
+    //format the SFML music stream needs
+    audioFormat.type = ADLMIDI_SampleType_S16;
+    audioFormat.containerSize = sizeof(int16_t);
+    audioFormat.sampleOffset = sizeof(int16_t) * 2;
+
+    //enable endless looping of game music
+    adl_setLoopEnabled(player, 1);
+
+    //if we do not setup the OPL instruments correctly
+    //the player music will sound completely wrong
+    if (adl_openBankFile(player, bankFile) < 0) {
+        errorMsg.assign("Couldn't open OPL3 instrument file ");
+        errorMsg.append(bankFile);
+        errorMsg.append(" :");
+        errorMsg.append(adl_errorInfo(player));
+        adl_close(player);
+        return nullptr;
+    }
+
+    return player;
+}
+
+bool MusicSynth::Init(const char* bankFile, std::string& errorMsg) {
+    mMidiPlayer = CreatePlayer(mSampleRate, bankFile, mAudioFormat, errorMsg);
+
+    return (mMidiPlayer != nullptr);
+}
+
+void MusicSynth::Start() {
+    if ((mMidiPlayer == nullptr) || mWorker.joinable())
+        return;
+
+    mWorker = std::thread(&MusicSynth::WorkerThread, this);
+}
+
+void MusicSynth::Stop() {
+    if (!mWorker.joinable())
+        return;
+
+    std::shared_ptr<MusicSynthMsgStruct> msg = std::make_shared<MusicSynthMsgStruct>();
+    msg->type = MUSICSYNTH_MSG_QUIT;
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mMsgList.push_back(msg);
+    }
+
+    mMsgCondition.notify_one();
+    mWorker.join();
+}
+
+bool MusicSynth::LoadFile(const char* fileName, std::string& errorMsg) {
+    if (!mWorker.joinable()) {
+        errorMsg.assign("Music synth thread is not running");
+        return false;
+    }
+
+    std::shared_ptr<MusicSynthMsgStruct> msg = std::make_shared<MusicSynthMsgStruct>();
+    msg->type = MUSICSYNTH_MSG_LOADFILE;
+    msg->fileName.assign(fileName);
+
+    std::future<bool> result = msg->done.get_future();
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mMsgList.push_back(msg);
+    }
+
+    mMsgCondition.notify_one();
+
+    bool loadOk = result.get();
+    if (!loadOk) {
+        errorMsg = msg->errorMsg;
+    }
+
+    return loadOk;
+}
+
+uint32_t MusicSynth::ReadSamples(int16_t* dest, uint32_t nrSamples) {
+    return mRingBuffer.Read(dest, nrSamples);
+}
+
+bool MusicSynth::HasEnded() {
+    return (mEnded.load() && (mRingBuffer.GetAvailableSamples() == 0));
+}
+
+bool MusicSynth::RenderNextSamples() {
+    if (!mFileLoaded || mEnded.load())
+        return false;
+
+    if (mRingBuffer.GetFreeSamples() < MUSICSYNTH_RENDER_SAMPLES)
+        return false;
+
+    //ADLMIDI writes the interleaved samples directly
+    //in the native 16 bit format
+    ADL_UInt8* left = (ADL_UInt8*)(mRenderBuffer.data());
+    int nrSamples = adl_playFormat(mMidiPlayer, MUSICSYNTH_RENDER_SAMPLES,
+                                   left, left + mAudioFormat.containerSize, &mAudioFormat);
+
+    if (nrSamples <= 0) {
+        //no more samples to play
+        mEnded.store(true);
+        return false;
+    }
+
+    mRingBuffer.Write(mRenderBuffer.data(), (uint32_t)(nrSamples));
+
+    return true;
+}
+
+bool MusicSynth::ProcessMessage(MusicSynthMsgStruct& msg) {
+    if (msg.type == MUSICSYNTH_MSG_QUIT) {
+        msg.done.set_value(true);
+        return false;
+    }
+
+    if (msg.type == MUSICSYNTH_MSG_LOADFILE) {
+        //the samples of the last music file
+        //should not be played anymore
+        mRingBuffer.DiscardWritten();
+        mEnded.store(false);
+
+        if (adl_openFile(mMidiPlayer, msg.fileName.c_str()) < 0) {
+            msg.errorMsg.assign("Couldn't open music file ");
+            msg.errorMsg.append(msg.fileName);
+            msg.errorMsg.append(" :");
+            msg.errorMsg.append(adl_errorInfo(mMidiPlayer));
+
+            mFileLoaded = false;
+            msg.done.set_value(false);
+            return true;
+        }
+
+        mFileLoaded = true;
+
+        //fill the free part of the ring buffer before we return, so that the music
+        //starts without a gap; the space of the discarded samples is only filled
+        //after the audio callback skipped them
+        while (RenderNextSamples()) {
+        }
+
+        msg.done.set_value(true);
+    }
+
+    return true;
+}
+
+void MusicSynth::WorkerThread() {
+    while (true) {
+        std::shared_ptr<MusicSynthMsgStruct> msg = nullptr;
+
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+
+            if (mMsgList.empty()) {
+                //nothing to render right now? then wait for a message, otherwise only
+                //wait a short time until the audio callback has read some samples
+                if (!mFileLoaded || mEnded.load()) {
+                    mMsgCondition.wait(lock, [this]() {
+                        return !mMsgList.empty();
+                    });
+                } else if (mRingBuffer.GetFreeSamples() < MUSICSYNTH_RENDER_SAMPLES) {
+                    mMsgCondition.wait_for(lock, std::chrono::milliseconds(MUSICSYNTH_POLL_MS), [this]() {
+                        return !mMsgList.empty();
+                    });
+                }
+            }
+
+            if (!mMsgList.empty()) {
+                msg = mMsgList.front();
+                mMsgList.pop_front();
+            }
+        }
+
+        if (msg != nullptr) {
+            if (!ProcessMessage(*msg))
+                return;
+
+            continue;
+        }
+
+        RenderNextSamples();
+    }
+}
@@ -0,0 +1,157 @@
+/*
+ Copyright (C) 2026 Wolf Alexander
+
+ This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.                                          */
+
+#ifndef MUSICSYNTH_H
+#define MUSICSYNTH_H
+
+#include "adlmidi.h"
+#include <cstdint>
+#include <vector>
+#include <list>
+#include <string>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <future>
+
+//number of samples (all channels) ADLMIDI renders with one
+//call, the same amount the music stream used to request
+#define MUSICSYNTH_RENDER_SAMPLES 4096
+
+//size of the PCM ring buffer in samples (all channels), must be a
+//power of 2; 32768 samples are around 370ms stereo music at 44100 Hz
+#define MUSICSYNTH_RINGBUFFER_SAMPLES 32768
+
+//how long the synth thread sleeps if the ring buffer is full
+#define MUSICSYNTH_POLL_MS 5
+
+//messages for the synth thread
+#define MUSICSYNTH_MSG_LOADFILE 0
+#define MUSICSYNTH_MSG_QUIT 1
+
+//Single producer, single consumer ring buffer for 16 bit PCM samples. The read and write positions
+//only increase, the ring buffer index is the position modulo the buffer size; This way no lock is
+//needed, the producer only changes mWritePos and mDiscardPos, the consumer only changes mReadPos.
+//Discarded samples are skipped by the consumer, and their space is only reused by the producer
+//after the consumer acknowledged this with its new read position
+class MusicRingBuffer {
+public:
+    MusicRingBuffer();
+
+    //producer side: number of samples that can be written right now, discarded
+    //samples count as free space only after the consumer skipped them
+    uint32_t GetFreeSamples();
+
+    //producer side: writes nrSamples, the caller must make sure
+    //that there is enough free space
+    void Write(const int16_t* src, uint32_t nrSamples);
+
+    //producer side: all samples written until now are skipped by
+    //the consumer, used when a new music file is started
+    void DiscardWritten();
+
+    //consumer side: skips discarded samples, copies up to nrSamples
+    //into dest, and returns the number of copied samples
+    uint32_t Read(int16_t* dest, uint32_t nrSamples);
+
+    //consumer side: number of samples that can be read right now
+    uint32_t GetAvailableSamples();
+
+private:
+    std::vector<int16_t> mBuffer;
+
+    std::atomic<uint64_t> mWritePos{0};
+    std::atomic<uint64_t> mReadPos{0};
+
+    //the consumer continues reading at this position
+    //if it is still behind it
+    std::atomic<uint64_t> mDiscardPos{0};
+};
+
+//one message for the synth thread
+typedef struct MusicSynthMsgStruct {
+    uint8_t type = MUSICSYNTH_MSG_QUIT;
+    std::string fileName;
+
+    //set by the synth thread after the message was processed
+    std::promise<bool> done;
+    std::string errorMsg;
+} MusicSynthMsgStruct;
+
+//Renders the game music with ADLMIDI (OPL3 emulation) on its own thread into a MusicRingBuffer, so that
+//the audio callback of the music stream only needs to copy the samples. The ADLMIDI player is only used
+//by the synth thread after Start was called, the music file is therefore changed with a message
+class MusicSynth {
+public:
+    MusicSynth(uint32_t sampleRate);
+
+    //stops the synth thread, and closes ADLMIDI
+    ~MusicSynth();
+
+    //Initializes ADLMIDI with the OPL3 instrument file bankFile
+    //Returns false in case of an error, errorMsg contains the reason
+    bool Init(const char* bankFile, std::string& errorMsg);
+
+    //starts the synth thread
+    void Start();
+
+    //stops the synth thread, can be called more than once
+    void Stop();
+
+    //Loads a music file on the synth thread, and waits until it was loaded; Samples of the
+    //previous music file that are still in the ring buffer are skipped. Returns false in
+    //case of an error, errorMsg contains the reason
+    bool LoadFile(const char* fileName, std::string& errorMsg);
+
+    //Called from the audio callback: copies up to nrSamples into dest, and returns the number
+    //of copied samples; Never blocks, returns 0 if the synth thread is behind
+    uint32_t ReadSamples(int16_t* dest, uint32_t nrSamples);
+
+    //true if the music file has ended, and all
+    //samples were read already
+    bool HasEnded();
+
+private:
+    uint32_t mSampleRate;
+
+    struct ADL_MIDIPlayer* mMidiPlayer = nullptr;
+    struct ADLMIDI_AudioFormat mAudioFormat;
+
+    MusicRingBuffer mRingBuffer;
+
+    //only used by the synth thread
+    std::vector<int16_t> mRenderBuffer;
+    bool mFileLoaded = false;
+
+    std::atomic<bool> mEnded{false};
+
+    std::thread mWorker;
+    std::mutex mMutex;
+
+    //signaled when a new message was queued
+    std::condition_variable mMsgCondition;
+    std::list<std::shared_ptr<MusicSynthMsgStruct>> mMsgList;
+
+    //creates the ADLMIDI player with the game settings
+    static struct ADL_MIDIPlayer* CreatePlayer(uint32_t sampleRate, const char* bankFile,
+                                               struct ADLMIDI_AudioFormat& audioFormat, std::string& errorMsg);
+
+    //renders the next samples into the ring buffer, returns
+    //false if the ring buffer is full or the music has ended
+    bool RenderNextSamples();
+
+    //returns false if the synth thread should stop
+    bool ProcessMessage(MusicSynthMsgStruct& msg);
+
+    void WorkerThread();
+};
+
+#endif // MUSICSYNTH_H
@@ -10,13 +10,25 @@
 #include "sound.h"
 #include <iostream>
 #include "../utils/logging.h"
+#include "../resources/assetarchive.h"
+#include "../game.h"
 
-SoundResource::SoundResource(std::string fileName, u_int8_t soundResId) {
+SoundResource::SoundResource(std::string fileName, u_int8_t soundResId, AssetArchive* archive) {
     //Store my sound resource Id so that we know
     //what I contain
     mSoundResId = soundResId;
 
-    if (!mSoundBuf.loadFromFile(fileName)) {
+    const void* data;
+    size_t dataSize;
+    bool loaded;
+
+    if ((archive != nullptr) && archive->GetFileData(fileName.c_str(), data, dataSize)) {
+        loaded = mSoundBuf.loadFromMemory(data, dataSize);
+    } else {
+        loaded = mSoundBuf.loadFromFile(fileName);
+    }
+
+    if (!loaded) {
             std::string errMsg("LoadSoundResouce: Could not load sound resource file ");
             errMsg.append(fileName);
             logging::Error(errMsg);
@@ -51,6 +63,9 @@ void SoundEngine::StopAllSounds() {
         std::vector<sf::Sound*>::iterator it;
         enum sf::SoundSource::Status stat;
         for (it = SoundVec->begin(); it != SoundVec->end(); ++it) {
+            if ((*it) == nullptr)
+                continue;
+
             stat = (*it)->getStatus();
             if ((stat == sf::SoundSource::Status::Playing) || (stat == sf::SoundSource::Status::Paused)) {
                 (*it)->stop();
@@ -58,6 +73,9 @@ void SoundEngine::StopAllSounds() {
         }
     }
 
+    //all voices are free again
+    mVoiceAlloc->ReleaseAll();
+
     StopEngineSoundForAllPlayers();
 }
 
@@ -66,6 +84,9 @@ bool SoundEngine::IsAnySoundPlaying() {
         std::vector<sf::Sound*>::iterator it;
         enum sf::SoundSource::Status stat;
         for (it = SoundVec->begin(); it != SoundVec->end(); ++it) {
+            if ((*it) == nullptr)
+                continue;
+
             stat = (*it)->getStatus();
             if (stat == sf::SoundSource::Status::Playing)
                 return true;
@@ -187,6 +208,8 @@ void SoundEngine::StopEngineSoundForPlayer(Player* player) {
 }
 
 void SoundEngine::UpdateListenerLocation(irr::core::vector3df location, irr::core::vector3df frontDirVec) {
+   mListenerLocation = location;
+
    sf::Listener::setPosition(reinterpret_cast<sf::Vector3f&>(location));
 
    frontDirVec.normalize();
@@ -201,9 +224,17 @@ SoundEngine::SoundEngine(Game* gamePnter) {
     SoundResVec = new std::vector<SoundResource*>();
 
     //create new vector where we can store sound sources
-    SoundVec = new std::vector<sf::Sound*>();
+    SoundVec = new std::vector<sf::Sound*>(SOUND_MAXNR, nullptr);
 
-    mNrSoundSources = 0;
+    //setup the voice allocation, the critical sounds can
+    //use all voices, and steal the voices of all other sounds
+    mVoiceAlloc = new VoiceAllocator(SOUND_MAXNR, SOUND_RESERVEDNR);
+
+    mVoiceAlloc->SetCategory(SOUND_CAT_AMBIENT, 0, 3, false);
+    mVoiceAlloc->SetCategory(SOUND_CAT_WEAPON, 1, 8, false);
+    mVoiceAlloc->SetCategory(SOUND_CAT_PLAYER, 2, 6, false);
+    mVoiceAlloc->SetCategory(SOUND_CAT_MENUE, 3, SOUND_MAXNR, false);
+    mVoiceAlloc->SetCategory(SOUND_CAT_CRITICAL, 4, SOUND_MAXNR, true);
 
     mNonLocalizedSoundPos = new irr::core::vector3df(0.0f, 0.0f, 0.0f);
 }
@@ -227,38 +258,106 @@ SoundResource* SoundEngine::SearchSndRes(uint8_t soundResId) {
     return nullptr;
 }
 
-sf::Sound* SoundEngine::GetFreeSoundSource(SoundResource* resToPlay) {
-    //if we have already sources available try to
-    //reuse an already existing inactive source
-    if (this->SoundVec->size() > 0) {
-        std::vector<sf::Sound*>::iterator it;
-        for (it = this->SoundVec->begin(); it != this->SoundVec->end(); ++it) {
-           if ((*it)->getStatus() == sf::SoundSource::Status::Stopped) {
-               //found useful source
-               return (*it);
-           }
+uint8_t SoundEngine::GetSoundCategory(uint8_t soundResId) {
+    switch (soundResId) {
+        case SRES_GAME_WARNING:
+        case SRES_GAME_LOCKON:
+        case SRES_GAME_FINALLAP:
+        case SRES_GAME_START1:
+        case SRES_GAME_START2: {
+            return SOUND_CAT_CRITICAL;
+        }
+
+        case SRES_GAME_PICKUP:
+        case SRES_GAME_REFUEL:
+        case SRES_GAME_TURBO:
+        case SRES_GAME_BOOSTER:
+        case SRES_GAME_COLLISION:
+        case SRES_GAME_MGUN_SHOTFAILED: {
+            return SOUND_CAT_PLAYER;
+        }
+
+        case SRES_GAME_MGUN_SINGLESHOT:
+        case SRES_GAME_MGUN_LONGSHOT:
+        case SRES_GAME_MISSILE_SHOT:
+        case SRES_GAME_EXPLODE: {
+            return SOUND_CAT_WEAPON;
+        }
+
+        case SRES_GAME_RICCO1:
+        case SRES_GAME_RICCO2:
+        case SRES_GAME_RICCO3: {
+            return SOUND_CAT_AMBIENT;
+        }
+
+        default: {
+            //menue and intro sounds
+            return SOUND_CAT_MENUE;
         }
     }
+}
 
-    //we did not find a currently
-    //useful sound source, maybe all currently
-    //playing
-    //can we create a new one?
-    if (this->mNrSoundSources < SOUND_MAXNR) {
-        sf::Sound *newSnd = new sf::Sound(resToPlay->mSoundBuf);
+float SoundEngine::GetAudibleGain(irr::core::vector3df sourceLocation) {
+    irr::f32 dist = sourceLocation.getDistanceFrom(mListenerLocation);
 
-        //also set current sound volue
-        newSnd->setVolume(mSoundVolume);
+    //inside of the min distance the full
+    //volume is used
+    if (dist <= 1.0f)
+        return 1.0f;
 
-        this->SoundVec->push_back(newSnd);
-        this->mNrSoundSources++;
+    return (1.0f / dist);
+}
 
-        return newSnd;
+void SoundEngine::ReclaimStoppedSoundSources() {
+    for (int32_t idx = 0; idx < (int32_t)(SoundVec->size()); idx++) {
+        if (!mVoiceAlloc->IsActive(idx))
+            continue;
+
+        if ((SoundVec->at(idx) == nullptr) ||
+                (SoundVec->at(idx)->getStatus() == sf::SoundSource::Status::Stopped)) {
+            mVoiceAlloc->Release(idx);
+        }
     }
+}
 
-    //already too much sounds, do not do
-    //anything
-    return nullptr;
+int32_t SoundEngine::GetFreeSoundSource(SoundResource* resToPlay, float gain) {
+    uint8_t category = GetSoundCategory(resToPlay->mSoundResId);
+    bool stolen;
+
+    //as long as there is a free voice we do not need to
+    //look at the other sound sources at all
+    int32_t voiceIdx = mVoiceAlloc->Allocate(category, gain, false, stolen);
+
+    if (voiceIdx == VOICEALLOC_NOVOICE) {
+        //the voices of sounds that finished playing are only released
+        //here, afterwards steal a voice if there is still none free
+        ReclaimStoppedSoundSources();
+        voiceIdx = mVoiceAlloc->Allocate(category, gain, true, stolen);
+    }
+
+    if (voiceIdx == VOICEALLOC_NOVOICE) {
+        //all voices are used by more
+        //important sounds, do not play it
+        return VOICEALLOC_NOVOICE;
+    }
+
+    sf::Sound* snd = SoundVec->at(voiceIdx);
+
+    if (snd == nullptr) {
+        //voice is used the first time, create the sound source
+        snd = new sf::Sound(resToPlay->mSoundBuf);
+
+        //also set current sound volue
+        snd->setVolume(mSoundVolume);
+
+        SoundVec->at(voiceIdx) = snd;
+    } else if (stolen) {
+        //stop the sound that was playing before, the handle
+        //of its owner is stale from now on
+        snd->stop();
+    }
+
+    return voiceIdx;
 }
 
 //sets a new sound volume for all available sound
@@ -285,7 +384,9 @@ void SoundEngine::SetVolume(float soundVolume) {
         if (this->SoundVec->size() > 0) {
             std::vector<sf::Sound*>::iterator it;
             for (it = this->SoundVec->begin(); it != this->SoundVec->end(); ++it) {
-               (*it)->setVolume(soundVolume);
+               if ((*it) != nullptr) {
+                   (*it)->setVolume(soundVolume);
+               }
             }
         }
     }
@@ -296,33 +397,50 @@ bool SoundEngine::GetIsSoundActive() {
 }
 
 //Localized sound source
-sf::Sound* SoundEngine::PlaySound(uint8_t soundResId, irr::core::vector3df sourceLocation, bool looping) {
+VoiceHandleStruct SoundEngine::PlaySound(uint8_t soundResId, irr::core::vector3df sourceLocation, bool looping) {
     return PlaySound(soundResId, true, sourceLocation, 1.0f, looping);
 }
 
 //non Localized sound source with default pitch
-sf::Sound* SoundEngine::PlaySound(uint8_t soundResId, bool looping) {
+VoiceHandleStruct SoundEngine::PlaySound(uint8_t soundResId, bool looping) {
     return PlaySound(soundResId, false, *mNonLocalizedSoundPos, 1.0f, looping);
 }
 
 //non Localized sound source with pitch control
-sf::Sound* SoundEngine::PlaySound(uint8_t soundResId, irr::f32 playPitch, bool looping) {
+VoiceHandleStruct SoundEngine::PlaySound(uint8_t soundResId, irr::f32 playPitch, bool looping) {
     return PlaySound(soundResId, false, *mNonLocalizedSoundPos, playPitch, looping);
 }
 
-sf::Sound* SoundEngine::PlaySound(uint8_t soundResId, bool localizedSoundSource, irr::core::vector3df sourceLocation,
+VoiceHandleStruct SoundEngine::PlaySound(uint8_t soundResId, bool localizedSoundSource, irr::core::vector3df sourceLocation,
                      irr::f32 playPitch, bool looping) {
+    //stale handle, returned if the
+    //sound is not played
+    VoiceHandleStruct noSound;
+
     //if we should not play sounds exit
     if (!mPlaySound)
-        return nullptr;
+        return noSound;
 
     //first search resource
     SoundResource* res = SearchSndRes(soundResId);
 
     if ((res != nullptr) && (res->loadOk)) {
         //we found the sound resource to play
-            sf::Sound* sndPntr = GetFreeSoundSource(res);
-            if (sndPntr != nullptr) {
+        //localized sounds that can not be heard at the listener
+        //location are not played, except the critical ones
+        float gain = 1.0f;
+
+        if (localizedSoundSource) {
+            gain = GetAudibleGain(sourceLocation);
+
+            if ((gain < SOUND_MIN_AUDIBLE_GAIN) && (GetSoundCategory(soundResId) != SOUND_CAT_CRITICAL))
+                return noSound;
+        }
+
+            int32_t voiceIdx = GetFreeSoundSource(res, gain);
+            if (voiceIdx != VOICEALLOC_NOVOICE) {
+                sf::Sound* sndPntr = SoundVec->at(voiceIdx);
+
                 //we found a free sound source to play buffer
                 //or a new one was created for us
                 sndPntr->setBuffer(res->mSoundBuf);
@@ -341,17 +459,24 @@ sf::Sound* SoundEngine::PlaySound(uint8_t soundResId, bool localizedSoundSource,
 
                 sndPntr->play();
 
-                //return sound source we have used
+                //return the handle of the sound
                 //(is important to be able to stop
                 //looping sound afterwards)
-                return sndPntr;
+                return mVoiceAlloc->GetHandle(voiceIdx);
             }
     }
 
-    return nullptr;
+    return noSound;
 }
 
-void SoundEngine::StopLoopingSound(sf::Sound* pntrSound) {
+void SoundEngine::StopSound(const VoiceHandleStruct& handle) {
+    //the sound source plays the sound of
+    //another owner by now?
+    if (!mVoiceAlloc->IsCurrent(handle))
+        return;
+
+    sf::Sound* pntrSound = SoundVec->at(handle.voiceIdx);
+
     if (pntrSound != nullptr) {
         if (pntrSound->getStatus() == sf::SoundSource::Status::Playing) {
             pntrSound->stop();
@@ -359,6 +484,18 @@ void SoundEngine::StopLoopingSound(sf::Sound* pntrSound) {
     }
 }
 
+bool SoundEngine::IsSoundPlaying(const VoiceHandleStruct& handle) {
+    if (!mVoiceAlloc->IsCurrent(handle))
+        return false;
+
+    sf::Sound* pntrSound = SoundVec->at(handle.voiceIdx);
+
+    if (pntrSound == nullptr)
+        return false;
+
+    return (pntrSound->getStatus() != sf::SoundSource::Status::Stopped);
+}
+
 //returns true if successful, false otherwise
 void SoundEngine::LoadSoundResourcesIntro() {
     //load all the intro sounds as well
@@ -445,7 +582,7 @@ bool SoundEngine::LoadSoundResource(std::string fileName, uint8_t soundResId) {
     }
 
     //we do not have this resouce ID yet => all ok
-    SoundResource* newRes = new SoundResource(fileName, soundResId);
+    SoundResource* newRes = new SoundResource(fileName, soundResId, mGame->mAssetArchive);
 
     //add new resource to vector
     this->SoundResVec->push_back(newRes);
@@ -492,6 +629,18 @@ SoundEngine::~SoundEngine() {
     //stop engine sound as well
     StopEngineSoundForAllPlayers();
 
+    //delete all sound sources before the sound
+    //buffers they use
+    std::vector<sf::Sound*>::iterator itSnd;
+    for (itSnd = SoundVec->begin(); itSnd != SoundVec->end(); ++itSnd) {
+        if ((*itSnd) != nullptr) {
+            delete (*itSnd);
+        }
+    }
+
+    delete SoundVec;
+    delete mVoiceAlloc;
+
     //delete all available sound resource
     DeleteSoundResource(SRES_MENUE_TYPEWRITEREFFECT1);
     DeleteSoundResource(SRES_MENUE_TYPEWRITEREFFECT2);
@@ -13,6 +13,7 @@
 #include "SFML/Audio.hpp"
 #include "irrlicht.h"
 #include <cstdint>
+#include "voicealloc.h"
 
 //File name definition
 #define SFILE_MENUE_TYPEWRITEREFFECT1 "extract/sound/sound2-PRINTTYP.WAV"
@@ -98,16 +99,35 @@
 //maximum number of allowed sound sources
 #define SOUND_MAXNR 20
 
+//number of sound sources that are kept free
+//for the sounds of category SOUND_CAT_CRITICAL
+#define SOUND_RESERVEDNR 2
+
+//sound categories for the voice allocation,
+//from the lowest to the highest priority
+#define SOUND_CAT_AMBIENT 0     //ricochets
+#define SOUND_CAT_WEAPON 1      //machine gun, missiles, explosions
+#define SOUND_CAT_PLAYER 2      //pickups, charging, turbo, booster, collisions
+#define SOUND_CAT_MENUE 3       //menue and intro sounds
+#define SOUND_CAT_CRITICAL 4    //warnings, lock on, final lap, race start; are never dropped
+
+//localized sounds that are more quiet than this at the
+//listener location are not played at all (critical sounds excluded)
+#define SOUND_MIN_AUDIBLE_GAIN 0.01f
+
 /************************
  * Forward declarations *
  ************************/
 
 class Player;
 class Game;
+class AssetArchive;
 
 class SoundResource {
 public:
-    SoundResource(std::string fileName, u_int8_t soundResId);
+    //if archive is specified and contains the file, the
+    //sound is loaded from the archive
+    SoundResource(std::string fileName, u_int8_t soundResId, AssetArchive* archive = nullptr);
     ~SoundResource();
 
     bool loadOk;
@@ -123,16 +143,27 @@ public:
 
   bool GetSoundResourcesLoadOk();
 
+  //All PlaySound functions return the handle of the started sound, the handle
+  //is stale if the sound was not played
+
   //play sound with localized sound source
-  sf::Sound* PlaySound(uint8_t soundResId, irr::core::vector3df sourceLocation, bool looping = false);
+  VoiceHandleStruct PlaySound(uint8_t soundResId, irr::core::vector3df sourceLocation, bool looping = false);
   //play sound without localized sound source
-  sf::Sound* PlaySound(uint8_t soundResId, bool looping = false);
+  VoiceHandleStruct PlaySound(uint8_t soundResId, bool looping = false);
 
   //non Localized sound source with pitch control, we need this to control
   //speed of booster sound playback
-  sf::Sound* PlaySound(uint8_t soundResId, irr::f32 playPitch, bool looping = false);
+  VoiceHandleStruct PlaySound(uint8_t soundResId, irr::f32 playPitch, bool looping = false);
+
+  //stops the sound of the handle; does nothing if the sound was stolen
+  //for another sound in the meantime
+  void StopSound(const VoiceHandleStruct& handle);
+
+  //returns false if the sound of the handle has finished, or if its sound
+  //source was stolen for another sound; the owner of a looping sound can
+  //use this to start its sound again
+  bool IsSoundPlaying(const VoiceHandleStruct& handle);
 
-  void StopLoopingSound(sf::Sound* pntrSound);
   bool IsAnySoundPlaying();
   void StopAllSounds();
 
@@ -170,21 +201,43 @@ private:
 
   bool mPlaySound = true;
 
-  sf::Sound* PlaySound(uint8_t soundResId, bool localizedSoundSource, irr::core::vector3df sourceLocation, irr::f32 playPitch, bool looping = false);
+  VoiceHandleStruct PlaySound(uint8_t soundResId, bool localizedSoundSource, irr::core::vector3df sourceLocation, irr::f32 playPitch, bool looping = false);
 
   bool LoadSoundResource(std::string fileName, uint8_t soundResId);
   void DeleteSoundResource(uint8_t soundResId);
 
-  sf::Sound* GetFreeSoundSource(SoundResource* resToPlay);
+  //Returns the voice index for a new sound, a playing sound with lower priority (or a more
+  //quiet one of the same category) is stopped if necessary; Returns VOICEALLOC_NOVOICE if the
+  //sound should not be played. gain is the audible gain of the sound at the listener location
+  int32_t GetFreeSoundSource(SoundResource* resToPlay, float gain);
+
+  //returns the category of a sound resource
+  //for the voice allocation
+  static uint8_t GetSoundCategory(uint8_t soundResId);
+
+  //calculates the gain of a localized sound at the current listener location, the
+  //same way SFML does it (inverse distance with min distance 1 and attenuation 1)
+  float GetAudibleGain(irr::core::vector3df sourceLocation);
+
+  //releases the voices of all sound sources that
+  //finished playing in the voice allocator
+  void ReclaimStoppedSoundSources();
 
   //searches for a sound resource entry with a certain specified sound ID
   //if no sound under this sound ID is found returns nullptr
   SoundResource* SearchSndRes(uint8_t soundResId);
 
   std::vector<SoundResource*> *SoundResVec = nullptr;
+
+  //one entry per voice of the voice allocator, the sound
+  //sources are created when the voice is used the first time
   std::vector<sf::Sound*> *SoundVec = nullptr;
 
-  uint8_t mNrSoundSources = 0;
+  VoiceAllocator* mVoiceAlloc = nullptr;
+
+  //location of the listener, for the audibility
+  //of localized sounds
+  irr::core::vector3df mListenerLocation;
   float mSoundVolume = 100.0f;
 
   irr::core::vector3df* mNonLocalizedSoundPos = nullptr;
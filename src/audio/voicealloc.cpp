@@ -0,0 +1,209 @@
+/*
+ Copyright (C) 2026 Wolf Alexander
+
+ This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.                                          */
+
+#include "voicealloc.h"
+
+VoiceAllocator::VoiceAllocator(uint32_t nrVoices, uint32_t nrReservedVoices) {
+    mVoiceVec.resize(nrVoices);
+    mNrReservedVoices = (nrReservedVoices < nrVoices) ? nrReservedVoices : nrVoices;
+
+    ReleaseAll();
+}
+
+VoiceAllocator::~VoiceAllocator() {
+}
+
+void VoiceAllocator::SetCategory(uint8_t category, uint8_t priority, uint32_t maxVoices, bool useReserved) {
+    if (category >= VOICEALLOC_MAXCATEGORIES)
+        return;
+
+    mCategory[category].priority = priority;
+    mCategory[category].maxVoices = maxVoices;
+    mCategory[category].useReserved = useReserved;
+}
+
+void VoiceAllocator::ReleaseAll() {
+    //put all voices into the free list, voice 0 first
+    mFirstFree = VOICEALLOC_NOVOICE;
+
+    for (int32_t idx = (int32_t)(mVoiceVec.size()) - 1; idx >= 0; idx--) {
+        mVoiceVec[idx].active = false;
+        mVoiceVec[idx].nextFree = mFirstFree;
+        mFirstFree = idx;
+    }
+
+    mNrFree = (uint32_t)(mVoiceVec.size());
+
+    for (uint8_t cat = 0; cat < VOICEALLOC_MAXCATEGORIES; cat++) {
+        mCategory[cat].nrActive = 0;
+    }
+}
+
+bool VoiceAllocator::IsBetterVictim(const VoiceStateStruct& a, const VoiceStateStruct& b) {
+    uint8_t prioA = mCategory[a.category].priority;
+    uint8_t prioB = mCategory[b.category].priority;
+
+    if (prioA != prioB)
+        return (prioA < prioB);
+
+    if (a.gain != b.gain)
+        return (a.gain < b.gain);
+
+    return (a.startNr < b.startNr);
+}
+
+int32_t VoiceAllocator::FindVictim(uint8_t newPriority, float newGain, uint8_t onlyCategory) {
+    int32_t victim = VOICEALLOC_NOVOICE;
+
+    for (int32_t idx = 0; idx < (int32_t)(mVoiceVec.size()); idx++) {
+        const VoiceStateStruct& voice = mVoiceVec[idx];
+
+        if (!voice.active)
+            continue;
+
+        if ((onlyCategory != VOICEALLOC_MAXCATEGORIES) && (voice.category != onlyCategory))
+            continue;
+
+        //only steal for a more important sound, or for a
+        //louder sound of the same priority
+        uint8_t prio = mCategory[voice.category].priority;
+
+        if ((prio > newPriority) || ((prio == newPriority) && (voice.gain > newGain)))
+            continue;
+
+        if ((victim == VOICEALLOC_NOVOICE) || IsBetterVictim(voice, mVoiceVec[victim])) {
+            victim = idx;
+        }
+    }
+
+    return victim;
+}
+
+void VoiceAllocator::Activate(int32_t voiceIdx, uint8_t category, float gain) {
+    VoiceStateStruct& voice = mVoiceVec[voiceIdx];
+
+    voice.active = true;
+    voice.generation++;
+    voice.category = category;
+    voice.gain = gain;
+    voice.startNr = mStartCounter++;
+    voice.nextFree = VOICEALLOC_NOVOICE;
+
+    mCategory[category].nrActive++;
+}
+
+int32_t VoiceAllocator::Allocate(uint8_t category, float gain, bool allowSteal, bool& stolen) {
+    stolen = false;
+
+    if (category >= VOICEALLOC_MAXCATEGORIES)
+        return VOICEALLOC_NOVOICE;
+
+    VoiceCategoryStruct& cat = mCategory[category];
+    int32_t voiceIdx = VOICEALLOC_NOVOICE;
+
+    if (cat.nrActive >= cat.maxVoices) {
+        //the category is full, the new sound can
+        //only replace a sound of the same category
+        if (allowSteal) {
+            voiceIdx = FindVictim(cat.priority, gain, category);
+            stolen = (voiceIdx != VOICEALLOC_NOVOICE);
+        }
+    } else if ((mNrFree > mNrReservedVoices) || (cat.useReserved && (mNrFree > 0))) {
+        //take the first voice of the free list
+        voiceIdx = mFirstFree;
+        mFirstFree = mVoiceVec[voiceIdx].nextFree;
+        mNrFree--;
+    } else if (allowSteal) {
+        voiceIdx = FindVictim(cat.priority, gain, VOICEALLOC_MAXCATEGORIES);
+        stolen = (voiceIdx != VOICEALLOC_NOVOICE);
+    }
+
+    if (voiceIdx == VOICEALLOC_NOVOICE) {
+        if (allowSteal) {
+            mNrDropped++;
+        }
+
+        return VOICEALLOC_NOVOICE;
+    }
+
+    if (stolen) {
+        mCategory[mVoiceVec[voiceIdx].category].nrActive--;
+        mNrStolen++;
+    }
+
+    Activate(voiceIdx, category, gain);
+
+    return voiceIdx;
+}
+
+void VoiceAllocator::Release(int32_t voiceIdx) {
+    if ((voiceIdx < 0) || (voiceIdx >= (int32_t)(mVoiceVec.size())))
+        return;
+
+    VoiceStateStruct& voice = mVoiceVec[voiceIdx];
+
+    if (!voice.active)
+        return;
+
+    voice.active = false;
+    mCategory[voice.category].nrActive--;
+
+    voice.nextFree = mFirstFree;
+    mFirstFree = voiceIdx;
+    mNrFree++;
+}
+
+VoiceHandleStruct VoiceAllocator::GetHandle(int32_t voiceIdx) {
+    VoiceHandleStruct handle;
+
+    if ((voiceIdx < 0) || (voiceIdx >= (int32_t)(mVoiceVec.size())))
+        return handle;
+
+    handle.voiceIdx = voiceIdx;
+    handle.generation = mVoiceVec[voiceIdx].generation;
+
+    return handle;
+}
+
+bool VoiceAllocator::IsCurrent(const VoiceHandleStruct& handle) {
+    if (!IsActive(handle.voiceIdx))
+        return false;
+
+    return (mVoiceVec[handle.voiceIdx].generation == handle.generation);
+}
+
+bool VoiceAllocator::IsActive(int32_t voiceIdx) {
+    if ((voiceIdx < 0) || (voiceIdx >= (int32_t)(mVoiceVec.size())))
+        return false;
+
+    return mVoiceVec[voiceIdx].active;
+}
+
+uint32_t VoiceAllocator::GetNrVoices() {
+    return (uint32_t)(mVoiceVec.size());
+}
+
+uint32_t VoiceAllocator::GetNrFreeVoices() {
+    return mNrFree;
+}
+
+uint32_t VoiceAllocator::GetNrActiveVoices(uint8_t category) {
+    if (category >= VOICEALLOC_MAXCATEGORIES)
+        return 0;
+
+    return mCategory[category].nrActive;
+}
+
+uint32_t VoiceAllocator::GetNrStolen() {
+    return mNrStolen;
+}
+
+uint32_t VoiceAllocator::GetNrDropped() {
+    return mNrDropped;
+}
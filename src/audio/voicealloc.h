@@ -0,0 +1,142 @@
+/*
+ Copyright (C) 2026 Wolf Alexander
+
+ This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.                                          */
+
+#ifndef VOICEALLOC_H
+#define VOICEALLOC_H
+
+#include <vector>
+#include <cstdint>
+
+//returned by Allocate if no voice is available
+#define VOICEALLOC_NOVOICE -1
+
+//maximum number of sound categories
+#define VOICEALLOC_MAXCATEGORIES 8
+
+//state of one voice (sound source)
+typedef struct VoiceStateStruct {
+    bool active = false;
+
+    //increases every time the voice starts a new sound, handles
+    //of the sounds played before on this voice become stale
+    uint32_t generation = 0;
+
+    uint8_t category = 0;
+
+    //audible gain (0.0 up to 1.0) of the
+    //sound at the time it was started
+    float gain = 0.0f;
+
+    //increases with every allocation, smaller
+    //values are older voices
+    uint32_t startNr = 0;
+
+    //next voice in the free list
+    int32_t nextFree = VOICEALLOC_NOVOICE;
+} VoiceStateStruct;
+
+//identifies one sound that was started on a voice; after the voice was
+//stolen or reused for another sound the generation does not match anymore,
+//so the owner of the handle can not stop or poll the other sound by accident
+typedef struct VoiceHandleStruct {
+    int32_t voiceIdx = VOICEALLOC_NOVOICE;
+    uint32_t generation = 0;
+} VoiceHandleStruct;
+
+//settings of one sound category
+typedef struct VoiceCategoryStruct {
+    //voices with a higher priority can steal
+    //voices with a lower priority
+    uint8_t priority = 0;
+
+    //maximum number of voices this category
+    //can use at the same time
+    uint32_t maxVoices = 0;
+
+    //if true the category can also use the reserved voices, this way
+    //these sounds are still played when all other voices are busy
+    bool useReserved = false;
+
+    uint32_t nrActive = 0;
+} VoiceCategoryStruct;
+
+//Decides which sound source (voice) plays a new sound. Free voices are kept in a free list, so a voice is
+//allocated in O(1) as long as one is free. If no voice is free (or the category has reached its limit)
+//a playing voice is stolen: the voice with the lowest priority, and with the same priority the most quiet
+//one, and then the oldest one. A voice is only stolen for a sound with a higher priority, or for a louder
+//sound with the same priority. The allocator does not play any sound itself, therefore it can be used
+//(and tested) without an audio device; The caller stops the stolen voice and releases voices that
+//finished playing. Owners of a sound keep a VoiceHandleStruct instead of the voice itself, and
+//can find out with IsCurrent if the sound was stolen in the meantime
+class VoiceAllocator {
+public:
+    //nrReservedVoices of the nrVoices can only be
+    //used by categories with useReserved set
+    VoiceAllocator(uint32_t nrVoices, uint32_t nrReservedVoices);
+    ~VoiceAllocator();
+
+    void SetCategory(uint8_t category, uint8_t priority, uint32_t maxVoices, bool useReserved);
+
+    //Returns the voice index for the new sound, or VOICEALLOC_NOVOICE if the sound should not be played
+    //If allowSteal is false only a free voice is returned; If stolen is true the returned voice
+    //was still playing another sound, which must be stopped first
+    int32_t Allocate(uint8_t category, float gain, bool allowSteal, bool& stolen);
+
+    //returns the handle of the sound that was
+    //started last on the voice
+    VoiceHandleStruct GetHandle(int32_t voiceIdx);
+
+    //returns true if the voice still plays the sound of the handle, false if the
+    //voice was released, or was stolen (or reused) for another sound since then
+    bool IsCurrent(const VoiceHandleStruct& handle);
+
+    //the voice finished playing, or was stopped
+    void Release(int32_t voiceIdx);
+
+    //releases all active voices
+    void ReleaseAll();
+
+    bool IsActive(int32_t voiceIdx);
+
+    uint32_t GetNrVoices();
+    uint32_t GetNrFreeVoices();
+    uint32_t GetNrActiveVoices(uint8_t category);
+
+    //number of voices that were stolen, and sounds that
+    //could not be played, since the allocator was created
+    uint32_t GetNrStolen();
+    uint32_t GetNrDropped();
+
+private:
+    std::vector<VoiceStateStruct> mVoiceVec;
+    VoiceCategoryStruct mCategory[VOICEALLOC_MAXCATEGORIES];
+
+    uint32_t mNrReservedVoices;
+
+    //first voice of the free list
+    int32_t mFirstFree = VOICEALLOC_NOVOICE;
+    uint32_t mNrFree = 0;
+
+    uint32_t mStartCounter = 0;
+
+    uint32_t mNrStolen = 0;
+    uint32_t mNrDropped = 0;
+
+    //returns true if voice a should be stolen
+    //before voice b
+    bool IsBetterVictim(const VoiceStateStruct& a, const VoiceStateStruct& b);
+
+    //returns the voice that should be stolen for the new sound, only voices of
+    //onlyCategory are considered if it is not VOICEALLOC_MAXCATEGORIES
+    int32_t FindVictim(uint8_t newPriority, float newGain, uint8_t onlyCategory);
+
+    void Activate(int32_t voiceIdx, uint8_t category, float gain);
+};
+
+#endif // VOICEALLOC_H
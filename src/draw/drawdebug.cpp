@@ -9,6 +9,7 @@
 
 #include "drawdebug.h"
 #include <cmath>
+#include <cstdio>
 
 DrawDebug::DrawDebug(irr::scene::ISceneManager* sceneManager, irr::video::IVideoDriver *driver) {
     myDriver = driver;
@@ -34,6 +35,11 @@ DrawDebug::DrawDebug(irr::scene::ISceneManager* sceneManager, irr::video::IVideo
     YAxis = new irr::core::vector3df(0.0f, 10.0f, 0.0f);
     ZAxis = new irr::core::vector3df(0.0f, 0.0f, 10.0f);
 
+    //all categories are enabled by default
+    for (irr::u8 idx = 0; idx < DEF_DRAWDEBUG_CAT_COUNT; idx++) {
+        mCategoryEnabled[idx] = true;
+    }
+
     InitCubeMesh();
 }
 
@@ -62,32 +68,215 @@ void DrawDebug::CleanUpColor(ColorStruct* whichColor) {
     }
 }
 
-void DrawDebug::Draw3DTriangle(const irr::core::triangle3df *triangle, ColorStruct* color) {
-    myDriver->draw3DTriangle(*triangle, *color->color);
+DrawDebugBatchStruct* DrawDebug::GetBatch(ColorStruct* color) {
+    if ((mLastBatch != nullptr) && (mLastBatch->color == color))
+        return mLastBatch;
+
+    std::vector<DrawDebugBatchStruct*>::iterator it;
+
+    for (it = mBatchVec.begin(); it != mBatchVec.end(); ++it) {
+        if ((*it)->color == color) {
+            mLastBatch = (*it);
+            return mLastBatch;
+        }
+    }
+
+    //first primitive with this color
+    DrawDebugBatchStruct* newBatch = new DrawDebugBatchStruct();
+    newBatch->color = color;
+
+    mBatchVec.push_back(newBatch);
+    mLastBatch = newBatch;
+
+    return newBatch;
+}
+
+void DrawDebug::SetCategoryEnabled(irr::u8 category, bool enabled) {
+    if (category >= DEF_DRAWDEBUG_CAT_COUNT)
+        return;
+
+    mCategoryEnabled[category] = enabled;
+}
+
+bool DrawDebug::IsCategoryEnabled(irr::u8 category) {
+    if (category >= DEF_DRAWDEBUG_CAT_COUNT)
+        return false;
+
+    return mCategoryEnabled[category];
+}
+
+void DrawDebug::AddLine(DrawDebugBatchStruct* batch, const irr::core::vector3df& startPos, const irr::core::vector3df& endPos,
+                        irr::u8 category) {
+    batch->lineVertices.push_back(irr::video::S3DVertex(startPos, irr::core::vector3df(0.0f, 0.0f, 0.0f), *batch->color->color,
+                                                       irr::core::vector2df(0.0f, 0.0f)));
+    batch->lineVertices.push_back(irr::video::S3DVertex(endPos, irr::core::vector3df(0.0f, 0.0f, 0.0f), *batch->color->color,
+                                                       irr::core::vector2df(0.0f, 0.0f)));
+    batch->lineCategories.push_back(category);
+}
+
+void DrawDebug::Draw3DTriangle(const irr::core::triangle3df *triangle, ColorStruct* color, irr::u8 category) {
+    if (!IsCategoryEnabled(category))
+        return;
+
+    DrawDebugBatchStruct* batch = GetBatch(color);
+    irr::core::vector3df normal = triangle->getNormal().normalize();
+
+    batch->triangleVertices.push_back(irr::video::S3DVertex(triangle->pointA, normal, *color->color, irr::core::vector2df(0.0f, 0.0f)));
+    batch->triangleVertices.push_back(irr::video::S3DVertex(triangle->pointB, normal, *color->color, irr::core::vector2df(0.0f, 0.0f)));
+    batch->triangleVertices.push_back(irr::video::S3DVertex(triangle->pointC, normal, *color->color, irr::core::vector2df(0.0f, 0.0f)));
+    batch->triangleCategories.push_back(category);
 }
 
-void DrawDebug::Draw3DTriangleOutline(const irr::core::triangle3df *triangle, ColorStruct* color) {
-    myDriver->setMaterial(*color->material);
-    myDriver->draw3DLine(triangle->pointA, triangle->pointB);
-    myDriver->draw3DLine(triangle->pointB, triangle->pointC);
-    myDriver->draw3DLine(triangle->pointC, triangle->pointA);
+void DrawDebug::Draw3DTriangleOutline(const irr::core::triangle3df *triangle, ColorStruct* color, irr::u8 category) {
+    if (!IsCategoryEnabled(category))
+        return;
+
+    DrawDebugBatchStruct* batch = GetBatch(color);
+
+    AddLine(batch, triangle->pointA, triangle->pointB, category);
+    AddLine(batch, triangle->pointB, triangle->pointC, category);
+    AddLine(batch, triangle->pointC, triangle->pointA, category);
 }
 
-void DrawDebug::Draw3DLine(irr::core::vector3df startPos, irr::core::vector3df endPos, ColorStruct* color) {
-    myDriver->setMaterial(*color->material);
-    myDriver->draw3DLine(startPos, endPos);
+void DrawDebug::Draw3DLine(irr::core::vector3df startPos, irr::core::vector3df endPos, ColorStruct* color, irr::u8 category) {
+    if (!IsCategoryEnabled(category))
+        return;
+
+    AddLine(GetBatch(color), startPos, endPos, category);
 }
 
 void DrawDebug::Draw3DRectangle(irr::core::vector3df v1, irr::core::vector3df v2, irr::core::vector3df v3, irr::core::vector3df v4,
-                     ColorStruct* color) {
-    myDriver->setMaterial(*color->material);
-    myDriver->draw3DLine(v1, v2);
-    myDriver->draw3DLine(v2, v3);
-    myDriver->draw3DLine(v3, v4);
-    myDriver->draw3DLine(v4, v1);
+                     ColorStruct* color, irr::u8 category) {
+    if (!IsCategoryEnabled(category))
+        return;
+
+    DrawDebugBatchStruct* batch = GetBatch(color);
+
+    AddLine(batch, v1, v2, category);
+    AddLine(batch, v2, v3, category);
+    AddLine(batch, v3, v4, category);
+    AddLine(batch, v4, v1, category);
+}
+
+void DrawDebug::PrepareIndices(irr::u32 nrIndices) {
+    //the index list only grows, and is then
+    //reused for all the next frames
+    for (irr::u32 idx = mIndices.size(); idx < nrIndices; idx++) {
+        mIndices.push_back(idx);
+    }
+}
+
+void DrawDebug::Flush() {
+    mNrLinesLastFlush = 0;
+    mNrTrianglesLastFlush = 0;
+    mNrDrawCallsLastFlush = 0;
+
+    if (mBatchVec.size() == 0)
+        return;
+
+    myDriver->setTransform(irr::video::ETS_WORLD, irr::core::IdentityMatrix);
+
+    std::vector<DrawDebugBatchStruct*>::iterator it;
+
+    for (it = mBatchVec.begin(); it != mBatchVec.end(); ++it) {
+        irr::u32 nrLineVertices = (*it)->lineVertices.size();
+        irr::u32 nrTriangleVertices = (*it)->triangleVertices.size();
+
+        if ((nrLineVertices == 0) && (nrTriangleVertices == 0))
+            continue;
+
+        PrepareIndices(nrLineVertices > nrTriangleVertices ? nrLineVertices : nrTriangleVertices);
+
+        myDriver->setMaterial(*(*it)->color->material);
+
+        if (nrLineVertices > 0) {
+            myDriver->drawVertexPrimitiveList((*it)->lineVertices.const_pointer(), nrLineVertices,
+                                              mIndices.const_pointer(), nrLineVertices / 2,
+                                              irr::video::EVT_STANDARD, irr::scene::EPT_LINES, irr::video::EIT_32BIT);
+
+            mNrLinesLastFlush += nrLineVertices / 2;
+            mNrDrawCallsLastFlush++;
+        }
+
+        if (nrTriangleVertices > 0) {
+            myDriver->drawVertexPrimitiveList((*it)->triangleVertices.const_pointer(), nrTriangleVertices,
+                                              mIndices.const_pointer(), nrTriangleVertices / 3,
+                                              irr::video::EVT_STANDARD, irr::scene::EPT_TRIANGLES, irr::video::EIT_32BIT);
+
+            mNrTrianglesLastFlush += nrTriangleVertices / 3;
+            mNrDrawCallsLastFlush++;
+        }
+    }
+
+    Clear();
+}
+
+void DrawDebug::Clear() {
+    std::vector<DrawDebugBatchStruct*>::iterator it;
+
+    //keep the allocated memory of the arrays
+    //for the next frame
+    for (it = mBatchVec.begin(); it != mBatchVec.end(); ++it) {
+        (*it)->lineVertices.set_used(0);
+        (*it)->lineCategories.clear();
+        (*it)->triangleVertices.set_used(0);
+        (*it)->triangleCategories.clear();
+    }
+}
+
+void DrawDebug::CleanUpBatches() {
+    std::vector<DrawDebugBatchStruct*>::iterator it;
+
+    for (it = mBatchVec.begin(); it != mBatchVec.end(); ++it) {
+        delete (*it);
+    }
+
+    mBatchVec.clear();
+    mLastBatch = nullptr;
+}
+
+//File format, one primitive per line:
+//  L <category> <r> <g> <b> <x1> <y1> <z1> <x2> <y2> <z2>
+//  T <category> <r> <g> <b> <x1> <y1> <z1> <x2> <y2> <z2> <x3> <y3> <z3>
+bool DrawDebug::DumpPrimitives(const char* fileName) {
+    FILE* oFile = fopen(fileName, "w");
+
+    if (oFile == nullptr) {
+        return false;
+    }
+
+    std::vector<DrawDebugBatchStruct*>::iterator it;
+
+    for (it = mBatchVec.begin(); it != mBatchVec.end(); ++it) {
+        irr::video::SColor* col = (*it)->color->color;
+
+        for (irr::u32 idx = 0; idx < (*it)->lineCategories.size(); idx++) {
+            const irr::core::vector3df& p1 = (*it)->lineVertices[2 * idx].Pos;
+            const irr::core::vector3df& p2 = (*it)->lineVertices[2 * idx + 1].Pos;
+
+            fprintf(oFile, "L %u %u %u %u %f %f %f %f %f %f\n", (*it)->lineCategories[idx],
+                    col->getRed(), col->getGreen(), col->getBlue(), p1.X, p1.Y, p1.Z, p2.X, p2.Y, p2.Z);
+        }
+
+        for (irr::u32 idx = 0; idx < (*it)->triangleCategories.size(); idx++) {
+            const irr::core::vector3df& p1 = (*it)->triangleVertices[3 * idx].Pos;
+            const irr::core::vector3df& p2 = (*it)->triangleVertices[3 * idx + 1].Pos;
+            const irr::core::vector3df& p3 = (*it)->triangleVertices[3 * idx + 2].Pos;
+
+            fprintf(oFile, "T %u %u %u %u %f %f %f %f %f %f %f %f %f\n", (*it)->triangleCategories[idx],
+                    col->getRed(), col->getGreen(), col->getBlue(), p1.X, p1.Y, p1.Z, p2.X, p2.Y, p2.Z, p3.X, p3.Y, p3.Z);
+        }
+    }
+
+    bool writeOk = (ferror(oFile) == 0);
+
+    fclose(oFile);
+
+    return writeOk;
 }
 
 DrawDebug::~DrawDebug() {
+    CleanUpBatches();
     CleanupAllCubeMesh();
 
     delete ZAxis;
@@ -121,11 +310,14 @@ irr::core::vector3df DrawDebug::GetOrthogonalVector(irr::core::vector3df inVec)
   return irr::core::vector3df((irr::f32)(g*h - x*x), (irr::f32)(- x * y), (irr::f32)(- x * h));
 }
 
-void DrawDebug::Draw3DArrow(irr::core::vector3df startPos, irr::core::vector3df arrowPosition, irr::f32 arrowOffset, ColorStruct* color, irr::f32 arrowSize) {
-    myDriver->setTransform(irr::video::ETS_WORLD, irr::core::IdentityMatrix);
+void DrawDebug::Draw3DArrow(irr::core::vector3df startPos, irr::core::vector3df arrowPosition, irr::f32 arrowOffset, ColorStruct* color,
+                            irr::f32 arrowSize, irr::u8 category) {
+    if (!IsCategoryEnabled(category))
+        return;
+
+    DrawDebugBatchStruct* batch = GetBatch(color);
 
-    myDriver->setMaterial(*color->material);
-    myDriver->draw3DLine(startPos, arrowPosition);
+    AddLine(batch, startPos, arrowPosition, category);
 
     irr::core::vector3df dirVec = (startPos - arrowPosition);
     dirVec.normalize();
@@ -138,10 +330,10 @@ void DrawDebug::Draw3DArrow(irr::core::vector3df startPos, irr::core::vector3df
     irr::core::vector3df otherVec = dp.crossProduct(oneNormal);
     otherVec.normalize();
 
-    myDriver->draw3DLine(arrowPosition, dp + oneNormal * arrowSize);
-    myDriver->draw3DLine(arrowPosition, dp - oneNormal * arrowSize);
-    myDriver->draw3DLine(arrowPosition, dp + otherVec * arrowSize);
-    myDriver->draw3DLine(arrowPosition, dp - otherVec * arrowSize);
+    AddLine(batch, arrowPosition, dp + oneNormal * arrowSize, category);
+    AddLine(batch, arrowPosition, dp - oneNormal * arrowSize, category);
+    AddLine(batch, arrowPosition, dp + otherVec * arrowSize, category);
+    AddLine(batch, arrowPosition, dp - otherVec * arrowSize, category);
 }
 
 void DrawDebug::DrawWorldCoordinateSystemArrows(void) {
@@ -150,14 +342,28 @@ void DrawDebug::DrawWorldCoordinateSystemArrows(void) {
     Draw3DArrow(*origin, *ZAxis, 0.0f, blue);
 }
 
-void DrawDebug::DrawAround3DBoundingBox(irr::core::aabbox3df* boundingBox, ColorStruct* color) {
-    if (boundingBox == nullptr)
+void DrawDebug::DrawAround3DBoundingBox(irr::core::aabbox3df* boundingBox, ColorStruct* color, irr::u8 category) {
+    if ((boundingBox == nullptr) || !IsCategoryEnabled(category))
         return;
 
-    myDriver->setMaterial(*color->material);
-    myDriver->setTransform(irr::video::ETS_WORLD, irr::core::IdentityMatrix);
-
-    myDriver->draw3DBox(*boundingBox);
+    DrawDebugBatchStruct* batch = GetBatch(color);
+
+    //same edge order as Irrlicht draw3DBox
+    irr::core::vector3df edges[8];
+    boundingBox->getEdges(edges);
+
+    AddLine(batch, edges[5], edges[1], category);
+    AddLine(batch, edges[1], edges[3], category);
+    AddLine(batch, edges[3], edges[7], category);
+    AddLine(batch, edges[7], edges[5], category);
+    AddLine(batch, edges[0], edges[2], category);
+    AddLine(batch, edges[2], edges[6], category);
+    AddLine(batch, edges[6], edges[4], category);
+    AddLine(batch, edges[4], edges[0], category);
+    AddLine(batch, edges[1], edges[0], category);
+    AddLine(batch, edges[3], edges[2], category);
+    AddLine(batch, edges[7], edges[6], category);
+    AddLine(batch, edges[5], edges[4], category);
 }
 
 void DrawDebug::InitCubeMesh() {
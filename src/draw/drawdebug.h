@@ -13,11 +13,38 @@
 #include <irrlicht.h>
 #include <vector>
 
+//categories of debug primitives, each category
+//can be enabled/disabled separately
+#define DEF_DRAWDEBUG_CAT_GENERAL 0
+#define DEF_DRAWDEBUG_CAT_WAYPOINTS 1
+#define DEF_DRAWDEBUG_CAT_LEVEL 2
+#define DEF_DRAWDEBUG_CAT_PHYSICS 3
+#define DEF_DRAWDEBUG_CAT_AIPATH 4
+#define DEF_DRAWDEBUG_CAT_COUNT 5
+
 struct ColorStruct {
     irr::video::SColor* color;
     irr::video::SMaterial* material;
 };
 
+//all debug primitives of one color (material) which are
+//collected during the current frame
+struct DrawDebugBatchStruct {
+    ColorStruct* color = nullptr;
+
+    //two vertices for each line
+    irr::core::array<irr::video::S3DVertex> lineVertices;
+    std::vector<irr::u8> lineCategories;
+
+    //three vertices for each (filled) triangle
+    irr::core::array<irr::video::S3DVertex> triangleVertices;
+    std::vector<irr::u8> triangleCategories;
+};
+
+//All Draw functions below do not draw immediately, they only add the primitives
+//to vertex arrays of the current frame (one array per color). All primitives
+//are drawn at once when Flush() is called, with one line list (and one triangle list)
+//draw call per color. All coordinates are world coordinates.
 class DrawDebug {
 
 public:
@@ -25,13 +52,38 @@ public:
     ~DrawDebug();
     void DrawWorldCoordinateSystemArrows();
     void Draw3DArrow(irr::core::vector3df startPos, irr::core::vector3df arrowPosition, irr::f32 arrowOffset,
-                     ColorStruct* color, irr::f32 arrowSize = 1.0f);
-    void Draw3DLine(irr::core::vector3df startPos, irr::core::vector3df endPos, ColorStruct* color);
-    void Draw3DTriangle(const irr::core::triangle3df *triangle, ColorStruct* color);
-    void Draw3DTriangleOutline(const irr::core::triangle3df *triangle, ColorStruct* color);
+                     ColorStruct* color, irr::f32 arrowSize = 1.0f, irr::u8 category = DEF_DRAWDEBUG_CAT_GENERAL);
+    void Draw3DLine(irr::core::vector3df startPos, irr::core::vector3df endPos, ColorStruct* color,
+                    irr::u8 category = DEF_DRAWDEBUG_CAT_GENERAL);
+    void Draw3DTriangle(const irr::core::triangle3df *triangle, ColorStruct* color, irr::u8 category = DEF_DRAWDEBUG_CAT_GENERAL);
+    void Draw3DTriangleOutline(const irr::core::triangle3df *triangle, ColorStruct* color,
+                               irr::u8 category = DEF_DRAWDEBUG_CAT_GENERAL);
     void Draw3DRectangle(irr::core::vector3df v1, irr::core::vector3df v2, irr::core::vector3df v3, irr::core::vector3df v4,
-                         ColorStruct* color);
-    void DrawAround3DBoundingBox(irr::core::aabbox3df* boundingBox, ColorStruct* color);
+                         ColorStruct* color, irr::u8 category = DEF_DRAWDEBUG_CAT_GENERAL);
+    void DrawAround3DBoundingBox(irr::core::aabbox3df* boundingBox, ColorStruct* color,
+                                 irr::u8 category = DEF_DRAWDEBUG_CAT_GENERAL);
+
+    //primitives of a disabled category are not collected at all
+    void SetCategoryEnabled(irr::u8 category, bool enabled);
+    bool IsCategoryEnabled(irr::u8 category);
+
+    //draws all primitives collected until now, and
+    //clears them afterwards for the next frame
+    void Flush();
+
+    //removes all collected primitives without drawing them
+    void Clear();
+
+    //writes all primitives collected until now (one primitive per text line) into a
+    //file, can be used to inspect the debug output of a frame offline, for example
+    //during a run without rendering; Needs to be called before Flush()
+    //returns true in case of success, false otherwise
+    bool DumpPrimitives(const char* fileName);
+
+    //statistics of the last Flush
+    irr::u32 mNrLinesLastFlush = 0;
+    irr::u32 mNrTrianglesLastFlush = 0;
+    irr::u32 mNrDrawCallsLastFlush = 0;
 
     //If specified color is not available, returns a white cube
     irr::scene::IMesh* GetCubeMeshWithColor(ColorStruct* whichColor);
@@ -69,6 +121,24 @@ private:
     ColorStruct* AddColor(irr::u32 alpha, irr::u32 r, irr::u32 g, irr::u32 b);
     void CleanUpColor(ColorStruct* whichColor);
 
+    //one batch for each used color
+    std::vector<DrawDebugBatchStruct*> mBatchVec;
+
+    //the batch which was used last, most of the time
+    //many primitives with the same color are added after each other
+    DrawDebugBatchStruct* mLastBatch = nullptr;
+
+    bool mCategoryEnabled[DEF_DRAWDEBUG_CAT_COUNT];
+
+    //index list 0, 1, 2, 3... shared by all draw calls
+    irr::core::array<irr::u32> mIndices;
+
+    DrawDebugBatchStruct* GetBatch(ColorStruct* color);
+    void AddLine(DrawDebugBatchStruct* batch, const irr::core::vector3df& startPos, const irr::core::vector3df& endPos,
+                 irr::u8 category);
+    void PrepareIndices(irr::u32 nrIndices);
+    void CleanUpBatches();
+
     //a simple Cube Mesh for Waypoint and Wallsegment level Editor
     //entity items
     std::vector<std::pair<ColorStruct*, irr::scene::IMesh*>> mCubeMeshVec;
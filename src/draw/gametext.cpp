@@ -10,6 +10,7 @@
 #include "gametext.h"
 #include "../infrabase.h"
 #include "../utils/logging.h"
+#include "spritebatch.h"
 
 //Loads a game font from the extracted (many) character image files
 //Parameters:
@@ -97,10 +98,17 @@ GameTextFont* GameText::LoadGameFont(char* fileName, const char *fileEnding, uns
 
       mInfra->mDriver->makeColorKeyTexture(newCharInfo->texture, newCharInfo->transColor);
 
+      //copy the character into the sprite batch atlas, so that
+      //all characters of a text can be drawn at once
+      newCharInfo->atlasEntry = mInfra->mSpriteBatch->AddToAtlas(newCharInfo->texture, newCharInfo->charRect);
+
       //add new character to our vector of characters for this font
       newFont->CharacterVector.push_back(newCharInfo);
   }
 
+  //upload the new characters into the atlas textures
+  mInfra->mSpriteBatch->UpdateAtlasTextures();
+
   mInfra->mDriver->setTextureCreationFlag(irr::video::ETCF_CREATE_MIP_MAPS, true);
 
   return newFont;
@@ -130,6 +138,15 @@ void GameText::FreeTextFont(GameTextFont &pntrFont) {
    delete &pntrFont;
 }
 
+void GameText::DrawCharacter(GameTextCharacterInfo* charInfo, irr::core::position2di position, irr::video::SColor renderColor) {
+    if (charInfo->atlasEntry != nullptr) {
+        mInfra->mSpriteBatch->Draw(charInfo->atlasEntry, position, renderColor, true);
+    } else {
+        //character is not in the atlas, use its own texture
+        mInfra->mSpriteBatch->Draw(charInfo->texture, position, charInfo->charRect, renderColor, true);
+    }
+}
+
 //Renders specified 2D text using irrlicht at the specified location
 //Parameters:
 //  text = Text which should be rendered (null terminated!)
@@ -145,11 +162,12 @@ void GameText::DrawGameText(char* text, GameTextFont *whichFont, irr::core::posi
     irr::core::vector2di correctCharPosition = position;
     irr::s16 charCnter = stopAfterNrChars;
 
+    //draw the whole text with one batch
+    mInfra->mSpriteBatch->Begin();
+
     while ((*pntr != 0) && ((charCnter > 0) || (stopAfterNrChars == -1))) {
         //draw current character
-        mInfra->mDriver->draw2DImage(whichFont->CharacterVector[*pntr]->texture, correctCharPosition,
-              whichFont->CharacterVector[*pntr]->charRect, 0,
-                  renderColor, true);
+        DrawCharacter(whichFont->CharacterVector[*pntr], correctCharPosition, renderColor);
 
         //calculate next char position
         correctCharPosition.X += whichFont->CharacterVector[*pntr]->charRect.getWidth();
@@ -159,6 +177,8 @@ void GameText::DrawGameText(char* text, GameTextFont *whichFont, irr::core::posi
         if (charCnter > 0)
             charCnter--;
      }
+
+    mInfra->mSpriteBatch->End();
   }
 }
 
@@ -244,6 +264,8 @@ void GameText::DrawHudSmallText(char* alphanumericalText, GameTextFont *whichHud
 
       irr::core::vector2di correctCharPosition = position;
 
+      mInfra->mSpriteBatch->Begin();
+
       while (*pntr != 0) {
           //different to the other (full text font) text output render function DrawGameText for
           //this function/fonts the vector of characters only contains uppercase A-Z, and no
@@ -261,9 +283,7 @@ void GameText::DrawHudSmallText(char* alphanumericalText, GameTextFont *whichHud
 
           if (!skipChar) {
               //draw current character
-              mInfra->mDriver->draw2DImage(whichHudFont->CharacterVector[index]->texture, correctCharPosition,
-                whichHudFont->CharacterVector[index]->charRect, 0,
-                    irr::video::SColor(255,255,255,255), true);
+              DrawCharacter(whichHudFont->CharacterVector[index], correctCharPosition, irr::video::SColor(255,255,255,255));
 
               //calculate next char position
               correctCharPosition.X += whichHudFont->CharacterVector[index]->charRect.getWidth();
@@ -271,6 +291,8 @@ void GameText::DrawHudSmallText(char* alphanumericalText, GameTextFont *whichHud
 
           pntr++;
       }
+
+      mInfra->mSpriteBatch->End();
     }
 }
 
@@ -289,6 +311,8 @@ void GameText::DrawGameNumberText(char* numberText, GameTextFont *whichFont, irr
 
     irr::core::vector2di correctCharPosition = position;
 
+    mInfra->mSpriteBatch->Begin();
+
     while (*pntr != 0) {
         //different to the other (full text font) text output render function DrawGameText for
         //this function/fonts the vector of characters only contains numbers 0 up to 9, and special for the red text
@@ -336,9 +360,7 @@ void GameText::DrawGameNumberText(char* numberText, GameTextFont *whichFont, irr
 
         if (!skipChar) {
             //draw current character
-            mInfra->mDriver->draw2DImage(whichFont->CharacterVector[index]->texture, correctCharPosition,
-              whichFont->CharacterVector[index]->charRect, 0,
-                  irr::video::SColor(255,255,255,255), true);
+            DrawCharacter(whichFont->CharacterVector[index], correctCharPosition, irr::video::SColor(255,255,255,255));
 
             //calculate next char position
             correctCharPosition.X += whichFont->CharacterVector[index]->charRect.getWidth();
@@ -346,6 +368,8 @@ void GameText::DrawGameNumberText(char* numberText, GameTextFont *whichFont, irr
 
         pntr++;
     }
+
+    mInfra->mSpriteBatch->End();
   }
 }
 
@@ -21,6 +21,7 @@
   ************************/
 
 class InfrastructureBase;
+struct SpriteBatchAtlasEntry;
 
 typedef struct GameTextCharacterInfo {
      //contains the texture for the character
@@ -36,6 +37,10 @@ typedef struct GameTextCharacterInfo {
      //contains the transparent color found for this
      //character
      irr::video::SColor transColor;
+
+     //location of the character inside of the sprite
+     //batch atlas, nullptr if not available
+     SpriteBatchAtlasEntry* atlasEntry = nullptr;
 } GameTextCharacterInfo;
 
 typedef struct GameTextFont {
@@ -54,6 +59,9 @@ private:
  
     void FreeTextFont(GameTextFont &pntrFont);
 
+    //queues a single character into the sprite batch
+    void DrawCharacter(GameTextCharacterInfo* charInfo, irr::core::position2di position, irr::video::SColor renderColor);
+
 public:
     GameText(InfrastructureBase* infra);
     ~GameText();
@@ -12,6 +12,7 @@
 #include "../models/player.h"
 #include "../utils/physics.h"
 #include "../draw/gametext.h"
+#include "../draw/spritebatch.h"
 #include "../race.h"
 
 //a negative altPanelTexNr input value means no alternative texture (image) is used
@@ -690,27 +691,21 @@ void HUD::DrawHUD1PlayerStartSignal(irr::f32 deltaTime) {
     }
 
     if (redLit) {
-         mGame->mDriver->draw2DImage((*startSignal)[0]->altTexture, (*startSignal)[0]->drawScrPosition,
-               (*startSignal)[0]->sourceRect, 0, *mColorSolid, true);
+         DrawHudDisplayPart((*startSignal)[0], true, *mColorSolid);
     } else {
-        mGame->mDriver->draw2DImage((*startSignal)[0]->texture, (*startSignal)[0]->drawScrPosition,
-              (*startSignal)[0]->sourceRect, 0, *mColorSolid, true);
+        DrawHudDisplayPart((*startSignal)[0], false, *mColorSolid);
     }
 
     if (yellowLit) {
-         mGame->mDriver->draw2DImage((*startSignal)[1]->altTexture, (*startSignal)[1]->drawScrPosition,
-               (*startSignal)[1]->sourceRect, 0, *mColorSolid, true);
+         DrawHudDisplayPart((*startSignal)[1], true, *mColorSolid);
     } else {
-        mGame->mDriver->draw2DImage((*startSignal)[1]->texture, (*startSignal)[1]->drawScrPosition,
-              (*startSignal)[1]->sourceRect, 0, *mColorSolid, true);
+        DrawHudDisplayPart((*startSignal)[1], false, *mColorSolid);
     }
 
     if (greenLit) {
-         mGame->mDriver->draw2DImage((*startSignal)[2]->altTexture, (*startSignal)[2]->drawScrPosition,
-               (*startSignal)[2]->sourceRect, 0, *mColorSolid, true);
+         DrawHudDisplayPart((*startSignal)[2], true, *mColorSolid);
     } else {
-        mGame->mDriver->draw2DImage((*startSignal)[2]->texture, (*startSignal)[2]->drawScrPosition,
-              (*startSignal)[2]->sourceRect, 0, *mColorSolid, true);
+        DrawHudDisplayPart((*startSignal)[2], false, *mColorSolid);
     }
 }
 
@@ -732,11 +727,9 @@ void HUD::DrawAmmoBar() {
 
     for (int i = 0; i < (addBarsInt + 1); i++) {
         if (!mDrawAmmoBarTransparent) {
-            mGame->mDriver->draw2DImage((*ammoBar)[i]->texture, (*ammoBar)[i]->drawScrPosition,
-                  (*ammoBar)[i]->sourceRect, 0, *mColorSolid, true);
+            DrawHudDisplayPart((*ammoBar)[i], false, *mColorSolid);
         } else {
-            mGame->mDriver->draw2DImage((*ammoBar)[i]->texture, (*ammoBar)[i]->drawScrPosition,
-                  (*ammoBar)[i]->sourceRect, 0, *mColorTransparent, true);
+            DrawHudDisplayPart((*ammoBar)[i], false, *mColorTransparent);
         }
     }
 }
@@ -757,11 +750,9 @@ void HUD::DrawShieldBar() {
     //draw as many shield bars as the current shield state of the ship allows
     for (int i = 0; i < barsInt ; i++) {
         if (!mDrawShieldBarTransparent) {
-            mGame->mDriver->draw2DImage((*shieldBar)[i]->texture, (*shieldBar)[i]->drawScrPosition,
-                  (*shieldBar)[i]->sourceRect, 0, *mColorSolid, true);
+            DrawHudDisplayPart((*shieldBar)[i], false, *mColorSolid);
         } else {
-            mGame->mDriver->draw2DImage((*shieldBar)[i]->texture, (*shieldBar)[i]->drawScrPosition,
-                  (*shieldBar)[i]->sourceRect, 0, *mColorTransparent, true);
+            DrawHudDisplayPart((*shieldBar)[i], false, *mColorTransparent);
         }
     }
 }
@@ -839,11 +830,9 @@ void HUD::DrawGasolineBar() {
 
     for (int i = (sizeVec - nrBarsToDraw); i < sizeVec; i++) {
         if (!mDrawGasolineBarTransparent) {
-            mGame->mDriver->draw2DImage((*gasolineBar)[i]->texture, (*gasolineBar)[i]->drawScrPosition,
-                  (*gasolineBar)[i]->sourceRect, 0, *mColorSolid, true);
+            DrawHudDisplayPart((*gasolineBar)[i], false, *mColorSolid);
         } else {
-            mGame->mDriver->draw2DImage((*gasolineBar)[i]->texture, (*gasolineBar)[i]->drawScrPosition,
-                  (*gasolineBar)[i]->sourceRect, 0, *mColorTransparent, true);
+            DrawHudDisplayPart((*gasolineBar)[i], false, *mColorTransparent);
         }
     }
 }
@@ -886,8 +875,7 @@ void HUD::DrawHUD1PlayerRace(irr::f32 deltaTime) {
             std::vector<HudDisplayPart*>::iterator itGlasBreak;
 
             for (itGlasBreak = this->monitorWhichPlayer->brokenGlasVec->begin(); itGlasBreak != this->monitorWhichPlayer->brokenGlasVec->end(); ++itGlasBreak) {
-                mGame->mDriver->draw2DImage((*itGlasBreak)->texture, (*itGlasBreak)->drawScrPosition,
-                      (*itGlasBreak)->sourceRect, 0, *mColorSolid, true);
+                DrawHudDisplayPart((*itGlasBreak), false, *mColorSolid);
             }
         }
 
@@ -914,14 +902,12 @@ void HUD::DrawHUD1PlayerRace(irr::f32 deltaTime) {
 
         //according to current player throttle setting draw unlighted default colors
         for (int i = 0; i < perc2; i++) {
-            mGame->mDriver->draw2DImage((*throttleBar)[i]->texture, (*throttleBar)[i]->drawScrPosition,
-                  (*throttleBar)[i]->sourceRect, 0, *mColorSolid, true);
+            DrawHudDisplayPart((*throttleBar)[i], false, *mColorSolid);
         }
 
         //according to current booster state draw over it with lighted colors
         for (int i = 0; i < perc; i++) {
-            mGame->mDriver->draw2DImage((*throttleBar)[i]->altTexture, (*throttleBar)[i]->drawScrPosition,
-                  (*throttleBar)[i]->sourceRect, 0, *mColorSolid, true);
+            DrawHudDisplayPart((*throttleBar)[i], true, *mColorSolid);
         }
 
         sizeVec = (int)(speedBar->size());
@@ -935,8 +921,7 @@ void HUD::DrawHUD1PlayerRace(irr::f32 deltaTime) {
             perc = (irr::f32)(sizeVec);
 
         for (int i = 0; i < perc; i++) {
-            mGame->mDriver->draw2DImage((*speedBar)[i]->texture, (*speedBar)[i]->drawScrPosition,
-                  (*speedBar)[i]->sourceRect, 0, *mColorSolid, true);
+            DrawHudDisplayPart((*speedBar)[i], false, *mColorSolid);
         }
 
         //Draw machine gun heat bar
@@ -951,30 +936,26 @@ void HUD::DrawHUD1PlayerRace(irr::f32 deltaTime) {
             perc = (irr::f32)(sizeVec);
 
         for (int i = 0; i < perc; i++) {
-            mGame->mDriver->draw2DImage((*mgHeatBar)[i]->texture, (*mgHeatBar)[i]->drawScrPosition,
-                  (*mgHeatBar)[i]->sourceRect, 0, *mColorSolid, true);
+            DrawHudDisplayPart((*mgHeatBar)[i], false, *mColorSolid);
         }
 
         //Draw upgrade bar
         //symbol number 0 is the minigun symbol itself (for basic upgrade level 0)
         //the next three symbols 1, 2 and 3 are for upgrade levels 1, 2 and 3
         for (int i = 0; i <= monitorWhichPlayer->mPlayerStats->currMinigunUpgradeLevel; i++) {
-            mGame->mDriver->draw2DImage((*upgradeBar)[i]->texture, (*upgradeBar)[i]->drawScrPosition,
-                  (*upgradeBar)[i]->sourceRect, 0, *mColorSolid, true);
+            DrawHudDisplayPart((*upgradeBar)[i], false, *mColorSolid);
         }
 
         //symbol number 4 is the rocket symbol itself (for basic upgrade level 0)
         //the next three symbols 5, 6 and 7 are for upgrade levels 1, 2 and 3
         for (int i = 4; i <= (monitorWhichPlayer->mPlayerStats->currRocketUpgradeLevel + 4); i++) {
-            mGame->mDriver->draw2DImage((*upgradeBar)[i]->texture, (*upgradeBar)[i]->drawScrPosition,
-                  (*upgradeBar)[i]->sourceRect, 0, *mColorSolid, true);
+            DrawHudDisplayPart((*upgradeBar)[i], false, *mColorSolid);
         }
 
         //symbol number 8 is the booster symbol itself (for basic upgrade level 0)
         //the next three symbols 9, 10 and 11 are for upgrade levels 1, 2 and 3
         for (int i = 8; i <= (monitorWhichPlayer->mPlayerStats->currBoosterUpgradeLevel + 8); i++) {
-            mGame->mDriver->draw2DImage((*upgradeBar)[i]->texture, (*upgradeBar)[i]->drawScrPosition,
-                  (*upgradeBar)[i]->sourceRect, 0, *mColorSolid, true);
+            DrawHudDisplayPart((*upgradeBar)[i], false, *mColorSolid);
         }
 
 
@@ -987,12 +968,10 @@ void HUD::DrawHUD1PlayerRace(irr::f32 deltaTime) {
         if (hlp > 9)
             hlp = 9;
 
-        mGame->mDriver->draw2DImage((*currRacePlayerPosition)[hlp]->texture, (*currRacePlayerPosition)[hlp]->drawScrPosition,
-              (*currRacePlayerPosition)[hlp]->sourceRect, 0, *mColorSolid, true);
+        DrawHudDisplayPart((*currRacePlayerPosition)[hlp], false, *mColorSolid);
 
         //draw the slash for player position (slash is #10 in the list)
-        mGame->mDriver->draw2DImage((*currRacePlayerPosition)[10]->texture, (*currRacePlayerPosition)[10]->drawScrPosition,
-              (*currRacePlayerPosition)[10]->sourceRect, 0, *mColorSolid, true);
+        DrawHudDisplayPart((*currRacePlayerPosition)[10], false, *mColorSolid);
 
         //draw overall number of players in race
         hlp = monitorWhichPlayer->mPlayerStats->overallPlayerNumber;
@@ -1004,8 +983,7 @@ void HUD::DrawHUD1PlayerRace(irr::f32 deltaTime) {
             hlp = 9;
 
         //draw the overall number of players in the race
-        mGame->mDriver->draw2DImage((*numberPlayers)[hlp]->texture, (*numberPlayers)[hlp]->drawScrPosition,
-              (*numberPlayers)[hlp]->sourceRect, 0, *mColorSolid, true);
+        DrawHudDisplayPart((*numberPlayers)[hlp], false, *mColorSolid);
 
         //render current lap number information
         char lapNumStr[10];
@@ -1545,9 +1523,7 @@ void HUD::RenderTextBannerGraphics() {
         if (elementsToDraw != nullptr) {
             //draw currently visible banner state
             for (unsigned long i = 0; i < elementsToDraw->size(); i++) {
-                mGame->mDriver->draw2DImage(elementsToDraw->at(i)->texture, elementsToDraw->at(i)->drawScrPosition,
-                      irr::core::rect<irr::s32>(0,0, elementsToDraw->at(i)->sizeTex.Width, elementsToDraw->at(i)->sizeTex.Height), 0,
-                      *mColorSolid, true);
+                DrawHudDisplayPart(elementsToDraw->at(i), false, *mColorSolid);
 
         }
 
@@ -1920,8 +1896,7 @@ void HUD::RenderTargetSymbol(irr::f32 deltaTime) {
 
           if (!monitorWhichPlayer->mTargetMissleLock) {
              //no missle lock, green symbol and green text
-             mGame->mDriver->draw2DImage(targetSymbol->texture, targetSymbol->drawScrPosition,
-                targetSymbol->sourceRect, 0, irr::video::SColor(255,255,255,255), true);
+             DrawHudDisplayPart(targetSymbol, false, irr::video::SColor(255,255,255,255));
 
                if (currShowTargetName) {
                     //write player name next to target symbol
@@ -1932,24 +1907,19 @@ void HUD::RenderTargetSymbol(irr::f32 deltaTime) {
                }
 
              //left green arrow
-             mGame->mDriver->draw2DImage(targetArrowLeft->texture, targetArrowLeft->drawScrPosition,
-                targetArrowLeft->sourceRect, 0, *mColorSolid, true);
+             DrawHudDisplayPart(targetArrowLeft, false, *mColorSolid);
 
              //right green arrow
-             mGame->mDriver->draw2DImage(targetArrowRight->texture, targetArrowRight->drawScrPosition,
-                targetArrowRight->sourceRect, 0, *mColorSolid, true);
+             DrawHudDisplayPart(targetArrowRight, false, *mColorSolid);
 
              //above green arrow
-             mGame->mDriver->draw2DImage(targetArrowAbove->texture, targetArrowAbove->drawScrPosition,
-                targetArrowAbove->sourceRect, 0, *mColorSolid, true);
+             DrawHudDisplayPart(targetArrowAbove, false, *mColorSolid);
 
              //below green arrow
-             mGame->mDriver->draw2DImage(targetArrowBelow->texture, targetArrowBelow->drawScrPosition,
-                targetArrowBelow->sourceRect, 0, *mColorSolid, true);
+             DrawHudDisplayPart(targetArrowBelow, false, *mColorSolid);
           } else {
               //we also have missile lock, red symbol and red text
-              mGame->mDriver->draw2DImage(targetSymbol->altTexture, targetSymbol->drawScrPosition,
-                 targetSymbol->sourceRect, 0, *mColorSolid, true);
+              DrawHudDisplayPart(targetSymbol, true, *mColorSolid);
 
               if (currShowTargetName) {
                 //write player name next to target symbol
@@ -1960,20 +1930,16 @@ void HUD::RenderTargetSymbol(irr::f32 deltaTime) {
               }
 
               //left red arrow
-              mGame->mDriver->draw2DImage(targetArrowLeft->altTexture, targetArrowLeft->drawScrPosition,
-                 targetArrowLeft->sourceRect, 0, *mColorSolid, true);
+              DrawHudDisplayPart(targetArrowLeft, true, *mColorSolid);
 
               //right red arrow
-              mGame->mDriver->draw2DImage(targetArrowRight->altTexture, targetArrowRight->drawScrPosition,
-                 targetArrowRight->sourceRect, 0, *mColorSolid, true);
+              DrawHudDisplayPart(targetArrowRight, true, *mColorSolid);
 
               //above red arrow
-              mGame->mDriver->draw2DImage(targetArrowAbove->altTexture, targetArrowAbove->drawScrPosition,
-                 targetArrowAbove->sourceRect, 0, *mColorSolid, true);
+              DrawHudDisplayPart(targetArrowAbove, true, *mColorSolid);
 
               //below red arrow
-              mGame->mDriver->draw2DImage(targetArrowBelow->altTexture, targetArrowBelow->drawScrPosition,
-                 targetArrowBelow->sourceRect, 0, *mColorSolid, true);
+              DrawHudDisplayPart(targetArrowBelow, true, *mColorSolid);
           }
 
           irr::core::rect<irr::s32> healthBarLocation;
@@ -1988,6 +1954,8 @@ void HUD::RenderTargetSymbol(irr::f32 deltaTime) {
           healthBarLocation.LowerRightCorner.Y = healthBarLocation.UpperLeftCorner.Y + 5;
 
           //draw a small health bar below the target symbol
+          //all images queued until now need to be drawn first
+          mGame->mSpriteBatch->Flush();
           mGame->mDriver->draw2DRectangle(*mColorTargetSymbolHealthBar, healthBarLocation, nullptr);
      }
 }
@@ -2027,6 +1995,35 @@ HUD::HUD(Game* game) {
     bannerMessageVec->clear();
 }
 
+void HUD::DrawHudDisplayPart(HudDisplayPart* part, bool useAltTexture, irr::video::SColor color) {
+    //not all Hud parts have a prepared source rect, in this
+    //case the whole texture is drawn
+    if (part->sourceRect.getArea() == 0) {
+        part->sourceRect.UpperLeftCorner.set(0, 0);
+        part->sourceRect.LowerRightCorner.set(part->sizeTex.Width, part->sizeTex.Height);
+    }
+
+    //the first time we draw this part, copy the images into the sprite batch
+    //atlas, so that most of the Hud can be drawn with only a few draw calls
+    if (!part->atlasSetupDone) {
+        part->atlasSetupDone = true;
+
+        if ((part->sizeTex.Width <= DEF_HUD_ATLAS_MAXPARTSIZE) && (part->sizeTex.Height <= DEF_HUD_ATLAS_MAXPARTSIZE)) {
+            part->atlasEntry = mGame->mSpriteBatch->AddToAtlas(part->texture, part->sourceRect);
+            part->altAtlasEntry = mGame->mSpriteBatch->AddToAtlas(part->altTexture, part->sourceRect);
+        }
+    }
+
+    irr::video::ITexture* texture = useAltTexture ? part->altTexture : part->texture;
+    SpriteBatchAtlasEntry* entry = useAltTexture ? part->altAtlasEntry : part->atlasEntry;
+
+    if (entry != nullptr) {
+        mGame->mSpriteBatch->Draw(entry, part->drawScrPosition, color, true);
+    } else {
+        mGame->mSpriteBatch->Draw(texture, part->drawScrPosition, part->sourceRect, color, true);
+    }
+}
+
 void HUD::CleanUpHudDisplayPartVector(std::vector<HudDisplayPart*> &pntrVector) {
     std::vector<HudDisplayPart*>::iterator itHudDisplayPart;
     HudDisplayPart* pntr;
@@ -33,12 +33,29 @@
 #define DEF_HUD_STARTSIGNAL_YELLOW_LIT 2
 #define DEF_HUD_STARTSIGNAL_GREEN_LIT 3
 
+//Hud images up to this size (width and height in pixels) are copied
+//into the sprite batch atlas, bigger ones (like the broken glas) are
+//drawn with their own texture
+#define DEF_HUD_ATLAS_MAXPARTSIZE 128
+
+/************************
+ * Forward declarations *
+ ************************/
+
+struct SpriteBatchAtlasEntry;
+
 struct HudDisplayPart{
      irr::core::vector2d<irr::s32> drawScrPosition;
      irr::video::ITexture* texture = nullptr;
      irr::video::ITexture* altTexture = nullptr;
      irr::core::dimension2d<irr::s32> sizeTex;
      irr::core::rect<irr::s32> sourceRect;
+
+     //location of texture and altTexture inside the sprite batch atlas,
+     //is setup the first time the part is drawn
+     SpriteBatchAtlasEntry* atlasEntry = nullptr;
+     SpriteBatchAtlasEntry* altAtlasEntry = nullptr;
+     bool atlasSetupDone = false;
 };
 
 class Player; //Forward declaration
@@ -150,6 +167,10 @@ private:
 
     void CleanUpHudDisplayPartVector(std::vector<HudDisplayPart*> &pntrVector);
 
+    //draws a Hud part with the sprite batch, if useAltTexture is true
+    //the alternative texture of the part is drawn
+    void DrawHudDisplayPart(HudDisplayPart* part, bool useAltTexture, irr::video::SColor color);
+
     //************************************
     //* Player target resources          *
     //************************************
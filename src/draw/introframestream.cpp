@@ -0,0 +1,220 @@
+/*
+ Copyright (C) 2026 Wolf Alexander
+
+ This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.                                          */
+
+#include "introframestream.h"
+#include "../resources/xbrz-1-8/xbrz.h"
+#include "../utils/logging.h"
+#include <cstring>
+#include <string>
+
+FliMemoryFileInterface::FliMemoryFileInterface(const std::vector<uint8_t>* data) {
+    mData = data;
+}
+
+bool FliMemoryFileInterface::ok() const {
+    return mOk;
+}
+
+size_t FliMemoryFileInterface::tell() {
+    return mPos;
+}
+
+void FliMemoryFileInterface::seek(size_t absPos) {
+    mPos = absPos;
+}
+
+uint8_t FliMemoryFileInterface::read8() {
+    if (mPos >= mData->size()) {
+        mOk = false;
+        return 0;
+    }
+
+    return (*mData)[mPos++];
+}
+
+void FliMemoryFileInterface::write8(uint8_t) {
+    //the data is read only
+    mOk = false;
+}
+
+IntroFrameStream::IntroFrameStream() {
+}
+
+IntroFrameStream::~IntroFrameStream() {
+    Stop();
+
+    delete mDecoder;
+    delete mFileInterface;
+}
+
+bool IntroFrameStream::Open(irr::io::IFileSystem* fileSystem, const char* fliFileName) {
+    irr::io::IReadFile* file = fileSystem->createAndOpenFile(fliFileName);
+
+    if (file == nullptr) {
+        std::string msg("IntroFrameStream: Could not open ");
+        msg.append(fliFileName);
+        logging::Error(msg);
+        return false;
+    }
+
+    mFliData.resize((size_t)(file->getSize()));
+    bool readOk = (file->read(mFliData.data(), (irr::u32)(mFliData.size())) == (irr::s32)(mFliData.size()));
+    file->drop();
+
+    if (!readOk) {
+        std::string msg("IntroFrameStream: Could not read ");
+        msg.append(fliFileName);
+        logging::Error(msg);
+        return false;
+    }
+
+    mFileInterface = new FliMemoryFileInterface(&mFliData);
+    mDecoder = new flic::Decoder(mFileInterface);
+
+    if (!mDecoder->readHeader(mHeader) || (mHeader.frames <= 0) || (mHeader.width <= 0) || (mHeader.height <= 0)) {
+        std::string msg("IntroFrameStream: Invalid FLI header in file ");
+        msg.append(fliFileName);
+        logging::Error(msg);
+        return false;
+    }
+
+    irr::core::dimension2du frameSize = GetFrameSize();
+
+    for (irr::u32 idx = 0; idx < DEF_INTRO_RINGBUFFER_FRAMES; idx++) {
+        mRing[idx].pixels.resize((size_t)(frameSize.Width) * frameSize.Height);
+    }
+
+    return true;
+}
+
+void IntroFrameStream::Start() {
+    if ((mDecoder == nullptr) || mWorker.joinable())
+        return;
+
+    mWorker = std::thread(&IntroFrameStream::WorkerThread, this);
+}
+
+void IntroFrameStream::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStop = true;
+    }
+
+    mSpaceCondition.notify_all();
+
+    if (mWorker.joinable()) {
+        mWorker.join();
+    }
+}
+
+irr::u32 IntroFrameStream::GetNrFrames() {
+    return (irr::u32)(mHeader.frames);
+}
+
+irr::core::dimension2du IntroFrameStream::GetFrameSize() {
+    return irr::core::dimension2du((irr::u32)(mHeader.width) * DEF_INTRO_UPSCALE_FACTOR,
+                                   (irr::u32)(mHeader.height) * DEF_INTRO_UPSCALE_FACTOR);
+}
+
+bool IntroFrameStream::HasFailed() {
+    return mDecodeFailed;
+}
+
+bool IntroFrameStream::CopyFrame(irr::u32 frameNr, uint32_t* dest, irr::u32 destPitch) {
+    bool frameAvailable = false;
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        //drop all frames that are older than the
+        //requested one, they are not needed anymore
+        while ((mNrQueued > 0) && (mRing[mReadIdx].frameNr < frameNr)) {
+            mReadIdx = (mReadIdx + 1) % DEF_INTRO_RINGBUFFER_FRAMES;
+            mNrQueued--;
+        }
+
+        if ((mNrQueued > 0) && (mRing[mReadIdx].frameNr == frameNr)) {
+            irr::core::dimension2du frameSize = GetFrameSize();
+            const uint32_t* src = mRing[mReadIdx].pixels.data();
+
+            for (irr::u32 y = 0; y < frameSize.Height; y++) {
+                memcpy((irr::u8*)(dest) + (size_t)(y) * destPitch, src + (size_t)(y) * frameSize.Width,
+                       frameSize.Width * sizeof(uint32_t));
+            }
+
+            mReadIdx = (mReadIdx + 1) % DEF_INTRO_RINGBUFFER_FRAMES;
+            mNrQueued--;
+
+            frameAvailable = true;
+        }
+    }
+
+    //the worker can continue now
+    mSpaceCondition.notify_one();
+
+    return frameAvailable;
+}
+
+void IntroFrameStream::WorkerThread() {
+    irr::u32 width = (irr::u32)(mHeader.width);
+    irr::u32 height = (irr::u32)(mHeader.height);
+
+    //the decoder changes only parts of the frame for most
+    //frames, therefore the indexed frame buffer must be kept
+    std::vector<uint8_t> indexedPixels((size_t)(width) * height, 0);
+    std::vector<uint32_t> srcPixels((size_t)(width) * height);
+
+    flic::Frame frame;
+    frame.pixels = indexedPixels.data();
+    frame.rowstride = width;
+
+    for (irr::u32 frameNr = 0; frameNr < (irr::u32)(mHeader.frames); frameNr++) {
+        if (!mDecoder->readFrame(frame)) {
+            char hlpstr[100];
+            snprintf(hlpstr, 100, "IntroFrameStream: Error decoding intro frame %u", frameNr);
+            logging::Error(hlpstr);
+
+            mDecodeFailed = true;
+            return;
+        }
+
+        for (size_t idx = 0; idx < indexedPixels.size(); idx++) {
+            flic::Color color = frame.colormap[indexedPixels[idx]];
+            srcPixels[idx] = 0xFF000000 | (color.r << 16) | (color.g << 8) | color.b;
+        }
+
+        //wait until there is space in the ring buffer
+        irr::u32 writeIdx;
+
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+
+            mSpaceCondition.wait(lock, [this]() {
+                return (mStop || (mNrQueued < DEF_INTRO_RINGBUFFER_FRAMES));
+            });
+
+            if (mStop)
+                return;
+
+            writeIdx = (mReadIdx + mNrQueued) % DEF_INTRO_RINGBUFFER_FRAMES;
+        }
+
+        //the main thread does not access this slot until it is queued,
+        //therefore we can upscale without holding the lock; The intro
+        //has no transparency, the alpha channel does not need to be scaled
+        xbrz::scale(DEF_INTRO_UPSCALE_FACTOR, srcPixels.data(), mRing[writeIdx].pixels.data(), width, height,
+                    xbrz::ColorFormat::RGB, xbrz::ScalerCfg(), 0, height);
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mRing[writeIdx].frameNr = frameNr;
+            mNrQueued++;
+        }
+    }
+}
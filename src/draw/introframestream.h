@@ -0,0 +1,121 @@
+/*
+ Copyright (C) 2026 Wolf Alexander
+
+ This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.                                          */
+
+#ifndef INTROFRAMESTREAM_H
+#define INTROFRAMESTREAM_H
+
+#include "irrlicht.h"
+#include <vector>
+#include <cstdint>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include "../resources/intro/flic.h"
+
+//the repaired FLI file of the original game intro,
+//written by the data extraction
+#define DEF_INTRO_FLI_FILE "extract/intro/intro.fli"
+
+//number of decoded frames the decoder
+//can run ahead of the intro playback
+#define DEF_INTRO_RINGBUFFER_FRAMES 8
+
+//the original frames (320x200) are upscaled
+//with xBRZ by this factor
+#define DEF_INTRO_UPSCALE_FACTOR 2
+
+//flic::FileInterface for a FLI file that is
+//completely stored in memory (read only)
+class FliMemoryFileInterface : public flic::FileInterface {
+public:
+    FliMemoryFileInterface(const std::vector<uint8_t>* data);
+
+    bool ok() const override;
+    size_t tell() override;
+    void seek(size_t absPos) override;
+    uint8_t read8() override;
+    void write8(uint8_t value) override;
+
+private:
+    const std::vector<uint8_t>* mData = nullptr;
+    size_t mPos = 0;
+    bool mOk = true;
+};
+
+//one decoded and upscaled frame in the ring buffer
+typedef struct IntroRingFrameStruct {
+    irr::u32 frameNr = 0;
+
+    //pixels in ECF_A8R8G8B8 format, without padding
+    std::vector<uint32_t> pixels;
+} IntroRingFrameStruct;
+
+//Decodes the game intro directly from the FLI file: A worker thread decodes and upscales the frames
+//in order, and puts them into a small ring buffer. The worker waits as soon as the ring buffer is
+//full, so only DEF_INTRO_RINGBUFFER_FRAMES frames are in memory at the same time. The intro player
+//takes the frames out of the ring buffer on the main thread
+class IntroFrameStream {
+public:
+    IntroFrameStream();
+
+    //stops the worker thread
+    ~IntroFrameStream();
+
+    //Reads the complete FLI file (via the Irrlicht file system, so that the asset archive
+    //is used as well) and its header; Returns false if the file could not be read
+    bool Open(irr::io::IFileSystem* fileSystem, const char* fliFileName);
+
+    //starts decoding on the worker thread
+    void Start();
+
+    //stops the worker thread, can be called more than once
+    void Stop();
+
+    irr::u32 GetNrFrames();
+
+    //size of the upscaled frames
+    irr::core::dimension2du GetFrameSize();
+
+    //Copies the frame with number frameNr into dest (ECF_A8R8G8B8, destPitch bytes per line). Frames
+    //before frameNr that are still in the ring buffer were not needed in time, and are dropped. Returns
+    //false if the frame is not decoded yet; Then the caller should keep showing the last frame
+    bool CopyFrame(irr::u32 frameNr, uint32_t* dest, irr::u32 destPitch);
+
+    //true if the worker stopped because of a FLI decoding error
+    bool HasFailed();
+
+private:
+    std::vector<uint8_t> mFliData;
+
+    FliMemoryFileInterface* mFileInterface = nullptr;
+    flic::Decoder* mDecoder = nullptr;
+    flic::Header mHeader;
+
+    std::thread mWorker;
+    std::mutex mMutex;
+
+    //signaled when the main thread took a frame
+    //out of the ring buffer, or the worker needs to stop
+    std::condition_variable mSpaceCondition;
+
+    IntroRingFrameStruct mRing[DEF_INTRO_RINGBUFFER_FRAMES];
+
+    //index of the oldest frame in the ring buffer,
+    //and the number of frames in the ring buffer
+    irr::u32 mReadIdx = 0;
+    irr::u32 mNrQueued = 0;
+
+    bool mStop = false;
+    std::atomic<bool> mDecodeFailed{false};
+
+    void WorkerThread();
+};
+
+#endif // INTROFRAMESTREAM_H
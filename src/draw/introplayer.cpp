@@ -8,6 +8,7 @@
  You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.                                          */
 
 #include "introplayer.h"
+#include "introframestream.h"
 #include "../input/input.h"
 #include "../audio/music.h"
 #include "../audio/sound.h"
@@ -60,10 +61,24 @@ void IntroPlayer::RenderIntro(irr::f32 frameDeltaTime) {
                    irr::core::rect<irr::s32>(0, 0, mGame->mScreenRes.Width, mGame->mScreenRes.Height));
 
     if (introPlaying) {
-        //draw the current intro frame
-        mGame->mDriver->draw2DImage(this->introTextures->at(currIntroFrame), introFrameScrDrawPos,
-                          irr::core::recti(0, 0, introFrameScrSize.Width, introFrameScrSize.Height)
-                            , 0, irr::video::SColor(255,255,255,255), true);
+        UpdateFrameTexture(currIntroFrame);
+
+        //if the decoder can not deliver
+        //any frames anymore end the intro
+        if (mFrameStream->HasFailed() && (mTextureFrameNr != (irr::s32)(currIntroFrame))) {
+            currIntroFrame = numIntroFrame;
+            return;
+        }
+
+        //draw the current intro frame, the texture can be larger
+        //than the frame if the driver needs power of two textures
+        irr::core::dimension2du texSize = mFrameTexture->getSize();
+
+        mGame->mDriver->draw2DImage(mFrameTexture,
+                          irr::core::recti(introFrameScrDrawPos.X, introFrameScrDrawPos.Y,
+                                           introFrameScrDrawPos.X + introFrameScrSize.Width,
+                                           introFrameScrDrawPos.Y + introFrameScrSize.Height),
+                          irr::core::recti(0, 0, texSize.Width, texSize.Height));
 
         if (currIntroFrame > 0) {
             introCurrTimeBetweenFramesSec += frameDeltaTime;
@@ -96,7 +111,7 @@ void IntroPlayer::RenderIntro(irr::f32 frameDeltaTime) {
             //time to trigger the next sound event?
             if (introAbsTimeSound >= pntr->triggerAbsTime) {
                 //looping sound?
-	         pntr->soundBufPntr = mSoundEngine->PlaySound(pntr->soundResId, pntr->looping ? true : false);
+	         pntr->soundHandle = mSoundEngine->PlaySound(pntr->soundResId, pntr->looping ? true : false);
 	         pntr->loopSoundActive = pntr->looping ? true : false;
 
                 //is there one additional intro sound trigger event available
@@ -125,45 +140,46 @@ bool IntroPlayer::Init() {
          return false;
     }
 
-    //first we need to load all textures (each frame is a texture) for the game intro
+    //the intro is decoded from the FLI file on a worker thread while it is playing,
+    //start decoding now so that the first frames are ready when the intro starts
+    mFrameStream = new IntroFrameStream();
+
+    if (!mFrameStream->Open(mGame->mDevice->getFileSystem(), DEF_INTRO_FLI_FILE)) {
+        logging::Error("Intro FLI file loading error");
+        return false;
+    }
+
+    mFrameStream->Start();
+
+    introFrameScrSize = mFrameStream->GetFrameSize();
+
+    //one texture for all frames, the intro frames
+    //are never drawn scaled, we do not need mipmaps
+    bool mipMapsEnabled = mGame->mDriver->getTextureCreationFlag(irr::video::ETCF_CREATE_MIP_MAPS);
     mGame->mDriver->setTextureCreationFlag(irr::video::ETCF_CREATE_MIP_MAPS, false);
 
-    char frameFileName[50];
-    char fname[20];
-
-    introTextures = new std::vector<irr::video::ITexture*>();
-    introTextures->clear();
-
-    irr::video::ITexture* newTex;
-
-    for (long frameNr = 0; frameNr < 548; frameNr++) {
-        //first build the name for the image file to load
-        //that we have prepared during the first start of the game
-        strcpy(frameFileName, "extract/intro/frame");
-        //sprintf (fname, "%0*lu.png", 4, frameNr);
-        //28.12.2025: Changed from png image format to jpg today,
-        //to save a lot of disc space for video sequence storage
-        //sprintf (fname, "%0*lu.png", 4, frameNr);
-        sprintf (fname, "%0*lu.jpg", 4, frameNr);
-        strcat(frameFileName, fname);
-
-        //load this image (texture)
-        newTex = mGame->mDriver->getTexture(frameFileName);
-        if (newTex == nullptr) {
-            //there was a texture loading error
-            //std::cout << "Intro image loading error" << std::endl;
-            logging::Error("Intro image loading error");
-
-            return false;
-        }
+    mFrameTexture = mGame->mDriver->addTexture(introFrameScrSize, "IntroFrameStream", irr::video::ECF_A8R8G8B8);
 
-        introTextures->push_back(newTex);
+    mGame->mDriver->setTextureCreationFlag(irr::video::ETCF_CREATE_MIP_MAPS, mipMapsEnabled);
+
+    if (mFrameTexture == nullptr) {
+        logging::Error("Intro texture creation error");
+        return false;
     }
 
-    mGame->mDriver->setTextureCreationFlag(irr::video::ETCF_CREATE_MIP_MAPS, true);
+    //the decoded frames are copied into this image, which converts
+    //them into the color format and size of the texture
+    mFramePixels.resize((size_t)(introFrameScrSize.Width) * introFrameScrSize.Height, 0xFF000000);
+    mFrameImage = mGame->mDriver->createImageFromData(irr::video::ECF_A8R8G8B8, introFrameScrSize,
+                                                      mFramePixels.data(), true, false);
 
-    //get size of texture from first frame
-    introFrameScrSize = introTextures->at(0)->getSize();
+    if (mFrameImage == nullptr) {
+        logging::Error("Intro image creation error");
+        return false;
+    }
+
+    //the texture stays black until the first frame is decoded
+    CopyFrameImageToTexture();
 
     //calculate position to draw intro frames so that the are centered on the screen
     //because maybe target resolution does not fit with image resolution
@@ -219,7 +235,7 @@ void IntroPlayer::Play() {
         return;
 
    currIntroFrame = 0;
-   numIntroFrame = 548;
+   numIntroFrame = mFrameStream->GetNrFrames();
 
    //start with the first sound event element at idx 0
    currIdxSoundEventVec = 0;
@@ -240,6 +256,31 @@ void IntroPlayer::Play() {
    introFinished = false;
 }
 
+void IntroPlayer::UpdateFrameTexture(irr::u32 frameNr) {
+    if (mTextureFrameNr == (irr::s32)(frameNr))
+        return;
+
+    if (!mFrameStream->CopyFrame(frameNr, mFramePixels.data(), introFrameScrSize.Width * sizeof(uint32_t)))
+        return;
+
+    CopyFrameImageToTexture();
+
+    mTextureFrameNr = (irr::s32)(frameNr);
+}
+
+void IntroPlayer::CopyFrameImageToTexture() {
+    void* texData = mFrameTexture->lock(irr::video::ETLM_WRITE_ONLY);
+
+    if (texData == nullptr)
+        return;
+
+    irr::core::dimension2du texSize = mFrameTexture->getSize();
+
+    mFrameImage->copyToScaling(texData, texSize.Width, texSize.Height,
+                               mFrameTexture->getColorFormat(), mFrameTexture->getPitch());
+    mFrameTexture->unlock();
+}
+
 void IntroPlayer::IntroProcessLoopingSounds(irr::f32 currSoundPlayingTime) {
   std::vector<IntroSoundTriggerStruct*>::iterator it;
 
@@ -247,8 +288,7 @@ void IntroPlayer::IntroProcessLoopingSounds(irr::f32 currSoundPlayingTime) {
       if ((*it)->loopSoundActive) {
           //is it time to stop the looping sound
           if (currSoundPlayingTime >= (*it)->endLoopingAbsTime) {
-              if ((*it)->soundBufPntr != nullptr)
-                       (*it)->soundBufPntr->stop();
+              mSoundEngine->StopSound((*it)->soundHandle);
               (*it)->loopSoundActive = false;
           }
       }
@@ -268,21 +308,26 @@ void IntroPlayer::AddIntroSoundTrigger(irr::f32 absTriggerTime, uint8_t soundIdN
    this->introSoundEventVec->push_back(newTrigger);
 }
 
-//This function cleans up the 548 textures we had to load for the intro
+//This function cleans up the intro frame decoding and texture
 //Important after the intro!
 void IntroPlayer::CleanupIntro() {
-   std::vector<irr::video::ITexture*>::iterator it;
+   //stops the decoder worker thread
+   if (mFrameStream != nullptr) {
+       delete mFrameStream;
+       mFrameStream = nullptr;
+   }
 
-   //free each of the textures we loaded before
-   for (it = this->introTextures->begin(); it != this->introTextures->end(); ++it) {
-        //remove underlying texture
-        mGame->mDriver->removeTexture((*it));
+   if (mFrameImage != nullptr) {
+       mFrameImage->drop();
+       mFrameImage = nullptr;
    }
 
-   //free vector at the end
-   delete introTextures;
+   if (mFrameTexture != nullptr) {
+       //remove underlying texture
+       mGame->mDriver->removeTexture(mFrameTexture);
+       mFrameTexture = nullptr;
+   }
 
    //unload additional sound resources
    mSoundEngine->UnLoadSoundResourcesIntro();
 }
-
@@ -13,6 +13,7 @@
 #include "irrlicht.h"
 #include <vector>
 #include "SFML/Audio.hpp"
+#include "../audio/voicealloc.h"
 #include <cstdint>
 
 //this struct holds the information for a sound trigger event
@@ -37,10 +38,11 @@ typedef struct IntroSoundTriggerStruct {
     irr::f32 endLoopingAbsTime;
 
     //needed for looping sounds
-    sf::Sound* soundBufPntr = nullptr;
+    VoiceHandleStruct soundHandle;
 } IntroSoundTriggerStruct;
 
 class SoundEngine; //Forward declaration
+class IntroFrameStream; //Forward declaration
 class MyMusicStream; //forward declaration
 class Game; //Forward declaration
 
@@ -69,7 +71,17 @@ class IntroPlayer {
     Game* mGame = nullptr;
 
     //stuff for game intro playing
-    std::vector<irr::video::ITexture*>* introTextures = nullptr;
+    //the frames are decoded from the FLI file while the intro
+    //is playing, and shown with a single streaming texture
+    IntroFrameStream* mFrameStream = nullptr;
+    irr::video::ITexture* mFrameTexture = nullptr;
+    irr::video::IImage* mFrameImage = nullptr;
+    std::vector<uint32_t> mFramePixels;
+
+    //number of the frame that is currently in mFrameTexture,
+    //-1 if there is no frame in the texture yet
+    irr::s32 mTextureFrameNr = -1;
+
     irr::u32 currIntroFrame;
     irr::u32 numIntroFrame;
     irr::core::vector2di introFrameScrDrawPos;
@@ -90,6 +102,11 @@ class IntroPlayer {
                               bool looping = false,  irr::f32 endLoopingTime = 0.0f);
     void IntroProcessLoopingSounds(irr::f32 currSoundPlayingTime);
 
+    //copies the specified frame into the streaming texture, if
+    //it is decoded already; Otherwise the last frame stays visible
+    void UpdateFrameTexture(irr::u32 frameNr);
+    void CopyFrameImageToTexture();
+
     void CleanupIntro();
 
 };
@@ -3137,6 +3137,13 @@ void Menue::InitVehicleModels() {
           vecSceneNodePntr->clear();
           for (int i = 0; i < 8; i++) {
             newSceneNode = smgrMenue->addMeshSceneNode(this->mGameAssets->mCraftVec->at(j)->MeshCraft.at(i));
+
+            //color schemes that share the mesh of the first
+            //color scheme only differ in the texture
+            if (this->mGameAssets->mCraftVec->at(j)->TexCraft.at(i) != nullptr) {
+                newSceneNode->setMaterialTexture(0, this->mGameAssets->mCraftVec->at(j)->TexCraft.at(i));
+            }
+
             newSceneNode->setVisible(true);
             newSceneNode->setMaterialFlag(irr::video::EMF_LIGHTING, false);
 
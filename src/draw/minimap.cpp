@@ -11,6 +11,7 @@
 #include "minimap.h"
 #include "../utils/fileutils.h"
 #include "../utils/logging.h"
+#include "spritebatch.h"
 
 MiniMap::MiniMap(InfrastructureBase* infra, irr::core::vector2di lowerRightCorner,
                  MapConfigStruct* mapConfig, std::string levelRootDir) {
@@ -71,9 +72,17 @@ void MiniMap::DrawMiniMap(irr::f32 frameDeltaTime, std::vector<irr::core::vector
     if (!mMiniMapInitOk)
         return;
 
-    mInfra->mDriver->draw2DImage(baseMiniMap, miniMapDrawLocation,
-             miniMapImageUsedArea, 0,
-             irr::video::SColor(255,255,255,255), true);
+    //draw the minimap and all markers together
+    //with as few draw calls as possible
+    mInfra->mSpriteBatch->Begin();
+
+    if (mBaseMiniMapAtlasEntry != nullptr) {
+        mInfra->mSpriteBatch->Draw(mBaseMiniMapAtlasEntry, miniMapDrawLocation,
+                 irr::video::SColor(255,255,255,255), true);
+    } else {
+        mInfra->mSpriteBatch->Draw(baseMiniMap, miniMapDrawLocation,
+                 miniMapImageUsedArea, irr::video::SColor(255,255,255,255), true);
+    }
 
     //we want to blink the human player location
     //marker
@@ -104,7 +113,7 @@ void MiniMap::DrawMiniMap(irr::f32 frameDeltaTime, std::vector<irr::core::vector
                 //for blinking effect draw bigger frame block for player 1
                 //only draw it for blinking effect
                 if (miniMapBlinkActive) {
-                    mInfra->mDriver->draw2DRectangle(player1LocationFrameColor,
+                    mInfra->mSpriteBatch->DrawRectangle(player1LocationFrameColor,
                                          core::rect<s32>(playerLocation.Width - 5, playerLocation.Height -5,
                                                          playerLocation.Width + 5, playerLocation.Height + 5));
                 }
@@ -112,12 +121,14 @@ void MiniMap::DrawMiniMap(irr::f32 frameDeltaTime, std::vector<irr::core::vector
         }
 
         //draw the default marker for all available players
-        mInfra->mDriver->draw2DRectangle(*mMiniMapMarkerColors.at(playerIdx),
+        mInfra->mSpriteBatch->DrawRectangle(*mMiniMapMarkerColors.at(playerIdx),
                                  core::rect<s32>(playerLocation.Width - 3, playerLocation.Height - 3,
                                                  playerLocation.Width + 3, playerLocation.Height + 3));
 
         playerIdx++;
     }
+
+    mInfra->mSpriteBatch->End();
 }
 
 irr::core::dimension2di MiniMap::CalcPlayerMiniMapPosition(irr::core::vector2di inputCoord) {
@@ -199,6 +210,10 @@ bool MiniMap::InitMiniMap() {
     //miniMapDrawLocation.X = this->mGameScreenRes.Width - miniMapSize.Width;
     //miniMapDrawLocation.Y = this->mGameScreenRes.Height - miniMapSize.Height;
 
+    //the minimap image does not change during the race, copy
+    //it into the sprite batch atlas together with the HUD images
+    mBaseMiniMapAtlasEntry = mInfra->mSpriteBatch->AddToAtlas(baseMiniMap, miniMapImageUsedArea);
+
     miniMapSize.Width = miniMapImageUsedArea.getWidth();
     miniMapSize.Height = miniMapImageUsedArea.getHeight();
 
@@ -15,6 +15,7 @@
 #include <string>
 
 class InfrastructureBase; //Forward declaration
+struct SpriteBatchAtlasEntry; //Forward declaration
 struct MapConfigStruct; //Forward declaration
 
 class MiniMap {
@@ -31,6 +32,10 @@ private:
     //the image for the base of the minimap
     //without the player location dots
     irr::video::ITexture* baseMiniMap = nullptr;
+
+    //copy of the used minimap area in the sprite batch atlas,
+    //nullptr if it did not fit into the atlas
+    SpriteBatchAtlasEntry* mBaseMiniMapAtlasEntry = nullptr;
     irr::core::dimension2di miniMapSize;
     irr::core::vector2d<irr::s32> miniMapDrawLocation;
 
@@ -0,0 +1,375 @@
+/*
+ Copyright (C) 2026 Wolf Alexander
+
+ This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.                                          */
+
+#include "spritebatch.h"
+#include "../infrabase.h"
+#include "../utils/logging.h"
+#include <cstdio>
+
+SpriteBatch::SpriteBatch(InfrastructureBase* infra) {
+    mInfra = infra;
+
+    mQuadVec.reserve(1024);
+    mBatchPositions.reallocate(1024);
+    mBatchSourceRects.reallocate(1024);
+}
+
+SpriteBatch::~SpriteBatch() {
+    std::vector<SpriteBatchAtlasEntry*>::iterator itEntry;
+
+    for (itEntry = mAtlasEntryVec.begin(); itEntry != mAtlasEntryVec.end(); ++itEntry) {
+        delete (*itEntry);
+    }
+
+    mAtlasEntryVec.clear();
+
+    std::vector<SpriteBatchAtlasPage*>::iterator itPage;
+
+    for (itPage = mAtlasPageVec.begin(); itPage != mAtlasPageVec.end(); ++itPage) {
+        if ((*itPage)->image != nullptr) {
+            (*itPage)->image->drop();
+        }
+
+        if ((*itPage)->texture != nullptr) {
+            mInfra->mDriver->removeTexture((*itPage)->texture);
+        }
+
+        delete (*itPage);
+    }
+
+    mAtlasPageVec.clear();
+}
+
+SpriteBatchAtlasPage* SpriteBatch::CreateAtlasPage() {
+    SpriteBatchAtlasPage* newPage = new SpriteBatchAtlasPage();
+
+    newPage->image = mInfra->mDriver->createImage(irr::video::ECF_A8R8G8B8,
+                           irr::core::dimension2d<irr::u32>(DEF_SPRITEBATCH_ATLASPAGESIZE, DEF_SPRITEBATCH_ATLASPAGESIZE));
+
+    if (newPage->image == nullptr) {
+        delete newPage;
+        return nullptr;
+    }
+
+    //start with a fully transparent page
+    newPage->image->fill(irr::video::SColor(0, 0, 0, 0));
+
+    mAtlasPageVec.push_back(newPage);
+
+    return newPage;
+}
+
+bool SpriteBatch::AllocateInAtlasPage(SpriteBatchAtlasPage* page, irr::core::dimension2d<irr::s32> size,
+                                      irr::core::position2d<irr::s32> &outPos) {
+    irr::s32 pageSize = DEF_SPRITEBATCH_ATLASPAGESIZE;
+    irr::s32 paddedWidth = size.Width + DEF_SPRITEBATCH_ATLASPADDING;
+    irr::s32 paddedHeight = size.Height + DEF_SPRITEBATCH_ATLASPADDING;
+
+    //image does not fit into the current shelf anymore?
+    //start a new shelf below
+    if (page->shelfPosX + paddedWidth > pageSize) {
+        page->shelfPosY += page->shelfHeight;
+        page->shelfPosX = 0;
+        page->shelfHeight = 0;
+    }
+
+    //page is full
+    if ((page->shelfPosY + paddedHeight > pageSize) || (paddedWidth > pageSize)) {
+        return false;
+    }
+
+    outPos.set(page->shelfPosX, page->shelfPosY);
+
+    page->shelfPosX += paddedWidth;
+
+    if (paddedHeight > page->shelfHeight) {
+        page->shelfHeight = paddedHeight;
+    }
+
+    return true;
+}
+
+SpriteBatchAtlasEntry* SpriteBatch::FindAtlasEntry(const irr::io::path& textureName, irr::core::rect<irr::s32> sourceRect) {
+    std::vector<SpriteBatchAtlasEntry*>::iterator it;
+
+    for (it = mAtlasEntryVec.begin(); it != mAtlasEntryVec.end(); ++it) {
+        if (((*it)->srcRect == sourceRect) && ((*it)->srcTextureName == textureName)) {
+            return (*it);
+        }
+    }
+
+    return nullptr;
+}
+
+SpriteBatchAtlasPage* SpriteBatch::AllocateInAtlas(irr::core::dimension2d<irr::s32> size,
+                                                  irr::core::position2d<irr::s32> &outPos) {
+    //only the last page can have free space left, all
+    //the pages before are already full
+    if (mAtlasPageVec.size() > 0) {
+        if (AllocateInAtlasPage(mAtlasPageVec.back(), size, outPos)) {
+            return mAtlasPageVec.back();
+        }
+    }
+
+    SpriteBatchAtlasPage* page = CreateAtlasPage();
+
+    if (page == nullptr) {
+        logging::Warning("SpriteBatch: Could not create a new atlas page");
+        return nullptr;
+    }
+
+    if (!AllocateInAtlasPage(page, size, outPos)) {
+        return nullptr;
+    }
+
+    return page;
+}
+
+SpriteBatchAtlasEntry* SpriteBatch::GetSolidEntry() {
+    if (mSolidEntry != nullptr)
+        return mSolidEntry;
+
+    irr::core::dimension2d<irr::s32> size(DEF_SPRITEBATCH_SOLIDSIZE, DEF_SPRITEBATCH_SOLIDSIZE);
+    irr::core::position2d<irr::s32> pos;
+    SpriteBatchAtlasPage* page = AllocateInAtlas(size, pos);
+
+    if (page == nullptr)
+        return nullptr;
+
+    irr::video::SColor white(255, 255, 255, 255);
+
+    for (irr::s32 y = pos.Y; y < pos.Y + size.Height; y++) {
+        for (irr::s32 x = pos.X; x < pos.X + size.Width; x++) {
+            page->image->setPixel((irr::u32)(x), (irr::u32)(y), white);
+        }
+    }
+
+    page->dirty = true;
+
+    //the entry has no source texture, it is only
+    //kept in mAtlasEntryVec to be deleted later
+    mSolidEntry = new SpriteBatchAtlasEntry();
+    mSolidEntry->page = page;
+    mSolidEntry->sourceRect = irr::core::rect<irr::s32>(pos.X, pos.Y, pos.X + size.Width, pos.Y + size.Height);
+    mSolidEntry->srcRect = mSolidEntry->sourceRect;
+
+    mAtlasEntryVec.push_back(mSolidEntry);
+
+    return mSolidEntry;
+}
+
+SpriteBatchAtlasEntry* SpriteBatch::AddToAtlas(irr::video::ITexture* texture, irr::core::rect<irr::s32> sourceRect) {
+    if (texture == nullptr)
+        return nullptr;
+
+    irr::core::dimension2d<irr::s32> size(sourceRect.getWidth(), sourceRect.getHeight());
+
+    //images that are too big are not worth
+    //to be put into the atlas
+    if ((size.Width <= 0) || (size.Height <= 0) ||
+        (size.Width + DEF_SPRITEBATCH_ATLASPADDING > DEF_SPRITEBATCH_ATLASPAGESIZE) ||
+        (size.Height + DEF_SPRITEBATCH_ATLASPADDING > DEF_SPRITEBATCH_ATLASPAGESIZE)) {
+        return nullptr;
+    }
+
+    //was this image already copied into the atlas before?
+    SpriteBatchAtlasEntry* existingEntry = FindAtlasEntry(texture->getName().getPath(), sourceRect);
+
+    if (existingEntry != nullptr)
+        return existingEntry;
+
+    irr::core::position2d<irr::s32> pos;
+    SpriteBatchAtlasPage* page = AllocateInAtlas(size, pos);
+
+    if (page == nullptr)
+        return nullptr;
+
+    //get a copy of the texture pixels, the texture is already color
+    //keyed at this point, therefore the transparency is copied as well
+    irr::video::IImage* srcImage = mInfra->mDriver->createImage(texture, irr::core::position2d<irr::s32>(0, 0),
+                                                                 texture->getSize());
+
+    if (srcImage == nullptr) {
+        return nullptr;
+    }
+
+    srcImage->copyTo(page->image, pos, sourceRect);
+    srcImage->drop();
+
+    page->dirty = true;
+
+    SpriteBatchAtlasEntry* newEntry = new SpriteBatchAtlasEntry();
+    newEntry->page = page;
+    newEntry->sourceRect = irr::core::rect<irr::s32>(pos.X, pos.Y, pos.X + size.Width, pos.Y + size.Height);
+    newEntry->srcTextureName = texture->getName().getPath();
+    newEntry->srcRect = sourceRect;
+
+    mAtlasEntryVec.push_back(newEntry);
+
+    return newEntry;
+}
+
+void SpriteBatch::UpdateAtlasTextures() {
+    std::vector<SpriteBatchAtlasPage*>::iterator it;
+
+    for (it = mAtlasPageVec.begin(); it != mAtlasPageVec.end(); ++it) {
+        if (!(*it)->dirty)
+            continue;
+
+        if ((*it)->texture == nullptr) {
+            //2D images are never drawn scaled, we do not need mipmaps
+            bool mipMapsEnabled = mInfra->mDriver->getTextureCreationFlag(irr::video::ETCF_CREATE_MIP_MAPS);
+            mInfra->mDriver->setTextureCreationFlag(irr::video::ETCF_CREATE_MIP_MAPS, false);
+
+            char pageName[50];
+            snprintf(pageName, 50, "SpriteBatchAtlasPage%u", (irr::u32)(it - mAtlasPageVec.begin()));
+
+            (*it)->texture = mInfra->mDriver->addTexture(pageName, (*it)->image);
+
+            mInfra->mDriver->setTextureCreationFlag(irr::video::ETCF_CREATE_MIP_MAPS, mipMapsEnabled);
+        } else {
+            //the page texture already exists, and can already be referenced by queued
+            //draw operations, therefore overwrite the existing texture content
+            void* texData = (*it)->texture->lock(irr::video::ETLM_WRITE_ONLY);
+
+            if (texData != nullptr) {
+                irr::core::dimension2d<irr::u32> texSize = (*it)->texture->getSize();
+
+                (*it)->image->copyToScaling(texData, texSize.Width, texSize.Height,
+                                            (*it)->texture->getColorFormat(), (*it)->texture->getPitch());
+                (*it)->texture->unlock();
+            }
+        }
+
+        (*it)->dirty = false;
+    }
+}
+
+void SpriteBatch::Begin() {
+    mBeginNestingLevel++;
+}
+
+void SpriteBatch::End() {
+    if (mBeginNestingLevel == 0)
+        return;
+
+    mBeginNestingLevel--;
+
+    if (mBeginNestingLevel == 0) {
+        Flush();
+    }
+}
+
+void SpriteBatch::Draw(irr::video::ITexture* texture, irr::core::position2d<irr::s32> position,
+                       irr::core::rect<irr::s32> sourceRect, irr::video::SColor color, bool useAlphaChannel) {
+    if (texture == nullptr)
+        return;
+
+    //batching not active, draw immediately
+    if (mBeginNestingLevel == 0) {
+        mInfra->mDriver->draw2DImage(texture, position, sourceRect, 0, color, useAlphaChannel);
+
+        mNrQuadsDrawn++;
+        mNrDrawCalls++;
+        return;
+    }
+
+    SpriteBatchQuad newQuad;
+    newQuad.texture = texture;
+    newQuad.position = position;
+    newQuad.sourceRect = sourceRect;
+    newQuad.color = color;
+    newQuad.useAlphaChannel = useAlphaChannel;
+
+    mQuadVec.push_back(newQuad);
+}
+
+void SpriteBatch::Draw(SpriteBatchAtlasEntry* entry, irr::core::position2d<irr::s32> position,
+                       irr::video::SColor color, bool useAlphaChannel) {
+    if (entry == nullptr)
+        return;
+
+    //make sure the page texture exists, and
+    //contains all images
+    if (entry->page->dirty) {
+        UpdateAtlasTextures();
+    }
+
+    Draw(entry->page->texture, position, entry->sourceRect, color, useAlphaChannel);
+}
+
+void SpriteBatch::DrawRectangle(irr::video::SColor color, irr::core::rect<irr::s32> rect) {
+    irr::s32 width = rect.getWidth();
+    irr::s32 height = rect.getHeight();
+
+    if ((width <= 0) || (height <= 0))
+        return;
+
+    SpriteBatchAtlasEntry* solid = nullptr;
+
+    if ((mBeginNestingLevel > 0) && (width <= DEF_SPRITEBATCH_SOLIDSIZE) && (height <= DEF_SPRITEBATCH_SOLIDSIZE)) {
+        solid = GetSolidEntry();
+    }
+
+    if (solid == nullptr) {
+        //can not be batched, keep the draw order
+        Flush();
+        mInfra->mDriver->draw2DRectangle(color, rect, nullptr);
+        return;
+    }
+
+    if (solid->page->dirty) {
+        UpdateAtlasTextures();
+    }
+
+    irr::core::rect<irr::s32> sourceRect(solid->sourceRect.UpperLeftCorner.X, solid->sourceRect.UpperLeftCorner.Y,
+                                         solid->sourceRect.UpperLeftCorner.X + width,
+                                         solid->sourceRect.UpperLeftCorner.Y + height);
+
+    Draw(solid->page->texture, rect.UpperLeftCorner, sourceRect, color, true);
+}
+
+void SpriteBatch::Flush() {
+    size_t nrQuads = mQuadVec.size();
+
+    if (nrQuads == 0)
+        return;
+
+    UpdateAtlasTextures();
+
+    size_t startIdx = 0;
+
+    while (startIdx < nrQuads) {
+        const SpriteBatchQuad& first = mQuadVec[startIdx];
+
+        mBatchPositions.set_used(0);
+        mBatchSourceRects.set_used(0);
+
+        //collect all following quads that can be drawn
+        //with the same draw call
+        size_t idx = startIdx;
+
+        while ((idx < nrQuads) && (mQuadVec[idx].texture == first.texture) && (mQuadVec[idx].color == first.color)
+               && (mQuadVec[idx].useAlphaChannel == first.useAlphaChannel)) {
+            mBatchPositions.push_back(mQuadVec[idx].position);
+            mBatchSourceRects.push_back(mQuadVec[idx].sourceRect);
+            idx++;
+        }
+
+        mInfra->mDriver->draw2DImageBatch(first.texture, mBatchPositions, mBatchSourceRects, 0,
+                                          first.color, first.useAlphaChannel);
+
+        mNrQuadsDrawn += (irr::u32)(idx - startIdx);
+        mNrDrawCalls++;
+
+        startIdx = idx;
+    }
+
+    mQuadVec.clear();
+}
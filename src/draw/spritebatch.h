@@ -0,0 +1,154 @@
+/*
+ Copyright (C) 2026 Wolf Alexander
+
+ This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.                                          */
+
+#ifndef SPRITEBATCH_H
+#define SPRITEBATCH_H
+
+#include "irrlicht.h"
+#include <vector>
+
+//size of one atlas page texture in pixels (width and height)
+#define DEF_SPRITEBATCH_ATLASPAGESIZE 1024
+
+//free pixels between two images inside an atlas page
+#define DEF_SPRITEBATCH_ATLASPADDING 1
+
+//size of the white area inside the atlas that is used to
+//draw solid rectangles, bigger rectangles are not batched
+#define DEF_SPRITEBATCH_SOLIDSIZE 16
+
+/************************
+ * Forward declarations *
+ ************************/
+
+class InfrastructureBase;
+
+//one atlas page; Images are packed in rows
+//(shelves) from the top to the bottom of the page
+struct SpriteBatchAtlasPage {
+    //CPU side copy of the page, is uploaded into
+    //the texture when the page was modified
+    irr::video::IImage* image = nullptr;
+    irr::video::ITexture* texture = nullptr;
+
+    //true if the image contains data that is not
+    //uploaded into the texture yet
+    bool dirty = false;
+
+    //packing state of the current shelf
+    irr::s32 shelfPosX = 0;
+    irr::s32 shelfPosY = 0;
+    irr::s32 shelfHeight = 0;
+};
+
+//location of a single image inside of the atlas
+struct SpriteBatchAtlasEntry {
+    SpriteBatchAtlasPage* page = nullptr;
+    irr::core::rect<irr::s32> sourceRect;
+
+    //name of the texture and area the image was copied from,
+    //allows to reuse the entry if the same image is added again
+    irr::io::path srcTextureName;
+    irr::core::rect<irr::s32> srcRect;
+};
+
+//one queued 2D image draw operation
+struct SpriteBatchQuad {
+    irr::video::ITexture* texture = nullptr;
+    irr::core::position2d<irr::s32> position;
+    irr::core::rect<irr::s32> sourceRect;
+    irr::video::SColor color;
+    bool useAlphaChannel;
+};
+
+//Collects 2D image draw operations, and draws them with as few Irrlicht
+//draw2DImageBatch calls as possible. Small images that are drawn very often
+//(font characters, HUD parts) can be copied into shared atlas page textures,
+//so that one batch call can draw all of them together.
+//The draw order is always kept, only neighboring quads with the same texture,
+//color and alpha setting are combined. Small solid rectangles can be queued with
+//DrawRectangle, any other 2D drawing (lines...) while batching is active needs a
+//call to Flush() before.
+class SpriteBatch {
+public:
+    SpriteBatch(InfrastructureBase* infra);
+    ~SpriteBatch();
+
+    //Copies the specified area of a texture into the atlas
+    //returns the new atlas entry, or nullptr if the image does not
+    //fit into an atlas page or could not be copied; In this case
+    //the caller should keep drawing with the original texture
+    //If the same area of a texture with the same name was already added
+    //before, the existing entry is returned (for example when the Hud
+    //is created again for the next race)
+    SpriteBatchAtlasEntry* AddToAtlas(irr::video::ITexture* texture, irr::core::rect<irr::s32> sourceRect);
+
+    //Uploads all modified atlas pages into their textures
+    //is also done automatically before the next flush
+    void UpdateAtlasTextures();
+
+    //Starts to collect draw operations; Begin/End calls can be
+    //nested, draw operations are only flushed at the outermost End
+    void Begin();
+    void End();
+
+    //Draws all collected draw operations now
+    void Flush();
+
+    //Queues a 2D image draw operation, if we are not between Begin
+    //and End the image is drawn immediately
+    void Draw(irr::video::ITexture* texture, irr::core::position2d<irr::s32> position,
+              irr::core::rect<irr::s32> sourceRect, irr::video::SColor color, bool useAlphaChannel);
+
+    void Draw(SpriteBatchAtlasEntry* entry, irr::core::position2d<irr::s32> position,
+              irr::video::SColor color, bool useAlphaChannel);
+
+    //Queues a solid rectangle, it is drawn with a white area of the atlas
+    //tinted with the color; Rectangles bigger than DEF_SPRITEBATCH_SOLIDSIZE
+    //flush the queue, and are drawn with draw2DRectangle
+    void DrawRectangle(irr::video::SColor color, irr::core::rect<irr::s32> rect);
+
+    //statistics of the last flushes
+    irr::u32 mNrQuadsDrawn = 0;
+    irr::u32 mNrDrawCalls = 0;
+
+private:
+    InfrastructureBase* mInfra = nullptr;
+
+    std::vector<SpriteBatchAtlasPage*> mAtlasPageVec;
+    std::vector<SpriteBatchAtlasEntry*> mAtlasEntryVec;
+
+    std::vector<SpriteBatchQuad> mQuadVec;
+
+    //white area for DrawRectangle, is
+    //created when it is needed first
+    SpriteBatchAtlasEntry* mSolidEntry = nullptr;
+
+    irr::u32 mBeginNestingLevel = 0;
+
+    //preallocated arrays for the Irrlicht batch draw call
+    irr::core::array<irr::core::position2d<irr::s32>> mBatchPositions;
+    irr::core::array<irr::core::rect<irr::s32>> mBatchSourceRects;
+
+    SpriteBatchAtlasPage* CreateAtlasPage();
+    SpriteBatchAtlasEntry* FindAtlasEntry(const irr::io::path& textureName, irr::core::rect<irr::s32> sourceRect);
+
+    //finds space for an image with the specified size in the last atlas page,
+    //or in a new page; returns the page, or nullptr if there is no space
+    SpriteBatchAtlasPage* AllocateInAtlas(irr::core::dimension2d<irr::s32> size, irr::core::position2d<irr::s32> &outPos);
+
+    SpriteBatchAtlasEntry* GetSolidEntry();
+
+    //tries to find space for an image with the specified size inside of
+    //the page, returns true and the location if there was enough space
+    bool AllocateInAtlasPage(SpriteBatchAtlasPage* page, irr::core::dimension2d<irr::s32> size,
+                             irr::core::position2d<irr::s32> &outPos);
+};
+
+#endif // SPRITEBATCH_H
@@ -37,6 +37,7 @@
 #include <fstream>
 #include "utils/fileutils.h"
 #include "utils/tiny-process-library/process.hpp"
+#include "utils/testmapinput.h"
 #include <sstream>
 #include <iomanip>
 
@@ -643,33 +644,91 @@ bool Editor::SaveAsLevel(bool saveAsNewLevel) {
 }
 
 void Editor::TestMapinHioctance20XX() {
-    cout << "Call to hi-octance20XX" << endl;
-    std::string cmdStr("");
-    cmdStr.append("./hi-octane202x ");
+    if (mCurrentSession == nullptr)
+        return;
+
+    int exitStatus;
+
+    //was hi-octane202x closed in the meantime?
+    if ((mTestMapProcess != nullptr) && mTestMapProcess->try_get_exit_status(exitStatus)) {
+        cout << "hi-octane202x returned: " << exitStatus << " (" << (exitStatus==0?"success":"failure") << ")" << endl;
+
+        delete mTestMapProcess;
+        mTestMapProcess = nullptr;
+    }
+
+    if (mTestMapProcess == nullptr) {
+        cout << "Call to hi-octance20XX" << endl;
+
+        //the game only loads its assets once, and
+        //then waits for map test commands on stdin
+        std::string cmdStr("./hi-octane202x testserver");
+
+        //the output is forwarded line by line, this way a ready message
+        //that is split over multiple reads is also detected
+        mTestMapOutputLine.clear();
+        mTestMapGameReady = false;
+
+        mTestMapProcess = new TinyProcessLib::Process(cmdStr.c_str(), "", [this](const char *bytes, size_t n) {
+          mTestMapOutputLine.append(bytes, n);
+
+          size_t endPos;
+
+          while ((endPos = mTestMapOutputLine.find('\n')) != std::string::npos) {
+              std::string line = mTestMapOutputLine.substr(0, endPos);
+              mTestMapOutputLine.erase(0, endPos + 1);
+
+              if (line.find(DEF_TESTMAP_MSG_READY) != std::string::npos) {
+                  mTestMapGameReady = true;
+              } else {
+                  cout << "Output from stdout: " << line << endl;
+              }
+          }
+        }, [](const char *bytes, size_t n) {
+          cout << "Output from stderr: " << std::string(bytes, n);
+          //add a newline for prettier output on some platforms:
+          if(bytes[n-1]!='\n')
+            cout << endl;
+        }, true);
+    } else if (!mTestMapGameReady) {
+        logging::Warning("Map test is still running, end it first in hi-octane202x");
+        return;
+    }
+
+    //command format: test [nocpu] <level folder>; if hi-octane202x is still
+    //loading its assets the command waits in its stdin until it is ready
+    std::string testCmd(DEF_TESTMAP_CMD_TEST);
+    testCmd.append(" ");
 
-    //Test command line option is used to directly load a
-    //level in hi-octane202x
     if (mTestMapNoCpuPlayer) {
       //if we do not want to include cpu players
       //simply state option nocpu
-      cmdStr.append("nocpu ");
+      testCmd.append(DEF_TESTMAP_OPTION_NOCPU);
+      testCmd.append(" ");
+    }
+
+    testCmd.append(mCurrentSession->mLevelRootPath);
+    testCmd.append("\n");
+
+    mTestMapGameReady = false;
+
+    if (!mTestMapProcess->write(testCmd)) {
+        logging::Error("Could not send the map test to hi-octane202x");
     }
+}
 
-    cmdStr.append("test ");
-    cmdStr.append(mCurrentSession->mLevelRootPath);
-    cmdStr.erase(cmdStr.begin() + cmdStr.size() - 1);
+void Editor::StopTestMapProcess() {
+    if (mTestMapProcess == nullptr)
+        return;
+
+    //a map test that is still running is ended as well,
+    //the editor is the only user of this process
+    mTestMapProcess->close_stdin();
+    mTestMapProcess->kill();
+    mTestMapProcess->get_exit_status();
 
-    TinyProcessLib::Process hiprocess(cmdStr.c_str(), "", [](const char *bytes, size_t n) {
-      cout << "Output from stdout: " << std::string(bytes, n);
-    }, [](const char *bytes, size_t n) {
-      cout << "Output from stderr: " << std::string(bytes, n);
-      //add a newline for prettier output on some platforms:
-      if(bytes[n-1]!='\n')
-        cout << endl;
-    });
-    auto exit_status=hiprocess.get_exit_status();
-    cout << "hi-octane202x returned: " << exit_status << " (" << (exit_status==0?"success":"failure") << ")" << endl;
-    //this_thread::sleep_for(chrono::seconds(5));
+    delete mTestMapProcess;
+    mTestMapProcess = nullptr;
 }
 
 void Editor::TestMapModification() {
@@ -2616,5 +2675,7 @@ Editor::~Editor() {
         mFileOperationDialog = nullptr;
     }
 
+    StopTestMapProcess();
+
     CleanupExistingLevelData();
 }
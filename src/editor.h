@@ -13,6 +13,7 @@
 #include "irrlicht.h"
 #include "infrabase.h"
 #include <vector>
+#include <atomic>
 
 using namespace irr;
 using namespace gui;
@@ -180,6 +181,10 @@ class NumberEditBox;
 class UiConversion;
 class FileOperationDialog;
 
+namespace TinyProcessLib {
+    class Process;
+}
+
 class Editor : public InfrastructureBase {
 private:
     //Irrlicht related, for debugging of game
@@ -327,8 +332,27 @@ private:
     void CleanupExistingLevelData();
 
     bool mTestMapNoCpuPlayer = true;
+
+    //Sends the current level to hi-octane202x for a map test; hi-octane202x is started only
+    //once (in map test server mode), and keeps running between the map tests, so that it does
+    //not need to load all game assets again for every test. The editor is not blocked meanwhile
     void TestMapinHioctance20XX();
 
+    //the running hi-octane202x process in map test server mode,
+    //nullptr if there is none
+    TinyProcessLib::Process* mTestMapProcess = nullptr;
+
+    //set by the stdout reader thread of the process as soon as
+    //hi-octane202x waits for the next map test command
+    std::atomic<bool> mTestMapGameReady{false};
+
+    //incomplete output line of the process, only
+    //used by the stdout reader thread of the process
+    std::string mTestMapOutputLine;
+
+    //ends hi-octane202x if it is still running
+    void StopTestMapProcess();
+
     void TestMapModification();
 
     void DebugPrintTable(irr::s32 id);
@@ -374,10 +374,10 @@ void TerraformingMode::NewLevelItemSelected(CurrentlySelectedEditorItemInfoStruc
         irr::s32 coordY = mParentSession->mItemSelector->mCurrSelectedItem.mCellCoordSelected.Y;
 
         //Y-coordinate from original map has flipped sign in this project
-        irr::f32 currV1h = -mParentSession->mLevelTerrain->pTerrainTiles[coordX][coordY].vert1CurrPositionY;
-        irr::f32 currV2h = -mParentSession->mLevelTerrain->pTerrainTiles[coordX][coordY].vert2CurrPositionY;
-        irr::f32 currV3h = -mParentSession->mLevelTerrain->pTerrainTiles[coordX][coordY].vert3CurrPositionY;
-        irr::f32 currV4h = -mParentSession->mLevelTerrain->pTerrainTiles[coordX][coordY].vert4CurrPositionY;
+        irr::f32 currV1h = -mParentSession->mLevelTerrain->mTileStore->GetVertexHeight(coordX, coordY, 1);
+        irr::f32 currV2h = -mParentSession->mLevelTerrain->mTileStore->GetVertexHeight(coordX, coordY, 2);
+        irr::f32 currV3h = -mParentSession->mLevelTerrain->mTileStore->GetVertexHeight(coordX, coordY, 3);
+        irr::f32 currV4h = -mParentSession->mLevelTerrain->mTileStore->GetVertexHeight(coordX, coordY, 4);
 
         //Update the labels showing vertice height
         UpdateHeightLbl(1, currV1h);
@@ -501,10 +501,10 @@ void TerraformingMode::OnSelectedVertexModifyHeight(CurrentlySelectedEditorItemI
     irr::s32 coordX = whichItem.mCellCoordSelected.X;
     irr::s32 coordY = whichItem.mCellCoordSelected.Y;
 
-    irr::f32 currV1h = mParentSession->mLevelTerrain->pTerrainTiles[coordX][coordY].vert1CurrPositionY;
-    irr::f32 currV2h = mParentSession->mLevelTerrain->pTerrainTiles[coordX][coordY].vert2CurrPositionY;
-    irr::f32 currV3h = mParentSession->mLevelTerrain->pTerrainTiles[coordX][coordY].vert3CurrPositionY;
-    irr::f32 currV4h = mParentSession->mLevelTerrain->pTerrainTiles[coordX][coordY].vert4CurrPositionY;
+    irr::f32 currV1h = mParentSession->mLevelTerrain->mTileStore->GetVertexHeight(coordX, coordY, 1);
+    irr::f32 currV2h = mParentSession->mLevelTerrain->mTileStore->GetVertexHeight(coordX, coordY, 2);
+    irr::f32 currV3h = mParentSession->mLevelTerrain->mTileStore->GetVertexHeight(coordX, coordY, 3);
+    irr::f32 currV4h = mParentSession->mLevelTerrain->mTileStore->GetVertexHeight(coordX, coordY, 4);
     irr::f32 newH = 0.0f;
 
     switch (whichItem.mCellCoordVerticeNrSelected) {
@@ -585,10 +585,10 @@ void TerraformingMode::OnSelectedCellModifyHeight(CurrentlySelectedEditorItemInf
     irr::s32 coordX = whichItem.mCellCoordSelected.X;
     irr::s32 coordY = whichItem.mCellCoordSelected.Y;
 
-    irr::f32 currV1h = mParentSession->mLevelTerrain->pTerrainTiles[coordX][coordY].vert1CurrPositionY;
-    irr::f32 currV2h = mParentSession->mLevelTerrain->pTerrainTiles[coordX][coordY].vert2CurrPositionY;
-    irr::f32 currV3h = mParentSession->mLevelTerrain->pTerrainTiles[coordX][coordY].vert3CurrPositionY;
-    irr::f32 currV4h = mParentSession->mLevelTerrain->pTerrainTiles[coordX][coordY].vert4CurrPositionY;
+    irr::f32 currV1h = mParentSession->mLevelTerrain->mTileStore->GetVertexHeight(coordX, coordY, 1);
+    irr::f32 currV2h = mParentSession->mLevelTerrain->mTileStore->GetVertexHeight(coordX, coordY, 2);
+    irr::f32 currV3h = mParentSession->mLevelTerrain->mTileStore->GetVertexHeight(coordX, coordY, 3);
+    irr::f32 currV4h = mParentSession->mLevelTerrain->mTileStore->GetVertexHeight(coordX, coordY, 4);
     irr::f32 newH = 0.0f;
     irr::f32 avgH = 0.0f;
 
@@ -396,7 +396,9 @@ bool EditorSession::LoadLevel() {
    //this routine also generates the column/block collision information inside that
    //we need for collision detection later
    this->mLevelBlocks = new LevelBlocks(this->mParentEditor, this->mLevelTerrain, this->mLevelRes, mTexLoader, true,
-                                        DebugShowWallCollisionMesh, false, mParentEditor->enableBlockPreview);
+                                        DebugShowWallCollisionMesh, false, mParentEditor->enableBlockPreview, nullptr);
+
+   mLevelBlocks->FinishBlocksInitialization();
 
    //we can only set levelBlocks afterwards in Terrain
    //unfortunetly! do not forget it!
@@ -755,6 +757,9 @@ void EditorSession::Render() {
     if (mEditorMode != nullptr) {
        mEditorMode->OnDraw();
     }
+
+    //draw all debug lines of this frame at once
+    mParentEditor->mDrawDebug->Flush();
 }
 
 void EditorSession::MoveUserViewToLocation(irr::core::vector3df newCameraLookAtPnt, irr::f32 cameraDistance) {
@@ -20,6 +20,9 @@
 #include "utils/tprofile.h"
 #include "utils/gamedbgwnd.h"
 #include "draw/attribution.h"
+#include "utils/testmapinput.h"
+#include <iostream>
+#include <algorithm>
 
 void Game::StopTime() {
     if (!mTimeStopped) {
@@ -92,6 +95,10 @@ bool Game::LoadGameData() {
 //original game files were already extracted before and are
 //available
 bool Game::InitGameStep2() {
+    //all game data is extracted now, load the
+    //following assets from the archive if available
+    MountAssetArchive();
+
     /***********************************************************/
     /* Load and define game assets (Meshes, Tracks, Craft)     */
     /***********************************************************/
@@ -954,6 +961,13 @@ void Game::GameLoopTitleScreenLoadData() {
                 //add computer players?
                 mGameAssets->SetComputerPlayersEnabled(true);
 
+                if (mTestMapServerMode) {
+                    //wait for the first map test command
+                    //of the level editor
+                    mGameState = DEF_GAMESTATE_TESTMAPWAIT;
+                    return;
+                }
+
                 mGameState = DEF_GAMESTATE_INITRACE;
                 return;
             }
@@ -1028,65 +1042,87 @@ void Game::GameLoopLoadRaceScreen() {
 
     mGameTexts->DrawGameText(loadingTxt, mGameTexts->GameMenueSelectedItemFont, txtDrawPos);
 
-    mDriver->endScene();
+    //show how far the level loading is
+    if (mRaceCreationRunning && (mCurrentRace != nullptr)) {
+        irr::s32 barStartY = txtDrawPos.Y + txtHeight + txtHeight / 2;
+        irr::core::recti barRect(txtDrawPos.X, barStartY, txtDrawPos.X + txtWidth, barStartY + txtHeight / 2);
 
-    if (mGameState == DEF_GAMESTATE_INITRACE) {
-        if (!mTestMapMode) {
-            //Default game mode
+        irr::s32 fillWidth = (irr::s32)(mCurrentRace->GetInitProgress() * (irr::f32)(txtWidth));
 
-            //player wants to start the race
-            mPilotsNextRace = mGameAssets->GetPilotInfoNextRace(true, mGameAssets->GetComputerPlayersEnabled());
+        mDriver->draw2DRectangleOutline(barRect, irr::video::SColor(255, 255, 255, 255));
+        mDriver->draw2DRectangle(irr::video::SColor(255, 255, 255, 255),
+                       irr::core::recti(barRect.UpperLeftCorner.X, barRect.UpperLeftCorner.Y,
+                                        barRect.UpperLeftCorner.X + fillWidth, barRect.LowerRightCorner.Y));
+    }
 
-            if (this->CreateNewRace(nextRaceLevelNr, mPilotsNextRace, mGameAssets->mRaceTrackVec->at(nextRaceLevelNr-1)->currSelNrLaps,
-                                    false, mDebugRace)) {
-                 mGameState = DEF_GAMESTATE_RACE;
-                 CleanupPilotInfo(mPilotsNextRace);
-            } else {
-                CleanupPilotInfo(mPilotsNextRace);
+    mDriver->endScene();
 
-                mGameState = DEF_GAMESTATE_MENUE;
+    if (!mRaceCreationRunning) {
+        //first frame of the race load screen, start the race creation
+        //the level itself is loaded step by step during the next frames, so that
+        //the window stays responsive
+        bool started = false;
 
-                //there was an error while creating the race
-                //Go back to top of main menue
-                MainMenue->ShowMainMenue();
-            }
-        } else {
-            //Test map mode via Command-line
+        if (mGameState == DEF_GAMESTATE_INITRACE) {
+            if (!mTestMapMode) {
+                //Default game mode
 
-            //let the command line parameters define if computer players are added or not
-            mPilotsNextRace = mGameAssets->GetPilotInfoNextRace(true, !mTestMapModeNoCpuPlayers);
+                //player wants to start the race
+                mPilotsNextRace = mGameAssets->GetPilotInfoNextRace(true, mGameAssets->GetComputerPlayersEnabled());
 
-            if (this->CreateNewRace(mTestTargetLevel, mPilotsNextRace, 10, false, mDebugRace)) {
-                 mGameState = DEF_GAMESTATE_RACE;
-                 CleanupPilotInfo(mPilotsNextRace);
+                started = this->CreateNewRace(nextRaceLevelNr, mGameAssets->mRaceTrackVec->at(nextRaceLevelNr-1)->currSelNrLaps,
+                                              false, mDebugRace);
             } else {
-                CleanupPilotInfo(mPilotsNextRace);
+                //Test map mode via Command-line
 
-                mGameState = DEF_GAMESTATE_MENUE;
+                //let the command line parameters define if computer players are added or not
+                mPilotsNextRace = mGameAssets->GetPilotInfoNextRace(true, !mTestMapModeNoCpuPlayers);
 
-                //there was an error while creating the race
-                //Go back to top of main menue
-                MainMenue->ShowMainMenue();
+                started = this->CreateNewRace(mTestTargetLevel, 10, false, mDebugRace);
             }
-        }
-    } else if (mGameState == DEF_GAMESTATE_INITDEMO) {
-        //for the demo do not add a human player, but add computer players
-        mPilotsNextRace = mGameAssets->GetPilotInfoNextRace(false, true);
-
-        if (this->CreateNewRace(nextRaceLevelNr, mPilotsNextRace, mGameAssets->mRaceTrackVec->at(nextRaceLevelNr-1)->currSelNrLaps,
-                                true, mDebugRace)) {
-             mGameState = DEF_GAMESTATE_RACE;
-             CleanupPilotInfo(mPilotsNextRace);
-        } else {
-            CleanupPilotInfo(mPilotsNextRace);
+        } else if (mGameState == DEF_GAMESTATE_INITDEMO) {
+            //for the demo do not add a human player, but add computer players
+            mPilotsNextRace = mGameAssets->GetPilotInfoNextRace(false, true);
 
-            mGameState = DEF_GAMESTATE_MENUE;
+            started = this->CreateNewRace(nextRaceLevelNr, mGameAssets->mRaceTrackVec->at(nextRaceLevelNr-1)->currSelNrLaps,
+                                          true, mDebugRace);
+        }
 
-            //there was an error while creating the race
-            //Go back to top of main menue
-            MainMenue->ShowMainMenue();
+        if (!started) {
+            RaceCreationFailed();
         }
+
+        return;
+    }
+
+    irr::u8 result = ContinueCreateNewRace(mPilotsNextRace);
+
+    if (result == DEF_GAME_RACECREATION_BUSY)
+        return;
+
+    if (result == DEF_GAME_RACECREATION_DONE) {
+        mGameState = DEF_GAMESTATE_RACE;
+        CleanupPilotInfo(mPilotsNextRace);
+    } else {
+        RaceCreationFailed();
+    }
+}
+
+void Game::RaceCreationFailed() {
+    CleanupPilotInfo(mPilotsNextRace);
+
+    if (mTestMapServerMode) {
+        //the level editor can send
+        //the next map test
+        mGameState = DEF_GAMESTATE_TESTMAPWAIT;
+        return;
     }
+
+    mGameState = DEF_GAMESTATE_MENUE;
+
+    //there was an error while creating the race
+    //Go back to top of main menue
+    MainMenue->ShowMainMenue();
 }
 
 void Game::GameLoopMenue(irr::f32 frameDeltaTime) {
@@ -1300,6 +1336,10 @@ void Game::GameLoopRace(irr::f32 frameDeltaTime) {
         mEffect->update();
     }
 
+    //unhide all entities that were hidden by
+    //occlusion culling before this frame was drawn
+    mCurrentRace->RestoreOccludedSceneNodes();
+
     mTimeProfiler->Profile(mTimeProfiler->tIntRender3DScene);
 
     //2nd draw HUD over the scene, needs to be done at the end
@@ -1339,8 +1379,8 @@ void Game::GameLoopRace(irr::f32 frameDeltaTime) {
         }
 
         //was the race finished, that means all players went through the finish
-        //line and finished the last lap?
-        if (mCurrentRace->GetWasRaceFinished()) {
+        //line and finished the last lap? (statistics are not shown in map test server mode)
+        if (!mTestMapServerMode && mCurrentRace->GetWasRaceFinished()) {
             //yes it was, get race statistics
             this->lastRaceStat = mCurrentRace->RetrieveFinalRaceStatistics();
         }
@@ -1355,9 +1395,13 @@ void Game::GameLoopRace(irr::f32 frameDeltaTime) {
             mEffect = nullptr;
         }
 
-        //if we were in game debugging mode or map test mode simply skip
-        //main menue, and exit game immediately
-        if (mDebugRace || mDebugDemoMode || mTestMapMode) {
+        //in map test server mode wait for the next
+        //map test command of the level editor
+        if (mTestMapServerMode) {
+            mGameState = DEF_GAMESTATE_TESTMAPWAIT;
+        } else if (mDebugRace || mDebugDemoMode || mTestMapMode) {
+            //if we were in game debugging mode or map test mode simply skip
+            //main menue, and exit game immediately
             ExitGame = true;
         } else {
             mGameState = DEF_GAMESTATE_MENUE;
@@ -1376,7 +1420,8 @@ void Game::GameLoopRace(irr::f32 frameDeltaTime) {
 
 void Game::GameLoopIntro(irr::f32 frameDeltaTime) {
     //if we want to skip the intro, do it now
-    if (mGameConfig->skipIntro) {
+    //in map test mode never play the intro
+    if (mGameConfig->skipIntro || mTestMapMode) {
         mGameState = DEF_GAMESTATE_GAMETITLE;
         return;
     }
@@ -1509,6 +1554,11 @@ void Game::MainGameLoop() {
                 break;
             }
 
+            case DEF_GAMESTATE_TESTMAPWAIT: {
+                GameLoopTestMapWait();
+                break;
+            }
+
             case DEF_GAMESTATE_ERROR: {
                 //there was an error, exit game
                 ExitGame = true;
@@ -1556,8 +1606,7 @@ void Game::CleanupPilotInfo(std::vector<PilotInfoStruct*> &pilotInfo) {
     }
 }
 
-bool Game::CreateNewRace(std::string targetLevel, std::vector<PilotInfoStruct*> pilotInfo,
-                         irr::u8 nrLaps, bool demoMode, bool debugRace) {
+bool Game::CreateNewRace(std::string targetLevel, irr::u8 nrLaps, bool demoMode, bool debugRace) {
     if (mCurrentRace != nullptr)
         return false;
 
@@ -1591,7 +1640,25 @@ bool Game::CreateNewRace(std::string targetLevel, std::vector<PilotInfoStruct*>
     //create a new Race
     mCurrentRace = new Race(this, gameMusicPlayer, gameSoundEngine, levelRootDir, levelName, nrLaps, demoMode, mAttributionRunning, debugRace);
 
-    mCurrentRace->Init();
+    //the level is loaded by the following
+    //calls of ContinueCreateNewRace
+    mCurrentRace->BeginInit();
+    mRaceCreationRunning = true;
+
+    return true;
+}
+
+irr::u8 Game::ContinueCreateNewRace(std::vector<PilotInfoStruct*> pilotInfo) {
+    if (!mCurrentRace->ContinueInit())
+        return DEF_GAME_RACECREATION_BUSY;
+
+    mRaceCreationRunning = false;
+
+    if (!mCurrentRace->ready) {
+        //there was a problem with Race initialization
+        logging::Error("Race creation failed!");
+        return DEF_GAME_RACECREATION_FAILED;
+    }
 
     //now add players according to pilotInfo
     std::vector<PilotInfoStruct*>::iterator itPilot;
@@ -1602,10 +1669,12 @@ bool Game::CreateNewRace(std::string targetLevel, std::vector<PilotInfoStruct*>
 
         //if there was a problem modelName is an empty string
         if (modelName == "")
-            return false;
+            return DEF_GAME_RACECREATION_FAILED;
 
         //finally add the player to the race
-        mCurrentRace->AddPlayer((*itPilot)->humanPlayer, (*itPilot)->pilotName, modelName);
+        mCurrentRace->AddPlayer((*itPilot)->humanPlayer, (*itPilot)->pilotName, modelName,
+                                mGameAssets->GetCraftColorSchemeTexture((*itPilot)->defaultCraftName,
+                                                                        (*itPilot)->currSelectedCraftColorScheme));
     }
 
     //is there at least one player?
@@ -1613,23 +1682,17 @@ bool Game::CreateNewRace(std::string targetLevel, std::vector<PilotInfoStruct*>
         //no player in race, we need to interrupt
         //no race possible
         logging::Error("Not a single player in race, interrupt race creation");
-        return false;
+        return DEF_GAME_RACECREATION_FAILED;
     }
 
     //which player do we want to follow at the start
     //of the race
     mCurrentRace->DebugSelectPlayer(0);
 
-    if (!mCurrentRace->ready) {
-        //there was a problem with Race initialization
-        logging::Error("Race creation failed!");
-        return false;
-    }
-
-    return true;
+    return DEF_GAME_RACECREATION_DONE;
 }
 
-bool Game::CreateNewRace(int load_levelnr, std::vector<PilotInfoStruct*> pilotInfo, irr::u8 nrLaps, bool demoMode, bool debugRace) {
+bool Game::CreateNewRace(int load_levelnr, irr::u8 nrLaps, bool demoMode, bool debugRace) {
     if (mCurrentRace != nullptr)
         return false;
 
@@ -1651,7 +1714,83 @@ bool Game::CreateNewRace(int load_levelnr, std::vector<PilotInfoStruct*> pilotIn
     snprintf(nrStr, 9, "%d", load_levelnr);
     targetLevel.append(nrStr);
 
-    return (CreateNewRace(targetLevel, pilotInfo, nrLaps, demoMode, debugRace));
+    return (CreateNewRace(targetLevel, nrLaps, demoMode, debugRace));
+}
+
+void Game::GameLoopTestMapWait() {
+    //the level editor was closed
+    if (mTestMapInput->IsClosed()) {
+        ExitGame = true;
+        return;
+    }
+
+    std::string command;
+
+    if (!mTestMapInput->GetNextCommand(command)) {
+        mDriver->beginScene(true,true, irr::video::SColor(255, 0, 0, 0));
+
+        char waitTxt[30];
+        strcpy(waitTxt, "WAITING FOR EDITOR");
+
+        irr::u32 txtWidth = mGameTexts->GetWidthPixelsGameText(waitTxt, mGameTexts->GameMenueSelectedItemFont);
+        irr::u32 txtHeight = mGameTexts->GetHeightPixelsGameText(waitTxt, mGameTexts->GameMenueSelectedItemFont);
+
+        irr::core::position2di txtDrawPos;
+        txtDrawPos.X = mScreenRes.Width / 2 - txtWidth / 2;
+        txtDrawPos.Y = mScreenRes.Height / 2 - txtHeight / 2;
+
+        mGameTexts->DrawGameText(waitTxt, mGameTexts->GameMenueSelectedItemFont, txtDrawPos);
+
+        mDriver->endScene();
+
+        if (!mTestMapWaitReported) {
+            //tell the level editor that the next
+            //map test can be started
+            std::cout << DEF_TESTMAP_MSG_READY << std::endl;
+            mTestMapWaitReported = true;
+        }
+
+        //do not waste CPU time while waiting
+        mDevice->sleep(20);
+
+        return;
+    }
+
+    //command format: test [nocpu] <level folder>
+    std::string cmdTest(DEF_TESTMAP_CMD_TEST);
+    cmdTest.append(" ");
+
+    std::string optNoCpu(DEF_TESTMAP_OPTION_NOCPU);
+    optNoCpu.append(" ");
+
+    if (command.compare(0, cmdTest.size(), cmdTest) != 0) {
+        std::string errMsg("Unknown map test command: ");
+        errMsg.append(command);
+        logging::Error(errMsg);
+        return;
+    }
+
+    std::string level = command.substr(cmdTest.size());
+
+    mTestMapModeNoCpuPlayers = (level.compare(0, optNoCpu.size(), optNoCpu) == 0);
+
+    if (mTestMapModeNoCpuPlayers) {
+        level.erase(0, optNoCpu.size());
+    }
+
+    //the level folder must not end with a '/'
+    if (!level.empty() && (level.back() == '/')) {
+        level.pop_back();
+    }
+
+    mTestTargetLevel = level;
+    mTestMapWaitReported = false;
+
+    std::string logMessage("Start map test with map ");
+    logMessage.append(mTestTargetLevel);
+    logging::Info(logMessage);
+
+    mGameState = DEF_GAMESTATE_INITRACE;
 }
 
 bool Game::StartAttribution() {
@@ -1696,6 +1835,7 @@ bool Game::ParseCommandLineForGame() {
     std::string substr("test");
     std::string subStr2("nocpu");
     std::string subStr3("debug");
+    std::string subStr4("testserver");
     irr::u8 currIdx = 0;
 
     for (it = mCLIVec.begin(); it != mCLIVec.end(); ++it) {
@@ -1740,6 +1880,22 @@ bool Game::ParseCommandLineForGame() {
                logging::Info("Unlocked debugging functions in game");
         }
 
+        //if one parameter contains substring "testserver" the game was
+        //started by the level editor, and waits for map test commands on stdin
+        if ((*it).find(subStr4) != std::string::npos && ((*it).size() == subStr4.size())) {
+               mTestMapMode = true;
+               mTestMapServerMode = true;
+
+               mTestMapInput = new TestMapInput();
+               mTestMapInput->Start();
+
+               logging::Info("Activate map test server mode");
+
+               //In this special testMode only print
+               //Warning/Errors to the log window
+               logging::PrintOnlyIssues = true;
+        }
+
         currIdx++;
     }
 
@@ -1765,4 +1921,9 @@ Game::~Game() {
         raceLoadingScr->drop();
         raceLoadingScr = nullptr;
     }
+
+    if (mTestMapInput != nullptr) {
+        delete mTestMapInput;
+        mTestMapInput = nullptr;
+    }
 }
@@ -27,10 +27,16 @@
 #define DEF_GAMESTATE_INITRACE 11
 #define DEF_GAMESTATE_INITDEMO 12
 #define DEF_GAMESTATE_ERROR 13
+#define DEF_GAMESTATE_TESTMAPWAIT 14
 
 #define DEF_GAME_STARTRACE 0
 #define DEF_GAME_STARTDEMO 1
 
+//results of ContinueCreateNewRace
+#define DEF_GAME_RACECREATION_BUSY 0
+#define DEF_GAME_RACECREATION_DONE 1
+#define DEF_GAME_RACECREATION_FAILED 2
+
 // Values used to identify individual GUI elements
 enum
 {
@@ -45,12 +51,19 @@ enum
     GUI_ID_LEVEL_ACTIVATEMORPHKEYTRG_CHECKBOX,
     GUI_ID_LEVEL_SHOWCHARGINGSTATIONINFO_CHECKBOX,
     GUI_ID_LEVEL_SHOWCLONERECORDING_CHECKBOX,
+    GUI_ID_LEVEL_OCCLUSIONCULLING_CHECKBOX,
 
     GUI_ID_MOVEMENT_CURRWAYPOINTLINK_CHECKBOX,
     GUI_ID_MOVEMENT_ACTINGFORCES_CHECKBOX,
     GUI_ID_MOVEMENT_CPU_CURRSEGMENT_CHECKBOX,
     GUI_ID_MOVEMENT_CPU_PATHHISTORY_CHECKBOX,
-    GUI_ID_MOVEMENT_CPU_FREESPACE_CHECKBOX
+    GUI_ID_MOVEMENT_CPU_FREESPACE_CHECKBOX,
+
+    GUI_ID_DRAW_CAT_GENERAL_CHECKBOX,
+    GUI_ID_DRAW_CAT_WAYPOINTS_CHECKBOX,
+    GUI_ID_DRAW_CAT_LEVEL_CHECKBOX,
+    GUI_ID_DRAW_CAT_PHYSICS_CHECKBOX,
+    GUI_ID_DRAW_CAT_AIPATH_CHECKBOX
 };
 
 /************************
@@ -68,6 +81,7 @@ class Assets;
 class IntroPlayer;
 class MyMusicStream;
 class Race;
+class TestMapInput;
 
 class Game : public InfrastructureBase {
 private:
@@ -117,9 +131,21 @@ private:
     Race* mCurrentRace = nullptr;
     bool mTimeStopped = false;
 
-    bool CreateNewRace(int load_levelnr, std::vector<PilotInfoStruct*> pilotInfo, irr::u8 nrLaps, bool demoMode, bool debugRace);
-    bool CreateNewRace(std::string targetLevel, std::vector<PilotInfoStruct*> pilotInfo,
-                             irr::u8 nrLaps, bool demoMode, bool debugRace);
+    //Only starts the creation of a new race, the level is loaded
+    //afterwards step by step by ContinueCreateNewRace
+    //Returns false if the race creation could not be started
+    bool CreateNewRace(int load_levelnr, irr::u8 nrLaps, bool demoMode, bool debugRace);
+    bool CreateNewRace(std::string targetLevel, irr::u8 nrLaps, bool demoMode, bool debugRace);
+
+    //Must be called once per frame after CreateNewRace, while the race load screen is shown
+    //Returns DEF_GAME_RACECREATION_BUSY as long as the level is still loading; Afterwards the players
+    //in pilotInfo are added and DEF_GAME_RACECREATION_DONE or DEF_GAME_RACECREATION_FAILED is returned
+    irr::u8 ContinueCreateNewRace(std::vector<PilotInfoStruct*> pilotInfo);
+
+    //true while a race is created
+    bool mRaceCreationRunning = false;
+
+    void RaceCreationFailed();
 
     void RenderDataExtractionScreen();
     bool LoadBackgroundImage();
@@ -164,6 +190,19 @@ private:
     std::string mTestTargetLevel;
     bool mTestMapModeNoCpuPlayers = false;
 
+    //Map test server mode, the game is started by the level editor with command line
+    //parameter "testserver", and keeps running between the map tests. This way all game
+    //assets are only loaded once; The map test commands are read from stdin
+    bool mTestMapServerMode = false;
+    TestMapInput* mTestMapInput = nullptr;
+
+    //true if the level editor was already told that
+    //the game waits for the next map test command
+    bool mTestMapWaitReported = false;
+
+    //waits for the next map test command of the level editor
+    void GameLoopTestMapWait();
+
     //for Attribution
     //Returns true in case attribution has
     //started succesfully, False otherwise
@@ -198,6 +237,7 @@ public:
     bool InitGameStep2();
 
     void RunGame();
+
     void SetupDebugGame();
     void SetupDebugDemo();
 
@@ -13,15 +13,20 @@
 #include <iostream>
 #include <fstream>
 #include "draw/gametext.h"
+#include "draw/spritebatch.h"
 #include "input/input.h"
 #include "utils/tprofile.h"
 #include "utils/fileutils.h"
 #include "draw/drawdebug.h"
 #include "resources/readgamedata/bulcommn.h"
 #include "utils/crc32.h"
+#include "utils/threadpool.h"
+#include "resources/assetarchive.h"
+#include "resources/meshfileloader.h"
 #include <cwctype>
 #include <sstream>
 #include <iomanip>
+#include <filesystem>
 #include "draw/attribution.h"
 #include "font/font_manager.h"
 #include "game.h"
@@ -577,6 +582,12 @@ bool InfrastructureBase::InitStage2() {
     mDriver = mDevice->getVideoDriver();
     mSmgr = mDevice->getSceneManager();
 
+    //loader for the binary mesh files of the
+    //extracted 3D models, the scene manager keeps a reference
+    MeshFileLoader* meshLoader = new MeshFileLoader(mDriver, mDevice->getFileSystem());
+    mSmgr->addExternalMeshLoader(meshLoader);
+    meshLoader->drop();
+
     //get Irrlicht GUI functionality pointers
     mGuienv = mDevice->getGUIEnvironment();
 
@@ -656,6 +667,10 @@ bool InfrastructureBase::InitStage3() {
     mLogger = new Logger(mGuienv, logWindowPos);
     mLogger->HideWindow();
 
+    //is also needed by the game data extraction
+    //to verify already extracted files
+    mCrc32 = new Crc32();
+
     //Initial most basic game assets to be able
     //to show a first graphical screen to the user
     //remaining data extraction/loading of assets is
@@ -667,8 +682,6 @@ bool InfrastructureBase::InitStage3() {
 
     mTimeProfiler = new TimeProfiler(mGuienv, rect<s32>(100,150,300,300));
 
-    mCrc32 = new Crc32();
-
     if ((mRunningAs == INFRA_RUNNING_AS_EDITOR) ||
             ((mRunningAs == INFRA_RUNNING_AS_GAME) && (mGameConfig->enableDoubleResolution))) {
             mAttribution = new Attribution(this, 796, 0, true);
@@ -1808,6 +1821,81 @@ irr::io::IFileList* InfrastructureBase::CreateFileList(irr::io::path whichAbsPat
     return fileList;
 }
 
+irr::io::IFileList* InfrastructureBase::CreateFileListThreadSafe(irr::io::path whichPath) {
+    namespace fs = std::filesystem;
+
+    std::error_code ec;
+    fs::directory_iterator dirIt(fs::path(whichPath.c_str()), ec);
+
+    if (ec) {
+        return nullptr;
+    }
+
+    irr::io::IFileList* fileList = mDevice->getFileSystem()->createEmptyFileList(whichPath, false, false);
+
+    for (const fs::directory_entry& entry : dirIt) {
+        if (!entry.is_regular_file(ec))
+            continue;
+
+        //keep the same path style as the specified path, so that
+        //relative paths stay relative to the game root dir
+        irr::io::path fullPath(whichPath);
+        fullPath.append("/");
+        fullPath.append(entry.path().filename().string().c_str());
+
+        fileList->addItem(fullPath, 0, (irr::u32)(entry.file_size(ec)), false);
+    }
+
+    fileList->sort();
+
+    return fileList;
+}
+
+void InfrastructureBase::MountAssetArchive() {
+    //the archive belongs to the extracted data with exactly this manifest
+    uint32_t manifestChecksum = 0;
+
+    if (!mCrc32->ComputeFileChecksum(DEF_PREP_DATA_MANIFEST_FILE, manifestChecksum)) {
+        logging::Warning("No extraction manifest found, do not use asset archive");
+        return;
+    }
+
+    if (std::find(mCLIVec.begin(), mCLIVec.end(), std::string("packassets")) != mCLIVec.end()) {
+        logging::Info("Pack extracted game assets into asset archive...");
+
+        //the manifest and temporary files of the extraction are no assets
+        std::vector<std::string> skipFileVec = { DEF_PREP_DATA_MANIFEST_FILE, "extract/tmp-unpacked" };
+
+        if (!AssetArchive::Pack("extract", DEF_ASSETARCHIVE_FILE, manifestChecksum, skipFileVec)) {
+            logging::Warning("Packing of asset archive failed");
+        }
+    }
+
+    if (FileExists(DEF_ASSETARCHIVE_FILE) != 1)
+        return;
+
+    AssetArchive* archive = new AssetArchive(mDevice->getFileSystem(), DEF_ASSETARCHIVE_FILE);
+
+    if (!archive->IsReady()) {
+        archive->drop();
+        return;
+    }
+
+    if (archive->GetManifestChecksum() != manifestChecksum) {
+        logging::Warning("Asset archive is outdated, use extracted files instead (start with option 'packassets' to update it)");
+        archive->drop();
+        return;
+    }
+
+    //the file system searches archives before the
+    //real files; We keep our own reference for files
+    //that are not loaded by Irrlicht (sounds)
+    mDevice->getFileSystem()->addFileArchive(archive);
+    mAssetArchive = archive;
+
+    logging::Info("Asset archive mounted");
+}
+
 io::path InfrastructureBase::RemoveFileEndingFromFileName(io::path fileName) {
     io::path result("");
 
@@ -2244,6 +2332,10 @@ bool InfrastructureBase::InitGameResourcesInitialStep() {
     /* games main loop, so that rendering is not               */
     /* completely blocked                                      */
     /***********************************************************/
+    //game data extraction runs on the
+    //worker threads of the pool
+    mThreadPool = new ThreadPool();
+
     try {
         mPrepareData = new PrepareData(this);
     }
@@ -2258,6 +2350,7 @@ bool InfrastructureBase::InitGameResourcesInitialStep() {
     /* Load the first initial GameFont, so that we can show    */
     /* a first graphical screen                                */
     /***********************************************************/
+    mSpriteBatch = new SpriteBatch(this);
     mGameTexts = new GameText(this);
 
     if (!mGameTexts->GameTextInitializedOk) {
@@ -2793,9 +2886,22 @@ std::string InfrastructureBase::WStringToStdString(std::wstring inputStr) {
 }
 
 InfrastructureBase::~InfrastructureBase() {
+    //stop all worker threads first, as they
+    //could still use other objects below
+    delete mThreadPool;
+    mThreadPool = nullptr;
+
+    if (mAssetArchive != nullptr) {
+        mAssetArchive->drop();
+        mAssetArchive = nullptr;
+    }
+
     //cleanup game texts
     delete mGameTexts;
 
+    //removes also all atlas textures
+    delete mSpriteBatch;
+
     delete mTimeProfiler;
 
     delete mDrawDebug;
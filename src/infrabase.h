@@ -36,10 +36,13 @@ using namespace irr::gui;
 class Logger;
 class PrepareData;
 class GameText;
+class SpriteBatch;
 class MyEventReceiver;
 class TimeProfiler;
 class DrawDebug;
 class Crc32;
+class ThreadPool;
+class AssetArchive;
 class Attribution;
 class FontManager;
 
@@ -157,10 +160,22 @@ public:
 
   PrepareData* mPrepareData = nullptr;
   GameText* mGameTexts = nullptr;
+
+  //batches all 2D image drawing of fonts
+  //and HUD elements
+  SpriteBatch* mSpriteBatch = nullptr;
   TimeProfiler* mTimeProfiler = nullptr;
   Crc32* mCrc32 = nullptr;
   Attribution* mAttribution = nullptr;
 
+  //worker threads for work that should not block
+  //the main loop (for example game data extraction)
+  ThreadPool* mThreadPool = nullptr;
+
+  //packed archive of the extracted game assets, is nullptr if
+  //there is none (then the loose files in extract are used)
+  AssetArchive* mAssetArchive = nullptr;
+
   //Note: only used for the game itself
   //not for the Level editor
   GameConfigStruct* mGameConfig = nullptr;
@@ -172,6 +187,16 @@ public:
 
   irr::io::IFileList* CreateFileList(irr::io::path whichAbsPath);
 
+  //Same as CreateFileList, but does not change the current working directory
+  //of the process; Therefore can also be used from worker threads while other threads
+  //open files with relative paths. Directories are not part of the returned list
+  irr::io::IFileList* CreateFileListThreadSafe(irr::io::path whichPath);
+
+  //If command line option "packassets" is set, packs all extracted game assets
+  //into the asset archive first; Afterwards adds the asset archive to the Irrlicht
+  //file system, if the archive exists and still matches the extracted data
+  void MountAssetArchive();
+
   //if specified file is not found, returns empty path
   irr::io::path LocateFileInFileList(irr::io::IFileList* fileList, irr::core::string<fschar_t> fileName,
                                      bool ignoreFileEnding = false);
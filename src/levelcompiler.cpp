@@ -0,0 +1,137 @@
+/*
+ Copyright (C) 2026 Wolf Alexander
+
+ This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.                                          */
+
+#include "levelcompiler.h"
+#include "definitions.h"
+#include "resources/levelfile.h"
+#include "resources/levelcache.h"
+#include "utils/levelanalysis.h"
+#include "utils/path.h"
+#include "utils/crc32.h"
+#include "utils/logging.h"
+#include <vector>
+#include <cstdio>
+
+LevelCompiler::LevelCompiler(bool extendedGame) {
+    mExtendedGame = extendedGame;
+    mCrc32 = new Crc32();
+}
+
+LevelCompiler::~LevelCompiler() {
+    delete mCrc32;
+}
+
+bool LevelCompiler::CompileLevel(std::string levelFolder) {
+    size_t splitCharPos = levelFolder.find_last_of("/");
+
+    if (splitCharPos == std::string::npos) {
+        logging::Error("Specified level folder invalid, no '/' found");
+        return false;
+    }
+
+    //same file names as the race uses
+    std::string levelName(levelFolder.substr(splitCharPos + 1));
+
+    std::string levelFilename(levelFolder);
+    levelFilename.append("/");
+    levelFilename.append(levelName);
+    levelFilename.append("-unpacked.dat");
+
+    std::string cacheFilename(levelFolder);
+    cacheFilename.append("/");
+    cacheFilename.append(LEVELCACHE_FILENAME);
+
+    LevelFile* levelRes = new LevelFile(mCrc32, levelFilename, mExtendedGame);
+
+    if (!levelRes->get_Ready()) {
+        logging::Error("Level file could not be loaded");
+        delete levelRes;
+        return false;
+    }
+
+    //keep the sections of an existing cache file that is still valid for this
+    //level file, the game adds the sections which need the Irrlicht device
+    //(terrain and block meshes, collision triangles) during the first race start
+    LevelCache* levelCache = new LevelCache(mCrc32, cacheFilename, levelRes->GetChecksum());
+    levelCache->Load();
+
+    //create the wall segment lines and waypoint
+    //links like the race does
+    std::vector<LineStruct*> wallSegmentLines;
+    std::vector<WayPointLinkInfoStruct*> wayPointLinks;
+
+    LevelAnalysis::CreateWallSegmentLines(levelRes, wallSegmentLines);
+    LevelAnalysis::CreateWayPointLinks(levelRes, wayPointLinks);
+
+    //always derive the data again
+    LevelAnalysis* levelAnalysis = new LevelAnalysis(levelRes);
+
+    levelAnalysis->CreateStaticWorldMap(wallSegmentLines);
+    levelAnalysis->StoreStaticWorldMapInCache(levelCache);
+
+    levelAnalysis->AnalyzeWaypointLinksOffsetRange(wayPointLinks);
+    levelAnalysis->StoreWaypointLinksOffsetRangeInCache(levelCache, wayPointLinks);
+
+    char hlpstr[100];
+    snprintf(hlpstr, 100, "%u wall segment lines, %u waypoint links analyzed",
+             (unsigned int)(wallSegmentLines.size()), (unsigned int)(wayPointLinks.size()));
+    logging::Info(hlpstr);
+
+    bool compileOk = levelCache->Save();
+
+    if (!compileOk) {
+        logging::Error("Level cache file could not be written");
+    } else {
+        compileOk = VerifyLevelCacheFile(cacheFilename, levelRes->GetChecksum());
+    }
+
+    delete levelAnalysis;
+    LevelAnalysis::CleanUpWayPointLinks(wayPointLinks);
+    LevelAnalysis::CleanUpWallSegmentLines(wallSegmentLines);
+    delete levelCache;
+    delete levelRes;
+
+    if (compileOk) {
+        std::string msg("Level cache file written and verified: ");
+        msg.append(cacheFilename);
+        logging::Info(msg);
+    } else {
+        //do not leave an incomplete cache file behind,
+        //the game derives the data itself then
+        std::remove(cacheFilename.c_str());
+    }
+
+    return compileOk;
+}
+
+bool LevelCompiler::VerifyLevelCacheFile(std::string cacheFilename, uint32_t levelFileChecksum) {
+    //use a new object, so that the file on disk is checked,
+    //not the sections that are still in memory
+    LevelCache* verifyCache = new LevelCache(mCrc32, cacheFilename, levelFileChecksum);
+
+    bool valid = verifyCache->Load();
+
+    if (valid) {
+        if (!verifyCache->HasSection(LEVELCACHE_SECTION_STATICWORLDMAP)) {
+            logging::Error("Level cache file has no static world map section");
+            valid = false;
+        }
+
+        if (!verifyCache->HasSection(LEVELCACHE_SECTION_WAYPOINTOFFSETRANGE)) {
+            logging::Error("Level cache file has no waypoint link offset range section");
+            valid = false;
+        }
+    } else {
+        logging::Error("Level cache file could not be loaded");
+    }
+
+    delete verifyCache;
+
+    return valid;
+}
@@ -0,0 +1,44 @@
+/*
+ Copyright (C) 2026 Wolf Alexander
+
+ This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.                                          */
+
+#ifndef LEVELCOMPILER_H
+#define LEVELCOMPILER_H
+
+#include <string>
+#include <cstdint>
+
+/************************
+ * Forward declarations *
+ ************************/
+
+class Crc32;
+
+//The level compiler of hi-levelc: Derives the level cache sections that only depend on the
+//level file (static world map, waypoint link offset ranges) with LevelAnalysis, the same code
+//the game uses, and writes them into the level cache file of the level; Does not need the
+//Irrlicht device, the game and the original game data
+class LevelCompiler {
+public:
+    LevelCompiler(bool extendedGame);
+    ~LevelCompiler();
+
+    //Compiles the level in the specified level folder (for example "extract/level0-1")
+    //Returns true for success, false for error occured
+    bool CompileLevel(std::string levelFolder);
+
+private:
+    Crc32* mCrc32 = nullptr;
+    bool mExtendedGame;
+
+    //Loads the written level cache file again, and checks that it is valid for
+    //the level file and contains all sections the compiler derives
+    bool VerifyLevelCacheFile(std::string cacheFilename, uint32_t levelFileChecksum);
+};
+
+#endif // LEVELCOMPILER_H
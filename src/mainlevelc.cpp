@@ -0,0 +1,100 @@
+/*
+ Copyright (C) 2026 Wolf Alexander
+
+ This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.                                          */
+
+//hi-levelc: the level compiler
+//Derives the level cache sections that only depend on the level file (static world map,
+//waypoint link offset ranges) offline, without a window, Irrlicht device or audio, and writes
+//and verifies the level cache file of each level; The game afterwards only needs to validate
+//the cache file against the level file checksum at race start
+//
+//Usage: hi-levelc [level folder ...]
+//Without a level folder (for example extract/level0-1) all extracted levels of the game are compiled
+
+#include "levelcompiler.h"
+#include "utils/logging.h"
+#include <vector>
+#include <string>
+#include <fstream>
+#include <cstdio>
+
+//returns true if the level file of the specified
+//level folder exists
+bool LevelFileExists(std::string levelFolder) {
+    size_t splitCharPos = levelFolder.find_last_of("/");
+
+    std::string levelFilename(levelFolder);
+    levelFilename.append("/");
+    levelFilename.append(levelFolder.substr(splitCharPos + 1));
+    levelFilename.append("-unpacked.dat");
+
+    std::ifstream ifile(levelFilename, std::ifstream::binary);
+
+    return (bool)(ifile);
+}
+
+int main(int argc, char **argv)
+{
+    //all parameters with a '/' are level folders
+    std::vector<std::string> levelVec;
+    std::vector<std::string>::iterator it;
+
+    for (int argIdx = 1; argIdx < argc; argIdx++) {
+        std::string level(argv[argIdx]);
+
+        if (level.find('/') != std::string::npos) {
+            //remove a trailing '/'
+            if (level.back() == '/') {
+                level.pop_back();
+            }
+
+            levelVec.push_back(level);
+        }
+    }
+
+    //only the extended game has more than 6 levels
+    bool extendedGame = LevelFileExists("extract/level0-7");
+
+    if (levelVec.size() == 0) {
+        int nrLevels = extendedGame ? 9 : 6;
+        char hlpstr[50];
+
+        for (int levelNr = 1; levelNr <= nrLevels; levelNr++) {
+            snprintf(hlpstr, 50, "extract/level0-%d", levelNr);
+            levelVec.push_back(std::string(hlpstr));
+        }
+    }
+
+    LevelCompiler* levelCompiler = new LevelCompiler(extendedGame);
+
+    unsigned int nrFailed = 0;
+
+    for (it = levelVec.begin(); it != levelVec.end(); ++it) {
+        std::string msg("Compile level ");
+        msg.append(*it);
+        logging::Info(msg);
+
+        if (!levelCompiler->CompileLevel(*it)) {
+            std::string errMsg("Compiling level ");
+            errMsg.append(*it);
+            errMsg.append(" failed");
+            logging::Error(errMsg);
+
+            nrFailed++;
+        }
+    }
+
+    char hlpstr[100];
+    snprintf(hlpstr, 100, "Compiled %u of %u levels", (unsigned int)(levelVec.size()) - nrFailed,
+             (unsigned int)(levelVec.size()));
+    logging::Info(hlpstr);
+
+    delete levelCompiler;
+
+    return (nrFailed == 0) ? 0 : 1;
+}
@@ -27,6 +27,7 @@ const irr::f32 DEF_TYPE2_COLLECTABLE_LIFETIME = 30.0f;
  ************************/
 
 class InfrastructureBase;
+struct VisGridEntryStruct;
 
 //Note 02.02.2025: In this project there are two different types of Collectables
 // Type 1: Entities (Collectables) that are stored inside the original game map files, and always
@@ -59,6 +60,10 @@ public:
     irr::scene::IBillboardSceneNode *billSceneNode = nullptr;
     irr::core::aabbox3df boundingBox;
 
+    //entry of this collectable inside the race visibility grid
+    //only used for collectables of the first type
+    VisGridEntryStruct* mVisGridEntry = nullptr;
+
     bool GetIfVisible();
     void PickedUp();
     void Trigger();
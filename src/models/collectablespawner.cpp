@@ -68,7 +68,7 @@ void CollectableSpawner::Update(irr::f32 deltaTime) {
 
                           //is there actually an entry?
                           if (mEntry != nullptr) {
-                               terrainHeight = mRace->mLevelTerrain->pTerrainTiles[mEntry->get_X()][mEntry->get_Z()].currTileHeight;
+                               terrainHeight = mRace->mLevelTerrain->mTileStore->GetTileHeight(mEntry->get_X(), mEntry->get_Z());
 
                                //collectible too close to terrain, stop the collectible to continue further
                                if (((*it)->pntrCollectable->Position.Y - terrainHeight) < ((*it)->pntrCollectable->GetCollectableCenterHeight())) {
@@ -274,7 +274,7 @@ irr::f32 Column::GetCurrentHeightTile(int x, int z) {
     if (x > Width - 1) x = Width - 1;
     if (z > Height - 1) z = Height - 1;
 
-    return mTerrain->pTerrainTiles[x][z].vert1CurrPositionY;
+    return mTerrain->mTileStore->GetVertexHeight(x, z, 1);
 }
 
 irr::f32 Column::GetOriginalHeightTile(int x, int z) {
@@ -24,7 +24,7 @@ Cone::Cone(Race* race, irr::f32 x, irr::f32 y, irr::f32 z, irr::scene::ISceneMan
 
     orientation.set(irr::core::vector3df(0.0f, 0.0f, 0.0f));
 
-    coneMesh = smgr->getMesh("extract/models/cone0-0.obj");
+    coneMesh = smgr->getMesh("extract/models/cone0-0.hmesh");
     cone_node = smgr->addMeshSceneNode(coneMesh);
 
     cone_node->setPosition(Position);
@@ -96,7 +96,7 @@ void Cone::Update(irr::f32 deltaTime) {
 
                 //is there actually an entry?
                 if (mEntry != nullptr) {
-                     terrainHeight = mRace->mLevelTerrain->pTerrainTiles[mEntry->get_X()][mEntry->get_Z()].currTileHeight;
+                     terrainHeight = mRace->mLevelTerrain->mTileStore->GetTileHeight(mEntry->get_X(), mEntry->get_Z());
 
                      //cone too close to terrain, stop the cone to continue further
                      if ((Position.Y - terrainHeight) < mCenterHeight) {
@@ -17,6 +17,7 @@
  ************************/
 
 class Race;
+struct VisGridEntryStruct;
 
 class Cone {
 public:
@@ -28,13 +29,17 @@ public:
 
     irr::core::vector3df Position;
     bool mActivity = false;
+
+    irr::scene::IMeshSceneNode* cone_node = nullptr;
+
+    //entry of this cone inside the race visibility grid
+    VisGridEntryStruct* mVisGridEntry = nullptr;
+
 private:
     irr::core::quaternion orientation;
     irr::core::vector3d<irr::f32> rotAxis;
 
     irr::scene::IAnimatedMesh*  coneMesh = nullptr;
-    irr::scene::IMeshSceneNode* cone_node = nullptr;
-
     irr::scene::ISceneManager* mSmgr = nullptr;
 
     Race *mRace = nullptr;
@@ -548,7 +548,7 @@ void CpuPlayer::DebugDrawCurrentSegment() {
        for (itPathEl = mCurrentPathSeg.begin(); itPathEl != mCurrentPathSeg.end(); ++itPathEl) {
              mParentPlayer->mRace->mGame->mDrawDebug->Draw3DLine((*itPathEl)->pLineStruct->A,
                                                                  (*itPathEl)->pLineStruct->B,
-                                                                 (*itPathEl)->pLineStruct->color);
+                                                                 (*itPathEl)->pLineStruct->color, DEF_DRAWDEBUG_CAT_AIPATH);
         }
   }
 }
@@ -560,7 +560,7 @@ void CpuPlayer::DebugDrawPathHistory() {
         for (itPathEl = mPathHistoryVec.begin(); itPathEl != mPathHistoryVec.end(); ++itPathEl) {
            mParentPlayer->mRace->mGame->mDrawDebug->Draw3DLine((*itPathEl)->pLineStruct->A,
                                                                (*itPathEl)->pLineStruct->B,
-                                                               (*itPathEl)->pLineStruct->color);
+                                                               (*itPathEl)->pLineStruct->color, DEF_DRAWDEBUG_CAT_AIPATH);
        }
     }
 }
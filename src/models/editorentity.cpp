@@ -55,7 +55,7 @@ EditorEntity::EditorEntity(EntityManager* parentManager, EntityItem* itemPntr, i
         mTransparentMesh = true;
 
         //Create us a SteamFountain for visible effect
-        mSteamFountain = new SteamFountain(mSpriteTex, itemPntr, mParentManager->mInfra->mSmgr, mParentManager->mInfra->mDriver,
+        mSteamFountain = new SteamFountain(mSpriteTex, itemPntr, mParentManager->mParticleBatch, mParentManager->mInfra->mSmgr, mParentManager->mInfra->mDriver,
             mPosition, 100);
 
         mSteamFountain->Activate();
@@ -194,7 +194,7 @@ void EditorEntity::UpdatePosition() {
 
             //Create a new SteamFountain for visible effect
             //at the new location
-            mSteamFountain = new SteamFountain(mSpriteTex, mEntityItem, mParentManager->mInfra->mSmgr, mParentManager->mInfra->mDriver,
+            mSteamFountain = new SteamFountain(mSpriteTex, mEntityItem, mParentManager->mParticleBatch, mParentManager->mInfra->mSmgr, mParentManager->mInfra->mDriver,
                 mPosition, 100);
 
             //activate the new mSteamFountain again
@@ -18,6 +18,7 @@
 #include "../models/editorentity.h"
 #include "../resources/texture.h"
 #include "../utils/logging.h"
+#include "../scenenodes/particlebatch.h"
 #include "../resources/levelfile.h"
 #include "irrlicht.h"
 
@@ -64,6 +65,13 @@ EntityManager::EntityManager(InfrastructureBase* infra, LevelFile* levelRes, Lev
         DEF_EDITOR_ENTITYMANAGER_STEAMFOUNTAIN_SELMESHBOXCOLOR);
 
     mSelectionMeshVec.clear();
+
+    //create the scene node which renders the particles
+    //of all SteamFountains
+    mParticleBatch = new ParticleBatchSceneNode(mInfra->mSmgr->getRootSceneNode(), mInfra->mSmgr);
+
+    //the parent scene node holds a reference now
+    mParticleBatch->drop();
 }
 
 EntityManager::~EntityManager() {
@@ -73,6 +81,12 @@ EntityManager::~EntityManager() {
 
     CleanUpEntities();
 
+    //all SteamFountains are gone now
+    if (mParticleBatch != nullptr) {
+        mParticleBatch->remove();
+        mParticleBatch = nullptr;
+    }
+
     if (mSteamFountainMesh != nullptr) {
         //remove this Mesh from the Meshcache
         mInfra->mSmgr->getMeshCache()->removeMesh(mSteamFountainMesh);
@@ -662,11 +676,11 @@ irr::io::path EntityManager::GetModelForEntityType(Entity::EntityType entityType
        }
 
        case Entity::EntityType::RecoveryTruck: {
-            return irr::io::path("extract/models/recov0-0.obj");
+            return irr::io::path("extract/models/recov0-0.hmesh");
         }
 
         case Entity::EntityType::Cone: {
-            return irr::io::path("extract/models/cone0-0.obj");
+            return irr::io::path("extract/models/cone0-0.hmesh");
         }
 
         case Entity::EntityType::Checkpoint: {
@@ -1251,7 +1265,7 @@ irr::video::ITexture* EntityManager::GetImageForEntityType(Entity::EntityType mE
         }
 
         case Entity::EntityType::Checkpoint: {
-            return (mTexLoader->levelTex.at(121));
+            return (mTexLoader->GetLevelTexture(121));
         }
 
         case Entity::EntityType::Cone: {
@@ -1648,15 +1662,15 @@ void EntityManager::CreateModelPictures() {
     mTexImageCone = mInfra->mDriver->addTexture(mRenderToTargetTexImageSize, "ModelPreviewCone");
 
     //Create image of recovery vehicle
-    CreateModelPreview((char*)("extract/models/recov0-0.obj"), irr::core::vector3df(40.0f, -50.0f, 0.0f),
+    CreateModelPreview((char*)("extract/models/recov0-0.hmesh"), irr::core::vector3df(40.0f, -50.0f, 0.0f),
                      irr::core::vector3df(44.325f, -51.7125f, 4.925f), irr::core::vector3df(40.5f, -48.5f, 0.0f), *mTexImageRecoveryVehicle);
 
     //Create image of a race vehicle
-    CreateModelPreview((char*)("extract/models/bike0-0.obj"), irr::core::vector3df(40.5f, -48.5f, 0.0f),
+    CreateModelPreview((char*)("extract/models/bike0-0.hmesh"), irr::core::vector3df(40.5f, -48.5f, 0.0f),
         irr::core::vector3df(40.1f, -48.1f, -0.7f), irr::core::vector3df(40.5f, -48.5f, 0.0f), *mTexImageRaceVehicle);
 
     //Create image of cone
-    CreateModelPreview((char*)("extract/models/cone0-0.obj"), irr::core::vector3df(40.0f, -50.0f, 0.0f),
+    CreateModelPreview((char*)("extract/models/cone0-0.hmesh"), irr::core::vector3df(40.0f, -50.0f, 0.0f),
                      irr::core::vector3df(40.4f, -49.6f, 0.4f), irr::core::vector3df(40.0f, -49.9f, 0.0f), *mTexImageCone);
 }
 
@@ -55,6 +55,7 @@ class LevelTerrain;
 class LevelBlocks;
 class Morph;
 class TextureLoader;
+class ParticleBatchSceneNode;
 struct ColorStruct;
 
 class EntityManager {
@@ -130,6 +131,9 @@ public:
     InfrastructureBase* mInfra = nullptr;
     TextureLoader* mTexLoader = nullptr;
 
+    //renders the particles of all SteamFountains
+    ParticleBatchSceneNode* mParticleBatch = nullptr;
+
     void UpdateSteamFoutains(irr::f32 frameDeltaTime);
 
     void SetVisible(irr::u8 whichEntityClass, bool visible);
@@ -2,6 +2,10 @@
 #include "explosion.h"
 #include "../resources/texture.h"
 #include "../race.h"
+#include "../models/levelterrain.h"
+#include "../utils/physics.h"
+#include "../resources/mapentry.h"
+#include "../scenenodes/particlebatch.h"
 
 //Returns true in case of success
 //False otherwise
@@ -32,6 +36,57 @@ void ExplosionLauncher::Trigger(irr::core::vector3df targetLocation) {
     this->mCurrentExplosionVec.push_back(newExplosion);
 }
 
+void ExplosionLauncher::EmitDebrisSprite(irr::core::vector3df location, irr::core::vector3df velocity, irr::f32 spriteSize,
+                                         irr::f32 lifeTime, irr::u8 texNr) {
+    if (mDebrisPool == nullptr)
+        return;
+
+    irr::s32 newIdx = mDebrisPool->Emit(location, lifeTime, spriteSize, 0.0f, texNr);
+
+    if (newIdx < 0)
+        return;
+
+    //debris sprites do not change the velocity over lifetime
+    //only gravity is applied
+    irr::core::vector3df vel = velocity * DEF_EXPLAUNCHER_DEBRISSPEEDFACTOR;
+    mDebrisPool->SetMovementVelocity((irr::u32)(newIdx), vel, vel);
+}
+
+void ExplosionLauncher::UpdateDebrisTerrainCollision() {
+    irr::u32 nrSprites = mDebrisPool->GetNrActiveParticles();
+
+    int current_cell_calc_x, current_cell_calc_y;
+    irr::f32 terrainHeight;
+    LevelTerrain* terrain = mParentRace->mLevelTerrain;
+
+    for (irr::u32 idx = 0; idx < nrSprites; idx++) {
+        //check if sprite is currently moving towards ground, and is very close to race track ground (hits the ground)
+        //in this case let the debris sprite disappear
+        //only check more if the sprite is currently falling towards the race track
+        if (mDebrisPool->mVelStartY[idx] < 0.0f) {
+            //yes, sprite is falling down, now we need to calculate high about terrain tile below
+            //calculate current cell below sprite
+            current_cell_calc_y = (int)(mDebrisPool->mPosZ[idx] / terrain->segmentSize);
+            current_cell_calc_x = -(int)(mDebrisPool->mPosX[idx] / terrain->segmentSize);
+
+            MapEntry* mEntry = terrain->GetMapEntry(current_cell_calc_x, current_cell_calc_y);
+
+            //is there actually an entry?
+            if (mEntry != nullptr) {
+                 terrainHeight = terrain->mTileStore->GetTileHeight(mEntry->get_X(), mEntry->get_Z());
+
+                 //sprite to close to terrain, if so stop the sprite to continue further
+                 if ((mDebrisPool->mPosY[idx] - terrainHeight) < 0.3f) {
+                     mDebrisPool->Kill(idx);
+                 }
+            } else {
+                //we did not find a valid entry, end sprite here
+                mDebrisPool->Kill(idx);
+            }
+        }
+    }
+}
+
 void ExplosionLauncher::Update(irr::f32 DeltaTime) {
 
    std::vector <Explosion*>::iterator it;
@@ -52,6 +107,15 @@ void ExplosionLauncher::Update(irr::f32 DeltaTime) {
     }*/
    }
 
+   if (mDebrisPool != nullptr) {
+       //move all existing debris sprites, new sprites
+       //are added afterwards by the explosions
+       mDebrisPool->mAcceleration = mParentRace->mPhysics->mGravityVec * DEF_EXPLAUNCHER_DEBRISSPEEDFACTOR * DEF_EXPLAUNCHER_DEBRISSPEEDFACTOR;
+       mDebrisPool->Update(DeltaTime);
+
+       UpdateDebrisTerrainCollision();
+   }
+
    if (mCurrentExplosionVec.size() > 0 ) {
      //update all my current active explosions
     for (it = this->mCurrentExplosionVec.begin(); it != this->mCurrentExplosionVec.end(); ++it) {
@@ -76,9 +140,26 @@ ExplosionLauncher::ExplosionLauncher(Race* myParentRace, irr::scene::ISceneManag
 
     if (!LoadSprites()) {
         ready = false;
+    } else {
+        std::vector<irr::video::ITexture*> debrisTex;
+
+        for (irr::u32 i = 0; i < animTexList.size(); i++) {
+            debrisTex.push_back(animTexList[i]);
+        }
+
+        mDebrisPool = mParentRace->mParticleBatch->CreatePool(DEF_EXPLAUNCHER_MAXDEBRISSPRITES, debrisTex);
+
+        //debris sprites do not fade out, and are lit
+        //like the old billboard debris
+        mDebrisPool->mFadeOut = false;
+        mDebrisPool->mMaterial.Lighting = true;
     }
 }
 
 ExplosionLauncher::~ExplosionLauncher() {
     //TODO:: Cleanup whole explosion launcher stuff here!
+    if (mDebrisPool != nullptr) {
+        mParentRace->mParticleBatch->RemovePool(mDebrisPool);
+        mDebrisPool = nullptr;
+    }
 }
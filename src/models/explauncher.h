@@ -14,12 +14,21 @@
 #include <vector>
 #include "../audio/sound.h"
 
+//max number of explosion debris sprites
+//of all currently active explosions together
+#define DEF_EXPLAUNCHER_MAXDEBRISSPRITES 1024
+
+//the debris was moved with 0.015 * (deltaTime * 60) per frame
+//in the past, this factor keeps the same debris flight path
+#define DEF_EXPLAUNCHER_DEBRISSPEEDFACTOR 0.9f
+
 /************************
  * Forward declarations *
  ************************/
 
 class Race;
 class Explosion;
+class ParticlePool;
 
 class ExplosionLauncher {
     public:
@@ -38,6 +47,10 @@ class ExplosionLauncher {
 
         irr::core::array<irr::video::ITexture*> animTexList;
 
+        //adds a new flying debris sprite to the debris particle pool
+        void EmitDebrisSprite(irr::core::vector3df location, irr::core::vector3df velocity, irr::f32 spriteSize,
+                              irr::f32 lifeTime, irr::u8 texNr);
+
     private:
 
         std::vector<Explosion*> mCurrentExplosionVec;
@@ -46,6 +59,12 @@ class ExplosionLauncher {
         //False otherwise
         bool LoadSprites();
 
+        //all flying debris sprites of all explosions
+        ParticlePool* mDebrisPool = nullptr;
+
+        //removes debris sprites that hit the race track
+        void UpdateDebrisTerrainCollision();
+
         irr::f32 timeAccu = 0.0f;
         irr::f32 coolOffTime = 0.0f;
 
@@ -10,9 +10,6 @@
 #include "explosion.h"
 #include "../models/explauncher.h"
 #include "../race.h"
-#include "../models/levelterrain.h"
-#include "../utils/physics.h"
-#include "../resources/mapentry.h"
 
 Explosion::Explosion(irr::core::vector3df targetLoc, ExplosionLauncher* parentExpLauncher) {
     this->targetLocation = targetLoc;
@@ -24,7 +21,6 @@ Explosion::Explosion(irr::core::vector3df targetLoc, ExplosionLauncher* parentEx
     irr::f32 rNumFloat1;
     irr::f32 rNumFloat2;
     irr::f32 rNumFloat3;
-    irr::f32 rNumFloat4;
     irr::f32 rNumFloat5;
     int rNum;
 
@@ -72,7 +68,6 @@ Explosion::Explosion(irr::core::vector3df targetLoc, ExplosionLauncher* parentEx
     }
 
     irr::f32 timer = DEF_EXPLOSION_DEBRIS_DISTANCENEXTSPRITE;
-    irr::f32 lifeTime = DEF_EXPLOSION_DEBRISSPRITELIFETIME;
 
     //create all flying debris for this explosion
     for (int i = 0; i < DEF_EXPLOSION_NRDEBRIS; i++) {
@@ -113,15 +108,6 @@ Explosion::Explosion(irr::core::vector3df targetLoc, ExplosionLauncher* parentEx
         rNum = rand();
         rNumFloat3 = -randVal * 0.5f + (float(rNum) / float (RAND_MAX))  * randVal;
 
-        //also randomize the size slightly
-        //rNum = rand();
-        //rNumFloat4 = 0.5f + (float(rNum) / float (RAND_MAX))  * 1.0f;
-
-        //first sprite (glowing ball for missile) should be only half the size
-        rNumFloat4 = DEF_EXPLOSION_DEBRIS_SPRITESIZE * 0.5f;
-
-        irr::core::dimension2d<irr::f32> newSpriteSize(rNumFloat4, rNumFloat4);
-
         //derive a random speed when we shoot the object out
         //let all debris sprites use the same velocity
         rNum = rand();
@@ -136,8 +122,8 @@ Explosion::Explosion(irr::core::vector3df targetLoc, ExplosionLauncher* parentEx
         //remember spawn point where the debris is coming from
         newDebris->spawnPoint = targetLoc + irr::core::vector3df(rNumFloat1, rNumFloat2, rNumFloat3);
 
-        //add first sprite to debris
-        AddNewSpriteToDebris(*newDebris, newDebris->spawnPoint, newDebris->mVelocity, newSpriteSize, lifeTime);
+        //the first sprite of the debris is added
+        //as soon as the debris is shoot away
 
         //set random detonation delay
         rNum = rand();
@@ -154,38 +140,23 @@ Explosion::Explosion(irr::core::vector3df targetLoc, ExplosionLauncher* parentEx
 Explosion::~Explosion() {
 }
 
-void Explosion::AddNewSpriteToDebris(ExplosionFlyingDebrisStruct &debrisPntr, irr::core::vector3df newLocation,
-                                     irr::core::vector3df currVel, irr::core::dimension2d<irr::f32> newSpriteSize, irr::f32 lifeTime) {
-    irr::scene::IBillboardSceneNode* newSceneNode = mParentExplosionLauncher->mSmgr->addBillboardSceneNode();
-
-    newSceneNode->setMaterialTexture(0, mParentExplosionLauncher->animTexList[debrisPntr.currTexNrFlyingDebris]);
-
+void Explosion::AddNewSpriteToDebris(ExplosionFlyingDebrisStruct &debrisPntr, irr::f32 newSpriteSize, irr::f32 lifeTime) {
     //with every sprite we add to the flying debris we want to use the next texture in
     //the explosion texture order; the game seems to do the same, the last texture is a cloud
     //texture we just keep repeating; Increase index of used texture until we can not increase it anymore
     //because we reached already the cloud sprite
     //first texture is the glowing ball for the missile itself
-    if (debrisPntr.currTexNrFlyingDebris < (mParentExplosionLauncher->animTexList.size() - 1)) {
-        debrisPntr.currTexNrFlyingDebris++;
-    }
-
-    newSceneNode->setMaterialType(irr::video::EMT_TRANSPARENT_ADD_COLOR );
-    newSceneNode->setMaterialFlag(irr::video::EMF_LIGHTING, true);
-    newSceneNode->setMaterialFlag(irr::video::EMF_ZBUFFER, true);
+    irr::u32 texNr = debrisPntr.nrSpritesEmitted;
 
-    //newSceneNode->setDebugDataVisible(irr::scene::EDS_BBOX);
-
-    newSceneNode->setPosition(newLocation);
-    newSceneNode->setSize(newSpriteSize);
+    if (texNr > (mParentExplosionLauncher->animTexList.size() - 1)) {
+        texNr = mParentExplosionLauncher->animTexList.size() - 1;
+    }
 
-    //first hide new sprite
-    newSceneNode->setVisible(false);
+    //all sprites start at the spawn point, and follow the same path
+    mParentExplosionLauncher->EmitDebrisSprite(debrisPntr.spawnPoint, debrisPntr.mVelocity, newSpriteSize, lifeTime, (irr::u8)(texNr));
 
-    debrisPntr.mSceneNodeDebrisSprite.push_back(newSceneNode);
-    debrisPntr.currVelocity.push_back(currVel);
-    debrisPntr.currSpritePos.push_back(newLocation);
-    debrisPntr.mCurrSpriteSize.push_back(newSpriteSize);
-    debrisPntr.remainingLifeTime.push_back(lifeTime);
+    debrisPntr.nrSpritesEmitted++;
+    debrisPntr.lastSpriteRemainingLifeTime = lifeTime;
 }
 
 void Explosion::UpdateDetonations(irr::f32 DeltaTime) {
@@ -249,8 +220,6 @@ void Explosion::UpdateDebris(irr::f32 DeltaTime) {
     //cycle through all of my debris
     std::vector<ExplosionFlyingDebrisStruct*>::iterator it;
     ExplosionFlyingDebrisStruct* pntr;
-    std::vector<irr::scene::IBillboardSceneNode*>::iterator it2;
-    irr::scene::IBillboardSceneNode* pntr2;
 
     //first clean up debris that is not visible anymore (happened already)
     for (it = this->mExplosionDebrisVec.begin(); it != this->mExplosionDebrisVec.end();) {
@@ -259,33 +228,17 @@ void Explosion::UpdateDebris(irr::f32 DeltaTime) {
             //we need to clean this one up
             it = mExplosionDebrisVec.erase(it);
 
-            //get rid of all of the sceneNodes inside this debris
-            for (it2 = pntr->mSceneNodeDebrisSprite.begin(); it2 != pntr->mSceneNodeDebrisSprite.end(); ++it2) {
-                pntr2 = (*it2);
-
-                it2 = pntr->mSceneNodeDebrisSprite.erase(it2);
-
-                //remove the sceneNode
-                pntr2->remove();
-            }
-
-            //delete the struct itself
+            //delete the struct itself, the sprites are
+            //already removed from the particle pool
             delete pntr;
           } else ++it;
     }
 
-    int idx;
-    irr::f32 rNumFloat4 = DEF_EXPLOSION_DEBRIS_SPRITESIZE;
     irr::f32 lifeTime = DEF_EXPLOSION_DEBRISSPRITELIFETIME;
-    bool spriteRemaining = false;
-    irr::f32 terrainHeight;
-    //int rNum;
-
-    int current_cell_calc_x, current_cell_calc_y;
-
-    irr::f32 speedFactor = (DeltaTime / (irr::f32)(1.0f / 60.0f));
 
     //now update all the remaining explosion objects
+    //the movement of the sprites itself is done by the particle pool
+    //of the explosion launcher
     for (it = this->mExplosionDebrisVec.begin(); it != this->mExplosionDebrisVec.end(); ++it) {
 
         if (!(*it)->detonated) {
@@ -295,62 +248,13 @@ void Explosion::UpdateDebris(irr::f32 DeltaTime) {
                 (*it)->detonationDelay -= DeltaTime;
                 if ((*it)->detonationDelay < 0.0f) {
                     //delay is over, shoot debris away
-
                     (*it)->currDetonating = true;
 
-                    //make all sprites visible
-                    for (it2 = (*it)->mSceneNodeDebrisSprite.begin(); it2 != (*it)->mSceneNodeDebrisSprite.end(); ++it2) {
-                        (*it2)->setVisible(true);
-                    }
+                    //first sprite (glowing ball for missile) should be only half the size
+                    AddNewSpriteToDebris(*(*it), DEF_EXPLOSION_DEBRIS_SPRITESIZE * 0.5f, lifeTime);
                    }
             } else {
-
-                //debris is flying right now, update position of all existing sprites
-                idx = 0;
-                for (it2 = (*it)->mSceneNodeDebrisSprite.begin(); it2 != (*it)->mSceneNodeDebrisSprite.end(); ++it2) {
-                    (*it)->currSpritePos[idx] = (*it)->currSpritePos[idx] + (*it)->currVelocity[idx] * speedFactor * 0.015f;
-                    (*it)->currVelocity[idx] = (*it)->currVelocity[idx] + this->mParentExplosionLauncher->mParentRace->mPhysics->mGravityVec * speedFactor * 0.015f;
-
-                    (*it2)->setPosition((*it)->currSpritePos[idx]);
-
-                    //check if sprite is currently moving towards ground, and is very close to race track ground (hits the ground)
-                    //in this case let the debris sprite disappear
-                    //only check more if the sprite is currently falling towards the race track
-                    if ((*it)->currVelocity[idx].Y < 0.0f) {
-                        //yes, sprite is falling down, now we need to calculate high about terrain tile below
-                        //calculate current cell below sprite
-                        current_cell_calc_y = (int)((*it)->currSpritePos[idx].Z / mParentExplosionLauncher->mParentRace->mLevelTerrain->segmentSize);
-                        current_cell_calc_x = -(int)((*it)->currSpritePos[idx].X / mParentExplosionLauncher->mParentRace->mLevelTerrain->segmentSize);
-
-                        MapEntry* mEntry = mParentExplosionLauncher->mParentRace->mLevelTerrain->GetMapEntry(current_cell_calc_x, current_cell_calc_y);
-
-                        //is there actually an entry?
-                        if (mEntry != nullptr) {
-                             terrainHeight = mParentExplosionLauncher->mParentRace->mLevelTerrain->pTerrainTiles[mEntry->get_X()][mEntry->get_Z()].currTileHeight;
-
-                             //sprite to close to terrain, if so stop the sprite to continue further
-                             if (((*it)->currSpritePos[idx].Y - terrainHeight) < 0.3f) {
-                                 //to close to terrain, hide sprite
-                                 (*it2)->setVisible(false);
-                             }
-                        } else {
-                            //we did not find a valid entry, end sprite here
-                            (*it2)->setVisible(false);
-                        }
-                    }
-
-                    //lifetime left for current sprite?
-                    (*it)->remainingLifeTime[idx] -= DeltaTime;
-
-                    if ((*it)->remainingLifeTime[idx] < 0.0f) {
-                        //lifetime over, hide sprite
-                        (*it2)->setVisible(false);
-                    } else {
-                        spriteRemaining = true;
-                    }
-
-                    idx++;
-                }
+                (*it)->lastSpriteRemainingLifeTime -= DeltaTime;
 
                 //time to add next sprite to flying debris?
                 (*it)->timerAddNextSprite -= DeltaTime;
@@ -363,47 +267,19 @@ void Explosion::UpdateDebris(irr::f32 DeltaTime) {
                     (*it)->timerAddNextSprite = (timer / (*it)->mVelocity.getLength());
 
                     //can add another sprite, or already enough?
-                    if ((*it)->mSceneNodeDebrisSprite.size() < DEF_EXPLOSION_NRDEBRISSPRITES) {
-
-                        irr::core::dimension2d<irr::f32> newSpriteSize;
-
-                        //also randomize the size slightly
-                        //rNum = rand();
-                        //rNumFloat4 = 0.5f + (float(rNum) / float (RAND_MAX))  * 1.0f;
-
-                        newSpriteSize.set(rNumFloat4, rNumFloat4);
-
-                        //add another sprite to this flying debris, at the stored location where before the last position
-                        //update the last sprite was located at
-                        AddNewSpriteToDebris(*(*it), (*it)->spawnPoint, (*it)->mVelocity, newSpriteSize, lifeTime);
-
-                        //make the new sprite visible
-                        (*it)->mSceneNodeDebrisSprite.at((*it)->mSceneNodeDebrisSprite.size() - 1)->setVisible(true);
-
-                        spriteRemaining = true;
+                    if ((*it)->nrSpritesEmitted < DEF_EXPLOSION_NRDEBRISSPRITES) {
+                        //add another sprite to this flying debris, at the spawn point
+                        AddNewSpriteToDebris(*(*it), DEF_EXPLOSION_DEBRIS_SPRITESIZE, lifeTime);
                     }
                 }
 
-                //all sprites inactive, can we remove this explosion debris?
-                if (!spriteRemaining) {
+                //all sprites gone, can we remove this explosion debris?
+                if (((*it)->nrSpritesEmitted >= DEF_EXPLOSION_NRDEBRISSPRITES) && ((*it)->lastSpriteRemainingLifeTime < 0.0f)) {
                     //set detonated, during the next update all of this debris
                     //will be removed
                     (*it)->detonated = true;
                 }
-
-               /* if ((*it)->animator->hasFinished()) {
-                    (*it)->animator->drop();
-                    (*it)->currDetonating = false;
-                    (*it)->detonated = true;
-                    (*it)->mSceneNodeDetonation->setVisible(false);
-                }*/
             }
-        } else {
-            //shooting debris happend already, we are done, cleanup up flying debris again
-
         }
     }
-
 }
-
-
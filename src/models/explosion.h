@@ -51,25 +51,22 @@ struct ExplosionDetonationStruct {
 
 //struct for keeping all the data for a single non-animated
 //flying explosion debris, each flying debris consists of multiple
-//Scenenode sprites following each other on a certain path ejected
-//away from the explosion
+//sprites following each other on a certain path ejected
+//away from the explosion; The sprites itself are particles inside the
+//debris particle pool of the explosion launcher
 struct ExplosionFlyingDebrisStruct {
-    std::vector<irr::scene::IBillboardSceneNode*> mSceneNodeDebrisSprite;
-    std::vector<irr::core::vector3d<irr::f32>> currSpritePos;
-
-    std::vector<irr::core::dimension2d<irr::f32>> mCurrSpriteSize;
-    std::vector<irr::core::vector3df> currVelocity;
-    std::vector<irr::f32> remainingLifeTime;
-
     irr::core::vector3df spawnPoint;
 
     irr::core::vector3df mVelocity;
 
-    bool mHitTerrainAgain = false;
-
     irr::f32 detonationDelay;
 
-    unsigned int currTexNrFlyingDebris = 0;
+    //number of sprites already added to this debris
+    irr::u32 nrSpritesEmitted = 0;
+
+    //remaining lifetime of the last added sprite, if
+    //this one is gone the whole debris is done
+    irr::f32 lastSpriteRemainingLifeTime = 0.0f;
 
     irr::f32 timerAddNextSprite;
 
@@ -103,8 +100,7 @@ class Explosion {
             bool exploding = false;
 
             //adds a new sprite to a debris that is currently flying
-            void AddNewSpriteToDebris(ExplosionFlyingDebrisStruct &debrisPntr, irr::core::vector3df newLocation, irr::core::vector3df currVel,
-                                      irr::core::dimension2d<irr::f32> newSpriteSize, irr::f32 lifeTime);
+            void AddNewSpriteToDebris(ExplosionFlyingDebrisStruct &debrisPntr, irr::f32 newSpriteSize, irr::f32 lifeTime);
 
         public:
             Explosion(irr::core::vector3df targetLoc, ExplosionLauncher* parentExpLauncher);
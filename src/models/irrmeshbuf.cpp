@@ -11,6 +11,7 @@
 #include "levelterrain.h"
 #include "../resources/texture.h"
 #include "column.h"
+#include "levelmesh.h"
 
 IrrMeshBuf::IrrMeshBuf(TextureLoader* texSource, bool enableLighning) {
     mTexSource = texSource;
@@ -70,7 +71,7 @@ MeshBufferInfoStruct* IrrMeshBuf::AddAdditionalMeshBuffer(std::vector<MeshBuffer
     SMeshBuffer* newBuf = new SMeshBuffer();
 
     //set texture/material for each SMeshBuffer
-    newBuf->getMaterial().setTexture(0, this->mTexSource->levelTex[forTextureId]);
+    newBuf->getMaterial().setTexture(0, this->mTexSource->GetLevelTexture(forTextureId));
     newBuf->getMaterial().Lighting = mEnableLightning;
     newBuf->getMaterial().Wireframe = false;
 
@@ -606,3 +607,46 @@ void IrrMeshBuf::RemoveMeshBufferCubeFace(std::vector<MeshBufferInfoStruct*> &ta
      }
  }
 
+void IrrMeshBuf::AddLevelMesh(std::vector<MeshBufferInfoStruct*> &targetMeshBufVec, LevelMesh* levelMesh,
+                              std::vector<irr::scene::SMeshBuffer*> &outMeshBufVec, MeshObjectStatsStruct &statpntr) {
+    outMeshBufVec.clear();
+
+    std::vector<LevelMeshBufferStruct*>::iterator it;
+
+    for (it = levelMesh->mBufferVec.begin(); it != levelMesh->mBufferVec.end(); ++it) {
+        //the level mesh creates the meshbuffers for each textureId in the
+        //same order as AddMeshBufferTile and AddMeshBufferCubeFace do, so that
+        //the linked list of each textureId ends up in the same order
+        MeshBufferInfoStruct* newBufInfo = AddAdditionalMeshBuffer(targetMeshBufVec, (*it)->textureId);
+
+        //something wrong?
+        if (newBufInfo == nullptr) {
+            outMeshBufVec.push_back(nullptr);
+            continue;
+        }
+
+        irr::u32 nrVertices = (irr::u32)((*it)->vertices.size());
+        irr::u32 nrIndices = (irr::u32)((*it)->indices.size());
+
+        newBufInfo->meshBuf->Vertices.reallocate(nrVertices);
+        newBufInfo->meshBuf->Indices.reallocate(nrIndices);
+
+        for (irr::u32 idx = 0; idx < nrVertices; idx++) {
+            newBufInfo->meshBuf->Vertices.push_back((*it)->vertices[idx]);
+        }
+
+        for (irr::u32 idx = 0; idx < nrIndices; idx++) {
+            newBufInfo->meshBuf->Indices.push_back((*it)->indices[idx]);
+        }
+
+        newBufInfo->remainingIndices = (irr::u16)(65535 - nrIndices);
+
+        outMeshBufVec.push_back(newBufInfo->meshBuf);
+
+        //increase statistical values
+        statpntr.numUVs += nrVertices;
+        statpntr.numVertices += nrVertices;
+        statpntr.numNormals += nrVertices;
+        statpntr.numIndices += nrIndices;
+    }
+}
@@ -51,6 +51,7 @@ struct TerrainTileData;
 class TextureLoader;
 struct BlockFaceInfoStruct;
 struct BlockInfoStruct;
+class LevelMesh;
 
 class IrrMeshBuf {
 public:
@@ -79,6 +80,12 @@ public:
     void AddMeshBufferBlock(std::vector<MeshBufferInfoStruct*> &targetMeshBufVec, BlockInfoStruct* blockInfo, MeshObjectStatsStruct &statpntr);
     void RemoveMeshBufferCubeFace(std::vector<MeshBufferInfoStruct*> &targetMeshBufVec, BlockFaceInfoStruct* blockFaceInfo, MeshObjectStatsStruct &statpntr);
 
+    //adds one additional Meshbuffer for each meshbuffer of the level mesh, and copies
+    //the vertices and indices into it; outMeshBufVec returns the new Meshbuffers
+    //in the same order as they are stored in levelMesh->mBufferVec
+    void AddLevelMesh(std::vector<MeshBufferInfoStruct*> &targetMeshBufVec, LevelMesh* levelMesh,
+                      std::vector<irr::scene::SMeshBuffer*> &outMeshBufVec, MeshObjectStatsStruct &statpntr);
+
     void ResetMeshStats(MeshObjectStatsStruct* statPntr);
 
     int GetNrTextures();
@@ -19,6 +19,8 @@
 #include "../draw/drawdebug.h"
 #include "../resources/blockdefinition.h"
 #include "irrmeshbuf.h"
+#include "levelmesh.h"
+#include "../resources/levelcache.h"
 #include "../models/levelterrain.h"
 #include "../editorsession.h"
 #include "../editor.h"
@@ -35,6 +37,18 @@ LevelBlocks::~LevelBlocks() {
       BlockWithoutCollisionSceneNode = nullptr;
   }
 
+  //CPU side block meshes that were not transfered into the Irrlicht
+  //meshes yet, in case the initialization was not finished
+  if (mwCollLevelMesh != nullptr) {
+    delete mwCollLevelMesh;
+    mwCollLevelMesh = nullptr;
+  }
+
+  if (mwoCollLevelMesh != nullptr) {
+    delete mwoCollLevelMesh;
+    mwoCollLevelMesh = nullptr;
+  }
+
   //free existing meshes
   if (blockMeshForCollision != nullptr) {
     mInfra->mSmgr->getMeshCache()->removeMesh(blockMeshForCollision);
@@ -87,8 +101,11 @@ LevelBlocks::~LevelBlocks() {
 }
 
 LevelBlocks::LevelBlocks(InfrastructureBase* infra, LevelTerrain* myTerrain, LevelFile* levelRes,
-                         TextureLoader* textureSource, bool levelEditorMode, bool debugShowWallCollisionMesh, bool enableLightning, bool enableBlockPreview) {
+                         TextureLoader* textureSource, bool levelEditorMode, bool debugShowWallCollisionMesh, bool enableLightning, bool enableBlockPreview,
+                         LevelCache* levelCache, std::atomic<irr::u32>* progress) {
    MyTerrain = myTerrain;
+   mLevelCache = levelCache;
+   mDebugShowWallCollisionMesh = debugShowWallCollisionMesh;
    mInfra = infra;
    mEnableLightning = enableLightning;
    mLevelEditorMode = levelEditorMode;
@@ -117,6 +134,9 @@ LevelBlocks::LevelBlocks(InfrastructureBase* infra, LevelTerrain* myTerrain, Lev
    //create all buildings (column objects) out of the raw low level level data
    for(std::vector<ColumnsStruct>::iterator loopi = levelRes->Columns.begin(); loopi != levelRes->Columns.end(); ++loopi) {
        AddColumn((*loopi).Columns, (*loopi).Vector3, levelRes);
+
+       if (progress != nullptr)
+           (*progress)++;
    }
 
    segmentSize = DEF_SEGMENTSIZE;
@@ -125,6 +145,15 @@ LevelBlocks::LevelBlocks(InfrastructureBase* infra, LevelTerrain* myTerrain, Lev
    //blockdefinition objects
    UpdateBlockDefinitionUsageCnt();
 
+   //prepare the vertices of the block meshes, this does not need the
+   //Irrlicht device yet; the meshes itself are created in FinishBlocksInitialization
+   PrepareBlocksMesh();
+
+   //default illumination is enabled
+   mIlluminationEnabled = true;
+}
+
+void LevelBlocks::FinishBlocksInitialization() {
    //generate Mesh with blocks
    //creates 2 meshes inside, one with collision detection
    //and one without (contains roof blocks (for example of tunnels) where player craft easily could get stuck
@@ -147,7 +176,7 @@ LevelBlocks::LevelBlocks(InfrastructureBase* infra, LevelTerrain* myTerrain, Lev
 
    SetViewMode(LEVELBLOCKS_VIEW_DEFAULT);
 
-   if (debugShowWallCollisionMesh) {
+   if (mDebugShowWallCollisionMesh) {
       BlockCollisionSceneNode->setDebugDataVisible(EDS_BBOX);
    }
 
@@ -202,9 +231,6 @@ LevelBlocks::LevelBlocks(InfrastructureBase* infra, LevelTerrain* myTerrain, Lev
    }
 
    //DebugWriteBlockDefinitionTableToCsvFile((char*)("DbgBlockDefinition.csv"));
-
-   //default illumination is enabled
-   mIlluminationEnabled = true;
 }
 
 void LevelBlocks::AddColumn(ColumnDefinition* definition, vector3d<irr::f32> pos, LevelFile *levelRes) {
@@ -282,34 +308,175 @@ std::vector<Column*> LevelBlocks::ColumnsInRange(int sx, int sz, float w, float
     return columns;
 }
 
-void LevelBlocks::CreateBlocksMesh() {
+void LevelBlocks::AddBlockFacesToVec(BlockInfoStruct* blockInfo, std::vector<BlockFaceInfoStruct*> &faceVec) {
+    //same order of faces as in IrrMeshBuf::AddMeshBufferBlock
+    BlockFaceInfoStruct* faces[6] = {blockInfo->fN, blockInfo->fE, blockInfo->fS, blockInfo->fW, blockInfo->fT, blockInfo->fB};
+
+    int nrTextures = mIrrMeshBuf->GetNrTextures();
+
+    for (int idx = 0; idx < 6; idx++) {
+        //faces with an invalid textureId
+        //can not be drawn
+        if ((faces[idx]->textureId < 0) || (faces[idx]->textureId >= nrTextures))
+            continue;
+
+        faceVec.push_back(faces[idx]);
+    }
+}
+
+void LevelBlocks::AddLevelMeshToFaces(std::vector<MeshBufferInfoStruct*> &targetMeshBufVec, LevelMesh* levelMesh,
+                                      std::vector<BlockFaceInfoStruct*> &faceVec) {
+    std::vector<irr::scene::SMeshBuffer*> meshBufVec;
+
+    mIrrMeshBuf->AddLevelMesh(targetMeshBufVec, levelMesh, meshBufVec, *mBlocksMeshStats);
+
+    //we need to know for each block face in which meshbuffer
+    //its vertices are, for morphing later
+    for (size_t idx = 0; idx < faceVec.size(); idx++) {
+        LevelMeshQuadStruct& quad = levelMesh->mQuadVec[idx];
+
+        if (meshBufVec[quad.bufferIdx] == nullptr)
+            continue;
+
+        faceVec[idx]->myMeshBufVertexId.push_back(quad.firstVertexIdx);
+        faceVec[idx]->myMeshBuffers.push_back(meshBufVec[quad.bufferIdx]);
+    }
+}
+
+//Layout of the block mesh cache section:
+//  uint32 number of columns
+//  level mesh of the blocks with collision, level mesh of the blocks
+//  without collision, see LevelMesh::AppendToCacheData
+bool LevelBlocks::ReadBlockMeshesFromCache(std::vector<LevelMesh*> &levelMeshVec, std::vector<std::vector<BlockFaceInfoStruct*>*> &faceVecVec) {
+    if (mLevelCache == nullptr)
+        return false;
+
+    std::vector<uint8_t> data;
+
+    if (!mLevelCache->GetSection(LEVELCACHE_SECTION_BLOCKMESH, data))
+        return false;
+
+    size_t readIdx = 0;
+
+    if (data.size() < sizeof(uint32_t))
+        return false;
+
+    if (LevelCache::ReadUInt32(data, readIdx) != (uint32_t)(ColumnsByPosition.size()))
+        return false;
+
+    for (size_t meshIdx = 0; meshIdx < levelMeshVec.size(); meshIdx++) {
+        LevelMesh* levelMesh = levelMeshVec[meshIdx];
+        std::vector<BlockFaceInfoStruct*>* faceVec = faceVecVec[meshIdx];
+
+        if (!levelMesh->ReadFromCacheData(data, readIdx))
+            return false;
+
+        //the cached mesh must contain exactly our block
+        //faces, each one with its current texture
+        if (levelMesh->mQuadVec.size() != faceVec->size())
+            return false;
+
+        for (size_t idx = 0; idx < faceVec->size(); idx++) {
+            if (levelMesh->mBufferVec[levelMesh->mQuadVec[idx].bufferIdx]->textureId != (*faceVec)[idx]->textureId)
+                return false;
+        }
+    }
+
+    return (readIdx == data.size());
+}
+
+void LevelBlocks::WriteBlockMeshesToCache(std::vector<LevelMesh*> &levelMeshVec) {
+    if (mLevelCache == nullptr)
+        return;
+
+    std::vector<uint8_t> data;
+
+    LevelCache::AppendUInt32(data, (uint32_t)(ColumnsByPosition.size()));
+
+    std::vector<LevelMesh*>::iterator it;
+
+    for (it = levelMeshVec.begin(); it != levelMeshVec.end(); ++it) {
+        (*it)->AppendToCacheData(data);
+    }
+
+    mLevelCache->SetSection(LEVELCACHE_SECTION_BLOCKMESH, data);
+}
+
+void LevelBlocks::PrepareBlocksMesh() {
     //create all buildings (column objects)
     std::vector<ColumnsByPositionStruct>::iterator loopi;
     ColumnsByPositionStruct GetColumn;
-    std::vector<irr::u32> indiceOffset;
-    irr::u8 cubeCnt;
-
-    //first create the building Mesh with
-    //collision active
-    blockMeshForCollision = new SMesh();
-    blockMeshForCollision->setHardwareMappingHint(EHM_DYNAMIC, EBT_VERTEX);
 
     std::vector<BlockInfoStruct*>::iterator it;
 
+    mFacewCollVec.clear();
+    mFacewoCollVec.clear();
+
     for(loopi = ColumnsByPosition.begin(); loopi != ColumnsByPosition.end(); ++loopi) {
         GetColumn = (*loopi);
-        cubeCnt = (irr::u8)(GetColumn.pColumn->mBlockInfoVec.size());
 
         for (it = GetColumn.pColumn->mBlockInfoVec.begin(); it != GetColumn.pColumn->mBlockInfoVec.end(); ++it) {
             //if collisionSelector = 1 then mesh contains all blocks
             //that are needed for collision detection
             if (GetColumn.pColumn->Definition->mInCollisionMesh[(*it)->idxBlockFromBaseCnt] == 1) {
                 //we want collision detection for this block
-                mIrrMeshBuf->AddMeshBufferBlock(mBlockwCollMeshBufferVec, (*it), *mBlocksMeshStats);
+                AddBlockFacesToVec((*it), mFacewCollVec);
+            } else if (GetColumn.pColumn->Definition->mInCollisionMesh[(*it)->idxBlockFromBaseCnt] == 0) {
+                //if collisionSelector = 0 then mesh contains all blocks
+                //that should not be included in collision detection
+                AddBlockFacesToVec((*it), mFacewoCollVec);
             }
         }
     }
 
+    int nrTextures = mIrrMeshBuf->GetNrTextures();
+
+    mwCollLevelMesh = new LevelMesh(nrTextures);
+    mwoCollLevelMesh = new LevelMesh(nrTextures);
+
+    std::vector<LevelMesh*> levelMeshVec = {mwCollLevelMesh, mwoCollLevelMesh};
+    std::vector<std::vector<BlockFaceInfoStruct*>*> faceVecVec = {&mFacewCollVec, &mFacewoCollVec};
+
+    std::vector<BlockFaceInfoStruct*>::iterator itFace;
+
+    if (ReadBlockMeshesFromCache(levelMeshVec, faceVecVec)) {
+        //the vertex colors are not taken from the cache, they depend
+        //on the current illumination setting of the terrain
+        for (size_t meshIdx = 0; meshIdx < levelMeshVec.size(); meshIdx++) {
+            for (size_t idx = 0; idx < faceVecVec[meshIdx]->size(); idx++) {
+                BlockFaceInfoStruct* face = (*faceVecVec[meshIdx])[idx];
+                LevelMeshQuadStruct& quad = levelMeshVec[meshIdx]->mQuadVec[idx];
+                irr::video::S3DVertex* quadVertices = &levelMeshVec[meshIdx]->mBufferVec[quad.bufferIdx]->vertices[quad.firstVertexIdx];
+
+                quadVertices[0].Color = face->vert1->Color;
+                quadVertices[1].Color = face->vert2->Color;
+                quadVertices[2].Color = face->vert3->Color;
+                quadVertices[3].Color = face->vert4->Color;
+            }
+        }
+    } else {
+        for (itFace = mFacewCollVec.begin(); itFace != mFacewCollVec.end(); ++itFace) {
+            mwCollLevelMesh->AddQuad((*itFace)->textureId, *(*itFace)->vert1, *(*itFace)->vert2, *(*itFace)->vert3, *(*itFace)->vert4);
+        }
+
+        for (itFace = mFacewoCollVec.begin(); itFace != mFacewoCollVec.end(); ++itFace) {
+            mwoCollLevelMesh->AddQuad((*itFace)->textureId, *(*itFace)->vert1, *(*itFace)->vert2, *(*itFace)->vert3, *(*itFace)->vert4);
+        }
+
+        WriteBlockMeshesToCache(levelMeshVec);
+    }
+}
+
+void LevelBlocks::CreateBlocksMesh() {
+    int nrTextures = mIrrMeshBuf->GetNrTextures();
+
+    //first create the building Mesh with
+    //collision active
+    blockMeshForCollision = new SMesh();
+    blockMeshForCollision->setHardwareMappingHint(EHM_DYNAMIC, EBT_VERTEX);
+
+    AddLevelMeshToFaces(mBlockwCollMeshBufferVec, mwCollLevelMesh, mFacewCollVec);
+
     //get number of already existing Meshbuffers for all available Texture Ids of cubes with collision detection
     std::vector<irr::u8> nrMeshBuffersPerTexId = mIrrMeshBuf->ReturnMeshBufferCntPerTextureId(mBlockwCollMeshBufferVec);
 
@@ -335,8 +502,6 @@ void LevelBlocks::CreateBlocksMesh() {
     std::vector<irr::scene::SMeshBuffer*> bufList;
     std::vector<irr::scene::SMeshBuffer*>::iterator bufIt;
 
-    int nrTextures = mIrrMeshBuf->GetNrTextures();
-
     for (int currTexId = 0; currTexId < nrTextures; currTexId++) {
 
         bufList = mIrrMeshBuf->ReturnAllMeshBuffersForTextureId(mBlockwCollMeshBufferVec, currTexId);
@@ -351,24 +516,19 @@ void LevelBlocks::CreateBlocksMesh() {
         }
    }
 
-    //first create the building Mesh with
+    //now create the building Mesh with
     //collision not active (unwanted)
     blockMeshWithoutCollision = new SMesh();
     blockMeshWithoutCollision->setHardwareMappingHint(EHM_DYNAMIC, EBT_VERTEX);
 
-    for(loopi = ColumnsByPosition.begin(); loopi != ColumnsByPosition.end(); ++loopi) {
-        GetColumn = (*loopi);
-        cubeCnt = (irr::u8)(GetColumn.pColumn->mBlockInfoVec.size());
+    AddLevelMeshToFaces(mBlockwoCollMeshBufferVec, mwoCollLevelMesh, mFacewoCollVec);
 
-        for (it = GetColumn.pColumn->mBlockInfoVec.begin(); it != GetColumn.pColumn->mBlockInfoVec.end(); ++it) {
-            //if collisionSelector = 0 then mesh contains all blocks
-            //that should not be included in collision detection
-            if (GetColumn.pColumn->Definition->mInCollisionMesh[(*it)->idxBlockFromBaseCnt] == 0) {
-                //we do not want collision detection for this block
-                mIrrMeshBuf->AddMeshBufferBlock(mBlockwoCollMeshBufferVec, (*it), *mBlocksMeshStats);
-            }
-        }
-    }
+    //the CPU side copy is not needed anymore
+    delete mwCollLevelMesh;
+    delete mwoCollLevelMesh;
+
+    mwCollLevelMesh = nullptr;
+    mwoCollLevelMesh = nullptr;
 
     //get number of already existing Meshbuffers for all available Texture Ids of cubes without collision detection
     nrMeshBuffersPerTexId = mIrrMeshBuf->ReturnMeshBufferCntPerTextureId(mBlockwoCollMeshBufferVec);
@@ -1157,9 +1317,6 @@ void LevelBlocks::RemoveColumn(Column* selColumnPntr) {
     selColumnPntr->Definition = nullptr;
     entry->set_Column(nullptr);
 
-    //update the cells internal data
-    entry->WriteChanges();
-
     std::vector<ColumnDefinition*>::iterator itColumnDef;
 
     for (itColumnDef = this->levelRes->ColumnDefinitions.begin(); itColumnDef != this->levelRes->ColumnDefinitions.end(); ++itColumnDef) {
@@ -1227,9 +1384,6 @@ void LevelBlocks::AddColumnAtCell(int x, int y, ColumnDefinition* newColumDef) {
     //add the new specified column at this location
     entry->set_Column(newColumDef);
 
-    //update the cells internal data
-    entry->WriteChanges();
-
     irr::core::vector3d<float> columPos;
     columPos.set((irr::f32)(x), 0.0f, (irr::f32)(y));
 
@@ -1558,7 +1712,6 @@ void LevelBlocks::SetCubeFaceTexture(Column* selColumnPntr, int nrBlockFromBase,
         return;
 
     entry->set_Column(this->levelRes->ColumnDefinitions.at(outColumnIndex));
-    entry->WriteChanges();
 
     //we need to update specific additional column definitions values
     UpdateColumDefinitions();
@@ -1912,7 +2065,6 @@ void LevelBlocks::RemoveBlock(Column* selColumnPntr, int nrBlockFromBase) {
         return;
 
     entry->set_Column(this->levelRes->ColumnDefinitions.at(outColumnIndex));
-    entry->WriteChanges();
 
     //we need to update specific additional column definitions values
     UpdateColumDefinitions();
@@ -2100,7 +2252,6 @@ void LevelBlocks::AddBlock(Column* selColumnPntr, int nrBlockFromBase, BlockDefi
         return;
 
     entry->set_Column(this->levelRes->ColumnDefinitions.at(outColumnIndex));
-    entry->WriteChanges();
 
     //we need to update specific additional column definitions values
     UpdateColumDefinitions();
@@ -2225,7 +2376,6 @@ void LevelBlocks::SetColumnFloorTextureId(Column* selColumnPntr, bool updateTexI
         return;
 
     entry->set_Column(this->levelRes->ColumnDefinitions.at(outColumnIndex));
-    entry->WriteChanges();
 
     //we need to update specific additional column definitions values
     UpdateColumDefinitions();
@@ -2842,12 +2992,10 @@ void LevelBlocks::ReplaceColumnDefinitionWithNewOneForAllColumns(std::vector<irr
 
                   logging::Info(infoMsg);
 
+                  //the new Id for this column definition is converted
+                  //into the cid value when the level file is saved
                   entry->set_Column(newDef);
 
-                  //update entry data, which will convert the new Id for this colum definition
-                  //into the correct cid value inside this MapEntry
-                  entry->WriteChanges();
-
                   colMod = true;
               }
          }
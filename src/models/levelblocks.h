@@ -14,6 +14,7 @@
 #include <vector>
 #include <cstdint>
 #include <string>
+#include <atomic>
 
 using namespace irr;
 using namespace video;
@@ -57,6 +58,8 @@ struct MeshBufferInfoStruct;
 struct BlockFaceInfoStruct;
 struct BlockInfoStruct;
 struct ColorStruct;
+class LevelCache;
+class LevelMesh;
 
 struct ColumnsByPositionStruct {
       int pos;
@@ -66,9 +69,16 @@ struct ColumnsByPositionStruct {
 class LevelBlocks {
 public:
     LevelBlocks(InfrastructureBase* infra, LevelTerrain* myTerrain, LevelFile* levelRes,
-                TextureLoader* textureSource, bool levelEditorMode, bool debugShowWallCollisionMesh, bool enableLightning, bool enableBlockPreview);
+                TextureLoader* textureSource, bool levelEditorMode, bool debugShowWallCollisionMesh, bool enableLightning, bool enableBlockPreview,
+                LevelCache* levelCache, std::atomic<irr::u32>* progress = nullptr);
     ~LevelBlocks();
 
+    //The constructor only creates the columns and the vertices of the block meshes, and does
+    //not use the Irrlicht device, so that it can run on a thread pool worker; progress (if set)
+    //is incremented once for each column of the level file. FinishBlocksInitialization
+    //creates the Irrlicht meshes and scene nodes afterwards, and must run on the main thread
+    void FinishBlocksInitialization();
+
     void CreateBlocksMesh();
     std::vector<Column*> ColumnsInRange(int sx, int sz, float w, float h);
 
@@ -201,6 +211,39 @@ private:
     TextureLoader* mTexSource = nullptr;
     LevelTerrain* MyTerrain = nullptr;
 
+    //if not nullptr the block meshbuffers are restored from the
+    //level cache if possible, or are stored in it after they were created
+    LevelCache* mLevelCache = nullptr;
+
+    //creates the vertices of the block meshes (without the Irrlicht
+    //device), restores them from the level cache if possible
+    void PrepareBlocksMesh();
+
+    //the prepared block meshes, only valid between the constructor and
+    //FinishBlocksInitialization; the face vectors contain the block faces
+    //in the same order as the quads of the level meshes
+    LevelMesh* mwCollLevelMesh = nullptr;
+    LevelMesh* mwoCollLevelMesh = nullptr;
+
+    std::vector<BlockFaceInfoStruct*> mFacewCollVec;
+    std::vector<BlockFaceInfoStruct*> mFacewoCollVec;
+
+    bool mDebugShowWallCollisionMesh = false;
+
+    //adds the faces of a block to faceVec, skips faces
+    //with an invalid textureId
+    void AddBlockFacesToVec(BlockInfoStruct* blockInfo, std::vector<BlockFaceInfoStruct*> &faceVec);
+
+    //creates the Irrlicht meshbuffers for the level mesh, and stores in each block face
+    //where its vertices are located
+    void AddLevelMeshToFaces(std::vector<MeshBufferInfoStruct*> &targetMeshBufVec, LevelMesh* levelMesh,
+                             std::vector<BlockFaceInfoStruct*> &faceVec);
+
+    //reads the level meshes from the level cache, returns false if the
+    //cache has no block mesh or it does not match the specified block faces
+    bool ReadBlockMeshesFromCache(std::vector<LevelMesh*> &levelMeshVec, std::vector<std::vector<BlockFaceInfoStruct*>*> &faceVecVec);
+    void WriteBlockMeshesToCache(std::vector<LevelMesh*> &levelMeshVec);
+
     InfrastructureBase* mInfra = nullptr;
 
     bool mIlluminationEnabled;
@@ -0,0 +1,248 @@
+/*
+ Copyright (C) 2026 Wolf Alexander
+
+ This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.                                          */
+
+#include "levelmesh.h"
+#include "../resources/levelcache.h"
+
+//bytes per vertex in the level cache: position, normal,
+//texture coordinates (8 floats) and the color
+#define LEVELMESH_CACHEDVERTEXSIZE (9 * sizeof(uint32_t))
+
+LevelMesh::LevelMesh(int nrTextures) {
+    mNrTextures = nrTextures;
+
+    mCurrentBufferIdx.assign(nrTextures, -1);
+}
+
+LevelMesh::~LevelMesh() {
+    CleanUp();
+}
+
+void LevelMesh::CleanUp() {
+    std::vector<LevelMeshBufferStruct*>::iterator it;
+
+    for (it = mBufferVec.begin(); it != mBufferVec.end(); ++it) {
+        delete (*it);
+    }
+
+    mBufferVec.clear();
+    mQuadVec.clear();
+
+    mCurrentBufferIdx.assign(mNrTextures, -1);
+}
+
+bool LevelMesh::IsValidTextureId(int16_t textureId) {
+    return ((textureId >= 0) && (textureId < mNrTextures));
+}
+
+bool LevelMesh::AddQuad(int16_t textureId, const irr::video::S3DVertex& vert1, const irr::video::S3DVertex& vert2,
+                        const irr::video::S3DVertex& vert3, const irr::video::S3DVertex& vert4) {
+    if (!IsValidTextureId(textureId))
+        return false;
+
+    irr::s32 bufferIdx = mCurrentBufferIdx[textureId];
+
+    //is there no meshbuffer for this textureId yet, or has the current one no
+    //space for 6 additional indices anymore? then start a new meshbuffer
+    if ((bufferIdx < 0) || (mBufferVec[bufferIdx]->indices.size() + 6 > LEVELMESH_MAXINDICES)) {
+        LevelMeshBufferStruct* newBuffer = new LevelMeshBufferStruct();
+        newBuffer->textureId = textureId;
+
+        mBufferVec.push_back(newBuffer);
+
+        bufferIdx = (irr::s32)(mBufferVec.size() - 1);
+        mCurrentBufferIdx[textureId] = bufferIdx;
+    }
+
+    LevelMeshBufferStruct* buffer = mBufferVec[bufferIdx];
+
+    irr::u16 firstIdx = (irr::u16)(buffer->vertices.size());
+
+    buffer->vertices.push_back(vert1);
+    buffer->vertices.push_back(vert2);
+    buffer->vertices.push_back(vert3);
+    buffer->vertices.push_back(vert4);
+
+    //the 2 triangles of the quad, same
+    //as in IrrMeshBuf::AddMeshBufferTile
+    buffer->indices.push_back(firstIdx);
+    buffer->indices.push_back(firstIdx + 1);
+    buffer->indices.push_back(firstIdx + 3);
+
+    buffer->indices.push_back(firstIdx + 1);
+    buffer->indices.push_back(firstIdx + 2);
+    buffer->indices.push_back(firstIdx + 3);
+
+    LevelMeshQuadStruct newQuad;
+    newQuad.bufferIdx = (irr::u32)(bufferIdx);
+    newQuad.firstVertexIdx = firstIdx;
+
+    mQuadVec.push_back(newQuad);
+
+    return true;
+}
+
+void LevelMesh::GetTriangles(std::vector<irr::core::triangle3df> &outTriangles) {
+    std::vector<LevelMeshBufferStruct*>::iterator it;
+
+    //the Irrlicht mesh contains the meshbuffers sorted by textureId
+    for (int textureId = 0; textureId < mNrTextures; textureId++) {
+        for (it = mBufferVec.begin(); it != mBufferVec.end(); ++it) {
+            if ((*it)->textureId != textureId)
+                continue;
+
+            size_t nrIndices = (*it)->indices.size();
+
+            for (size_t idx = 0; idx + 2 < nrIndices; idx += 3) {
+                outTriangles.push_back(irr::core::triangle3df((*it)->vertices[(*it)->indices[idx]].Pos,
+                                                              (*it)->vertices[(*it)->indices[idx + 1]].Pos,
+                                                              (*it)->vertices[(*it)->indices[idx + 2]].Pos));
+            }
+        }
+    }
+}
+
+//Layout of a level mesh inside a cache section:
+//  uint32 number of meshbuffers
+//  for each meshbuffer: uint32 textureId, uint32 number of vertices, uint32 number of indices,
+//                       vertices (position, normal, texture coordinates, color), indices (uint16)
+//  uint32 number of quads
+//  for each quad: uint32 meshbuffer index, uint32 index of the first vertex
+void LevelMesh::AppendToCacheData(std::vector<uint8_t> &data) {
+    std::vector<LevelMeshBufferStruct*>::iterator it;
+
+    LevelCache::AppendUInt32(data, (uint32_t)(mBufferVec.size()));
+
+    for (it = mBufferVec.begin(); it != mBufferVec.end(); ++it) {
+        LevelCache::AppendUInt32(data, (uint32_t)((*it)->textureId));
+        LevelCache::AppendUInt32(data, (uint32_t)((*it)->vertices.size()));
+        LevelCache::AppendUInt32(data, (uint32_t)((*it)->indices.size()));
+
+        data.reserve(data.size() + (*it)->vertices.size() * LEVELMESH_CACHEDVERTEXSIZE +
+                     (*it)->indices.size() * sizeof(uint16_t));
+
+        std::vector<irr::video::S3DVertex>::iterator itVert;
+
+        for (itVert = (*it)->vertices.begin(); itVert != (*it)->vertices.end(); ++itVert) {
+            LevelCache::AppendFloat(data, (*itVert).Pos.X);
+            LevelCache::AppendFloat(data, (*itVert).Pos.Y);
+            LevelCache::AppendFloat(data, (*itVert).Pos.Z);
+            LevelCache::AppendFloat(data, (*itVert).Normal.X);
+            LevelCache::AppendFloat(data, (*itVert).Normal.Y);
+            LevelCache::AppendFloat(data, (*itVert).Normal.Z);
+            LevelCache::AppendFloat(data, (*itVert).TCoords.X);
+            LevelCache::AppendFloat(data, (*itVert).TCoords.Y);
+            LevelCache::AppendUInt32(data, (uint32_t)((*itVert).Color.color));
+        }
+
+        std::vector<irr::u16>::iterator itIdx;
+
+        for (itIdx = (*it)->indices.begin(); itIdx != (*it)->indices.end(); ++itIdx) {
+            LevelCache::AppendUInt16(data, (*itIdx));
+        }
+    }
+
+    LevelCache::AppendUInt32(data, (uint32_t)(mQuadVec.size()));
+
+    std::vector<LevelMeshQuadStruct>::iterator itQuad;
+
+    for (itQuad = mQuadVec.begin(); itQuad != mQuadVec.end(); ++itQuad) {
+        LevelCache::AppendUInt32(data, (*itQuad).bufferIdx);
+        LevelCache::AppendUInt32(data, (*itQuad).firstVertexIdx);
+    }
+}
+
+bool LevelMesh::ReadFromCacheData(const std::vector<uint8_t> &data, size_t &readIdx) {
+    CleanUp();
+
+    if (readIdx + sizeof(uint32_t) > data.size())
+        return false;
+
+    uint32_t nrBuffers = LevelCache::ReadUInt32(data, readIdx);
+
+    for (uint32_t bufIdx = 0; bufIdx < nrBuffers; bufIdx++) {
+        if (readIdx + 3 * sizeof(uint32_t) > data.size()) {
+            CleanUp();
+            return false;
+        }
+
+        int16_t textureId = (int16_t)(LevelCache::ReadUInt32(data, readIdx));
+        uint32_t nrVertices = LevelCache::ReadUInt32(data, readIdx);
+        uint32_t nrIndices = LevelCache::ReadUInt32(data, readIdx);
+
+        //plausi-check of the header before we allocate
+        //anything, and before we read the arrays
+        if (!IsValidTextureId(textureId) || (nrVertices > LEVELMESH_MAXINDICES + 1) || (nrIndices > LEVELMESH_MAXINDICES) ||
+                (readIdx + (size_t)(nrVertices) * LEVELMESH_CACHEDVERTEXSIZE + (size_t)(nrIndices) * sizeof(uint16_t) > data.size())) {
+            CleanUp();
+            return false;
+        }
+
+        LevelMeshBufferStruct* newBuffer = new LevelMeshBufferStruct();
+        newBuffer->textureId = textureId;
+        newBuffer->vertices.resize(nrVertices);
+        newBuffer->indices.resize(nrIndices);
+
+        mBufferVec.push_back(newBuffer);
+
+        for (uint32_t idx = 0; idx < nrVertices; idx++) {
+            irr::video::S3DVertex& vert = newBuffer->vertices[idx];
+
+            vert.Pos.X = LevelCache::ReadFloat(data, readIdx);
+            vert.Pos.Y = LevelCache::ReadFloat(data, readIdx);
+            vert.Pos.Z = LevelCache::ReadFloat(data, readIdx);
+            vert.Normal.X = LevelCache::ReadFloat(data, readIdx);
+            vert.Normal.Y = LevelCache::ReadFloat(data, readIdx);
+            vert.Normal.Z = LevelCache::ReadFloat(data, readIdx);
+            vert.TCoords.X = LevelCache::ReadFloat(data, readIdx);
+            vert.TCoords.Y = LevelCache::ReadFloat(data, readIdx);
+            vert.Color.color = LevelCache::ReadUInt32(data, readIdx);
+        }
+
+        for (uint32_t idx = 0; idx < nrIndices; idx++) {
+            newBuffer->indices[idx] = LevelCache::ReadUInt16(data, readIdx);
+
+            if (newBuffer->indices[idx] >= nrVertices) {
+                CleanUp();
+                return false;
+            }
+        }
+
+        //next quads for this textureId would go into the
+        //last meshbuffer, like during AddQuad
+        mCurrentBufferIdx[textureId] = (irr::s32)(bufIdx);
+    }
+
+    if (readIdx + sizeof(uint32_t) > data.size()) {
+        CleanUp();
+        return false;
+    }
+
+    uint32_t nrQuads = LevelCache::ReadUInt32(data, readIdx);
+
+    if (readIdx + (size_t)(nrQuads) * 2 * sizeof(uint32_t) > data.size()) {
+        CleanUp();
+        return false;
+    }
+
+    mQuadVec.resize(nrQuads);
+
+    for (uint32_t idx = 0; idx < nrQuads; idx++) {
+        mQuadVec[idx].bufferIdx = LevelCache::ReadUInt32(data, readIdx);
+        mQuadVec[idx].firstVertexIdx = LevelCache::ReadUInt32(data, readIdx);
+
+        if ((mQuadVec[idx].bufferIdx >= nrBuffers) ||
+                ((size_t)(mQuadVec[idx].firstVertexIdx) + 4 > mBufferVec[mQuadVec[idx].bufferIdx]->vertices.size())) {
+            CleanUp();
+            return false;
+        }
+    }
+
+    return true;
+}
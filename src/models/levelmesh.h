@@ -0,0 +1,81 @@
+/*
+ Copyright (C) 2026 Wolf Alexander
+
+ This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.                                          */
+
+#ifndef LEVELMESH_H
+#define LEVELMESH_H
+
+#include "irrlicht.h"
+#include <vector>
+#include <cstdint>
+
+//Irrlicht meshbuffers use 16 bit indices
+#define LEVELMESH_MAXINDICES 65535
+
+//vertices and indices of one meshbuffer
+struct LevelMeshBufferStruct {
+    int16_t textureId;
+
+    std::vector<irr::video::S3DVertex> vertices;
+    std::vector<irr::u16> indices;
+};
+
+//where the 4 vertices of a quad (a terrain tile
+//or a block face) are stored in the level mesh
+struct LevelMeshQuadStruct {
+    //index of the meshbuffer in mBufferVec
+    irr::u32 bufferIdx;
+
+    //index of the first of the 4 vertices
+    //inside of this meshbuffer
+    irr::u32 firstVertexIdx;
+};
+
+//The terrain and the blocks are made out of quads, which are sorted into one or more meshbuffers
+//per textureId, with max 65535 indices per meshbuffer. LevelMesh does exactly the same split as
+//IrrMeshBuf::AddMeshBufferTile and IrrMeshBuf::AddMeshBufferCubeFace, but only into plain vectors,
+//so that it does not need the Irrlicht device, and the result can be stored in the level cache.
+//The Irrlicht meshbuffers are created out of it with IrrMeshBuf::AddLevelMesh afterwards
+class LevelMesh {
+public:
+    LevelMesh(int nrTextures);
+    ~LevelMesh();
+
+    //adds a new quad with the 4 specified vertices, returns false
+    //(and does not add the quad) if the textureId is invalid
+    bool AddQuad(int16_t textureId, const irr::video::S3DVertex& vert1, const irr::video::S3DVertex& vert2,
+                 const irr::video::S3DVertex& vert3, const irr::video::S3DVertex& vert4);
+
+    bool IsValidTextureId(int16_t textureId);
+
+    //appends the triangles of all meshbuffers to outTriangles, in the same order
+    //as the Irrlicht mesh created by IrrMeshBuf::AddLevelMesh contains them
+    void GetTriangles(std::vector<irr::core::triangle3df> &outTriangles);
+
+    //serialization for the level cache; ReadFromCacheData returns false if the
+    //data is invalid, the level mesh is empty afterwards in this case
+    void AppendToCacheData(std::vector<uint8_t> &data);
+    bool ReadFromCacheData(const std::vector<uint8_t> &data, size_t &readIdx);
+
+    //all meshbuffers in the order they were created
+    std::vector<LevelMeshBufferStruct*> mBufferVec;
+
+    //all quads in the order they were added
+    std::vector<LevelMeshQuadStruct> mQuadVec;
+
+private:
+    int mNrTextures;
+
+    //index of the meshbuffer in mBufferVec to which the next quad
+    //of each textureId is added, -1 if there is none yet
+    std::vector<irr::s32> mCurrentBufferIdx;
+
+    void CleanUp();
+};
+
+#endif // LEVELMESH_H
@@ -23,11 +23,19 @@
 #include "../resources/entityitem.h"
 #include "../draw/drawdebug.h"
 #include "irrmeshbuf.h"
+#include "terrainregion.h"
+#include "levelmesh.h"
+#include "../resources/levelcache.h"
+#include "../utils/levelanalysis.h"
 
 void LevelTerrain::ResetTerrainTileData() {
     int levelWidth = this->levelRes->Width();
     int levelHeight = this->levelRes->Height();
 
+    //heights and flags are stored separately
+    mTileStore->Reset();
+    mTileStoreEndOfMap->Reset();
+
     for (int i = 0; i < levelWidth; i++) {
         for (int j = 0; j < levelHeight; j++) {
             pTerrainTiles[i][j].vert1 = nullptr;
@@ -39,7 +47,6 @@ void LevelTerrain::ResetTerrainTileData() {
             pTerrainTiles[i][j].vert3UVcoord.set(0.0f, 0.0f);
             pTerrainTiles[i][j].vert4UVcoord.set(0.0f, 0.0f);
             pTerrainTiles[i][j].myMeshBuffers.clear();
-            pTerrainTiles[i][j].currTileHeight = 0.0f;
             if (mOptimizeMesh) {
                 pTerrainTiles[i][j].m_draw_in_mesh = false;
             } else {
@@ -50,17 +57,8 @@ void LevelTerrain::ResetTerrainTileData() {
             pTerrainTiles[i][j].vert3CurrNormal.set(0.0f, 1.0f, 0.0f);
             pTerrainTiles[i][j].vert4CurrNormal.set(0.0f, 1.0f, 0.0f);
             pTerrainTiles[i][j].myMeshBufVertexId1.clear();
-            pTerrainTiles[i][j].vert1CurrPositionY = 0.0f;
-            pTerrainTiles[i][j].vert2CurrPositionY = 0.0f;
-            pTerrainTiles[i][j].vert3CurrPositionY = 0.0f;
-            pTerrainTiles[i][j].vert4CurrPositionY = 0.0f;
             pTerrainTiles[i][j].VertUpdatedUVScoord = false;
-            pTerrainTiles[i][j].RefreshNormals = false;
             pTerrainTiles[i][j].m_optimization_cnt = 0.0f;
-            pTerrainTiles[i][j].vert1CurrPositionYDirty = false;
-            pTerrainTiles[i][j].vert2CurrPositionYDirty = false;
-            pTerrainTiles[i][j].vert3CurrPositionYDirty = false;
-            pTerrainTiles[i][j].vert4CurrPositionYDirty = false;
         }
     }
 
@@ -75,7 +73,6 @@ void LevelTerrain::ResetTerrainTileData() {
             pTerrainTilesEndOfMap[i][j].vert3UVcoord.set(0.0f, 0.0f);
             pTerrainTilesEndOfMap[i][j].vert4UVcoord.set(0.0f, 0.0f);
             pTerrainTilesEndOfMap[i][j].myMeshBuffers.clear();
-            pTerrainTilesEndOfMap[i][j].currTileHeight = 0.0f;
 
             //Always draw this specific tiles!
             pTerrainTilesEndOfMap[i][j].m_draw_in_mesh = true;
@@ -85,17 +82,8 @@ void LevelTerrain::ResetTerrainTileData() {
             pTerrainTilesEndOfMap[i][j].vert3CurrNormal.set(0.0f, 1.0f, 0.0f);
             pTerrainTilesEndOfMap[i][j].vert4CurrNormal.set(0.0f, 1.0f, 0.0f);
             pTerrainTilesEndOfMap[i][j].myMeshBufVertexId1.clear();
-            pTerrainTilesEndOfMap[i][j].vert1CurrPositionY = 0.0f;
-            pTerrainTilesEndOfMap[i][j].vert2CurrPositionY = 0.0f;
-            pTerrainTilesEndOfMap[i][j].vert3CurrPositionY = 0.0f;
-            pTerrainTilesEndOfMap[i][j].vert4CurrPositionY = 0.0f;
             pTerrainTilesEndOfMap[i][j].VertUpdatedUVScoord = false;
-            pTerrainTilesEndOfMap[i][j].RefreshNormals = false;
             pTerrainTilesEndOfMap[i][j].m_optimization_cnt = 0.0f;
-            pTerrainTilesEndOfMap[i][j].vert1CurrPositionYDirty = false;
-            pTerrainTilesEndOfMap[i][j].vert2CurrPositionYDirty = false;
-            pTerrainTilesEndOfMap[i][j].vert3CurrPositionYDirty = false;
-            pTerrainTilesEndOfMap[i][j].vert4CurrPositionYDirty = false;
         }
     }
 }
@@ -329,7 +317,7 @@ void LevelTerrain::CheckPosInsideChargingRegion(int posX, int posY, bool &charge
 //Because we need to know where the morph areas are, to be able to put
 //dynamic parts of the terrain mesh into their own Meshbuffers and SceneNodes
 //for performance improvement reasons
-void LevelTerrain::FinishTerrainInitialization() {
+bool LevelTerrain::PrepareTerrainGeometry(std::atomic<irr::u32>* progress) {
     //for the game we want (need) to optimize the
     //mesh, for the editor we do not want to do this
     if (mOptimizeMesh) {
@@ -337,7 +325,38 @@ void LevelTerrain::FinishTerrainInitialization() {
         FindTerrainOptimization();
     }
 
-    bool successGeometry = SetupGeometry();
+    bool successGeometry = PrepareGeometry(progress);
+
+    if (!mLevelEditorMode) {
+        successGeometry = successGeometry && PrepareGeometryEndOfMap(progress);
+    }
+
+    mGeometryPrepared = true;
+
+    if (!successGeometry) {
+        Terrain_ready = false;
+    }
+
+    return successGeometry;
+}
+
+irr::u32 LevelTerrain::GetNrPrepareSteps() {
+    //one step for each row of tiles, in the game
+    //also for each row of the end of the map
+    if (mLevelEditorMode)
+        return (irr::u32)(levelRes->Height());
+
+    return (irr::u32)(2 * levelRes->Height());
+}
+
+void LevelTerrain::FinishTerrainInitialization() {
+    //in the game the CPU side is already prepared in the
+    //background, in the level editor we do it here
+    if (!mGeometryPrepared) {
+        PrepareTerrainGeometry();
+    }
+
+    bool successGeometry = Terrain_ready && SetupGeometry();
 
     if (!mLevelEditorMode) {
         successGeometry = successGeometry && SetupGeometryEndOfMap();
@@ -437,6 +456,10 @@ LevelTerrain::LevelTerrain(InfrastructureBase* infra, bool levelEditorMode, Leve
 
    mTerrainMeshStats = new MeshObjectStatsStruct();
 
+   //vertex heights and flags of all tiles
+   mTileStore = new TerrainTileStore(LEVELFILE_WIDTH, LEVELFILE_HEIGHT);
+   mTileStoreEndOfMap = new TerrainTileStore(LEVELTERRAIN_WIDTH_ENDOFMAP, LEVELFILE_HEIGHT);
+
    mIrrMeshBuf = new IrrMeshBuf(mTexSource, mEnableLightning);
 
    //initial fill the mStaticMeshBufferVec and
@@ -483,6 +506,23 @@ LevelTerrain::LevelTerrain(InfrastructureBase* infra, bool levelEditorMode, Leve
 }
 
 LevelTerrain::~LevelTerrain() {
+  //CPU side geometry that was not transfered into the Irrlicht
+  //meshes yet, in case the initialization was not finished
+  if (mStaticLevelMesh != nullptr) {
+    delete mStaticLevelMesh;
+    mStaticLevelMesh = nullptr;
+  }
+
+  if (mDynamicLevelMesh != nullptr) {
+    delete mDynamicLevelMesh;
+    mDynamicLevelMesh = nullptr;
+  }
+
+  if (mEndOfMapLevelMesh != nullptr) {
+    delete mEndOfMapLevelMesh;
+    mEndOfMapLevelMesh = nullptr;
+  }
+
   //remove my static SceneNode
   if (StaticTerrainSceneNode != nullptr) {
     StaticTerrainSceneNode->remove();
@@ -627,6 +667,12 @@ LevelTerrain::~LevelTerrain() {
   }
 
   delete mTerrainMeshStats;
+
+  delete mTileStore;
+  mTileStore = nullptr;
+
+  delete mTileStoreEndOfMap;
+  mTileStoreEndOfMap = nullptr;
 }
 
 void LevelTerrain::SetIllumination(bool enabled) {
@@ -670,23 +716,7 @@ bool LevelTerrain::IsIlluminationEnabled() {
 //Returns true if input texture is a roadtexture
 //according to a predefined list
 bool LevelTerrain::IsRoadTexture(irr::s32 texture, bool addExtendedTextures) {
-    for (std::vector<irr::s32>::iterator itTex = roadTexIdsVec.begin(); itTex != roadTexIdsVec.end(); ++itTex) {
-        if ((*itTex) == texture) {
-            //texture found, exit
-            return true;
-        }
-    }
-
-    if (addExtendedTextures) {
-        for (std::vector<irr::s32>::iterator itTex = roadTexIdsVecExtendedForWorldAware.begin(); itTex != roadTexIdsVecExtendedForWorldAware.end(); ++itTex) {
-            if ((*itTex) == texture) {
-                //texture found, exit
-                return true;
-            }
-        }
-    }
-
-    return false;
+    return LevelAnalysis::IsRoadTexture(texture, addExtendedTextures);
 }
 
 bool LevelTerrain::IsChargingStationTexture(irr::s32 texture) {
@@ -991,10 +1021,10 @@ irr::f32 LevelTerrain::GetHeightInterpolated(irr::f32 x, irr::f32 z)
     //int id = 4 * (ix       + zPlusOne * levelRes.Width);
 
     // get heights and proceed...
-    irr::f32 a = this->pTerrainTiles[ix][iz].vert1CurrPositionY;
-    irr::f32 b = this->pTerrainTiles[xPlusOne][iz].vert1CurrPositionY;
-    irr::f32 c = this->pTerrainTiles[xPlusOne][zPlusOne].vert1CurrPositionY;
-    irr::f32 d = this->pTerrainTiles[ix][zPlusOne].vert1CurrPositionY;
+    irr::f32 a = this->mTileStore->GetVertexHeight(ix, iz, 1);
+    irr::f32 b = this->mTileStore->GetVertexHeight(xPlusOne, iz, 1);
+    irr::f32 c = this->mTileStore->GetVertexHeight(xPlusOne, zPlusOne, 1);
+    irr::f32 d = this->mTileStore->GetVertexHeight(ix, zPlusOne, 1);
 
     irr::f32 hheight = 0.0f;
 
@@ -1029,8 +1059,8 @@ irr::f32 LevelTerrain::GetAveragedTileHeight(int x, int z)
     if (x > width - 1) x = width - 1;
     if (z > height - 1) z = height - 1;
 
-    irr::f32 avgHeight = -(this->pTerrainTiles[x][z].vert1CurrPositionY + this->pTerrainTiles[x][z].vert2CurrPositionY +
-            this->pTerrainTiles[x][z].vert3CurrPositionY + this->pTerrainTiles[x][z].vert4CurrPositionY) / 4.0f;
+    irr::f32 avgHeight = -(this->mTileStore->GetVertexHeight(x, z, 1) + this->mTileStore->GetVertexHeight(x, z, 2) +
+            this->mTileStore->GetVertexHeight(x, z, 3) + this->mTileStore->GetVertexHeight(x, z, 4)) / 4.0f;
 
     return avgHeight;
 }
@@ -1224,9 +1254,9 @@ irr::f32 LevelTerrain::GetSteepnessOfNeighboringTile(int x1, int z1, int x2, int
             switch (deltaZ) {
                 case -1: {
                     //corner tile left/upwards has 3 stepnessess
-                    stepness1 = (-this->pTerrainTiles[x2][z2].vert2CurrPositionY + this->pTerrainTiles[x2][z2].vert3CurrPositionY);
-                    stepness2 = (-this->pTerrainTiles[x2][z2].vert1CurrPositionY + this->pTerrainTiles[x2][z2].vert3CurrPositionY);
-                    stepness3 = (-this->pTerrainTiles[x2][z2].vert4CurrPositionY + this->pTerrainTiles[x2][z2].vert3CurrPositionY);       
+                    stepness1 = (-this->mTileStore->GetVertexHeight(x2, z2, 2) + this->mTileStore->GetVertexHeight(x2, z2, 3));
+                    stepness2 = (-this->mTileStore->GetVertexHeight(x2, z2, 1) + this->mTileStore->GetVertexHeight(x2, z2, 3));
+                    stepness3 = (-this->mTileStore->GetVertexHeight(x2, z2, 4) + this->mTileStore->GetVertexHeight(x2, z2, 3));       
 
                     hlp = (v3 - v1) * irr::core::vector3df(0.5f, 1.0f, 0.5f);
                     collPlanePos1 = v4 - hlp;
@@ -1237,8 +1267,8 @@ irr::f32 LevelTerrain::GetSteepnessOfNeighboringTile(int x1, int z1, int x2, int
                  }
                 case 0: {
                     //tile left of first tile, here there are only 2 stepnessess
-                    stepness1 = (-this->pTerrainTiles[x2][z2].vert1CurrPositionY + this->pTerrainTiles[x2][z2].vert2CurrPositionY);
-                    stepness2 = (-this->pTerrainTiles[x2][z2].vert4CurrPositionY + this->pTerrainTiles[x2][z2].vert3CurrPositionY);
+                    stepness1 = (-this->mTileStore->GetVertexHeight(x2, z2, 1) + this->mTileStore->GetVertexHeight(x2, z2, 2));
+                    stepness2 = (-this->mTileStore->GetVertexHeight(x2, z2, 4) + this->mTileStore->GetVertexHeight(x2, z2, 3));
                     collPlanePos1 = v1;
                     collPlanePos2 = v4;
                     hlp = v3 - v4;
@@ -1248,9 +1278,9 @@ irr::f32 LevelTerrain::GetSteepnessOfNeighboringTile(int x1, int z1, int x2, int
                 }
                 case +1: {
                     //corner tile left/downwards has 3 stepnessess
-                    stepness1 = (-this->pTerrainTiles[x2][z2].vert1CurrPositionY + this->pTerrainTiles[x2][z2].vert2CurrPositionY);
-                    stepness2 = (-this->pTerrainTiles[x2][z2].vert4CurrPositionY + this->pTerrainTiles[x2][z2].vert2CurrPositionY);
-                    stepness3 = (-this->pTerrainTiles[x2][z2].vert3CurrPositionY + this->pTerrainTiles[x2][z2].vert2CurrPositionY);
+                    stepness1 = (-this->mTileStore->GetVertexHeight(x2, z2, 1) + this->mTileStore->GetVertexHeight(x2, z2, 2));
+                    stepness2 = (-this->mTileStore->GetVertexHeight(x2, z2, 4) + this->mTileStore->GetVertexHeight(x2, z2, 2));
+                    stepness3 = (-this->mTileStore->GetVertexHeight(x2, z2, 3) + this->mTileStore->GetVertexHeight(x2, z2, 2));
                     hlp = (v2 - v4) * irr::core::vector3df(0.5f, 1.0f, 0.5f);
                     collPlanePos1 = v1 - hlp;
                     collPlanePos2 = v3 - hlp;
@@ -1267,8 +1297,8 @@ irr::f32 LevelTerrain::GetSteepnessOfNeighboringTile(int x1, int z1, int x2, int
             switch (deltaZ) {
                 case -1: {
                     //tile upwards has 2 stepnessess
-                    stepness1 = (-this->pTerrainTiles[x2][z2].vert1CurrPositionY + this->pTerrainTiles[x2][z2].vert4CurrPositionY);
-                    stepness2 = (-this->pTerrainTiles[x2][z2].vert2CurrPositionY + this->pTerrainTiles[x2][z2].vert3CurrPositionY);
+                    stepness1 = (-this->mTileStore->GetVertexHeight(x2, z2, 1) + this->mTileStore->GetVertexHeight(x2, z2, 4));
+                    stepness2 = (-this->mTileStore->GetVertexHeight(x2, z2, 2) + this->mTileStore->GetVertexHeight(x2, z2, 3));
                     collPlanePos1 = v1;
                     collPlanePos2 = v2;
                     hlp = v4 - v1;
@@ -1283,8 +1313,8 @@ irr::f32 LevelTerrain::GetSteepnessOfNeighboringTile(int x1, int z1, int x2, int
                 }
                 case +1: {
                     //tile downwards has 2 stepnessess
-                    stepness1 = (-this->pTerrainTiles[x2][z2].vert4CurrPositionY + this->pTerrainTiles[x2][z2].vert1CurrPositionY);
-                    stepness2 = (-this->pTerrainTiles[x2][z2].vert3CurrPositionY + this->pTerrainTiles[x2][z2].vert2CurrPositionY);
+                    stepness1 = (-this->mTileStore->GetVertexHeight(x2, z2, 4) + this->mTileStore->GetVertexHeight(x2, z2, 1));
+                    stepness2 = (-this->mTileStore->GetVertexHeight(x2, z2, 3) + this->mTileStore->GetVertexHeight(x2, z2, 2));
                     collPlanePos1 = v3;
                     collPlanePos2 = v4;
                     hlp = v1 - v4;
@@ -1301,9 +1331,9 @@ irr::f32 LevelTerrain::GetSteepnessOfNeighboringTile(int x1, int z1, int x2, int
         switch (deltaZ) {
             case -1: {
                 //corner tile right/upwards has 3 stepnessess
-                stepness1 = (-this->pTerrainTiles[x2][z2].vert3CurrPositionY + this->pTerrainTiles[x2][z2].vert4CurrPositionY);
-                stepness2 = (-this->pTerrainTiles[x2][z2].vert2CurrPositionY + this->pTerrainTiles[x2][z2].vert4CurrPositionY);
-                stepness3 = (-this->pTerrainTiles[x2][z2].vert1CurrPositionY + this->pTerrainTiles[x2][z2].vert4CurrPositionY);
+                stepness1 = (-this->mTileStore->GetVertexHeight(x2, z2, 3) + this->mTileStore->GetVertexHeight(x2, z2, 4));
+                stepness2 = (-this->mTileStore->GetVertexHeight(x2, z2, 2) + this->mTileStore->GetVertexHeight(x2, z2, 4));
+                stepness3 = (-this->mTileStore->GetVertexHeight(x2, z2, 1) + this->mTileStore->GetVertexHeight(x2, z2, 4));
                 hlp = (v4 - v2) * irr::core::vector3df(0.5f, 1.0f, 0.5f);
                 collPlanePos1 = v1 - hlp;
                 collPlanePos2 = v3 - hlp;
@@ -1313,8 +1343,8 @@ irr::f32 LevelTerrain::GetSteepnessOfNeighboringTile(int x1, int z1, int x2, int
              }
             case 0: {
                 //tile right of first tile, here there are only 2 stepnessess
-                stepness1 = (-this->pTerrainTiles[x2][z2].vert2CurrPositionY + this->pTerrainTiles[x2][z2].vert1CurrPositionY);
-                stepness2 = (-this->pTerrainTiles[x2][z2].vert3CurrPositionY + this->pTerrainTiles[x2][z2].vert4CurrPositionY);
+                stepness1 = (-this->mTileStore->GetVertexHeight(x2, z2, 2) + this->mTileStore->GetVertexHeight(x2, z2, 1));
+                stepness2 = (-this->mTileStore->GetVertexHeight(x2, z2, 3) + this->mTileStore->GetVertexHeight(x2, z2, 4));
                 collPlanePos1 = v2;
                 collPlanePos2 = v3;
                 hlp = v4 - v3;
@@ -1324,9 +1354,9 @@ irr::f32 LevelTerrain::GetSteepnessOfNeighboringTile(int x1, int z1, int x2, int
             }
             case +1: {
                 //corner tile right/downwards has 3 stepnessess
-                stepness1 = (-this->pTerrainTiles[x2][z2].vert4CurrPositionY + this->pTerrainTiles[x2][z2].vert1CurrPositionY);
-                stepness2 = (-this->pTerrainTiles[x2][z2].vert3CurrPositionY + this->pTerrainTiles[x2][z2].vert1CurrPositionY);
-                stepness3 = (-this->pTerrainTiles[x2][z2].vert2CurrPositionY + this->pTerrainTiles[x2][z2].vert1CurrPositionY);
+                stepness1 = (-this->mTileStore->GetVertexHeight(x2, z2, 4) + this->mTileStore->GetVertexHeight(x2, z2, 1));
+                stepness2 = (-this->mTileStore->GetVertexHeight(x2, z2, 3) + this->mTileStore->GetVertexHeight(x2, z2, 1));
+                stepness3 = (-this->mTileStore->GetVertexHeight(x2, z2, 2) + this->mTileStore->GetVertexHeight(x2, z2, 1));
                 hlp = (v1 - v3) * irr::core::vector3df(0.5f, 1.0f, 0.5f);
                 collPlanePos1 = v2 - hlp;
                 collPlanePos2 = v4 - hlp;
@@ -1357,36 +1387,31 @@ irr::f32 LevelTerrain::GetSteepnessOfNeighboringTile(int x1, int z1, int x2, int
 
 void LevelTerrain::RecalculateNormals(MapEntry *entry)
 {
-    //int max = positionVboData.Length;
-    //int perRow = levelRes.Width;
-
-    int Width = levelRes->Width();
-    int Height = levelRes->Height();
-
-    // update normals
+    // the height of the map entry is the vertice 1 height of tile (x, z), and
+    // the normal at a tile corner depends on the vertice 1 heights of the corner
+    // itself and of its 4 direct neighbors; The changed corners (x - 1 up to x + 1)
+    // are used by the tiles x - 2 up to x + 1 (the same for z)
     int valZ = entry->get_Z();
     int valX = entry->get_X();
 
-    for (int z = valZ - 1; z <= valZ + 1; z++)
-    {
-        for (int x = valX - 1; x <= valX + 1; x++)
-        {
-            if (x > Width - 1 || z > Height - 1) continue;
-
-            //int id = 4 * (x + z * perRow);
-            //if (id < 0 || id >= max) continue;
-
-            //normalVboData[id    ] = computeNormalFromPositionsBuffer(x, z, 1.0f);
-            //normalVboData[id + 1] = computeNormalFromPositionsBuffer(x + 1, z, 1.0f);
-            //normalVboData[id + 2] = computeNormalFromPositionsBuffer(x + 1, z + 1, 1.0f);
-            //normalVboData[id + 3] = computeNormalFromPositionsBuffer(x, z + 1, 1.0f);
-
-            this->pTerrainTiles[x][z].vert1CurrNormal = computeNormalFromPositionsBuffer(x, z, 1.0f);
-            this->pTerrainTiles[x][z].vert2CurrNormal = computeNormalFromPositionsBuffer(x + 1, z, 1.0f);
-            this->pTerrainTiles[x][z].vert3CurrNormal = computeNormalFromPositionsBuffer(x + 1, z + 1, 1.0f);
-            this->pTerrainTiles[x][z].vert4CurrNormal = computeNormalFromPositionsBuffer(x, z + 1, 1.0f);
-        }
-    }
+    RecalculateNormalsRegion(valX - 2, valZ - 2, valX + 1, valZ + 1);
+}
+
+//Recalculates the vertice normals of all tiles inside the specified
+//tile rectangle (xMax and zMax are included), each shared tile corner
+//is only calculated once (see CalcTerrainNormalsRegion)
+void LevelTerrain::RecalculateNormalsRegion(int xMin, int zMin, int xMax, int zMax)
+{
+    CalcTerrainNormalsRegion(mTileStore, xMin, zMin, xMax, zMax,
+        [this](int x, int z, const vector3d<irr::f32>& normal1, const vector3d<irr::f32>& normal2,
+               const vector3d<irr::f32>& normal3, const vector3d<irr::f32>& normal4) {
+            TerrainTileData* tile = &this->pTerrainTiles[x][z];
+
+            tile->vert1CurrNormal = normal1;
+            tile->vert2CurrNormal = normal2;
+            tile->vert3CurrNormal = normal3;
+            tile->vert4CurrNormal = normal4;
+        });
 }
 
 //outNrVertice returns the number of the vertice
@@ -1461,38 +1486,8 @@ bool LevelTerrain::ForceTileGridCoordRange(irr::core::vector2di &tileGridPos) {
 
 vector3d<irr::f32> LevelTerrain::computeNormalFromPositionsBuffer(irr::s32 x, irr::s32 z, irr::f32 intensity)
 {
-    int Width = levelRes->Width();
-    int Height = levelRes->Height();
-
-    if (x < 0 || x > Width - 1 || z < 0 || z > Height - 1)
-        return vector3d<irr::f32>(0.0f, 1.0f, 0.0f);
-
-    //int perLine = 4 * levelRes.Width;
-    //int id = 4 * x + z * perLine;
-
-    //float h = positionVboData[id].Y;
-    //use current vertice 1 Y position for calculation
-    float h = this->pTerrainTiles[x][z].vert1CurrPositionY;
-
-    irr::f32 a = z - 1 >= 0 ? this->pTerrainTiles[x][z-1].vert1CurrPositionY : h;
-    irr::f32 b = x + 1 < Width ? this->pTerrainTiles[x+1][z].vert1CurrPositionY : h;
-    irr::f32 c = z + 1 < Height ? this->pTerrainTiles[x][z+1].vert1CurrPositionY : h;
-    irr::f32 d = x - 1 >= 0 ? this->pTerrainTiles[x-1][z].vert1CurrPositionY : h;
-
-    vector3d<irr::f32> *nA = new vector3d<irr::f32>(0.0f, a - h, -intensity);
-    vector3d<irr::f32> *nB = new vector3d<irr::f32>(intensity, b - h, 0.0f);
-    vector3d<irr::f32> *nC = new vector3d<irr::f32>(0.0f, c - h, intensity);
-    vector3d<irr::f32> *nD = new vector3d<irr::f32>(-intensity, d - h, 0.0f);
-
-    vector3d<irr::f32> normal = 0.25f * (nA->crossProduct(*nB) + nB->crossProduct(*nC) + nC->crossProduct(*nD) + nD->crossProduct(*nA));
-    normal.normalize();
-
-    delete nA;
-    delete nB;
-    delete nC;
-    delete nD;
-
-    return normal;
+    //use current vertice 1 Y positions for calculation
+    return ComputeTerrainCornerNormal(this->mTileStore, x, z, intensity);
 }
 
 //calculate the one normal that is centered at the surface of the tile, and points in a 90 degress angle outwards (surfaceNormal of tile)
@@ -1637,42 +1632,6 @@ void LevelTerrain::FindTerrainOptimization() {
     }
 }
 
-int16_t LevelTerrain::GetIlluminationValueVertice1(int x, int y) {
-    MapEntry *a = GetMapEntry(x, y);
-    MapEntry *b = GetMapEntry(x + 1, y);
-    MapEntry *c = GetMapEntry(x + 1, y + 1);
-    MapEntry *d = GetMapEntry(x, y +  1);
-
-    return (a->mIllumination + b->mIllumination + c->mIllumination + d->mIllumination) / 4;
-}
-
-int16_t LevelTerrain::GetIlluminationValueVertice2(int x, int y) {
-    MapEntry *a = GetMapEntry(x, y);
-    MapEntry *b = GetMapEntry(x - 1, y);
-    MapEntry *c = GetMapEntry(x, y + 1);
-    MapEntry *d = GetMapEntry(x - 1, y +  1);
-
-    return (a->mIllumination + b->mIllumination + c->mIllumination + d->mIllumination) / 4;
-}
-
-int16_t LevelTerrain::GetIlluminationValueVertice3(int x, int y) {
-    MapEntry *a = GetMapEntry(x, y);
-    MapEntry *b = GetMapEntry(x - 1, y);
-    MapEntry *c = GetMapEntry(x - 1, y - 1);
-    MapEntry *d = GetMapEntry(x, y -  1);
-
-    return (a->mIllumination + b->mIllumination + c->mIllumination + d->mIllumination) / 4;
-}
-
-int16_t LevelTerrain::GetIlluminationValueVertice4(int x, int y) {
-    MapEntry *a = GetMapEntry(x, y);
-    MapEntry *b = GetMapEntry(x, y - 1);
-    MapEntry *c = GetMapEntry(x + 1, y - 1);
-    MapEntry *d = GetMapEntry(x + 1, y);
-
-    return (a->mIllumination + b->mIllumination + c->mIllumination + d->mIllumination) / 4;
-}
-
 irr::video::SColor LevelTerrain::CalcVertexColorForIllumination(int16_t illuminationValue) {
    irr::f32 colVal;
    irr::u32 colValInt;
@@ -1726,145 +1685,273 @@ void LevelTerrain::DisableIllumination() {
 }
 
 void LevelTerrain::CalculateIllumination() {
-    int x, z = 0;
+    //preproccess illumination slope value
+    mKIllumination = (255.0f - LEVEL_TERRAIN_COLOR_DARKEST) / (LEVEL_TERRAIN_ILLMAXVAL - LEVEL_TERRAIN_ILLMINVAL);
 
-    int Width = levelRes->Width();
-    int Height = levelRes->Height();
+    CalculateIlluminationRegion(0, 0, levelRes->Width() - 1, levelRes->Height() - 1);
 
-    TerrainTileData* tile;
+    std::cout << "Min VertexCol value = " << mMinVertexCol << ", Max VertexCol value = " << mMaxVertexCol << std::endl;
+}
 
-    //preproccess illumination slope value
-    mKIllumination = (255.0f - LEVEL_TERRAIN_COLOR_DARKEST) / (LEVEL_TERRAIN_ILLMAXVAL - LEVEL_TERRAIN_ILLMINVAL);
+//Calculates the illumination vertex colors for all tiles inside the specified
+//tile rectangle (xMax and zMax are included), and also stores them as the initial
+//colors for later morphing; Each shared tile corner is only calculated once
+//(see CalcTerrainIlluminationRegion)
+void LevelTerrain::CalculateIlluminationRegion(int xMin, int zMin, int xMax, int zMax) {
+    CalcTerrainIlluminationRegion(levelRes->Width(), levelRes->Height(), xMin, zMin, xMax, zMax,
+        [this](int x, int z) {
+            return this->levelRes->pMap[x][z]->mIllumination;
+        },
+        [this](int16_t illuminationValue) {
+            return CalcVertexColorForIllumination(illuminationValue);
+        },
+        [this](int x, int z, const irr::video::SColor& color1, const irr::video::SColor& color2,
+               const irr::video::SColor& color3, const irr::video::SColor& color4) {
+            TerrainTileData* tile = &this->pTerrainTiles[x][z];
+
+            tile->vert1Color = color1;
+            tile->vert2Color = color2;
+            tile->vert3Color = color3;
+            tile->vert4Color = color4;
+
+            //also stored the initial values for later
+            //morphing
+            tile->vert1ColorInitial = color1;
+            tile->vert2ColorInitial = color2;
+            tile->vert3ColorInitial = color3;
+            tile->vert4ColorInitial = color4;
+        });
+}
 
-    int16_t illumnVertex1;
-    int16_t illumnVertex2;
-    int16_t illumnVertex3;
-    int16_t illumnVertex4;
+void LevelTerrain::SetLevelCache(LevelCache* levelCache) {
+    mLevelCache = levelCache;
+}
 
-    for (z = 0; z < Height; z++) {
-      for (x = 0; x < Width; x++) {
-        illumnVertex3 = GetIlluminationValueVertice1(x, z);
-        illumnVertex4 = GetIlluminationValueVertice2(x, z);
-        illumnVertex1 = GetIlluminationValueVertice3(x, z);
-        illumnVertex2 = GetIlluminationValueVertice4(x, z);
+void LevelTerrain::SetupTileVertices(TerrainTileData* tile, TerrainTileStore* tileStore, int storeX, int mapX, int z,
+                                     irr::f32 posXLeft, irr::f32 posXRight) {
+    core::vector3df normal;
+    std::vector<vector2d<irr::f32>> newuvs;
 
-        tile = &pTerrainTiles[x][z];
+    // 4 vertices - need separate UVs so cannot share
+    MapEntry *a = GetMapEntry(mapX, z);
+    MapEntry *b = GetMapEntry(mapX + 1, z);
+    MapEntry *c = GetMapEntry(mapX + 1, z + 1);
+    MapEntry *d = GetMapEntry(mapX, z + 1);
 
-        tile->vert1Color = CalcVertexColorForIllumination(illumnVertex1);
-        tile->vert2Color = CalcVertexColorForIllumination(illumnVertex2);
-        tile->vert3Color = CalcVertexColorForIllumination(illumnVertex3);
-        tile->vert4Color = CalcVertexColorForIllumination(illumnVertex4);
-
-        //also stored the initial values for later
-        //morphing
-        tile->vert1ColorInitial = tile->vert1Color;
-        tile->vert2ColorInitial = tile->vert2Color;
-        tile->vert3ColorInitial = tile->vert3Color;
-        tile->vert4ColorInitial = tile->vert4Color;
-       }
-    }
+    //create 4 irrlicht vertices for this tile, regardless if we show the tile later or not!
+    tile->vert1 = new video::S3DVertex(0.0f,0.0f,0.0f, 0.0f, 0.0f, 0.0f, tile->vert1Color, 0.0f, 0.0f);
+    tile->vert2 = new video::S3DVertex(0.0f,0.0f,0.0f, 0.0f, 0.0f, 0.0f, tile->vert2Color, 0.0f, 0.0f);
+    tile->vert3 = new video::S3DVertex(0.0f,0.0f,0.0f, 0.0f, 0.0f, 0.0f, tile->vert3Color, 0.0f, 0.0f);
+    tile->vert4 = new video::S3DVertex(0.0f,0.0f,0.0f, 0.0f, 0.0f, 0.0f, tile->vert4Color, 0.0f, 0.0f);
 
-    std::cout << "Min VertexCol value = " << mMinVertexCol << ", Max VertexCol value = " << mMaxVertexCol << std::endl;
+    tile->vert1->Pos.set(posXLeft, -irr::f32(a->m_Height), z * segmentSize);
+    tileStore->SetVertexHeight(storeX, z, 1, tile->vert1->Pos.Y);
+
+    tile->vert2->Pos.set(posXRight, -irr::f32(b->m_Height), z * segmentSize);
+    tileStore->SetVertexHeight(storeX, z, 2, tile->vert2->Pos.Y);
+
+    tile->vert3->Pos.set(posXRight, -irr::f32(c->m_Height), (z + 1) * segmentSize);
+    tileStore->SetVertexHeight(storeX, z, 3, tile->vert3->Pos.Y);
+
+    tile->vert4->Pos.set(posXLeft, -irr::f32(d->m_Height), (z + 1) * segmentSize);
+    tileStore->SetVertexHeight(storeX, z, 4, tile->vert4->Pos.Y);
+
+    //precalculate averaged tile height, this value will be for example used later
+    //for player craft calculations...
+    tileStore->SetTileHeight(storeX, z, GetAveragedTileHeight(mapX, z));
+
+    //texture atlas 4 UVs
+    newuvs = MakeUVs(a->GetTextureModification());
+
+    tile->vert1->TCoords = newuvs[0];
+    tile->vert1UVcoord = newuvs[0];
+
+    tile->vert2->TCoords = newuvs[1];
+    tile->vert2UVcoord = newuvs[1];
+
+    tile->vert3->TCoords = newuvs[2];
+    tile->vert3UVcoord = newuvs[2];
+
+    tile->vert4->TCoords = newuvs[3];
+    tile->vert4UVcoord = newuvs[3];
+
+    tile->VertUpdatedUVScoord = false;
+
+    // add normals
+    normal = computeNormalFromMapEntries(mapX    , z    , 1.0f);
+    tile->vert1->Normal = normal;
+    tile->vert1CurrNormal = normal;
+
+    normal = computeNormalFromMapEntries(mapX + 1, z    , 1.0f);
+    tile->vert2->Normal = normal;
+    tile->vert2CurrNormal = normal;
+
+    normal = computeNormalFromMapEntries(mapX + 1, z + 1, 1.0f);
+    tile->vert3->Normal = normal;
+    tile->vert3CurrNormal = normal;
+
+    normal = computeNormalFromMapEntries(mapX    , z + 1, 1.0f);
+    tile->vert4->Normal = normal;
+    tile->vert4CurrNormal = normal;
 }
 
-bool LevelTerrain::SetupGeometry() {
-    int x, z = 0;
+void LevelTerrain::SetupTileVerticesFromLevelMesh(TerrainTileData* tile, TerrainTileStore* tileStore, int storeX, int mapX, int z,
+                                                  irr::video::S3DVertex* quadVertices) {
+    //the vertex colors are not taken from the cache, they depend
+    //on the current illumination setting
+    quadVertices[0].Color = tile->vert1Color;
+    quadVertices[1].Color = tile->vert2Color;
+    quadVertices[2].Color = tile->vert3Color;
+    quadVertices[3].Color = tile->vert4Color;
+
+    tile->vert1 = new video::S3DVertex(quadVertices[0]);
+    tile->vert2 = new video::S3DVertex(quadVertices[1]);
+    tile->vert3 = new video::S3DVertex(quadVertices[2]);
+    tile->vert4 = new video::S3DVertex(quadVertices[3]);
+
+    tileStore->SetVertexHeight(storeX, z, 1, tile->vert1->Pos.Y);
+    tileStore->SetVertexHeight(storeX, z, 2, tile->vert2->Pos.Y);
+    tileStore->SetVertexHeight(storeX, z, 3, tile->vert3->Pos.Y);
+    tileStore->SetVertexHeight(storeX, z, 4, tile->vert4->Pos.Y);
+
+    tileStore->SetTileHeight(storeX, z, GetAveragedTileHeight(mapX, z));
+
+    tile->vert1UVcoord = tile->vert1->TCoords;
+    tile->vert2UVcoord = tile->vert2->TCoords;
+    tile->vert3UVcoord = tile->vert3->TCoords;
+    tile->vert4UVcoord = tile->vert4->TCoords;
+
+    tile->VertUpdatedUVScoord = false;
+
+    tile->vert1CurrNormal = tile->vert1->Normal;
+    tile->vert2CurrNormal = tile->vert2->Normal;
+    tile->vert3CurrNormal = tile->vert3->Normal;
+    tile->vert4CurrNormal = tile->vert4->Normal;
+}
 
-    float max = 0.0f;
+void LevelTerrain::SetupTilesFromLevelMesh(LevelMesh* levelMesh, std::vector<TerrainMeshTileStruct> &tileVec, TerrainTileStore* tileStore) {
+    //ReadLevelMeshesFromCache made sure that there
+    //is exactly one quad for each tile
+    for (size_t idx = 0; idx < tileVec.size(); idx++) {
+        LevelMeshQuadStruct& quad = levelMesh->mQuadVec[idx];
+        LevelMeshBufferStruct* buffer = levelMesh->mBufferVec[quad.bufferIdx];
 
-    int Width = levelRes->Width();
-    int Height = levelRes->Height();
+        SetupTileVerticesFromLevelMesh(tileVec[idx].tile, tileStore, tileVec[idx].storeX, tileVec[idx].mapX, tileVec[idx].mapZ,
+                                       &buffer->vertices[quad.firstVertexIdx]);
+    }
+}
 
-    core::vector3df normal;
+void LevelTerrain::AddTilesToLevelMesh(LevelMesh* levelMesh, std::vector<TerrainMeshTileStruct> &tileVec) {
+    std::vector<TerrainMeshTileStruct>::iterator it;
 
-    TerrainTileData* tile;
-    std::vector<vector2d<irr::f32>> newuvs;
+    for (it = tileVec.begin(); it != tileVec.end(); ++it) {
+        levelMesh->AddQuad((*it).textureId, *(*it).tile->vert1, *(*it).tile->vert2, *(*it).tile->vert3, *(*it).tile->vert4);
+    }
+}
 
-    MapEntry *a;
-    MapEntry *b;
-    MapEntry *c;
-    MapEntry *d;
+void LevelTerrain::AddLevelMeshToTiles(std::vector<MeshBufferInfoStruct*> &targetMeshBufVec, LevelMesh* levelMesh,
+                                       std::vector<TerrainMeshTileStruct> &tileVec) {
+    std::vector<irr::scene::SMeshBuffer*> meshBufVec;
 
-    /*********************************************************
-     * First setup vertices for all possible Terrain tiles   *
-     *********************************************************/
+    mIrrMeshBuf->AddLevelMesh(targetMeshBufVec, levelMesh, meshBufVec, *mTerrainMeshStats);
 
-    for (z = 0; z < Height; z++) {
-      for (x = 0; x < Width; x++) {
-        // 4 vertices - need separate UVs so cannot share
-        a = GetMapEntry(x, z);
-        b = GetMapEntry(x + 1, z);
-        c = GetMapEntry(x + 1, z + 1);
-        d = GetMapEntry(x, z + 1);
+    //we need to know for each tile in which meshbuffer
+    //its vertices are, for morphing later
+    for (size_t idx = 0; idx < tileVec.size(); idx++) {
+        LevelMeshQuadStruct& quad = levelMesh->mQuadVec[idx];
 
-        tile = &pTerrainTiles[x][z];
+        if (meshBufVec[quad.bufferIdx] == nullptr)
+            continue;
 
-        //create 4 irrlicht vertices for this tile, regardless if we show the tile later or not!
-        tile->vert1 = new video::S3DVertex(0.0f,0.0f,0.0f, 0.0f, 0.0f, 0.0f, tile->vert1Color, 0.0f, 0.0f);
-        tile->vert2 = new video::S3DVertex(0.0f,0.0f,0.0f, 0.0f, 0.0f, 0.0f, tile->vert2Color, 0.0f, 0.0f);
-        tile->vert3 = new video::S3DVertex(0.0f,0.0f,0.0f, 0.0f, 0.0f, 0.0f, tile->vert3Color, 0.0f, 0.0f);
-        tile->vert4 = new video::S3DVertex(0.0f,0.0f,0.0f, 0.0f, 0.0f, 0.0f, tile->vert4Color, 0.0f, 0.0f);
+        tileVec[idx].tile->myMeshBufVertexId1.push_back(quad.firstVertexIdx);
+        tileVec[idx].tile->myMeshBuffers.push_back(meshBufVec[quad.bufferIdx]);
+    }
+}
 
-        tile->vert1->Pos.set(x       * segmentSize, -irr::f32(a->m_Height),  z * segmentSize);
-        tile->vert1CurrPositionY = tile->vert1->Pos.Y;
-        tile->vert1CurrPositionYDirty = false;
+//Layout of the terrain mesh cache sections:
+//  uint32 width of the tile area, uint32 height of the tile area
+//  followed by the level meshes, see LevelMesh::AppendToCacheData
+bool LevelTerrain::ReadLevelMeshesFromCache(uint32_t sectionId, irr::u32 width, std::vector<LevelMesh*> &levelMeshVec,
+                                            std::vector<std::vector<TerrainMeshTileStruct>*> &tileVecVec) {
+    if (mLevelCache == nullptr)
+        return false;
 
-        tile->vert2->Pos.set((x + 1) * segmentSize, -irr::f32(b->m_Height), z * segmentSize);
-        tile->vert2CurrPositionY = tile->vert2->Pos.Y;
-        tile->vert2CurrPositionYDirty = false;
+    std::vector<uint8_t> data;
 
-        tile->vert3->Pos.set((x + 1) * segmentSize, -irr::f32(c->m_Height), (z + 1) * segmentSize);
-        tile->vert3CurrPositionY = tile->vert3->Pos.Y;
-        tile->vert3CurrPositionYDirty = false;
+    if (!mLevelCache->GetSection(sectionId, data))
+        return false;
 
-        tile->vert4->Pos.set(x       * segmentSize, -irr::f32(d->m_Height), (z + 1) * segmentSize);
-        tile->vert4CurrPositionY = tile->vert4->Pos.Y;
-        tile->vert4CurrPositionYDirty = false;
+    size_t readIdx = 0;
 
-        //precalculate averaged tile height, this value will be for example used later
-        //for player craft calculations...
-        tile->currTileHeight = GetAveragedTileHeight(x, z);
+    if (data.size() < 2 * sizeof(uint32_t))
+        return false;
 
-        //texture atlas 4 UVs
-        newuvs = MakeUVs(a->GetTextureModification());
+    if ((LevelCache::ReadUInt32(data, readIdx) != width) || (LevelCache::ReadUInt32(data, readIdx) != (irr::u32)(levelRes->Height())))
+        return false;
 
-        tile->vert1->TCoords = newuvs[0];
-        tile->vert1UVcoord = newuvs[0];
+    for (size_t meshIdx = 0; meshIdx < levelMeshVec.size(); meshIdx++) {
+        LevelMesh* levelMesh = levelMeshVec[meshIdx];
+        std::vector<TerrainMeshTileStruct>* tileVec = tileVecVec[meshIdx];
 
-        tile->vert2->TCoords = newuvs[1];
-        tile->vert2UVcoord = newuvs[1];
+        if (!levelMesh->ReadFromCacheData(data, readIdx))
+            return false;
 
-        tile->vert3->TCoords = newuvs[2];
-        tile->vert3UVcoord = newuvs[2];
+        //the cached mesh must contain exactly the tiles we want
+        //to draw, each one with its current texture
+        if (levelMesh->mQuadVec.size() != tileVec->size())
+            return false;
 
-        tile->vert4->TCoords = newuvs[3];
-        tile->vert4UVcoord = newuvs[3];
+        for (size_t idx = 0; idx < tileVec->size(); idx++) {
+            if (levelMesh->mBufferVec[levelMesh->mQuadVec[idx].bufferIdx]->textureId != (*tileVec)[idx].textureId)
+                return false;
+        }
+    }
 
-        tile->VertUpdatedUVScoord = false;
+    return (readIdx == data.size());
+}
 
-        // add normals
-        normal = computeNormalFromMapEntries(x    , z    , 1.0f);
-        tile->vert1->Normal = normal;
-        tile->vert1CurrNormal = normal;
+void LevelTerrain::WriteLevelMeshesToCache(uint32_t sectionId, irr::u32 width, std::vector<LevelMesh*> &levelMeshVec) {
+    if (mLevelCache == nullptr)
+        return;
 
-        normal = computeNormalFromMapEntries(x + 1, z    , 1.0f);
-        tile->vert2->Normal = normal;
-        tile->vert2CurrNormal = normal;
+    std::vector<uint8_t> data;
 
-        normal = computeNormalFromMapEntries(x + 1, z + 1, 1.0f);
-        tile->vert3->Normal = normal;
-        tile->vert3CurrNormal = normal;
+    LevelCache::AppendUInt32(data, width);
+    LevelCache::AppendUInt32(data, (irr::u32)(levelRes->Height()));
 
-        normal = computeNormalFromMapEntries(x    , z + 1, 1.0f);
-        tile->vert4->Normal = normal;
-        tile->vert4CurrNormal = normal;
+    std::vector<LevelMesh*>::iterator it;
 
-        tile->RefreshNormals = false;
-      }
+    for (it = levelMeshVec.begin(); it != levelMeshVec.end(); ++it) {
+        (*it)->AppendToCacheData(data);
     }
 
-    //now add all visible cells (only cells that were
-    //not optimized away (non used parts of the level map))
+    mLevelCache->SetSection(sectionId, data);
+}
+
+bool LevelTerrain::PrepareGeometry(std::atomic<irr::u32>* progress) {
+    int x, z = 0;
+
+    float max = 0.0f;
+
+    int Width = levelRes->Width();
+    int Height = levelRes->Height();
+
+    TerrainTileData* tile;
+    MapEntry *a;
+
+    int nrTextures = mIrrMeshBuf->GetNrTextures();
+
+    mStaticLevelMesh = new LevelMesh(nrTextures);
+    mDynamicLevelMesh = new LevelMesh(nrTextures);
+
+    mStaticMeshTileVec.clear();
+    mDynamicMeshTileVec.clear();
+
+    /*********************************************************
+     * First find all visible cells (only cells that were    *
+     * not optimized away (non used parts of the level map)) *
+     *********************************************************/
+
     for (z = 0; z < Height; z++) {
       for (x = 0; x < Width; x++) {
           tile = &pTerrainTiles[x][z];
@@ -1875,17 +1962,88 @@ bool LevelTerrain::SetupGeometry() {
               // determine max height
               max = std::max(max, a->m_Height);
 
+              //tiles with an invalid texture Id
+              //can not be drawn
+              if (!mStaticLevelMesh->IsValidTextureId(a->m_TextureId))
+                  continue;
+
+              TerrainMeshTileStruct meshTile;
+              meshTile.tile = tile;
+              meshTile.storeX = x;
+              meshTile.mapX = x;
+              meshTile.mapZ = z;
+              meshTile.textureId = a->m_TextureId;
+
               if (!tile->dynamicMesh) {
                  //is a static cell (does not morph)
-                 mIrrMeshBuf->AddMeshBufferTile(mStaticMeshBufferVec, tile, a->m_TextureId, *mTerrainMeshStats);
+                 mStaticMeshTileVec.push_back(meshTile);
               } else {
                  //is a dynamic cell (is able to morph)
-                 mIrrMeshBuf->AddMeshBufferTile(mDynamicMeshBufferVec, tile, a->m_TextureId, *mTerrainMeshStats);
+                 mDynamicMeshTileVec.push_back(meshTile);
               }
         }
       }
     }
 
+    /*********************************************************
+     * Setup vertices for all possible Terrain tiles         *
+     *********************************************************/
+
+    std::vector<LevelMesh*> levelMeshVec = {mStaticLevelMesh, mDynamicLevelMesh};
+    std::vector<std::vector<TerrainMeshTileStruct>*> tileVecVec = {&mStaticMeshTileVec, &mDynamicMeshTileVec};
+
+    //if the level cache contains the terrain mesh already, we take
+    //the vertices of all visible cells directly out of it
+    bool fromCache = ReadLevelMeshesFromCache(LEVELCACHE_SECTION_TERRAINMESH, (irr::u32)(Width), levelMeshVec, tileVecVec);
+
+    if (fromCache) {
+        SetupTilesFromLevelMesh(mStaticLevelMesh, mStaticMeshTileVec, mTileStore);
+        SetupTilesFromLevelMesh(mDynamicLevelMesh, mDynamicMeshTileVec, mTileStore);
+    }
+
+    //all remaining tiles (or all tiles without a valid cache) are
+    //created out of the map entries
+    for (z = 0; z < Height; z++) {
+      for (x = 0; x < Width; x++) {
+        tile = &pTerrainTiles[x][z];
+
+        if (tile->vert1 == nullptr) {
+            SetupTileVertices(tile, mTileStore, x, x, z, x * segmentSize, (x + 1) * segmentSize);
+        }
+      }
+
+      if (progress != nullptr)
+          (*progress)++;
+    }
+
+    if (!fromCache) {
+        AddTilesToLevelMesh(mStaticLevelMesh, mStaticMeshTileVec);
+        AddTilesToLevelMesh(mDynamicLevelMesh, mDynamicMeshTileVec);
+
+        WriteLevelMeshesToCache(LEVELCACHE_SECTION_TERRAINMESH, (irr::u32)(Width), levelMeshVec);
+    }
+
+    Size.X = levelRes->Width() * segmentSize;
+    Size.Y = max;
+    Size.Z = levelRes->Height() * segmentSize;
+
+    return true;
+}
+
+bool LevelTerrain::SetupGeometry() {
+    int nrTextures = mIrrMeshBuf->GetNrTextures();
+
+    //now create the Irrlicht meshbuffers for all visible cells
+    AddLevelMeshToTiles(mStaticMeshBufferVec, mStaticLevelMesh, mStaticMeshTileVec);
+    AddLevelMeshToTiles(mDynamicMeshBufferVec, mDynamicLevelMesh, mDynamicMeshTileVec);
+
+    //the CPU side copy is not needed anymore
+    delete mStaticLevelMesh;
+    delete mDynamicLevelMesh;
+
+    mStaticLevelMesh = nullptr;
+    mDynamicLevelMesh = nullptr;
+
     //get number of already existing Meshbuffers for all available Texture Ids of Terrain
     std::vector<irr::u8> nrMeshBuffersPerTexId = mIrrMeshBuf->ReturnMeshBufferCntPerTextureId(mStaticMeshBufferVec);
 
@@ -1941,8 +2099,6 @@ bool LevelTerrain::SetupGeometry() {
     std::vector<irr::scene::SMeshBuffer*> bufList;
     std::vector<irr::scene::SMeshBuffer*>::iterator bufIt;
 
-    int nrTextures = mIrrMeshBuf->GetNrTextures();
-
     for (int currTexId = 0; currTexId < nrTextures; currTexId++) {
 
         bufList = mIrrMeshBuf->ReturnAllMeshBuffersForTextureId(mStaticMeshBufferVec, currTexId);
@@ -1980,46 +2136,33 @@ bool LevelTerrain::SetupGeometry() {
    myDynamicTerrainMesh->setDirty();
    myDynamicTerrainMesh->recalculateBoundingBox();
 
-   Size.X = levelRes->Width() * segmentSize;
-   Size.Y = max;
-   Size.Z = levelRes->Height() * segmentSize;
-
    return true;
 }
 
-bool LevelTerrain::SetupGeometryEndOfMap() {
+bool LevelTerrain::PrepareGeometryEndOfMap(std::atomic<irr::u32>* progress) {
     int x, z = 0;
 
     int Width = levelRes->Width();
     int Height = levelRes->Height();
 
-    core::vector3df normal;
-
     TerrainTileData* tile;
-    std::vector<vector2d<irr::f32>> newuvs;
-
     MapEntry *a;
-    MapEntry *b;
-    MapEntry *c;
-    MapEntry *d;
 
     int idxHelper;
     int xCoordHelper;
     TerrainTileData* origTile;
 
+    mEndOfMapLevelMesh = new LevelMesh(mIrrMeshBuf->GetNrTextures());
+    mEndOfMapMeshTileVec.clear();
+
     /********************************************
-     * Setup vertices for this special tiles    *
+     * Find all of this special tiles           *
      ********************************************/
 
     for (z = 0; z < Height; z++) {
-       idxHelper = 0;
-       xCoordHelper = LEVELTERRAIN_WIDTH_ENDOFMAP - 1;
+      idxHelper = 0;
       for (x = (Width - LEVELTERRAIN_WIDTH_ENDOFMAP); x < Width; x++) {
-        // 4 vertices - need separate UVs so cannot share
         a = GetMapEntry(x , z);
-        b = GetMapEntry(x + 1, z);
-        c = GetMapEntry(x + 1, z + 1);
-        d = GetMapEntry(x , z + 1);
 
         tile = &pTerrainTilesEndOfMap[idxHelper][z];
         origTile = &pTerrainTiles[x][z];
@@ -2035,86 +2178,73 @@ bool LevelTerrain::SetupGeometryEndOfMap() {
         tile->vert3ColorInitial = origTile->vert3ColorInitial;
         tile->vert4ColorInitial = origTile->vert4ColorInitial;
 
-        //create 4 irrlicht vertices for this tile, regardless if we show the tile later or not!
-        tile->vert1 = new video::S3DVertex(0.0f,0.0f,0.0f, 0.0f, 0.0f, 0.0f, tile->vert1Color, 0.0f, 0.0f);
-        tile->vert2 = new video::S3DVertex(0.0f,0.0f,0.0f, 0.0f, 0.0f, 0.0f, tile->vert2Color, 0.0f, 0.0f);
-        tile->vert3 = new video::S3DVertex(0.0f,0.0f,0.0f, 0.0f, 0.0f, 0.0f, tile->vert3Color, 0.0f, 0.0f);
-        tile->vert4 = new video::S3DVertex(0.0f,0.0f,0.0f, 0.0f, 0.0f, 0.0f, tile->vert4Color, 0.0f, 0.0f);
-
-        tile->vert1->Pos.set(- (xCoordHelper + 1)      * segmentSize, -irr::f32(a->m_Height), z * segmentSize);
-        tile->vert1CurrPositionY = tile->vert1->Pos.Y;
-        tile->vert1CurrPositionYDirty = false;
-
-        tile->vert2->Pos.set(- xCoordHelper * segmentSize, -irr::f32(b->m_Height), z * segmentSize);
-        tile->vert2CurrPositionY = tile->vert2->Pos.Y;
-        tile->vert2CurrPositionYDirty = false;
-
-        tile->vert3->Pos.set(- xCoordHelper * segmentSize, -irr::f32(c->m_Height), (z + 1) * segmentSize);
-        tile->vert3CurrPositionY = tile->vert3->Pos.Y;
-        tile->vert3CurrPositionYDirty = false;
-
-        tile->vert4->Pos.set(- (xCoordHelper + 1)       * segmentSize, -irr::f32(d->m_Height), (z + 1) * segmentSize);
-        tile->vert4CurrPositionY = tile->vert4->Pos.Y;
-        tile->vert4CurrPositionYDirty = false;
-
-        //precalculate averaged tile height, this value will be for example used later
-        //for player craft calculations...
-        tile->currTileHeight = GetAveragedTileHeight(x, z);
-
-        //texture atlas 4 UVs
-        newuvs = MakeUVs(a->GetTextureModification());
-
-        tile->vert1->TCoords = newuvs[0];
-        tile->vert1UVcoord = newuvs[0];
-
-        tile->vert2->TCoords = newuvs[1];
-        tile->vert2UVcoord = newuvs[1];
-
-        tile->vert3->TCoords = newuvs[2];
-        tile->vert3UVcoord = newuvs[2];
+        //tiles with an invalid texture Id
+        //can not be drawn
+        if (mEndOfMapLevelMesh->IsValidTextureId(a->m_TextureId)) {
+            TerrainMeshTileStruct meshTile;
+            meshTile.tile = tile;
+            meshTile.storeX = idxHelper;
+            meshTile.mapX = x;
+            meshTile.mapZ = z;
+            meshTile.textureId = a->m_TextureId;
+
+            mEndOfMapMeshTileVec.push_back(meshTile);
+        }
 
-        tile->vert4->TCoords = newuvs[3];
-        tile->vert4UVcoord = newuvs[3];
+        idxHelper++;
+      }
+    }
 
-        tile->VertUpdatedUVScoord = false;
+    /********************************************
+     * Setup vertices for this special tiles    *
+     ********************************************/
 
-        // add normals
-        normal = computeNormalFromMapEntries(x    , z    , 1.0f);
-        tile->vert1->Normal = normal;
-        tile->vert1CurrNormal = normal;
+    std::vector<LevelMesh*> levelMeshVec = {mEndOfMapLevelMesh};
+    std::vector<std::vector<TerrainMeshTileStruct>*> tileVecVec = {&mEndOfMapMeshTileVec};
 
-        normal = computeNormalFromMapEntries(x + 1, z    , 1.0f);
-        tile->vert2->Normal = normal;
-        tile->vert2CurrNormal = normal;
+    bool fromCache = ReadLevelMeshesFromCache(LEVELCACHE_SECTION_TERRAINMESHENDOFMAP, LEVELTERRAIN_WIDTH_ENDOFMAP,
+                                              levelMeshVec, tileVecVec);
 
-        normal = computeNormalFromMapEntries(x + 1, z + 1, 1.0f);
-        tile->vert3->Normal = normal;
-        tile->vert3CurrNormal = normal;
+    if (fromCache) {
+        SetupTilesFromLevelMesh(mEndOfMapLevelMesh, mEndOfMapMeshTileVec, mTileStoreEndOfMap);
+    }
 
-        normal = computeNormalFromMapEntries(x    , z + 1, 1.0f);
-        tile->vert4->Normal = normal;
-        tile->vert4CurrNormal = normal;
+    for (z = 0; z < Height; z++) {
+       idxHelper = 0;
+       xCoordHelper = LEVELTERRAIN_WIDTH_ENDOFMAP - 1;
+      for (x = (Width - LEVELTERRAIN_WIDTH_ENDOFMAP); x < Width; x++) {
+        tile = &pTerrainTilesEndOfMap[idxHelper][z];
 
-        tile->RefreshNormals = false;
+        if (tile->vert1 == nullptr) {
+            SetupTileVertices(tile, mTileStoreEndOfMap, idxHelper, x, z,
+                              - (xCoordHelper + 1) * segmentSize, - xCoordHelper * segmentSize);
+        }
 
         idxHelper++;
         xCoordHelper--;
       }
+
+      if (progress != nullptr)
+          (*progress)++;
     }
 
     //now add all Terrain cells
-    for (z = 0; z < Height; z++) {
-        idxHelper = 0;
-        for (x = (Width - LEVELTERRAIN_WIDTH_ENDOFMAP); x < Width; x++) {
-          a = GetMapEntry(x , z);
+    if (!fromCache) {
+        AddTilesToLevelMesh(mEndOfMapLevelMesh, mEndOfMapMeshTileVec);
 
-          tile = &pTerrainTilesEndOfMap[idxHelper][z];
-          idxHelper++;
-
-          mIrrMeshBuf->AddMeshBufferTile(mStaticMeshBufferEndOfMapVec, tile, a->m_TextureId, *mTerrainMeshStats);
-      }
+        WriteLevelMeshesToCache(LEVELCACHE_SECTION_TERRAINMESHENDOFMAP, LEVELTERRAIN_WIDTH_ENDOFMAP, levelMeshVec);
     }
 
+    return true;
+}
+
+bool LevelTerrain::SetupGeometryEndOfMap() {
+    AddLevelMeshToTiles(mStaticMeshBufferEndOfMapVec, mEndOfMapLevelMesh, mEndOfMapMeshTileVec);
+
+    //the CPU side copy is not needed anymore
+    delete mEndOfMapLevelMesh;
+    mEndOfMapLevelMesh = nullptr;
+
     //create Mesh for the static Terrain for X < 0 coordinates
 
     //first make the Mesh
@@ -2149,7 +2279,7 @@ bool LevelTerrain::SetupGeometryEndOfMap() {
 }
 
 void LevelTerrain::UpdateCellMeshVertex1(int x, int y) {
-    if (!this->pTerrainTiles[x][y].vert1CurrPositionYDirty)
+    if (!this->mTileStore->IsVertexHeightDirty(x, y, 1))
         return;
 
     std::vector<irr::scene::SMeshBuffer*>::iterator it2;
@@ -2161,7 +2291,7 @@ void LevelTerrain::UpdateCellMeshVertex1(int x, int y) {
          (*it2)->grab();
          void* pntrVert = (*it2)->getVertices();
          pntrVertices = (S3DVertex*)pntrVert;
-         pntrVertices[this->pTerrainTiles[x][y].myMeshBufVertexId1[idxMeshBuf]].Pos.Y = this->pTerrainTiles[x][y].vert1CurrPositionY;
+         pntrVertices[this->pTerrainTiles[x][y].myMeshBufVertexId1[idxMeshBuf]].Pos.Y = this->mTileStore->GetVertexHeight(x, y, 1);
          if (this->pTerrainTiles[x][y].VertUpdatedUVScoord) {
             pntrVertices[this->pTerrainTiles[x][y].myMeshBufVertexId1[idxMeshBuf]].TCoords = this->pTerrainTiles[x][y].vert1UVcoord;
             pntrVertices[this->pTerrainTiles[x][y].myMeshBufVertexId1[idxMeshBuf]].Color = this->pTerrainTiles[x][y].vert1Color;
@@ -2173,11 +2303,11 @@ void LevelTerrain::UpdateCellMeshVertex1(int x, int y) {
          (*it2)->drop();
      }
 
-    this->pTerrainTiles[x][y].vert1CurrPositionYDirty = false;
+    this->mTileStore->SetVertexHeightDirty(x, y, 1, false);
 }
 
 void LevelTerrain::UpdateCellMeshVertex2(int x, int y) {
-    if (!this->pTerrainTiles[x][y].vert2CurrPositionYDirty)
+    if (!this->mTileStore->IsVertexHeightDirty(x, y, 2))
         return;
 
     std::vector<irr::scene::SMeshBuffer*>::iterator it2;
@@ -2191,7 +2321,7 @@ void LevelTerrain::UpdateCellMeshVertex2(int x, int y) {
          void* pntrVert = (*it2)->getVertices();
          pntrVertices = (S3DVertex*)pntrVert;
 
-         pntrVertices[this->pTerrainTiles[x][y].myMeshBufVertexId1[idxMeshBuf] + 1].Pos.Y = this->pTerrainTiles[x][y].vert2CurrPositionY;
+         pntrVertices[this->pTerrainTiles[x][y].myMeshBufVertexId1[idxMeshBuf] + 1].Pos.Y = this->mTileStore->GetVertexHeight(x, y, 2);
          if (this->pTerrainTiles[x][y].VertUpdatedUVScoord) {
             pntrVertices[this->pTerrainTiles[x][y].myMeshBufVertexId1[idxMeshBuf] + 1].TCoords = this->pTerrainTiles[x][y].vert2UVcoord;
             pntrVertices[this->pTerrainTiles[x][y].myMeshBufVertexId1[idxMeshBuf] + 1].Color = this->pTerrainTiles[x][y].vert2Color;
@@ -2203,11 +2333,11 @@ void LevelTerrain::UpdateCellMeshVertex2(int x, int y) {
          (*it2)->drop();
      }
 
-      this->pTerrainTiles[x][y].vert2CurrPositionYDirty = false;
+      this->mTileStore->SetVertexHeightDirty(x, y, 2, false);
 }
 
 void LevelTerrain::UpdateCellMeshVertex3(int x, int y) {
-    if (!this->pTerrainTiles[x][y].vert3CurrPositionYDirty)
+    if (!this->mTileStore->IsVertexHeightDirty(x, y, 3))
         return;
 
     std::vector<irr::scene::SMeshBuffer*>::iterator it2;
@@ -2221,7 +2351,7 @@ void LevelTerrain::UpdateCellMeshVertex3(int x, int y) {
          void* pntrVert = (*it2)->getVertices();
          pntrVertices = (S3DVertex*)pntrVert;
 
-         pntrVertices[this->pTerrainTiles[x][y].myMeshBufVertexId1[idxMeshBuf] + 2].Pos.Y = this->pTerrainTiles[x][y].vert3CurrPositionY;
+         pntrVertices[this->pTerrainTiles[x][y].myMeshBufVertexId1[idxMeshBuf] + 2].Pos.Y = this->mTileStore->GetVertexHeight(x, y, 3);
          if (this->pTerrainTiles[x][y].VertUpdatedUVScoord) {
             pntrVertices[this->pTerrainTiles[x][y].myMeshBufVertexId1[idxMeshBuf] + 2].TCoords = this->pTerrainTiles[x][y].vert3UVcoord;
             pntrVertices[this->pTerrainTiles[x][y].myMeshBufVertexId1[idxMeshBuf] + 2].Color = this->pTerrainTiles[x][y].vert3Color;
@@ -2233,11 +2363,11 @@ void LevelTerrain::UpdateCellMeshVertex3(int x, int y) {
          (*it2)->drop();
      }
 
-     this->pTerrainTiles[x][y].vert3CurrPositionYDirty = false;
+     this->mTileStore->SetVertexHeightDirty(x, y, 3, false);
 }
 
 void LevelTerrain::UpdateCellMeshVertex4(int x, int y) {
-    if (!this->pTerrainTiles[x][y].vert4CurrPositionYDirty)
+    if (!this->mTileStore->IsVertexHeightDirty(x, y, 4))
         return;
 
     std::vector<irr::scene::SMeshBuffer*>::iterator it2;
@@ -2251,7 +2381,7 @@ void LevelTerrain::UpdateCellMeshVertex4(int x, int y) {
          void* pntrVert = (*it2)->getVertices();
          pntrVertices = (S3DVertex*)pntrVert;
 
-         pntrVertices[this->pTerrainTiles[x][y].myMeshBufVertexId1[idxMeshBuf] + 3].Pos.Y = this->pTerrainTiles[x][y].vert4CurrPositionY;
+         pntrVertices[this->pTerrainTiles[x][y].myMeshBufVertexId1[idxMeshBuf] + 3].Pos.Y = this->mTileStore->GetVertexHeight(x, y, 4);
          if (this->pTerrainTiles[x][y].VertUpdatedUVScoord) {
             pntrVertices[this->pTerrainTiles[x][y].myMeshBufVertexId1[idxMeshBuf] + 3].TCoords = this->pTerrainTiles[x][y].vert4UVcoord;
             pntrVertices[this->pTerrainTiles[x][y].myMeshBufVertexId1[idxMeshBuf] + 3].Color = this->pTerrainTiles[x][y].vert4Color;
@@ -2263,7 +2393,7 @@ void LevelTerrain::UpdateCellMeshVertex4(int x, int y) {
          (*it2)->drop();
      }
 
-    this->pTerrainTiles[x][y].vert4CurrPositionYDirty = false;
+    this->mTileStore->SetVertexHeightDirty(x, y, 4, false);
 }
 
 void LevelTerrain::SetFog(bool enabled) {
@@ -2320,9 +2450,6 @@ void LevelTerrain::ApplyMorph(Morph& morph)
                   MapEntry* c = GetMapEntry(xIdxSrc + 1, zIdxSrc + 1);
                   MapEntry* d = GetMapEntry(xIdxSrc, zIdxSrc + 1);
 
-                  //activate refreshNormals for entry a
-                  this->pTerrainTiles[xIdxSrc][zIdxSrc].RefreshNormals = true;
-
                   // target entries
                   xIdxTarget = xTarget + dx;
                   zIdxTarget = zTarget + dz;
@@ -2332,9 +2459,6 @@ void LevelTerrain::ApplyMorph(Morph& morph)
                   MapEntry* g = GetMapEntry(xIdxTarget + 1, zIdxTarget + 1);
                   MapEntry* h = GetMapEntry(xIdxTarget, zIdxTarget + 1);
 
-                  //activate refreshNormals for entry e
-                  this->pTerrainTiles[xIdxTarget][zIdxTarget].RefreshNormals = true;
-
                   // set UVs either from source or from target
                   if (updateUVs && (dx > 0) && (dz > 0))
                   {
@@ -2409,64 +2533,43 @@ void LevelTerrain::ApplyMorph(Morph& morph)
 
                   // calculate and set new Y values
                   if (dx > 0 && dz > 0) {
-                     this->pTerrainTiles[xIdxTarget][zIdxTarget].vert1CurrPositionY =
-                              -(e->m_Height * (1.0f - morph.getProgress()) + a->m_Height * morph.getProgress());
-                     this->pTerrainTiles[xIdxTarget][zIdxTarget].vert1CurrPositionYDirty = true;
+                     this->mTileStore->SetVertexHeight(xIdxTarget, zIdxTarget, 1,
+                              -(e->m_Height * (1.0f - morph.getProgress()) + a->m_Height * morph.getProgress()));
+                     this->mTileStore->SetVertexHeightDirty(xIdxTarget, zIdxTarget, 1, true);
                   }
 
                   if ((dx < morph.Width) && (dz > 0)) {
-                     this->pTerrainTiles[xIdxTarget][zIdxTarget].vert2CurrPositionY =
-                              -(f->m_Height * (1.0f - morph.getProgress()) + b->m_Height * morph.getProgress());
-                     this->pTerrainTiles[xIdxTarget][zIdxTarget].vert2CurrPositionYDirty = true;
+                     this->mTileStore->SetVertexHeight(xIdxTarget, zIdxTarget, 2,
+                              -(f->m_Height * (1.0f - morph.getProgress()) + b->m_Height * morph.getProgress()));
+                     this->mTileStore->SetVertexHeightDirty(xIdxTarget, zIdxTarget, 2, true);
                    }
 
                   if ((dx < morph.Width) && (dz < morph.Height)) {
-                     this->pTerrainTiles[xIdxTarget][zIdxTarget].vert3CurrPositionY =
-                              -(g->m_Height * (1.0f - morph.getProgress()) + c->m_Height * morph.getProgress());
-                     this->pTerrainTiles[xIdxTarget][zIdxTarget].vert3CurrPositionYDirty = true;
+                     this->mTileStore->SetVertexHeight(xIdxTarget, zIdxTarget, 3,
+                              -(g->m_Height * (1.0f - morph.getProgress()) + c->m_Height * morph.getProgress()));
+                     this->mTileStore->SetVertexHeightDirty(xIdxTarget, zIdxTarget, 3, true);
                   }
 
                  if ((dx > 0) && (dz < morph.Height)) {
-                     this->pTerrainTiles[xIdxTarget][zIdxTarget].vert4CurrPositionY =
-                             -(h->m_Height * (1.0f - morph.getProgress()) + d->m_Height * morph.getProgress());
-                     this->pTerrainTiles[xIdxTarget][zIdxTarget].vert4CurrPositionYDirty = true;
+                     this->mTileStore->SetVertexHeight(xIdxTarget, zIdxTarget, 4,
+                             -(h->m_Height * (1.0f - morph.getProgress()) + d->m_Height * morph.getProgress()));
+                     this->mTileStore->SetVertexHeightDirty(xIdxTarget, zIdxTarget, 4, true);
                  }
 
                  //recalculate averaged tile height, this value will be for example used later
                  //for player craft calculations...
-                 this->pTerrainTiles[xIdxTarget][zIdxTarget].currTileHeight = GetAveragedTileHeight(xIdxTarget, zIdxTarget);
+                 this->mTileStore->SetTileHeight(xIdxTarget, zIdxTarget, GetAveragedTileHeight(xIdxTarget, zIdxTarget));
               }
           }
 
           // recalculate all necessary vertice normals
-          for (int dz = 0; dz < morph.Height + 1; dz++)
-          {
-              for (int dx = 0; dx < morph.Width + 1; dx++)
-              {
-                  // source entries
-                  int x = xSource + dx;
-                  int z = zSource + dz;
-
-                  MapEntry* a = GetMapEntry(x, z);
-
-                  if (this->pTerrainTiles[x][z].RefreshNormals) {
-                      RecalculateNormals(a);
-                      this->pTerrainTiles[x][z].RefreshNormals = false;
-                  }
-
-                  // target entries
-                  x = xTarget + dx;
-                  z = zTarget + dz;
-
-                  MapEntry* e = GetMapEntry(x, z);
-
-                  if (this->pTerrainTiles[x][z].RefreshNormals) {
-                      RecalculateNormals(e);
-                      this->pTerrainTiles[x][z].RefreshNormals = false;
-                  }
-              }
-
-          }
+          // the vertice 1 heights of the tiles xTarget + 1 up to xTarget + morph.Width
+          // have changed (the same for z), this changes the normals at the corners xTarget
+          // up to xTarget + morph.Width + 1, which are used by the tiles of the morph
+          // rectangle plus a border of one tile; Only this region is updated, and each
+          // tile of it only once
+          RecalculateNormalsRegion(xSource - 1, zSource - 1, xSource + morph.Width + 1, zSource + morph.Height + 1);
+          RecalculateNormalsRegion(xTarget - 1, zTarget - 1, xTarget + morph.Width + 1, zTarget + morph.Height + 1);
 
           // now update all vertices in SMeshBuffers
           for (int dz = 0; dz < morph.Height + 1; dz++)
@@ -2581,21 +2684,15 @@ irr::f32 LevelTerrain::GetCurrentTerrainHeightForWorldCoordinate(irr::f32 x, irr
 
     outCellCoord = cell;
 
-    //get pntr to this tile
-    TerrainTileData *pntr = &pTerrainTiles[cell.X][cell.Y];
+    //get the 4 vertex heights of this tile
+    const irr::f32* vertHeight = mTileStore->GetVertexHeights(cell.X, cell.Y);
 
-    irr::f32 yRes;
+    irr::f32 slopeX = -vertHeight[1] + vertHeight[0];
+    irr::f32 slopeZ = -vertHeight[3] + vertHeight[0];
 
-    if (pntr != nullptr) {
-        irr::f32 slopeX = -pntr->vert2CurrPositionY + pntr->vert1CurrPositionY;
-        irr::f32 slopeZ = -pntr->vert4CurrPositionY + pntr->vert1CurrPositionY;
+    vector2df modulus(-x - irr::f32(cell.X), z - irr::f32(cell.Y));
 
-        vector2df modulus(-x - irr::f32(cell.X), z - irr::f32(cell.Y));
-
-        yRes = -pntr->vert1CurrPositionY + slopeX * modulus.X + slopeZ * modulus.Y;
-    } else {
-        yRes = 0.0f;
-    }
+    irr::f32 yRes = -vertHeight[0] + slopeX * modulus.X + slopeZ * modulus.Y;
 
     return yRes;
 }
@@ -2845,15 +2942,19 @@ void LevelTerrain::SetNewCellVertexHeight(int x, int y, int whichVertex, irr::f3
 
     irr::core::vector2di cell(x,y);
 
+    //the map entry whose height is changed
+    MapEntry* changedEntry = a;
+
     switch (whichVertex) {
         case 1: {
            //set new Y value in low level map
            a->m_Height = -newHeightValue;
+           changedEntry = a;
 
            //set new Y values in Irrlicht Mesh
-           this->pTerrainTiles[x][y].vert1CurrPositionY = newHeightValue;
+           this->mTileStore->SetVertexHeight(x, y, 1, newHeightValue);
            this->pTerrainTiles[x][y].vert1->Pos.Y = newHeightValue;
-           this->pTerrainTiles[x][y].vert1CurrPositionYDirty = true;
+           this->mTileStore->SetVertexHeightDirty(x, y, 1, true);
 
            CheckAndUpdateHeightExistingColumn(x, y, 1, -newHeightValue);
 
@@ -2864,9 +2965,9 @@ void LevelTerrain::SetNewCellVertexHeight(int x, int y, int whichVertex, irr::f3
            //Returns false if were landed outside of the valid grid area, and the coordinates
            //were adjusted
            if (!ForceTileGridCoordRange(cell)) {
-               this->pTerrainTiles[cell.X][cell.Y].vert2CurrPositionY = newHeightValue;
+               this->mTileStore->SetVertexHeight(cell.X, cell.Y, 2, newHeightValue);
                this->pTerrainTiles[cell.X][cell.Y].vert2->Pos.Y = newHeightValue;
-               this->pTerrainTiles[cell.X][cell.Y].vert2CurrPositionYDirty = true;
+               this->mTileStore->SetVertexHeightDirty(cell.X, cell.Y, 2, true);
 
                CheckAndUpdateHeightExistingColumn(cell.X, cell.Y, 2, -newHeightValue);
            }
@@ -2875,9 +2976,9 @@ void LevelTerrain::SetNewCellVertexHeight(int x, int y, int whichVertex, irr::f3
            cell.Y = y - 1;
 
            if (!ForceTileGridCoordRange(cell)) {
-               this->pTerrainTiles[cell.X][cell.Y].vert3CurrPositionY = newHeightValue;
+               this->mTileStore->SetVertexHeight(cell.X, cell.Y, 3, newHeightValue);
                this->pTerrainTiles[cell.X][cell.Y].vert3->Pos.Y = newHeightValue;
-               this->pTerrainTiles[cell.X][cell.Y].vert3CurrPositionYDirty = true;
+               this->mTileStore->SetVertexHeightDirty(cell.X, cell.Y, 3, true);
 
                CheckAndUpdateHeightExistingColumn(cell.X, cell.Y, 3, -newHeightValue);
            }
@@ -2886,9 +2987,9 @@ void LevelTerrain::SetNewCellVertexHeight(int x, int y, int whichVertex, irr::f3
            cell.Y = y - 1;
 
            if (!ForceTileGridCoordRange(cell)) {
-               this->pTerrainTiles[cell.X][cell.Y].vert4CurrPositionY = newHeightValue;
+               this->mTileStore->SetVertexHeight(cell.X, cell.Y, 4, newHeightValue);
                this->pTerrainTiles[cell.X][cell.Y].vert4->Pos.Y = newHeightValue;
-               this->pTerrainTiles[cell.X][cell.Y].vert4CurrPositionYDirty = true;
+               this->mTileStore->SetVertexHeightDirty(cell.X, cell.Y, 4, true);
 
                CheckAndUpdateHeightExistingColumn(cell.X, cell.Y, 4, -newHeightValue);
            }
@@ -2899,11 +3000,12 @@ void LevelTerrain::SetNewCellVertexHeight(int x, int y, int whichVertex, irr::f3
         case 2: {
            //set new Y value in low level map
            b->m_Height = -newHeightValue;
+           changedEntry = b;
 
            //set new Y values in Irrlicht Mesh
-           this->pTerrainTiles[x][y].vert2CurrPositionY = newHeightValue;
+           this->mTileStore->SetVertexHeight(x, y, 2, newHeightValue);
            this->pTerrainTiles[x][y].vert2->Pos.Y = newHeightValue;
-           this->pTerrainTiles[x][y].vert2CurrPositionYDirty = true;
+           this->mTileStore->SetVertexHeightDirty(x, y, 2, true);
 
            CheckAndUpdateHeightExistingColumn(x, y, 2, -newHeightValue);
 
@@ -2914,9 +3016,9 @@ void LevelTerrain::SetNewCellVertexHeight(int x, int y, int whichVertex, irr::f3
            //Returns false if were landed outside of the valid grid area, and the coordinates
            //were adjusted
            if (!ForceTileGridCoordRange(cell)) {
-               this->pTerrainTiles[cell.X][cell.Y].vert1CurrPositionY = newHeightValue;
+               this->mTileStore->SetVertexHeight(cell.X, cell.Y, 1, newHeightValue);
                this->pTerrainTiles[cell.X][cell.Y].vert1->Pos.Y = newHeightValue;
-               this->pTerrainTiles[cell.X][cell.Y].vert1CurrPositionYDirty = true;
+               this->mTileStore->SetVertexHeightDirty(cell.X, cell.Y, 1, true);
 
                CheckAndUpdateHeightExistingColumn(cell.X, cell.Y, 1, -newHeightValue);
            }
@@ -2925,9 +3027,9 @@ void LevelTerrain::SetNewCellVertexHeight(int x, int y, int whichVertex, irr::f3
            cell.Y = y - 1;
 
            if (!ForceTileGridCoordRange(cell)) {
-               this->pTerrainTiles[cell.X][cell.Y].vert3CurrPositionY = newHeightValue;
+               this->mTileStore->SetVertexHeight(cell.X, cell.Y, 3, newHeightValue);
                this->pTerrainTiles[cell.X][cell.Y].vert3->Pos.Y = newHeightValue;
-               this->pTerrainTiles[cell.X][cell.Y].vert3CurrPositionYDirty = true;
+               this->mTileStore->SetVertexHeightDirty(cell.X, cell.Y, 3, true);
 
                CheckAndUpdateHeightExistingColumn(cell.X, cell.Y, 3, -newHeightValue);
            }
@@ -2936,9 +3038,9 @@ void LevelTerrain::SetNewCellVertexHeight(int x, int y, int whichVertex, irr::f3
            cell.Y = y - 1;
 
            if (!ForceTileGridCoordRange(cell)) {
-               this->pTerrainTiles[cell.X][cell.Y].vert4CurrPositionY = newHeightValue;
+               this->mTileStore->SetVertexHeight(cell.X, cell.Y, 4, newHeightValue);
                this->pTerrainTiles[cell.X][cell.Y].vert4->Pos.Y = newHeightValue;
-               this->pTerrainTiles[cell.X][cell.Y].vert4CurrPositionYDirty = true;
+               this->mTileStore->SetVertexHeightDirty(cell.X, cell.Y, 4, true);
 
                CheckAndUpdateHeightExistingColumn(cell.X, cell.Y, 4, -newHeightValue);
            }
@@ -2949,11 +3051,12 @@ void LevelTerrain::SetNewCellVertexHeight(int x, int y, int whichVertex, irr::f3
         case 3: {
            //set new Y value in low level map
            c->m_Height = -newHeightValue;
+           changedEntry = c;
 
            //set new Y values in Irrlicht Mesh
-           this->pTerrainTiles[x][y].vert3CurrPositionY = newHeightValue;
+           this->mTileStore->SetVertexHeight(x, y, 3, newHeightValue);
            this->pTerrainTiles[x][y].vert3->Pos.Y = newHeightValue;
-           this->pTerrainTiles[x][y].vert3CurrPositionYDirty = true;
+           this->mTileStore->SetVertexHeightDirty(x, y, 3, true);
 
            CheckAndUpdateHeightExistingColumn(x, y, 3, -newHeightValue);
 
@@ -2964,9 +3067,9 @@ void LevelTerrain::SetNewCellVertexHeight(int x, int y, int whichVertex, irr::f3
            //Returns false if were landed outside of the valid grid area, and the coordinates
            //were adjusted
            if (!ForceTileGridCoordRange(cell)) {
-               this->pTerrainTiles[cell.X][cell.Y].vert4CurrPositionY = newHeightValue;
+               this->mTileStore->SetVertexHeight(cell.X, cell.Y, 4, newHeightValue);
                this->pTerrainTiles[cell.X][cell.Y].vert4->Pos.Y = newHeightValue;
-               this->pTerrainTiles[cell.X][cell.Y].vert4CurrPositionYDirty = true;
+               this->mTileStore->SetVertexHeightDirty(cell.X, cell.Y, 4, true);
 
                CheckAndUpdateHeightExistingColumn(cell.X, cell.Y, 4, -newHeightValue);
            }
@@ -2975,9 +3078,9 @@ void LevelTerrain::SetNewCellVertexHeight(int x, int y, int whichVertex, irr::f3
            cell.Y = y + 1;
 
            if (!ForceTileGridCoordRange(cell)) {
-               this->pTerrainTiles[cell.X][cell.Y].vert1CurrPositionY = newHeightValue;
+               this->mTileStore->SetVertexHeight(cell.X, cell.Y, 1, newHeightValue);
                this->pTerrainTiles[cell.X][cell.Y].vert1->Pos.Y = newHeightValue;
-               this->pTerrainTiles[cell.X][cell.Y].vert1CurrPositionYDirty = true;
+               this->mTileStore->SetVertexHeightDirty(cell.X, cell.Y, 1, true);
 
                CheckAndUpdateHeightExistingColumn(cell.X, cell.Y, 1, -newHeightValue);
            }
@@ -2986,9 +3089,9 @@ void LevelTerrain::SetNewCellVertexHeight(int x, int y, int whichVertex, irr::f3
            cell.Y = y + 1;
 
            if (!ForceTileGridCoordRange(cell)) {
-               this->pTerrainTiles[cell.X][cell.Y].vert2CurrPositionY = newHeightValue;
+               this->mTileStore->SetVertexHeight(cell.X, cell.Y, 2, newHeightValue);
                this->pTerrainTiles[cell.X][cell.Y].vert2->Pos.Y = newHeightValue;
-               this->pTerrainTiles[cell.X][cell.Y].vert2CurrPositionYDirty = true;
+               this->mTileStore->SetVertexHeightDirty(cell.X, cell.Y, 2, true);
 
                CheckAndUpdateHeightExistingColumn(cell.X, cell.Y, 2, -newHeightValue);
            }
@@ -2999,11 +3102,12 @@ void LevelTerrain::SetNewCellVertexHeight(int x, int y, int whichVertex, irr::f3
         case 4: {
            //set new Y value in low level map
            d->m_Height = -newHeightValue;
+           changedEntry = d;
 
            //set new Y values in Irrlicht Mesh
-           this->pTerrainTiles[x][y].vert4CurrPositionY = newHeightValue;
+           this->mTileStore->SetVertexHeight(x, y, 4, newHeightValue);
            this->pTerrainTiles[x][y].vert4->Pos.Y = newHeightValue;
-           this->pTerrainTiles[x][y].vert4CurrPositionYDirty = true;
+           this->mTileStore->SetVertexHeightDirty(x, y, 4, true);
 
            CheckAndUpdateHeightExistingColumn(x, y, 4, -newHeightValue);
 
@@ -3014,9 +3118,9 @@ void LevelTerrain::SetNewCellVertexHeight(int x, int y, int whichVertex, irr::f3
            //Returns false if were landed outside of the valid grid area, and the coordinates
            //were adjusted
            if (!ForceTileGridCoordRange(cell)) {
-               this->pTerrainTiles[cell.X][cell.Y].vert3CurrPositionY = newHeightValue;
+               this->mTileStore->SetVertexHeight(cell.X, cell.Y, 3, newHeightValue);
                this->pTerrainTiles[cell.X][cell.Y].vert3->Pos.Y = newHeightValue;
-               this->pTerrainTiles[cell.X][cell.Y].vert3CurrPositionYDirty = true;
+               this->mTileStore->SetVertexHeightDirty(cell.X, cell.Y, 3, true);
 
                CheckAndUpdateHeightExistingColumn(cell.X, cell.Y, 3, -newHeightValue);
            }
@@ -3025,9 +3129,9 @@ void LevelTerrain::SetNewCellVertexHeight(int x, int y, int whichVertex, irr::f3
            cell.Y = y + 1;
 
            if (!ForceTileGridCoordRange(cell)) {
-               this->pTerrainTiles[cell.X][cell.Y].vert2CurrPositionY = newHeightValue;
+               this->mTileStore->SetVertexHeight(cell.X, cell.Y, 2, newHeightValue);
                this->pTerrainTiles[cell.X][cell.Y].vert2->Pos.Y = newHeightValue;
-               this->pTerrainTiles[cell.X][cell.Y].vert2CurrPositionYDirty = true;
+               this->mTileStore->SetVertexHeightDirty(cell.X, cell.Y, 2, true);
 
                CheckAndUpdateHeightExistingColumn(cell.X, cell.Y, 2, -newHeightValue);
            }
@@ -3036,9 +3140,9 @@ void LevelTerrain::SetNewCellVertexHeight(int x, int y, int whichVertex, irr::f3
            cell.Y = y + 1;
 
            if (!ForceTileGridCoordRange(cell)) {
-               this->pTerrainTiles[cell.X][cell.Y].vert1CurrPositionY = newHeightValue;
+               this->mTileStore->SetVertexHeight(cell.X, cell.Y, 1, newHeightValue);
                this->pTerrainTiles[cell.X][cell.Y].vert1->Pos.Y = newHeightValue;
-               this->pTerrainTiles[cell.X][cell.Y].vert1CurrPositionYDirty = true;
+               this->mTileStore->SetVertexHeightDirty(cell.X, cell.Y, 1, true);
 
                CheckAndUpdateHeightExistingColumn(cell.X, cell.Y, 1, -newHeightValue);
            }
@@ -3061,12 +3165,12 @@ void LevelTerrain::SetNewCellVertexHeight(int x, int y, int whichVertex, irr::f3
         for (int yIdx = startPos.Y; yIdx <= endPos.Y; yIdx++) {
             //recalculate averaged tile height, this value will be for example used later
             //for player craft calculations...
-            this->pTerrainTiles[xIdx][yIdx].currTileHeight = GetAveragedTileHeight(xIdx, yIdx);
+            this->mTileStore->SetTileHeight(xIdx, yIdx, GetAveragedTileHeight(xIdx, yIdx));
         }
    }
 
    //recalculate all necessary vertice normals
-   RecalculateNormals(a);
+   RecalculateNormals(changedEntry);
 
    for (int xIdx = startPos.X; xIdx <= endPos.X; xIdx++) {
         for (int yIdx = startPos.Y; yIdx <= endPos.Y; yIdx++) {
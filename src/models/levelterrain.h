@@ -17,8 +17,10 @@
 
 #include "irrlicht.h"
 #include <vector>
+#include <atomic>
 #include "../resources/levelfile.h"
 #include "player.h"
+#include "terraintilestore.h"
 
 using namespace irr;
 using namespace video;
@@ -80,6 +82,8 @@ struct MeshObjectStatsStruct;
 class IrrMeshBuf;
 class LevelBlocks;
 struct ColorStruct;
+class LevelCache;
+class LevelMesh;
 
 struct TerrainTileData {
     //pointers to my 4 vertices per tile to be able to morph Terrain
@@ -109,17 +113,9 @@ struct TerrainTileData {
     //index for first vertice + 1, + 2, and + 3
     std::vector<irr::u32> myMeshBufVertexId1;
 
-    //to allow easier recalculation of vertice normals during Terrain morphing also
-    //store my vertice position for Y-axis information for every vertice here (positionVboData)
-    irr::f32 vert1CurrPositionY = 0.0f;
-    irr::f32 vert2CurrPositionY = 0.0f;
-    irr::f32 vert3CurrPositionY = 0.0f;
-    irr::f32 vert4CurrPositionY = 0.0f;
-
-    bool vert1CurrPositionYDirty = false;
-    bool vert2CurrPositionYDirty = false;
-    bool vert3CurrPositionYDirty = false;
-    bool vert4CurrPositionYDirty = false;
+    //Note: the current vertice Y-axis positions, their dirty flags and the current
+    //averaged tile height are not stored here, but in the TerrainTileStore of the
+    //LevelTerrain (see mTileStore), because they are read very often
 
     //for easier morphing also store my current vertices normals here
     vector3d<irr::f32> vert1CurrNormal;
@@ -127,8 +123,6 @@ struct TerrainTileData {
     vector3d<irr::f32> vert3CurrNormal;
     vector3d<irr::f32> vert4CurrNormal;
 
-    bool RefreshNormals = false;
-
     //for easier morphing also store my current vertice UVs coordinates here
     vector2d<irr::f32> vert1UVcoord;
     vector2d<irr::f32> vert2UVcoord;
@@ -152,12 +146,22 @@ struct TerrainTileData {
     //we need to keep pointer to my meshbuffer,
     //to be able to set it dirty if we have changed a vertices dynamically
     std::vector<irr::scene::SMeshBuffer*> myMeshBuffers;
+};
+
+//a terrain tile that is added to a LevelMesh, the tiles
+//are stored in the order in which they are added
+struct TerrainMeshTileStruct {
+    TerrainTileData* tile;
 
-    //stores the current averaged tile height
-    //is for example needed for player craft calculations
-    //afterwards; when the Terrain does morph this value
-    //keeps to be correct
-    irr::f32 currTileHeight = 0.0f;
+    //coordinate of the tile inside
+    //of its TerrainTileStore
+    int storeX;
+
+    //map coordinate of the tile
+    int mapX;
+    int mapZ;
+
+    int16_t textureId;
 };
 
 class LevelTerrain {
@@ -166,9 +170,24 @@ public:
                  bool optimizeMesh, bool enableLightning);
     ~LevelTerrain();
 
+    //First part of the terrain initialization: creates the vertices of all tiles, and sorts
+    //them into the meshbuffer layout; Needs to know which tiles are dynamic (morphing)
+    //already. Does not use the Irrlicht device, and can therefore run on a thread pool
+    //worker; progress (if set) is incremented up to GetNrPrepareSteps()
+    bool PrepareTerrainGeometry(std::atomic<irr::u32>* progress = nullptr);
+    irr::u32 GetNrPrepareSteps();
+
+    //Second part of the terrain initialization: creates the Irrlicht meshes and scene
+    //nodes, must run on the main thread; calls PrepareTerrainGeometry first if this
+    //was not done yet
     void FinishTerrainInitialization();
     void SetLevelBlocks(LevelBlocks* levelBlocks);
 
+    //if a level cache is set, the terrain meshbuffers are restored from
+    //the cache if possible, or are stored in the cache after they were
+    //created; without a level cache (level editor) they are always created
+    void SetLevelCache(LevelCache* levelCache);
+
     void ResetTerrainTileData();
 
     void ApplyMorph(Morph& morph);
@@ -176,6 +195,10 @@ public:
     bool Terrain_ready;
     TerrainTileData pTerrainTiles[LEVELFILE_WIDTH][LEVELFILE_HEIGHT];
 
+    //vertex heights, averaged tile heights and dirty flags of all
+    //tiles in pTerrainTiles, stored in tightly packed arrays
+    TerrainTileStore* mTileStore = nullptr;
+
     //static terrain mesh and SceneNode that is not affected
     //by any defined level morphs
     ISceneNode *StaticTerrainSceneNode = nullptr;
@@ -192,6 +215,7 @@ public:
     //Static terrain Mesh for map coordinates X < 0
     //Replicates approx. a region of one third of the map width
     TerrainTileData pTerrainTilesEndOfMap[LEVELTERRAIN_WIDTH_ENDOFMAP][LEVELFILE_HEIGHT];
+    TerrainTileStore* mTileStoreEndOfMap = nullptr;
 
     //static terrain mesh and SceneNode for the Terrain Mesh
     //for map coordinates X < 0
@@ -247,21 +271,6 @@ public:
     bool Overlapping(irr::f32 r1x1, irr::f32 r1y1, irr::f32 r1x2, irr::f32 r1y2,
                      irr::f32 r2x1, irr::f32 r2y1, irr::f32 r2x2, irr::f32 r2y2);
 
-    //definition of road texture elements
-    //most important textures for auto generation of
-    //minimap
-    std::vector<irr::s32> roadTexIdsVec = {31, 60, 61, 62, 63, 64, 65, 67, 69, 76,
-                                            77, 78, 79, 81, 82, 86, 116, 117, 118, 119,
-                                           122, 124, 125, 126, 127, 128, 129, 130, 131, 132, 136, 137, 138, 139, 140,
-                                           141, 142, 143, 144, 145, 148, 149, 150, 151, 152, 154, 155,
-                                           96, 4};
-
-    //some more additional texture IDs for roads which would disturb
-    //the minimap creation if we would add them to roadTexIdsVec directly
-    //but we need them in worldaware to properly detect the local width of the race track
-    std::vector<irr::s32> roadTexIdsVecExtendedForWorldAware = {
-        43, 47, 51, 120, 121,             123, 134, 135, 146, 147, 153 };
-
     //texture IDs we can use the detect charging areas
     std::vector<irr::s32> chargerTexIdsVec = {0, 2, 43, 47, 51, 31, 60, 61, 62, 63, 64, 65, 67, 69, 76,
                                             77, 78, 79, 81, 82, 86, 116, 117, 118, 119,
@@ -269,6 +278,7 @@ public:
                                            141, 142, 143, 144, 145, 148, 149, 150, 151, 152, 154, 155,
                                            96, 4};
 
+    //the road texture Ids are defined in LevelAnalysis
     bool IsRoadTexture(irr::s32 texture, bool addExtendedTextures = false);
     bool IsChargingStationTexture(irr::s32 texture);
 
@@ -309,10 +319,9 @@ public:
 private:
     IrrMeshBuf* mIrrMeshBuf = nullptr;
 
-    int16_t GetIlluminationValueVertice1(int x, int y);
-    int16_t GetIlluminationValueVertice2(int x, int y);
-    int16_t GetIlluminationValueVertice3(int x, int y);
-    int16_t GetIlluminationValueVertice4(int x, int y);
+    //Calculates illumination vertex colors only for the specified
+    //tile rectangle (xMax and zMax are included)
+    void CalculateIlluminationRegion(int xMin, int zMin, int xMax, int zMax);
 
     irr::video::SColor CalcVertexColorForIllumination(int16_t illuminationValue);
 
@@ -331,8 +340,52 @@ private:
 
     void UpdateTileVerticeColors(int x, int y, bool skipMeshUpdate = false);
 
+    //CPU side part of the geometry setup, see PrepareTerrainGeometry
+    bool PrepareGeometry(std::atomic<irr::u32>* progress);
+    bool PrepareGeometryEndOfMap(std::atomic<irr::u32>* progress);
+
+    //creates the Irrlicht meshes out of the prepared level meshes
     bool SetupGeometry();
     bool SetupGeometryEndOfMap();
+
+    //the prepared geometry, only valid between PrepareTerrainGeometry and
+    //FinishTerrainInitialization; The tile vectors contain the tiles in the same
+    //order as the quads of the level meshes
+    bool mGeometryPrepared = false;
+
+    LevelMesh* mStaticLevelMesh = nullptr;
+    LevelMesh* mDynamicLevelMesh = nullptr;
+    LevelMesh* mEndOfMapLevelMesh = nullptr;
+
+    std::vector<TerrainMeshTileStruct> mStaticMeshTileVec;
+    std::vector<TerrainMeshTileStruct> mDynamicMeshTileVec;
+    std::vector<TerrainMeshTileStruct> mEndOfMapMeshTileVec;
+
+    //creates the 4 vertices of a tile out of the map entries, posXLeft and posXRight
+    //are the X coordinates of the left and right edge of the tile
+    void SetupTileVertices(TerrainTileData* tile, TerrainTileStore* tileStore, int storeX, int mapX, int z,
+                           irr::f32 posXLeft, irr::f32 posXRight);
+
+    //creates the 4 vertices of a tile out of the 4 vertices of a quad of a
+    //LevelMesh that was restored from the level cache
+    void SetupTileVerticesFromLevelMesh(TerrainTileData* tile, TerrainTileStore* tileStore, int storeX, int mapX, int z,
+                                        irr::video::S3DVertex* quadVertices);
+
+    void SetupTilesFromLevelMesh(LevelMesh* levelMesh, std::vector<TerrainMeshTileStruct> &tileVec, TerrainTileStore* tileStore);
+    void AddTilesToLevelMesh(LevelMesh* levelMesh, std::vector<TerrainMeshTileStruct> &tileVec);
+
+    //creates the Irrlicht meshbuffers for the level mesh, and stores in each tile
+    //where its vertices are located
+    void AddLevelMeshToTiles(std::vector<MeshBufferInfoStruct*> &targetMeshBufVec, LevelMesh* levelMesh,
+                             std::vector<TerrainMeshTileStruct> &tileVec);
+
+    //reads the level meshes from the specified level cache section, returns false
+    //if the section is not available or does not match the specified tiles
+    bool ReadLevelMeshesFromCache(uint32_t sectionId, irr::u32 width, std::vector<LevelMesh*> &levelMeshVec,
+                                  std::vector<std::vector<TerrainMeshTileStruct>*> &tileVecVec);
+    void WriteLevelMeshesToCache(uint32_t sectionId, irr::u32 width, std::vector<LevelMesh*> &levelMeshVec);
+
+    LevelCache* mLevelCache = nullptr;
     void FindTerrainOptimization();
     bool Terrain_Optimization_isValid_Cell_coordinate(int xcoord, int zcoord);
     int TerrainOptimization_compareCells(MapEntry *MiddleCell, MapEntry *Neighborcell);
@@ -378,6 +431,10 @@ private:
     bool mLevelEditorMode;
 
     void RecalculateNormals(MapEntry *entry);
+
+    //Recalculates vertice normals only for the specified
+    //tile rectangle (xMax and zMax are included)
+    void RecalculateNormalsRegion(int xMin, int zMin, int xMax, int zMax);
     irr::f32 GetAveragedTileHeight(int x, int z);
 
     MeshObjectStatsStruct* mTerrainMeshStats;
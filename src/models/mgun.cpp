@@ -132,7 +132,7 @@ void MachineGun::Trigger() {
             //only play this sound for a human player, for a computer player
             //this does not make sense, and only is disturbing
             if (mParent->mHumanPlayer) {
-               if (mShotFailSound == nullptr) {
+               if (!mParent->mRace->mSoundEngine->IsSoundPlaying(mShotFailSound)) {
                     mShotFailSound = mParent->mRace->mSoundEngine->PlaySound(SRES_GAME_MGUN_SHOTFAILED,
                                                                              mParent->phobj->physicState.position, false);
                }
@@ -265,18 +265,6 @@ void MachineGun::Update(irr::f32 DeltaTime) {
                    (*it)->shooting = false;
                  }
             }
-
-            if ((*it)->mShotSound != nullptr) {
-                if ((*it)->mShotSound->getStatus() == sf::SoundSource::Status::Stopped) {
-                    (*it)->mShotSound = nullptr;
-                }
-            }
-    }
-
-    if (mShotFailSound != nullptr) {
-            if (mShotFailSound->getStatus() == sf::SoundSource::Status::Stopped) {
-                mShotFailSound = nullptr;
-            }
     }
 
     //we started or stopped firing
@@ -385,9 +373,7 @@ MachineGun::~MachineGun() {
         //remove all animators from this SceneNode
         pntr->animSprite->removeAnimators();
 
-        if (pntr->mShotSound != nullptr) {
-            pntr->mShotSound->stop();
-        }
+        mParent->mRace->mSoundEngine->StopSound(pntr->mShotSound);
 
         //remove this SceneNode from the
         //SceneManager
@@ -12,6 +12,7 @@
 
 #include <irrlicht.h>
 #include <SFML/Audio.hpp>
+#include "../audio/voicealloc.h"
 
 //the machine gun damage should be choosen that a
 //craft with full ammo needs continious machine gun for
@@ -39,7 +40,7 @@ struct MachineGunBulletImpactStruct {
     bool shooting = false;
     bool animatorActive = false;
 
-    sf::Sound* mShotSound = nullptr;
+    VoiceHandleStruct mShotSound;
 };
 
 class MachineGun {
@@ -78,7 +79,7 @@ private:
     //False otherwise
     bool LoadSprites();
 
-    sf::Sound* mShotFailSound = nullptr;
+    VoiceHandleStruct mShotFailSound;
 
     irr::core::array<irr::video::ITexture*> animTexList;
 
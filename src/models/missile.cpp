@@ -16,6 +16,7 @@
 #include "explauncher.h"
 #include "../race.h"
 #include "../resources/mapentry.h"
+#include "../utils/visgrid.h"
 
 Missile::Missile(MissileLauncher* mParentLauncher, irr::core::vector3df launchLoc, irr::core::vector3df targetLoc,
                  bool targetLocked, Player* lockedPlayer) {
@@ -49,6 +50,32 @@ Missile::Missile(MissileLauncher* mParentLauncher, irr::core::vector3df launchLo
     //adjust its target location to the location of the enemy player
     this->targetStillLocked = targetLocked;
     this->mLockedPlayer = lockedPlayer;
+
+    VisibilityGrid* visGrid = mParentLauncher->mParent->mRace->mVisibilityGrid;
+
+    if (visGrid != nullptr) {
+        mVisGridEntry = visGrid->AddEntity(GetVisGridBox(), mSceneNodeMissile);
+    }
+}
+
+irr::core::aabbox3df Missile::GetVisGridBox() {
+    irr::core::vector3df halfSize(DEF_MISSILE_VISGRIDBOXSIZE, DEF_MISSILE_VISGRIDBOXSIZE, DEF_MISSILE_VISGRIDBOXSIZE);
+
+    return irr::core::aabbox3df(currentLocation - halfSize, currentLocation + halfSize);
+}
+
+//needs to be called before the missile scene node is removed
+void Missile::RemoveFromVisGrid() {
+    if (mVisGridEntry == nullptr)
+        return;
+
+    VisibilityGrid* visGrid = mParentLauncher->mParent->mRace->mVisibilityGrid;
+
+    if (visGrid != nullptr) {
+        visGrid->RemoveEntity(mVisGridEntry);
+    }
+
+    mVisGridEntry = nullptr;
 }
 
 Missile::~Missile() {
@@ -64,6 +91,8 @@ Missile::~Missile() {
         RemoveSmokeSprite(pntr);
     }
 
+    RemoveFromVisGrid();
+
     if (mSceneNodeMissile != nullptr) {
         mSceneNodeMissile->remove();
     }
@@ -203,11 +232,7 @@ void Missile::Update(irr::f32 DeltaTime) {
         //if soundEngine is active report missile only as exploded
         //after explision sound was finished playing
         if (mParentLauncher->mParent->mRace->mSoundEngine->GetIsSoundActive()) {
-            if (mExplodeSound != nullptr) {
-                if (mExplodeSound->getStatus() == sf::SoundSource::Status::Stopped) {
-                    mExplodeSound = nullptr;
-                }
-            } else {
+            if (!mParentLauncher->mParent->mRace->mSoundEngine->IsSoundPlaying(mExplodeSound)) {
                 if (AreAllSmokeSpritesGone()) {
                    //mark that object (missile) can be deleted
                    objToBeDeleted = true;
@@ -256,6 +281,8 @@ void Missile::Update(irr::f32 DeltaTime) {
         if ((currentLocation - targetLocation).getLengthSQ() < 2.0f) {
             //we reached the target location
             //simply explode, let the missile disappear
+            RemoveFromVisGrid();
+
             mSceneNodeMissile->setVisible(false);
             mSceneNodeMissile->remove();
             mSceneNodeMissile = nullptr;
@@ -301,12 +328,16 @@ void Missile::Update(irr::f32 DeltaTime) {
 
         if (mEntry != nullptr) {
             currentLocation.Y =
-                    mParentLauncher->mParent->mRace->mLevelTerrain->pTerrainTiles[mEntry->get_X()][mEntry->get_Z()].currTileHeight + 0.3f;
+                    mParentLauncher->mParent->mRace->mLevelTerrain->mTileStore->GetTileHeight(mEntry->get_X(), mEntry->get_Z()) + 0.3f;
         }
 
         if (mSceneNodeMissile != nullptr) {
             mSceneNodeMissile->setPosition(currentLocation);
         }
+
+        if (mVisGridEntry != nullptr) {
+            mParentLauncher->mParent->mRace->mVisibilityGrid->UpdateEntity(mVisGridEntry, GetVisGridBox());
+        }
     }
 }
 
@@ -401,7 +432,7 @@ std::vector<irr::core::vector3df> MissileLauncher::GetMissileLaunchLocation(bool
     MapEntry* mEntry2 = nullptr;
 
     if (mEntry1 != nullptr) {
-        Loc1.Y = mParent->mRace->mLevelTerrain->pTerrainTiles[mEntry1->get_X()][mEntry1->get_Z()].currTileHeight + 0.3f;
+        Loc1.Y = mParent->mRace->mLevelTerrain->mTileStore->GetTileHeight(mEntry1->get_X(), mEntry1->get_Z()) + 0.3f;
     }
 
     result.push_back(Loc1);
@@ -412,7 +443,7 @@ std::vector<irr::core::vector3df> MissileLauncher::GetMissileLaunchLocation(bool
 
         mEntry2 = mParent->mRace->mLevelTerrain->GetMapEntry(current_cell_calc_x, current_cell_calc_y);
         if (mEntry2 != nullptr) {
-            Loc2.Y = mParent->mRace->mLevelTerrain->pTerrainTiles[mEntry2->get_X()][mEntry2->get_Z()].currTileHeight + 0.3f;
+            Loc2.Y = mParent->mRace->mLevelTerrain->mTileStore->GetTileHeight(mEntry2->get_X(), mEntry2->get_Z()) + 0.3f;
         }
 
          result.push_back(Loc2);
@@ -516,7 +547,7 @@ void MissileLauncher::Trigger() {
         shooting = true;
      }
 
-     if (mShotSound == nullptr) {
+     if (!mParent->mRace->mSoundEngine->IsSoundPlaying(mShotSound)) {
             mShotSound = mParent->mRace->mSoundEngine->PlaySound(SRES_GAME_MISSILE_SHOT, launchLoc.at(0), false);
      }
 }
@@ -547,12 +578,6 @@ void MissileLauncher::Update(irr::f32 DeltaTime) {
             (*it)->Update(DeltaTime);
         }
    }
-
-    if (mShotSound != nullptr) {
-        if (mShotSound->getStatus() == sf::SoundSource::Status::Stopped) {
-            mShotSound = nullptr;
-        }
-    }
 }
 
 MissileLauncher::MissileLauncher(Player* myParentPlayer, irr::scene::ISceneManager* smgr, irr::video::IVideoDriver *driver) {
@@ -13,6 +13,7 @@
 #include <irrlicht.h>
 #include <vector>
 #include <SFML/Audio.hpp>
+#include "../audio/voicealloc.h"
 
 /************************
  * Forward declarations *
@@ -20,6 +21,7 @@
 
 class Player;
 class MissileLauncher;
+struct VisGridEntryStruct;
 
 #define DEF_MISSILE_SPEED 20.0f
 #define DEF_MISSILE_SMOKEDIST 1.0f
@@ -31,6 +33,10 @@ class MissileLauncher;
 //enemy player
 #define DEF_MISSILE_DEALDAMAGE_DISTRANGE 4.0f
 
+//half size of the box around the flying missile
+//that is stored in the race visibility grid
+#define DEF_MISSILE_VISGRIDBOXSIZE 0.5f
+
 struct MissileSpriteStruct {
     irr::core::vector3d<irr::f32> mSpritePos;
     irr::video::ITexture* mSpriteTex = nullptr;
@@ -61,6 +67,10 @@ private:
 
     irr::scene::IBillboardSceneNode* mSceneNodeMissile = nullptr;
 
+    //entry of the flying missile inside the race visibility grid, the smoke
+    //sprites are not added, they are updated (and culled by Irrlicht) as before
+    VisGridEntryStruct* mVisGridEntry = nullptr;
+
     std::vector<MissileSpriteStruct*> mMissileSpriteVec;
 
     irr::f32 flightTime = 0.0f;
@@ -74,7 +84,7 @@ private:
     //by the player that shoot the missle initially
     Player* mLockedPlayer = nullptr;
 
-    sf::Sound* mExplodeSound = nullptr;
+    VoiceHandleStruct mExplodeSound;
     bool exploded = false;
 
     void UpdateSmokeSprites(irr::f32 DeltaTime);
@@ -83,6 +93,9 @@ private:
     bool AreAllSmokeSpritesGone();
     void CheckForHitOfMissileTrigger(irr::core::vector3df explodedAtLocation);
 
+    irr::core::aabbox3df GetVisGridBox();
+    void RemoveFromVisGrid();
+
 public:
     Missile(MissileLauncher* mParentLauncher, irr::core::vector3df launchLoc, irr::core::vector3df targetLoc, bool targetLocked, Player* lockedPlayer);
     ~Missile();
@@ -126,7 +139,7 @@ private:
     irr::f32 timeAccu = 0.0f;
     irr::f32 coolOffTime = 0.0f;
 
-    sf::Sound* mShotSound = nullptr;
+    VoiceHandleStruct mShotSound;
 };
 
 #endif // MISSILE_H
@@ -11,69 +11,11 @@
 #include "player.h"
 #include "../resources/texture.h"
 #include "../race.h"
-#include "spriteparticle.h"
+#include "../scenenodes/particlebatch.h"
 
- //***************************************************
-//*   SmokeParticle / SmokeTrail class              *
 //***************************************************
-
-void SmokeParticle::ResetParticle(irr::core::vector3df newStartLocation) {
-    //let particle restart
-    mParticlePos = newStartLocation;
-    mLifeTimeSec = lifeTimeSecParam;
-    mCurrParticleSize = mInitSize;
-
-    //I want a random number between 0.8f and 1.2f
-    int rNum = rand();
-    irr::f32 rNumFloat = 0.8f + (float(rNum) / float (RAND_MAX))  * 0.4f;
-
-    mSceneNode->setPosition(mParticlePos);
-    mSceneNode->setSize(mInitSize * rNumFloat);
-
-    ShowParticle();
-}
-
-//Update returns true if particle still has remaining lifetime
-//returns false if lifetime is over
-bool SmokeParticle::Update(irr::f32 frameDeltaTime, irr::core::vector3df newStartLocation) {
-   mLifeTimeSec -= frameDeltaTime;
-
-   if (mLifeTimeSec > 0.0f) {
-     //this particle has some time left
-     int rNum = rand();
-     irr::f32 rNumFloat = 0.8f + (float(rNum) / float (RAND_MAX)) * 0.4f;
-
-     mParticlePos.Y += 3.0f * rNumFloat * frameDeltaTime;
-
-     rNum = rand();
-     rNumFloat = (float(rNum - (RAND_MAX / 2)) / float (RAND_MAX));
-
-     mParticlePos.X += 0.7f * rNumFloat * frameDeltaTime;
-
-     rNum = rand();
-     rNumFloat = (float(rNum - (RAND_MAX / 2)) / float (RAND_MAX));
-
-     mParticlePos.Z += 0.7f * rNumFloat * frameDeltaTime;
-
-     //calculate new size depending on remaining particle lifetime
-     mCurrParticleSize = mInitSize + mEndLifeSize * (1.0f - (mLifeTimeSec / lifeTimeSecParam));
-
-     mSceneNode->setPosition(mParticlePos);
-     mSceneNode->setSize(mCurrParticleSize);
-
-   } else {
-       HideParticle();
-   }
-
-    SpriteParticle::Update(frameDeltaTime);
-
-    if (mLifeTimeSec > 0.0f)
-        return true;
-    else return false;
-}
-
-SmokeParticle::~SmokeParticle() {
-}
+//*   SmokeTrail class                              *
+//***************************************************
 
 SmokeTrail::SmokeTrail(irr::scene::ISceneManager* smgr, irr::video::IVideoDriver* driver, Player* parentPlayer,
                              irr::u32 nrMaxParticles) {
@@ -87,32 +29,18 @@ SmokeTrail::SmokeTrail(irr::scene::ISceneManager* smgr, irr::video::IVideoDriver
     //std::string spriteTexFile("extract/sprites/tmaps0013.png");
 
     mSmokeTex = parentPlayer->mRace->mTexLoader->spriteTex.at(13);
-    mSmokeTexSize = mSmokeTex->getSize();
 
-    mCurrSpriteVec = new std::vector<SmokeParticle*>();
+    //get my particle pool, smoke particles rise upwards
+    //and move randomly a little bit sideways
+    mParticlePool = mParentPlayer->mRace->mParticleBatch->CreatePool(mNrMaxParticles, mSmokeTex);
+    mParticlePool->mRiseSpeed = 3.0f;
+    mParticlePool->mJitterSpeedXZ = 0.7f;
 }
 
 SmokeTrail::~SmokeTrail() {
     //remove all currently existing particles
-    std::vector<SmokeParticle*>::iterator itParticle;
-
-    SmokeParticle* pntr;
-
-    if (mCurrSpriteVec->size() > 0) {
-
-        //delete all existing particles
-        itParticle = mCurrSpriteVec->begin();
-
-        while (itParticle != mCurrSpriteVec->end()) {
-           pntr = (*itParticle);
-           itParticle = mCurrSpriteVec->erase(itParticle);
-
-           //remove also particle itself
-           delete pntr;
-        }
-    }
-
-    delete mCurrSpriteVec;
+    mParentPlayer->mRace->mParticleBatch->RemovePool(mParticlePool);
+    mParticlePool = nullptr;
 }
 
 void SmokeTrail::Activate() {
@@ -134,123 +62,25 @@ void SmokeTrail::Update(irr::f32 frameDeltaTime) {
 
     absTimeSinceLastUpdate += frameDeltaTime;
 
-        //only update sprites every 0.01 seconds
-        if (absTimeSinceLastUpdate > 0.01) {
-
-            if (mActivated) {
-                    //we can create more particles
-                    if (mCurrNrParticels < mNrMaxParticles) {
-                       //old reusable particle left?
-                       std::vector<SmokeParticle*>::iterator it;
-                       SmokeParticle* pntr = nullptr;
-                       for (it = this->mCurrSpriteVec->begin(); it != this->mCurrSpriteVec->end(); it++) {
-                           if (!((*it)->mLifeTimeSec > 0.0f)) {
-                               pntr = (*it);
-                               break;
-                           }
-                       }
-
-                      if (pntr != nullptr) {
-                          pntr->ResetParticle(this->mParentPlayer->WorldCoordCraftSmokePnt);
-                      } else {
-                           //nothing available anymore, create a new particle
-                           SmokeParticle* newParticle = new SmokeParticle(mSmgr, mSmokeTex,
-                                     this->mParentPlayer->WorldCoordCraftSmokePnt, 0.6f,
-                                                                       irr::core::dimension2d<irr::f32>(0.2f, 0.2f), irr::core::dimension2d<irr::f32>(0.4f, 0.4f));
-
-                         //add new particle to my particle list
-                         this->mCurrSpriteVec->push_back(newParticle);
-                      }
-
-                      mCurrNrParticels++;
-                  }
-            }
+    //only update sprites every 0.01 seconds
+    if (absTimeSinceLastUpdate > 0.01) {
+        //update all currently existing particles
+        //particles without remaining lifetime are removed
+        mParticlePool->Update(absTimeSinceLastUpdate);
 
-          std::vector<SmokeParticle*>::iterator it;
-
-          //update all currently existing particles
-          for (it = mCurrSpriteVec->begin(); it != mCurrSpriteVec->end(); ++it) {
-              if (!(*it)->Update(absTimeSinceLastUpdate,
-                            this->mParentPlayer->WorldCoordCraftSmokePnt)) {
-                  //current particle stopped to exist (no lifetime anymore)
-                  if (mCurrNrParticels > 0) {
-                      mCurrNrParticels--;
-                  }
-              }
-          }
-
-            absTimeSinceLastUpdate = 0.0f;
-      }
+        //we can create more particles?
+        if (mActivated && (mParticlePool->GetNrActiveParticles() < mNrMaxParticles)) {
+            mParticlePool->Emit(this->mParentPlayer->WorldCoordCraftSmokePnt, 0.6f, 0.2f, 0.4f);
+        }
+
+        absTimeSinceLastUpdate = 0.0f;
+    }
 }
 
 //***************************************************
-//*   DustParticle / DustBelowCraft class           *
+//*   DustBelowCraft class                          *
 //***************************************************
 
-void DustParticle::ResetParticle(irr::core::vector3df newStartLocation) {
-    //let particle restart
-    mParticlePos = newStartLocation;
-    mLifeTimeSec = lifeTimeSecParam;
-    mCurrParticleSize = mInitSize;
-
-    //I want a random number between 0.8f and 1.2f
-    int rNum = rand();
-    irr::f32 rNumFloat = 0.8f + (float(rNum) / float (RAND_MAX))  * 0.4f;
-
-    mSceneNode->setPosition(mParticlePos);
-    mSceneNode->setSize(mInitSize * rNumFloat);
-
-    //unhide existing sceneNode of particles
-    //again
-    ShowParticle();
-}
-
-//Update returns true if particle still has remaining lifetime
-//returns false if lifetime is over
-bool DustParticle::Update(irr::f32 frameDeltaTime, irr::core::vector3df newStartLocation) {
-   mLifeTimeSec -= frameDeltaTime;
-
-   if (mLifeTimeSec > 0.0f) {
-     //this particle has some time left
-     int rNum = rand();
-     irr::f32 rNumFloat = 0.8f + (float(rNum) / float (RAND_MAX)) * 0.4f;
-
-     mParticlePos.Y += 0.03f * rNumFloat * frameDeltaTime;
-
-     rNum = rand();
-     rNumFloat = (float(rNum - (RAND_MAX / 2)) / float (RAND_MAX));
-
-     mParticlePos.X += 2.0f * rNumFloat * frameDeltaTime;
-
-     rNum = rand();
-     rNumFloat = (float(rNum - (RAND_MAX / 2)) / float (RAND_MAX));
-
-     mParticlePos.Z += 2.0f * rNumFloat * frameDeltaTime;
-
-     //calculate new size depending on remaining particle lifetime
-     mCurrParticleSize = mInitSize + mEndLifeSize * (1.0f - (mLifeTimeSec / lifeTimeSecParam));
-
-     mSceneNode->setPosition(mParticlePos);
-     mSceneNode->setSize(mCurrParticleSize);
-
-   } else {
-       if (!mIsReset) {
-        //this particles time is over
-        ResetParticle(newStartLocation);
-        mIsReset = true;
-       }
-   }
-
-    SpriteParticle::Update(frameDeltaTime);
-
-    if (mLifeTimeSec > 0.0f)
-        return true;
-    else return false;
-}
-
-DustParticle::~DustParticle() {
-}
-
 DustBelowCraft::DustBelowCraft(irr::scene::ISceneManager* smgr, irr::video::IVideoDriver* driver, Player* parentPlayer,
                              irr::u32 nrMaxParticles) {
     mSmgr = smgr;
@@ -261,39 +91,21 @@ DustBelowCraft::DustBelowCraft(irr::scene::ISceneManager* smgr, irr::video::IVid
 
     //get the cloud sprite from the game
     mDustTex = mParentPlayer->mRace->mTexLoader->spriteTex.at(17);
-    mDustTexSize = mDustTex->getSize();
 
-    mCurrSpriteVec = new std::vector<DustParticle*>();
+    mParticlePool = mParentPlayer->mRace->mParticleBatch->CreatePool(mNrMaxParticles, mDustTex);
+    mParticlePool->mRiseSpeed = 0.03f;
+    mParticlePool->mJitterSpeedXZ = 2.0f;
 }
 
 DustBelowCraft::~DustBelowCraft() {
     //remove all currently existing particles
-    std::vector<DustParticle*>::iterator itParticle;
-
-    DustParticle* pntr;
-
-    if (mCurrSpriteVec->size() > 0) {
-
-        //delete all existing particles
-        itParticle = mCurrSpriteVec->begin();
-
-        while (itParticle != mCurrSpriteVec->end()) {
-           pntr = (*itParticle);
-           itParticle = mCurrSpriteVec->erase(itParticle);
-
-           //remove also particle itself
-           delete pntr;
-        }
-    }
-
-    delete mCurrSpriteVec;
+    mParentPlayer->mRace->mParticleBatch->RemovePool(mParticlePool);
+    mParticlePool = nullptr;
 }
 
 void DustBelowCraft::Activate() {
     absTimeSinceLastActivation = 0.0f;
 
-    mCurrNrParticels = 0;
-
     mActivated = true;
     absTimeSinceLastUpdate = 0.0f;
 }
@@ -301,16 +113,11 @@ void DustBelowCraft::Activate() {
 void DustBelowCraft::Deactivate() {
     absTimeSinceLastActivation = 0.0f;
 
-    mCurrNrParticels = 0;
-
     mActivated = false;
     absTimeSinceLastUpdate = 0.0f;
 }
 
-void DustBelowCraft::SetupVelocityParticle(DustParticle* particlePntr) {
-    if (particlePntr == nullptr)
-        return;
-
+void DustBelowCraft::SetupVelocityParticle(irr::u32 particleIdx) {
     int rNum;
 
     //first get a random direction for velocity in X-Z plane, so that
@@ -351,7 +158,7 @@ void DustBelowCraft::SetupVelocityParticle(DustParticle* particlePntr) {
     finalVel.Z = initialVelocity.Z * 0.25f;
     finalVel.Y = initialVelocity.Y * 2.0f;
 
-    particlePntr->SetMovemenVelocity(initialVelocity, finalVel);
+    mParticlePool->SetMovementVelocity(particleIdx, initialVelocity, finalVel);
 }
 
 void DustBelowCraft::Update(irr::f32 frameDeltaTime) {
@@ -361,58 +168,20 @@ void DustBelowCraft::Update(irr::f32 frameDeltaTime) {
 
     //only update sprites every 0.01 seconds
     if (absTimeSinceLastUpdate > 0.01) {
-            //are we currently above dirt, and need to create more particles?
-            if (mActivated) {
-                    //we can create more particles
-                    if (mCurrNrParticels < mNrMaxParticles) {
-                       //old reusable particle left?
-                       std::vector<DustParticle*>::iterator it;
-                       DustParticle* pntr = nullptr;
-                       for (it = this->mCurrSpriteVec->begin(); it != this->mCurrSpriteVec->end(); it++) {
-                           if (!((*it)->mLifeTimeSec > 0.0f)) {
-                               pntr = (*it);
-                               break;
-                           }
-                       }
-
-                      if (pntr != nullptr) {
-                          pntr->mIsReset = false;
-
-                          //setup new particle velocities
-                          SetupVelocityParticle(pntr);
-
-                      } else {
-                           //nothing available anymore, create a new particle
-                           DustParticle* newParticle = new DustParticle(mSmgr, mDustTex,
-                                     this->mParentPlayer->WorldCraftDustPnt, DEF_DUSTPARTICLELIFETIME,
-                                                                       irr::core::dimension2d<irr::f32>(0.3f, 0.3f), irr::core::dimension2d<irr::f32>(0.4f, 0.4f));
-
-                           //setup new particle velocities
-                           SetupVelocityParticle(newParticle);
-
-                           //add new particle to my particle list
-                           this->mCurrSpriteVec->push_back(newParticle);
-                      }
-
-                      mCurrNrParticels++;
-                  }
-            }
+        //update all currently existing particles
+        //particles without remaining lifetime are removed
+        mParticlePool->Update(absTimeSinceLastUpdate);
 
-          std::vector<DustParticle*>::iterator it;
+        //are we currently above dirt, and need to create more particles?
+        if (mActivated && (mParticlePool->GetNrActiveParticles() < mNrMaxParticles)) {
+            irr::s32 newIdx = mParticlePool->Emit(this->mParentPlayer->WorldCraftDustPnt, DEF_DUSTPARTICLELIFETIME, 0.3f, 0.4f);
 
-          //update all currently existing particles
-          for (it = mCurrSpriteVec->begin(); it != mCurrSpriteVec->end(); ++it) {
-              if (!(*it)->Update(absTimeSinceLastUpdate,
-                            this->mParentPlayer->WorldCraftDustPnt)) {
-                  //current particle stopped to exist (no lifetime anymore)
-                  (*it)->HideParticle();
-                  if (mCurrNrParticels > 0) {
-                      mCurrNrParticels--;
-                  }
-              }
-          }
-
-            absTimeSinceLastUpdate = 0.0f;
-      }
+            if (newIdx >= 0) {
+                //setup new particle velocities
+                SetupVelocityParticle((irr::u32)(newIdx));
+            }
+        }
 
+        absTimeSinceLastUpdate = 0.0f;
+    }
 }
@@ -12,7 +12,6 @@
 
 #include <irrlicht.h>
 #include <vector>
-#include "spriteparticle.h"
 
 const irr::f32 DEF_DUSTPARTICLELIFETIME = 2.0f;  //0.5f before debugging, reset back to this value!
 
@@ -23,22 +22,7 @@ const irr::f32 DEF_DUSTPARTICLELIFETIME = 2.0f;  //0.5f before debugging, reset
 class Player;
 class Race;
 class EntityItem;
-
-class SmokeParticle: public SpriteParticle {
-public:
-    SmokeParticle(irr::scene::ISceneManager* smgr, irr::video::ITexture* spriteTex, irr::core::vector3d<irr::f32> startLocation,
-                  irr::f32 lifeTimeSec, irr::core::dimension2d<irr::f32> initSize, irr::core::dimension2d<irr::f32> endLifeSize) :
-        SpriteParticle(smgr, spriteTex, startLocation, lifeTimeSec, initSize, endLifeSize) {
-    }
-
-    ~SmokeParticle();
-
-    //Update returns true if particle still has remaining lifetime
-    //returns false if lifetime is over
-    bool Update(irr::f32 frameDeltaTime, irr::core::vector3df newStartLocation);
-
-    void ResetParticle(irr::core::vector3df newStartLocation);
-};
+class ParticlePool;
 
 class SmokeTrail {
 public:
@@ -52,43 +36,23 @@ public:
     void Deactivate();
 
 private:
-    bool mVisible;
     bool mActivated = false;
 
     Player* mParentPlayer = nullptr;
 
     irr::video::ITexture* mSmokeTex = nullptr;
-    irr::core::dimension2d<irr::u32> mSmokeTexSize;
 
     irr::scene::ISceneManager* mSmgr = nullptr;
     irr::video::IVideoDriver* mDriver = nullptr;
 
     irr::u32 mNrMaxParticles;
-    irr::u32 mCurrNrParticels = 0;
 
     irr::f32 absTimeSinceLastActivation;
     irr::f32 absTimeSinceLastUpdate = 0.0f;
 
-    std::vector<SmokeParticle*>* mCurrSpriteVec = nullptr;
-
-    void CreateParticle() {
-    }
-};
-
-class DustParticle: public SpriteParticle {
-public:
-    DustParticle(irr::scene::ISceneManager* smgr, irr::video::ITexture* spriteTex, irr::core::vector3d<irr::f32> startLocation,
-                  irr::f32 lifeTimeSec, irr::core::dimension2d<irr::f32> initSize, irr::core::dimension2d<irr::f32> endLifeSize) :
-        SpriteParticle(smgr, spriteTex, startLocation, lifeTimeSec, initSize, endLifeSize) {
-    }
-
-    ~DustParticle();
-
-    //Update returns true if particle still has remaining lifetime
-    //returns false if lifetime is over
-    bool Update(irr::f32 frameDeltaTime, irr::core::vector3df newStartLocation);
-
-    void ResetParticle(irr::core::vector3df newStartLocation);
+    //all my particles are stored in this pool, which is
+    //rendered by the particle batch scene node of the race
+    ParticlePool* mParticlePool = nullptr;
 };
 
 class DustBelowCraft {
@@ -103,26 +67,23 @@ public:
     void Deactivate();
 
 private:
-    bool mVisible;
     bool mActivated = false;
 
     Player* mParentPlayer = nullptr;
 
     irr::video::ITexture* mDustTex = nullptr;
-    irr::core::dimension2d<irr::u32> mDustTexSize;
 
     irr::scene::ISceneManager* mSmgr = nullptr;
     irr::video::IVideoDriver* mDriver = nullptr;
 
     irr::u32 mNrMaxParticles;
-    irr::u32 mCurrNrParticels = 0;
 
     irr::f32 absTimeSinceLastActivation;
     irr::f32 absTimeSinceLastUpdate = 0.0f;
 
-    std::vector<DustParticle*>* mCurrSpriteVec = nullptr;
+    ParticlePool* mParticlePool = nullptr;
 
-    void SetupVelocityParticle(DustParticle* particlePntr);
+    void SetupVelocityParticle(irr::u32 particleIdx);
 };
 
 #endif // PARTICLE_H
@@ -419,7 +419,7 @@ irr::u32 Player::GetCurrentState() {
     return this->mPlayerStats->mPlayerCurrentState;
 }
 
-Player::Player(Race* race, std::string model, irr::core::vector3d<irr::f32> NewPosition,
+Player::Player(Race* race, std::string model, irr::video::ITexture* colorSchemeTex, irr::core::vector3d<irr::f32> NewPosition,
                irr::core::vector3d<irr::f32> NewFrontAt,
                irr::u8 nrLaps, bool humanPlayer) {
 
@@ -470,6 +470,12 @@ Player::Player(Race* race, std::string model, irr::core::vector3d<irr::f32> NewP
     PlayerMesh = mRace->mGame->mSmgr->getMesh(model.c_str());
     Player_node = mRace->mGame->mSmgr->addMeshSceneNode(PlayerMesh);
 
+    //the crafts of all color schemes can share the same mesh,
+    //then only the texture is different
+    if (colorSchemeTex != nullptr) {
+        Player_node->setMaterialTexture(0, colorSchemeTex);
+    }
+
     //set player model initial orientation and position, later player craft is only moved by physics engine
     //also current change in Rotation of player craft model compared with this initial orientation is controlled by a
     //quaterion inside the physics engine object for this player craft as well
@@ -1579,19 +1585,13 @@ void Player::StopRecordingHeightMapCollisionDbgData(char* outputDbgFileName) {
 
 void Player::Collided() {
     if (mHumanPlayer) {
-           if (CollisionSound == nullptr) {
+           if (!mRace->mSoundEngine->IsSoundPlaying(CollisionSound)) {
               CollisionSound = mRace->mSoundEngine->PlaySound(SRES_GAME_COLLISION, this->phobj->physicState.position, false);
            }
     }
 }
 
 void Player::AfterPhysicsUpdate() {
-    if (CollisionSound != nullptr) {
-        if (CollisionSound->getStatus() == sf::SoundSource::Status::Stopped) {
-            CollisionSound = nullptr;
-        }
-    }
-
     if (this->phobj->CollidedOtherObjectLastTime) {
         Collided();
     }
@@ -1742,10 +1742,7 @@ void Player::IsSpaceDown(bool down, irr::f32 deltaTime) {
                //we reached max turbo level
                //make sure turbo sound is stopped
                //TurboSound->stop();
-               if (TurboSound != nullptr) {
-                   TurboSound->stop();
-                   TurboSound = nullptr;
-               }
+               mRace->mSoundEngine->StopSound(TurboSound);
 
                MaxTurboReached();
            }
@@ -1755,10 +1752,7 @@ void Player::IsSpaceDown(bool down, irr::f32 deltaTime) {
                     //space key was released
                     //make sure turbo sound is stopped
                     //TurboSound->stop();
-                    if (TurboSound != nullptr) {
-                        TurboSound->stop();
-                        TurboSound = nullptr;
-                    }
+                    mRace->mSoundEngine->StopSound(TurboSound);
 
                     //if space key is released the booster sound is played as well
                     mRace->mSoundEngine->PlaySound(SRES_GAME_BOOSTER, false);
@@ -2956,22 +2950,22 @@ void Player::CheckForChargingStation(irr::f32 deltaTime) {
     if (atCharger) {
          if (mPlayerCurrentlyCharging == false) {
                 mPlayerCurrentlyCharging = true;
+         }
 
-                //play sound
-                if (this->mHumanPlayer) {
-                    //we need to keep a pntr to the looping sound source to be able to stop it
-                    //later again!
-                    mChargingSoundSource = this->mRace->mSoundEngine->PlaySound(SRES_GAME_REFUEL, true);
-                }
-        }
+         //play sound, and play it again if its sound source
+         //was stolen for a more important sound
+         if (this->mHumanPlayer && !this->mRace->mSoundEngine->IsSoundPlaying(mChargingSoundSource)) {
+                //we need to keep the handle of the looping sound to be able to stop it
+                //later again!
+                mChargingSoundSource = this->mRace->mSoundEngine->PlaySound(SRES_GAME_REFUEL, true);
+         }
     } else {
         if (mPlayerCurrentlyCharging == true) {
                mPlayerCurrentlyCharging = false;
 
                //stop playing sound from looping sound source
                if (this->mHumanPlayer) {
-                   this->mRace->mSoundEngine->StopLoopingSound(mChargingSoundSource);
-                   mChargingSoundSource = nullptr;
+                   this->mRace->mSoundEngine->StopSound(mChargingSoundSource);
                }
        }
 
@@ -2980,40 +2974,35 @@ void Player::CheckForChargingStation(irr::f32 deltaTime) {
 
 void Player::StartPlayingWarningSound() {
    //already warning playing?
-   if (mWarningSoundSource == nullptr) {
+   if (!this->mRace->mSoundEngine->IsSoundPlaying(mWarningSoundSource)) {
        //no, start playing new warning
-       //we need to keep a pntr to the looping sound source to be able to stop it
+       //we need to keep the handle of the looping sound to be able to stop it
        //later again!
        mWarningSoundSource = this->mRace->mSoundEngine->PlaySound(SRES_GAME_WARNING, true);
    }
 }
 
 void Player::StopPlayingWarningSound() {
-   //warning really playing?
-   if (mWarningSoundSource != nullptr) {
-       //yes, stop it
-       this->mRace->mSoundEngine->StopLoopingSound(mWarningSoundSource);
-       mWarningSoundSource = nullptr;
-   }
+   //stop the warning, does nothing if it
+   //is not playing anymore
+   this->mRace->mSoundEngine->StopSound(mWarningSoundSource);
 }
 
 void Player::StartPlayingLockOnSound() {
-   //already lockon sound playing?
-   if (mLockOnSoundSource == nullptr) {
+   //already lockon sound playing? (it is started again if its
+   //sound source was stolen for another sound)
+   if (!this->mRace->mSoundEngine->IsSoundPlaying(mLockOnSoundSource)) {
        //no, start playing new lockon sound
-       //we need to keep a pntr to the looping sound source to be able to stop it
+       //we need to keep the handle of the looping sound to be able to stop it
        //later again!
         mLockOnSoundSource = this->mRace->mSoundEngine->PlaySound(SRES_GAME_LOCKON, true);
    }
 }
 
 void Player::StopPlayingLockOnSound() {
-   //lock on sound really playing?
-   if (mLockOnSoundSource != nullptr) {
-       //yes, stop it
-         this->mRace->mSoundEngine->StopLoopingSound(mLockOnSoundSource);
-         mLockOnSoundSource = nullptr;
-   }
+   //stop the lock on sound, does nothing
+   //if it is not playing anymore
+   this->mRace->mSoundEngine->StopSound(mLockOnSoundSource);
 }
 
 void Player::AddTextureID(irr::s32 newTexId) {
@@ -11,6 +11,7 @@
 #define PLAYER_H
 
 #include "SFML/Audio.hpp"
+#include "../audio/voicealloc.h"
 #include <list>
 #include <vector>
 #include "irrlicht.h"
@@ -222,8 +223,10 @@ struct HudDisplayPart; //Forward declaration
 
 class Player {
 public:
-    Player(Race* race, std::string model, irr::core::vector3d<irr::f32> NewPosition, irr::core::vector3d<irr::f32> NewFrontAt,
-           irr::u8 nrLaps, bool humanPlayer);
+    //colorSchemeTex is set for the craft scene node, nullptr
+    //means the model is used with its own texture
+    Player(Race* race, std::string model, irr::video::ITexture* colorSchemeTex, irr::core::vector3d<irr::f32> NewPosition,
+           irr::core::vector3d<irr::f32> NewFrontAt, irr::u8 nrLaps, bool humanPlayer);
     ~Player();
 
     void SetPlayerObject(PhysicsObject* phObjPtr);
@@ -546,7 +549,7 @@ public:
     bool mBoosterActive = false;
     bool mBoosterRechargeCurrentlyLocked = false;
     bool mLastBoosterActive = false;
-    sf::Sound* TurboSound = nullptr;
+    VoiceHandleStruct TurboSound;
 
     void IsSpaceDown(bool down, irr::f32 deltaTime);
     void MaxTurboReached();
@@ -557,7 +560,7 @@ public:
 
     void Collided();
     void AfterPhysicsUpdate();
-    sf::Sound* CollisionSound = nullptr;
+    VoiceHandleStruct CollisionSound;
 
     MachineGun* mMGun = nullptr;
     MissileLauncher* mMissileLauncher = nullptr;
@@ -733,9 +736,9 @@ private:
     bool mBlockAdditionalAmmoFullMsg = false;
 
     bool mPlayerCurrentlyCharging = false;
-    sf::Sound* mChargingSoundSource = nullptr;
-    sf::Sound* mWarningSoundSource = nullptr;
-    sf::Sound* mLockOnSoundSource = nullptr;
+    VoiceHandleStruct mChargingSoundSource;
+    VoiceHandleStruct mWarningSoundSource;
+    VoiceHandleStruct mLockOnSoundSource;
     
     //each player has a particle system for the
     //case the craft is heavily damager
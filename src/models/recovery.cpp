@@ -36,7 +36,7 @@ Recovery::Recovery(Race* race, irr::f32 x, irr::f32 y, irr::f32 z, irr::scene::I
     //remember the starting position, we need it later
     mStartingPosition = mPosition;
 
-    RecoveryMesh = smgr->getMesh("extract/models/recov0-0.obj");
+    RecoveryMesh = smgr->getMesh("extract/models/recov0-0.hmesh");
     Recovery_node = smgr->addMeshSceneNode(RecoveryMesh);
 
     Recovery_node->setScale(irr::core::vector3d<irr::f32>(1,1,1));
@@ -36,6 +36,7 @@ const irr::f32 RECOVERY_VEHICLE_ACCELDEACCELRATE = 0.1f;
 class Player;
 struct WayPointLinkInfoStruct;
 class Race;
+struct VisGridEntryStruct;
 
 class Recovery {
 public:
@@ -52,6 +53,9 @@ public:
 
     irr::scene::IMeshSceneNode* Recovery_node = nullptr;
 
+    //entry of this recovery vehicle inside the race visibility grid
+    VisGridEntryStruct* mVisGridEntry = nullptr;
+
 private:
     //my current position I am at
     irr::core::vector3df mPosition;
@@ -9,81 +9,18 @@
 
 #include "steamfountain.h"
 #include "../resources/texture.h"
-#include "spriteparticle.h"
+#include "../scenenodes/particlebatch.h"
 
 //***************************************************
-//*   SteamParticle / SteamFountain class           *
+//*   SteamFountain class                           *
 //***************************************************
 
-void SteamParticle::ResetParticle() {
-    //let particle restart
-    mParticlePos = startLocationParam;
-    mLifeTimeSec = lifeTimeSecParam;
-    mCurrParticleSize = mInitSize;
-
-    //I want a random number between 0.8f and 1.2f
-    int rNum = rand();
-    irr::f32 rNumFloat = 0.8f + (float(rNum) / float (RAND_MAX))  * 0.4f;
-
-    mSceneNode->setPosition(mParticlePos);
-    mSceneNode->setSize(mInitSize * rNumFloat);
-
-   //show particle again
-   ShowParticle();
-}
-
-//Update returns true if particle still has remaining lifetime
-//returns false if lifetime is over
-bool SteamParticle::Update(irr::f32 frameDeltaTime) {
-   mLifeTimeSec -= frameDeltaTime;
-
-   if (mLifeTimeSec > 0.0f) {
-     //this particle has some time left
-     int rNum = rand();
-     irr::f32 rNumFloat = 0.8f + (float(rNum) / float (RAND_MAX)) * 0.4f;
-
-     mParticlePos.Y += 3.0f * rNumFloat * frameDeltaTime;
-
-     rNum = rand();
-     rNumFloat = (float(rNum - (RAND_MAX / 2)) / float (RAND_MAX));
-
-     mParticlePos.X += 0.4f * rNumFloat * frameDeltaTime;
-
-     rNum = rand();
-     rNumFloat = (float(rNum - (RAND_MAX / 2)) / float (RAND_MAX));
-
-     mParticlePos.Z += 0.4f * rNumFloat * frameDeltaTime;
-
-     //calculate new size depending on remaining particle lifetime
-     mCurrParticleSize = mInitSize + mEndLifeSize * (1.0f - (mLifeTimeSec / lifeTimeSecParam));
-
-     mSceneNode->setPosition(mParticlePos);
-     mSceneNode->setSize(mCurrParticleSize);
-
-   } else {
-       //this particles time is over
-       ResetParticle();
-   }
-
-   SpriteParticle::Update(frameDeltaTime);
-
-   if (mLifeTimeSec > 0.0f)
-       return true;
-   else return false;
-}
-
-SteamParticle::~SteamParticle() {
-}
-
 //only used by the level Editor
 void SteamFountain::Hide() {
     mActivated = false;
 
-    std::vector<SteamParticle*>::iterator itParticle;
-
-    for (itParticle = mCurrSpriteVec->begin(); itParticle != mCurrSpriteVec->end(); ++itParticle) {
-        (*itParticle)->HideParticle();
-    }
+    //remove all currently existing particles
+    mParticlePool->Clear();
 }
 
 //only used by the level Editor
@@ -95,49 +32,40 @@ bool SteamFountain::IsActivated() {
     return mActivated;
 }
 
-SteamFountain::SteamFountain(irr::video::ITexture* steamTex, EntityItem* entityItem, irr::scene::ISceneManager* smgr, irr::video::IVideoDriver* driver, irr::core::vector3d<irr::f32> location,
+void SteamFountain::SetInView(bool inView) {
+    mInView = inView;
+    mParticlePool->mVisible = inView;
+}
+
+SteamFountain::SteamFountain(irr::video::ITexture* steamTex, EntityItem* entityItem, ParticleBatchSceneNode* particleBatch,
+                             irr::scene::ISceneManager* smgr, irr::video::IVideoDriver* driver, irr::core::vector3d<irr::f32> location,
                              irr::u32 nrMaxParticles) {
     mSmgr = smgr;
     mDriver = driver;
+    mParticleBatch = particleBatch;
     
     mPosition = location;
     mNrMaxParticles = nrMaxParticles;
     mEntityItem = entityItem;
 
     mSteamTex = steamTex;
-    mSteamTexSize = mSteamTex->getSize();
 
-    mCurrSpriteVec = new std::vector<SteamParticle*>();
+    //steam particles rise upwards quickly, and move
+    //randomly a little bit sideways
+    mParticlePool = mParticleBatch->CreatePool(mNrMaxParticles, mSteamTex);
+    mParticlePool->mRiseSpeed = 3.0f;
+    mParticlePool->mJitterSpeedXZ = 0.4f;
 }
 
 SteamFountain::~SteamFountain() {
     //remove all currently existing particles
-    std::vector<SteamParticle*>::iterator itParticle;
-
-    SteamParticle* pntr;
-
-    if (mCurrSpriteVec->size() > 0) {
-
-        //delete all existing particles
-        itParticle = mCurrSpriteVec->begin();
-
-        while (itParticle != mCurrSpriteVec->end()) {
-           pntr = (*itParticle);
-           itParticle = mCurrSpriteVec->erase(itParticle);
-
-           //remove also particle itself
-           delete pntr;
-        }
-    }
-
-    delete mCurrSpriteVec;
+    mParticleBatch->RemovePool(mParticlePool);
+    mParticlePool = nullptr;
 }
 
 void SteamFountain::Activate() {
     absTimeSinceLastActivation = 0.0f;
 
-    mCurrNrParticels = 0;
-
     mActivated = true;
     absTimeSinceLastUpdate = 0.0f;
 }
@@ -151,32 +79,25 @@ void SteamFountain::Trigger() {
 void SteamFountain::TriggerUpdate(irr::f32 frameDeltaTime) {
     absTimeSinceLastActivation += frameDeltaTime;
 
-    if (mActivated) {
+    //nobody can see the steam right now, keep the current particles
+    //frozen until the fountain comes into view again
+    if (mActivated && mInView) {
         absTimeSinceLastUpdate += frameDeltaTime;
 
         //only update sprites every 10 mSeconds
         if (absTimeSinceLastUpdate > 0.01) {
 
-            //we can create more particles
-            if (mCurrNrParticels < mNrMaxParticles) {
-              SteamParticle* newParticle = new SteamParticle(mSmgr, mSteamTex, mPosition, 1.2f,
-                                                               irr::core::dimension2d<irr::f32>(0.1f, 0.1f), irr::core::dimension2d<irr::f32>(0.4f, 0.4f));
-
-              //add new particle to my particle list
-              this->mCurrSpriteVec->push_back(newParticle);
+            //update all currently existing particles, particles
+            //at the end of their lifetime are removed, and are
+            //replaced by new particles at the fountain location
+            mParticlePool->Update(absTimeSinceLastUpdate);
 
-              mCurrNrParticels++;
-          }
-
-          std::vector<SteamParticle*>::iterator it;
-
-          //update all currently existing particles
-          for (it = mCurrSpriteVec->begin(); it != mCurrSpriteVec->end(); ++it) {
-              (*it)->Update(absTimeSinceLastUpdate);
-          }
+            //we can create more particles
+            if (mParticlePool->GetNrActiveParticles() < mNrMaxParticles) {
+                mParticlePool->Emit(mPosition, 1.2f, 0.1f, 0.4f);
+            }
 
             absTimeSinceLastUpdate = 0.0f;
       }
     }
 }
-
@@ -12,32 +12,20 @@
 
 #include <irrlicht.h>
 #include <vector>
-#include "spriteparticle.h"
 
 /************************
  * Forward declarations *
  ************************/
 
 class EntityItem;
-
-class SteamParticle: public SpriteParticle {
-public:
-    SteamParticle(irr::scene::ISceneManager* smgr, irr::video::ITexture* spriteTex, irr::core::vector3d<irr::f32> startLocation,
-                  irr::f32 lifeTimeSec, irr::core::dimension2d<irr::f32> initSize, irr::core::dimension2d<irr::f32> endLifeSize) :
-        SpriteParticle(smgr, spriteTex, startLocation, lifeTimeSec, initSize, endLifeSize) {
-    }
-
-    ~SteamParticle();
-
-    //Update returns true if particle still has remaining lifetime
-    //returns false if lifetime is over
-    bool Update(irr::f32 frameDeltaTime);
-    void ResetParticle();
-};
+class ParticleBatchSceneNode;
+class ParticlePool;
+struct VisGridEntryStruct;
 
 class SteamFountain {
 public:
-    SteamFountain(irr::video::ITexture* steamTex, EntityItem* entityItem, irr::scene::ISceneManager* smgr, irr::video::IVideoDriver* driver, irr::core::vector3d<irr::f32> location,
+    SteamFountain(irr::video::ITexture* steamTex, EntityItem* entityItem, ParticleBatchSceneNode* particleBatch,
+                  irr::scene::ISceneManager* smgr, irr::video::IVideoDriver* driver, irr::core::vector3d<irr::f32> location,
                   irr::u32 nrMaxParticles);
 
     ~SteamFountain();
@@ -56,24 +44,33 @@ public:
 
     bool IsActivated();
 
+    //if the fountain is outside of the camera view
+    //the steam particles are neither updated nor drawn
+    void SetInView(bool inView);
+
+    //entry of this fountain inside the race visibility grid
+    VisGridEntryStruct* mVisGridEntry = nullptr;
+
 private:
+    bool mInView = true;
+
     irr::core::vector3d<irr::f32> mPosition;
-    bool mVisible;
     bool mActivated = false;
 
     irr::video::ITexture* mSteamTex = nullptr;
-    irr::core::dimension2d<irr::u32> mSteamTexSize;
 
     irr::scene::ISceneManager* mSmgr = nullptr;
     irr::video::IVideoDriver* mDriver = nullptr;
 
     irr::u32 mNrMaxParticles;
-    irr::u32 mCurrNrParticels = 0;
 
     irr::f32 absTimeSinceLastActivation;
     irr::f32 absTimeSinceLastUpdate = 0.0f;
 
-    std::vector<SteamParticle*>* mCurrSpriteVec = nullptr;
+    //the particles of this fountain are rendered
+    //by this particle batch scene node
+    ParticleBatchSceneNode* mParticleBatch = nullptr;
+    ParticlePool* mParticlePool = nullptr;
 };
 
 #endif // STEAMFOUNTAIN_H
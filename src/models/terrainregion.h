@@ -0,0 +1,187 @@
+/*
+ Copyright (C) 2026 Wolf Alexander
+
+ This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.                                          */
+
+#ifndef TERRAINREGION_H
+#define TERRAINREGION_H
+
+#include "irrlicht.h"
+#include "terraintilestore.h"
+#include <vector>
+
+//Calculation of the terrain vertice normals and illumination colors for a rectangle of tiles.
+//The functions do not need the terrain mesh or the Irrlicht device, the caller hands over
+//where the results of each tile go (assignTile); This way LevelTerrain can use them during
+//the game, and test-terrainregion can compare a region update with a full update.
+//assignTile is called as assignTile(x, z, vert1Value, vert2Value, vert3Value, vert4Value)
+
+//clamps the tile rectangle (xMax and zMax are included) to the map,
+//returns false if no tile of the rectangle is inside the map
+inline bool ClampTerrainRegion(int width, int height, int& xMin, int& zMin, int& xMax, int& zMax) {
+    if (xMin < 0) xMin = 0;
+    if (zMin < 0) zMin = 0;
+    if (xMax > width - 1) xMax = width - 1;
+    if (zMax > height - 1) zMax = height - 1;
+
+    return ((xMin <= xMax) && (zMin <= zMax));
+}
+
+//returns the vertice normal at the tile corner (x, z), is calculated
+//from the current vertice 1 heights of the tile and its direct neighbors
+inline irr::core::vector3df ComputeTerrainCornerNormal(TerrainTileStore* tileStore, irr::s32 x, irr::s32 z,
+                                                       irr::f32 intensity) {
+    int width = tileStore->GetWidth();
+    int height = tileStore->GetHeight();
+
+    if (x < 0 || x > width - 1 || z < 0 || z > height - 1)
+        return irr::core::vector3df(0.0f, 1.0f, 0.0f);
+
+    irr::f32 h = tileStore->GetVertexHeight(x, z, 1);
+
+    irr::f32 a = z - 1 >= 0 ? tileStore->GetVertexHeight(x, z - 1, 1) : h;
+    irr::f32 b = x + 1 < width ? tileStore->GetVertexHeight(x + 1, z, 1) : h;
+    irr::f32 c = z + 1 < height ? tileStore->GetVertexHeight(x, z + 1, 1) : h;
+    irr::f32 d = x - 1 >= 0 ? tileStore->GetVertexHeight(x - 1, z, 1) : h;
+
+    //this function is called very often during morphs, therefore
+    //do not allocate the helper vectors on the heap
+    irr::core::vector3df nA(0.0f, a - h, -intensity);
+    irr::core::vector3df nB(intensity, b - h, 0.0f);
+    irr::core::vector3df nC(0.0f, c - h, intensity);
+    irr::core::vector3df nD(-intensity, d - h, 0.0f);
+
+    irr::core::vector3df normal = 0.25f * (nA.crossProduct(nB) + nB.crossProduct(nC) + nC.crossProduct(nD) + nD.crossProduct(nA));
+    normal.normalize();
+
+    return normal;
+}
+
+//Calculates the vertice normals of all tiles inside the specified tile rectangle (xMax and zMax
+//are included). A tile corner is shared by up to 4 tiles, therefore each corner normal is only
+//calculated once here, and then handed over to all tiles that use it. The result is exactly the
+//same as calculating the 4 corner normals for each tile seperately
+template <typename AssignFunc>
+void CalcTerrainNormalsRegion(TerrainTileStore* tileStore, int xMin, int zMin, int xMax, int zMax, AssignFunc assignTile) {
+    if (!ClampTerrainRegion(tileStore->GetWidth(), tileStore->GetHeight(), xMin, zMin, xMax, zMax))
+        return;
+
+    //number of tile corners in x direction
+    int nrCornersX = xMax - xMin + 2;
+
+    //corner normals of the upper and lower corner row
+    //of the current tile row
+    std::vector<irr::core::vector3df> normalRowUpper(nrCornersX);
+    std::vector<irr::core::vector3df> normalRowLower(nrCornersX);
+
+    for (int idx = 0; idx < nrCornersX; idx++) {
+        normalRowUpper[idx] = ComputeTerrainCornerNormal(tileStore, xMin + idx, zMin, 1.0f);
+    }
+
+    for (int z = zMin; z <= zMax; z++) {
+        for (int idx = 0; idx < nrCornersX; idx++) {
+            normalRowLower[idx] = ComputeTerrainCornerNormal(tileStore, xMin + idx, z + 1, 1.0f);
+        }
+
+        for (int x = xMin; x <= xMax; x++) {
+            assignTile(x, z, normalRowUpper[x - xMin], normalRowUpper[x - xMin + 1],
+                       normalRowLower[x - xMin + 1], normalRowLower[x - xMin]);
+        }
+
+        //lower corner row of this tile row is the upper
+        //corner row of the next tile row
+        normalRowUpper.swap(normalRowLower);
+    }
+}
+
+//Calculates the illumination vertex colors for all tiles inside the specified tile rectangle
+//(xMax and zMax are included) of a map with width x height map entries.
+//getIllumination(x, z) returns the illumination value of a map entry, it is only called with
+//coordinates inside of the map; Coordinates outside of the map are clamped to the closest valid
+//map entry. calcColor(int16_t illuminationValue) returns the vertex color for an illumination value.
+//The illumination value of a tile corner is the average of the 4 map entries that share this
+//corner. Because each corner is also shared by up to 4 tiles, we first calculate the average (and
+//the resulting vertex color) only once for each corner of a whole corner row, and then assign the
+//colors to the tiles afterwards. The inner loop only works on plain integer arrays, so that the
+//compiler is able to vectorize it
+template <typename IlluminationFunc, typename ColorFunc, typename AssignFunc>
+void CalcTerrainIlluminationRegion(int width, int height, int xMin, int zMin, int xMax, int zMax,
+                                   IlluminationFunc getIllumination, ColorFunc calcColor, AssignFunc assignTile) {
+    if (!ClampTerrainRegion(width, height, xMin, zMin, xMax, zMax))
+        return;
+
+    //number of tile corners in x direction
+    int nrCornersX = xMax - xMin + 2;
+
+    //illumination values of the two map entry rows above and below
+    //of the current corner row; corner idx is located between map entry idx
+    //and idx + 1 of these rows (map entry 0 is at x coordinate xMin - 1)
+    std::vector<irr::s32> entryRowUpper(nrCornersX + 1);
+    std::vector<irr::s32> entryRowLower(nrCornersX + 1);
+
+    //summed up illumination values of the 4 map entries around each corner
+    std::vector<irr::s32> cornerSum(nrCornersX);
+
+    //resulting vertex colors of the upper and lower corner row
+    //of the current tile row
+    std::vector<irr::video::SColor> colorRowUpper(nrCornersX);
+    std::vector<irr::video::SColor> colorRowLower(nrCornersX);
+
+    //fills an entry row, clamped to the map
+    auto readEntryRow = [&](std::vector<irr::s32>& entryRow, int z) {
+        if (z < 0) z = 0;
+        if (z > height - 1) z = height - 1;
+
+        for (int idx = 0; idx <= nrCornersX; idx++) {
+            int x = xMin - 1 + idx;
+
+            if (x < 0) x = 0;
+            if (x > width - 1) x = width - 1;
+
+            entryRow[idx] = (irr::s32)(getIllumination(x, z));
+        }
+    };
+
+    readEntryRow(entryRowLower, zMin - 1);
+
+    //corner row zCorner is located between map entry row
+    //zCorner - 1 and zCorner
+    for (int zCorner = zMin; zCorner <= zMax + 1; zCorner++) {
+        //the lower entry row of the last corner row is the upper
+        //entry row of this corner row
+        entryRowUpper.swap(entryRowLower);
+
+        readEntryRow(entryRowLower, zCorner);
+
+        const irr::s32* upper = entryRowUpper.data();
+        const irr::s32* lower = entryRowLower.data();
+        irr::s32* sum = cornerSum.data();
+
+        for (int idx = 0; idx < nrCornersX; idx++) {
+            sum[idx] = upper[idx] + upper[idx + 1] + lower[idx] + lower[idx + 1];
+        }
+
+        for (int idx = 0; idx < nrCornersX; idx++) {
+            colorRowLower[idx] = calcColor((int16_t)(cornerSum[idx] / 4));
+        }
+
+        //we need two corner rows before we can
+        //assign colors to a tile row
+        if (zCorner > zMin) {
+            int z = zCorner - 1;
+
+            for (int x = xMin; x <= xMax; x++) {
+                assignTile(x, z, colorRowUpper[x - xMin], colorRowUpper[x - xMin + 1],
+                           colorRowLower[x - xMin + 1], colorRowLower[x - xMin]);
+            }
+        }
+
+        colorRowUpper.swap(colorRowLower);
+    }
+}
+
+#endif // TERRAINREGION_H
@@ -0,0 +1,44 @@
+/*
+ Copyright (C) 2026 Wolf Alexander
+
+ This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.                                          */
+
+#include "terraintilestore.h"
+#include <algorithm>
+
+TerrainTileStore::TerrainTileStore(irr::s32 width, irr::s32 height) {
+    mWidth = width;
+    mHeight = height;
+
+    size_t nrTiles = (size_t)(mWidth) * (size_t)(mHeight);
+
+    mVertexHeight.resize(nrTiles * 4);
+    mTileHeight.resize(nrTiles);
+    mFlags.resize(nrTiles);
+
+    Reset();
+}
+
+TerrainTileStore::~TerrainTileStore() {
+    mVertexHeight.clear();
+    mTileHeight.clear();
+    mFlags.clear();
+}
+
+void TerrainTileStore::Reset() {
+    std::fill(mVertexHeight.begin(), mVertexHeight.end(), 0.0f);
+    std::fill(mTileHeight.begin(), mTileHeight.end(), 0.0f);
+    std::fill(mFlags.begin(), mFlags.end(), 0);
+}
+
+irr::s32 TerrainTileStore::GetWidth() {
+    return mWidth;
+}
+
+irr::s32 TerrainTileStore::GetHeight() {
+    return mHeight;
+}
@@ -0,0 +1,98 @@
+/*
+ Copyright (C) 2026 Wolf Alexander
+
+ This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.                                          */
+
+#ifndef TERRAINTILESTORE_H
+#define TERRAINTILESTORE_H
+
+#include "irrlicht.h"
+#include <vector>
+
+//per tile flags, vertex dirty flags are set when the vertex
+//height was changed (morphing, terraforming), and the mesh
+//vertex still needs to be updated
+#define DEF_TERRAINTILE_FLAG_VERT1DIRTY 0x01
+#define DEF_TERRAINTILE_FLAG_VERT2DIRTY 0x02
+#define DEF_TERRAINTILE_FLAG_VERT3DIRTY 0x04
+#define DEF_TERRAINTILE_FLAG_VERT4DIRTY 0x08
+
+//Stores the terrain tile data that is read very often during the game (vertex heights,
+//averaged tile height, dirty flags) in flat and tightly packed arrays, separate from the
+//render bookkeeping in TerrainTileData. Height queries of physics, computer players and morphs
+//therefore only touch a few bytes per tile, instead of pulling the whole TerrainTileData
+//record (vertex pointers, colors, normals, UVs, vectors...) through the cache.
+//Tiles are stored in the same order as the TerrainTileData arrays ([x][z]), and the
+//4 vertex heights of a tile are stored next to each other.
+//Vertex numbering (1 up to 4) is the same as vert1 up to vert4 of TerrainTileData
+class TerrainTileStore {
+public:
+    TerrainTileStore(irr::s32 width, irr::s32 height);
+    ~TerrainTileStore();
+
+    //sets all heights to 0, and clears all flags
+    void Reset();
+
+    irr::s32 GetWidth();
+    irr::s32 GetHeight();
+
+    //returns the index of the tile inside of the data arrays
+    inline irr::s32 GetTileIndex(irr::s32 x, irr::s32 z) {
+        return (x * mHeight + z);
+    }
+
+    inline irr::f32 GetVertexHeight(irr::s32 x, irr::s32 z, irr::u8 vertex) {
+        return mVertexHeight[GetTileIndex(x, z) * 4 + vertex - 1];
+    }
+
+    inline void SetVertexHeight(irr::s32 x, irr::s32 z, irr::u8 vertex, irr::f32 newHeight) {
+        mVertexHeight[GetTileIndex(x, z) * 4 + vertex - 1] = newHeight;
+    }
+
+    //returns a pointer to all 4 vertex heights of the tile
+    //index 0 is vert1, index 3 is vert4
+    inline const irr::f32* GetVertexHeights(irr::s32 x, irr::s32 z) {
+        return &mVertexHeight[GetTileIndex(x, z) * 4];
+    }
+
+    inline bool IsVertexHeightDirty(irr::s32 x, irr::s32 z, irr::u8 vertex) {
+        return ((mFlags[GetTileIndex(x, z)] & (DEF_TERRAINTILE_FLAG_VERT1DIRTY << (vertex - 1))) != 0);
+    }
+
+    inline void SetVertexHeightDirty(irr::s32 x, irr::s32 z, irr::u8 vertex, bool dirty) {
+        irr::u8 flag = (irr::u8)(DEF_TERRAINTILE_FLAG_VERT1DIRTY << (vertex - 1));
+
+        if (dirty) {
+            mFlags[GetTileIndex(x, z)] |= flag;
+        } else {
+            mFlags[GetTileIndex(x, z)] &= (irr::u8)(~flag);
+        }
+    }
+
+    //the current averaged tile height, is for example needed for player
+    //craft calculations; when the Terrain does morph this value keeps to be correct
+    inline irr::f32 GetTileHeight(irr::s32 x, irr::s32 z) {
+        return mTileHeight[GetTileIndex(x, z)];
+    }
+
+    inline void SetTileHeight(irr::s32 x, irr::s32 z, irr::f32 newHeight) {
+        mTileHeight[GetTileIndex(x, z)] = newHeight;
+    }
+
+private:
+    irr::s32 mWidth;
+    irr::s32 mHeight;
+
+    //4 values per tile
+    std::vector<irr::f32> mVertexHeight;
+
+    //1 value per tile
+    std::vector<irr::f32> mTileHeight;
+    std::vector<irr::u8> mFlags;
+};
+
+#endif // TERRAINTILESTORE_H
@@ -24,6 +24,12 @@
 #include "utils/worldaware.h"
 #include "utils/fileutils.h"
 #include "utils/gamedbgwnd.h"
+#include "utils/occlusion.h"
+#include "utils/visgrid.h"
+#include "utils/threadpool.h"
+#include "utils/trianglegrid.h"
+#include "utils/trianglegridselector.h"
+#include "resources/levelcache.h"
 #include "vanilla/vcalc.h"
 
 #include "draw/hud.h"
@@ -50,9 +56,11 @@
 #include "models/collectablespawner.h"
 #include "draw/drawdebug.h"
 #include "draw/minimap.h"
+#include "draw/spritebatch.h"
 #include "resources/assets.h"
 #include "models/steamfountain.h"
 #include "scenenodes/CLensFlareSceneNode.h"
+#include "scenenodes/particlebatch.h"
 
 #include "audio/sound.h"
 #include "audio/music.h"
@@ -555,6 +563,15 @@ void Race::SetDebugFlag(irr::u8 debugFlag, bool enable) {
           break;
       }
 
+      case DEF_RACE_DBG_OCCLUSIONCULLING: {
+          mOcclusionCullingEnabled = enable;
+
+          if (mOcclusionCulling != nullptr) {
+              mOcclusionCulling->SetEnabled(enable);
+          }
+          break;
+      }
+
       default: {
           break;
       }
@@ -623,6 +640,10 @@ bool Race::GetDebugFlag(irr::u8 debugFlag) {
             return (DebugShowCloneRecording);
         }
 
+        case DEF_RACE_DBG_OCCLUSIONCULLING: {
+            return (mOcclusionCullingEnabled);
+        }
+
         default: {
             return (false);
         }
@@ -630,6 +651,10 @@ bool Race::GetDebugFlag(irr::u8 debugFlag) {
 }
 
 Race::~Race() {
+    //a background init job could still
+    //work on this race
+    FinishInitJob();
+
     //unregister existing HUD in all players
     std::vector<Player*>::iterator it;
 
@@ -684,6 +709,32 @@ Race::~Race() {
 
     delete mWorldAware;
 
+    if (mLevelCache != nullptr) {
+        delete mLevelCache;
+        mLevelCache = nullptr;
+    }
+
+    //collision grids that were not handed over to
+    //a triangle selector yet (initialization aborted)
+    std::vector<TriangleGrid*>::iterator itGrid;
+
+    for (itGrid = mCollisionGridVec.begin(); itGrid != mCollisionGridVec.end(); ++itGrid) {
+        delete (*itGrid);
+    }
+
+    mCollisionGridVec.clear();
+
+    //make sure no scene node stays hidden
+    if (mOcclusionCulling != nullptr) {
+        delete mOcclusionCulling;
+        mOcclusionCulling = nullptr;
+    }
+
+    if (mVisibilityGrid != nullptr) {
+        delete mVisibilityGrid;
+        mVisibilityGrid = nullptr;
+    }
+
     //clean collision mesh and SceneNodes
     //remove Scenenode
     wallCollisionMeshSceneNode->remove();
@@ -748,6 +799,13 @@ Race::~Race() {
         cloudLayer3 = nullptr;
     }
 
+    //all particle systems are already deleted
+    //at this point, we can remove the particle batch
+    if (mParticleBatch != nullptr) {
+        mParticleBatch->remove();
+        mParticleBatch = nullptr;
+    }
+
     //free lowlevel level data
     delete mLevelBlocks;
     delete mLevelTerrain;
@@ -1341,7 +1399,7 @@ bool Race::RaceAllowsPlayersToAttack() {
     return false;
 }
 
-void Race::AddPlayer(bool humanPlayer, char* name, std::string player_model) {
+void Race::AddPlayer(bool humanPlayer, char* name, std::string player_model, irr::video::ITexture* colorSchemeTex) {
     Player* newPlayer;
 
     //***************************************************
@@ -1373,7 +1431,7 @@ void Race::AddPlayer(bool humanPlayer, char* name, std::string player_model) {
     Startdirection.Z = Startpos.Z - 1.0f; //attempt beginning from 04.09.2024
 
     //create the new player
-    newPlayer = new Player(this, player_model, Startpos, Startdirection,
+    newPlayer = new Player(this, player_model, colorSchemeTex, Startpos, Startdirection,
                           this->mRaceNumberOfLaps, humanPlayer);
 
     if (mGame->mUseXEffects) {
@@ -1809,7 +1867,7 @@ void Race::HandleCraftHeightMapCollisions(irr::f32 deltaTime, PhysicsObject* whi
     }
 }
 
-void Race::Init() {
+void Race::BeginInit() {
     //we want to adjust the keymap for the free movable camera
     SKeyMap keyMap[4];
 
@@ -1825,11 +1883,145 @@ void Race::Init() {
 
     //mCamera->setFOV(PI / 2.5);
 
-    if (!LoadLevel()) {
-        //there was an error loading the level
-        return;
+    mInitStep = DEF_RACE_INITSTEP_LOADTEXTURES;
+}
+
+bool Race::ContinueInit() {
+    if (mInitStep == DEF_RACE_INITSTEP_DONE)
+        return true;
+
+    //as long as the background job of the last step is still running
+    //we return, so that the caller can update the race load screen meanwhile
+    if ((mInitJob != nullptr) && !mGame->mThreadPool->IsJobFinished(mInitJob))
+        return false;
+
+    bool stepOk = false;
+
+    switch (mInitStep) {
+        case DEF_RACE_INITSTEP_LOADTEXTURES: {
+            stepOk = LoadLevelTextures();
+            break;
+        }
+
+        case DEF_RACE_INITSTEP_LEVELTEXTURES: {
+            stepOk = LoadRequestedLevelTextures();
+
+            //the requested textures are loaded over multiple calls,
+            //stay in this step until the request queue is empty
+            if (stepOk && (mTexLoader->GetNrLevelTextureRequests() > 0))
+                return false;
+
+            break;
+        }
+
+        case DEF_RACE_INITSTEP_TERRAIN: {
+            stepOk = LoadLevelTerrain();
+            break;
+        }
+
+        case DEF_RACE_INITSTEP_BLOCKS: {
+            stepOk = LoadLevelBlocks();
+            break;
+        }
+
+        case DEF_RACE_INITSTEP_ENTITIES: {
+            stepOk = LoadLevelEntities();
+            break;
+        }
+
+        case DEF_RACE_INITSTEP_TERRAINMESH: {
+            stepOk = LoadLevelTerrainMesh();
+            break;
+        }
+
+        case DEF_RACE_INITSTEP_COLLISION: {
+            stepOk = LoadLevelCollision();
+            break;
+        }
+
+        case DEF_RACE_INITSTEP_SETUP: {
+            stepOk = InitSetup();
+            break;
+        }
+
+        case DEF_RACE_INITSTEP_FINISH: {
+            stepOk = InitFinish();
+            break;
+        }
+    }
+
+    if (!stepOk) {
+        //there was an error loading the level, ready stays false
+        //we need to wait for a possible background job anyway
+        FinishInitJob();
+        mInitStep = DEF_RACE_INITSTEP_DONE;
+        return true;
+    }
+
+    mInitStep++;
+
+    //if this step did not start a background job, the
+    //progress inside of the step is not valid anymore
+    if (mInitJob == nullptr) {
+        mInitSubStep = 0;
+        mInitNrSubSteps = 0;
+    }
+
+    return (mInitStep == DEF_RACE_INITSTEP_DONE);
+}
+
+irr::f32 Race::GetInitProgress() {
+    irr::f32 progress = (irr::f32)(mInitStep);
+
+    //add the progress inside of the current step, this is
+    //mostly the background job the step is waiting for
+    irr::u32 nrSubSteps = mInitNrSubSteps;
+
+    if ((mInitStep < DEF_RACE_INITSTEP_DONE) && (nrSubSteps > 0)) {
+        irr::u32 currSubStep = mInitSubStep;
+
+        if (currSubStep > nrSubSteps)
+            currSubStep = nrSubSteps;
+
+        progress += (irr::f32)(currSubStep) / (irr::f32)(nrSubSteps);
     }
 
+    return (progress / (irr::f32)(DEF_RACE_INITSTEP_DONE));
+}
+
+void Race::AddInitJob(const std::string& description, irr::u32 nrSubSteps, std::function<void()> work) {
+    mInitSubStep = 0;
+    mInitNrSubSteps = nrSubSteps;
+
+    mInitJob = mGame->mThreadPool->AddJob(description, work);
+}
+
+bool Race::FinishInitJob() {
+    if (mInitJob == nullptr)
+        return true;
+
+    mGame->mThreadPool->WaitForJob(mInitJob);
+
+    bool jobOk = (mInitJob->state == DEF_THREADPOOL_JOB_DONE);
+
+    if (!jobOk) {
+        std::string errMsg("Race initialization job '");
+        errMsg.append(mInitJob->description);
+        errMsg.append("' failed: ");
+        errMsg.append(mInitJob->errorMsg);
+        logging::Error(errMsg);
+    }
+
+    mGame->mThreadPool->ReleaseJob(mInitJob);
+    mInitJob = nullptr;
+
+    mInitSubStep = 0;
+    mInitNrSubSteps = 0;
+
+    return jobOk;
+}
+
+bool Race::InitSetup() {
     irr::s32 distCorner = 5;
 
     if (mGame->mGameConfig->enableDoubleResolution) {
@@ -1926,7 +2118,29 @@ void Race::Init() {
 
     //now use the new world aware class to further analyze all
     //waypoint links for computer player movement control later
-    mWorldAware->PreAnalyzeWaypointLinksOffsetRange();
+    //this only uses the CPU side world images, and can take a while
+    //if the result is not in the level cache yet, therefore do it in the background
+    AddInitJob("Waypoint link analysis", 0, [this]() {
+        mWorldAware->PreAnalyzeWaypointLinksOffsetRange();
+    });
+
+    return true;
+}
+
+bool Race::InitFinish() {
+    //waypoint link analysis must be done
+    if (!FinishInitJob())
+        return false;
+
+    //write all data that was newly calculated during
+    //this level load into the level cache
+    mLevelCache->Save();
+
+    //setup the occluders for CPU side occlusion culling
+    CreateOcclusionCulling();
+
+    //sort all static race entities into the visibility grid
+    CreateVisibilityGrid();
 
     //create my ExplosionLauncher
     mExplosionLauncher = new ExplosionLauncher(this, mGame->mSmgr, mGame->mDriver);
@@ -1937,7 +2151,7 @@ void Race::Init() {
     //load the correct music file for this level
     if (!mMusicPlayer->loadGameMusicFile(mMapConfig->MusicFile.c_str())) {
         logging::Error("Music load failed");
-        return;
+        return false;
     } else {
              //start music playing
              mMusicPlayer->StartPlay();
@@ -1961,6 +2175,8 @@ void Race::Init() {
     //only to test if we can save a levelfile properly!
     //std::string testsaveName("testsave.dat");
     //this->mLevelRes->Save(testsaveName);
+
+    return true;
 }
 
 void Race::RemovePlayer(Player* whichPlayer) {
@@ -2628,6 +2844,13 @@ void Race::HandleDebugInput() {
          DebugHitBreakpoint = true;
     }
 
+    if(mGame->mEventReceiver->IsKeyDownSingleEvent(irr::KEY_F7))
+    {
+         //write the debug primitives of the next
+         //rendered frame into a text file
+         mDumpDebugPrimitives = true;
+    }
+
     if (mGame->mEventReceiver->IsKeyDownSingleEvent(irr::KEY_KEY_P)) {
         playerCamera = !playerCamera;
 
@@ -2974,7 +3197,11 @@ void Race::DrawTestShape() {
 }
 
 void Race::DrawHUD(irr::f32 frameDeltaTime) {
+    //collect all Hud images and texts, and draw them
+    //with as few draw calls as possible
+    mGame->mSpriteBatch->Begin();
     this->Hud1Player->DrawHUD1(frameDeltaTime);
+    mGame->mSpriteBatch->End();
 
     //in Demo mode we do not want to draw a minimap
     //we also do only want to start drawing the map after
@@ -3032,7 +3259,7 @@ void Race::DebugDrawWayPointLinks(bool drawFreeMovementSpace) {
         mGame->mDrawDebug->Draw3DArrow((*WayPointLink_iterator)->pLineStruct->A + incY,
                                         (*WayPointLink_iterator)->pLineStruct->B + incY,
                                         0.5f,
-                                        (*WayPointLink_iterator)->pLineStruct->color, 0.1f);
+                                        (*WayPointLink_iterator)->pLineStruct->color, 0.1f, DEF_DRAWDEBUG_CAT_WAYPOINTS);
 
         if (drawFreeMovementSpace) {
             //also draw min/max offset shift limit lines for graphical representation of possible computer player
@@ -3042,14 +3269,14 @@ void Race::DebugDrawWayPointLinks(bool drawFreeMovementSpace) {
                         (*WayPointLink_iterator)->minOffsetShiftStart,
                         (*WayPointLink_iterator)->pLineStruct->B + incY + (*WayPointLink_iterator)->offsetDirVec *
                         (*WayPointLink_iterator)->minOffsetShiftEnd,
-                        this->mGame->mDrawDebug->blue);
+                        this->mGame->mDrawDebug->blue, DEF_DRAWDEBUG_CAT_WAYPOINTS);
 
             mGame->mDrawDebug->Draw3DLine(
                         (*WayPointLink_iterator)->pLineStruct->A + incY + (*WayPointLink_iterator)->offsetDirVec *
                         (*WayPointLink_iterator)->maxOffsetShiftStart,
                         (*WayPointLink_iterator)->pLineStruct->B + incY + (*WayPointLink_iterator)->offsetDirVec *
                         (*WayPointLink_iterator)->maxOffsetShiftEnd,
-                        this->mGame->mDrawDebug->red);
+                        this->mGame->mDrawDebug->red, DEF_DRAWDEBUG_CAT_WAYPOINTS);
         }
     }
 }
@@ -3143,14 +3370,16 @@ void Race::Render() {
         if (DebugShowWallSegments) {
           //draw all wallsegments for debugging purposes
          for(Linedraw_iterator2 = ENTWallsegmentsLine_List->begin(); Linedraw_iterator2 != ENTWallsegmentsLine_List->end(); ++Linedraw_iterator2) {
-              mGame->mDrawDebug->Draw3DLine((*Linedraw_iterator2)->A, (*Linedraw_iterator2)->B, mGame->mDrawDebug->red);
+              mGame->mDrawDebug->Draw3DLine((*Linedraw_iterator2)->A, (*Linedraw_iterator2)->B, mGame->mDrawDebug->red,
+                                            DEF_DRAWDEBUG_CAT_LEVEL);
            }
          }
 
         if (DebugShowCheckpoints) {
           //draw all checkpoint lines for debugging purposes
           for(CheckPoint_iterator = checkPointVec->begin(); CheckPoint_iterator != checkPointVec->end(); ++CheckPoint_iterator) {
-              mGame->mDrawDebug->Draw3DLine((*CheckPoint_iterator)->pLineStruct->A, (*CheckPoint_iterator)->pLineStruct->B, mGame->mDrawDebug->blue);
+              mGame->mDrawDebug->Draw3DLine((*CheckPoint_iterator)->pLineStruct->A, (*CheckPoint_iterator)->pLineStruct->B, mGame->mDrawDebug->blue,
+                                            DEF_DRAWDEBUG_CAT_LEVEL);
           }
         }
 
@@ -3308,6 +3537,210 @@ void Race::Render() {
         //DebugShowAllObstaclePlayers();
 
     // mVCalc->DebugDraw();
+
+    //hide all entities outside of the camera view first, so that
+    //occlusion culling only needs to test the remaining ones
+    UpdateVisibilityGrid();
+
+    //hide all entities that are hidden behind
+    //terrain and columns before the scene is drawn
+    UpdateOcclusionCulling();
+
+    if (mDumpDebugPrimitives) {
+        mDumpDebugPrimitives = false;
+
+        if (mGame->mDrawDebug->DumpPrimitives("dbgprimitives.txt")) {
+            logging::Info("Debug primitives of current frame written to dbgprimitives.txt");
+        } else {
+            logging::Error("Writing debug primitives to dbgprimitives.txt failed");
+        }
+    }
+
+    //draw all debug lines of this frame at once
+    mGame->mDrawDebug->Flush();
+}
+
+void Race::CreateOcclusionCulling() {
+    mOcclusionCulling = new OcclusionCulling();
+
+    //columns that are part of a morph change during the race
+    //and must therefore never be used as occluders
+    std::vector<Column*> morphColumns;
+    std::list<Morph*>::iterator itMorph;
+
+    for (itMorph = Morphs.begin(); itMorph != Morphs.end(); ++itMorph) {
+        morphColumns.insert(morphColumns.end(), (*itMorph)->Columns.begin(), (*itMorph)->Columns.end());
+    }
+
+    mOcclusionCulling->AddOccludersFromTerrain(mLevelTerrain);
+    mOcclusionCulling->AddOccludersFromColumns(mLevelBlocks, morphColumns);
+
+    mOcclusionCulling->SetEnabled(mOcclusionCullingEnabled);
+
+    std::string infoMsg("Occlusion culling uses ");
+    infoMsg.append(std::to_string(mOcclusionCulling->mNrOccluders));
+    infoMsg.append(" occluders");
+    logging::Info(infoMsg);
+}
+
+void Race::UpdateOcclusionCulling() {
+    if ((mOcclusionCulling == nullptr) || !mOcclusionCulling->IsEnabled())
+        return;
+
+    irr::scene::ICameraSceneNode* activeCam = mGame->mSmgr->getActiveCamera();
+
+    if (activeCam == nullptr)
+        return;
+
+    //make sure the camera matrices reflect the camera
+    //position of this frame
+    activeCam->updateMatrices();
+
+    mOcclusionCulling->RasterizeOccluders(activeCam->getViewMatrix(), activeCam->getProjectionMatrix(),
+                                          activeCam->getAbsolutePosition());
+
+    //collect all entity scene nodes we want to test
+    mOcclusionCandidateVec.clear();
+
+    std::vector<Player*>::iterator itPlayer;
+    for (itPlayer = mPlayerVec.begin(); itPlayer != mPlayerVec.end(); ++itPlayer) {
+        mOcclusionCandidateVec.push_back((*itPlayer)->Player_node);
+    }
+
+    std::vector<Collectable*>::iterator itCollectable;
+    for (itCollectable = ENTCollectablesVec->begin(); itCollectable != ENTCollectablesVec->end(); ++itCollectable) {
+        mOcclusionCandidateVec.push_back((*itCollectable)->billSceneNode);
+    }
+
+    std::vector<Cone*>::iterator itCone;
+    for (itCone = coneVec->begin(); itCone != coneVec->end(); ++itCone) {
+        mOcclusionCandidateVec.push_back((*itCone)->cone_node);
+    }
+
+    std::vector<Recovery*>::iterator itRecovery;
+    for (itRecovery = recoveryVec->begin(); itRecovery != recoveryVec->end(); ++itRecovery) {
+        mOcclusionCandidateVec.push_back((*itRecovery)->Recovery_node);
+    }
+
+    mOcclusionCulling->CullSceneNodes(mOcclusionCandidateVec);
+}
+
+void Race::CreateVisibilityGrid() {
+    //the grid covers the whole level terrain
+    irr::core::aabbox3df worldArea = mLevelTerrain->StaticTerrainSceneNode->getTransformedBoundingBox();
+
+    if (mLevelTerrain->DynamicTerrainSceneNode != nullptr) {
+        worldArea.addInternalBox(mLevelTerrain->DynamicTerrainSceneNode->getTransformedBoundingBox());
+    }
+
+    mVisibilityGrid = new VisibilityGrid(worldArea);
+
+    //collectables that are stored in the level file; temporary spawned
+    //collectables only exist for a short time, and are not added
+    std::vector<Collectable*>::iterator itCollectable;
+    for (itCollectable = ENTCollectablesVec->begin(); itCollectable != ENTCollectablesVec->end(); ++itCollectable) {
+        if ((*itCollectable)->mEntityItem != nullptr) {
+            (*itCollectable)->mVisGridEntry =
+                    mVisibilityGrid->AddEntity((*itCollectable)->boundingBox, (*itCollectable)->billSceneNode);
+        }
+    }
+
+    std::vector<Cone*>::iterator itCone;
+    for (itCone = coneVec->begin(); itCone != coneVec->end(); ++itCone) {
+        (*itCone)->mVisGridEntry =
+                mVisibilityGrid->AddEntity((*itCone)->cone_node->getTransformedBoundingBox(), (*itCone)->cone_node);
+    }
+
+    //recovery vehicles move around, their entries
+    //are updated every frame
+    std::vector<Recovery*>::iterator itRecovery;
+    for (itRecovery = recoveryVec->begin(); itRecovery != recoveryVec->end(); ++itRecovery) {
+        (*itRecovery)->mVisGridEntry =
+                mVisibilityGrid->AddEntity((*itRecovery)->Recovery_node->getTransformedBoundingBox(), (*itRecovery)->Recovery_node);
+    }
+
+    //Missiles add (and remove) themselves while they are flying. Not added on purpose:
+    //  - Explosions: the fire balls are animated with a non looping texture animator, and Irrlicht
+    //    does not animate hidden scene nodes; A fire ball that is culled by the grid would never
+    //    finish, and its explosion would never be removed
+    //  - Charging stations: their region scene node is never visible during the race
+    //  - Collectables have no per frame update (no rotation or sprite animation) that could be skipped
+
+    //steam fountains do not have an own scene node, their particles are
+    //drawn by the particle batch; The box needs to contain the whole rising steam
+    std::vector<SteamFountain*>::iterator itSteam;
+    for (itSteam = steamFountainVec->begin(); itSteam != steamFountainVec->end(); ++itSteam) {
+        irr::core::vector3df pos = (*itSteam)->mEntityItem->getCenter();
+
+        irr::core::aabbox3df steamBox(pos.X - DEF_RACE_STEAMFOUNTAIN_VISRADIUS, pos.Y,
+                                      pos.Z - DEF_RACE_STEAMFOUNTAIN_VISRADIUS,
+                                      pos.X + DEF_RACE_STEAMFOUNTAIN_VISRADIUS, pos.Y + DEF_RACE_STEAMFOUNTAIN_VISHEIGHT,
+                                      pos.Z + DEF_RACE_STEAMFOUNTAIN_VISRADIUS);
+
+        (*itSteam)->mVisGridEntry = mVisibilityGrid->AddEntity(steamBox, nullptr);
+    }
+
+    std::string infoMsg("Visibility grid uses ");
+    infoMsg.append(std::to_string(mVisibilityGrid->GetNrCells()));
+    infoMsg.append(" cells for ");
+    infoMsg.append(std::to_string(mVisibilityGrid->GetNrEntities()));
+    infoMsg.append(" entities");
+    logging::Info(infoMsg);
+}
+
+void Race::UpdateVisibilityGrid() {
+    if (mVisibilityGrid == nullptr)
+        return;
+
+    irr::scene::ICameraSceneNode* activeCam = mGame->mSmgr->getActiveCamera();
+
+    if (activeCam == nullptr)
+        return;
+
+    //cones that were hit by a player are moving
+    std::vector<Cone*>::iterator itCone;
+    for (itCone = coneVec->begin(); itCone != coneVec->end(); ++itCone) {
+        if ((*itCone)->mActivity) {
+            mVisibilityGrid->UpdateEntity((*itCone)->mVisGridEntry, (*itCone)->cone_node->getTransformedBoundingBox());
+        }
+    }
+
+    std::vector<Recovery*>::iterator itRecovery;
+    for (itRecovery = recoveryVec->begin(); itRecovery != recoveryVec->end(); ++itRecovery) {
+        (*itRecovery)->Recovery_node->updateAbsolutePosition();
+        mVisibilityGrid->UpdateEntity((*itRecovery)->mVisGridEntry, (*itRecovery)->Recovery_node->getTransformedBoundingBox());
+    }
+
+    //make sure the camera frustum reflects the camera
+    //position of this frame
+    activeCam->updateMatrices();
+
+    mVisibilityGrid->Cull(*activeCam->getViewFrustum());
+
+    //steam fountains outside of the view do not need to
+    //update their particles
+    std::vector<SteamFountain*>::iterator itSteam;
+    for (itSteam = steamFountainVec->begin(); itSteam != steamFountainVec->end(); ++itSteam) {
+        if ((*itSteam)->mVisGridEntry != nullptr) {
+            (*itSteam)->SetInView((*itSteam)->mVisGridEntry->inView);
+        }
+    }
+}
+
+void Race::RestoreOccludedSceneNodes() {
+    if (mOcclusionCulling != nullptr) {
+        mOcclusionCulling->RestoreCulledSceneNodes();
+    }
+
+    if (mVisibilityGrid != nullptr) {
+        mVisibilityGrid->RestoreCulledSceneNodes();
+    }
+
+    //keep the occlusion statistics in the
+    //debug window up to date
+    if ((mDbgWindow != nullptr) && (mDbgWindow->IsWindowVisible())) {
+        mDbgWindow->UpdateStatistics();
+    }
 }
 
 void Race::UpdatePlayersDbgFlag(irr::u8 debugFlag, bool enable) {
@@ -3582,7 +4015,7 @@ bool Race::SetupSky() {
     return true;
 }
 
-bool Race::LoadLevel() {
+bool Race::LoadLevelTextures() {
    std::string levelfilename("");
    std::string texfilename("");
 
@@ -3601,10 +4034,21 @@ bool Race::LoadLevel() {
    }
 
    /***********************************************************/
-   /* Load level textures                                     */
+   /* Load selected level file                                */
    /***********************************************************/
+   //parsing the level file does not need the Irrlicht device, therefore
+   //do it in the background while we load the level textures
+   AddInitJob("Level file loading", 0, [this, levelfilename]() {
+       LoadLevelFile(levelfilename);
+   });
+
+   /***********************************************************/
+   /* Load sprite textures                                    */
+   /***********************************************************/
+   //the level textures are only loaded in the next step, when we
+   //know from the level file which of them are used by this level
    mTexLoader = new TextureLoader(mGame, mLevelRootPath.c_str(), mMapConfig->texBaseLocation.c_str(),
-                                  mMapConfig->useCustomTextures, spritefilename.c_str());
+                                  mMapConfig->useCustomTextures, spritefilename.c_str(), false, true);
 
    //was loading textures succesfull? if not interrupt
    if (!this->mTexLoader->mLoadSuccess) {
@@ -3612,34 +4056,123 @@ bool Race::LoadLevel() {
        return false;
    }
 
-   /***********************************************************/
-   /* Load selected level file                                */
-   /***********************************************************/
+   return true;
+}
 
+//is executed on a thread pool worker, must not
+//use the Irrlicht device
+void Race::LoadLevelFile(std::string levelfilename) {
    //load the level data itself
    this->mLevelRes = new LevelFile(mGame, levelfilename, mGame->mExtendedGame);
 
    //was loading level data succesful? if not interrupt
-   if (!this->mLevelRes->get_Ready()) {
+   if (!this->mLevelRes->get_Ready())
+       return;
+
+   /***********************************************************/
+   /* Open level cache                                        */
+   /***********************************************************/
+   //the cache is only valid for exactly this level file
+   //therefore use the checksum of the level file as key
+   std::string cacheFilename("");
+   cacheFilename.append(mLevelRootPath);
+   cacheFilename.append(LEVELCACHE_FILENAME);
+
+   mLevelCache = new LevelCache(mGame->mCrc32, cacheFilename, mLevelRes->GetChecksum());
+
+   //if there is no valid cache file yet, all
+   //data is calculated, and the cache file is written
+   //at the end of Race::InitFinish
+   mLevelCache->Load();
+}
+
+bool Race::LoadRequestedLevelTextures() {
+   if (!mLevelTexRequested) {
+       //level file must be loaded
+       if (!FinishInitJob())
+           return false;
+
+       //was loading level data succesful? if not interrupt
+       if ((this->mLevelRes == nullptr) || !this->mLevelRes->get_Ready()) {
+           logging::Error("Race::LoadLevel failed, exiting");
+           return false;
+       }
+
+       mTexLoader->RequestLevelTextures(mLevelRes);
+       mLevelTexRequested = true;
+
+       //the progress of this step are the loaded textures
+       mInitSubStep = 0;
+       mInitNrSubSteps = mTexLoader->GetNrLevelTextureRequests();
+   }
+
+   irr::u32 remainingRequests = mTexLoader->ProcessLevelTextureRequests(DEF_RACE_LEVELTEX_LOADS_PER_STEP);
+   irr::u32 nrRequests = mInitNrSubSteps;
+   mInitSubStep = nrRequests - std::min(nrRequests, remainingRequests);
+
+   if (remainingRequests == 0) {
+       char hlpstr[500];
+
+       snprintf(hlpstr, 500, "Loaded %u of %d level textures", mTexLoader->GetNrResidentLevelTextures(),
+                mTexLoader->NumLevelTextures);
+       logging::Info(hlpstr);
+   }
+
+   //was loading textures succesfull? if not interrupt
+   if (!this->mTexLoader->mLoadSuccess) {
+       logging::Error("Race::LoadTextures failed, exiting");
+       return false;
+   }
+
+   return true;
+}
+
+bool Race::LoadLevelTerrain() {
+   //level file must be loaded
+   if (!FinishInitJob())
+       return false;
+
+   //was loading level data succesful? if not interrupt
+   if ((this->mLevelRes == nullptr) || !this->mLevelRes->get_Ready()) {
        logging::Error("Race::LoadLevel failed, exiting");
        return false;
    }
 
-   /***********************************************************/
-   /* Prepare level terrain                                   */
-   /***********************************************************/
-   //for the game optimize the Terrain mesh!
-   //Update 24.01.2026: Disable terrain optimization temporary
-   this->mLevelTerrain = new LevelTerrain(mGame, false, this->mLevelRes, mTexLoader, false,
-                                          this->mGame->enableLightning);
+   //creating the terrain tile data and all columns (with the vertices of
+   //all blocks) does not need the Irrlicht device, therefore do it in the
+   //background; the Irrlicht meshes are created in the next step
+   AddInitJob("Level terrain and blocks creation", (irr::u32)(mLevelRes->Columns.size()), [this]() {
+       /***********************************************************/
+       /* Prepare level terrain                                   */
+       /***********************************************************/
+       //for the game optimize the Terrain mesh!
+       //Update 24.01.2026: Disable terrain optimization temporary
+       this->mLevelTerrain = new LevelTerrain(mGame, false, this->mLevelRes, mTexLoader, false,
+                                              this->mGame->enableLightning);
+
+       //restore the terrain mesh from the level cache if possible
+       this->mLevelTerrain->SetLevelCache(mLevelCache);
+
+       /***********************************************************/
+       /* Create building (cube) Mesh                             */
+       /***********************************************************/
+       //this routine also generates the column/block collision information inside that
+       //we need for collision detection later
+       this->mLevelBlocks = new LevelBlocks(mGame, this->mLevelTerrain, this->mLevelRes, mTexLoader, false,
+                                            DebugShowWallCollisionMesh, this->mGame->enableLightning, false, mLevelCache,
+                                            &mInitSubStep);
+   });
+
+   return true;
+}
 
-   /***********************************************************/
-   /* Create building (cube) Mesh                             */
-   /***********************************************************/
-   //this routine also generates the column/block collision information inside that
-   //we need for collision detection later
-   this->mLevelBlocks = new LevelBlocks(mGame, this->mLevelTerrain, this->mLevelRes, mTexLoader, false,
-                                        DebugShowWallCollisionMesh, this->mGame->enableLightning, false);
+bool Race::LoadLevelBlocks() {
+   //terrain and columns must be created
+   if (!FinishInitJob())
+       return false;
+
+   //create the Irrlicht meshes and scene nodes of the blocks
+   this->mLevelBlocks->FinishBlocksInitialization();
 
    //we can only set levelBlocks afterwards in Terrain
    //unfortunetly! do not forget it!
@@ -3685,6 +4218,18 @@ bool Race::LoadLevel() {
        mGame->mEffect->addShadowToNode(mLevelBlocks->BlockWithoutCollisionSceneNode, mShadowMapFilterType, ESM_RECEIVE);
    }
 
+   return true;
+}
+
+bool Race::LoadLevelEntities() {
+   //create the scene node which renders all particles
+   //of this race, is needed for the steam fountains
+   //of the level entities
+   mParticleBatch = new ParticleBatchSceneNode(mGame->mSmgr->getRootSceneNode(), mGame->mSmgr);
+
+   //the parent scene node holds a reference now
+   mParticleBatch->drop();
+
    //create all level entities
    //this are not only items to pickup by the player
    //but also waypoints, collision information, checkpoints
@@ -3696,6 +4241,21 @@ bool Race::LoadLevel() {
    //Because we need to know where the morph areas are, to be able to put
    //dynamic parts of the terrain mesh into their own Meshbuffers and SceneNodes
    //for performance improvement reasons
+   //the vertices of all tiles are created in the background, the Irrlicht
+   //meshes in the next step
+   AddInitJob("Level terrain preparation", mLevelTerrain->GetNrPrepareSteps(), [this]() {
+       mLevelTerrain->PrepareTerrainGeometry(&mInitSubStep);
+   });
+
+   return true;
+}
+
+bool Race::LoadLevelTerrainMesh() {
+   //terrain vertices must be prepared
+   if (!FinishInitJob())
+       return false;
+
+   //create the Irrlicht meshes and scene nodes of the terrain
    mLevelTerrain->FinishTerrainInitialization();
 
    if (this->mLevelTerrain->Terrain_ready == false) {
@@ -3721,6 +4281,25 @@ bool Race::LoadLevel() {
 
   createWallCollisionData();
 
+  //sorting all collision triangles into the grids does not need the
+  //Irrlicht device, therefore do it in the background
+  std::vector<irr::scene::IMesh*> meshVec;
+  std::vector<irr::scene::ISceneNode*> sceneNodeVec;
+
+  GetCollisionMeshes(meshVec, sceneNodeVec);
+
+  AddInitJob("Collision triangle grid creation", (irr::u32)(meshVec.size()), [this, meshVec]() {
+      createCollisionGrids(meshVec);
+  });
+
+  return true;
+}
+
+bool Race::LoadLevelCollision() {
+  //collision triangle grids must be created
+  if (!FinishInitJob())
+      return false;
+
   //create final overall triangle selectors for collision
   //with physics
   createFinalCollisionData();
@@ -4142,8 +4721,9 @@ void Race::createWallCollisionData() {
         wallCollisionMesh->recalculateBoundingBox();
    }
 
-    //now create a OctreeSceneNode for the wall collision Mesh
-    wallCollisionMeshSceneNode = mGame->mSmgr->addOctreeSceneNode(wallCollisionMesh, 0, IDFlag_IsPickable);
+    //now create a SceneNode for the wall collision Mesh; it is never drawn, and the
+    //triangle selector has its own grid, therefore we do not need an octree here
+    wallCollisionMeshSceneNode = mGame->mSmgr->addMeshSceneNode(wallCollisionMesh, 0, IDFlag_IsPickable);
 
     //hide the collision mesh that the player does not see it
     wallCollisionMeshSceneNode->setVisible(false);
@@ -4152,34 +4732,119 @@ void Race::createWallCollisionData() {
     //wallCollisionMeshSceneNode->setDebugDataVisible(EDS_BBOX);
 }
 
+//Layout of the collision triangles cache section:
+//  uint32 number of triangle grids
+//  the triangle grids, see TriangleGrid::AppendToCacheData
+bool Race::ReadCollisionGridsFromCache(std::vector<TriangleGrid*> &gridVec, const std::vector<irr::scene::IMesh*> &meshVec) {
+   std::vector<uint8_t> data;
+
+   if (!mLevelCache->GetSection(LEVELCACHE_SECTION_COLLISIONTRIANGLES, data))
+       return false;
+
+   size_t readIdx = 0;
+
+   if ((data.size() < sizeof(uint32_t)) || (LevelCache::ReadUInt32(data, readIdx) != (uint32_t)(gridVec.size())))
+       return false;
+
+   for (size_t idx = 0; idx < gridVec.size(); idx++) {
+       if (!gridVec[idx]->ReadFromCacheData(data, readIdx))
+           return false;
+
+       //the cached grid must contain exactly the
+       //triangles of the current mesh
+       if (gridVec[idx]->GetTriangleCount() != TriangleGrid::GetMeshTriangleCount(meshVec[idx]))
+           return false;
+   }
+
+   return (readIdx == data.size());
+}
+
+void Race::WriteCollisionGridsToCache(std::vector<TriangleGrid*> &gridVec) {
+   std::vector<uint8_t> data;
+
+   LevelCache::AppendUInt32(data, (uint32_t)(gridVec.size()));
+
+   std::vector<TriangleGrid*>::iterator it;
+
+   for (it = gridVec.begin(); it != gridVec.end(); ++it) {
+       (*it)->AppendToCacheData(data);
+   }
+
+   mLevelCache->SetSection(LEVELCACHE_SECTION_COLLISIONTRIANGLES, data);
+}
+
+void Race::GetCollisionMeshes(std::vector<irr::scene::IMesh*> &meshVec, std::vector<irr::scene::ISceneNode*> &sceneNodeVec) {
+   //only blocks with collision detection are part of our column triangle selector
+   //so that blocks that should not have collision detection are not part of it;
+   //the blocks without collision detection and the terrain we use for ray casting
+   //(for example to find target of machine gun)
+   meshVec = {wallCollisionMesh,
+              this->mLevelBlocks->blockMeshForCollision,
+              this->mLevelBlocks->blockMeshWithoutCollision,
+              this->mLevelTerrain->myStaticTerrainMesh,
+              this->mLevelTerrain->myDynamicTerrainMesh};
+
+   sceneNodeVec = {wallCollisionMeshSceneNode,
+                   this->mLevelBlocks->BlockCollisionSceneNode,
+                   this->mLevelBlocks->BlockWithoutCollisionSceneNode,
+                   this->mLevelTerrain->StaticTerrainSceneNode,
+                   this->mLevelTerrain->DynamicTerrainSceneNode};
+}
+
+//is executed on a thread pool worker, must not
+//use the Irrlicht device
+void Race::createCollisionGrids(const std::vector<irr::scene::IMesh*> &meshVec) {
+   for (size_t idx = 0; idx < meshVec.size(); idx++) {
+       mCollisionGridVec.push_back(new TriangleGrid());
+   }
+
+   //sorting the triangles into the grids takes a while for
+   //the terrain, therefore keep the result in the level cache
+   if (ReadCollisionGridsFromCache(mCollisionGridVec, meshVec)) {
+       mInitSubStep = (irr::u32)(meshVec.size());
+       return;
+   }
+
+   std::vector<irr::core::triangle3df> triangles;
+
+   for (size_t idx = 0; idx < meshVec.size(); idx++) {
+       triangles.clear();
+       TriangleGrid::AppendMeshTriangles(meshVec[idx], triangles);
+
+       mCollisionGridVec[idx]->Build(triangles);
+
+       mInitSubStep++;
+   }
+
+   WriteCollisionGridsToCache(mCollisionGridVec);
+}
+
 //takes the precalculated wall and column collision data
 //and creates the final triangle selector out of it for the
 //physics later
 void Race::createFinalCollisionData() {
+   std::vector<irr::scene::IMesh*> meshVec;
+   std::vector<irr::scene::ISceneNode*> sceneNodeVec;
 
-   triangleSelectorWallCollision = mGame->mSmgr->createOctreeTriangleSelector(
-                wallCollisionMesh, wallCollisionMeshSceneNode, 128);
-   wallCollisionMeshSceneNode->setTriangleSelector(triangleSelectorWallCollision);
+   GetCollisionMeshes(meshVec, sceneNodeVec);
 
-   //only add blocks with collision detection to our column triangle selector
-   //so that blocks that should not have collision detection are not part of it
-   triangleSelectorColumnswCollision = mGame->mSmgr->createOctreeTriangleSelector(
-                this->mLevelBlocks->blockMeshForCollision, this->mLevelBlocks->BlockCollisionSceneNode, 128);
-   this->mLevelBlocks->BlockCollisionSceneNode->setTriangleSelector(triangleSelectorColumnswCollision);
+   //the selectors take ownership of the grids
+   std::vector<irr::scene::ITriangleSelector*> selectorVec;
 
-   //also create a triangle selector for blocks without collision detection
-   //we use this for ray casting (for example to find target of machine gun)
-   triangleSelectorColumnswoCollision = mGame->mSmgr->createOctreeTriangleSelector(
-                this->mLevelBlocks->blockMeshWithoutCollision, this->mLevelBlocks->BlockWithoutCollisionSceneNode, 128);
-   this->mLevelBlocks->BlockWithoutCollisionSceneNode->setTriangleSelector(triangleSelectorColumnswoCollision);
+   for (size_t idx = 0; idx < mCollisionGridVec.size(); idx++) {
+       TriangleGridSelector* newSelector = new TriangleGridSelector(mCollisionGridVec[idx], sceneNodeVec[idx]);
+       sceneNodeVec[idx]->setTriangleSelector(newSelector);
+
+       selectorVec.push_back(newSelector);
+   }
 
-   triangleSelectorStaticTerrain = mGame->mSmgr->createOctreeTriangleSelector(
-               this->mLevelTerrain->myStaticTerrainMesh, this->mLevelTerrain->StaticTerrainSceneNode, 128);
-  this->mLevelTerrain->StaticTerrainSceneNode->setTriangleSelector(triangleSelectorStaticTerrain);
+   mCollisionGridVec.clear();
 
-   triangleSelectorDynamicTerrain = mGame->mSmgr->createOctreeTriangleSelector(
-               this->mLevelTerrain->myDynamicTerrainMesh, this->mLevelTerrain->DynamicTerrainSceneNode, 128);
-  this->mLevelTerrain->DynamicTerrainSceneNode->setTriangleSelector(triangleSelectorDynamicTerrain);
+   triangleSelectorWallCollision = selectorVec[0];
+   triangleSelectorColumnswCollision = selectorVec[1];
+   triangleSelectorColumnswoCollision = selectorVec[2];
+   triangleSelectorStaticTerrain = selectorVec[3];
+   triangleSelectorDynamicTerrain = selectorVec[4];
 }
 
 //Creates the charging stations
@@ -5057,7 +5722,7 @@ void Race::createEntity(EntityItem *p_entity,
         case Entity::EntityType::SteamStrong: {
                irr::core::vector3d<irr::f32> newlocation = entity.getCenter();
                //get the cloud sprite from the game
-               SteamFountain *sf = new SteamFountain(mTexLoader->spriteTex.at(17), p_entity, mGame->mSmgr, driver, newlocation , 100);
+               SteamFountain *sf = new SteamFountain(mTexLoader->spriteTex.at(17), p_entity, mParticleBatch, mGame->mSmgr, driver, newlocation , 100);
 
                //only for first testing
                //sf->Activate();
@@ -5074,7 +5739,7 @@ void Race::createEntity(EntityItem *p_entity,
         case Entity::EntityType::SteamLight: {
                irr::core::vector3d<irr::f32> newlocation = entity.getCenter();
                //get the cloud sprite from the game
-               SteamFountain *sf = new SteamFountain(mTexLoader->spriteTex.at(17), p_entity, mGame->mSmgr, driver, newlocation , 50);
+               SteamFountain *sf = new SteamFountain(mTexLoader->spriteTex.at(17), p_entity, mParticleBatch, mGame->mSmgr, driver, newlocation , 50);
 
                //only for first testing
                //sf->Activate();
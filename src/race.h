@@ -24,6 +24,8 @@
 #include <list>
 #include "resources/entityitem.h"
 #include <string>
+#include <atomic>
+#include <functional>
 #include "xeffects/XEffects.h"
 #include "scenenodes/CloudSceneNode.h"
 #include "scenenodes/CLensFlareSceneNode.h"
@@ -49,6 +51,22 @@ const irr::f32 DbgWaypointCubeHeightDistance = 0.3f;
 #define DEF_RACE_PHASE_RACING 2
 #define DEF_RACE_PHASE_WAITUNTIL_ANIMATORS_DONE 3
 
+//steps of the race initialization, see ContinueInit
+#define DEF_RACE_INITSTEP_LOADTEXTURES 0
+#define DEF_RACE_INITSTEP_LEVELTEXTURES 1
+#define DEF_RACE_INITSTEP_TERRAIN 2
+#define DEF_RACE_INITSTEP_BLOCKS 3
+#define DEF_RACE_INITSTEP_ENTITIES 4
+#define DEF_RACE_INITSTEP_TERRAINMESH 5
+#define DEF_RACE_INITSTEP_COLLISION 6
+#define DEF_RACE_INITSTEP_SETUP 7
+#define DEF_RACE_INITSTEP_FINISH 8
+#define DEF_RACE_INITSTEP_DONE 9
+
+//number of level textures that are loaded from the request
+//queue per ContinueInit call, so that the load screen is updated
+#define DEF_RACE_LEVELTEX_LOADS_PER_STEP 16
+
 #define DEF_RACE_DBG_ALL 0
 #define DEF_RACE_DBG_WALLSEGMENTS 1
 #define DEF_RACE_DBG_WALLCOLLISIONMESH 2
@@ -61,6 +79,12 @@ const irr::f32 DbgWaypointCubeHeightDistance = 0.3f;
 #define DEF_RACE_DBG_ACTIVATEMORPHKEYTRG 9
 #define DEF_RACE_DBG_CHARGINGSTATIONINFO 10
 #define DEF_RACE_DBG_SHOWCLONERECORDING 11
+#define DEF_RACE_DBG_OCCLUSIONCULLING 12
+
+//area around a steam fountain that is used to find out if the
+//rising steam is inside of the camera view
+#define DEF_RACE_STEAMFOUNTAIN_VISRADIUS 1.5f
+#define DEF_RACE_STEAMFOUNTAIN_VISHEIGHT 5.0f
 
 struct RaceStatsEntryStruct {
     //player names in Hi-Octane are limited
@@ -122,6 +146,7 @@ class Path;
 class Camera;
 class ChargingStation;
 class SteamFountain;
+class ParticleBatchSceneNode;
 class LevelTerrain;
 class LevelBlocks;
 class Morph;
@@ -139,6 +164,11 @@ struct CloneAngle;
 struct CloneRecording;
 class VCalculations;
 class VVehicle;
+class OcclusionCulling;
+class VisibilityGrid;
+class LevelCache;
+struct ThreadPoolJob;
+class TriangleGrid;
 
 class Race {
 public:
@@ -159,8 +189,23 @@ public:
     void DrawHUD(irr::f32 frameDeltaTime);
 
     void AdvanceTime(irr::f32 frameDeltaTime);
-    void Init();
-    void AddPlayer(bool humanPlayer, char* name, std::string player_model);
+    //Starts the race initialization; Afterwards ContinueInit must be called once per frame until
+    //it returns true, then the initialization is finished (check ready for the result). Each call
+    //executes one step of the level loading; Work that does not need the Irrlicht device (level file
+    //parsing, terrain and block vertices, collision triangle grids, waypoint link analysis) runs on
+    //the thread pool while the caller keeps rendering, the main thread only creates the Irrlicht
+    //meshes and scene nodes out of it
+    void BeginInit();
+    bool ContinueInit();
+
+    //returns the initialization progress
+    //between 0.0 and 1.0
+    irr::f32 GetInitProgress();
+
+    //colorSchemeTex is the texture of the players color scheme, nullptr
+    //means player_model is used with its own texture
+    void AddPlayer(bool humanPlayer, char* name, std::string player_model,
+                   irr::video::ITexture* colorSchemeTex = nullptr);
     void End();
 
     void SetDebugFlag(irr::u8 debugFlag, bool enable);
@@ -221,6 +266,10 @@ public:
     //my explosion launcher
     ExplosionLauncher* mExplosionLauncher = nullptr;
 
+    //renders all particles (smoke, dust, steam, explosion debris)
+    //of this race with a few batched draw calls
+    ParticleBatchSceneNode* mParticleBatch = nullptr;
+
     //vector of all available explosions in
     //this map
     std::vector<ExplosionEntity*> mExplosionEntityVec;
@@ -229,6 +278,10 @@ public:
 
     bool DebugHitBreakpoint = false;
 
+    //if true the debug primitives of the current frame
+    //are written into a text file before they are drawn
+    bool mDumpDebugPrimitives = false;
+
     GameDbgWnd* mDbgWindow = nullptr;
 
     //debugging function which allows to draw a rectangle around a selected
@@ -327,6 +380,21 @@ public:
     void UpdatePlayersDbgFlag(irr::u8 debugFlag, bool enable);
     bool GetPlayersDbgFlagState(irr::u8 debugFlag);
 
+    //CPU side occlusion culling of race entities
+    //behind terrain and columns
+    OcclusionCulling* mOcclusionCulling = nullptr;
+
+    //uniform grid of race entities for view frustum culling
+    VisibilityGrid* mVisibilityGrid = nullptr;
+
+    //Must be called after the 3D scene was rendered, makes all
+    //scene nodes visible again that were hidden by occlusion culling
+    void RestoreOccludedSceneNodes();
+
+    //cache for data which is derived from the level file
+    //and expensive to calculate during each race start
+    LevelCache* mLevelCache = nullptr;
+
 private:
     std::string mLevelRootPath;
     std::string mLevelName;
@@ -408,9 +476,56 @@ private:
     bool DebugShowChargingStationInfo = false;
     bool DebugShowCloneRecording = false;
 
+    bool mOcclusionCullingEnabled = true;
+
+    void CreateOcclusionCulling();
+    void UpdateOcclusionCulling();
+
+    void CreateVisibilityGrid();
+    void UpdateVisibilityGrid();
+
+    //all entity scene nodes that are tested against
+    //the occlusion culling depth buffer each frame
+    std::vector<irr::scene::ISceneNode*> mOcclusionCandidateVec;
+
     void createEntity(EntityItem *p_entity, LevelFile *levelRes, LevelTerrain *levelTerrain, LevelBlocks* levelBlocks, irr::video::IVideoDriver *driver);
     bool LoadSkyImage(irr::video::IVideoDriver* driver, irr::core::dimension2d<irr::u32> screenResolution);
-    bool LoadLevel();
+    irr::u8 mInitStep = DEF_RACE_INITSTEP_LOADTEXTURES;
+
+    //background job of the current init
+    //step, nullptr if there is none
+    ThreadPoolJob* mInitJob = nullptr;
+
+    //true after the level textures the level file
+    //references were added to the request queue
+    bool mLevelTexRequested = false;
+
+    //progress inside of the current init step (for example of its background
+    //job), is written by the worker thread and read by GetInitProgress
+    std::atomic<irr::u32> mInitSubStep{0};
+    std::atomic<irr::u32> mInitNrSubSteps{0};
+
+    //starts the background job of the current init step, the job
+    //can increment mInitSubStep up to nrSubSteps
+    void AddInitJob(const std::string& description, irr::u32 nrSubSteps, std::function<void()> work);
+
+    //waits for the background job of the current init step and
+    //releases it; returns false if the job failed
+    bool FinishInitJob();
+
+    //the single steps of ContinueInit, return
+    //false in case of an error
+    bool LoadLevelTextures();
+    bool LoadRequestedLevelTextures();
+    bool LoadLevelTerrain();
+    bool LoadLevelBlocks();
+    bool LoadLevelEntities();
+    bool LoadLevelTerrainMesh();
+    bool LoadLevelCollision();
+    bool InitSetup();
+    bool InitFinish();
+
+    void LoadLevelFile(std::string levelfilename);
     void createLevelEntities();
 
     void DrawSky();
@@ -442,12 +557,29 @@ private:
     void createWallCollisionData();
     void createFinalCollisionData();
 
+    //the collision triangle grids of the wall collision mesh, the blocks and the terrain
+    //in the level cache; ReadCollisionGridsFromCache returns false if the cache has no
+    //collision grids, or they do not match the specified meshes
+    bool ReadCollisionGridsFromCache(std::vector<TriangleGrid*> &gridVec, const std::vector<irr::scene::IMesh*> &meshVec);
+    void WriteCollisionGridsToCache(std::vector<TriangleGrid*> &gridVec);
+
+    //returns the meshes we need collision triangles for, and their scene nodes
+    void GetCollisionMeshes(std::vector<irr::scene::IMesh*> &meshVec, std::vector<irr::scene::ISceneNode*> &sceneNodeVec);
+
+    //creates mCollisionGridVec for the specified meshes, does not use the
+    //Irrlicht device (only reads the meshbuffers), and runs on the thread pool
+    void createCollisionGrids(const std::vector<irr::scene::IMesh*> &meshVec);
+
+    //the collision triangle grids between createCollisionGrids and createFinalCollisionData,
+    //afterwards the triangle selectors own them
+    std::vector<TriangleGrid*> mCollisionGridVec;
+
     void DebugResetColorAllWayPointLinksToWhite();
 
     //holds a generated Mesh for wall collision detection
     irr::scene::SMesh* wallCollisionMesh = nullptr;
 
-    //holds the OctreeSceneNode for the wall collision detection
+    //holds the (invisible) SceneNode for the wall collision detection
     //we use this for trianglePicking later
     irr::scene::ISceneNode *wallCollisionMeshSceneNode = nullptr;
 
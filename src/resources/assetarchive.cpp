@@ -0,0 +1,485 @@
+/*
+ Copyright (C) 2026 Wolf Alexander
+
+ This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.                                          */
+
+#include "assetarchive.h"
+#include "../utils/logging.h"
+#include <algorithm>
+#include <filesystem>
+#include <cstdio>
+#include <cctype>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+//size of the header at the start of the archive file
+#define DEF_ASSETARCHIVE_HEADERSIZE 16
+
+//size of one index entry without the file name
+#define DEF_ASSETARCHIVE_INDEXENTRYSIZE 18
+
+static void WriteU16(FILE* oFile, irr::u16 value) {
+    irr::u8 bytes[2] = { (irr::u8)(value), (irr::u8)(value >> 8) };
+    fwrite(bytes, 1, 2, oFile);
+}
+
+static void WriteU32(FILE* oFile, irr::u32 value) {
+    irr::u8 bytes[4];
+
+    for (int idx = 0; idx < 4; idx++) {
+        bytes[idx] = (irr::u8)(value >> (idx * 8));
+    }
+
+    fwrite(bytes, 1, 4, oFile);
+}
+
+static void WriteU64(FILE* oFile, irr::u64 value) {
+    WriteU32(oFile, (irr::u32)(value));
+    WriteU32(oFile, (irr::u32)(value >> 32));
+}
+
+static irr::u16 ReadU16(const irr::u8* data) {
+    return (irr::u16)(data[0] | (data[1] << 8));
+}
+
+static irr::u32 ReadU32(const irr::u8* data) {
+    return ((irr::u32)(data[0])) | ((irr::u32)(data[1]) << 8) | ((irr::u32)(data[2]) << 16) |
+            ((irr::u32)(data[3]) << 24);
+}
+
+static irr::u64 ReadU64(const irr::u8* data) {
+    return ((irr::u64)(ReadU32(data))) | ((irr::u64)(ReadU32(data + 4)) << 32);
+}
+
+AssetArchive::AssetArchive(irr::io::IFileSystem* fileSystem, const char* archiveFileName) {
+    //Note: we do not grab the file system, because the
+    //file system itself holds a reference to the archive
+    mFileSystem = fileSystem;
+
+    irr::io::path absPath = mFileSystem->getAbsolutePath(irr::io::path(archiveFileName));
+    mBaseDir = NormalizeFileName(mFileSystem->getFileDir(absPath).c_str());
+
+    if ((mBaseDir.size() > 0) && (mBaseDir.back() != '/')) {
+        mBaseDir.push_back('/');
+    }
+
+    mFileList = mFileSystem->createEmptyFileList(irr::io::path(""), true, false);
+
+    if (!MapArchiveFile(archiveFileName))
+        return;
+
+    if (!ReadIndex()) {
+        std::string msg("AssetArchive: Archive file ");
+        msg.append(archiveFileName);
+        msg.append(" is not valid");
+        logging::Warning(msg);
+
+        UnmapArchiveFile();
+        return;
+    }
+
+    mReady = true;
+
+    char hlpstr[200];
+    snprintf(hlpstr, 200, "AssetArchive: Opened archive %s with %u files", archiveFileName,
+             (irr::u32)(mEntryVec.size()));
+    logging::Info(hlpstr);
+}
+
+AssetArchive::~AssetArchive() {
+    UnmapArchiveFile();
+
+    if (mFileList != nullptr) {
+        mFileList->drop();
+        mFileList = nullptr;
+    }
+}
+
+bool AssetArchive::IsReady() {
+    return mReady;
+}
+
+uint32_t AssetArchive::GetManifestChecksum() {
+    return mManifestChecksum;
+}
+
+bool AssetArchive::MapArchiveFile(const char* archiveFileName) {
+#ifdef _WIN32
+    HANDLE fileHandle = CreateFileA(archiveFileName, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                    FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+    if (fileHandle == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER fileSize;
+
+    if (!GetFileSizeEx(fileHandle, &fileSize) || (fileSize.QuadPart < DEF_ASSETARCHIVE_HEADERSIZE)) {
+        CloseHandle(fileHandle);
+        return false;
+    }
+
+    HANDLE mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+    if (mappingHandle == nullptr) {
+        CloseHandle(fileHandle);
+        return false;
+    }
+
+    void* view = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+
+    if (view == nullptr) {
+        CloseHandle(mappingHandle);
+        CloseHandle(fileHandle);
+        return false;
+    }
+
+    mFileHandle = fileHandle;
+    mMappingHandle = mappingHandle;
+    mData = (const irr::u8*)(view);
+    mDataSize = (size_t)(fileSize.QuadPart);
+#else
+    int fd = open(archiveFileName, O_RDONLY);
+
+    if (fd < 0)
+        return false;
+
+    struct stat fileStat;
+
+    if ((fstat(fd, &fileStat) != 0) || (fileStat.st_size < DEF_ASSETARCHIVE_HEADERSIZE)) {
+        close(fd);
+        return false;
+    }
+
+    void* view = mmap(nullptr, (size_t)(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+
+    //the mapping stays valid without the
+    //file descriptor
+    close(fd);
+
+    if (view == MAP_FAILED)
+        return false;
+
+    //we will need most of the assets, start reading the
+    //whole file now instead of page by page later
+    posix_madvise(view, (size_t)(fileStat.st_size), POSIX_MADV_WILLNEED);
+
+    mData = (const irr::u8*)(view);
+    mDataSize = (size_t)(fileStat.st_size);
+#endif
+
+    return true;
+}
+
+void AssetArchive::UnmapArchiveFile() {
+    if (mData == nullptr)
+        return;
+
+#ifdef _WIN32
+    UnmapViewOfFile(mData);
+    CloseHandle((HANDLE)(mMappingHandle));
+    CloseHandle((HANDLE)(mFileHandle));
+
+    mMappingHandle = nullptr;
+    mFileHandle = nullptr;
+#else
+    munmap((void*)(mData), mDataSize);
+#endif
+
+    mData = nullptr;
+    mDataSize = 0;
+}
+
+bool AssetArchive::ReadIndex() {
+    if (ReadU32(&mData[0]) != DEF_ASSETARCHIVE_MAGIC)
+        return false;
+
+    if (ReadU32(&mData[4]) != DEF_ASSETARCHIVE_VERSION)
+        return false;
+
+    irr::u32 nrEntries = ReadU32(&mData[8]);
+    mManifestChecksum = ReadU32(&mData[12]);
+
+    size_t pos = DEF_ASSETARCHIVE_HEADERSIZE;
+
+    mEntryVec.resize(nrEntries);
+
+    for (irr::u32 idx = 0; idx < nrEntries; idx++) {
+        if (pos + DEF_ASSETARCHIVE_INDEXENTRYSIZE > mDataSize)
+            return false;
+
+        AssetArchiveEntryStruct& entry = mEntryVec[idx];
+        entry.dataOffset = ReadU64(&mData[pos]);
+        entry.dataSize = ReadU64(&mData[pos + 8]);
+        irr::u16 fileNameLen = ReadU16(&mData[pos + 16]);
+
+        pos += DEF_ASSETARCHIVE_INDEXENTRYSIZE;
+
+        if (pos + fileNameLen > mDataSize)
+            return false;
+
+        entry.fileName.assign((const char*)(&mData[pos]), fileNameLen);
+        pos += fileNameLen;
+
+        //the entry data must be inside of the archive file, and a memory
+        //read file can not be larger than 2GB
+        if ((entry.dataOffset > mDataSize) || (entry.dataSize > mDataSize - entry.dataOffset) ||
+                (entry.dataSize > 0x7FFFFFFF))
+            return false;
+
+        mEntryLookup[NormalizeFileName(entry.fileName.c_str())] = idx;
+        mFileList->addItem(irr::io::path(entry.fileName.c_str()), (irr::u32)(entry.dataOffset),
+                           (irr::u32)(entry.dataSize), false, idx);
+    }
+
+    mFileList->sort();
+
+    return true;
+}
+
+std::string AssetArchive::NormalizeFileName(const char* fileName) {
+    std::string result(fileName);
+
+    std::replace(result.begin(), result.end(), '\\', '/');
+
+    std::transform(result.begin(), result.end(), result.begin(),
+                     [](unsigned char c){ return std::tolower(c); });
+
+    size_t pos;
+
+    while ((pos = result.find("//")) != std::string::npos) {
+        result.erase(pos, 1);
+    }
+
+    while (result.compare(0, 2, "./") == 0) {
+        result.erase(0, 2);
+    }
+
+    return result;
+}
+
+AssetArchiveEntryStruct* AssetArchive::FindEntry(const char* fileName) {
+    if (!mReady)
+        return nullptr;
+
+    std::string name = NormalizeFileName(fileName);
+
+    //Irrlicht requests textures with the absolute path
+    if ((mBaseDir.size() > 0) && (name.compare(0, mBaseDir.size(), mBaseDir) == 0)) {
+        name.erase(0, mBaseDir.size());
+    }
+
+    std::unordered_map<std::string, irr::u32>::iterator it = mEntryLookup.find(name);
+
+    if (it == mEntryLookup.end())
+        return nullptr;
+
+    return &mEntryVec[(*it).second];
+}
+
+bool AssetArchive::GetFileData(const char* fileName, const void*& data, size_t& dataSize) {
+    AssetArchiveEntryStruct* entry = FindEntry(fileName);
+
+    if (entry == nullptr)
+        return false;
+
+    data = &mData[entry->dataOffset];
+    dataSize = (size_t)(entry->dataSize);
+
+    return true;
+}
+
+irr::io::IReadFile* AssetArchive::createAndOpenFile(const irr::io::path& filename) {
+    AssetArchiveEntryStruct* entry = FindEntry(filename.c_str());
+
+    if (entry == nullptr)
+        return nullptr;
+
+    //the memory read file does not own the memory, it
+    //points directly into the mapped archive file
+    return mFileSystem->createMemoryReadFile((void*)(&mData[entry->dataOffset]), (irr::s32)(entry->dataSize),
+                                             filename, false);
+}
+
+irr::io::IReadFile* AssetArchive::createAndOpenFile(irr::u32 index) {
+    if (!mReady || (index >= mFileList->getFileCount()))
+        return nullptr;
+
+    AssetArchiveEntryStruct* entry = &mEntryVec[mFileList->getID(index)];
+
+    return mFileSystem->createMemoryReadFile((void*)(&mData[entry->dataOffset]), (irr::s32)(entry->dataSize),
+                                             irr::io::path(entry->fileName.c_str()), false);
+}
+
+const irr::io::IFileList* AssetArchive::getFileList() const {
+    return mFileList;
+}
+
+bool AssetArchive::Pack(const char* dirName, const char* archiveFileName, uint32_t manifestChecksum,
+                        std::vector<std::string> skipFileVec) {
+    namespace fs = std::filesystem;
+
+    std::vector<AssetArchiveEntryStruct> entryVec;
+    std::error_code ec;
+
+    for (fs::recursive_directory_iterator it(fs::path(dirName), ec), itEnd; it != itEnd; it.increment(ec)) {
+        if (ec)
+            break;
+
+        if (!it->is_regular_file(ec))
+            continue;
+
+        AssetArchiveEntryStruct newEntry;
+        newEntry.fileName = it->path().generic_string();
+        newEntry.dataSize = (irr::u64)(it->file_size(ec));
+
+        if (ec)
+            continue;
+
+        bool skip = false;
+        std::vector<std::string>::iterator itSkip;
+
+        for (itSkip = skipFileVec.begin(); itSkip != skipFileVec.end(); ++itSkip) {
+            if (newEntry.fileName.find(*itSkip) != std::string::npos) {
+                skip = true;
+                break;
+            }
+        }
+
+        if (!skip && (newEntry.fileName.size() <= 0xFFFF)) {
+            entryVec.push_back(newEntry);
+        }
+    }
+
+    if (ec) {
+        std::string msg("AssetArchive: Could not read directory ");
+        msg.append(dirName);
+        logging::Error(msg);
+        return false;
+    }
+
+    std::sort(entryVec.begin(), entryVec.end(),
+              [](const AssetArchiveEntryStruct& a, const AssetArchiveEntryStruct& b) { return a.fileName < b.fileName; });
+
+    //the data of all entries follows directly behind the index
+    irr::u64 dataOffset = DEF_ASSETARCHIVE_HEADERSIZE;
+    std::vector<AssetArchiveEntryStruct>::iterator it;
+
+    for (it = entryVec.begin(); it != entryVec.end(); ++it) {
+        dataOffset += DEF_ASSETARCHIVE_INDEXENTRYSIZE + (*it).fileName.size();
+    }
+
+    irr::u64 indexEnd = dataOffset;
+
+    for (it = entryVec.begin(); it != entryVec.end(); ++it) {
+        dataOffset = (dataOffset + DEF_ASSETARCHIVE_DATAALIGN - 1) & ~((irr::u64)(DEF_ASSETARCHIVE_DATAALIGN - 1));
+        (*it).dataOffset = dataOffset;
+        dataOffset += (*it).dataSize;
+    }
+
+    //write into a temporary file first, so that an existing archive
+    //is only replaced by a complete new one
+    std::string tmpFileName(archiveFileName);
+    tmpFileName.append(".tmp");
+
+    FILE* oFile = fopen(tmpFileName.c_str(), "wb");
+
+    if (oFile == nullptr) {
+        std::string msg("AssetArchive: Could not create archive file ");
+        msg.append(tmpFileName);
+        logging::Error(msg);
+        return false;
+    }
+
+    WriteU32(oFile, DEF_ASSETARCHIVE_MAGIC);
+    WriteU32(oFile, DEF_ASSETARCHIVE_VERSION);
+    WriteU32(oFile, (irr::u32)(entryVec.size()));
+    WriteU32(oFile, manifestChecksum);
+
+    for (it = entryVec.begin(); it != entryVec.end(); ++it) {
+        WriteU64(oFile, (*it).dataOffset);
+        WriteU64(oFile, (*it).dataSize);
+        WriteU16(oFile, (irr::u16)((*it).fileName.size()));
+        fwrite((*it).fileName.c_str(), 1, (*it).fileName.size(), oFile);
+    }
+
+    std::vector<irr::u8> buffer;
+    bool ok = true;
+
+    //current write position in the archive file
+    irr::u64 filePos = indexEnd;
+
+    for (it = entryVec.begin(); it != entryVec.end(); ++it) {
+        //padding up to the data of the next entry
+        while (ok && (filePos < (*it).dataOffset)) {
+            ok = (fputc(0, oFile) != EOF);
+            filePos++;
+        }
+
+        FILE* iFile = fopen((*it).fileName.c_str(), "rb");
+
+        if (iFile == nullptr) {
+            ok = false;
+        } else {
+            buffer.resize((size_t)((*it).dataSize));
+
+            //the file size could have changed since we have looked at it
+            if ((fread(buffer.data(), 1, buffer.size(), iFile) != buffer.size()) || (fgetc(iFile) != EOF)) {
+                ok = false;
+            }
+
+            fclose(iFile);
+        }
+
+        if (ok && (fwrite(buffer.data(), 1, buffer.size(), oFile) != buffer.size())) {
+            ok = false;
+        }
+
+        filePos += buffer.size();
+
+        if (!ok) {
+            std::string msg("AssetArchive: Could not add file ");
+            msg.append((*it).fileName);
+            msg.append(" to archive");
+            logging::Error(msg);
+            break;
+        }
+    }
+
+    if (fclose(oFile) != 0) {
+        ok = false;
+    }
+
+    if (ok) {
+        //rename fails on Windows if the target exists
+        std::remove(archiveFileName);
+        ok = (std::rename(tmpFileName.c_str(), archiveFileName) == 0);
+    }
+
+    if (!ok) {
+        std::remove(tmpFileName.c_str());
+        return false;
+    }
+
+    char hlpstr[200];
+    snprintf(hlpstr, 200, "AssetArchive: Packed %u files into archive %s", (irr::u32)(entryVec.size()), archiveFileName);
+    logging::Info(hlpstr);
+
+    return true;
+}
@@ -0,0 +1,113 @@
+/*
+ Copyright (C) 2026 Wolf Alexander
+
+ This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.                                          */
+
+#ifndef ASSETARCHIVE_H
+#define ASSETARCHIVE_H
+
+#include "irrlicht.h"
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <unordered_map>
+
+//the archive file is stored in the game root directory,
+//next to the extract directory
+#define DEF_ASSETARCHIVE_FILE "assets.pak"
+
+//"HIPK" in little endian
+#define DEF_ASSETARCHIVE_MAGIC 0x4B504948
+#define DEF_ASSETARCHIVE_VERSION 1
+
+//the data of each entry starts at a multiple of this
+#define DEF_ASSETARCHIVE_DATAALIGN 16
+
+//Archive file layout (all numbers little endian):
+//  Header: u32 magic, u32 version, u32 nrEntries, u32 manifestChecksum
+//  Index:  for each entry u64 dataOffset, u64 dataSize, u16 fileNameLen, fileName (not null terminated)
+//  Data:   file content of all entries, dataOffset is counted from the start of the archive file
+
+typedef struct AssetArchiveEntryStruct {
+    //path relative to the game root dir,
+    //for example "extract/sprites/tmaps-0001.png"
+    std::string fileName;
+    irr::u64 dataOffset = 0;
+    irr::u64 dataSize = 0;
+} AssetArchiveEntryStruct;
+
+//Read only Irrlicht file archive for the extracted game assets. Instead of thousands of small files
+//the archive is one file that is memory mapped; Files opened from the archive are memory read files that
+//point directly into the mapped view, so nothing is copied. The archive also serves files that are requested
+//with their absolute path, as the Irrlicht texture loading does
+class AssetArchive : public irr::io::IFileArchive {
+public:
+    //maps the archive file, use IsReady to check if this was successful
+    AssetArchive(irr::io::IFileSystem* fileSystem, const char* archiveFileName);
+    virtual ~AssetArchive();
+
+    //returns false if the archive file could not be mapped, or is not valid
+    bool IsReady();
+
+    //the checksum of the extraction manifest at the time the archive was packed,
+    //if the extracted data changed afterwards the archive is outdated
+    uint32_t GetManifestChecksum();
+
+    //returns false if the file is not part of the archive; Otherwise data points directly
+    //into the mapped archive, and stays valid as long as the archive exists
+    bool GetFileData(const char* fileName, const void*& data, size_t& dataSize);
+
+    //Irrlicht IFileArchive interface
+    virtual irr::io::IReadFile* createAndOpenFile(const irr::io::path& filename);
+    virtual irr::io::IReadFile* createAndOpenFile(irr::u32 index);
+    virtual const irr::io::IFileList* getFileList() const;
+
+    //Packs all files of directory dirName (including subdirectories) into a new archive file; Files
+    //whose name contains one of the strings in skipFileVec are not added
+    //returns false if the archive could not be written
+    static bool Pack(const char* dirName, const char* archiveFileName, uint32_t manifestChecksum,
+                     std::vector<std::string> skipFileVec);
+
+private:
+    irr::io::IFileSystem* mFileSystem = nullptr;
+    irr::io::IFileList* mFileList = nullptr;
+
+    //absolute path of the directory the archive is
+    //stored in, normalized, with trailing slash
+    std::string mBaseDir;
+
+    bool mReady = false;
+    uint32_t mManifestChecksum = 0;
+
+    std::vector<AssetArchiveEntryStruct> mEntryVec;
+
+    //normalized file name to index in mEntryVec
+    std::unordered_map<std::string, irr::u32> mEntryLookup;
+
+    //the memory mapped archive file
+    const irr::u8* mData = nullptr;
+    size_t mDataSize = 0;
+
+#ifdef _WIN32
+    void* mFileHandle = nullptr;
+    void* mMappingHandle = nullptr;
+#endif
+
+    bool MapArchiveFile(const char* archiveFileName);
+    void UnmapArchiveFile();
+
+    bool ReadIndex();
+
+    //returns nullptr if the file is not part of the archive
+    AssetArchiveEntryStruct* FindEntry(const char* fileName);
+
+    //lower case, only forward slashes, no double slashes
+    //and no leading "./"
+    static std::string NormalizeFileName(const char* fileName);
+};
+
+#endif // ASSETARCHIVE_H
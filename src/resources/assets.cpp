@@ -10,6 +10,7 @@
 #include "assets.h"
 #include "../game.h"
 #include "../race.h"
+#include "../utils/fileutils.h"
 
 /* 30.03.2025: Additional settings in CONFIG.DAT for extended original game version:
  *
@@ -798,20 +799,24 @@ char* Assets::GetNewMainPlayerName() {
     return this->currMainPlayerName;
 }
 
-std::string Assets::GetCraftModelName(char* craftName, irr::u8 selectedCraftColorScheme) {
-    CraftInfoStruct* craft = nullptr;
+CraftInfoStruct* Assets::FindCraft(char* craftName) {
     std::vector<CraftInfoStruct*>::iterator itCraft;
-    std::string resultStr("");
 
     //search the craft with the right name
     for (itCraft = this->mCraftVec->begin(); itCraft != this->mCraftVec->end(); ++itCraft) {
         if (strcmp((*itCraft)->name, craftName) == 0) {
             //we found the right craft
-            craft = (*itCraft);
-            break;
+            return (*itCraft);
         }
     }
 
+    return nullptr;
+}
+
+std::string Assets::GetCraftModelName(char* craftName, irr::u8 selectedCraftColorScheme) {
+    CraftInfoStruct* craft = FindCraft(craftName);
+    std::string resultStr("");
+
     if (craft != nullptr) {
         char* meshFileName = craft->meshFileName;
 
@@ -819,17 +824,34 @@ std::string Assets::GetCraftModelName(char* craftName, irr::u8 selectedCraftColo
             resultStr.push_back(meshFileName[idx]);
         }
 
+        irr::u8 schemeIdx = GetColorSchemeIndexNumberFromColorScheme(selectedCraftColorScheme);
+
+        //if the color scheme has a texture, it uses
+        //the model of the first color scheme
+        if (craft->TexCraft.at(schemeIdx) != nullptr) {
+            schemeIdx = 0;
+        }
+
         //add number for color scheme
         char number[5];
-        sprintf(number, "%d", GetColorSchemeIndexNumberFromColorScheme(selectedCraftColorScheme));
+        sprintf(number, "%d", schemeIdx);
 
         resultStr.push_back(number[0]);
-        resultStr.append(".obj");
+        resultStr.append(".hmesh");
     }
 
    return resultStr;
 }
 
+irr::video::ITexture* Assets::GetCraftColorSchemeTexture(char* craftName, irr::u8 selectedCraftColorScheme) {
+    CraftInfoStruct* craft = FindCraft(craftName);
+
+    if (craft == nullptr)
+        return nullptr;
+
+    return craft->TexCraft.at(GetColorSchemeIndexNumberFromColorScheme(selectedCraftColorScheme));
+}
+
 //rotates through the available color schemes, so
 //that every player has a different color scheme
 irr::u8 Assets::RotateColorScheme(irr::u8 currentColorScheme) {
@@ -1629,16 +1651,40 @@ void Assets::AddCraft(char* nameCraft, char* meshFileName, irr::u8 statSpeed, ir
     char fileName[40];
 
     irr::scene::IMesh* newMesh;
+    irr::video::ITexture* newTex;
     newCraft->MeshCraft.clear();
+    newCraft->TexCraft.clear();
 
-    //load the mesh
-    //lets loop to load all available ship color schemes
+    //all color schemes have the same geometry, therefore we
+    //only need to load the mesh of the first color scheme
+    sprintf(fileName, "%s0.hmesh", meshFileName);
+    irr::scene::IMesh* sharedMesh = mGame->mSmgr->getMesh(fileName);
+
+    //lets loop to setup all available ship color schemes
     for (int i = 0; i < 8; i++) {
-        sprintf(fileName, "%s%d.obj", meshFileName, i);
-        newMesh = mGame->mSmgr->getMesh(fileName);
+        newMesh = sharedMesh;
+        newTex = nullptr;
+
+        if (i > 0) {
+            //the data extraction creates a texture for each color scheme, which makes
+            //the first color scheme mesh look like this color scheme; If there is none
+            //(not possible for this color scheme, or older extracted data) we need to
+            //load the own mesh of this color scheme
+            sprintf(fileName, "%s%d-tex.png", meshFileName, i);
+
+            if (FileExists(fileName) == 1) {
+                newTex = mGame->mDriver->getTexture(fileName);
+            }
+
+            if (newTex == nullptr) {
+                sprintf(fileName, "%s%d.hmesh", meshFileName, i);
+                newMesh = mGame->mSmgr->getMesh(fileName);
+            }
+        }
 
         //add mesh to vector of available meshes (different color schemes)
         newCraft->MeshCraft.push_back(newMesh);
+        newCraft->TexCraft.push_back(newTex);
     }
 
     strcpy(newCraft->meshFileName, meshFileName);
@@ -1773,34 +1819,34 @@ void Assets::InitCrafts() {
 
 void Assets::InitRaceTracks() {
     //Track1
-    AddRaceTrack((char*)("1. AMAZON DELTA TURNPIKE"), (char*)("extract/models/track0-0.obj"), GAME_DEFAULT_LAPS_TRACK1);
+    AddRaceTrack((char*)("1. AMAZON DELTA TURNPIKE"), (char*)("extract/models/track0-0.hmesh"), GAME_DEFAULT_LAPS_TRACK1);
 
     //Track2
-    AddRaceTrack((char*)("2. TRANS-ASIA INTERSTATE"), (char*)("extract/models/track0-1.obj"), GAME_DEFAULT_LAPS_TRACK2);
+    AddRaceTrack((char*)("2. TRANS-ASIA INTERSTATE"), (char*)("extract/models/track0-1.hmesh"), GAME_DEFAULT_LAPS_TRACK2);
 
     //Track3
-    AddRaceTrack((char*)("3. SHANGHAI DRAGON"), (char*)("extract/models/track0-2.obj"), GAME_DEFAULT_LAPS_TRACK3);
+    AddRaceTrack((char*)("3. SHANGHAI DRAGON"), (char*)("extract/models/track0-2.hmesh"), GAME_DEFAULT_LAPS_TRACK3);
 
     //Track4
-    AddRaceTrack((char*)("4. NEW CHERNOBYL CENTRAL"), (char*)("extract/models/track0-3.obj"), GAME_DEFAULT_LAPS_TRACK4);
+    AddRaceTrack((char*)("4. NEW CHERNOBYL CENTRAL"), (char*)("extract/models/track0-3.hmesh"), GAME_DEFAULT_LAPS_TRACK4);
 
     //Track5
-    AddRaceTrack((char*)("5. SLAM CANYON"), (char*)("extract/models/track0-4.obj"), GAME_DEFAULT_LAPS_TRACK5);
+    AddRaceTrack((char*)("5. SLAM CANYON"), (char*)("extract/models/track0-4.hmesh"), GAME_DEFAULT_LAPS_TRACK5);
 
     //Track6
-    AddRaceTrack((char*)("6. THRAK CITY"), (char*)("extract/models/track0-5.obj"), GAME_DEFAULT_LAPS_TRACK6);
+    AddRaceTrack((char*)("6. THRAK CITY"), (char*)("extract/models/track0-5.hmesh"), GAME_DEFAULT_LAPS_TRACK6);
 
     //if we have the extended original game version available
     //also add the additional 3 race tracks
     if (mGame->mExtendedGame) {
         //Track7
-        AddRaceTrack((char*)("7. ANCIENT MINE TOWN"), (char*)("extract/models/track0-6.obj"), GAME_DEFAULT_LAPS_TRACK7);
+        AddRaceTrack((char*)("7. ANCIENT MINE TOWN"), (char*)("extract/models/track0-6.hmesh"), GAME_DEFAULT_LAPS_TRACK7);
 
         //Track8
-        AddRaceTrack((char*)("8. ARCTIC LAND"), (char*)("extract/models/track0-7.obj"), GAME_DEFAULT_LAPS_TRACK8);
+        AddRaceTrack((char*)("8. ARCTIC LAND"), (char*)("extract/models/track0-7.hmesh"), GAME_DEFAULT_LAPS_TRACK8);
 
         //Track9
-        AddRaceTrack((char*)("9. DEATH MATCH ARENA"), (char*)("extract/models/track0-8.obj"), GAME_DEFAULT_LAPS_TRACK9);
+        AddRaceTrack((char*)("9. DEATH MATCH ARENA"), (char*)("extract/models/track0-8.hmesh"), GAME_DEFAULT_LAPS_TRACK9);
     }
 }
 
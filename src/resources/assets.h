@@ -118,8 +118,16 @@ struct CraftInfoStruct {
     char meshFileName[50];
 
     //we have a vector of meshes, because each craft
-    //is available in different color schemes!
+    //is available in different color schemes! All color schemes
+    //share the mesh of the first color scheme, and only use another texture
+    //(see TexCraft); Only if there is no texture for a color scheme
+    //it has its own mesh
     std::vector<irr::scene::IMesh*> MeshCraft;
+
+    //the texture for each color scheme, which needs to be set
+    //for the scene node of MeshCraft; nullptr means the texture of
+    //the mesh itself is used
+    std::vector<irr::video::ITexture*> TexCraft;
 };
 
 struct PilotInfoStruct {
@@ -281,6 +289,10 @@ public:
 
     std::string GetCraftModelName(char* craftName, irr::u8 selectedCraftColorScheme);
 
+    //returns the texture that needs to be set for the model returned by GetCraftModelName,
+    //nullptr means the model is used with its own texture
+    irr::video::ITexture* GetCraftColorSchemeTexture(char* craftName, irr::u8 selectedCraftColorScheme);
+
     /**************************************
      * Pilot setup stuff                  *
      * ************************************/
@@ -398,6 +410,9 @@ private:
     RaceTrackInfoStruct* CreateNewDefaultRaceTrackStats(irr::u8 levelNr, irr::u8 defaultNrLaps);
     void AddRaceTrack(char* nameTrack, char* meshFileName, irr::u8 defaultNrLaps);
     void InitCrafts();
+    //returns nullptr if there is no craft with this name
+    CraftInfoStruct* FindCraft(char* craftName);
+
     void AddCraft(char* nameCraft, char* meshFileName, irr::u8 statSpeed, irr::u8 statArmour,
                   irr::u8 statWeight, irr::u8 statFirePower);
 
@@ -15,9 +15,9 @@
 #include "blockdefinition.h"
 #include "../utils/crc32.h"
 
-BlockDefinition::BlockDefinition(int id, int offset, std::vector<uint8_t> bytes)  {
+BlockDefinition::BlockDefinition(int id, int offset, const uint8_t* bytes)  {
    this->m_ID = id;
-   this->m_Bytes = bytes;
+   this->m_Bytes.assign(bytes, bytes + BLOCKDEFINITION_SIZE_BYTES);
    this->m_Offset = offset;
 
    //11.07.2025: East seems to be swapped
@@ -19,13 +19,18 @@
 #include <cstdint>
 #include "irrlicht.h"
 
+//each block definition is 16 bytes long
+#define BLOCKDEFINITION_SIZE_BYTES 16
+
 #define DEF_BLOCKDEF_STATE_DEFAULT 0
 #define DEF_BLOCKDEF_STATE_NEWLYADDED_KEEP 1
 #define DEF_BLOCKDEF_STATE_NEWLYUNASSIGNEDONE 2
 
 class BlockDefinition : public TableItem {
 public:
-    BlockDefinition(int id, int offset, std::vector<uint8_t> bytes);
+    //bytes points to the BLOCKDEFINITION_SIZE_BYTES bytes
+    //of this definition inside of the level file data
+    BlockDefinition(int id, int offset, const uint8_t* bytes);
     ~BlockDefinition();
 
     //alternative constructor for usage with the level editor
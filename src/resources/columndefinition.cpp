@@ -15,9 +15,9 @@
 #include "columndefinition.h"
 #include "../utils/crc32.h"
 
-ColumnDefinition::ColumnDefinition(int id, int offset, std::vector<uint8_t> bytes) {
+ColumnDefinition::ColumnDefinition(int id, int offset, const uint8_t* bytes) {
   this->m_ID = id;
-  this->m_Bytes = bytes;
+  this->m_Bytes.assign(bytes, bytes + COLUMNDEFINITION_SIZE_BYTES);
   this->m_Offset = offset;
 
   //for debugging of level saving, comment out later
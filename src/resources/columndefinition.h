@@ -19,13 +19,18 @@
 #include <vector>
 #include <cstdint>
 
+//each column definition is 26 bytes long
+#define COLUMNDEFINITION_SIZE_BYTES 26
+
 #define DEF_COLUMNDEF_STATE_DEFAULT 0
 #define DEF_COLUMNDEF_STATE_NEWLYADDED_KEEP 1
 #define DEF_COLUMNDEF_STATE_NEWLYUNASSIGNEDONE 2
 
 class ColumnDefinition : public TableItem {
 public:
-    ColumnDefinition(int id, int offset, std::vector<uint8_t> bytes);
+    //bytes points to the COLUMNDEFINITION_SIZE_BYTES bytes
+    //of this definition inside of the level file data
+    ColumnDefinition(int id, int offset, const uint8_t* bytes);
     ~ColumnDefinition();
 
     //Alternative constructor used for the level editor
@@ -16,9 +16,9 @@
 #include "../utils/crc32.h"
 #include "../definitions.h"
 
-EntityItem::EntityItem(int id, int offset, std::vector<uint8_t> bytes) {
+EntityItem::EntityItem(int id, int offset, const uint8_t* bytes) {
    this->m_ID = id;
-   this->m_Bytes = bytes;
+   this->m_Bytes.assign(bytes, bytes + ENTITYITEM_SIZE_BYTES);
    this->m_Offset = offset;
 
    //for debugging of level saving, comment out later
@@ -20,6 +20,9 @@
 #include <cstdint>
 
 //This two states are only used in the LevelEditor
+//each entity entry is 24 bytes long
+#define ENTITYITEM_SIZE_BYTES 24
+
 #define DEF_ENTITYITEM_STATE_DEFAULT 0
 #define DEF_ENTITYITEM_STATE_NEWLYUNASSIGNEDONE 1
 #define DEF_ENTITYITEM_STATE_LINKUPDATED 2
@@ -50,7 +53,9 @@ namespace Entity {
 class EntityItem : public TableItem {
 public:
     //constructor for entity items stored inside game level files
-    EntityItem(int id, int offset, std::vector<unsigned char> bytes);
+    //bytes points to the ENTITYITEM_SIZE_BYTES bytes
+    //of this entity inside of the level file data
+    EntityItem(int id, int offset, const uint8_t* bytes);
     virtual ~EntityItem();
 
     //special constructor that is only used in LevelEditor for creation of new
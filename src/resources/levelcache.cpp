@@ -0,0 +1,279 @@
+/*
+ Copyright (C) 2026 Wolf Alexander
+
+ This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.                                          */
+
+#include "levelcache.h"
+#include "../utils/crc32.h"
+#include "../utils/logging.h"
+#include <fstream>
+#include <cstring>
+#include <cstdio>
+
+LevelCache::LevelCache(Crc32* crc32, std::string cacheFileName, uint32_t levelFileChecksum) {
+    mCrc32 = crc32;
+    mCacheFileName = cacheFileName;
+    mLevelFileChecksum = levelFileChecksum;
+}
+
+LevelCache::~LevelCache() {
+    CleanUpSections();
+}
+
+void LevelCache::CleanUpSections() {
+    std::vector<LevelCacheSectionStruct*>::iterator it;
+
+    for (it = mSectionVec.begin(); it != mSectionVec.end(); ++it) {
+        delete (*it);
+    }
+
+    mSectionVec.clear();
+}
+
+//File layout (all values are stored little endian):
+//  uint32 magic
+//  uint32 cache version
+//  uint32 Crc32 checksum of the level file
+//  uint32 number of sections
+//  for each section: uint32 section Id, uint32 size in bytes, section data
+//  uint32 Crc32 checksum of all the bytes above
+bool LevelCache::Load() {
+    CleanUpSections();
+    mDirty = false;
+
+    std::ifstream ifile;
+    ifile.open(mCacheFileName, std::ifstream::binary);
+
+    if (!ifile) {
+        //no cache file available yet
+        return false;
+    }
+
+    ifile.seekg(0, std::ios::end);
+    std::streampos fileSize = ifile.tellg();
+    ifile.seekg(0, std::ios::beg);
+
+    //header and final checksum are the minimum
+    if ((size_t)(fileSize) < 5 * sizeof(uint32_t)) {
+        ifile.close();
+        logging::Warning("Level cache file is invalid, ignore it");
+        return false;
+    }
+
+    std::vector<uint8_t> bytes;
+    bytes.resize(fileSize);
+    ifile.read(reinterpret_cast<char*>(bytes.data()), bytes.size());
+
+    if (!ifile) {
+        ifile.close();
+        logging::Warning("Level cache file read error, ignore it");
+        return false;
+    }
+
+    ifile.close();
+
+    //first verify the checksum at the end of the file
+    size_t readIdx = bytes.size() - sizeof(uint32_t);
+    uint32_t storedChecksum = ReadUInt32(bytes, readIdx);
+
+    bytes.resize(bytes.size() - sizeof(uint32_t));
+
+    if (mCrc32->ComputeChecksum(bytes) != storedChecksum) {
+        logging::Warning("Level cache file checksum error, ignore it");
+        return false;
+    }
+
+    readIdx = 0;
+
+    if (ReadUInt32(bytes, readIdx) != LEVELCACHE_MAGIC) {
+        logging::Warning("Level cache file is invalid, ignore it");
+        return false;
+    }
+
+    if (ReadUInt32(bytes, readIdx) != LEVELCACHE_VERSION) {
+        logging::Info("Level cache file has an outdated version, ignore it");
+        return false;
+    }
+
+    if (ReadUInt32(bytes, readIdx) != mLevelFileChecksum) {
+        logging::Info("Level cache file does not match current level file, ignore it");
+        return false;
+    }
+
+    uint32_t nrSections = ReadUInt32(bytes, readIdx);
+
+    for (uint32_t idx = 0; idx < nrSections; idx++) {
+        if (readIdx + 2 * sizeof(uint32_t) > bytes.size()) {
+            CleanUpSections();
+            logging::Warning("Level cache file is truncated, ignore it");
+            return false;
+        }
+
+        LevelCacheSectionStruct* newSection = new LevelCacheSectionStruct();
+        newSection->sectionId = ReadUInt32(bytes, readIdx);
+        uint32_t sectionSize = ReadUInt32(bytes, readIdx);
+
+        if (readIdx + sectionSize > bytes.size()) {
+            delete newSection;
+            CleanUpSections();
+            logging::Warning("Level cache file is truncated, ignore it");
+            return false;
+        }
+
+        newSection->data.assign(bytes.begin() + readIdx, bytes.begin() + readIdx + sectionSize);
+        readIdx += sectionSize;
+
+        mSectionVec.push_back(newSection);
+    }
+
+    logging::Info("Level cache file loaded succesfully");
+
+    return true;
+}
+
+bool LevelCache::Save() {
+    //nothing new to write
+    if (!mDirty)
+        return true;
+
+    std::vector<uint8_t> bytes;
+
+    AppendUInt32(bytes, LEVELCACHE_MAGIC);
+    AppendUInt32(bytes, LEVELCACHE_VERSION);
+    AppendUInt32(bytes, mLevelFileChecksum);
+    AppendUInt32(bytes, (uint32_t)(mSectionVec.size()));
+
+    std::vector<LevelCacheSectionStruct*>::iterator it;
+
+    for (it = mSectionVec.begin(); it != mSectionVec.end(); ++it) {
+        AppendUInt32(bytes, (*it)->sectionId);
+        AppendUInt32(bytes, (uint32_t)((*it)->data.size()));
+        bytes.insert(bytes.end(), (*it)->data.begin(), (*it)->data.end());
+    }
+
+    uint32_t checksum = mCrc32->ComputeChecksum(bytes);
+    AppendUInt32(bytes, checksum);
+
+    std::ofstream ofile;
+    ofile.open(mCacheFileName, std::ofstream::binary | std::ofstream::trunc);
+
+    if (!ofile) {
+        logging::Warning("Could not create level cache file");
+        return false;
+    }
+
+    ofile.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+    ofile.close();
+
+    if (!ofile) {
+        logging::Warning("Level cache file write error");
+        //do not leave a partial cache file behind
+        std::remove(mCacheFileName.c_str());
+        return false;
+    }
+
+    mDirty = false;
+
+    logging::Info("Level cache file written succesfully");
+
+    return true;
+}
+
+LevelCacheSectionStruct* LevelCache::FindSection(uint32_t sectionId) {
+    std::vector<LevelCacheSectionStruct*>::iterator it;
+
+    for (it = mSectionVec.begin(); it != mSectionVec.end(); ++it) {
+        if ((*it)->sectionId == sectionId) {
+            return (*it);
+        }
+    }
+
+    return nullptr;
+}
+
+bool LevelCache::GetSection(uint32_t sectionId, std::vector<uint8_t> &outData) {
+    LevelCacheSectionStruct* section = FindSection(sectionId);
+
+    if (section == nullptr)
+        return false;
+
+    outData = section->data;
+
+    return true;
+}
+
+bool LevelCache::HasSection(uint32_t sectionId) {
+    return (FindSection(sectionId) != nullptr);
+}
+
+void LevelCache::SetSection(uint32_t sectionId, const std::vector<uint8_t> &data) {
+    LevelCacheSectionStruct* section = FindSection(sectionId);
+
+    if (section == nullptr) {
+        section = new LevelCacheSectionStruct();
+        section->sectionId = sectionId;
+        mSectionVec.push_back(section);
+    }
+
+    section->data = data;
+    mDirty = true;
+}
+
+void LevelCache::AppendUInt16(std::vector<uint8_t> &data, uint16_t value) {
+    data.push_back((uint8_t)(value & 0xFF));
+    data.push_back((uint8_t)((value >> 8) & 0xFF));
+}
+
+void LevelCache::AppendUInt32(std::vector<uint8_t> &data, uint32_t value) {
+    data.push_back((uint8_t)(value & 0xFF));
+    data.push_back((uint8_t)((value >> 8) & 0xFF));
+    data.push_back((uint8_t)((value >> 16) & 0xFF));
+    data.push_back((uint8_t)((value >> 24) & 0xFF));
+}
+
+void LevelCache::AppendFloat(std::vector<uint8_t> &data, float value) {
+    uint32_t rawValue;
+    std::memcpy(&rawValue, &value, sizeof(uint32_t));
+
+    AppendUInt32(data, rawValue);
+}
+
+uint16_t LevelCache::ReadUInt16(const std::vector<uint8_t> &data, size_t &readIdx) {
+    if (readIdx + sizeof(uint16_t) > data.size()) {
+        readIdx = data.size();
+        return 0;
+    }
+
+    uint16_t value = (uint16_t)((uint16_t)(data[readIdx]) | ((uint16_t)(data[readIdx + 1]) << 8));
+
+    readIdx += sizeof(uint16_t);
+
+    return value;
+}
+
+uint32_t LevelCache::ReadUInt32(const std::vector<uint8_t> &data, size_t &readIdx) {
+    if (readIdx + sizeof(uint32_t) > data.size()) {
+        readIdx = data.size();
+        return 0;
+    }
+
+    uint32_t value = (uint32_t)(data[readIdx]) | ((uint32_t)(data[readIdx + 1]) << 8) |
+            ((uint32_t)(data[readIdx + 2]) << 16) | ((uint32_t)(data[readIdx + 3]) << 24);
+
+    readIdx += sizeof(uint32_t);
+
+    return value;
+}
+
+float LevelCache::ReadFloat(const std::vector<uint8_t> &data, size_t &readIdx) {
+    uint32_t rawValue = ReadUInt32(data, readIdx);
+
+    float value;
+    std::memcpy(&value, &rawValue, sizeof(float));
+
+    return value;
+}
@@ -0,0 +1,105 @@
+/*
+ Copyright (C) 2026 Wolf Alexander
+
+ This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.                                          */
+
+#ifndef LEVELCACHE_H
+#define LEVELCACHE_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+//name of the cache file inside of the level folder
+#define LEVELCACHE_FILENAME "levelcache.dat"
+
+//first 4 bytes of each cache file
+#define LEVELCACHE_MAGIC 0x434C4F48   //"HOLC"
+
+//increase this version number every time the
+//content or format of a cached section changes,
+//this invalidates all existing cache files
+#define LEVELCACHE_VERSION 2
+
+//Ids of the available data sections
+//inside a cache file
+#define LEVELCACHE_SECTION_STATICWORLDMAP 1
+#define LEVELCACHE_SECTION_WAYPOINTOFFSETRANGE 2
+#define LEVELCACHE_SECTION_TERRAINMESH 3
+#define LEVELCACHE_SECTION_TERRAINMESHENDOFMAP 4
+#define LEVELCACHE_SECTION_BLOCKMESH 5
+#define LEVELCACHE_SECTION_COLLISIONTRIANGLES 6
+
+/************************
+ * Forward declarations *
+ ************************/
+
+class Crc32;
+
+struct LevelCacheSectionStruct {
+    uint32_t sectionId;
+    std::vector<uint8_t> data;
+};
+
+//The level cache stores data that is derived from the level file
+//and that takes long to calculate (but is the same every time
+//the level is loaded) in a binary file inside of the level folder.
+//The cache file is keyed with the Crc32 checksum of the level file, if the
+//level file is modified (for example by the level editor), the cache file
+//is not used anymore and is recreated during the next race start
+class LevelCache {
+public:
+    LevelCache(Crc32* crc32, std::string cacheFileName, uint32_t levelFileChecksum);
+    ~LevelCache();
+
+    //Tries to load the cache file from disk
+    //returns true if the cache file exists and is valid for
+    //the current level file, false otherwise
+    bool Load();
+
+    //Writes the cache file to disk if there
+    //were new sections added since the last load
+    //returns true in case of success, false otherwise
+    bool Save();
+
+    //Returns true if the specified section is available
+    //and copies the data into outData, false otherwise
+    bool GetSection(uint32_t sectionId, std::vector<uint8_t> &outData);
+
+    //Returns true if the specified section is available
+    bool HasSection(uint32_t sectionId);
+
+    //Adds a new section to the cache, or replaces
+    //an already existing one with the same Id
+    void SetSection(uint32_t sectionId, const std::vector<uint8_t> &data);
+
+    //helper functions to serialize data
+    //for the cache sections
+    static void AppendUInt16(std::vector<uint8_t> &data, uint16_t value);
+    static void AppendUInt32(std::vector<uint8_t> &data, uint32_t value);
+    static void AppendFloat(std::vector<uint8_t> &data, float value);
+    static uint16_t ReadUInt16(const std::vector<uint8_t> &data, size_t &readIdx);
+    static uint32_t ReadUInt32(const std::vector<uint8_t> &data, size_t &readIdx);
+    static float ReadFloat(const std::vector<uint8_t> &data, size_t &readIdx);
+
+private:
+    Crc32* mCrc32 = nullptr;
+
+    std::string mCacheFileName;
+    uint32_t mLevelFileChecksum;
+
+    std::vector<LevelCacheSectionStruct*> mSectionVec;
+
+    //true if there is data which was not
+    //written to disk yet
+    bool mDirty = false;
+
+    LevelCacheSectionStruct* FindSection(uint32_t sectionId);
+    void CleanUpSections();
+};
+
+#endif // LEVELCACHE_H
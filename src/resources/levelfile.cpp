@@ -49,10 +49,19 @@
 
 */
 
-LevelFile::LevelFile(InfrastructureBase* infra, std::string filename, bool runAsExtendedGame) {
+LevelFile::LevelFile(InfrastructureBase* infra, std::string filename, bool runAsExtendedGame) :
+    LevelFile(infra->mCrc32, filename, runAsExtendedGame) {
+   //the level editor loads the levels of the extended game
+   //with runAsExtendedGame false, but must save them like the
+   //extended game does
+   this->mExtendedGame = infra->mExtendedGame;
+}
+
+LevelFile::LevelFile(Crc32* crc32, std::string filename, bool runAsExtendedGame) {
    this->m_Filename = filename;
    this->m_Ready = false;
-   this->mInfra = infra;
+   this->mCrc32 = crc32;
+   this->mExtendedGame = runAsExtendedGame;
 
    bool ready_result;
 
@@ -104,6 +113,10 @@ LevelFile::LevelFile(InfrastructureBase* infra, std::string filename, bool runAs
         return;
     }
 
+    //remember the checksum of the original file data, this is used
+    //to find out if cached data derived from this level file is still valid
+    this->m_Checksum = mCrc32->ComputeChecksum(this->m_bytes);
+
     ready_result = loadBlockTexTable() && loadColumnsTable() && loadMapEntries() && loadEntitiesTable() &&
             loadMapRegions() && loadFrictionTable();
 
@@ -222,15 +235,8 @@ LevelFile::~LevelFile() {
         mThingList = nullptr;
     }
 
-    //delete all MapEntry objects
-    for (int y = 0; y < Height(); y++) {
-     for (int x = 0; x < Width(); x++) {
-
-         MapEntry *entry = this->pMap[x][y];
-         delete entry;
-         this->pMap[x][y] = nullptr;
-     }
-    }
+    //Note: the MapEntry objects are part of mMapEntryVec
+    //and are freed together with it
 }
 
 int LevelFile::Width() {
@@ -265,6 +271,10 @@ void LevelFile::set_Ready(bool newstate) {
     this->m_Ready = newstate;
 }
 
+uint32_t LevelFile::GetChecksum() {
+    return(this->m_Checksum);
+}
+
 //if no entity whith this Id is found, returns false
 bool LevelFile::ReturnEntityItemWithId(int searchId, EntityItem **fndItem) {
     bool notFound = true;
@@ -284,22 +294,19 @@ bool LevelFile::ReturnEntityItemWithId(int searchId, EntityItem **fndItem) {
 }
 
 bool LevelFile::loadEntitiesTable() {
-    std::vector<uint8_t>::const_iterator startslice;
-    std::vector<uint8_t>::const_iterator endslice;
-    std::vector<uint8_t> dataslice;
+    const uint8_t* record;
 
     this->Entities.clear();
 
     //index starts at i = 1, Entry i = 0 is not used
     for (int i = 1; i < 4000; i++) {
-        int baseOffset = i * 24;
-        if (this->m_bytes.at(baseOffset) == 0) continue;
+        int baseOffset = i * ENTITYITEM_SIZE_BYTES;
 
-        startslice = this->m_bytes.begin() + baseOffset;
-        endslice = this->m_bytes.begin()+ baseOffset + 24;
-        dataslice.assign(startslice, endslice);
+        record = GetRecordData(baseOffset, ENTITYITEM_SIZE_BYTES);
+        if (record == nullptr) return(false);
+        if (record[0] == 0) continue;
 
-        EntityItem *item = new EntityItem(i, baseOffset, dataslice);
+        EntityItem *item = new EntityItem(i, baseOffset, record);
         item->setY(this->pMap[item->getCell().X][item->getCell().Y]->m_Height);
         this->Entities.push_back(item);
 
@@ -319,15 +326,9 @@ bool LevelFile::loadThingListData() {
     //Create a new "ThingList" struct
     mThingList = new ThingListStruct;
 
-    std::vector<uint8_t>::const_iterator startslice;
-    std::vector<uint8_t>::const_iterator endslice;
-    std::vector<uint8_t> dataslice;
-
     //data starts at Offset 96000      => Offset 98011
-    startslice = this->m_bytes.begin() + 96000;
-    endslice = this->m_bytes.begin() + 96000 + 2012; //2011 bytes long
-
-    dataslice.assign(startslice, endslice);
+    const uint8_t* dataslice = GetRecordData(96000, 2012); //2011 bytes long
+    if (dataslice == nullptr) return(false);
 
     unsigned int currOff = 0;
 
@@ -398,9 +399,7 @@ bool LevelFile::loadFrictionTable() {
  }
 
 bool LevelFile::loadBlockTexTable() {
-    std::vector<uint8_t>::const_iterator startslice;
-    std::vector<uint8_t>::const_iterator endslice;
-    std::vector<uint8_t> dataslice;
+    const uint8_t* record;
 
     this->BlockDefinitions.clear();
 
@@ -408,14 +407,13 @@ bool LevelFile::loadBlockTexTable() {
 
     //index starts at i = 1, Entry i = 0 is not used
     for (int i = 1; i < 1024; i++) {
-        int baseOffset = 124636 + i * 16;
-        if (this->m_bytes.at(baseOffset) == 0) continue;
+        int baseOffset = 124636 + i * BLOCKDEFINITION_SIZE_BYTES;
 
-        startslice = this->m_bytes.begin() + baseOffset;
-        endslice = this->m_bytes.begin()+ baseOffset + 16;
-        dataslice.assign(startslice, endslice);
+        record = GetRecordData(baseOffset, BLOCKDEFINITION_SIZE_BYTES);
+        if (record == nullptr) return(false);
+        if (record[0] == 0) continue;
 
-        BlockDefinition *item = new BlockDefinition(i, baseOffset, dataslice);
+        BlockDefinition *item = new BlockDefinition(i, baseOffset, record);
         this->BlockDefinitions.push_back(item);
 
         //next lines are only for level writting debugging
@@ -431,22 +429,19 @@ bool LevelFile::loadBlockTexTable() {
 }
 
 bool LevelFile::loadColumnsTable() {
-    std::vector<uint8_t>::const_iterator startslice;
-    std::vector<uint8_t>::const_iterator endslice;
-    std::vector<uint8_t> dataslice;
+    const uint8_t* record;
 
     this->ColumnDefinitions.clear();
 
     //index starts at i = 1, Entry i = 0 is not used
     for (int i = 1; i < 1024; i++) {
-        int baseOffset = 98012 + i * 26;
-        if (this->m_bytes.at(baseOffset) == 0) continue;
+        int baseOffset = 98012 + i * COLUMNDEFINITION_SIZE_BYTES;
 
-        startslice = this->m_bytes.begin() + baseOffset;
-        endslice = this->m_bytes.begin()+ baseOffset + 26;
-        dataslice.assign(startslice, endslice);
+        record = GetRecordData(baseOffset, COLUMNDEFINITION_SIZE_BYTES);
+        if (record == nullptr) return(false);
+        if (record[0] == 0) continue;
 
-        ColumnDefinition *item = new ColumnDefinition(i, baseOffset, dataslice);
+        ColumnDefinition *item = new ColumnDefinition(i, baseOffset, record);
         this->ColumnDefinitions.push_back(item);
 
         //next lines are only for level writting debugging
@@ -461,11 +456,14 @@ bool LevelFile::loadColumnsTable() {
  return(true);
 }
 
-bool LevelFile::loadMapEntries() {
-    std::vector<uint8_t>::const_iterator startslice;
-    std::vector<uint8_t>::const_iterator endslice;
-    std::vector<uint8_t> dataslice;
+const uint8_t* LevelFile::GetRecordData(size_t offset, size_t recordSize) {
+    if (offset + recordSize > this->m_bytes.size())
+        return nullptr;
+
+    return &this->m_bytes[offset];
+}
 
+bool LevelFile::loadMapEntries() {
     ColumnsStruct NewStruct;
     MapPointOfInterest poi;
 
@@ -477,17 +475,24 @@ bool LevelFile::loadMapEntries() {
     //Map = new MapEntry[Width, Height];
 
     // entry is 12 bytes long, map is at end of file
-    int numBytes = 12 * Width() * Height();
+    int numBytes = MAPENTRY_SIZE_BYTES * Width() * Height();
+
+    if ((int)(this->m_bytes.size()) < numBytes) {
+        logging::Error("Level file too small, map entries missing");
+        return false;
+    }
 
     int i = (int)(this->m_bytes.size()) - numBytes;
 
+    //reserve the whole array first, so that the pointers in
+    //pMap stay valid while we add the entries
+    mMapEntryVec.clear();
+    mMapEntryVec.reserve(Width() * Height());
+
     for (int y = 0; y < Height(); y++) {
      for (int x = 0; x < Width(); x++) {
-         startslice = this->m_bytes.begin() + i;
-         endslice = this->m_bytes.begin()+ i + 12;
-         dataslice.assign(startslice, endslice);
-
-         MapEntry *entry = new MapEntry(x, y, i, dataslice, ColumnDefinitions);
+         mMapEntryVec.emplace_back(x, y, i, GetRecordData(i, MAPENTRY_SIZE_BYTES), ColumnDefinitions);
+         MapEntry *entry = &mMapEntryVec.back();
 
          if (entry->get_Column() != nullptr) {
               NewStruct.Vector3 = irr::core::vector3d<float>((irr::f32)(x), 0.0f, (irr::f32)(y));
@@ -498,15 +503,9 @@ bool LevelFile::loadMapEntries() {
 
          this->pMap[x][y] = entry;
 
-         /*entry->WriteChanges();
-         if (!std::equal (startslice,endslice, entry->m_wBytes.begin())) {
-             //there is an unexpected difference in the written data
-             std::cout << "Unexpected difference in written MapEntry data!" << std::endl << std::flush;
-         }*/
-
          // check for points of interest, this POI then point into the region definition table
          //there we find the size of each region in number of cells and of what type this region is
-        int16_t poiValue = (this->m_bytes.at(i + 7) << 8) | this->m_bytes.at(i + 6);
+        int16_t poiValue = entry->mPointOfInterest;
         if (poiValue > 0) {
             poi.Value = poiValue;
             poi.cellCoord.X = x;
@@ -516,7 +515,7 @@ bool LevelFile::loadMapEntries() {
             PointsOfInterest.push_back(poi);
          }
 
-        i += 12;
+        i += MAPENTRY_SIZE_BYTES;
     }
    }
 
@@ -952,7 +951,7 @@ bool LevelFile::AddRegion(irr::u8 whichRegionId, irr::core::vector2df coord1, ir
    //Byte 18 seems to only contain value 1 if entry is used, not interesting to read, but we need to write it like that
    regionTable.at(whichRegionId * 85 + 18) = (uint8_t)(1);
 
-   if (!mInfra->mExtendedGame) {
+   if (!mExtendedGame) {
        //Only for the original game (non-extended version):
        //Byte 19 seems to only contain value 1 if entry is used, not interesting to read, but we need to write it like that
        regionTable.at(whichRegionId * 85 + 19) = (uint8_t)(1);
@@ -988,7 +987,7 @@ bool LevelFile::AddRegion(irr::u8 whichRegionId, irr::core::vector2df coord1, ir
    irr::f32 deltaX = (pntr->tileXmax - pntr->tileXmin) * 0.5f;
    irr::f32 deltaY = (pntr->tileYmax - pntr->tileYmin) * 0.5f;
 
-   if (mInfra->mExtendedGame) {
+   if (mExtendedGame) {
        //Bytes 39 & 40 have different values for the non extended game over the different levels (I saw in levels 1 and 2, I did not check
        //for the other levels), and the extended version of the game has (compared with non extended game another)
        //the same value for all levels, except level 7 which is an exception).
@@ -1667,12 +1666,9 @@ bool LevelFile::saveMapEntries() {
         mapEntry = this->pMap[x][y];
 
         if (mapEntry != nullptr) {
-            //first prepare updated/new data
-            mapEntry->WriteChanges();
-
-            //copy new data to overall save data array
-            std::copy(mapEntry->m_wBytes.begin(), mapEntry->m_wBytes.end(), this->m_wBytes.begin()
-                      + mapEntry->get_Offset());
+            //write the entry directly into the
+            //overall save data array
+            mapEntry->WriteChanges(&this->m_wBytes[mapEntry->get_Offset()]);
         }
       }
     }
@@ -24,6 +24,7 @@
 #include <string>
 #include <cstdint>
 #include "entityitem.h"
+#include "mapentry.h"
 
 #define LEVELFILE_WIDTH 256
 #define LEVELFILE_HEIGHT 160
@@ -44,10 +45,10 @@ using namespace std;
  ************************/
 
 class BlockDefinition;
-class MapEntry;
 class EntityItem;
 class ColumnDefinition;
 class InfrastructureBase;
+class Crc32;
 
 struct MapPointOfInterest {
       irr::core::vector3d<float> Position;
@@ -93,6 +94,10 @@ struct ThingListStruct {
 class LevelFile {
 public:
     LevelFile(InfrastructureBase* infra, std::string filename, bool runAsExtendedGame);
+
+    //for tools without an InfrastructureBase (for example the level compiler hi-levelc),
+    //the level is loaded in the same way
+    LevelFile(Crc32* crc32, std::string filename, bool runAsExtendedGame);
     ~LevelFile();
 
     int Width();
@@ -107,6 +112,10 @@ public:
     bool get_Ready();
     void set_Ready(bool newstate);
 
+    //Returns the Crc32 checksum of the level file
+    //data that was read from disk
+    uint32_t GetChecksum();
+
     bool Save(std::string filename);
 
     MapEntry* pMap[LEVELFILE_WIDTH][LEVELFILE_HEIGHT];
@@ -257,10 +266,26 @@ protected:
      std::string m_Name;
      bool m_Ready;
 
-     InfrastructureBase* mInfra = nullptr;
+     Crc32* mCrc32 = nullptr;
+
+     //true if the region table has to be
+     //written like the extended game does
+     bool mExtendedGame = false;
 
      std::vector<uint8_t> m_bytes;
 
+     //all map entries in one contiguous array, pMap
+     //points into this array
+     std::vector<MapEntry> mMapEntryVec;
+
+     //returns a pointer to the record with the specified size at offset
+     //inside of the level file data, or nullptr if the file is too small
+     const uint8_t* GetRecordData(size_t offset, size_t recordSize);
+
+     //Crc32 checksum of m_bytes when the
+     //level file was loaded
+     uint32_t m_Checksum = 0;
+
      //for debugging of level write and
      //modification function, disable later
      //to save much memory
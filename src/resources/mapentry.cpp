@@ -17,19 +17,19 @@
 #include "../utils/crc32.h"
 #include "../utils/logging.h"
 #include "columndefinition.h"
+#include <type_traits>
 
-MapEntry::MapEntry(int x, int z, int offset, std::vector<uint8_t> bytes, std::vector<ColumnDefinition*> columnDefinitions) {
+//all map entries of a level are stored in one array, and
+//are created and dropped without running any destructors
+static_assert(std::is_trivially_copyable<MapEntry>::value, "MapEntry must stay a plain data class");
+
+MapEntry::MapEntry(int x, int z, int offset, const uint8_t* bytes, const std::vector<ColumnDefinition*> &columnDefinitions) {
     this->m_X = x;
     this->m_Z = z;
 
     this->m_Offset = offset;
-    this->m_Bytes = bytes;
     this->m_Column = nullptr;
 
-    //for debugging of level saving, comment out later
-    this->m_wBytes.resize(this->m_Bytes.size());
-    std::fill(m_wBytes.begin(), m_wBytes.begin() + this->m_Bytes.size(), 0);
-
     //each map entry is 12 bytes long
     //Byte 0:  Cell Illumination value: This value controls how well illuminated a cell is
     //Byte 1:  Cell Illumination value: This value controls how well illuminated a cell is
@@ -48,29 +48,29 @@ MapEntry::MapEntry(int x, int z, int offset, std::vector<uint8_t> bytes, std::ve
     //game. Is not a single time non zero. Was maybe reserved for
     //a future expansion, and never used (maybe reserved).
 
-    this->m_Height = (((float)(bytes.at(2))) / 256.0f) + (float)(bytes.at(3));
+    this->m_Height = (((float)(bytes[2])) / 256.0f) + (float)(bytes[3]);
 
     int16_t cid = ConvertByteArray_ToInt16(bytes, 4);
 
     if (cid < 0) { // is column of blocks?
        uint16_t element = -cid - 1;
        //std::cout << "Element " << element << std::endl;
-       if (element > columnDefinitions.size()-1) {
+       if (element >= columnDefinitions.size()) {
         //error this should never happen
            logging::Error("Column ID outside allowed size found!!! This should not happen");
        } else {
            //use the next if statement for debugging purposes, if you one want to add columns
            //in the level with specific column definition numbers
            //if (element == 0) {
-               this->m_Column = columnDefinitions.at(element);
+               this->m_Column = columnDefinitions[element];
            //}
 
-           cid = columnDefinitions.at(element)->get_FloorTextureID();
+           cid = columnDefinitions[element]->get_FloorTextureID();
        }
     }
 
     this->m_TextureId = cid;
-    this->m_TextureModification = (uint8_t)(bytes.at(10));
+    this->m_TextureModification = (uint8_t)(bytes[10]);
 
     mPointOfInterest = ConvertByteArray_ToInt16(bytes, 6);
 
@@ -79,10 +79,7 @@ MapEntry::MapEntry(int x, int z, int offset, std::vector<uint8_t> bytes, std::ve
 
     //read also unknown data
     mReserved1 = ConvertByteArray_ToInt16(bytes, 8);
-    mReserved2 = bytes.at(11);
-}
-
-MapEntry::~MapEntry() {
+    mReserved2 = bytes[11];
 }
 
 int8_t MapEntry::GetTextureModification() {
@@ -137,17 +134,21 @@ void MapEntry::set_Z(int new_Z) {
     this->m_Z = new_Z;
 }
 
-bool MapEntry::WriteChanges() {
+int MapEntry::get_Offset() {
+    return(this->m_Offset);
+}
+
+void MapEntry::WriteChanges(uint8_t* targetBytes) {
     //convert height information to bytes
     /*unsigned char div = (unsigned char)(this->m_Height / 255.0f);
     float remainder = (this->m_Height - float(div));
     unsigned char rem = (unsigned char)(remainder);
 
-    this->m_wBytes.at(2) = div;
-    this->m_wBytes.at(3) = rem;*/
+    targetBytes[2] = div;
+    targetBytes[3] = rem;*/
 
     //convert height information to bytes
-    ConvertAndWriteFloatToByteArray(this->m_Height, this->m_wBytes, 2);
+    ConvertAndWriteFloatToByteArray(this->m_Height, targetBytes, 2);
 
     //is this a column at this location
     if (this->get_Column() != nullptr) {
@@ -157,22 +158,20 @@ bool MapEntry::WriteChanges() {
 
         int16_t cid = -element;
 
-        ConvertAndWriteInt16ToByteArray(cid, this->m_wBytes, 4);
+        ConvertAndWriteInt16ToByteArray(cid, targetBytes, 4);
     } else {
         //no column, just write texture ID
-        ConvertAndWriteInt16ToByteArray(m_TextureId, this->m_wBytes, 4);
+        ConvertAndWriteInt16ToByteArray(m_TextureId, targetBytes, 4);
     }
 
-    this->m_wBytes.at(10) = (uint8_t)(this->m_TextureModification);
+    targetBytes[10] = (uint8_t)(this->m_TextureModification);
 
-    ConvertAndWriteInt16ToByteArray(mPointOfInterest, this->m_wBytes, 6);
+    ConvertAndWriteInt16ToByteArray(mPointOfInterest, targetBytes, 6);
 
     //write illumination value (how much light does a cell receive)
-    ConvertAndWriteInt16ToByteArray(mIllumination, this->m_wBytes, 0);
+    ConvertAndWriteInt16ToByteArray(mIllumination, targetBytes, 0);
 
     //write also unknown data
-    ConvertAndWriteInt16ToByteArray(mReserved1, this->m_wBytes, 8);
-    this->m_wBytes.at(11) = (uint8_t)(mReserved2);
-
-    return true;
+    ConvertAndWriteInt16ToByteArray(mReserved1, targetBytes, 8);
+    targetBytes[11] = (uint8_t)(mReserved2);
 }
@@ -17,7 +17,9 @@
 
 #include <cstdint>
 #include <vector>
-#include "tableitem.h"
+
+//each map entry is 12 bytes long
+#define MAPENTRY_SIZE_BYTES 12
 
 /************************
  * Forward declarations *
@@ -25,10 +27,14 @@
 
 class ColumnDefinition;
 
-class MapEntry:public TableItem {
+//Note: MapEntry is a plain data class without virtual functions or own heap memory; All map entries
+//of a level are stored in one contiguous array inside of the LevelFile, and are parsed directly from the
+//level file data. Therefore do not add members here that need a destructor
+class MapEntry {
 public:
-    MapEntry(int x, int z, int offset, std::vector<uint8_t> bytes, std::vector<ColumnDefinition*> columnDefinitions);
-    virtual ~MapEntry();
+    //bytes points to the MAPENTRY_SIZE_BYTES bytes of
+    //this entry inside of the level file data
+    MapEntry(int x, int z, int offset, const uint8_t* bytes, const std::vector<ColumnDefinition*> &columnDefinitions);
 
     float m_Height;
     int16_t m_TextureId;
@@ -40,7 +46,12 @@ public:
     void set_Column(ColumnDefinition* newColumnDefinition);
     ColumnDefinition* get_Column();
 
-    bool WriteChanges() override;
+    //offset of this entry inside of the level file
+    int get_Offset();
+
+    //writes the MAPENTRY_SIZE_BYTES bytes of this entry
+    //into the level file data at targetBytes
+    void WriteChanges(uint8_t* targetBytes);
 
     void SetTextureModification(int8_t newValue);
     int8_t GetTextureModification();
@@ -65,6 +76,7 @@ public:
 protected:
     int m_X;
     int m_Z;
+    int m_Offset;
 
     ColumnDefinition* m_Column = nullptr;
 
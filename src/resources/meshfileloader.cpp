@@ -0,0 +1,161 @@
+/*
+ Copyright (C) 2026 Wolf Alexander
+
+ This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.                                          */
+
+#include "meshfileloader.h"
+#include "../utils/logging.h"
+#include <string>
+#include <vector>
+
+//the vertices are read directly into the
+//mesh buffer, see file layout in header
+static_assert(sizeof(irr::video::S3DVertex) == 36, "Unexpected memory layout of irr::video::S3DVertex");
+
+MeshFileLoader::MeshFileLoader(irr::video::IVideoDriver* driver, irr::io::IFileSystem* fileSystem) {
+    mDriver = driver;
+    mFileSystem = fileSystem;
+}
+
+MeshFileLoader::~MeshFileLoader() {
+}
+
+bool MeshFileLoader::isALoadableFileExtension(const irr::io::path& filename) const {
+    return irr::core::hasFileExtension(filename, DEF_MESHFILE_EXTENSION);
+}
+
+bool MeshFileLoader::ReadData(irr::io::IReadFile* file, void* dest, irr::u32 size) {
+    if (size == 0)
+        return true;
+
+    return (file->read(dest, size) == (irr::s32)(size));
+}
+
+irr::scene::SMeshBuffer* MeshFileLoader::ReadMeshBuffer(irr::io::IReadFile* file) {
+    irr::u32 colors[4];
+    irr::f32 shininess;
+    irr::u16 texFileNameLen;
+
+    if (!ReadData(file, colors, sizeof(colors)) || !ReadData(file, &shininess, sizeof(shininess)) ||
+            !ReadData(file, &texFileNameLen, sizeof(texFileNameLen)))
+        return nullptr;
+
+    std::vector<char> texFileName(texFileNameLen + 1, 0);
+
+    if (!ReadData(file, texFileName.data(), texFileNameLen))
+        return nullptr;
+
+    irr::u32 nrVertices;
+    irr::u32 nrIndices;
+
+    if (!ReadData(file, &nrVertices, sizeof(nrVertices)) || !ReadData(file, &nrIndices, sizeof(nrIndices)))
+        return nullptr;
+
+    //all vertices must be reachable with 16 bit indices, and
+    //there must not be more data than left in the file
+    if ((nrVertices > 65536) || ((nrIndices % 3) != 0))
+        return nullptr;
+
+    long bytesLeft = file->getSize() - file->getPos();
+
+    if ((long)(nrVertices * sizeof(irr::video::S3DVertex) + nrIndices * sizeof(irr::u16)) > bytesLeft)
+        return nullptr;
+
+    irr::scene::SMeshBuffer* buffer = new irr::scene::SMeshBuffer();
+
+    buffer->Vertices.set_used(nrVertices);
+    buffer->Indices.set_used(nrIndices);
+
+    if (!ReadData(file, buffer->Vertices.pointer(), nrVertices * sizeof(irr::video::S3DVertex)) ||
+            !ReadData(file, buffer->Indices.pointer(), nrIndices * sizeof(irr::u16))) {
+        buffer->drop();
+        return nullptr;
+    }
+
+    for (irr::u32 idx = 0; idx < nrIndices; idx++) {
+        if (buffer->Indices[idx] >= nrVertices) {
+            buffer->drop();
+            return nullptr;
+        }
+    }
+
+    buffer->Material.AmbientColor = irr::video::SColor(colors[0]);
+    buffer->Material.DiffuseColor = irr::video::SColor(colors[1]);
+    buffer->Material.SpecularColor = irr::video::SColor(colors[2]);
+    buffer->Material.EmissiveColor = irr::video::SColor(colors[3]);
+    buffer->Material.Shininess = shininess;
+
+    if (texFileNameLen > 0) {
+        //texture file is stored next to the mesh file
+        irr::io::path texPath = mFileSystem->getFileDir(file->getFileName());
+        texPath.append("/");
+        texPath.append(texFileName.data());
+
+        irr::video::ITexture* tex = mDriver->getTexture(texPath);
+
+        if (tex == nullptr) {
+            std::string msg("MeshFileLoader: Texture ");
+            msg.append(texPath.c_str());
+            msg.append(" not found");
+            logging::Warning(msg);
+        }
+
+        buffer->Material.setTexture(0, tex);
+    }
+
+    buffer->recalculateBoundingBox();
+
+    return buffer;
+}
+
+irr::scene::IAnimatedMesh* MeshFileLoader::createMesh(irr::io::IReadFile* file) {
+    irr::u32 header[3];
+
+    if (!ReadData(file, header, sizeof(header)) || (header[0] != DEF_MESHFILE_MAGIC)) {
+        std::string msg("MeshFileLoader: ");
+        msg.append(file->getFileName().c_str());
+        msg.append(" is not a valid mesh file");
+        logging::Error(msg);
+        return nullptr;
+    }
+
+    if (header[1] != DEF_MESHFILE_VERSION) {
+        std::string msg("MeshFileLoader: ");
+        msg.append(file->getFileName().c_str());
+        msg.append(" has unsupported version, please extract the game data again");
+        logging::Error(msg);
+        return nullptr;
+    }
+
+    irr::scene::SMesh* mesh = new irr::scene::SMesh();
+
+    for (irr::u32 idx = 0; idx < header[2]; idx++) {
+        irr::scene::SMeshBuffer* buffer = ReadMeshBuffer(file);
+
+        if (buffer == nullptr) {
+            std::string msg("MeshFileLoader: ");
+            msg.append(file->getFileName().c_str());
+            msg.append(" is corrupt");
+            logging::Error(msg);
+
+            mesh->drop();
+            return nullptr;
+        }
+
+        //the mesh holds its own reference
+        mesh->addMeshBuffer(buffer);
+        buffer->drop();
+    }
+
+    mesh->recalculateBoundingBox();
+
+    irr::scene::SAnimatedMesh* animMesh = new irr::scene::SAnimatedMesh(mesh);
+    animMesh->recalculateBoundingBox();
+    mesh->drop();
+
+    return animMesh;
+}
@@ -0,0 +1,59 @@
+/*
+ Copyright (C) 2026 Wolf Alexander
+
+ This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.                                          */
+
+#ifndef MESHFILELOADER_H
+#define MESHFILELOADER_H
+
+#include "irrlicht.h"
+
+//file extension of our binary mesh files,
+//without the dot
+#define DEF_MESHFILE_EXTENSION "hmesh"
+
+//"HMSH" in little endian
+#define DEF_MESHFILE_MAGIC 0x48534D48
+#define DEF_MESHFILE_VERSION 1
+
+//Mesh file layout (all numbers little endian):
+//  Header:     u32 magic, u32 version, u32 nrMeshBuffers
+//  For each mesh buffer:
+//    Material: u32 ambientColor, u32 diffuseColor, u32 specularColor, u32 emissiveColor (all ARGB),
+//              f32 shininess, u16 texFileNameLen, texFileName (not null terminated, relative to the
+//              directory of the mesh file, empty if the material has no texture)
+//    Counts:   u32 nrVertices, u32 nrIndices
+//    Vertices: nrVertices times f32 pos X/Y/Z, f32 normal X/Y/Z, u32 color (ARGB), f32 texcoord U/V
+//              This is exactly the memory layout of irr::video::S3DVertex, and already in the Irrlicht
+//              coordinate system; Therefore the vertices can be read directly into the mesh buffer
+//    Indices:  nrIndices times u16, three indices for each triangle
+
+//Irrlicht mesh loader for our binary mesh files, that the data
+//extraction writes for the 3D models of the original game
+class MeshFileLoader : public irr::scene::IMeshLoader {
+public:
+    MeshFileLoader(irr::video::IVideoDriver* driver, irr::io::IFileSystem* fileSystem);
+    virtual ~MeshFileLoader();
+
+    //Irrlicht IMeshLoader interface
+    virtual bool isALoadableFileExtension(const irr::io::path& filename) const;
+
+    //returns nullptr if the file is not a valid mesh file
+    virtual irr::scene::IAnimatedMesh* createMesh(irr::io::IReadFile* file);
+
+private:
+    irr::video::IVideoDriver* mDriver = nullptr;
+    irr::io::IFileSystem* mFileSystem = nullptr;
+
+    //returns false if the file ends before size bytes were read
+    bool ReadData(irr::io::IReadFile* file, void* dest, irr::u32 size);
+
+    //returns nullptr if the mesh buffer data is not valid
+    irr::scene::SMeshBuffer* ReadMeshBuffer(irr::io::IReadFile* file);
+};
+
+#endif // MESHFILELOADER_H
@@ -0,0 +1,39 @@
+/*
+ Copyright (C) 2026 Wolf Alexander
+
+ This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.                                          */
+
+#include "bandupscale.h"
+#include "../xbrz-1-8/xbrz.h"
+#include "../../utils/threadpool.h"
+#include <algorithm>
+
+irr::u32 GetNrUpscaleBands(irr::u32 sizey, irr::u32 bandRows) {
+    if (bandRows == 0)
+        return 1;
+
+    return (sizey + bandRows - 1) / bandRows;
+}
+
+void UpscaleImageBands(ThreadPool* threadPool, int scaleFactor, const uint32_t* srcData, uint32_t* targetData,
+                       irr::u32 sizex, irr::u32 sizey, irr::u32 bandRows) {
+    irr::u32 nrBands = GetNrUpscaleBands(sizey, bandRows);
+
+    if ((threadPool == nullptr) || (nrBands < 2)) {
+        xbrz::scale(scaleFactor, srcData, targetData, sizex, sizey, xbrz::ColorFormat::ARGB, xbrz::ScalerCfg(), 0, sizey);
+        return;
+    }
+
+    //every band writes only its own rows of the target image
+    threadPool->RunParallel(nrBands, [=](irr::u32 bandIdx) {
+        int yFirst = (int)(bandIdx * bandRows);
+        int yLast = std::min(yFirst + (int)(bandRows), (int)(sizey));
+
+        xbrz::scale(scaleFactor, srcData, targetData, sizex, sizey, xbrz::ColorFormat::ARGB,
+                    xbrz::ScalerCfg(), yFirst, yLast);
+    });
+}
@@ -0,0 +1,34 @@
+/*
+ Copyright (C) 2026 Wolf Alexander
+
+ This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.                                          */
+
+#ifndef BANDUPSCALE_H
+#define BANDUPSCALE_H
+
+#include "irrlicht.h"
+#include <cstdint>
+
+//number of source image rows that are upscaled
+//together by one thread
+#define DEF_BAND_UPSCALE_ROWS 32
+
+class ThreadPool;
+
+//returns the number of bands of bandRows source rows an
+//image with sizey rows is split into; the last band can be smaller
+irr::u32 GetNrUpscaleBands(irr::u32 sizey, irr::u32 bandRows);
+
+//Upscales the ARGB image srcData (sizex * sizey pixels) with xBRZ into targetData (sizex * scaleFactor times
+//sizey * scaleFactor pixels). xBRZ can scale a slice of rows of the source image on its own (it still reads
+//the neighboring rows of the slice), so the image is split into bands of bandRows rows which are scaled in
+//parallel on the threads of threadPool; The result is the same as with a single call of xbrz::scale.
+//With threadPool = nullptr, or only one band, the image is scaled on the calling thread
+void UpscaleImageBands(ThreadPool* threadPool, int scaleFactor, const uint32_t* srcData, uint32_t* targetData,
+                       irr::u32 sizex, irr::u32 sizey, irr::u32 bandRows = DEF_BAND_UPSCALE_ROWS);
+
+#endif // BANDUPSCALE_H
@@ -204,7 +204,9 @@ long rnc_unpack (unsigned char *packed, unsigned char *unpacked, unsigned int fl
     unsigned char *output = unpacked;
     unsigned char *inputend, *outputend;
     bit_stream bs;
-    huf_table raw, dist, len;
+    //a chunk can keep the table of the chunk before, therefore
+    //start with empty tables to not use undefined data
+    huf_table raw = {}, dist = {}, len = {};
     unsigned long ch_count;
     unsigned long ret_len, inp_len;
     unsigned out_crc;
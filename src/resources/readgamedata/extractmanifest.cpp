@@ -0,0 +1,265 @@
+/*
+ Copyright (C) 2026 Wolf Alexander
+
+ This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.                                          */
+
+#include "extractmanifest.h"
+#include "../../utils/crc32.h"
+#include "../../utils/threadpool.h"
+#include "../../utils/fileutils.h"
+#include "../../utils/logging.h"
+#include <fstream>
+#include <sstream>
+
+//The manifest is a simple text file, one entry per line:
+//  manifest <file format version>
+//  step <stepId> <extractorVersion> <upscaleSettings> <inputChecksum>
+//  input <fileName>
+//  output <fileSize> <checksum> <fileName>
+//File names are always the last item of the line, so that they can contain spaces
+//input and output lines belong to the last step line before them
+
+ExtractManifest::ExtractManifest(Crc32* crc32, const char* fileName) {
+    mCrc32 = crc32;
+    mFileName = fileName;
+}
+
+ExtractManifest::~ExtractManifest() {
+    Clear();
+}
+
+void ExtractManifest::Clear() {
+    std::vector<ExtractManifestStepStruct*>::iterator it;
+
+    for (it = mStepVec.begin(); it != mStepVec.end(); ++it) {
+        delete (*it);
+    }
+
+    mStepVec.clear();
+}
+
+bool ExtractManifest::Load() {
+    Clear();
+
+    std::ifstream iFile(mFileName);
+
+    if (!iFile.is_open())
+        return false;
+
+    std::string line;
+    std::string keyword;
+    ExtractManifestStepStruct* currStep = nullptr;
+    bool headerOk = false;
+
+    while (std::getline(iFile, line)) {
+        std::istringstream lineStream(line);
+        lineStream >> keyword;
+
+        if (lineStream.fail())
+            continue;
+
+        if (keyword == "manifest") {
+            irr::u32 fileVersion = 0;
+            lineStream >> fileVersion;
+
+            if (fileVersion != DEF_EXTRACTMANIFEST_FILEVERSION)
+                break;
+
+            headerOk = true;
+            continue;
+        }
+
+        if (!headerOk)
+            break;
+
+        if (keyword == "step") {
+            irr::u32 stepId;
+            currStep = new ExtractManifestStepStruct();
+            lineStream >> stepId >> currStep->extractorVersion >> currStep->upscaleSettings >> currStep->inputChecksum;
+            currStep->stepId = (irr::u8)(stepId);
+
+            mStepVec.push_back(currStep);
+        } else if ((keyword == "input") && (currStep != nullptr)) {
+            std::string fileName;
+            lineStream >> std::ws;
+            std::getline(lineStream, fileName);
+
+            currStep->inputFileVec.push_back(fileName);
+        } else if ((keyword == "output") && (currStep != nullptr)) {
+            ExtractManifestFileStruct entry;
+            lineStream >> entry.fileSize >> entry.checksum >> std::ws;
+            std::getline(lineStream, entry.fileName);
+
+            currStep->outputFileVec.push_back(entry);
+        }
+
+        if (lineStream.bad()) {
+            headerOk = false;
+            break;
+        }
+    }
+
+    iFile.close();
+
+    if (!headerOk) {
+        Clear();
+        return false;
+    }
+
+    return true;
+}
+
+bool ExtractManifest::Save() {
+    std::ofstream oFile(mFileName, std::ios_base::out | std::ios_base::trunc);
+
+    if (!oFile.is_open()) {
+        logging::Warning("Could not write extraction manifest file");
+        return false;
+    }
+
+    oFile << "manifest " << DEF_EXTRACTMANIFEST_FILEVERSION << std::endl;
+
+    std::vector<ExtractManifestStepStruct*>::iterator it;
+    std::vector<std::string>::iterator itInput;
+    std::vector<ExtractManifestFileStruct>::iterator itOutput;
+
+    for (it = mStepVec.begin(); it != mStepVec.end(); ++it) {
+        oFile << "step " << (irr::u32)((*it)->stepId) << " " << (*it)->extractorVersion << " "
+              << (*it)->upscaleSettings << " " << (*it)->inputChecksum << std::endl;
+
+        for (itInput = (*it)->inputFileVec.begin(); itInput != (*it)->inputFileVec.end(); ++itInput) {
+            oFile << "input " << (*itInput) << std::endl;
+        }
+
+        for (itOutput = (*it)->outputFileVec.begin(); itOutput != (*it)->outputFileVec.end(); ++itOutput) {
+            oFile << "output " << (*itOutput).fileSize << " " << (*itOutput).checksum << " "
+                  << (*itOutput).fileName << std::endl;
+        }
+    }
+
+    oFile.close();
+
+    return !oFile.fail();
+}
+
+ExtractManifestStepStruct* ExtractManifest::GetStep(irr::u8 stepId) {
+    std::vector<ExtractManifestStepStruct*>::iterator it;
+
+    for (it = mStepVec.begin(); it != mStepVec.end(); ++it) {
+        if ((*it)->stepId == stepId)
+            return (*it);
+    }
+
+    return nullptr;
+}
+
+void ExtractManifest::SetStep(ExtractManifestStepStruct* newStep) {
+    RemoveStep(newStep->stepId);
+
+    mStepVec.push_back(newStep);
+}
+
+void ExtractManifest::RemoveStep(irr::u8 stepId) {
+    std::vector<ExtractManifestStepStruct*>::iterator it;
+
+    for (it = mStepVec.begin(); it != mStepVec.end(); ) {
+        if ((*it)->stepId == stepId) {
+            delete (*it);
+            it = mStepVec.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+bool ExtractManifest::ComputeInputChecksum(const std::vector<std::string>& inputFileVec, uint32_t& checksum) {
+    uint32_t crc = 0;
+    std::vector<std::string>::const_iterator it;
+
+    for (it = inputFileVec.begin(); it != inputFileVec.end(); ++it) {
+        if (!mCrc32->ComputeFileChecksum((*it).c_str(), crc, crc))
+            return false;
+    }
+
+    checksum = crc;
+
+    return true;
+}
+
+bool ExtractManifest::ComputeFileEntry(const std::string& fileName, ExtractManifestFileStruct& entry) {
+    if (FileExists(fileName.c_str()) != 1)
+        return false;
+
+    entry.fileName = fileName;
+    entry.fileSize = (irr::u32)(GetFileSizeBytes(fileName.c_str()));
+
+    return mCrc32->ComputeFileChecksum(fileName.c_str(), entry.checksum);
+}
+
+std::vector<irr::u8> ExtractManifest::VerifySteps(ThreadPool* threadPool, irr::u32 extractorVersion, uint32_t upscaleSettings) {
+    //one task for the inputs of each step, and
+    //one task for each output file
+    struct VerifyTask {
+        size_t stepIdx;
+        //-1 means the inputs of the step
+        irr::s32 outputIdx;
+    };
+
+    std::vector<VerifyTask> taskVec;
+    std::vector<irr::u8> stepOkVec(mStepVec.size(), 1);
+
+    for (size_t stepIdx = 0; stepIdx < mStepVec.size(); stepIdx++) {
+        ExtractManifestStepStruct* step = mStepVec[stepIdx];
+
+        if ((step->extractorVersion != extractorVersion) || (step->upscaleSettings != upscaleSettings)) {
+            stepOkVec[stepIdx] = 0;
+            continue;
+        }
+
+        taskVec.push_back({stepIdx, -1});
+
+        for (size_t outputIdx = 0; outputIdx < step->outputFileVec.size(); outputIdx++) {
+            taskVec.push_back({stepIdx, (irr::s32)(outputIdx)});
+        }
+    }
+
+    std::vector<irr::u8> taskOkVec(taskVec.size(), 0);
+
+    threadPool->RunParallel((irr::u32)(taskVec.size()), [this, &taskVec, &taskOkVec](irr::u32 taskIdx) {
+        ExtractManifestStepStruct* step = mStepVec[taskVec[taskIdx].stepIdx];
+        bool ok;
+
+        if (taskVec[taskIdx].outputIdx < 0) {
+            uint32_t checksum;
+            ok = ComputeInputChecksum(step->inputFileVec, checksum) && (checksum == step->inputChecksum);
+        } else {
+            const ExtractManifestFileStruct& expected = step->outputFileVec[taskVec[taskIdx].outputIdx];
+            ExtractManifestFileStruct current;
+
+            ok = ComputeFileEntry(expected.fileName, current) && (current.fileSize == expected.fileSize) &&
+                    (current.checksum == expected.checksum);
+        }
+
+        taskOkVec[taskIdx] = ok ? 1 : 0;
+    });
+
+    for (size_t taskIdx = 0; taskIdx < taskVec.size(); taskIdx++) {
+        if (taskOkVec[taskIdx] == 0) {
+            stepOkVec[taskVec[taskIdx].stepIdx] = 0;
+        }
+    }
+
+    std::vector<irr::u8> changedStepVec;
+
+    for (size_t stepIdx = 0; stepIdx < mStepVec.size(); stepIdx++) {
+        if (stepOkVec[stepIdx] == 0) {
+            changedStepVec.push_back(mStepVec[stepIdx]->stepId);
+        }
+    }
+
+    return changedStepVec;
+}
@@ -0,0 +1,99 @@
+/*
+ Copyright (C) 2026 Wolf Alexander
+
+ This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.                                          */
+
+#ifndef EXTRACTMANIFEST_H
+#define EXTRACTMANIFEST_H
+
+#include "irrlicht.h"
+#include <vector>
+#include <string>
+#include <cstdint>
+
+//version of the manifest file format itself
+#define DEF_EXTRACTMANIFEST_FILEVERSION 1
+
+/************************
+ * Forward declarations *
+ ************************/
+
+class Crc32;
+class ThreadPool;
+
+//one extracted output file
+typedef struct ExtractManifestFileStruct {
+    //path relative to the game root dir
+    std::string fileName;
+    irr::u32 fileSize = 0;
+    uint32_t checksum = 0;
+} ExtractManifestFileStruct;
+
+//everything we know about one finished extraction step
+typedef struct ExtractManifestStepStruct {
+    irr::u8 stepId = 0;
+
+    //the step output is only valid if created with
+    //the same extractor version and upscale settings
+    irr::u32 extractorVersion = 0;
+    uint32_t upscaleSettings = 0;
+
+    //original game files the step has read, and the
+    //combined checksum over all of them
+    std::vector<std::string> inputFileVec;
+    uint32_t inputChecksum = 0;
+
+    std::vector<ExtractManifestFileStruct> outputFileVec;
+} ExtractManifestStepStruct;
+
+//Keeps track of the game data extraction: For each finished extraction step the manifest file
+//stores the checksum of the original game files the step has read, the extractor version and upscale
+//settings, and size and checksum of every file the step has written. With this information only the
+//steps whose inputs or outputs changed (or that were interrupted) need to be extracted again
+class ExtractManifest {
+public:
+    ExtractManifest(Crc32* crc32, const char* fileName);
+    ~ExtractManifest();
+
+    //returns false if there is no manifest file, or
+    //the file is not valid; In this case the manifest is empty
+    bool Load();
+
+    //returns false if the file could not be written
+    bool Save();
+
+    //returns nullptr if the step is not part of the manifest
+    ExtractManifestStepStruct* GetStep(irr::u8 stepId);
+
+    //adds the step, an existing entry for the same step is
+    //replaced; The manifest takes ownership of newStep
+    void SetStep(ExtractManifestStepStruct* newStep);
+    void RemoveStep(irr::u8 stepId);
+
+    //computes the combined checksum over the content of all files
+    //returns false if one of the files could not be read
+    bool ComputeInputChecksum(const std::vector<std::string>& inputFileVec, uint32_t& checksum);
+
+    //computes size and checksum of the file
+    //returns false if the file could not be read
+    bool ComputeFileEntry(const std::string& fileName, ExtractManifestFileStruct& entry);
+
+    //Verifies all steps of the manifest, the input and output files are checked in parallel
+    //Returns the ids of all steps that need to be extracted again, because an input or output file
+    //changed, or the step was created with another extractor version or other upscale settings
+    std::vector<irr::u8> VerifySteps(ThreadPool* threadPool, irr::u32 extractorVersion, uint32_t upscaleSettings);
+
+private:
+    Crc32* mCrc32 = nullptr;
+    std::string mFileName;
+
+    std::vector<ExtractManifestStepStruct*> mStepVec;
+
+    void Clear();
+};
+
+#endif // EXTRACTMANIFEST_H
@@ -22,6 +22,9 @@
 #include "objectdatfile.h"
 #include "../../utils/logging.h"
 #include "../../infrabase.h"
+#include "../meshfileloader.h"
+#include "schemetexture.h"
+#include <map>
 
 ObjectDatFile::ObjectDatFile(InfrastructureBase* infra, TABFILE* pntrModelTextureAtlasInfo, unsigned int texAtlasWidth,
                              unsigned int texAtlasHeight) {
@@ -929,3 +932,184 @@ bool ObjectDatFile::WriteToObjFile(const char* filename, const char* objectname)
 
     return true;
 }
+
+bool ObjectDatFile::WriteToMeshFile(const char* filename) {
+    if (!ConversionSuccesful) {
+        logging::Error("ObjectDatFile: BitConverterToInt16 failed unit test on this computer!");
+        return false;
+    }
+
+    //same material as in the mtl file, and the same vertex color the
+    //Irrlicht obj loader uses (the diffuse color of the material)
+    irr::video::SColor diffuseColor(255, 255, 255, 255);
+    irr::u32 colors[4] = { irr::video::SColor(255, 51, 51, 51).color, diffuseColor.color,
+                           irr::video::SColor(255, 255, 255, 255).color, irr::video::SColor(255, 0, 0, 0).color };
+    irr::f32 shininess = 0.0f;
+    const char* texFileName = "tex0-0.png";
+
+    std::vector<irr::video::S3DVertex> vertices;
+    std::vector<irr::u16> indices;
+
+    //triangle corners with exactly the same vertex data
+    //are only stored once
+    std::map<irr::video::S3DVertex, irr::u16> vertexLookup;
+    std::map<irr::video::S3DVertex, irr::u16>::iterator itLookup;
+
+    ObjVertex* pntrVert;
+    ObjVertex* pntrNormal;
+    int corner[3];
+    size_t triIdx = 0;
+    std::vector<ObjTriangle*>::iterator itTri;
+
+    for (itTri = ObjFileTriangleVector->begin(); itTri != ObjFileTriangleVector->end(); ++itTri, triIdx++) {
+        corner[0] = (*itTri)->A;
+        corner[1] = (*itTri)->B;
+        corner[2] = (*itTri)->C;
+
+        pntrNormal = ObjFileNormalsVector->at(triIdx);
+        irr::u16 cornerIdx[3];
+
+        for (int k = 0; k < 3; k++) {
+            pntrVert = ObjFileVertexVector->at(corner[k]);
+
+            //swap Y and Z axis, as in the obj file, but without mirroring X; The Irrlicht
+            //obj loader mirrored X again when loading, so the result is the same
+            irr::video::S3DVertex newVertex(pntrVert->X, pntrVert->Z, pntrVert->Y,
+                                            pntrNormal->X, pntrNormal->Z, pntrNormal->Y, diffuseColor,
+                                            uvCoordVec->at(triIdx * 6 + k * 2), uvCoordVec->at(triIdx * 6 + k * 2 + 1));
+
+            itLookup = vertexLookup.find(newVertex);
+
+            if (itLookup != vertexLookup.end()) {
+                cornerIdx[k] = itLookup->second;
+            } else {
+                if (vertices.size() >= 65536) {
+                    logging::Error("ObjectDatFile: Too many vertices for mesh file");
+                    return false;
+                }
+
+                cornerIdx[k] = (irr::u16)(vertices.size());
+                vertexLookup[newVertex] = cornerIdx[k];
+                vertices.push_back(newVertex);
+            }
+        }
+
+        //reversed winding order, because of the different
+        //handedness of the Irrlicht coordinate system
+        indices.push_back(cornerIdx[2]);
+        indices.push_back(cornerIdx[1]);
+        indices.push_back(cornerIdx[0]);
+    }
+
+    FILE* oFile = fopen(filename, "wb");
+    if (oFile == nullptr) {
+        return false;
+    }
+
+    irr::u32 header[3] = { DEF_MESHFILE_MAGIC, DEF_MESHFILE_VERSION, 1 };
+    irr::u16 texFileNameLen = (irr::u16)(strlen(texFileName));
+    irr::u32 counts[2] = { (irr::u32)(vertices.size()), (irr::u32)(indices.size()) };
+
+    fwrite(header, sizeof(header), 1, oFile);
+    fwrite(colors, sizeof(colors), 1, oFile);
+    fwrite(&shininess, sizeof(shininess), 1, oFile);
+    fwrite(&texFileNameLen, sizeof(texFileNameLen), 1, oFile);
+    fwrite(texFileName, 1, texFileNameLen, oFile);
+    fwrite(counts, sizeof(counts), 1, oFile);
+
+    if (!vertices.empty()) {
+        fwrite(vertices.data(), sizeof(irr::video::S3DVertex), vertices.size(), oFile);
+        fwrite(indices.data(), sizeof(irr::u16), indices.size(), oFile);
+    }
+
+    bool writeOk = (ferror(oFile) == 0);
+
+    if (fclose(oFile) != 0) {
+        writeOk = false;
+    }
+
+    return writeOk;
+}
+
+bool ObjectDatFile::HasSameGeometry(ObjectDatFile* other) {
+    if ((this->ObjFileTriangleVector->size() != other->ObjFileTriangleVector->size()) ||
+        (this->ObjFileVertexVector->size() != other->ObjFileVertexVector->size()) ||
+        (this->uvCoordVec->size() != other->uvCoordVec->size()))
+        return false;
+
+    for (size_t idx = 0; idx < this->ObjFileTriangleVector->size(); idx++) {
+        ObjTriangle* tri = this->ObjFileTriangleVector->at(idx);
+        ObjTriangle* otherTri = other->ObjFileTriangleVector->at(idx);
+
+        if ((tri->A != otherTri->A) || (tri->B != otherTri->B) || (tri->C != otherTri->C))
+            return false;
+    }
+
+    for (size_t idx = 0; idx < this->ObjFileVertexVector->size(); idx++) {
+        ObjVertex* vert = this->ObjFileVertexVector->at(idx);
+        ObjVertex* otherVert = other->ObjFileVertexVector->at(idx);
+
+        if ((vert->X != otherVert->X) || (vert->Y != otherVert->Y) || (vert->Z != otherVert->Z))
+            return false;
+    }
+
+    return true;
+}
+
+irr::video::IImage* ObjectDatFile::CreateArgbImage(irr::video::IImage* image) {
+    irr::video::IImage* argbImage =
+            mInfra->mDriver->createImage(irr::video::ECOLOR_FORMAT::ECF_A8R8G8B8, image->getDimension());
+
+    image->copyTo(argbImage);
+
+    return argbImage;
+}
+
+irr::video::IImage* ObjectDatFile::CreateRemappedTexture(ObjectDatFile* other, irr::video::IImage* atlas) {
+    if (!HasSameGeometry(other))
+        return nullptr;
+
+    irr::core::dimension2du atlasSize = atlas->getDimension();
+
+    //the atlas can have another color format, the
+    //color scheme texture is created from ARGB texels
+    irr::video::IImage* atlasArgb = CreateArgbImage(atlas);
+    irr::video::IImage* remappedTex =
+            mInfra->mDriver->createImage(irr::video::ECOLOR_FORMAT::ECF_A8R8G8B8, atlasSize);
+
+    bool baked = BakeSchemeTexture(*this->uvCoordVec, *other->uvCoordVec, (const uint32_t*)atlasArgb->lock(),
+                                   (uint32_t*)remappedTex->lock(), atlasSize.Width, atlasSize.Height);
+
+    remappedTex->unlock();
+    atlasArgb->unlock();
+    atlasArgb->drop();
+
+    if (!baked) {
+        remappedTex->drop();
+        return nullptr;
+    }
+
+    return remappedTex;
+}
+
+bool ObjectDatFile::VerifyRemappedTexture(ObjectDatFile* other, irr::video::IImage* atlas, irr::video::IImage* remappedTex) {
+    if (!HasSameGeometry(other) || (remappedTex->getDimension() != atlas->getDimension()))
+        return false;
+
+    irr::core::dimension2du atlasSize = atlas->getDimension();
+
+    //the written texture is read back from a file,
+    //and can have another color format as well
+    irr::video::IImage* atlasArgb = CreateArgbImage(atlas);
+    irr::video::IImage* remappedArgb = CreateArgbImage(remappedTex);
+
+    bool texelsOk = VerifySchemeTexture(*this->uvCoordVec, *other->uvCoordVec, (const uint32_t*)atlasArgb->lock(),
+                                        (const uint32_t*)remappedArgb->lock(), atlasSize.Width, atlasSize.Height);
+
+    remappedArgb->unlock();
+    atlasArgb->unlock();
+    remappedArgb->drop();
+    atlasArgb->drop();
+
+    return texelsOk;
+}
@@ -67,6 +67,10 @@ private:
     void DebugWriteTriangleCsvFile(char* debugOutPutFileName, int triangleNr, int texID, TABFILE_ITEM* texItem);
     //void CreateTextureAtlasDebugPicture(int markTexId);
 
+    //returns a copy of the image with ARGB texels, which
+    //is needed for the color scheme texture functions
+    irr::video::IImage* CreateArgbImage(irr::video::IImage* image);
+
 public:
     ObjectDatFile(InfrastructureBase* infra, TABFILE* pntrModelTextureAtlasInfo, unsigned int texAtlasWidth,
                   unsigned int texAtlasHeight);
@@ -75,8 +79,26 @@ public:
     //Routines
     bool LoadObjectDatFile(const char* filename, std::vector<ObjTexModification*> texModificationVec);
     bool WriteToObjFile(const char* filename, const char* objectname);
+
+    //writes the object into our binary mesh file format (see meshfileloader.h), the vertices
+    //are already converted into the Irrlicht coordinate system and shared between triangles
+    bool WriteToMeshFile(const char* filename);
     bool TestBitConverterToInt16();
 
+    //returns true if the other object has exactly the same vertices
+    //and triangles, only the texture coordinates can be different
+    bool HasSameGeometry(ObjectDatFile* other);
+
+    //Creates a new texture from the atlas, in which every texel this object uses is replaced by the texel the
+    //other object uses at the same position of the same triangle. With this texture this object looks exactly like
+    //the other object. Returns nullptr if the geometry is different, or if the same texel of this object would need
+    //to show different texels of the other object
+    irr::video::IImage* CreateRemappedTexture(ObjectDatFile* other, irr::video::IImage* atlas);
+
+    //returns true if remappedTex gives this object exactly
+    //the same texels as the other object gets from the atlas
+    bool VerifyRemappedTexture(ObjectDatFile* other, irr::video::IImage* atlas, irr::video::IImage* remappedTex);
+
     bool ConversionSuccesful;
 };
 
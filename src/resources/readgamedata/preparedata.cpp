@@ -14,13 +14,27 @@
 #include "../../infrabase.h"
 #include "../../utils/logging.h"
 #include "../../utils/fileutils.h"
+#include "../../utils/threadpool.h"
 #include "../readgamedata/objectdatfile.h"
+#include "../meshfileloader.h"
+#include "../texturecache.h"
+#include "extractmanifest.h"
+#include "../../utils/crc32.h"
+#include "../levelcache.h"
 #include <iomanip>
 #include <algorithm>
 #include "../xbrz-1-8/xbrz.h"
+#include "bandupscale.h"
 #include "../intro/flifix.h"
 #include "../readgamedata/dernc.h"
+#include "../readgamedata/rncdecoder.h"
 #include <sstream>
+#include <cstring>
+#include <filesystem>
+
+//the extraction step that is currently executed by this thread
+//is used to remember the input files of the step
+static thread_local PrepareDataStepStruct* tCurrentStep = nullptr;
 
 ObjTexModification::ObjTexModification(int applyToTexIdParam, uint8_t texModTypeParam) {
     mApplyToTexId = applyToTexIdParam;
@@ -32,7 +46,7 @@ void PrepareData::CreatePalette() {
 
     //locate the palette file
     irr::io::path palFilePath =
-            mInfra->LocateFileInFileList(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>("palet0-0.dat"));
+            LocateInputFile(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>("palet0-0.dat"));
 
     if (palFilePath.empty()) {
         //palette file not found!
@@ -42,6 +56,8 @@ void PrepareData::CreatePalette() {
     //create memory for ingame palette
     palette=static_cast<unsigned char*>(malloc(768));
 
+    mPaletteFileName = palFilePath.c_str();
+
     char* fname = strdup(palFilePath.c_str());
 
     //read ingame palette
@@ -49,144 +65,250 @@ void PrepareData::CreatePalette() {
     free(fname);
 }
 
+//returns nullptr if the step does not need to be extracted
+PrepareDataStepStruct* PrepareData::AddExtractionStep(irr::u8 stepId, const char* description,
+                                                     std::vector<PrepareDataStepStruct*> dependsOnSteps) {
+    if (!StepNeedsRedo(stepId))
+        return nullptr;
+
+    PrepareDataStepStruct* newStep = new PrepareDataStepStruct();
+    newStep->stepId = stepId;
+    newStep->description.append(description);
+
+    //the palette is used by all steps
+    newStep->inputFileVec.push_back(mPaletteFileName);
+
+    std::vector<ThreadPoolJob*> dependencies;
+    std::vector<PrepareDataStepStruct*>::iterator it;
+
+    for (it = dependsOnSteps.begin(); it != dependsOnSteps.end(); ++it) {
+        //steps that are not extracted again are already done
+        if ((*it) != nullptr) {
+            dependencies.push_back((*it)->job);
+        }
+    }
+
+    newStep->job = mInfra->mThreadPool->AddJob(newStep->description,
+                                                [this, newStep]() { RunExtractionStep(newStep); }, dependencies);
+
+    mStepVec.push_back(newStep);
+
+    return newStep;
+}
+
+//Creates one job for each extraction step that needs to be extracted; Most steps only read from
+//the original game files and write into their own extract subdirectory, and
+//therefore can run at the same time. Steps that need the result of another step
+//specify this step as dependency
+void PrepareData::CreateExtractionJobs() {
+    AddExtractionStep(PREP_DATA_EXTRACTINTRO, "GAME INTRO");
+    AddExtractionStep(PREP_DATA_EXTRACTGAMESCREENS, "GAME SCREENS");
+
+    PrepareDataStepStruct* hudStep = AddExtractionStep(PREP_DATA_EXTRACTHUD, "GAME HUD");
+
+    //the fonts step moves some of the HUD images
+    //into the HUD font directories
+    //(both steps are always extracted together)
+    AddExtractionStep(PREP_DATA_EXTRACTFONTS, "GAME FONTS", {hudStep});
+
+    AddExtractionStep(PREP_DATA_EXTRACTSKIES, "GAME SKIES");
+    AddExtractionStep(PREP_DATA_EXTRACTSPRITES, "GAME SPRITES");
+    AddExtractionStep(PREP_DATA_EXTRACTTERRAINTEXTURES, "GAME TEXTURES");
+
+    PrepareDataStepStruct* levelsStep = AddExtractionStep(PREP_DATA_EXTRACTLEVELS, "GAME LEVELS");
+
+    //the minimaps are stored in the level
+    //directories created by the levels step
+    AddExtractionStep(PREP_DATA_EXTRACTMINIMAPS, "GAME MINIMAPS", {levelsStep});
+
+    AddExtractionStep(PREP_DATA_EXTRACTMISC, "GAME MISC");
+    AddExtractionStep(PREP_DATA_EXTRACTMODELS, "GAME MODELS");
+    AddExtractionStep(PREP_DATA_EXTRACTAUDIO, "GAME AUDIO");
+}
+
+void PrepareData::RunExtractionStep(PrepareDataStepStruct* step) {
+    bool finished = false;
+
+    tCurrentStep = step;
+
+    try {
+        while (!finished) {
+            switch (step->stepId) {
+                case PREP_DATA_EXTRACTGAMESCREENS: {
+                    finished = ExtractGameScreens(step);
+                    break;
+                }
+
+                case PREP_DATA_EXTRACTHUD: {
+                    finished = ExtractHuds(step);
+                    break;
+                }
+
+                case PREP_DATA_EXTRACTFONTS: {
+                    finished = ExtractFonts(step);
+                    break;
+                }
+
+                case PREP_DATA_EXTRACTSKIES: {
+                    finished = ExtractSkies(step);
+                    break;
+                }
+
+                case PREP_DATA_EXTRACTSPRITES: {
+                    finished = ExtractSprites(step);
+                    break;
+                }
+
+                case PREP_DATA_EXTRACTTERRAINTEXTURES: {
+                    finished = ExtractTerrainTextures(step);
+                    break;
+                }
+
+                case PREP_DATA_EXTRACTLEVELS: {
+                    finished = ExtractLevels(step);
+                    break;
+                }
+
+                case PREP_DATA_EXTRACTMINIMAPS: {
+                    finished = ExtractMiniMaps(step);
+                    break;
+                }
+
+                case PREP_DATA_EXTRACTMISC: {
+                    finished = ExtractMisc(step);
+                    break;
+                }
+
+                case PREP_DATA_EXTRACTMODELS: {
+                    finished = ExtractModels(step);
+                    break;
+                }
+
+                case PREP_DATA_EXTRACTINTRO: {
+                    finished = ExtractIntro(step);
+                    break;
+                }
+
+                case PREP_DATA_EXTRACTAUDIO: {
+                    finished = ExtractAudio(step);
+                    break;
+                }
+
+                default: {
+                    finished = true;
+                    break;
+                }
+            }
+        }
+    }
+    catch (...) {
+        //this worker thread will execute other jobs
+        tCurrentStep = nullptr;
+        throw;
+    }
+
+    tCurrentStep = nullptr;
+
+    //step is done, remember all files it has written
+    step->manifestEntry = CreateManifestEntry(step);
+}
+
+void PrepareData::ReleaseExtractionJobs() {
+    std::vector<PrepareDataStepStruct*>::iterator it;
+
+    //first cancel all steps that were not started yet
+    for (it = mStepVec.begin(); it != mStepVec.end(); ++it) {
+        mInfra->mThreadPool->CancelJob((*it)->job);
+    }
+
+    //wait for all steps before we release the first job, because
+    //jobs of later steps can depend on it
+    for (it = mStepVec.begin(); it != mStepVec.end(); ++it) {
+        mInfra->mThreadPool->WaitForJob((*it)->job);
+    }
+
+    for (it = mStepVec.begin(); it != mStepVec.end(); ++it) {
+        mInfra->mThreadPool->ReleaseJob((*it)->job);
+
+        if ((*it)->manifestEntry != nullptr) {
+            delete (*it)->manifestEntry;
+        }
+
+        delete (*it);
+    }
+
+    mStepVec.clear();
+}
+
+std::string PrepareData::GetTempFileName() {
+    irr::u32 nr = mTempFileCnt++;
+
+    return "extract/tmp-unpacked" + std::to_string(nr) + ".dat";
+}
+
 //returns true if data preparation was succesfully
-//finished
+//finished; The extraction itself runs on the worker threads
+//of the thread pool, here we only check the progress
+//throws the error message of the first failed step
 bool PrepareData::ExecuteNextStep() {
     //if we are done, return true
     if (mCurrentStep == PREP_DATA_FINISHED)
         return true;
 
-    switch (mCurrentStep) {
-        case PREP_DATA_EXTRACTGAMESCREENS: {
-            if (ExtractGameScreens()) {
-                //we are done with this substep
-                currSubStep = 0;
-                mCurrentStep = PREP_DATA_EXTRACTHUD;
-                currentStepDescription.clear();
-                currentStepDescription.append("GAME HUD");
-            }
-            break;
-         }
+    if (mStepVec.size() == 0) {
+        CreateExtractionJobs();
+    }
 
-        case PREP_DATA_EXTRACTHUD: {
-             if (ExtractHuds()) {
-                //we are done with this substep
-                currSubStep = 0;
-                mCurrentStep = PREP_DATA_EXTRACTFONTS;
-                currentStepDescription.clear();
-                currentStepDescription.append("GAME FONTS");
-             }
-             break;
-        }
+    std::vector<PrepareDataStepStruct*>::iterator it;
+    bool allFinished = true;
+    PrepareDataStepStruct* runningStep = nullptr;
 
-        case PREP_DATA_EXTRACTFONTS: {
-            if (ExtractFonts()) {
-                //we are done with this substep
-                currSubStep = 0;
-                mCurrentStep = PREP_DATA_EXTRACTSKIES;
-                currentStepDescription.clear();
-                currentStepDescription.append("GAME SKIES");
-            }
-            break;
-        }
+    for (it = mStepVec.begin(); it != mStepVec.end(); ++it) {
+        irr::u8 state = (*it)->job->state;
 
-        case PREP_DATA_EXTRACTSKIES: {
-             if (ExtractSkies()) {
-                //we are done with this substep
-                currSubStep = 0;
-                mCurrentStep = PREP_DATA_EXTRACTSPRITES;
-                currentStepDescription.clear();
-                currentStepDescription.append("GAME SPRITES");
-             }
-             break;
-        }
+        if (state == DEF_THREADPOOL_JOB_FAILED) {
+            std::string errorMsg((*it)->job->errorMsg);
 
-        case PREP_DATA_EXTRACTSPRITES: {
-             if (ExtractSprites()) {
-                //we are done with this substep
-                currSubStep = 0;
-                mCurrentStep = PREP_DATA_EXTRACTTERRAINTEXTURES;
-                currentStepDescription.clear();
-                currentStepDescription.append("GAME TEXTURES");
-             }
-             break;
-        }
+            //stop the remaining extraction
+            ReleaseExtractionJobs();
 
-        case PREP_DATA_EXTRACTTERRAINTEXTURES: {
-            if (ExtractTerrainTextures()) {
-                //we are done with this substep
-                currSubStep = 0;
-                mCurrentStep = PREP_DATA_EXTRACTLEVELS;
-                currentStepDescription.clear();
-                currentStepDescription.append("GAME LEVELS");
-            }
-            break;
+            throw errorMsg;
         }
 
-        case PREP_DATA_EXTRACTLEVELS: {
-            if (ExtractLevels()) {
-               //we are done with this substep
-               currSubStep = 0;
-               mCurrentStep = PREP_DATA_EXTRACTMINIMAPS;
-               currentStepDescription.clear();
-               currentStepDescription.append("GAME MINIMAPS");
-            }
-            break;
+        if ((state == DEF_THREADPOOL_JOB_DONE) && ((*it)->manifestEntry != nullptr)) {
+            //step finished, update the manifest right away, so that
+            //this step does not need to be extracted again even if the
+            //extraction is interrupted later
+            mManifest->SetStep((*it)->manifestEntry);
+            (*it)->manifestEntry = nullptr;
+            mManifest->Save();
         }
 
-        case PREP_DATA_EXTRACTMINIMAPS: {
-            if (ExtractMiniMaps()) {
-               //we are done with this substep
-               currSubStep = 0;
-               mCurrentStep = PREP_DATA_EXTRACTMISC;
-               currentStepDescription.clear();
-               currentStepDescription.append("GAME MISC");
-            }
-            break;
-        }
+        if (state != DEF_THREADPOOL_JOB_DONE) {
+            allFinished = false;
 
-        case PREP_DATA_EXTRACTMISC: {
-            if (ExtractMisc()) {
-               //we are done with this substep
-               currSubStep = 0;
-               mCurrentStep = PREP_DATA_EXTRACTMODELS;
-               currentStepDescription.clear();
-               currentStepDescription.append("GAME MODELS");
+            if ((runningStep == nullptr) && (state == DEF_THREADPOOL_JOB_RUNNING)) {
+                runningStep = (*it);
             }
-            break;
         }
+    }
 
-        case PREP_DATA_EXTRACTMODELS: {
-            if (ExtractModels()) {
-               //we are done with this substep
-               currSubStep = 0;
-               mCurrentStep = PREP_DATA_EXTRACTINTRO;
-               currentStepDescription.clear();
-               currentStepDescription.append("GAME INTRO");
-            }
-            break;
-        }
+    if (allFinished) {
+        ReleaseExtractionJobs();
 
-        case PREP_DATA_EXTRACTINTRO: {
-            if (ExtractIntro()) {
-               //we are done with this substep
-               currSubStep = 0;
-               mCurrentStep = PREP_DATA_EXTRACTAUDIO;
-               currentStepDescription.clear();
-               currentStepDescription.append("GAME AUDIO");
-            }
-            break;
-        }
+        mCurrentStep = PREP_DATA_FINISHED;
+        currentStepDescription.clear();
 
-        case PREP_DATA_EXTRACTAUDIO: {
-            if (ExtractAudio()) {
-               //we are done with this substep
-               currSubStep = 0;
-               mCurrentStep = PREP_DATA_FINISHED;
-               currentStepDescription.clear();
-            }
-            break;
-        }
+        logging::Info("Game data extraction finished");
+
+        return true;
+    }
+
+    //show one of the currently running steps
+    currentStepDescription.clear();
+
+    if (runningStep != nullptr) {
+        currentStepDescription.append(runningStep->description);
     }
 
     //not finished yet
@@ -194,15 +316,30 @@ bool PrepareData::ExecuteNextStep() {
 }
 
 irr::u8 PrepareData::GetProgressBarNrBlocksFilled(irr::u8 overallNrBlocksBar) {
+    if (mStepVec.size() == 0)
+        return 0;
+
     irr::f32 percentPerBlock = 100.0f / overallNrBlocksBar;
 
-    irr::f32 currProcess = ((irr::f32)(currSubStep) / (irr::f32)(nrSubSteps)) * 100.0f;
+    //each step has the same share of the progress bar
+    irr::f32 stepsDone = 0.0f;
+    std::vector<PrepareDataStepStruct*>::iterator it;
+
+    for (it = mStepVec.begin(); it != mStepVec.end(); ++it) {
+        irr::u32 nrSubSteps = (*it)->nrSubSteps;
+
+        if ((*it)->job->state == DEF_THREADPOOL_JOB_DONE) {
+            stepsDone += 1.0f;
+        } else if (nrSubSteps > 0) {
+            stepsDone += (irr::f32)((*it)->currSubStep) / (irr::f32)(nrSubSteps);
+        }
+    }
+
+    irr::f32 currProcess = (stepsDone / (irr::f32)(mStepVec.size())) * 100.0f;
 
     irr::u8 blocksFilled = (irr::u8)(currProcess / percentPerBlock);
 
-    if (blocksFilled < 0) {
-        blocksFilled = 0;
-    } else if (blocksFilled >= overallNrBlocksBar) {
+    if (blocksFilled >= overallNrBlocksBar) {
         blocksFilled = overallNrBlocksBar;
     }
 
@@ -210,15 +347,34 @@ irr::u8 PrepareData::GetProgressBarNrBlocksFilled(irr::u8 overallNrBlocksBar) {
 }
 
 void PrepareData::ExtractInitialData() {
-    logging::Info("Extracting first game logo and font...");
-    PrepareSubDir("extract/images");
+    if (StepNeedsRedo(PREP_DATA_EXTRACTINITIAL)) {
+        PrepareDataStepStruct initialStep;
+        initialStep.stepId = PREP_DATA_EXTRACTINITIAL;
+        initialStep.inputFileVec.push_back(mPaletteFileName);
+
+        tCurrentStep = &initialStep;
+
+        try {
+            logging::Info("Extracting first game logo and font...");
+            PrepareSubDir("extract/images");
+
+            ExtractSelectionScreenSVGA();
+
+            PrepareSubDir("extract/fonts");
+            PrepareSubDir("extract/fonts/smallsvga");
 
-    ExtractSelectionScreenSVGA();
+            ExtractSmallFontSVGA();
+        }
+        catch (...) {
+            tCurrentStep = nullptr;
+            throw;
+        }
 
-    PrepareSubDir("extract/fonts");
-    PrepareSubDir("extract/fonts/smallsvga");
+        tCurrentStep = nullptr;
 
-    ExtractSmallFontSVGA();
+        mManifest->SetStep(CreateManifestEntry(&initialStep));
+        mManifest->Save();
+    }
 
     mCurrentStep = PREP_DATA_EXTRACTGAMESCREENS;
     currentStepDescription.clear();
@@ -237,6 +393,11 @@ bool PrepareData::GameDataAvailable() {
 PrepareData::PrepareData(InfrastructureBase* mInfraPntr) {
     mInfra = mInfraPntr;
 
+    //the Wavefront obj files of the 3D models are not needed by the game
+    //anymore, but can be written additionally for debugging
+    mExportObjFiles = (std::find(mInfra->mCLIVec.begin(), mInfra->mCLIVec.end(), std::string("exportobj"))
+                       != mInfra->mCLIVec.end());
+
     //define correct font outline colors
     fontOutLineColor = new irr::video::SColor(255, 4, 4, 9);
     fontOutLineColor2 = new irr::video::SColor(255, 40, 65, 56);
@@ -250,28 +411,286 @@ PrepareData::PrepareData(InfrastructureBase* mInfraPntr) {
     //data preparation steps
     CreatePalette();
 
+    mManifest = new ExtractManifest(mInfra->mCrc32, DEF_PREP_DATA_MANIFEST_FILE);
+    DefineExtractionSteps();
+
     //check if extraction directory is already present
     //if not create this directory
-    if (IsDirectoryPresent("extract") == 1) {
+    bool extractDirPresent = (IsDirectoryPresent("extract") == 1);
+
+    if (!extractDirPresent) {
+        //need to create folder for data
+        //extraction
+        CreateDirectory("extract");
+    }
+
+    //find out which steps need to be extracted,
+    //if everything is there we are done
+    FindStepsToRedo(extractDirPresent);
+
+    if (mRedoStepIdVec.size() == 0) {
         mCurrentStep = PREP_DATA_FINISHED;
         return;
     }
 
-    //need to create folder for data
-    //extraction
-    CreateDirectory("extract");
-
     //only extract the one image we want to
     //show while data is prepared, and one of the fonts
     ExtractInitialData();
+}
 
-    currSubStep = 0;
-    nrSubSteps = 0;
+void PrepareData::DefineExtractionSteps() {
+    mStepOutputPrefixVec.push_back(std::make_pair(PREP_DATA_EXTRACTINITIAL, std::string("extract/images/oscr0-1")));
+    mStepOutputPrefixVec.push_back(std::make_pair(PREP_DATA_EXTRACTINITIAL, std::string("extract/fonts/smallsvga/")));
+    mStepOutputPrefixVec.push_back(std::make_pair(PREP_DATA_EXTRACTINITIAL, std::string("extract/fonts/smallsvga-x2/")));
+    mStepOutputPrefixVec.push_back(std::make_pair(PREP_DATA_EXTRACTGAMESCREENS, std::string("extract/images/")));
+    mStepOutputPrefixVec.push_back(std::make_pair(PREP_DATA_EXTRACTHUD, std::string("extract/hud1player/")));
+    mStepOutputPrefixVec.push_back(std::make_pair(PREP_DATA_EXTRACTHUD, std::string("extract/hud2player/")));
+    mStepOutputPrefixVec.push_back(std::make_pair(PREP_DATA_EXTRACTFONTS, std::string("extract/fonts/")));
+    mStepOutputPrefixVec.push_back(std::make_pair(PREP_DATA_EXTRACTSKIES, std::string("extract/sky/")));
+    mStepOutputPrefixVec.push_back(std::make_pair(PREP_DATA_EXTRACTSPRITES, std::string("extract/sprites/")));
+    mStepOutputPrefixVec.push_back(std::make_pair(PREP_DATA_EXTRACTTERRAINTEXTURES, std::string("extract/textures/")));
+    mStepOutputPrefixVec.push_back(std::make_pair(PREP_DATA_EXTRACTLEVELS, std::string("extract/level0-")));
+    mStepOutputPrefixVec.push_back(std::make_pair(PREP_DATA_EXTRACTMINIMAPS, std::string("extract/minimaps/")));
+    mStepOutputPrefixVec.push_back(std::make_pair(PREP_DATA_EXTRACTMISC, std::string("extract/editor/")));
+    mStepOutputPrefixVec.push_back(std::make_pair(PREP_DATA_EXTRACTMISC, std::string("extract/puzzle/")));
+    mStepOutputPrefixVec.push_back(std::make_pair(PREP_DATA_EXTRACTMODELS, std::string("extract/models/")));
+    mStepOutputPrefixVec.push_back(std::make_pair(PREP_DATA_EXTRACTINTRO, std::string("extract/intro/")));
+    mStepOutputPrefixVec.push_back(std::make_pair(PREP_DATA_EXTRACTAUDIO, std::string("extract/sound/")));
+    mStepOutputPrefixVec.push_back(std::make_pair(PREP_DATA_EXTRACTAUDIO, std::string("extract/music/")));
+
+    //files inside of the level directories that are written by the level editor
+    //(the unpacked level files) or by the game (the level cache) after the extraction;
+    //They must not be part of the manifest, otherwise the next start would see a modified
+    //output and extract the levels again, which overwrites the edited levels
+    mStepOutputExcludeSuffixVec.push_back(std::string("-unpacked.dat"));
+    mStepOutputExcludeSuffixVec.push_back(std::string("/") + LEVELCACHE_FILENAME);
+
+    //the minimaps are stored inside of the level directories
+    for (char levelNr = '1'; levelNr <= '9'; levelNr++) {
+        mStepOutputPrefixVec.push_back(std::make_pair(PREP_DATA_EXTRACTMINIMAPS,
+                                         std::string("extract/level0-") + levelNr + "/minimap.png"));
+    }
+
+    //the fonts step moves files out of the HUD step output, therefore both steps
+    //need to be extracted again together; The fonts step also creates the greenish
+    //fonts from the small font of the initial step
+    mStepLinkVec.push_back(std::make_pair(PREP_DATA_EXTRACTHUD, PREP_DATA_EXTRACTFONTS));
+    mStepLinkVec.push_back(std::make_pair(PREP_DATA_EXTRACTINITIAL, PREP_DATA_EXTRACTFONTS));
+}
 
-    currentStepDescription.clear();
+bool PrepareData::StepNeedsRedo(irr::u8 stepId) {
+    return (std::find(mRedoStepIdVec.begin(), mRedoStepIdVec.end(), stepId) != mRedoStepIdVec.end());
+}
+
+void PrepareData::FindStepsToRedo(bool extractDirPresent) {
+    std::vector<irr::u8> allStepIdVec = {
+        PREP_DATA_EXTRACTINITIAL, PREP_DATA_EXTRACTGAMESCREENS, PREP_DATA_EXTRACTHUD, PREP_DATA_EXTRACTFONTS,
+        PREP_DATA_EXTRACTSKIES, PREP_DATA_EXTRACTSPRITES, PREP_DATA_EXTRACTTERRAINTEXTURES, PREP_DATA_EXTRACTLEVELS,
+        PREP_DATA_EXTRACTMINIMAPS, PREP_DATA_EXTRACTMISC, PREP_DATA_EXTRACTMODELS, PREP_DATA_EXTRACTINTRO,
+        PREP_DATA_EXTRACTAUDIO };
+
+    mRedoStepIdVec.clear();
+
+    if (!extractDirPresent) {
+        mRedoStepIdVec = allStepIdVec;
+    } else if (!mManifest->Load()) {
+        logging::Info("No valid extraction manifest found, extract all game data again");
+        mRedoStepIdVec = allStepIdVec;
+    } else {
+        logging::Info("Verify extracted game data...");
+
+        //steps whose inputs or outputs changed
+        mRedoStepIdVec = mManifest->VerifySteps(mInfra->mThreadPool, DEF_PREP_DATA_EXTRACTOR_VERSION,
+                                                GetUpscaleSettingsChecksum());
+
+        //steps that were never finished
+        std::vector<irr::u8>::iterator it;
+
+        for (it = allStepIdVec.begin(); it != allStepIdVec.end(); ++it) {
+            if ((mManifest->GetStep(*it) == nullptr) && !StepNeedsRedo(*it)) {
+                mRedoStepIdVec.push_back(*it);
+            }
+        }
+
+        //the obj files are only written while the
+        //models are extracted
+        if (mExportObjFiles && !StepNeedsRedo(PREP_DATA_EXTRACTMODELS)) {
+            mRedoStepIdVec.push_back(PREP_DATA_EXTRACTMODELS);
+        }
+
+        //the unpacked level files are not verified by the manifest, because
+        //the level editor modifies them; Only make sure that they still exist
+        if (!StepNeedsRedo(PREP_DATA_EXTRACTLEVELS) && !AllUnpackedLevelFilesPresent()) {
+            mRedoStepIdVec.push_back(PREP_DATA_EXTRACTLEVELS);
+        }
+
+        //add linked steps
+        bool added = true;
+        std::vector<std::pair<irr::u8, irr::u8>>::iterator itLink;
+
+        while (added) {
+            added = false;
+
+            for (itLink = mStepLinkVec.begin(); itLink != mStepLinkVec.end(); ++itLink) {
+                bool firstRedo = StepNeedsRedo((*itLink).first);
+                bool secondRedo = StepNeedsRedo((*itLink).second);
+
+                if (firstRedo && !secondRedo) {
+                    mRedoStepIdVec.push_back((*itLink).second);
+                    added = true;
+                } else if (secondRedo && !firstRedo) {
+                    mRedoStepIdVec.push_back((*itLink).first);
+                    added = true;
+                }
+            }
+        }
+    }
+
+    if (mRedoStepIdVec.size() == 0)
+        return;
+
+    //remove the steps from the manifest before we start, so that they are
+    //extracted again if the extraction is interrupted
+    std::vector<irr::u8>::iterator it;
+
+    for (it = mRedoStepIdVec.begin(); it != mRedoStepIdVec.end(); ++it) {
+        mManifest->RemoveStep(*it);
+    }
+
+    mManifest->Save();
+
+    char hlpstr[100];
+    snprintf(hlpstr, 100, "%u of %u game data extraction steps need to be extracted",
+             (irr::u32)(mRedoStepIdVec.size()), (irr::u32)(allStepIdVec.size()));
+    logging::Info(hlpstr);
+}
+
+bool PrepareData::AllUnpackedLevelFilesPresent() {
+    char lastLevelNr = mInfra->mExtendedGame ? '9' : '6';
+
+    for (char levelNr = '1'; levelNr <= lastLevelNr; levelNr++) {
+        std::string levelFileName = std::string("extract/level0-") + levelNr + "/level0-" + levelNr + "-unpacked.dat";
+
+        if (FileExists(levelFileName.c_str()) != 1) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+irr::u8 PrepareData::GetOutputFileStep(const std::string& fileName) {
+    irr::u8 stepId = PREP_DATA_INITSTATE;
+    size_t longestPrefix = 0;
+
+    std::vector<std::string>::iterator itExclude;
+
+    for (itExclude = mStepOutputExcludeSuffixVec.begin(); itExclude != mStepOutputExcludeSuffixVec.end(); ++itExclude) {
+        const std::string& suffix = (*itExclude);
+
+        if ((fileName.size() >= suffix.size()) &&
+                (fileName.compare(fileName.size() - suffix.size(), suffix.size(), suffix) == 0)) {
+            return PREP_DATA_INITSTATE;
+        }
+    }
+
+    std::vector<std::pair<irr::u8, std::string>>::iterator it;
+
+    for (it = mStepOutputPrefixVec.begin(); it != mStepOutputPrefixVec.end(); ++it) {
+        const std::string& prefix = (*it).second;
+
+        if ((prefix.size() > longestPrefix) && (fileName.compare(0, prefix.size(), prefix) == 0)) {
+            longestPrefix = prefix.size();
+            stepId = (*it).first;
+        }
+    }
+
+    return stepId;
+}
+
+ExtractManifestStepStruct* PrepareData::CreateManifestEntry(PrepareDataStepStruct* step) {
+    ExtractManifestStepStruct* newEntry = new ExtractManifestStepStruct();
+    newEntry->stepId = step->stepId;
+    newEntry->extractorVersion = DEF_PREP_DATA_EXTRACTOR_VERSION;
+    newEntry->upscaleSettings = GetUpscaleSettingsChecksum();
+
+    //the same input file can be located multiple times
+    std::vector<std::string>::iterator itInput;
+
+    for (itInput = step->inputFileVec.begin(); itInput != step->inputFileVec.end(); ++itInput) {
+        if (std::find(newEntry->inputFileVec.begin(), newEntry->inputFileVec.end(), (*itInput)) ==
+                newEntry->inputFileVec.end()) {
+            newEntry->inputFileVec.push_back(*itInput);
+        }
+    }
+
+    if (!mManifest->ComputeInputChecksum(newEntry->inputFileVec, newEntry->inputChecksum)) {
+        delete newEntry;
+        throw std::string("CreateManifestEntry: Could not read input files of extraction step");
+    }
+
+    //find all files written by this step
+    namespace fs = std::filesystem;
+    std::vector<std::string> outputFileVec;
+    std::error_code ec;
+
+    for (fs::recursive_directory_iterator it(fs::path("extract"), ec), itEnd; it != itEnd; it.increment(ec)) {
+        if (ec)
+            break;
+
+        if (!it->is_regular_file(ec))
+            continue;
+
+        std::string fileName = it->path().generic_string();
+
+        if (GetOutputFileStep(fileName) == step->stepId) {
+            outputFileVec.push_back(fileName);
+        }
+    }
+
+    std::sort(outputFileVec.begin(), outputFileVec.end());
+
+    newEntry->outputFileVec.resize(outputFileVec.size());
+
+    try {
+        mInfra->mThreadPool->RunParallel((irr::u32)(outputFileVec.size()), [this, &outputFileVec, newEntry](irr::u32 idx) {
+            if (!mManifest->ComputeFileEntry(outputFileVec[idx], newEntry->outputFileVec[idx])) {
+                throw std::string("CreateManifestEntry: Could not read extracted file ") + outputFileVec[idx];
+            }
+        });
+    }
+    catch (const std::string &msg) {
+        delete newEntry;
+        throw msg;
+    }
+
+    return newEntry;
+}
+
+uint32_t PrepareData::GetUpscaleSettingsChecksum() {
+    //all upscaling is done with the default xBRZ settings
+    xbrz::ScalerCfg cfg;
+
+    return mInfra->mCrc32->ComputeChecksum((const uint8_t*)(&cfg), sizeof(cfg));
+}
+
+irr::io::path PrepareData::LocateInputFile(irr::io::IFileList* fileList, irr::core::string<irr::fschar_t> fileName,
+                                           bool ignoreFileEnding) {
+    irr::io::path result = mInfra->LocateFileInFileList(fileList, fileName, ignoreFileEnding);
+
+    if (!result.empty() && (tCurrentStep != nullptr)) {
+        tCurrentStep->inputFileVec.push_back(std::string(result.c_str()));
+    }
+
+    return result;
 }
 
 PrepareData::~PrepareData() {
+    //make sure no worker thread still uses our data
+    ReleaseExtractionJobs();
+
+    delete mManifest;
+
     free(palette);
 
     std::vector<ObjTexModification*>::iterator it;
@@ -299,13 +718,13 @@ PrepareData::~PrepareData() {
 
 //Returns true if this subitem is finished
 //False otherwise
-bool PrepareData::ExtractGameScreens() {
-    if (currSubStep == 0) {
+bool PrepareData::ExtractGameScreens(PrepareDataStepStruct* step) {
+    if (step->currSubStep == 0) {
         logging::Info("Extracting game logos...");
-        nrSubSteps = 3;
+        step->nrSubSteps = 3;
     }
 
-    switch (currSubStep) {
+    switch (step->currSubStep) {
       case 0: {
         ExtractGameLogoSVGA();
         break;
@@ -322,19 +741,19 @@ bool PrepareData::ExtractGameScreens() {
       }
     }
 
-    currSubStep++;
+    step->currSubStep++;
 
-    return (currSubStep >= nrSubSteps);
+    return (step->currSubStep >= step->nrSubSteps);
 }
 
-bool PrepareData::ExtractFonts() {
+bool PrepareData::ExtractFonts(PrepareDataStepStruct* step) {
     //extract SVGA game logo data if not all exported files present
-    if (currSubStep == 0) {
-        nrSubSteps = 12;
+    if (step->currSubStep == 0) {
+        step->nrSubSteps = 12;
         logging::Info("Extracting game fonts...");
     }
 
-    switch (currSubStep) {
+    switch (step->currSubStep) {
         case 0: {
             PrepareHudFontsLocation();
             break;
@@ -415,9 +834,9 @@ bool PrepareData::ExtractFonts() {
         }
     }
 
-    currSubStep++;
+    step->currSubStep++;
 
-    return (currSubStep >= nrSubSteps);
+    return (step->currSubStep >= step->nrSubSteps);
 }
 
 void PrepareData::MoveIndexedFilesToNewLocation(const char* srcPath, const char* srcPrefix, irr::u16 srcStartIdx,
@@ -508,12 +927,12 @@ void PrepareData::PrepareHudFontsLocation() {
     PreProcessFontDirectory("extract/fonts/hudkillcounterred", "panel0-1-", false, fontOutLineColor);
 }
 
-bool PrepareData::ExtractHuds() {
-    if (currSubStep == 0) {
-        nrSubSteps = 2;
+bool PrepareData::ExtractHuds(PrepareDataStepStruct* step) {
+    if (step->currSubStep == 0) {
+        step->nrSubSteps = 2;
     }
 
-    switch (currSubStep) {
+    switch (step->currSubStep) {
        case 0: {
           logging::Info("Extracting 1 player HUD...");
           PrepareSubDir("extract/hud1player");
@@ -529,48 +948,48 @@ bool PrepareData::ExtractHuds() {
        }
     }
 
-    currSubStep++;
+    step->currSubStep++;
 
-    return (currSubStep >= nrSubSteps);
+    return (step->currSubStep >= step->nrSubSteps);
 }
 
-bool PrepareData::ExtractSkies() {
-    if (currSubStep == 0) {
+bool PrepareData::ExtractSkies(PrepareDataStepStruct* step) {
+    if (step->currSubStep == 0) {
         logging::Info("Extracting sky...");
         PrepareSubDir("extract/sky");
-        nrSubSteps = 7;
+        step->nrSubSteps = 7;
     }
 
-    if (currSubStep < 6) {
-        char skyNr = '0' + currSubStep;
+    if (step->currSubStep < 6) {
+        char skyNr = '0' + step->currSubStep;
         ExtractSky(skyNr);
     } else {
         //prepare upgraded sky images (not from the original game)
         PrepareUpgradedSkyData();
     }
 
-    currSubStep++;
+    step->currSubStep++;
 
-    return (currSubStep >= nrSubSteps);
+    return (step->currSubStep >= step->nrSubSteps);
 }
 
-bool PrepareData::ExtractSprites() {
-    if (currSubStep == 0) {
-        nrSubSteps = 1;
+bool PrepareData::ExtractSprites(PrepareDataStepStruct* step) {
+    if (step->currSubStep == 0) {
+        step->nrSubSteps = 1;
         logging::Info("Extracting sprites...");
         PrepareSubDir("extract/sprites");
     }
 
-    switch(currSubStep) {
+    switch(step->currSubStep) {
        case 0: {
             ExtractTmaps();
             break;
        }
     }
 
-    currSubStep++;
+    step->currSubStep++;
 
-    return (currSubStep >= nrSubSteps);
+    return (step->currSubStep >= step->nrSubSteps);
 }
 
 //Returns true in case of success, False otherwise
@@ -943,14 +1362,14 @@ void PrepareData::PrepareMapConfigData() {
     }
 }
 
-bool PrepareData::ExtractMiniMaps() {
-    if (currSubStep == 0) {
+bool PrepareData::ExtractMiniMaps(PrepareDataStepStruct* step) {
+    if (step->currSubStep == 0) {
         logging::Info("Extracting minimaps...");
         PrepareSubDir("extract/minimaps");
-        nrSubSteps = 2;
+        step->nrSubSteps = 2;
     }
 
-    switch(currSubStep) {
+    switch(step->currSubStep) {
         case 0: {
             ExtractMiniMapsSVGA();
             break;
@@ -961,48 +1380,48 @@ bool PrepareData::ExtractMiniMaps() {
         }
     }
 
-    currSubStep++;
+    step->currSubStep++;
 
-    return (currSubStep >= nrSubSteps);
+    return (step->currSubStep >= step->nrSubSteps);
 }
 
-bool PrepareData::ExtractTerrainTextures() {
-    if (currSubStep == 0) {
+bool PrepareData::ExtractTerrainTextures(PrepareDataStepStruct* step) {
+    if (step->currSubStep == 0) {
         logging::Info("Extracting terrain textures...");
         PrepareSubDir("extract/textures");
 
         if (!mInfra->mExtendedGame) {
-            nrSubSteps = 6;
+            step->nrSubSteps = 6;
         } else {
-            nrSubSteps = 9;
+            step->nrSubSteps = 9;
         }
     }
 
-    char levelNr = '1' + currSubStep;
+    char levelNr = '1' + step->currSubStep;
     ExtractTerrainTexture(levelNr);
 
-    currSubStep++;
+    step->currSubStep++;
 
-    return (currSubStep >= nrSubSteps);
+    return (step->currSubStep >= step->nrSubSteps);
 }
 
-bool PrepareData::ExtractLevels() {
-    if (currSubStep == 0) {
+bool PrepareData::ExtractLevels(PrepareDataStepStruct* step) {
+    if (step->currSubStep == 0) {
         logging::Info("Extracting levels...");
         if (!mInfra->mExtendedGame) {
-            nrSubSteps = 6;
+            step->nrSubSteps = 6;
         } else {
-            nrSubSteps = 9;
+            step->nrSubSteps = 9;
         }
     }
 
     irr::io::path inputLevelFile;
 
-    switch(currSubStep) {
+    switch(step->currSubStep) {
         case 0: {
             //locate the needed input level file
             inputLevelFile =
-                mInfra->LocateFileInFileList(mInfra->mOriginalGame->mapsFolder, irr::core::string<fschar_t>("level0-1.dat"));
+                LocateInputFile(mInfra->mOriginalGame->mapsFolder, irr::core::string<fschar_t>("level0-1.dat"));
 
             if (inputLevelFile.empty()) {
                 //map file not found!
@@ -1015,7 +1434,7 @@ bool PrepareData::ExtractLevels() {
 
         case 1: {
             inputLevelFile =
-                mInfra->LocateFileInFileList(mInfra->mOriginalGame->mapsFolder, irr::core::string<fschar_t>("level0-2.dat"));
+                LocateInputFile(mInfra->mOriginalGame->mapsFolder, irr::core::string<fschar_t>("level0-2.dat"));
 
             if (inputLevelFile.empty()) {
                 //map file not found!
@@ -1028,7 +1447,7 @@ bool PrepareData::ExtractLevels() {
 
         case 2: {
             inputLevelFile =
-                mInfra->LocateFileInFileList(mInfra->mOriginalGame->mapsFolder, irr::core::string<fschar_t>("level0-3.dat"));
+                LocateInputFile(mInfra->mOriginalGame->mapsFolder, irr::core::string<fschar_t>("level0-3.dat"));
 
             if (inputLevelFile.empty()) {
                 //map file not found!
@@ -1041,7 +1460,7 @@ bool PrepareData::ExtractLevels() {
 
         case 3: {
             inputLevelFile =
-                mInfra->LocateFileInFileList(mInfra->mOriginalGame->mapsFolder, irr::core::string<fschar_t>("level0-4.dat"));
+                LocateInputFile(mInfra->mOriginalGame->mapsFolder, irr::core::string<fschar_t>("level0-4.dat"));
 
             if (inputLevelFile.empty()) {
                 //map file not found!
@@ -1054,7 +1473,7 @@ bool PrepareData::ExtractLevels() {
 
         case 4: {
             inputLevelFile =
-                mInfra->LocateFileInFileList(mInfra->mOriginalGame->mapsFolder, irr::core::string<fschar_t>("level0-5.dat"));
+                LocateInputFile(mInfra->mOriginalGame->mapsFolder, irr::core::string<fschar_t>("level0-5.dat"));
 
             if (inputLevelFile.empty()) {
                 //map file not found!
@@ -1067,7 +1486,7 @@ bool PrepareData::ExtractLevels() {
 
         case 5: {
             inputLevelFile =
-                mInfra->LocateFileInFileList(mInfra->mOriginalGame->mapsFolder, irr::core::string<fschar_t>("level0-6.dat"));
+                LocateInputFile(mInfra->mOriginalGame->mapsFolder, irr::core::string<fschar_t>("level0-6.dat"));
 
             if (inputLevelFile.empty()) {
                 //map file not found!
@@ -1083,7 +1502,7 @@ bool PrepareData::ExtractLevels() {
         case 6: {
             //locate the needed input level file
             inputLevelFile =
-                mInfra->LocateFileInFileList(mInfra->mOriginalGame->mapsFolder, irr::core::string<fschar_t>("level0-7.dat"));
+                LocateInputFile(mInfra->mOriginalGame->mapsFolder, irr::core::string<fschar_t>("level0-7.dat"));
 
             if (inputLevelFile.empty()) {
                 //map file not found!
@@ -1096,7 +1515,7 @@ bool PrepareData::ExtractLevels() {
 
         case 7: {
             inputLevelFile =
-                mInfra->LocateFileInFileList(mInfra->mOriginalGame->mapsFolder, irr::core::string<fschar_t>("level0-8.dat"));
+                LocateInputFile(mInfra->mOriginalGame->mapsFolder, irr::core::string<fschar_t>("level0-8.dat"));
 
             if (inputLevelFile.empty()) {
                 //map file not found!
@@ -1109,7 +1528,7 @@ bool PrepareData::ExtractLevels() {
 
         case 8: {
             inputLevelFile =
-                mInfra->LocateFileInFileList(mInfra->mOriginalGame->mapsFolder, irr::core::string<fschar_t>("level0-9.dat"));
+                LocateInputFile(mInfra->mOriginalGame->mapsFolder, irr::core::string<fschar_t>("level0-9.dat"));
 
             if (inputLevelFile.empty()) {
                 //map file not found!
@@ -1121,24 +1540,24 @@ bool PrepareData::ExtractLevels() {
         }
     }
 
-    currSubStep++;
+    step->currSubStep++;
 
-    if (currSubStep >= nrSubSteps) {
+    if (step->currSubStep >= step->nrSubSteps) {
         //Create additional original map config data
         PrepareMapConfigData();
     }
 
-    return (currSubStep >= nrSubSteps);
+    return (step->currSubStep >= step->nrSubSteps);
 }
 
-bool PrepareData::ExtractMisc() {
-    if (currSubStep == 0) {
-        nrSubSteps = 4;
+bool PrepareData::ExtractMisc(PrepareDataStepStruct* step) {
+    if (step->currSubStep == 0) {
+        step->nrSubSteps = 4;
         logging::Info("Extracting Misc...");
         PrepareSubDir("extract/editor");
     }
 
-    switch(currSubStep) {
+    switch(step->currSubStep) {
         case 0: {
             ExtractEditorItemsLarge();
             break;
@@ -1157,9 +1576,9 @@ bool PrepareData::ExtractMisc() {
         }
     }
 
-    currSubStep++;
+    step->currSubStep++;
 
-    return (currSubStep >= nrSubSteps);
+    return (step->currSubStep >= step->nrSubSteps);
 }
 
 void PrepareData::ExtractCheatPuzzle() {
@@ -1176,7 +1595,7 @@ void PrepareData::ExtractCheatPuzzle() {
     //scale puzzle by factor 4
     //locate the needed input data file
     irr::io::path inputDatFile =
-            mInfra->LocateFileInFileList(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>("puzzle.dat"));
+            LocateInputFile(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>("puzzle.dat"));
 
     if (inputDatFile.empty()) {
         //dat file not found!
@@ -1185,8 +1604,8 @@ void PrepareData::ExtractCheatPuzzle() {
     ConvertRawImageData(inputDatFile.c_str(), 112, 96, "extract/puzzle/puzzle.png", 4);
 }
 
-bool PrepareData::ExtractModels() {
-    if (currSubStep == 0) {
+bool PrepareData::ExtractModels(PrepareDataStepStruct* step) {
+    if (step->currSubStep == 0) {
         logging::Info("Extracting models...");
         PrepareSubDir("extract/models");
 
@@ -1197,10 +1616,10 @@ bool PrepareData::ExtractModels() {
             mModelTexModificationVec.push_back(new ObjTexModification(idx, OBJ_EXPORT_DEF_UVMAP_FLIPU));
         }
 
-        nrSubSteps = 12;
+        step->nrSubSteps = 12;
     }
 
-    switch(currSubStep) {
+    switch(step->currSubStep) {
         case 0: {
             ExtractModelTextures();
             break;
@@ -1211,10 +1630,12 @@ bool PrepareData::ExtractModels() {
         }
         case 2: {
             ExtractNamed3DModel("bike0-", 8);
+            CreateCraftColorSchemeTextures("bike0-", 8);
             break;
         }
         case 3: {
             ExtractNamed3DModel("car0-", 8);
+            CreateCraftColorSchemeTextures("car0-", 8);
             break;
         }
         case 4: {
@@ -1223,10 +1644,12 @@ bool PrepareData::ExtractModels() {
         }
         case 5: {
             ExtractNamed3DModel("jet0-", 8);
+            CreateCraftColorSchemeTextures("jet0-", 8);
             break;
         }
         case 6: {
             ExtractNamed3DModel("jugga0-", 8);
+            CreateCraftColorSchemeTextures("jugga0-", 8);
             break;
         }
         case 7: {
@@ -1243,17 +1666,19 @@ bool PrepareData::ExtractModels() {
         }
         case 10: {
             ExtractNamed3DModel("skim0-", 8);
+            CreateCraftColorSchemeTextures("skim0-", 8);
             break;
         }
         case 11: {
             ExtractNamed3DModel("tank0-", 8);
+            CreateCraftColorSchemeTextures("tank0-", 8);
             break;
         }
     }
 
-    currSubStep++;
+    step->currSubStep++;
 
-    if (currSubStep >= nrSubSteps) {
+    if (step->currSubStep >= step->nrSubSteps) {
         //if we have the extended version of the game we also need
         //to extract 3 more race track 3D models for the menue
         if (!mInfra->mExtendedGame) {
@@ -1263,54 +1688,37 @@ bool PrepareData::ExtractModels() {
         }
     }
 
-    return (currSubStep >= nrSubSteps);
+    return (step->currSubStep >= step->nrSubSteps);
 }
 
-//Processes the original intro data from the game
-//in a way so that we can play it afterwards at the beginning
-//of the game using Irrlicht Engine
-bool PrepareData::ExtractIntro() {
+//Processes the original intro data from the game in a way so that we
+//can play it afterwards at the beginning of the game; The intro player
+//decodes the frames directly from the repaired FLI file while playing
+bool PrepareData::ExtractIntro(PrepareDataStepStruct* step) {
     std::string fliDestFileName("extract/intro/intro.fli");
 
-    if (currSubStep == 0) {
+    if (step->currSubStep == 0) {
         logging::Info("Extracting intro...");
         PrepareSubDir("extract/intro");
 
-        //Initially set 3 steps
-        nrSubSteps = 3;
+        step->nrSubSteps = 2;
     }
 
-    switch(currSubStep) {
+    switch(step->currSubStep) {
         case 0: {
             RepairFLI(fliDestFileName.c_str());
             break;
         }
 
         case 1: {
-            //now load the FLI file and create for each frame a texture file for later
-            InitFLIProcessing(fliDestFileName.c_str());
-            //now update number of steps
-            nrSubSteps = 2 + (irr::u32)(mFLIHeader->frames);
+            VerifyIntroFLI(fliDestFileName.c_str());
             break;
         }
-
-        default: {
-          //process the next frame
-          ProcessFrame(currSubStep - 2);
-          break;
-        }
     }
 
-    currSubStep++;
+    step->currSubStep++;
 
-    if (currSubStep >= nrSubSteps) {
-        //delete temporary "intro.fli" file
-        remove(fliDestFileName.c_str());
-
-        CleanupFLIProcessing();
-    }
-
-    return (currSubStep >= nrSubSteps);
+    return (step->currSubStep >= step->nrSubSteps);
 }
 
 void PrepareData::ExtractUserdata() {
@@ -1327,9 +1735,9 @@ void PrepareData::ExtractNamed3DModel(const char* name, int n_models) {
     for (int idx = 0; idx < n_models; idx++) {
         std::string objname = std::string(name) + std::to_string(idx);
         std::string datfile = objname + ".dat";
-        std::string objfile = obj_path + objname + ".obj";
+        std::string meshfile = obj_path + objname + "." + DEF_MESHFILE_EXTENSION;
 
-        inputDatFile = mInfra->LocateFileInFileList(mInfra->mOriginalGame->objectsFolder,
+        inputDatFile = LocateInputFile(mInfra->mOriginalGame->objectsFolder,
                                              irr::core::string<fschar_t>(datfile.c_str()));
 
         if (inputDatFile.empty()) {
@@ -1337,7 +1745,87 @@ void PrepareData::ExtractNamed3DModel(const char* name, int n_models) {
              throw "Could not locate the original games object data file " + datfile;
         }
 
-        Extract3DModel(inputDatFile.c_str(), objfile.c_str(), objname.c_str());
+        Extract3DModel(inputDatFile.c_str(), meshfile.c_str(), objname.c_str());
+    }
+}
+
+void PrepareData::CreateCraftColorSchemeTextures(const char* name, int n_models) {
+    std::string obj_path = "extract/models/";
+    irr::io::path inputDatFile;
+    std::vector<ObjectDatFile*> schemeVec;
+    std::vector<ObjectDatFile*>::iterator it;
+
+    //the models were extracted already, therefore the
+    //dat files can be found, and are valid
+    for (int idx = 0; idx < n_models; idx++) {
+        std::string datfile = std::string(name) + std::to_string(idx) + ".dat";
+
+        inputDatFile = LocateInputFile(mInfra->mOriginalGame->objectsFolder,
+                                             irr::core::string<fschar_t>(datfile.c_str()));
+
+        ObjectDatFile* newObj = new ObjectDatFile(mInfra, this->modelsTabFileInfo, (unsigned int)(this->modelTexAtlasSize.Width),
+                           (unsigned int)(this->modelTexAtlasSize.Height));
+
+        schemeVec.push_back(newObj);
+
+        if (inputDatFile.empty() || !newObj->LoadObjectDatFile(inputDatFile.c_str(), mModelTexModificationVec)) {
+            for (it = schemeVec.begin(); it != schemeVec.end(); ++it) {
+                delete (*it);
+            }
+
+            throw "Error loading object file: " + datfile;
+        }
+    }
+
+    irr::video::IImage* atlas = mInfra->mDriver->createImageFromFile("extract/models/tex0-0.png");
+
+    if (atlas == nullptr) {
+        for (it = schemeVec.begin(); it != schemeVec.end(); ++it) {
+            delete (*it);
+        }
+
+        throw std::string("Could not load extracted model texture atlas extract/models/tex0-0.png");
+    }
+
+    //the first color scheme uses the atlas itself
+    for (int idx = 1; idx < n_models; idx++) {
+        std::string texFile = obj_path + name + std::to_string(idx) + "-tex.png";
+
+        irr::video::IImage* schemeTex = schemeVec.at(0)->CreateRemappedTexture(schemeVec.at(idx), atlas);
+
+        if (schemeTex == nullptr) {
+            logging::Warning(std::string("Color scheme ") + name + std::to_string(idx) +
+                             " can not share the geometry of the first color scheme");
+            continue;
+        }
+
+        bool written = mInfra->mDriver->writeImageToFile(schemeTex, texFile.c_str());
+        schemeTex->drop();
+
+        //read the written file again, and make sure that with it the first color scheme
+        //model gets exactly the same texels as the model of this color scheme
+        irr::video::IImage* writtenTex = nullptr;
+
+        if (written) {
+            writtenTex = mInfra->mDriver->createImageFromFile(texFile.c_str());
+        }
+
+        bool verified = (writtenTex != nullptr) && schemeVec.at(0)->VerifyRemappedTexture(schemeVec.at(idx), atlas, writtenTex);
+
+        if (writtenTex != nullptr) {
+            writtenTex->drop();
+        }
+
+        if (!verified) {
+            logging::Warning(std::string("Verification of color scheme texture ") + texFile + " failed, file is not used");
+            std::remove(texFile.c_str());
+        }
+    }
+
+    atlas->drop();
+
+    for (it = schemeVec.begin(); it != schemeVec.end(); ++it) {
+        delete (*it);
     }
 }
 
@@ -1356,9 +1844,16 @@ void PrepareData::Extract3DModel(const char* srcFilename, const char* destFilena
         throw "Error loading object file: " + std::string(srcFilename);
     }
 
-    if (!newConversion->WriteToObjFile(destFilename, objName)) {
+    if (!newConversion->WriteToMeshFile(destFilename)) {
         delete  newConversion;
-        throw "Error writing object file: " + std::string(destFilename);
+        throw "Error writing mesh file: " + std::string(destFilename);
+    }
+
+    //obj and mtl file get the same name as the
+    //mesh file, only with another file extension
+    if (mExportObjFiles && !newConversion->WriteToObjFile(destFilename, objName)) {
+        delete  newConversion;
+        throw "Error writing object file for: " + std::string(destFilename);
     }
 
     delete newConversion;
@@ -1374,7 +1869,7 @@ void PrepareData::ExtractGameLogoSVGA() {
     //Unknown format 	RNC-compressed = Yes 	Game logo (SVGA)
     //locate the needed input files
     irr::io::path inputDatFile =
-            mInfra->LocateFileInFileList(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>("logo0-1.dat"));
+            LocateInputFile(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>("logo0-1.dat"));
 
     if (inputDatFile.empty()) {
         //dat file not found!
@@ -1382,7 +1877,7 @@ void PrepareData::ExtractGameLogoSVGA() {
     }
 
     irr::io::path inputTabFile =
-            mInfra->LocateFileInFileList(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>("logo0-1.tab"));
+            LocateInputFile(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>("logo0-1.tab"));
 
     if (inputTabFile.empty()) {
         //tab file not found!
@@ -1410,7 +1905,7 @@ void PrepareData::ExtractGameLogoSVGA() {
 
 void PrepareData::UpscaleAllImagesInDirectory(const char* srcDir, const char* srcFilePrefix, const char* targetDir, int scaleFactor) {
     //Create a list of files existing in specified source dir
-    irr::io::IFileList* fList = mInfra->CreateFileList(irr::io::path(srcDir));
+    irr::io::IFileList* fList = mInfra->CreateFileListThreadSafe(irr::io::path(srcDir));
 
     if (fList == nullptr) {
         throw std::string("UpscaleAllImagesInDirectory: Can not search for files in source directory");
@@ -1420,25 +1915,31 @@ void PrepareData::UpscaleAllImagesInDirectory(const char* srcDir, const char* sr
     PrepareSubDir(targetDir);
 
     irr::u32 fileCnt = fList->getFileCount();
-    io::path currFileName;
-    io::path currTargetFileName;
-
-    for (irr::u32 idx = 0; idx < fileCnt; idx++) {
-        currFileName = fList->getFileName(idx);
 
-        //-1 return value means string not found in string
-        if (currFileName.find(srcFilePrefix, 0) != -1) {
-            //create targetFileName
-            currTargetFileName = "";
-            currTargetFileName.append(targetDir);
-            currTargetFileName.append("/");
-            currTargetFileName.append(mInfra->RemoveFileEndingFromFileName(currFileName));
-            //Save as PNG to not loose the Alpha value
-            currTargetFileName.append(".png");
-           
-            //file contains prefix, scale this file
-            UpscaleExistingImageFile(fList->getFullFileName(idx).c_str(), currTargetFileName.c_str(), scaleFactor);
-        }
+    //the images are independent of each other,
+    //therefore upscale them in parallel
+    try {
+        mInfra->mThreadPool->RunParallel(fileCnt, [this, fList, srcFilePrefix, targetDir, scaleFactor](irr::u32 idx) {
+            io::path currFileName = fList->getFileName(idx);
+
+            //-1 return value means string not found in string
+            if (currFileName.find(srcFilePrefix, 0) != -1) {
+                //create targetFileName
+                io::path currTargetFileName("");
+                currTargetFileName.append(targetDir);
+                currTargetFileName.append("/");
+                currTargetFileName.append(mInfra->RemoveFileEndingFromFileName(currFileName));
+                //Save as PNG to not loose the Alpha value
+                currTargetFileName.append(".png");
+
+                //file contains prefix, scale this file
+                UpscaleExistingImageFile(fList->getFullFileName(idx).c_str(), currTargetFileName.c_str(), scaleFactor);
+            }
+        });
+    }
+    catch (const std::string &msg) {
+        fList->drop();
+        throw msg;
     }
 
     //drop the file list again
@@ -1490,7 +1991,7 @@ void PrepareData::ExtractHUD1PlayerSVGA() {
     //Unknown format 	RNC-compressed = No 	HUD 1-Player (SVGA)
     //locate the needed input files
     irr::io::path inputDatFile =
-            mInfra->LocateFileInFileList(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>("panel0-1.dat"));
+            LocateInputFile(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>("panel0-1.dat"));
 
     if (inputDatFile.empty()) {
         //dat file not found!
@@ -1498,7 +1999,7 @@ void PrepareData::ExtractHUD1PlayerSVGA() {
     }
 
     irr::io::path inputTabFile =
-            mInfra->LocateFileInFileList(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>("panel0-1.tab"));
+            LocateInputFile(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>("panel0-1.tab"));
 
     if (inputTabFile.empty()) {
         //tab file not found!
@@ -1516,7 +2017,7 @@ void PrepareData::ExtractMiniMapsSVGA() {
     //Unknown format 	RNC-compressed = Yes! 	MiniMaps (for the extended version of the game!)
     //locate the needed input files
     irr::io::path inputDatFile =
-            mInfra->LocateFileInFileList(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>("track0-1.dat"));
+            LocateInputFile(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>("track0-1.dat"));
 
     if (inputDatFile.empty()) {
         //dat file not found!
@@ -1524,7 +2025,7 @@ void PrepareData::ExtractMiniMapsSVGA() {
     }
 
     irr::io::path inputTabFile =
-            mInfra->LocateFileInFileList(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>("track0-1.tab"));
+            LocateInputFile(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>("track0-1.tab"));
 
     if (inputTabFile.empty()) {
         //tab file not found!
@@ -1534,11 +2035,12 @@ void PrepareData::ExtractMiniMapsSVGA() {
     //Important note: For the extended version of the game the minimap data file is RNC-compressed!
     //if we do not do this right, then the minimap extraction will fail
     if (mInfra->mExtendedGame) {
-        UnpackDataFile(inputDatFile.c_str(), "extract/tmp-unpacked.dat");
+        std::string tmpFile = GetTempFileName();
+        UnpackDataFile(inputDatFile.c_str(), tmpFile.c_str());
 
-        ExtractImagesfromDataFile("extract/tmp-unpacked.dat", inputTabFile.c_str(), "extract/minimaps/track0-1-");
+        ExtractImagesfromDataFile(tmpFile.c_str(), inputTabFile.c_str(), "extract/minimaps/track0-1-");
 
-        remove("extract/tmp-unpacked.dat");
+        remove(tmpFile.c_str());
     } else {
         //non extended game version does not use RNC compression!
         ExtractImagesfromDataFile(inputDatFile.c_str(), inputTabFile.c_str(), "extract/minimaps/track0-1-");
@@ -1670,7 +2172,7 @@ void PrepareData::ExtractHUD2PlayersSVGA() {
     //Unknown format 	RNC-compressed = No 	HUD 2-Player (SVGA)
     //locate the needed input files
     irr::io::path inputDatFile =
-            mInfra->LocateFileInFileList(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>("panel0-0.dat"));
+            LocateInputFile(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>("panel0-0.dat"));
 
     if (inputDatFile.empty()) {
         //dat file not found!
@@ -1678,7 +2180,7 @@ void PrepareData::ExtractHUD2PlayersSVGA() {
     }
 
     irr::io::path inputTabFile =
-            mInfra->LocateFileInFileList(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>("panel0-0.tab"));
+            LocateInputFile(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>("panel0-0.tab"));
 
     if (inputTabFile.empty()) {
         //tab file not found!
@@ -1697,7 +2199,7 @@ void PrepareData::ExtractLargeGreenFontSVGA() {
     //Unknown format 	RNC-compressed = No 	Large Green Font (SVGA)
     //locate the needed input files
     irr::io::path inputDatFile =
-            mInfra->LocateFileInFileList(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>("pfont0-1.dat"));
+            LocateInputFile(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>("pfont0-1.dat"));
 
     if (inputDatFile.empty()) {
         //dat file not found!
@@ -1705,7 +2207,7 @@ void PrepareData::ExtractLargeGreenFontSVGA() {
     }
 
     irr::io::path inputTabFile =
-            mInfra->LocateFileInFileList(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>("pfont0-1.tab"));
+            LocateInputFile(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>("pfont0-1.tab"));
 
     if (inputTabFile.empty()) {
         //tab file not found!
@@ -1726,7 +2228,7 @@ void PrepareData::ExtractLargeFontSVGA() {
     //Unknown format 	RNC-compressed = Yes 	Large white font (SVGA)
     //locate the needed input files
     irr::io::path inputDatFile =
-            mInfra->LocateFileInFileList(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>("olfnt0-1.dat"));
+            LocateInputFile(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>("olfnt0-1.dat"));
 
     if (inputDatFile.empty()) {
         //dat file not found!
@@ -1734,7 +2236,7 @@ void PrepareData::ExtractLargeFontSVGA() {
     }
 
     irr::io::path inputTabFile =
-            mInfra->LocateFileInFileList(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>("olfnt0-1.tab"));
+            LocateInputFile(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>("olfnt0-1.tab"));
 
     if (inputTabFile.empty()) {
         //tab file not found!
@@ -1761,7 +2263,7 @@ void PrepareData::ExtractSmallFontSVGA() {
     //Unknown format 	RNC-compressed = Yes 	Small white font (SVGA)
     //locate the needed input files
     irr::io::path inputDatFile =
-            mInfra->LocateFileInFileList(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>("osfnt0-1.dat"));
+            LocateInputFile(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>("osfnt0-1.dat"));
 
     if (inputDatFile.empty()) {
         //dat file not found!
@@ -1769,7 +2271,7 @@ void PrepareData::ExtractSmallFontSVGA() {
     }
 
     irr::io::path inputTabFile =
-            mInfra->LocateFileInFileList(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>("osfnt0-1.tab"));
+            LocateInputFile(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>("osfnt0-1.tab"));
 
     if (inputTabFile.empty()) {
         //tab file not found!
@@ -1976,7 +2478,7 @@ void PrepareData::ExtractLoadingScreenSVGA() {
     //Raw VGA image 	RNC-compressed = Yes 	Loading and selection screens
     //locate the needed input files
     irr::io::path inputDatFile =
-            mInfra->LocateFileInFileList(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>("onet0-1.dat"));
+            LocateInputFile(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>("onet0-1.dat"));
 
     if (inputDatFile.empty()) {
         //dat file not found!
@@ -1998,7 +2500,7 @@ void PrepareData::ExtractSelectionScreenSVGA() {
     //Raw VGA image 	RNC-compressed = Yes 	Loading and selection screens
     //locate the needed input files
     irr::io::path inputDatFile =
-            mInfra->LocateFileInFileList(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>("oscr0-1.dat"));
+            LocateInputFile(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>("oscr0-1.dat"));
 
     if (inputDatFile.empty()) {
         //dat file not found!
@@ -2021,7 +2523,7 @@ void PrepareData::ExtractSky(char skyNr) {
 
     //locate the needed input file
     irr::io::path inputDatFile =
-            mInfra->LocateFileInFileList(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>(packFile.c_str()));
+            LocateInputFile(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>(packFile.c_str()));
 
     if (inputDatFile.empty()) {
         //dat file not found!
@@ -2295,6 +2797,11 @@ void PrepareData::ExportTerrainTextures(const char* targetFile, const char* expo
             mInfra->mDriver->writeImageToFile(imgNew, outputPic);
         }
         outputPic->drop();
+
+        //the game loads the terrain textures from the
+        //texture cache file, if available
+        TextureCache::WriteCacheFile((scaleFactor != 1.0) ? imgUp : imgNew,
+                                     TextureCache::GetCacheFileName(finalpath.c_str()));
     }
 
     //close the original picture file
@@ -2388,7 +2895,7 @@ void PrepareData::ExtractTerrainTexture(char levelNr) {
 
     //locate the needed input file
     irr::io::path inputDatFile =
-            mInfra->LocateFileInFileList(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>(packfile2.c_str()));
+            LocateInputFile(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>(packfile2.c_str()));
 
     if (inputDatFile.empty()) {
         //dat file not found!
@@ -2479,7 +2986,7 @@ irr::video::IImage* PrepareData::UpscaleImage(irr::video::IImage *srcImg, irr::u
     uint32_t *imageDataUp = (uint32_t*)upImg->lock();
     uint32_t *imageData = (uint32_t*)srcImg->lock();
 
-    xbrz::scale(scaleFactor, imageData, imageDataUp, sizex, sizey, xbrz::ColorFormat::ARGB, xbrz::ScalerCfg(), 0, sizey);
+    UpscaleImageBands(mInfra->mThreadPool, scaleFactor, imageData, imageDataUp, sizex, sizey);
 
     //release the pointers, we do not need them anymore
     srcImg->unlock();
@@ -2488,23 +2995,6 @@ irr::video::IImage* PrepareData::UpscaleImage(irr::video::IImage *srcImg, irr::u
     return upImg;
 }
 
-void PrepareData::ConvertIntroFrame(unsigned char* ByteArray, flic::Colormap colorMap, irr::u32 sizex, irr::u32 sizey,
-                                    char* outputFilename, int scaleFactor) {
-     //create an empty image
-     irr::video::IImage* img =
-             mInfra->mDriver->createImage(irr::video::ECOLOR_FORMAT::ECF_A8R8G8B8, irr::core::dimension2d<irr::u32>(sizex, sizey));
-
-    auto raw_buffer = (uint32_t*)img->lock();
-    for (const unsigned char* src=ByteArray; src<ByteArray+sizex*sizey; src++) {
-        flic::Color color = colorMap[*src];
-        *raw_buffer++ = 0xFF000000 | (color.r << 16) | (color.g << 8) | color.b;
-    }
-    img->unlock();
-
-    img = UpscaleImage(img, sizex, sizey, scaleFactor);
-    saveIrrImage(outputFilename, img);
-}
-
 void PrepareData::ReadPaletteFile(char *palFile, unsigned char* paletteDataOut) {
     int retcode=read_palette_rgb(paletteDataOut,palFile,(uint16_t)(256));
 
@@ -2758,6 +3248,10 @@ bool PrepareData::ConvertTMapImageData(char* rawDataFilename, char* outputFilena
      //close output file
      outputPic->drop();
 
+     //the game loads the sprites from the
+     //texture cache file, if available
+     TextureCache::WriteCacheFile((scaleFactor == 1.0) ? img : imgUp, TextureCache::GetCacheFileName(outputFilename));
+
     delete[] ByteArray;
     free(arrR);
     free(arrG);
@@ -2775,7 +3269,7 @@ void PrepareData::ExtractIntroductoryScreen() {
     //Raw image 320×200 	RNC-compressed = Yes 	320x200 Introductory screen
     //locate the needed input files
     irr::io::path inputDatFile =
-            mInfra->LocateFileInFileList(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>("title.dat"));
+            LocateInputFile(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>("title.dat"));
 
     if (inputDatFile.empty()) {
         //dat file not found!
@@ -2797,7 +3291,7 @@ void PrepareData::ExtractThinWhiteFontSVGA() {
     //Unknown format 	RNC-compressed = Yes 	Thin white font (SVGA) (SVGA)
     //locate the needed input files
     irr::io::path inputDatFile =
-            mInfra->LocateFileInFileList(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>("hfont0-0.dat"));
+            LocateInputFile(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>("hfont0-0.dat"));
 
     if (inputDatFile.empty()) {
         //dat file not found!
@@ -2805,7 +3299,7 @@ void PrepareData::ExtractThinWhiteFontSVGA() {
     }
 
     irr::io::path inputTabFile =
-            mInfra->LocateFileInFileList(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>("hfont0-0.tab"));
+            LocateInputFile(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>("hfont0-0.tab"));
 
     if (inputTabFile.empty()) {
         //tab file not found!
@@ -2826,7 +3320,7 @@ void PrepareData::ExtractEditorCursors() {
     //Unknown format 	RNC-compressed = Yes 	Editor cursors
     //locate the needed input files
     irr::io::path inputDatFile =
-            mInfra->LocateFileInFileList(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>("point0-0.dat"));
+            LocateInputFile(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>("point0-0.dat"));
 
     if (inputDatFile.empty()) {
         //dat file not found!
@@ -2834,7 +3328,7 @@ void PrepareData::ExtractEditorCursors() {
     }
 
     irr::io::path inputTabFile =
-            mInfra->LocateFileInFileList(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>("point0-0.tab"));
+            LocateInputFile(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>("point0-0.tab"));
 
     if (inputTabFile.empty()) {
         //tab file not found!
@@ -2853,7 +3347,7 @@ void PrepareData::ExtractEditorItemsLarge() {
     //Unknown format 	RNC-compressed = Yes 	Editor icons (large)
     //locate the needed input files
     irr::io::path inputDatFile =
-            mInfra->LocateFileInFileList(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>("hspr0-0.dat"));
+            LocateInputFile(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>("hspr0-0.dat"));
 
     if (inputDatFile.empty()) {
         //dat file not found!
@@ -2861,7 +3355,7 @@ void PrepareData::ExtractEditorItemsLarge() {
     }
 
     irr::io::path inputTabFile =
-            mInfra->LocateFileInFileList(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>("hspr0-0.tab"));
+            LocateInputFile(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>("hspr0-0.tab"));
 
     if (inputTabFile.empty()) {
         //tab file not found!
@@ -2880,7 +3374,7 @@ void PrepareData::ExtractEditorItemsSmall() {
     //Unknown format 	RNC-compressed = Yes 	Editor icons (small)
     //locate the needed input files
     irr::io::path inputDatFile =
-            mInfra->LocateFileInFileList(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>("mspr0-0.dat"));
+            LocateInputFile(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>("mspr0-0.dat"));
 
     if (inputDatFile.empty()) {
         //dat file not found!
@@ -2888,7 +3382,7 @@ void PrepareData::ExtractEditorItemsSmall() {
     }
 
     irr::io::path inputTabFile =
-            mInfra->LocateFileInFileList(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>("mspr0-0.tab"));
+            LocateInputFile(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>("mspr0-0.tab"));
 
     if (inputTabFile.empty()) {
         //tab file not found!
@@ -2913,7 +3407,7 @@ void PrepareData::ExtractModelTextures() {
 
     //locate the needed input files
     irr::io::path inputDatFile =
-            mInfra->LocateFileInFileList(mInfra->mOriginalGame->objectsFolder, irr::core::string<fschar_t>("tex0-0.dat"));
+            LocateInputFile(mInfra->mOriginalGame->objectsFolder, irr::core::string<fschar_t>("tex0-0.dat"));
 
     if (inputDatFile.empty()) {
         //dat file not found!
@@ -2921,7 +3415,7 @@ void PrepareData::ExtractModelTextures() {
     }
 
     irr::io::path inputTabFile =
-            mInfra->LocateFileInFileList(mInfra->mOriginalGame->objectsFolder, irr::core::string<fschar_t>("tex0-0.tab"));
+            LocateInputFile(mInfra->mOriginalGame->objectsFolder, irr::core::string<fschar_t>("tex0-0.tab"));
 
     if (inputTabFile.empty()) {
         //tab file not found!
@@ -2988,7 +3482,7 @@ void PrepareData::ExtractTmaps() {
 
     //locate the needed input file
     irr::io::path inputDatFile =
-            mInfra->LocateFileInFileList(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>("tmaps.dat"));
+            LocateInputFile(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>("tmaps.dat"));
 
     if (inputDatFile.empty()) {
         //dat file not found!
@@ -3089,7 +3583,7 @@ void PrepareData::ExtractTmaps() {
 void PrepareData::SplitSoundDatFile() {
     //locate the needed input file
     irr::io::path inputDatFile =
-            mInfra->LocateFileInFileList(mInfra->mOriginalGame->soundFolder, irr::core::string<fschar_t>("sound.dat"));
+            LocateInputFile(mInfra->mOriginalGame->soundFolder, irr::core::string<fschar_t>("sound.dat"));
 
     if (inputDatFile.empty()) {
         //dat file not found!
@@ -3151,14 +3645,14 @@ void PrepareData::RNCUnpackSoundData() {
     }
 }
 
-bool PrepareData::ExtractAudio() {
+bool PrepareData::ExtractAudio(PrepareDataStepStruct* step) {
     //Information on https://moddingwiki.shikadi.net/wiki/Hi_Octane
     //Many of the game's files are compressed using the Rob Northern Compression format;
     //some of them such as SOUND\SOUND.DAT are a concatenation of many RNC archives simply glued together.
-    if (currSubStep == 0) {
+    if (step->currSubStep == 0) {
         logging::Info("Extracting sounds...");
         PrepareSubDir("extract/sound");
-        nrSubSteps = 7;
+        step->nrSubSteps = 7;
     }
 
     char infofilename1[50];
@@ -3168,7 +3662,7 @@ bool PrepareData::ExtractAudio() {
     char splitfilename1[50];
     char ofilename1[50];
 
-    switch(currSubStep) {
+    switch(step->currSubStep) {
         case 0: {
             //Split the glued together RNC
             //archives
@@ -3269,9 +3763,9 @@ bool PrepareData::ExtractAudio() {
         }
     }
 
-    currSubStep++;
+    step->currSubStep++;
 
-    return (currSubStep >= nrSubSteps);
+    return (step->currSubStep >= step->nrSubSteps);
 }
 
 uint32_t PrepareData::read_uint32_le_file (FILE *fp)
@@ -3434,7 +3928,7 @@ void PrepareData::ExtractMusic() {
 
     //locate the needed input file
     irr::io::path inputDatFile =
-            mInfra->LocateFileInFileList(mInfra->mOriginalGame->soundFolder, irr::core::string<fschar_t>("music.dat"));
+            LocateInputFile(mInfra->mOriginalGame->soundFolder, irr::core::string<fschar_t>("music.dat"));
 
     if (inputDatFile.empty()) {
         //dat file not found!
@@ -3562,7 +4056,7 @@ void PrepareData::RepairFLI(const char* outputFLIFileName) {
 
     //locate the needed input file
     irr::io::path inputDatFile =
-            mInfra->LocateFileInFileList(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>("intro.dat"));
+            LocateInputFile(mInfra->mOriginalGame->dataFolder, irr::core::string<fschar_t>("intro.dat"));
 
     if (inputDatFile.empty()) {
         //dat file not found!
@@ -3600,95 +4094,61 @@ void PrepareData::RepairFLI(const char* outputFLIFileName) {
     free(destFName);
 }
 
-//Extracts the intro in single frames that we can then
-//load and play using Irrlicht
-void PrepareData::InitFLIProcessing(const char* inputFile) {
-    FILE* f = std::fopen(inputFile, "rb");
-    mFLIFileInterface = new flic::StdioFileInterface(f);
-    mFLIDecoder = new flic::Decoder(mFLIFileInterface);
-    mFLIHeader = new flic::Header();
-    if (!mFLIDecoder->readHeader(*mFLIHeader)) {
-        std::string errMsg("Error reading FLI header in file ");
-        errMsg.append(inputFile);
-        throw errMsg;
-    }
-
-   mFLIBuffer = new std::vector<uint8_t>();
-   mFLIBuffer->resize(mFLIHeader->width * mFLIHeader->height);
-   mFLIFrame = new flic::Frame();
-
-   mFLIFrame->pixels = mFLIBuffer->data();
-   mFLIFrame->rowstride = mFLIHeader->width;
-}
+//decodes all frames of the repaired intro FLI file once, so that a
+//broken file is already found during the extraction, and not only
+//when the intro is played
+void PrepareData::VerifyIntroFLI(const char* fliFileName) {
+    FILE* f = std::fopen(fliFileName, "rb");
 
-void PrepareData::CleanupFLIProcessing() {
-  delete mFLIFrame;
-  mFLIFrame = nullptr;
+    if (f == nullptr) {
+        throw std::string("Cannot open file: ") + fliFileName;
+    }
 
-  delete mFLIBuffer;
-  mFLIBuffer = nullptr;
+    flic::StdioFileInterface fileInterface(f);
+    flic::Decoder decoder(&fileInterface);
+    flic::Header header;
 
-  delete mFLIHeader;
-  mFLIHeader = nullptr;
+    bool fliOk = decoder.readHeader(header) && (header.frames > 0);
 
-  delete mFLIDecoder;
-  mFLIDecoder = nullptr;
+    if (fliOk) {
+        std::vector<uint8_t> pixels((size_t)(header.width) * header.height, 0);
 
-  delete mFLIFileInterface;
-  mFLIFileInterface = nullptr;
-}
+        flic::Frame frame;
+        frame.pixels = pixels.data();
+        frame.rowstride = header.width;
 
-//Extracts a single frame
-void PrepareData::ProcessFrame(long currFrameNr) {
-    if (!mFLIDecoder->readFrame(*mFLIFrame)) {
-        std::string errMsg("Error reading frame ");
-        errMsg.append(std::to_string(currFrameNr));
-        throw errMsg;
+        for (int frameNr = 0; fliOk && (frameNr < header.frames); frameNr++) {
+            fliOk = decoder.readFrame(frame);
+        }
     }
 
-    //process the current decoded frame data in buffer
-    char outFrameFileName[50];
-    char fname[20];
+    fclose(f);
 
-    //create the filename for the picture output file
-    strcpy(outFrameFileName, "extract/intro/frame");
-    //28.12.2025: Change from png image format to jpg instead
-    //The image quality loss is not really visible, but instead of
-    //85.7 MB during my experiments we only need 11.9 MB on disc for the
-    //overall sequence
-    //sprintf (fname, "%0*lu.png", 4, i);
-    sprintf (fname, "%0*lu.jpg", 4, currFrameNr);
-    strcat(outFrameFileName, fname);
-
-    std::string msg("");
-    msg.append("Upscaling frame ");
-    msg.append(std::to_string(currFrameNr));
-    msg.append("...");
-    logging::Info(msg);
-
-    //original frame size is 320x200, scale with factor of 2 to get frames with 640 x 400
-    ConvertIntroFrame(mFLIBuffer->data(), mFLIFrame->colormap, mFLIHeader->width,
-                      mFLIHeader->height, outFrameFileName, 2);
+    if (!fliOk) {
+        throw std::string("Error decoding FLI file ") + fliFileName;
+    }
 }
 
 void PrepareData::ConvertCompressedImageData(const char* packfile, const char* outfile, irr::u32 sizex, irr::u32 sizey, int scaleFactor) {
-    UnpackDataFile(packfile, "extract/tmp-unpacked.dat");
+    std::string tmpFile = GetTempFileName();
+    UnpackDataFile(packfile, tmpFile.c_str());
 
     // upscale original image data if necessary
-    ConvertRawImageData("extract/tmp-unpacked.dat", sizex, sizey, outfile, scaleFactor);
+    ConvertRawImageData(tmpFile.c_str(), sizex, sizey, outfile, scaleFactor);
 
-    remove("extract/tmp-unpacked.dat");
+    remove(tmpFile.c_str());
 }
 
 void PrepareData::ExtractCompressedImagesFromDataFile(const char* datFileName, const char* tabFileName, const char* outdir) {
-    UnpackDataFile(datFileName, "extract/tmp-unpacked.dat");
+    std::string tmpFile = GetTempFileName();
+    UnpackDataFile(datFileName, tmpFile.c_str());
 
     ExtractImagesfromDataFile(
-        "extract/tmp-unpacked.dat",
+        tmpFile.c_str(),
         tabFileName,
         outdir);
 
-    remove("extract/tmp-unpacked.dat");
+    remove(tmpFile.c_str());
 }
 
 irr::video::IImage* PrepareData::loadRawImage(const char* rawDataFilename, irr::u32 sizex, irr::u32 sizey) {
@@ -3763,21 +4223,37 @@ void PrepareData::ExtractImagesfromDataFile(const char* datfname, const char* ta
     }
 }
 
-// wrap main_unpack to take const char* arguments and throw an exception on error
+//unpacks a RNC packed file with RncDecoder, and throws an exception on error
+//files that are not RNC packed are copied unchanged (same as main_unpack did before)
 void PrepareData::UnpackDataFile(const char* packfile, const char* unpackfile) {
     logging::Detail(std::string("unpacking ") + packfile);
 
-    // we need to temporarily copy the strings because main_unpack takes char* arguments.
-    char* _packfile = strdup(packfile);
-    char* _unpackfile = strdup(unpackfile);
+    std::vector<unsigned char> packed = loadRawFile(packfile);
 
-    int unpack_res = main_unpack(_packfile, _unpackfile);
+    if ((packed.size() < 3) || (strncmp((const char*)(packed.data()), "RNC", 3) != 0)) {
+        if ((strcmp(packfile, unpackfile) != 0) && (copy_file(packfile, unpackfile) != 0)) {
+            throw std::string("Error unpacking file: ") + packfile;
+        }
+
+        return;
+    }
+
+    std::vector<unsigned char> unpacked;
+    long unpack_res = RncDecoder::Unpack(packed.data(), packed.size(), unpacked);
+
+    if (unpack_res < 0) {
+        throw std::string("Error unpacking file: ") + packfile + " (" + rnc_error(unpack_res) + ")";
+    }
+
+    FILE* oFile = fopen(unpackfile, "wb");
+    if (oFile == nullptr) {
+        throw std::string("Cannot open file for writing: ") + unpackfile;
+    }
 
-    free(_packfile);
-    free(_unpackfile);
+    size_t written = fwrite(unpacked.data(), 1, unpacked.size(), oFile);
 
-    if (unpack_res != 0) {
-        throw std::string("Error unpacking file: ") + packfile;
+    if ((fclose(oFile) != 0) || (written != unpacked.size())) {
+        throw std::string("Error writing file: ") + unpackfile;
     }
 }
 
@@ -4173,7 +4649,7 @@ bool PrepareData::StorePreProcessedFontCharacter(FontCharacterPreprocessInfo& ch
 void PrepareData::PreProcessFontDirectory(const char* fontDirName, const char* srcFilePrefix, bool addOutline, irr::video::SColor* outLineColor,
                                           bool cleanUp) {
     //Create a list of files existing in specified font dir
-    irr::io::IFileList* fList = mInfra->CreateFileList(irr::io::path(fontDirName));
+    irr::io::IFileList* fList = mInfra->CreateFileListThreadSafe(irr::io::path(fontDirName));
 
     if (fList == nullptr) {
         throw std::string("PreProcessFontDirectory: Can not search for files in source directory");
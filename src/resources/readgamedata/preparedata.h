@@ -17,6 +17,7 @@
 #include <cstdint>
 #include <string>
 #include <vector>
+#include <atomic>
 #include "../intro/flic.h"
 #include "../readgamedata/xtabdat8.h"
 
@@ -34,6 +35,14 @@
 #define PREP_DATA_EXTRACTAUDIO 11
 #define PREP_DATA_EXTRACTMISC 12
 #define PREP_DATA_FINISHED 13
+//extraction of the first data needed for the loading screen
+#define PREP_DATA_EXTRACTINITIAL 14
+
+//needs to be increased whenever the extraction code changes in a way
+//that changes the extracted files; Then all data is extracted again
+#define DEF_PREP_DATA_EXTRACTOR_VERSION 5
+
+#define DEF_PREP_DATA_MANIFEST_FILE "extract/manifest.txt"
 
 #define OBJ_EXPORT_DEF_UVMAP_NORMAL 0
 #define OBJ_EXPORT_DEF_UVMAP_FLIPU 1
@@ -45,6 +54,9 @@
  ************************/
 
 class InfrastructureBase;
+struct ThreadPoolJob;
+class ExtractManifest;
+struct ExtractManifestStepStruct;
 
 class ObjTexModification {
 public:
@@ -94,6 +106,29 @@ typedef struct FontCharacterPreprocessInfo {
     std::vector<irr::video::SColor> charColorVec;
 } FontCharacterPreprocessInfo;
 
+//one extraction step (game HUD, fonts, skies...), each step is
+//executed as one job on the thread pool
+typedef struct PrepareDataStepStruct {
+    //one of the PREP_DATA_EXTRACT defines
+    irr::u8 stepId;
+    std::string description;
+
+    ThreadPoolJob* job = nullptr;
+
+    //progress of the step, is written by the worker thread
+    //and read by the main thread for the progress bar
+    std::atomic<irr::u32> currSubStep{0};
+    std::atomic<irr::u32> nrSubSteps{0};
+
+    //all original game files the step has read
+    std::vector<std::string> inputFileVec;
+
+    //the new manifest entry for this step, is created by the worker
+    //thread at the end of the step, and then added to the manifest
+    //by the main thread
+    ExtractManifestStepStruct* manifestEntry = nullptr;
+} PrepareDataStepStruct;
+
 class PrepareData {
 
 public:
@@ -130,31 +165,88 @@ private:
     void ReadMusicFileEntry(FILE* inputFile, MUSICTABLEENTRY* entry);
 
     void CreatePalette();
+    std::string mPaletteFileName;
+
+    //Stuff for incremental extraction
+    ExtractManifest* mManifest = nullptr;
+
+    //ids of all steps that need to be extracted (again)
+    std::vector<irr::u8> mRedoStepIdVec;
+
+    //each extracted file belongs to the step
+    //with the longest matching path prefix
+    std::vector<std::pair<irr::u8, std::string>> mStepOutputPrefixVec;
+
+    //extracted files that end with one of these suffixes do not belong
+    //to any step, because they are modified after the extraction
+    std::vector<std::string> mStepOutputExcludeSuffixVec;
+
+    //pairs of steps that always need to be extracted together
+    std::vector<std::pair<irr::u8, irr::u8>> mStepLinkVec;
+
+    void DefineExtractionSteps();
+    void FindStepsToRedo(bool extractDirPresent);
+    bool StepNeedsRedo(irr::u8 stepId);
+
+    //returns PREP_DATA_INITSTATE if the file does
+    //not belong to any step
+    irr::u8 GetOutputFileStep(const std::string& fileName);
+
+    //returns true if the unpacked level files of
+    //all available levels exist
+    bool AllUnpackedLevelFilesPresent();
+
+    //finds all files written by the step, and computes the checksums
+    //for inputs and outputs; Throws an error message if a file could not be read
+    ExtractManifestStepStruct* CreateManifestEntry(PrepareDataStepStruct* step);
+
+    uint32_t GetUpscaleSettingsChecksum();
+
+    //same as LocateFileInFileList of InfrastructureBase, but also remembers
+    //the file as input file of the step that is currently executed by this thread
+    irr::io::path LocateInputFile(irr::io::IFileList* fileList, irr::core::string<irr::fschar_t> fileName,
+                                  bool ignoreFileEnding = false);
 
     void ExtractImagesfromDataFile(const char* datfname, const char* tabfname, const char* outputDir);
     void UnpackDataFile(const char* packfile, const char* unpackfile);
     std::vector<unsigned char> loadRawFile(const char *filename);
 
-    irr::u32 currSubStep;
-    irr::u32 nrSubSteps;
+    //all extraction steps, with their jobs
+    std::vector<PrepareDataStepStruct*> mStepVec;
+
+    void CreateExtractionJobs();
+    PrepareDataStepStruct* AddExtractionStep(irr::u8 stepId, const char* description,
+                                             std::vector<PrepareDataStepStruct*> dependsOnSteps = {});
+
+    //is executed by the worker thread, runs all sub steps of the step
+    void RunExtractionStep(PrepareDataStepStruct* step);
+
+    //waits for all steps that are still running, and releases
+    //the jobs afterwards
+    void ReleaseExtractionJobs();
+
+    //steps run in parallel, therefore each temporary file
+    //needs its own unique filename
+    std::atomic<irr::u32> mTempFileCnt{0};
+    std::string GetTempFileName();
 
     void ExtractInitialData();
 
     //The following methods return true if their work
     //is done, false otherwise
-    bool ExtractGameScreens();
-    bool ExtractFonts();
-    bool ExtractHuds();
-    bool ExtractSkies();
-    bool ExtractSprites();
-    bool ExtractMiniMaps();
-    bool ExtractTerrainTextures();
-    bool ExtractLevels();
-    bool ExtractMisc();
+    bool ExtractGameScreens(PrepareDataStepStruct* step);
+    bool ExtractFonts(PrepareDataStepStruct* step);
+    bool ExtractHuds(PrepareDataStepStruct* step);
+    bool ExtractSkies(PrepareDataStepStruct* step);
+    bool ExtractSprites(PrepareDataStepStruct* step);
+    bool ExtractMiniMaps(PrepareDataStepStruct* step);
+    bool ExtractTerrainTextures(PrepareDataStepStruct* step);
+    bool ExtractLevels(PrepareDataStepStruct* step);
+    bool ExtractMisc(PrepareDataStepStruct* step);
     void ExtractCheatPuzzle();
-    bool ExtractModels();
-    bool ExtractIntro();
-    bool ExtractAudio();
+    bool ExtractModels(PrepareDataStepStruct* step);
+    bool ExtractIntro(PrepareDataStepStruct* step);
+    bool ExtractAudio(PrepareDataStepStruct* step);
     void ExtractUserdata();
 
     //extracts sound files from sound.data
@@ -168,13 +260,24 @@ private:
 
     //Tabfile information for model texture atlas file
     //this information is needed to be able to export
-    //the objects in wavefront object file
+    //the objects into mesh files
     TABFILE *modelsTabFileInfo = nullptr;
     irr::core::dimension2d<irr::f32> modelTexAtlasSize;
 
+    //true if the 3D models are additionally written as Wavefront obj files
+    //for debugging (command line option "exportobj")
+    bool mExportObjFiles = false;
+
     void Extract3DModel(const char* srcFilename, const char* destFilename, const char* objName);
     void ExtractNamed3DModel(const char* name, int n_models);
 
+    //The color schemes of a craft only differ in the used texture coordinates. For each color scheme
+    //this creates a texture, with which the model of the first color scheme looks exactly like the model
+    //of this color scheme ("car0-1-tex.png" for "car0-1.hmesh"), so that the game needs to load the craft
+    //geometry only once. If this is not possible for a color scheme no texture is written; Then the game
+    //loads the own model of this color scheme instead
+    void CreateCraftColorSchemeTextures(const char* name, int n_models);
+
     void UpscaleExistingImageFile(const char* srcFile, const char* destFile, int scaleFactor);
 
     //extracts the SVGA game logo data in data\logo0-1.dat and data\logo0-1.tab
@@ -281,20 +384,9 @@ private:
 
     bool ConvertTMapImageData(char* rawDataFilename, char* outputFilename, int scaleFactor);
 
-    //Variables for Intro
-    //Processing
-    flic::StdioFileInterface* mFLIFileInterface = nullptr;
-    flic::Decoder* mFLIDecoder = nullptr;
-    flic::Header* mFLIHeader = nullptr;
-    flic::Frame* mFLIFrame = nullptr;
-    std::vector<uint8_t>* mFLIBuffer = nullptr;
-
-    void InitFLIProcessing(const char* inputFile);
-    void CleanupFLIProcessing();
+    //Intro processing
     void RepairFLI(const char* outputFLIFileName);
-    void ProcessFrame(long currFrameNr);
-    void ConvertIntroFrame(unsigned char* ByteArray, flic::Colormap colorMap, irr::u32 sizex, irr::u32 sizey,
-                           char* outputFilename, int scaleFactor);
+    void VerifyIntroFLI(const char* fliFileName);
 
     void SplitSoundDatFile();
     unsigned long mNrSoundFiles;
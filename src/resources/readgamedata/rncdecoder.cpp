@@ -0,0 +1,464 @@
+/*
+ Copyright (C) 2026 Wolf Alexander
+
+ This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.                                          */
+
+#include "rncdecoder.h"
+#include "dernc.h"
+#include <cstring>
+
+//The RNC bit stream consists of 16 bit little endian words, the literal bytes are stored
+//in between them. The decoder in dernc.cpp always holds the next word as lookahead in its
+//bit buffer, and the literals start at the position of this lookahead word. We keep up to
+//four words in our buffer instead; Before literals are copied all complete words that are
+//still unused are given back, which leads to the same literal start position
+
+typedef struct RncBitStream {
+    //packed data after the header; Bytes up to dataEnd are part of
+    //the stream, the original decoder also reads words that start
+    //at dataEnd, in this case bytes up to bufferEnd are used
+    const unsigned char* data;
+    size_t dataEnd;
+    size_t bufferEnd;
+
+    //position of the next word that is not in the bit buffer yet
+    size_t wordPos;
+
+    uint64_t bitBuf;
+    irr::u32 bitCount;
+} RncBitStream;
+
+typedef struct RncHufEntry {
+    unsigned long code;
+    irr::u32 codeLen;
+    irr::u32 value;
+} RncHufEntry;
+
+//a chunk can keep the table of the chunk before (see ReadHufTable), the
+//table starts empty so that broken data never uses undefined entries
+typedef struct RncHufTable {
+    irr::u32 num = 0;
+    RncHufEntry entry[32] = {};
+
+    //for each possible value of the next DEF_RNC_HUFLOOKUPBITS bits: code length in the
+    //high byte and value in the low byte, 0 if the code is longer (or there is none)
+    irr::u16 lookup[1 << DEF_RNC_HUFLOOKUPBITS] = {};
+} RncHufTable;
+
+static unsigned long ReadBigEndian32(const unsigned char* p) {
+    return ((unsigned long)(p[0]) << 24) | ((unsigned long)(p[1]) << 16) | ((unsigned long)(p[2]) << 8) | p[3];
+}
+
+static irr::u16 ReadBigEndian16(const unsigned char* p) {
+    return (irr::u16)((p[0] << 8) | p[1]);
+}
+
+static void BitRefill(RncBitStream& bs) {
+    while (bs.bitCount <= 48) {
+        uint64_t word = 0;
+
+        //same as the original, which reads the word at
+        //the end position, but not behind it
+        if (bs.wordPos <= bs.dataEnd) {
+            if (bs.wordPos < bs.bufferEnd)
+                word = bs.data[bs.wordPos];
+
+            if ((bs.wordPos + 1) < bs.bufferEnd)
+                word |= ((uint64_t)(bs.data[bs.wordPos + 1]) << 8);
+        }
+
+        bs.bitBuf |= (word << bs.bitCount);
+        bs.bitCount += 16;
+        bs.wordPos += 2;
+    }
+}
+
+//the caller needs to make sure that there are at least n bits in the buffer
+static irr::u32 BitRead(RncBitStream& bs, irr::u32 n) {
+    irr::u32 result = (irr::u32)(bs.bitBuf & ((((uint64_t)(1)) << n) - 1));
+
+    bs.bitBuf >>= n;
+    bs.bitCount -= n;
+
+    return result;
+}
+
+//position of the first word that was not used for the bit stream until now, the words
+//that are completely unused are given back; Afterwards the buffer only contains the bits
+//that are left from the last used word
+static size_t BitSyncPosition(RncBitStream& bs) {
+    irr::u32 unusedWords = bs.bitCount / 16;
+
+    bs.wordPos -= 2 * unusedWords;
+    bs.bitCount -= 16 * unusedWords;
+    bs.bitBuf &= ((((uint64_t)(1)) << bs.bitCount) - 1);
+
+    return bs.wordPos;
+}
+
+//Mirror the bottom n bits of x (same as in dernc.cpp)
+static unsigned long Mirror(unsigned long x, irr::u32 n) {
+    unsigned long top = 1UL << (n - 1), bottom = 1;
+
+    while (top > bottom) {
+        unsigned long mask = top | bottom;
+        unsigned long masked = x & mask;
+
+        if ((masked != 0) && (masked != mask))
+            x ^= mask;
+
+        top >>= 1;
+        bottom <<= 1;
+    }
+
+    return x;
+}
+
+static void ReadHufTable(RncHufTable& h, RncBitStream& bs) {
+    BitRefill(bs);
+    irr::u32 num = BitRead(bs, 5);
+
+    //the original keeps the table of the last chunk in this case
+    if (num == 0)
+        return;
+
+    irr::u32 leafLen[32];
+    irr::u32 leafMax = 1;
+
+    for (irr::u32 i = 0; i < num; i++) {
+        BitRefill(bs);
+        leafLen[i] = BitRead(bs, 4);
+
+        if (leafMax < leafLen[i])
+            leafMax = leafLen[i];
+    }
+
+    //create the codes in the same order as the original,
+    //the first code in this order that matches wins
+    unsigned long codeb = 0;
+    irr::u32 k = 0;
+
+    for (irr::u32 i = 1; i <= leafMax; i++) {
+        for (irr::u32 j = 0; j < num; j++) {
+            if (leafLen[j] == i) {
+                h.entry[k].code = Mirror(codeb, i);
+                h.entry[k].codeLen = i;
+                h.entry[k].value = j;
+                codeb++;
+                k++;
+            }
+        }
+
+        codeb <<= 1;
+    }
+
+    h.num = k;
+
+    memset(h.lookup, 0, sizeof(h.lookup));
+
+    for (irr::u32 i = 0; i < h.num; i++) {
+        irr::u32 codeLen = h.entry[i].codeLen;
+
+        //codes with bits above the code length can never match
+        if ((codeLen > DEF_RNC_HUFLOOKUPBITS) || ((h.entry[i].code >> codeLen) != 0))
+            continue;
+
+        for (unsigned long idx = h.entry[i].code; idx < (1UL << DEF_RNC_HUFLOOKUPBITS); idx += (1UL << codeLen)) {
+            if (h.lookup[idx] == 0) {
+                h.lookup[idx] = (irr::u16)((codeLen << 8) | h.entry[i].value);
+            }
+        }
+    }
+}
+
+//returns -1 if no code matches
+static long HufRead(RncHufTable& h, RncBitStream& bs) {
+    BitRefill(bs);
+
+    irr::u16 lookup = h.lookup[bs.bitBuf & ((1UL << DEF_RNC_HUFLOOKUPBITS) - 1)];
+    irr::u32 codeLen;
+    irr::u32 value;
+
+    if (lookup != 0) {
+        codeLen = (lookup >> 8);
+        value = (lookup & 0xFF);
+    } else {
+        //longer code
+        irr::u32 i;
+
+        for (i = 0; i < h.num; i++) {
+            uint64_t mask = (((uint64_t)(1)) << h.entry[i].codeLen) - 1;
+
+            if ((bs.bitBuf & mask) == h.entry[i].code)
+                break;
+        }
+
+        if (i == h.num)
+            return -1;
+
+        codeLen = h.entry[i].codeLen;
+        value = h.entry[i].value;
+    }
+
+    BitRead(bs, codeLen);
+
+    if (value < 2)
+        return (long)(value);
+
+    //the value is followed by its lower bits
+    return (long)((1UL << (value - 1)) | BitRead(bs, value - 1));
+}
+
+typedef struct RncCrcTables {
+    irr::u16 table[4][256];
+
+    RncCrcTables() {
+        for (irr::u32 i = 0; i < 256; i++) {
+            irr::u16 val = (irr::u16)(i);
+
+            for (int j = 0; j < 8; j++) {
+                if (val & 1)
+                    val = (val >> 1) ^ 0xA001;
+                else
+                    val = (val >> 1);
+            }
+
+            table[0][i] = val;
+        }
+
+        //table[k] gives the effect of a byte that
+        //is followed by k more bytes
+        for (irr::u32 k = 1; k < 4; k++) {
+            for (irr::u32 i = 0; i < 256; i++) {
+                irr::u16 prev = table[k - 1][i];
+                table[k][i] = (prev >> 8) ^ table[0][prev & 0xFF];
+            }
+        }
+    }
+} RncCrcTables;
+
+uint16_t RncDecoder::Crc(const unsigned char* data, size_t len) {
+    //created only once, thread safe
+    static const RncCrcTables tables;
+
+    irr::u16 val = 0;
+
+    while (len >= 4) {
+        irr::u16 x = val ^ (irr::u16)(data[0] | (data[1] << 8));
+
+        val = tables.table[3][x & 0xFF] ^ tables.table[2][x >> 8] ^ tables.table[1][data[2]] ^ tables.table[0][data[3]];
+
+        data += 4;
+        len -= 4;
+    }
+
+    while (len > 0) {
+        val ^= *data++;
+        val = (val >> 8) ^ tables.table[0][val & 0xFF];
+        len--;
+    }
+
+    return val;
+}
+
+bool RncDecoder::IsRncData(const unsigned char* packed, size_t packedLen) {
+    return ((packedLen >= DEF_RNC_HEADERSIZE) && (ReadBigEndian32(packed) == RNC_SIGNATURE));
+}
+
+long RncDecoder::GetUnpackedLength(const unsigned char* packed, size_t packedLen) {
+    if (!IsRncData(packed, packedLen))
+        return RNC_FILE_IS_NOT_RNC;
+
+    return (long)(ReadBigEndian32(packed + 4));
+}
+
+long RncDecoder::Unpack(const unsigned char* packed, size_t packedLen, unsigned char* unpacked, size_t unpackedLen,
+                        unsigned int flags) {
+    if (packedLen < DEF_RNC_HEADERSIZE)
+        return RNC_HEADER_VAL_ERROR;
+
+    if (ReadBigEndian32(packed) != RNC_SIGNATURE) {
+        if (!(flags & RNC_IGNORE_HEADER_VAL_ERROR))
+            return RNC_HEADER_VAL_ERROR;
+    }
+
+    unsigned long retLen = ReadBigEndian32(packed + 4);
+    unsigned long inpLen = ReadBigEndian32(packed + 8);
+
+    if ((retLen > (1UL << 30)) || (inpLen > (1UL << 30)))
+        return RNC_HEADER_VAL_ERROR;
+
+    //the packed data must be complete, and
+    //the output must fit into the buffer
+    if ((inpLen > (packedLen - DEF_RNC_HEADERSIZE)) || (retLen > unpackedLen))
+        return RNC_FILE_SIZE_MISMATCH;
+
+    const unsigned char* input = packed + DEF_RNC_HEADERSIZE;
+
+    if (Crc(input, inpLen) != ReadBigEndian16(packed + 14)) {
+        if (!(flags & RNC_IGNORE_PACKED_CRC_ERROR))
+            return RNC_PACKED_CRC_ERROR;
+    }
+
+    irr::u16 outCrc = ReadBigEndian16(packed + 12);
+
+    RncBitStream bs;
+    bs.data = input;
+    bs.dataEnd = inpLen;
+    bs.bufferEnd = packedLen - DEF_RNC_HEADERSIZE;
+    bs.wordPos = 0;
+    bs.bitBuf = 0;
+    bs.bitCount = 0;
+
+    //discard first two bits
+    BitRefill(bs);
+    BitRead(bs, 2);
+
+    RncHufTable raw;
+    RncHufTable dist;
+    RncHufTable len;
+
+    size_t outPos = 0;
+    bool stop = false;
+
+    //process chunks
+    while ((outPos < retLen) && !stop) {
+        size_t inPos = BitSyncPosition(bs);
+
+        if (((long)(inpLen) - (long)(inPos)) < 6) {
+            if (!(flags & RNC_IGNORE_HUF_EXCEEDS_RANGE))
+                return RNC_HUF_EXCEEDS_RANGE;
+
+            break;
+        }
+
+        ReadHufTable(raw, bs);
+        ReadHufTable(dist, bs);
+        ReadHufTable(len, bs);
+
+        BitRefill(bs);
+        unsigned long chCount = BitRead(bs, 16);
+
+        while (true) {
+            long length = HufRead(raw, bs);
+
+            if (length < 0) {
+                if (!(flags & RNC_IGNORE_HUF_DECODE_ERROR))
+                    return RNC_HUF_DECODE_ERROR;
+
+                stop = true;
+                break;
+            }
+
+            if (length > 0) {
+                //copy literal bytes
+                inPos = BitSyncPosition(bs);
+
+                if (((inPos + length) > inpLen) || ((outPos + length) > retLen)) {
+                    if (!(flags & RNC_IGNORE_HUF_EXCEEDS_RANGE))
+                        return RNC_HUF_EXCEEDS_RANGE;
+
+                    stop = true;
+                    break;
+                }
+
+                memcpy(&unpacked[outPos], &input[inPos], length);
+                outPos += length;
+                bs.wordPos = inPos + length;
+            }
+
+            if (--chCount == 0)
+                break;
+
+            long posn = HufRead(dist, bs);
+
+            if (posn >= 0) {
+                length = HufRead(len, bs);
+            }
+
+            if ((posn < 0) || (length < 0)) {
+                if (!(flags & RNC_IGNORE_HUF_DECODE_ERROR))
+                    return RNC_HUF_DECODE_ERROR;
+
+                stop = true;
+                break;
+            }
+
+            posn += 1;
+            length += 2;
+
+            if (((size_t)(posn) > outPos) || ((outPos + length) > retLen)) {
+                if (!(flags & RNC_IGNORE_HUF_EXCEEDS_RANGE))
+                    return RNC_HUF_EXCEEDS_RANGE;
+
+                stop = true;
+                break;
+            }
+
+            //source and destination can overlap, this
+            //repeats the last posn bytes
+            unsigned char* dest = &unpacked[outPos];
+            const unsigned char* src = dest - posn;
+
+            if (posn >= length) {
+                memcpy(dest, src, length);
+            } else {
+                for (long i = 0; i < length; i++) {
+                    dest[i] = src[i];
+                }
+            }
+
+            outPos += length;
+        }
+    }
+
+    //with the ignore flags decoding stops at the first
+    //error, the rest of the output is left as it is
+    if (stop) {
+        outPos = retLen;
+    }
+
+    if (outPos != retLen) {
+        if (!(flags & RNC_IGNORE_FILE_SIZE_MISMATCH))
+            return RNC_FILE_SIZE_MISMATCH;
+    }
+
+    if (Crc(unpacked, retLen) != outCrc) {
+        if (!(flags & RNC_IGNORE_UNPACKED_CRC_ERROR))
+            return RNC_UNPACKED_CRC_ERROR;
+    }
+
+    return (long)(retLen);
+}
+
+long RncDecoder::Unpack(const unsigned char* packed, size_t packedLen, std::vector<unsigned char>& unpacked,
+                        unsigned int flags) {
+    long unpackedLen = GetUnpackedLength(packed, packedLen);
+
+    if (unpackedLen < 0) {
+        if (!(flags & RNC_IGNORE_HEADER_VAL_ERROR))
+            return unpackedLen;
+
+        if (packedLen < DEF_RNC_HEADERSIZE)
+            return RNC_HEADER_VAL_ERROR;
+
+        unpackedLen = (long)(ReadBigEndian32(packed + 4));
+    }
+
+    if ((unsigned long)(unpackedLen) > (1UL << 30))
+        return RNC_HEADER_VAL_ERROR;
+
+    unpacked.resize(unpackedLen);
+
+    long result = Unpack(packed, packedLen, unpacked.data(), unpacked.size(), flags);
+
+    if (result < 0) {
+        unpacked.clear();
+    }
+
+    return result;
+}
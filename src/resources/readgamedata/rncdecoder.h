@@ -0,0 +1,53 @@
+/*
+ Copyright (C) 2026 Wolf Alexander
+
+ This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.                                          */
+
+#ifndef RNCDECODER_H
+#define RNCDECODER_H
+
+#include "irrlicht.h"
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+//size of the header in front of the packed data
+#define DEF_RNC_HEADERSIZE 18
+
+//Huffman codes up to this length are decoded with one table
+//lookup, longer codes with a search through the code list
+#define DEF_RNC_HUFLOOKUPBITS 9
+
+//In memory decoder for RNC (method 1) compressed data of the original game. It produces exactly
+//the same result as the decoder in dernc.cpp, but decodes the Huffman codes with a lookup table,
+//and reads the bit stream through a 64 bit buffer. The error codes and flags are the same as of
+//rnc_unpack (see dernc.h)
+class RncDecoder {
+public:
+    //returns true if the data starts with the RNC
+    //signature, and the header is complete
+    static bool IsRncData(const unsigned char* packed, size_t packedLen);
+
+    //returns the unpacked length from the header,
+    //or a negative error code
+    static long GetUnpackedLength(const unsigned char* packed, size_t packedLen);
+
+    //Unpacks packedLen bytes at packed into the output buffer, which must have room for at least
+    //GetUnpackedLength bytes. Bytes behind the end of the packed data are never read
+    //Returns the unpacked length, or a negative error code
+    static long Unpack(const unsigned char* packed, size_t packedLen, unsigned char* unpacked, size_t unpackedLen,
+                       unsigned int flags = 0);
+
+    //same as above, but the output vector is resized as needed
+    static long Unpack(const unsigned char* packed, size_t packedLen, std::vector<unsigned char>& unpacked,
+                       unsigned int flags = 0);
+
+    //the RNC CRC-16 (same result as rnc_crc), computes 4 bytes per step
+    static uint16_t Crc(const unsigned char* data, size_t len);
+};
+
+#endif // RNCDECODER_H
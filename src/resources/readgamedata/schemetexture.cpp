@@ -0,0 +1,136 @@
+/*
+ Copyright (C) 2026 Wolf Alexander
+
+ This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.                                          */
+
+#include "schemetexture.h"
+#include <cmath>
+#include <cstring>
+
+//converts a texture coordinate in texels into
+//the index of the texel that contains it
+static irr::u32 GetTexelIdx(irr::f32 coord, irr::u32 size) {
+    irr::s32 idx = (irr::s32)(floorf(coord));
+
+    if (idx < 0)
+        return 0;
+
+    if (idx >= (irr::s32)(size))
+        return (size - 1);
+
+    return (irr::u32)(idx);
+}
+
+void ForEachSchemeTexel(const std::vector<float>& uvCoords, const std::vector<float>& otherUvCoords,
+                        irr::u32 width, irr::u32 height,
+                        const std::function<void(irr::u32 x, irr::u32 y, irr::u32 srcX, irr::u32 srcY)>& texelFunc) {
+    irr::f32 atlasWidth = (irr::f32)(width);
+    irr::f32 atlasHeight = (irr::f32)(height);
+
+    //texture coordinates of the current triangle in texels,
+    //p for the first triangles, q for the other triangles
+    irr::core::vector2df p[3];
+    irr::core::vector2df q[3];
+
+    size_t nrTriangles = uvCoords.size() / 6;
+
+    for (size_t triIdx = 0; triIdx < nrTriangles; triIdx++) {
+        for (int k = 0; k < 3; k++) {
+            p[k].X = uvCoords.at(triIdx * 6 + k * 2) * atlasWidth;
+            p[k].Y = uvCoords.at(triIdx * 6 + k * 2 + 1) * atlasHeight;
+            q[k].X = otherUvCoords.at(triIdx * 6 + k * 2) * atlasWidth;
+            q[k].Y = otherUvCoords.at(triIdx * 6 + k * 2 + 1) * atlasHeight;
+        }
+
+        irr::f32 area = (p[1].X - p[0].X) * (p[2].Y - p[0].Y) - (p[2].X - p[0].X) * (p[1].Y - p[0].Y);
+
+        if (fabs(area) < 0.0001f) {
+            //degenerated triangle, for example a triangle without texture (all
+            //texture coordinates are 0); only the texels at the corners are used
+            for (int k = 0; k < 3; k++) {
+                texelFunc(GetTexelIdx(p[k].X, width), GetTexelIdx(p[k].Y, height),
+                          GetTexelIdx(q[k].X, width), GetTexelIdx(q[k].Y, height));
+            }
+
+            continue;
+        }
+
+        irr::u32 minX = GetTexelIdx(fmin(p[0].X, fmin(p[1].X, p[2].X)), width);
+        irr::u32 maxX = GetTexelIdx(fmax(p[0].X, fmax(p[1].X, p[2].X)), width);
+        irr::u32 minY = GetTexelIdx(fmin(p[0].Y, fmin(p[1].Y, p[2].Y)), height);
+        irr::u32 maxY = GetTexelIdx(fmax(p[0].Y, fmax(p[1].Y, p[2].Y)), height);
+
+        for (irr::u32 y = minY; y <= maxY; y++) {
+            for (irr::u32 x = minX; x <= maxX; x++) {
+                //barycentric coordinates of the texel center
+                irr::f32 cx = (irr::f32)(x) + 0.5f;
+                irr::f32 cy = (irr::f32)(y) + 0.5f;
+
+                irr::f32 b1 = ((cx - p[0].X) * (p[2].Y - p[0].Y) - (p[2].X - p[0].X) * (cy - p[0].Y)) / area;
+                irr::f32 b2 = ((p[1].X - p[0].X) * (cy - p[0].Y) - (cx - p[0].X) * (p[1].Y - p[0].Y)) / area;
+                irr::f32 b0 = 1.0f - b1 - b2;
+
+                //texel center outside of the triangle?
+                if ((b0 < -0.0001f) || (b1 < -0.0001f) || (b2 < -0.0001f))
+                    continue;
+
+                //same position in the other triangle
+                irr::f32 srcX = b0 * q[0].X + b1 * q[1].X + b2 * q[2].X;
+                irr::f32 srcY = b0 * q[0].Y + b1 * q[1].Y + b2 * q[2].Y;
+
+                texelFunc(x, y, GetTexelIdx(srcX, width), GetTexelIdx(srcY, height));
+            }
+        }
+    }
+}
+
+bool BakeSchemeTexture(const std::vector<float>& uvCoords, const std::vector<float>& otherUvCoords,
+                       const uint32_t* atlas, uint32_t* schemeTex, irr::u32 width, irr::u32 height) {
+    if (uvCoords.size() != otherUvCoords.size())
+        return false;
+
+    //texels that are not used by the triangles
+    //keep the content of the atlas
+    memcpy(schemeTex, atlas, (size_t)(width) * (size_t)(height) * sizeof(uint32_t));
+
+    //which texel of the atlas was copied into a texel of schemeTex,
+    //-1 means the texel was not written yet
+    std::vector<irr::s32> texelSourceVec(width * height, -1);
+    bool conflict = false;
+
+    ForEachSchemeTexel(uvCoords, otherUvCoords, width, height, [&](irr::u32 x, irr::u32 y, irr::u32 srcX, irr::u32 srcY) {
+        irr::s32 srcIdx = (irr::s32)(srcY * width + srcX);
+        irr::s32 &currSrcIdx = texelSourceVec[y * width + x];
+
+        if (currSrcIdx == -1) {
+            currSrcIdx = srcIdx;
+            schemeTex[y * width + x] = atlas[srcIdx];
+        } else if (atlas[srcIdx] != atlas[currSrcIdx]) {
+            //this texel is shared between triangles that show
+            //different content with the other texture coordinates
+            conflict = true;
+        }
+    });
+
+    return !conflict;
+}
+
+bool VerifySchemeTexture(const std::vector<float>& uvCoords, const std::vector<float>& otherUvCoords,
+                         const uint32_t* atlas, const uint32_t* schemeTex, irr::u32 width, irr::u32 height) {
+    if (uvCoords.size() != otherUvCoords.size())
+        return false;
+
+    bool texelsOk = true;
+
+    ForEachSchemeTexel(uvCoords, otherUvCoords, width, height, [&](irr::u32 x, irr::u32 y, irr::u32 srcX, irr::u32 srcY) {
+        if (schemeTex[y * width + x] != atlas[srcY * width + srcX]) {
+            texelsOk = false;
+        }
+    });
+
+    return texelsOk;
+}
@@ -0,0 +1,41 @@
+/*
+ Copyright (C) 2026 Wolf Alexander
+
+ This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.                                          */
+
+#ifndef SCHEMETEXTURE_H
+#define SCHEMETEXTURE_H
+
+#include "irrlicht.h"
+#include <cstdint>
+#include <vector>
+#include <functional>
+
+//Creation of the color scheme textures of the crafts. The color schemes of a craft have the same triangles,
+//and only use other texture coordinates in the model texture atlas. The functions below work on the texture
+//coordinates of the triangles (6 values per triangle, u and v of the 3 corners, in the range 0 up to 1, like
+//ObjectDatFile stores them) and on ARGB images with width x height texels, and do not need the Irrlicht device
+
+//calls texelFunc for every atlas texel (x, y) that a triangle with the texture coordinates uvCoords samples,
+//together with the atlas texel (srcX, srcY) that the same triangle with otherUvCoords samples at the same position
+void ForEachSchemeTexel(const std::vector<float>& uvCoords, const std::vector<float>& otherUvCoords,
+                        irr::u32 width, irr::u32 height,
+                        const std::function<void(irr::u32 x, irr::u32 y, irr::u32 srcX, irr::u32 srcY)>& texelFunc);
+
+//Writes a texture into schemeTex, in which every texel the triangles with uvCoords sample is replaced by the atlas texel
+//the triangles with otherUvCoords sample at the same position; All other texels are copied from the atlas. With this
+//texture the first triangles look exactly like the other triangles with the atlas. Returns false if the same texel
+//would need to show different atlas texels, then the content of schemeTex is undefined
+bool BakeSchemeTexture(const std::vector<float>& uvCoords, const std::vector<float>& otherUvCoords,
+                       const uint32_t* atlas, uint32_t* schemeTex, irr::u32 width, irr::u32 height);
+
+//returns true if schemeTex gives the triangles with uvCoords exactly the same
+//texels as the triangles with otherUvCoords get from the atlas
+bool VerifySchemeTexture(const std::vector<float>& uvCoords, const std::vector<float>& otherUvCoords,
+                         const uint32_t* atlas, const uint32_t* schemeTex, irr::u32 width, irr::u32 height);
+
+#endif // SCHEMETEXTURE_H
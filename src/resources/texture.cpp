@@ -11,6 +11,11 @@
 #include <string>
 #include "../utils/logging.h"
 #include "../infrabase.h"
+#include "texturecache.h"
+#include "levelfile.h"
+#include "blockdefinition.h"
+#include "columndefinition.h"
+#include <algorithm>
 
 void TextureLoader::LoadLevelTextures(const char* filePathLevelRootDir, const char* filePathBaseTextures) {
     int currTexIdx = 0;
@@ -21,6 +26,9 @@ void TextureLoader::LoadLevelTextures(const char* filePathLevelRootDir, const ch
     NumLevelTextures = 0;
     NumCustomLevelTextures = 0;
 
+    mLevelTexFileName.clear();
+    mLevelTexIsCustom.clear();
+
     //01.01.2026: Changed behavior: First build file name in level
     //root directory for each texture, to see if the user supplied
     //us with an alternative (replacement) texture file
@@ -87,28 +95,25 @@ void TextureLoader::LoadLevelTextures(const char* filePathLevelRootDir, const ch
              finalPath.append(".png");
         }
 
-        //loading the specified terrain texture file
-        newTex = mInfra->mDriver->getTexture(finalPath);
+        mLevelTexFileName.push_back(finalPath);
+        mLevelTexIsCustom.push_back(customTex);
 
-        if (newTex == nullptr) {
-            char hlpstr[500];
-            std::string msg("");
+        //in on demand mode the texture is only
+        //loaded when it is requested later
+        newTex = nullptr;
 
-            //loading texture failed
-            snprintf(hlpstr, 500, "Failed to load texture: %s", finalPath.c_str());
-            msg.clear();
-            msg.append(hlpstr);
-            logging::Error(msg);
+        if (!mLevelTexturesOnDemand) {
+            newTex = LoadLevelTexture(currTexIdx);
 
-            mLoadSuccess = false;
+            if (newTex == nullptr) {
+                if (!fallBackDefaultTex) {
+                    //drop the file list again
+                    //not that we get a memory leak!
+                    fList->drop();
+                }
 
-            if (!fallBackDefaultTex) {
-                //drop the file list again
-                //not that we get a memory leak!
-                fList->drop();
+                return;
             }
-
-            return;
         }
 
         //add new texture to texture vector
@@ -132,6 +137,128 @@ void TextureLoader::LoadLevelTextures(const char* filePathLevelRootDir, const ch
     }
 }
 
+irr::video::ITexture* TextureLoader::LoadLevelTexture(int texId) {
+    irr::video::ITexture* newTex = nullptr;
+    const irr::io::path& finalPath = mLevelTexFileName.at(texId);
+
+    //loading the specified terrain texture file, the default
+    //textures are usually available in the texture cache
+    if (!mLevelTexIsCustom.at(texId)) {
+        newTex = TextureCache::LoadTexture(mInfra->mDriver, mInfra->mDevice->getFileSystem(), finalPath);
+    }
+
+    if (newTex == nullptr) {
+        newTex = mInfra->mDriver->getTexture(finalPath);
+    }
+
+    if (newTex == nullptr) {
+        char hlpstr[500];
+        std::string msg("");
+
+        //loading texture failed
+        snprintf(hlpstr, 500, "Failed to load texture: %s", finalPath.c_str());
+        msg.clear();
+        msg.append(hlpstr);
+        logging::Error(msg);
+
+        mLoadSuccess = false;
+    }
+
+    return newTex;
+}
+
+irr::video::ITexture* TextureLoader::GetLevelTexture(int texId) {
+    if ((texId < 0) || (texId >= (int)(levelTex.size())))
+        return nullptr;
+
+    //texture was not requested before, or the request
+    //queue did not reach it yet, load it now
+    if (levelTex[texId] == nullptr) {
+        levelTex[texId] = LoadLevelTexture(texId);
+    }
+
+    return levelTex[texId];
+}
+
+void TextureLoader::AddLevelTextureRequest(int texId) {
+    if ((texId < 0) || (texId >= (int)(levelTex.size())))
+        return;
+
+    //already loaded
+    if (levelTex[texId] != nullptr)
+        return;
+
+    if (std::find(mLevelTexRequestVec.begin(), mLevelTexRequestVec.end(), texId) != mLevelTexRequestVec.end())
+        return;
+
+    mLevelTexRequestVec.push_back(texId);
+}
+
+void TextureLoader::RequestLevelTextures(LevelFile* levelRes) {
+    //terrain tiles, including the tiles that
+    //are only shown after a morph
+    for (int x = 0; x < levelRes->Width(); x++) {
+        for (int y = 0; y < levelRes->Height(); y++) {
+            if (levelRes->pMap[x][y] != nullptr) {
+                AddLevelTextureRequest(levelRes->pMap[x][y]->m_TextureId);
+            }
+        }
+    }
+
+    //all faces of all block definitions, not only of the
+    //blocks that are placed at the start of the race
+    std::vector<BlockDefinition*>::iterator itBlock;
+
+    for (itBlock = levelRes->BlockDefinitions.begin(); itBlock != levelRes->BlockDefinitions.end(); ++itBlock) {
+        AddLevelTextureRequest((*itBlock)->get_N());
+        AddLevelTextureRequest((*itBlock)->get_E());
+        AddLevelTextureRequest((*itBlock)->get_S());
+        AddLevelTextureRequest((*itBlock)->get_W());
+        AddLevelTextureRequest((*itBlock)->get_T());
+        AddLevelTextureRequest((*itBlock)->get_B());
+    }
+
+    //the floor texture is used for the terrain
+    //tile below a destroyed column
+    std::vector<ColumnDefinition*>::iterator itColumn;
+
+    for (itColumn = levelRes->ColumnDefinitions.begin(); itColumn != levelRes->ColumnDefinitions.end(); ++itColumn) {
+        AddLevelTextureRequest((*itColumn)->get_FloorTextureID());
+    }
+
+    //load the textures in Id order, the queue
+    //is processed from the back
+    std::sort(mLevelTexRequestVec.begin(), mLevelTexRequestVec.end(), std::greater<int>());
+}
+
+irr::u32 TextureLoader::ProcessLevelTextureRequests(irr::u32 maxNrTextures) {
+    for (irr::u32 nr = 0; (nr < maxNrTextures) && !mLevelTexRequestVec.empty(); nr++) {
+        int texId = mLevelTexRequestVec.back();
+        mLevelTexRequestVec.pop_back();
+
+        GetLevelTexture(texId);
+    }
+
+    return (irr::u32)(mLevelTexRequestVec.size());
+}
+
+irr::u32 TextureLoader::GetNrLevelTextureRequests() {
+    return (irr::u32)(mLevelTexRequestVec.size());
+}
+
+irr::u32 TextureLoader::GetNrResidentLevelTextures() {
+    irr::u32 nrTextures = 0;
+
+    std::vector<irr::video::ITexture*>::iterator it;
+
+    for (it = levelTex.begin(); it != levelTex.end(); ++it) {
+        if ((*it) != nullptr)
+            nrTextures++;
+    }
+
+    return nrTextures;
+}
+
 void TextureLoader::LoadSpriteTextures(const char* filePath, bool makeTransparent) {
     int currTexIdx = 0;
     char finalpath[70];
@@ -148,7 +275,11 @@ void TextureLoader::LoadSpriteTextures(const char* filePath, bool makeTransparen
         strcat(finalpath, fname);
 
         //loading the specified sprite texture file
-        newTex = mInfra->mDriver->getTexture(finalpath);
+        newTex = TextureCache::LoadTexture(mInfra->mDriver, mInfra->mDevice->getFileSystem(), finalpath);
+
+        if (newTex == nullptr) {
+            newTex = mInfra->mDriver->getTexture(finalpath);
+        }
 
         if (newTex == nullptr) {
             char hlpstr[500];
@@ -224,11 +355,14 @@ void TextureLoader::LoadEditorTextures() {
 }
 
 TextureLoader::TextureLoader(InfrastructureBase* infra, const char* filePathLevelRootDir, const char* filePathBaseTextures,
-                             bool useCustomTextures, const char* spriteTexFilePath, bool loadLevelEditorSprites) {
+                             bool useCustomTextures, const char* spriteTexFilePath, bool loadLevelEditorSprites,
+                             bool levelTexturesOnDemand) {
    mInfra = infra;
    mUseCustomTextures = useCustomTextures;
+   mLevelTexturesOnDemand = levelTexturesOnDemand;
 
-   //load all level textures
+   //load all level textures, or in on demand mode
+   //only find out the texture file names
    LoadLevelTextures(filePathLevelRootDir, filePathBaseTextures);
 
    //load all sprite textures
@@ -251,6 +385,11 @@ TextureLoader::~TextureLoader() {
 
            it = levelTex.erase(it);
 
+           //textures that were never requested
+           //are not loaded
+           if (pntr == nullptr)
+               continue;
+
            //free texture via driver
            mInfra->mDriver->removeTexture(pntr);
        }
@@ -20,6 +20,7 @@ using namespace irr::core;
  ************************/
 
 class InfrastructureBase;
+class LevelFile;
 
 class TextureLoader {
 
@@ -33,20 +34,52 @@ public:
     std::vector<irr::video::ITexture*> levelTex;
     std::vector<irr::video::ITexture*> spriteTex;
     std::vector<irr::video::ITexture*> editorTex;
+    //if levelTexturesOnDemand is true the level textures are not loaded in the constructor, levelTex contains
+    //nullptr for each texture until it is loaded via GetLevelTexture or the request queue
     TextureLoader(InfrastructureBase* infra, const char* filePathLevelRootDir, const char* filePathBaseTextures,
-                  bool useCustomTextures, const char* spriteTexFilePath, bool loadLevelEditorSprites = false);
+                  bool useCustomTextures, const char* spriteTexFilePath, bool loadLevelEditorSprites = false,
+                  bool levelTexturesOnDemand = false);
     ~TextureLoader();
 
     void LoadLevelTextures(const char* filePathLevelRootDir, const char* filePathBaseTextures);
     void LoadSpriteTextures(const char* filePath, bool makeTransparent = false);
     void LoadEditorTextures();
 
+    //returns the level texture with the specified Id, a texture that is not loaded yet
+    //is loaded immediately; Returns nullptr for an invalid Id, or if loading failed
+    irr::video::ITexture* GetLevelTexture(int texId);
+
+    //adds all level textures that the level file references to the request queue: the terrain tiles,
+    //the faces of all block definitions, and the floor textures of the column definitions
+    void RequestLevelTextures(LevelFile* levelRes);
+
+    //loads up to maxNrTextures textures of the request queue, returns
+    //the number of textures that are still waiting in the queue
+    irr::u32 ProcessLevelTextureRequests(irr::u32 maxNrTextures);
+
+    //number of textures that are still waiting in the request queue
+    irr::u32 GetNrLevelTextureRequests();
+
+    irr::u32 GetNrResidentLevelTextures();
+
     bool mLoadSuccess = true;
 
 private:
     InfrastructureBase* mInfra = nullptr;
 
     bool mUseCustomTextures;
+    bool mLevelTexturesOnDemand = false;
+
+    //file name of each level texture (index is
+    //texture Id), and if it is a custom texture
+    std::vector<irr::io::path> mLevelTexFileName;
+    std::vector<bool> mLevelTexIsCustom;
+
+    //Ids of the requested level textures that are not loaded yet
+    std::vector<int> mLevelTexRequestVec;
+
+    irr::video::ITexture* LoadLevelTexture(int texId);
+    void AddLevelTextureRequest(int texId);
 
     void LoadEditorTexture(const char* fileName, bool makeTransparent = false);
 };
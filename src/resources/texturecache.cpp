@@ -0,0 +1,234 @@
+/*
+ Copyright (C) 2026 Wolf Alexander
+
+ This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.                                          */
+
+#include "texturecache.h"
+#include "../utils/logging.h"
+#include <string>
+#include <cstdio>
+
+//size of the header at the start of the cache file
+#define DEF_TEXTURECACHE_HEADERSIZE 24
+
+irr::io::path TextureCache::GetCacheFileName(const irr::io::path& imageFileName) {
+    std::string fileName(imageFileName.c_str());
+
+    size_t dotPos = fileName.find_last_of('.');
+    size_t slashPos = fileName.find_last_of("/\\");
+
+    //only remove a file ending, not a dot
+    //in a directory name
+    if ((dotPos != std::string::npos) && ((slashPos == std::string::npos) || (dotPos > slashPos))) {
+        fileName.erase(dotPos);
+    }
+
+    fileName.append(".");
+    fileName.append(DEF_TEXTURECACHE_EXTENSION);
+
+    return irr::io::path(fileName.c_str());
+}
+
+bool TextureCache::IsPowerOfTwo(irr::u32 value) {
+    return ((value != 0) && ((value & (value - 1)) == 0));
+}
+
+irr::u32 TextureCache::GetNrMipLevels(irr::u32 width, irr::u32 height) {
+    irr::u32 nrLevels = 1;
+
+    while ((width > 1) || (height > 1)) {
+        if (width > 1)
+            width >>= 1;
+
+        if (height > 1)
+            height >>= 1;
+
+        nrLevels++;
+    }
+
+    return nrLevels;
+}
+
+void TextureCache::CreateMipChain(const irr::u32* srcPixels, irr::u32 width, irr::u32 height,
+                                  std::vector<irr::u32>& mipChain) {
+    mipChain.assign(srcPixels, srcPixels + (size_t)(width) * height);
+
+    size_t srcOffset = 0;
+
+    while ((width > 1) || (height > 1)) {
+        irr::u32 newWidth = (width > 1) ? (width >> 1) : 1;
+        irr::u32 newHeight = (height > 1) ? (height >> 1) : 1;
+
+        size_t destOffset = mipChain.size();
+        mipChain.resize(destOffset + (size_t)(newWidth) * newHeight);
+
+        for (irr::u32 y = 0; y < newHeight; y++) {
+            for (irr::u32 x = 0; x < newWidth; x++) {
+                //the 2x2 source pixels, if the source level has only
+                //one line or column the same pixels are used twice
+                irr::u32 srcX1 = x * 2;
+                irr::u32 srcX2 = (width > 1) ? (srcX1 + 1) : srcX1;
+                irr::u32 srcY1 = y * 2;
+                irr::u32 srcY2 = (height > 1) ? (srcY1 + 1) : srcY1;
+
+                irr::u32 pix[4];
+                pix[0] = mipChain[srcOffset + (size_t)(srcY1) * width + srcX1];
+                pix[1] = mipChain[srcOffset + (size_t)(srcY1) * width + srcX2];
+                pix[2] = mipChain[srcOffset + (size_t)(srcY2) * width + srcX1];
+                pix[3] = mipChain[srcOffset + (size_t)(srcY2) * width + srcX2];
+
+                irr::u32 result = 0;
+
+                //average each of the 4 color channels, with rounding
+                for (irr::u32 shift = 0; shift < 32; shift += 8) {
+                    irr::u32 sum = 2;
+
+                    for (int k = 0; k < 4; k++) {
+                        sum += (pix[k] >> shift) & 0xFF;
+                    }
+
+                    result |= ((sum >> 2) << shift);
+                }
+
+                mipChain[destOffset + (size_t)(y) * newWidth + x] = result;
+            }
+        }
+
+        srcOffset = destOffset;
+        width = newWidth;
+        height = newHeight;
+    }
+}
+
+bool TextureCache::WriteCacheFile(irr::video::IImage* image, const irr::io::path& cacheFileName) {
+    irr::core::dimension2du dim = image->getDimension();
+
+    if (!IsPowerOfTwo(dim.Width) || !IsPowerOfTwo(dim.Height))
+        return false;
+
+    //we always store ECF_A8R8G8B8, convert other formats first
+    std::vector<irr::u32> srcPixels((size_t)(dim.Width) * dim.Height);
+
+    for (irr::u32 y = 0; y < dim.Height; y++) {
+        for (irr::u32 x = 0; x < dim.Width; x++) {
+            srcPixels[(size_t)(y) * dim.Width + x] = image->getPixel(x, y).color;
+        }
+    }
+
+    std::vector<irr::u32> mipChain;
+    CreateMipChain(srcPixels.data(), dim.Width, dim.Height, mipChain);
+
+    FILE* oFile = fopen(cacheFileName.c_str(), "wb");
+
+    if (oFile == nullptr) {
+        std::string msg("TextureCache: Could not write file ");
+        msg.append(cacheFileName.c_str());
+        logging::Warning(msg);
+        return false;
+    }
+
+    irr::u32 header[6] = { DEF_TEXTURECACHE_MAGIC, DEF_TEXTURECACHE_VERSION, (irr::u32)(irr::video::ECF_A8R8G8B8),
+                           dim.Width, dim.Height, GetNrMipLevels(dim.Width, dim.Height) };
+
+    fwrite(header, sizeof(header), 1, oFile);
+    fwrite(mipChain.data(), sizeof(irr::u32), mipChain.size(), oFile);
+
+    bool writeOk = (ferror(oFile) == 0);
+
+    if (fclose(oFile) != 0) {
+        writeOk = false;
+    }
+
+    if (!writeOk) {
+        //do not leave a broken file behind
+        remove(cacheFileName.c_str());
+    }
+
+    return writeOk;
+}
+
+irr::video::ITexture* TextureCache::LoadTexture(irr::video::IVideoDriver* driver, irr::io::IFileSystem* fileSystem,
+                                                const irr::io::path& imageFileName) {
+    //texture could be loaded already
+    irr::video::ITexture* tex = driver->findTexture(imageFileName);
+
+    if (tex != nullptr)
+        return tex;
+
+    //if the driver wants to use another color format
+    //for the texture our mip levels do not fit
+    if (driver->getTextureCreationFlag(irr::video::ETCF_ALWAYS_16_BIT) ||
+            driver->getTextureCreationFlag(irr::video::ETCF_OPTIMIZED_FOR_SPEED))
+        return nullptr;
+
+    irr::io::IReadFile* file = fileSystem->createAndOpenFile(GetCacheFileName(imageFileName));
+
+    if (file == nullptr)
+        return nullptr;
+
+    irr::u32 header[6];
+    bool valid = (file->read(header, sizeof(header)) == (irr::s32)(sizeof(header)));
+
+    valid = valid && (header[0] == DEF_TEXTURECACHE_MAGIC) && (header[1] == DEF_TEXTURECACHE_VERSION) &&
+            (header[2] == (irr::u32)(irr::video::ECF_A8R8G8B8)) && IsPowerOfTwo(header[3]) && IsPowerOfTwo(header[4]) &&
+            (header[5] == GetNrMipLevels(header[3], header[4]));
+
+    std::vector<irr::u32> mipChain;
+
+    if (valid) {
+        //size of all mip levels together
+        size_t nrPixels = 0;
+        irr::u32 width = header[3];
+        irr::u32 height = header[4];
+
+        for (irr::u32 level = 0; level < header[5]; level++) {
+            nrPixels += (size_t)(width) * height;
+
+            if (width > 1)
+                width >>= 1;
+
+            if (height > 1)
+                height >>= 1;
+        }
+
+        valid = ((long)(DEF_TEXTURECACHE_HEADERSIZE + nrPixels * sizeof(irr::u32)) == file->getSize());
+
+        if (valid) {
+            mipChain.resize(nrPixels);
+            valid = (file->read(mipChain.data(), (irr::u32)(nrPixels * sizeof(irr::u32))) ==
+                     (irr::s32)(nrPixels * sizeof(irr::u32)));
+        }
+    }
+
+    file->drop();
+
+    if (!valid) {
+        std::string msg("TextureCache: Invalid texture cache file for ");
+        msg.append(imageFileName.c_str());
+        logging::Warning(msg);
+        return nullptr;
+    }
+
+    //the image uses our data directly, and the
+    //remaining mip levels follow the full size image
+    irr::core::dimension2du dim(header[3], header[4]);
+    irr::video::IImage* image = driver->createImageFromData(irr::video::ECF_A8R8G8B8, dim, mipChain.data(), true, false);
+
+    if (image == nullptr)
+        return nullptr;
+
+    void* mipData = nullptr;
+
+    if (header[5] > 1) {
+        mipData = mipChain.data() + (size_t)(dim.Width) * dim.Height;
+    }
+
+    tex = driver->addTexture(imageFileName, image, mipData);
+    image->drop();
+
+    return tex;
+}
@@ -0,0 +1,67 @@
+/*
+ Copyright (C) 2026 Wolf Alexander
+
+ This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.                                          */
+
+#ifndef TEXTURECACHE_H
+#define TEXTURECACHE_H
+
+#include "irrlicht.h"
+#include <vector>
+
+//file extension of the texture cache files, which are
+//stored next to the png file they were created from
+#define DEF_TEXTURECACHE_EXTENSION "htex"
+
+//"HTEX" in little endian
+#define DEF_TEXTURECACHE_MAGIC 0x58455448
+#define DEF_TEXTURECACHE_VERSION 1
+
+//Texture cache file layout (all numbers little endian):
+//  Header: u32 magic, u32 version, u32 colorFormat (irr::video::ECOLOR_FORMAT), u32 width, u32 height,
+//          u32 nrMipLevels
+//  Data:   pixel data of all mip levels, starting with the full size image; Each level has half the
+//          width and height of the level before (but at least 1), the last level is 1x1. There is no
+//          padding between lines or levels. Currently only ECF_A8R8G8B8 is used (one u32 per pixel)
+
+//Cache for textures that are loaded very often (the level and sprite textures): The data extraction
+//writes the pixel data of each texture together with the complete mip chain. Loading the texture later
+//does not need to decode the png file, and the driver does not need to create the mipmaps anymore
+class TextureCache {
+public:
+    //returns the cache file name for the image file
+    //("extract/sprites/tmaps0000.png" -> "extract/sprites/tmaps0000.htex")
+    static irr::io::path GetCacheFileName(const irr::io::path& imageFileName);
+
+    //Creates the texture from the cache file that belongs to imageFileName. The texture gets imageFileName
+    //as name, so that IVideoDriver::getTexture(imageFileName) returns it later as well. Returns nullptr
+    //if there is no valid cache file, or the driver can not use the cached data; Then the texture needs
+    //to be loaded from the image file instead
+    static irr::video::ITexture* LoadTexture(irr::video::IVideoDriver* driver, irr::io::IFileSystem* fileSystem,
+                                             const irr::io::path& imageFileName);
+
+    //Writes the cache file for the image (including all mip levels)
+    //Images whose width or height is not a power of two are not cached,
+    //as the driver could need to rescale them; In this case and if the file
+    //could not be written false is returned
+    static bool WriteCacheFile(irr::video::IImage* image, const irr::io::path& cacheFileName);
+
+    //number of mip levels including the full size image,
+    //down to a size of 1x1
+    static irr::u32 GetNrMipLevels(irr::u32 width, irr::u32 height);
+
+    //Creates the pixel data of all mip levels in the layout of the cache file
+    //srcPixels contains width * height pixels in ECF_A8R8G8B8 format; Each mip level is created
+    //from the level before with a 2x2 box filter
+    static void CreateMipChain(const irr::u32* srcPixels, irr::u32 width, irr::u32 height,
+                               std::vector<irr::u32>& mipChain);
+
+private:
+    static bool IsPowerOfTwo(irr::u32 value);
+};
+
+#endif // TEXTURECACHE_H
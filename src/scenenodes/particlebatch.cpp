@@ -0,0 +1,505 @@
+/*
+ Copyright (C) 2026 Wolf Alexander
+
+ This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.                                          */
+
+#include "particlebatch.h"
+
+//***************************************************
+//*   ParticlePool class                            *
+//***************************************************
+
+ParticlePool::ParticlePool(irr::u32 maxParticles, std::vector<irr::video::ITexture*> textures) {
+    mMaxParticles = maxParticles;
+    mTextures = textures;
+
+    //preallocate all memory we need for the particles
+    //now, so that we never need to allocate during a race
+    mPosX.resize(mMaxParticles);
+    mPosY.resize(mMaxParticles);
+    mPosZ.resize(mMaxParticles);
+
+    mVelStartX.resize(mMaxParticles);
+    mVelStartY.resize(mMaxParticles);
+    mVelStartZ.resize(mMaxParticles);
+
+    mVelEndX.resize(mMaxParticles);
+    mVelEndY.resize(mMaxParticles);
+    mVelEndZ.resize(mMaxParticles);
+
+    mSize.resize(mMaxParticles);
+    mSizeStart.resize(mMaxParticles);
+    mSizeIncrease.resize(mMaxParticles);
+
+    mLifeTime.resize(mMaxParticles);
+    mLifeTimeInv.resize(mMaxParticles);
+    mLifeFraction.resize(mMaxParticles);
+
+    mTextureIdx.resize(mMaxParticles);
+
+    //default material, the same the old billboard
+    //particles were using
+    mMaterial.MaterialType = irr::video::EMT_TRANSPARENT_ADD_COLOR;
+    mMaterial.Lighting = false;
+    mMaterial.ZBuffer = irr::video::ECFN_LESSEQUAL;
+    mMaterial.ZWriteEnable = false;
+    mMaterial.BackfaceCulling = false;
+
+    mAcceleration.set(0.0f, 0.0f, 0.0f);
+}
+
+ParticlePool::~ParticlePool() {
+}
+
+irr::u32 ParticlePool::GetNrActiveParticles() {
+    return mNrActive;
+}
+
+irr::u32 ParticlePool::GetMaxParticles() {
+    return mMaxParticles;
+}
+
+//returns a random number between 0.0f and 1.0f
+irr::f32 ParticlePool::RandomFloat() {
+    //simple xorshift random generator
+    mRandState ^= mRandState << 13;
+    mRandState ^= mRandState >> 17;
+    mRandState ^= mRandState << 5;
+
+    return (irr::f32)(mRandState & 0xFFFFFF) / (irr::f32)(0xFFFFFF);
+}
+
+irr::s32 ParticlePool::Emit(irr::core::vector3df position, irr::f32 lifeTimeSec, irr::f32 initSize,
+                            irr::f32 endLifeSizeIncrease, irr::u8 textureIdx) {
+    //pool full?
+    if (mNrActive >= mMaxParticles)
+        return -1;
+
+    if (lifeTimeSec <= 0.0f)
+        return -1;
+
+    irr::u32 idx = mNrActive;
+    mNrActive++;
+
+    mPosX[idx] = position.X;
+    mPosY[idx] = position.Y;
+    mPosZ[idx] = position.Z;
+
+    mVelStartX[idx] = 0.0f;
+    mVelStartY[idx] = 0.0f;
+    mVelStartZ[idx] = 0.0f;
+
+    mVelEndX[idx] = 0.0f;
+    mVelEndY[idx] = 0.0f;
+    mVelEndZ[idx] = 0.0f;
+
+    mSize[idx] = initSize;
+    mSizeStart[idx] = initSize;
+    mSizeIncrease[idx] = endLifeSizeIncrease;
+
+    mLifeTime[idx] = lifeTimeSec;
+    mLifeTimeInv[idx] = 1.0f / lifeTimeSec;
+    mLifeFraction[idx] = 0.0f;
+
+    if (textureIdx >= mTextures.size()) {
+        textureIdx = (irr::u8)(mTextures.size() - 1);
+    }
+
+    mTextureIdx[idx] = textureIdx;
+
+    return (irr::s32)(idx);
+}
+
+void ParticlePool::SetMovementVelocity(irr::u32 idx, irr::core::vector3df initialVelocity, irr::core::vector3df finalVelocity) {
+    if (idx >= mNrActive)
+        return;
+
+    mVelStartX[idx] = initialVelocity.X;
+    mVelStartY[idx] = initialVelocity.Y;
+    mVelStartZ[idx] = initialVelocity.Z;
+
+    mVelEndX[idx] = finalVelocity.X;
+    mVelEndY[idx] = finalVelocity.Y;
+    mVelEndZ[idx] = finalVelocity.Z;
+}
+
+void ParticlePool::Kill(irr::u32 idx) {
+    if (idx >= mNrActive)
+        return;
+
+    mLifeFraction[idx] = 1.0f;
+}
+
+void ParticlePool::Clear() {
+    mNrActive = 0;
+}
+
+void ParticlePool::MoveParticle(irr::u32 srcIdx, irr::u32 dstIdx) {
+    mPosX[dstIdx] = mPosX[srcIdx];
+    mPosY[dstIdx] = mPosY[srcIdx];
+    mPosZ[dstIdx] = mPosZ[srcIdx];
+
+    mVelStartX[dstIdx] = mVelStartX[srcIdx];
+    mVelStartY[dstIdx] = mVelStartY[srcIdx];
+    mVelStartZ[dstIdx] = mVelStartZ[srcIdx];
+
+    mVelEndX[dstIdx] = mVelEndX[srcIdx];
+    mVelEndY[dstIdx] = mVelEndY[srcIdx];
+    mVelEndZ[dstIdx] = mVelEndZ[srcIdx];
+
+    mSize[dstIdx] = mSize[srcIdx];
+    mSizeStart[dstIdx] = mSizeStart[srcIdx];
+    mSizeIncrease[dstIdx] = mSizeIncrease[srcIdx];
+
+    mLifeTime[dstIdx] = mLifeTime[srcIdx];
+    mLifeTimeInv[dstIdx] = mLifeTimeInv[srcIdx];
+    mLifeFraction[dstIdx] = mLifeFraction[srcIdx];
+
+    mTextureIdx[dstIdx] = mTextureIdx[srcIdx];
+}
+
+//moves the last alive particle into the slot of each dead
+//particle, so that all alive particles stay packed at the
+//beginning of the arrays
+void ParticlePool::RemoveDeadParticles() {
+    irr::u32 idx = 0;
+
+    while (idx < mNrActive) {
+        if (mLifeFraction[idx] >= 1.0f) {
+            mNrActive--;
+
+            if (idx != mNrActive) {
+                MoveParticle(mNrActive, idx);
+            }
+
+            //check the moved particle in the
+            //next loop again
+        } else {
+            idx++;
+        }
+    }
+}
+
+void ParticlePool::Update(irr::f32 deltaTime) {
+    irr::u32 n = mNrActive;
+
+    if (n == 0)
+        return;
+
+    irr::f32* lifeFraction = mLifeFraction.data();
+    const irr::f32* lifeTimeInv = mLifeTimeInv.data();
+
+    //age all particles
+    for (irr::u32 i = 0; i < n; i++) {
+        lifeFraction[i] += deltaTime * lifeTimeInv[i];
+    }
+
+    irr::f32* posX = mPosX.data();
+    irr::f32* posY = mPosY.data();
+    irr::f32* posZ = mPosZ.data();
+
+    irr::f32* velStartX = mVelStartX.data();
+    irr::f32* velStartY = mVelStartY.data();
+    irr::f32* velStartZ = mVelStartZ.data();
+
+    irr::f32* velEndX = mVelEndX.data();
+    irr::f32* velEndY = mVelEndY.data();
+    irr::f32* velEndZ = mVelEndZ.data();
+
+    //move particles, the current velocity is interpolated between
+    //start and end velocity depending on the particle age
+    for (irr::u32 i = 0; i < n; i++) {
+        irr::f32 t = lifeFraction[i];
+
+        if (t > 1.0f)
+            t = 1.0f;
+
+        posX[i] += (velStartX[i] + (velEndX[i] - velStartX[i]) * t) * deltaTime;
+        posY[i] += (velStartY[i] + (velEndY[i] - velStartY[i]) * t) * deltaTime;
+        posZ[i] += (velStartZ[i] + (velEndZ[i] - velStartZ[i]) * t) * deltaTime;
+    }
+
+    //apply constant acceleration to both velocities
+    if (!mAcceleration.equals(irr::core::vector3df(0.0f, 0.0f, 0.0f))) {
+        irr::f32 accX = mAcceleration.X * deltaTime;
+        irr::f32 accY = mAcceleration.Y * deltaTime;
+        irr::f32 accZ = mAcceleration.Z * deltaTime;
+
+        for (irr::u32 i = 0; i < n; i++) {
+            velStartX[i] += accX;
+            velStartY[i] += accY;
+            velStartZ[i] += accZ;
+
+            velEndX[i] += accX;
+            velEndY[i] += accY;
+            velEndZ[i] += accZ;
+        }
+    }
+
+    //random movement
+    if (mRiseSpeed != 0.0f) {
+        irr::f32 rise = mRiseSpeed * deltaTime;
+
+        for (irr::u32 i = 0; i < n; i++) {
+            //random number between 0.8f and 1.2f
+            posY[i] += rise * (0.8f + RandomFloat() * 0.4f);
+        }
+    }
+
+    if (mJitterSpeedXZ != 0.0f) {
+        irr::f32 jitter = mJitterSpeedXZ * deltaTime;
+
+        for (irr::u32 i = 0; i < n; i++) {
+            //random number between -0.5f and 0.5f
+            posX[i] += jitter * (RandomFloat() - 0.5f);
+            posZ[i] += jitter * (RandomFloat() - 0.5f);
+        }
+    }
+
+    //calculate new size depending on particle age
+    irr::f32* size = mSize.data();
+    const irr::f32* sizeStart = mSizeStart.data();
+    const irr::f32* sizeIncrease = mSizeIncrease.data();
+
+    for (irr::u32 i = 0; i < n; i++) {
+        size[i] = sizeStart[i] + sizeIncrease[i] * lifeFraction[i];
+    }
+
+    RemoveDeadParticles();
+}
+
+//***************************************************
+//*   ParticleBatchSceneNode class                  *
+//***************************************************
+
+ParticleBatchSceneNode::ParticleBatchSceneNode(irr::scene::ISceneNode* parent, irr::scene::ISceneManager* mgr, irr::s32 id) :
+    irr::scene::ISceneNode(parent, mgr, id) {
+
+    //particles are everywhere in the level, and
+    //culling is done by the GPU anyway
+    setAutomaticCulling(irr::scene::EAC_OFF);
+
+    mBox.reset(irr::core::vector3df(0.0f, 0.0f, 0.0f));
+    mBox.addInternalPoint(irr::core::vector3df(-100000.0f, -100000.0f, -100000.0f));
+    mBox.addInternalPoint(irr::core::vector3df(100000.0f, 100000.0f, 100000.0f));
+
+    mMaterial.Lighting = false;
+}
+
+ParticleBatchSceneNode::~ParticleBatchSceneNode() {
+    std::vector<ParticlePool*>::iterator it;
+
+    for (it = mPoolVec.begin(); it != mPoolVec.end(); ++it) {
+        delete (*it);
+    }
+
+    mPoolVec.clear();
+
+    std::vector<ParticleBatchStruct*>::iterator itBatch;
+
+    for (itBatch = mBatchVec.begin(); itBatch != mBatchVec.end(); ++itBatch) {
+        delete (*itBatch);
+    }
+
+    mBatchVec.clear();
+}
+
+ParticlePool* ParticleBatchSceneNode::CreatePool(irr::u32 maxParticles, std::vector<irr::video::ITexture*> textures) {
+    ParticlePool* newPool = new ParticlePool(maxParticles, textures);
+
+    mPoolVec.push_back(newPool);
+
+    return newPool;
+}
+
+ParticlePool* ParticleBatchSceneNode::CreatePool(irr::u32 maxParticles, irr::video::ITexture* texture) {
+    std::vector<irr::video::ITexture*> textures;
+    textures.push_back(texture);
+
+    return CreatePool(maxParticles, textures);
+}
+
+void ParticleBatchSceneNode::RemovePool(ParticlePool* pool) {
+    std::vector<ParticlePool*>::iterator it;
+
+    for (it = mPoolVec.begin(); it != mPoolVec.end(); ++it) {
+        if ((*it) == pool) {
+            mPoolVec.erase(it);
+            delete pool;
+            return;
+        }
+    }
+}
+
+void ParticleBatchSceneNode::OnRegisterSceneNode() {
+    if (IsVisible) {
+        SceneManager->registerNodeForRendering(this, irr::scene::ESNRP_TRANSPARENT);
+    }
+
+    ISceneNode::OnRegisterSceneNode();
+}
+
+ParticleBatchSceneNode::ParticleBatchStruct* ParticleBatchSceneNode::GetBatch(irr::video::ITexture* texture,
+                                                                              const irr::video::SMaterial& material) {
+    std::vector<ParticleBatchStruct*>::iterator it;
+
+    for (it = mBatchVec.begin(); it != mBatchVec.end(); ++it) {
+        if (((*it)->texture == texture) && ((*it)->material.MaterialType == material.MaterialType)
+                && ((*it)->material.Lighting == material.Lighting)) {
+            return (*it);
+        }
+    }
+
+    //no batch for this texture yet, create a new one
+    //batches are kept, so that the vertex memory is reused
+    //in all following frames
+    ParticleBatchStruct* newBatch = new ParticleBatchStruct();
+    newBatch->texture = texture;
+    newBatch->material = material;
+    newBatch->material.setTexture(0, texture);
+
+    mBatchVec.push_back(newBatch);
+
+    return newBatch;
+}
+
+void ParticleBatchSceneNode::FlushBatch(ParticleBatchStruct* batch) {
+    irr::u32 nrVertices = batch->vertices.size();
+
+    if (nrVertices == 0)
+        return;
+
+    irr::video::IVideoDriver* driver = SceneManager->getVideoDriver();
+
+    //all quads use the same index pattern, therefore we only need
+    //to extend the shared index list if this batch is bigger than all before
+    while ((mIndices.size() / 6) * 4 < nrVertices) {
+        irr::u16 base = (irr::u16)((mIndices.size() / 6) * 4);
+
+        mIndices.push_back(base);
+        mIndices.push_back(base + 2);
+        mIndices.push_back(base + 1);
+        mIndices.push_back(base);
+        mIndices.push_back(base + 3);
+        mIndices.push_back(base + 2);
+    }
+
+    driver->setMaterial(batch->material);
+    driver->drawIndexedTriangleList(batch->vertices.const_pointer(), nrVertices,
+                                    mIndices.const_pointer(), (nrVertices / 4) * 2);
+
+    mNrDrawCallsLastFrame++;
+
+    //keep the allocated memory
+    batch->vertices.set_used(0);
+}
+
+void ParticleBatchSceneNode::render() {
+    irr::video::IVideoDriver* driver = SceneManager->getVideoDriver();
+    irr::scene::ICameraSceneNode* camera = SceneManager->getActiveCamera();
+
+    mNrParticlesLastFrame = 0;
+    mNrDrawCallsLastFrame = 0;
+
+    if ((camera == nullptr) || (driver == nullptr))
+        return;
+
+    //calculate the camera facing vectors only once
+    //for all particles, the same way the Irrlicht billboard
+    //scene node does it for each billboard
+    irr::core::vector3df campos = camera->getAbsolutePosition();
+    irr::core::vector3df target = camera->getTarget();
+    irr::core::vector3df up = camera->getUpVector();
+    irr::core::vector3df view = target - campos;
+    view.normalize();
+
+    irr::core::vector3df horizontal = up.crossProduct(view);
+    if (horizontal.getLength() == 0.0f) {
+        horizontal.set(up.Y, up.X, up.Z);
+    }
+    horizontal.normalize();
+
+    irr::core::vector3df vertical = horizontal.crossProduct(view);
+    vertical.normalize();
+
+    irr::core::vector3df normal = -view;
+
+    driver->setTransform(irr::video::ETS_WORLD, irr::core::IdentityMatrix);
+
+    std::vector<ParticlePool*>::iterator it;
+
+    for (it = mPoolVec.begin(); it != mPoolVec.end(); ++it) {
+        ParticlePool* pool = (*it);
+        irr::u32 n = pool->GetNrActiveParticles();
+
+        if (!pool->mVisible || (n == 0) || pool->mTextures.empty())
+            continue;
+
+        irr::u8 lastTexIdx = pool->mTextureIdx[0];
+        ParticleBatchStruct* batch = GetBatch(pool->mTextures[lastTexIdx], pool->mMaterial);
+
+        for (irr::u32 i = 0; i < n; i++) {
+            irr::f32 t = pool->mLifeFraction[i];
+
+            //particle killed during this frame
+            if (t >= 1.0f)
+                continue;
+
+            //only search the batch again if the texture changes
+            if (pool->mTextureIdx[i] != lastTexIdx) {
+                lastTexIdx = pool->mTextureIdx[i];
+                batch = GetBatch(pool->mTextures[lastTexIdx], pool->mMaterial);
+            }
+
+            if (batch->vertices.size() + 4 > DEF_PARTICLEBATCH_MAXVERTICESPERDRAW) {
+                FlushBatch(batch);
+            }
+
+            //at the end of the lifetime fade the particle out
+            //we just need to set the vertices colors more black
+            //because of the additive material
+            irr::u32 fadeVal = 255;
+            if (pool->mFadeOut && (t > 0.5f)) {
+                fadeVal = (irr::u32)(255.0f * (1.0f - (t - 0.5f) / 0.5f));
+            }
+
+            irr::video::SColor color(255, fadeVal, fadeVal, fadeVal);
+
+            irr::core::vector3df pos(pool->mPosX[i], pool->mPosY[i], pool->mPosZ[i]);
+            irr::f32 halfSize = 0.5f * pool->mSize[i];
+
+            irr::core::vector3df h = horizontal * halfSize;
+            irr::core::vector3df v = vertical * halfSize;
+
+            batch->vertices.push_back(irr::video::S3DVertex(pos + h + v, normal, color, irr::core::vector2df(1.0f, 1.0f)));
+            batch->vertices.push_back(irr::video::S3DVertex(pos + h - v, normal, color, irr::core::vector2df(1.0f, 0.0f)));
+            batch->vertices.push_back(irr::video::S3DVertex(pos - h - v, normal, color, irr::core::vector2df(0.0f, 0.0f)));
+            batch->vertices.push_back(irr::video::S3DVertex(pos - h + v, normal, color, irr::core::vector2df(0.0f, 1.0f)));
+
+            mNrParticlesLastFrame++;
+        }
+    }
+
+    //draw everything that is left
+    std::vector<ParticleBatchStruct*>::iterator itBatch;
+
+    for (itBatch = mBatchVec.begin(); itBatch != mBatchVec.end(); ++itBatch) {
+        FlushBatch(*itBatch);
+    }
+}
+
+const irr::core::aabbox3d<irr::f32>& ParticleBatchSceneNode::getBoundingBox() const {
+    return mBox;
+}
+
+irr::u32 ParticleBatchSceneNode::getMaterialCount() const {
+    return 1;
+}
+
+irr::video::SMaterial& ParticleBatchSceneNode::getMaterial(irr::u32 i) {
+    return mMaterial;
+}
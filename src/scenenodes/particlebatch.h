@@ -0,0 +1,175 @@
+/*
+ Copyright (C) 2026 Wolf Alexander
+
+ This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.                                          */
+
+#ifndef PARTICLEBATCH_H
+#define PARTICLEBATCH_H
+
+#include <irrlicht.h>
+#include <vector>
+#include <cstdint>
+
+//max number of vertices we put into one draw call, we use
+//16bit indices, therefore we need to stay below 65536
+#define DEF_PARTICLEBATCH_MAXVERTICESPERDRAW 65532
+
+/************************
+ * Forward declarations *
+ ************************/
+
+class ParticleBatchSceneNode;
+
+//A preallocated pool of particles of one emitter
+//All particle data is stored in a "structure of arrays" layout, all currently alive
+//particles are always packed at the beginning of the arrays (index 0 until
+//GetNrActiveParticles() - 1), so that the update loops only have to run over
+//plain float arrays, which the compiler is able to vectorize
+class ParticlePool {
+public:
+    //all textures of the pool are specified here, each particle
+    //selects one of them with its texture index
+    ParticlePool(irr::u32 maxParticles, std::vector<irr::video::ITexture*> textures);
+    ~ParticlePool();
+
+    //Creates a new particle, returns the index of the new particle,
+    //or -1 if the pool is already full
+    irr::s32 Emit(irr::core::vector3df position, irr::f32 lifeTimeSec, irr::f32 initSize,
+                  irr::f32 endLifeSizeIncrease, irr::u8 textureIdx = 0);
+
+    //allows to setup movement velocity for a particle; The velocity is interpolated
+    //between initialVelocity and finalVelocity over the lifetime of the particle
+    void SetMovementVelocity(irr::u32 idx, irr::core::vector3df initialVelocity, irr::core::vector3df finalVelocity);
+
+    //moves all particles, ages them, and removes particles
+    //whose lifetime is over
+    void Update(irr::f32 deltaTime);
+
+    //ends the life of the particle, particle is removed
+    //during the next Update call
+    void Kill(irr::u32 idx);
+
+    //removes all particles
+    void Clear();
+
+    irr::u32 GetNrActiveParticles();
+    irr::u32 GetMaxParticles();
+
+    //Settings for all particles in this pool
+
+    //random movement upwards (Y axis) with this speed per second, each update
+    //the speed is randomized between 0.8 and 1.2 times of this value
+    irr::f32 mRiseSpeed = 0.0f;
+
+    //random movement in X and Z direction between -0.5 and 0.5 times
+    //of this speed per second
+    irr::f32 mJitterSpeedXZ = 0.0f;
+
+    //constant acceleration which is added to the particle
+    //velocity (for example gravity)
+    irr::core::vector3df mAcceleration;
+
+    //if true particles fade out during the
+    //second half of their lifetime
+    bool mFadeOut = true;
+
+    bool mVisible = true;
+
+    irr::video::SMaterial mMaterial;
+    std::vector<irr::video::ITexture*> mTextures;
+
+    //particle data arrays
+    std::vector<irr::f32> mPosX;
+    std::vector<irr::f32> mPosY;
+    std::vector<irr::f32> mPosZ;
+
+    std::vector<irr::f32> mVelStartX;
+    std::vector<irr::f32> mVelStartY;
+    std::vector<irr::f32> mVelStartZ;
+
+    std::vector<irr::f32> mVelEndX;
+    std::vector<irr::f32> mVelEndY;
+    std::vector<irr::f32> mVelEndZ;
+
+    std::vector<irr::f32> mSize;
+    std::vector<irr::f32> mSizeStart;
+    std::vector<irr::f32> mSizeIncrease;
+
+    std::vector<irr::f32> mLifeTime;
+    std::vector<irr::f32> mLifeTimeInv;
+
+    //0.0 at creation time, 1.0 at the end of life
+    std::vector<irr::f32> mLifeFraction;
+
+    std::vector<irr::u8> mTextureIdx;
+
+private:
+    irr::u32 mMaxParticles;
+    irr::u32 mNrActive = 0;
+
+    //state of our own small random generator; Is much
+    //faster then rand() for the jitter of many particles
+    uint32_t mRandState = 0x12345678;
+
+    irr::f32 RandomFloat();
+
+    //copies particle srcIdx over particle dstIdx
+    void MoveParticle(irr::u32 srcIdx, irr::u32 dstIdx);
+    void RemoveDeadParticles();
+};
+
+//Scene node which renders the particles of all registered
+//particle pools; Particles of all pools that use the same texture are
+//rendered as one batch of camera facing quads, which means one draw
+//call per texture each frame instead of one billboard scene node
+//per particle
+class ParticleBatchSceneNode : public irr::scene::ISceneNode {
+public:
+    ParticleBatchSceneNode(irr::scene::ISceneNode* parent, irr::scene::ISceneManager* mgr, irr::s32 id = -1);
+    ~ParticleBatchSceneNode();
+
+    //Creates a new particle pool which is rendered by this scene node
+    //The pool is owned by the scene node, and must be freed with RemovePool
+    ParticlePool* CreatePool(irr::u32 maxParticles, std::vector<irr::video::ITexture*> textures);
+    ParticlePool* CreatePool(irr::u32 maxParticles, irr::video::ITexture* texture);
+
+    void RemovePool(ParticlePool* pool);
+
+    virtual void OnRegisterSceneNode();
+    virtual void render();
+    virtual const irr::core::aabbox3d<irr::f32>& getBoundingBox() const;
+    virtual irr::u32 getMaterialCount() const;
+    virtual irr::video::SMaterial& getMaterial(irr::u32 i);
+
+    //statistics of the last frame
+    irr::u32 mNrParticlesLastFrame = 0;
+    irr::u32 mNrDrawCallsLastFrame = 0;
+
+private:
+    std::vector<ParticlePool*> mPoolVec;
+
+    //one batch for each used texture
+    struct ParticleBatchStruct {
+        irr::video::ITexture* texture = nullptr;
+        irr::video::SMaterial material;
+        irr::core::array<irr::video::S3DVertex> vertices;
+    };
+
+    std::vector<ParticleBatchStruct*> mBatchVec;
+
+    //all quads use the same index pattern, this index
+    //list is shared by all batches
+    irr::core::array<irr::u16> mIndices;
+
+    irr::core::aabbox3d<irr::f32> mBox;
+    irr::video::SMaterial mMaterial;
+
+    ParticleBatchStruct* GetBatch(irr::video::ITexture* texture, const irr::video::SMaterial& material);
+    void FlushBatch(ParticleBatchStruct* batch);
+};
+
+#endif // PARTICLEBATCH_H
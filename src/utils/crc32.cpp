@@ -36,6 +36,7 @@
 //I also added additional useful functions afterwards
 
 #include "crc32.h"
+#include <cstdio>
 
 Crc32::Crc32() {
     uint32_t poly = 0xedb88320;
@@ -50,39 +51,101 @@ Crc32::Crc32() {
                 temp >>= 1;
                }
         }
-        m_table[i] = temp;
+        m_table[0][i] = temp;
+    }
+
+    //table k contains the crc for a byte that is followed
+    //by k zero bytes
+    for (uint32_t i = 0; i < CRC32_TABLELEN; ++i) {
+        for (int k = 1; k < CRC32_NRSLICES; ++k) {
+            temp = m_table[k - 1][i];
+            m_table[k][i] = (temp >> 8) ^ m_table[0][temp & 0xff];
+        }
     }
 }
 
 Crc32::~Crc32() {
 }
 
-unsigned int Crc32::ComputeChecksum(std::vector<uint8_t> bytes) {
-  uint32_t crc = 0xffffffff;
-  size_t len = bytes.size();
-  uint8_t index;
+uint32_t Crc32::ComputeChecksum(const std::vector<uint8_t>& bytes) {
+    return UpdateChecksum(0, bytes.data(), bytes.size());
+}
+
+uint32_t Crc32::ComputeChecksum(const uint8_t* data, size_t len) {
+    return UpdateChecksum(0, data, len);
+}
+
+uint32_t Crc32::UpdateChecksum(uint32_t crc, const uint8_t* data, size_t len) {
+    crc = ~crc;
+
+    //process 8 bytes at once, bytes are combined in little endian
+    //order independent of the machine byte order
+    while (len >= 8) {
+        uint32_t one = ((uint32_t)(data[0]) | ((uint32_t)(data[1]) << 8) |
+                        ((uint32_t)(data[2]) << 16) | ((uint32_t)(data[3]) << 24)) ^ crc;
+        uint32_t two = (uint32_t)(data[4]) | ((uint32_t)(data[5]) << 8) |
+                        ((uint32_t)(data[6]) << 16) | ((uint32_t)(data[7]) << 24);
+
+        crc = m_table[7][one & 0xff] ^ m_table[6][(one >> 8) & 0xff] ^
+              m_table[5][(one >> 16) & 0xff] ^ m_table[4][one >> 24] ^
+              m_table[3][two & 0xff] ^ m_table[2][(two >> 8) & 0xff] ^
+              m_table[1][(two >> 16) & 0xff] ^ m_table[0][two >> 24];
+
+        data += 8;
+        len -= 8;
+    }
 
-  for (size_t i = 0; i < len; ++i) {
-        index = (uint8_t)(((crc) & 0xff) ^ bytes.at(i));
-        crc = ((crc >> 8) ^ m_table[index]);
+    //remaining bytes
+    while (len > 0) {
+        crc = (crc >> 8) ^ m_table[0][(crc & 0xff) ^ (*data)];
+        data++;
+        len--;
     }
 
-  return ~crc;
+    return ~crc;
 }
 
-int16_t ConvertByteArray_ToInt16(std::vector<uint8_t> bytes, unsigned int start_position) {
+bool Crc32::ComputeFileChecksum(const char* fileName, uint32_t& checksum, uint32_t startCrc) {
+    FILE* iFile = fopen(fileName, "rb");
+
+    if (iFile == nullptr)
+        return false;
+
+    std::vector<uint8_t> buffer(65536);
+    uint32_t crc = startCrc;
+    size_t nrBytes;
+
+    while ((nrBytes = fread(buffer.data(), 1, buffer.size(), iFile)) > 0) {
+        crc = UpdateChecksum(crc, buffer.data(), nrBytes);
+    }
+
+    bool readError = (ferror(iFile) != 0);
+    fclose(iFile);
+
+    if (readError)
+        return false;
+
+    checksum = crc;
+
+    return true;
+}
+
+int16_t ConvertByteArray_ToInt16(const std::vector<uint8_t> &bytes, unsigned int start_position) {
     int16_t result;
 
     result = static_cast<int16_t>((bytes.at(start_position+1) << 8) + bytes.at(start_position));
     return (result);
 }
 
-int32_t ConvertByteArray_ToInt32(std::vector<uint8_t> bytes, unsigned int start_position) {
-    int32_t result;
+int32_t ConvertByteArray_ToInt32(const std::vector<uint8_t> &bytes, unsigned int start_position) {
+    //little endian, every byte is shifted on its own as unsigned
+    //value before the bytes are combined
+    uint32_t result = static_cast<uint32_t>(bytes.at(start_position)) |
+                      (static_cast<uint32_t>(bytes.at(start_position + 1)) << 8) |
+                      (static_cast<uint32_t>(bytes.at(start_position + 2)) << 16) |
+                      (static_cast<uint32_t>(bytes.at(start_position + 3)) << 24);
 
-    result = static_cast<int32_t>(((bytes.at(start_position+3) << 24) + (bytes.at(start_position+2) << 16) +
-                                   bytes.at(start_position+1) << 8) + bytes.at(start_position));
-    return (result);
+    return static_cast<int32_t>(result);
 }
 
 void ConvertAndWriteInt16ToByteArray(int inputValue, std::vector<unsigned char> &bytes, unsigned int writeIndex) {
@@ -109,3 +172,41 @@ void ConvertAndWriteFloatToByteArray(float inputValue, std::vector<uint8_t> &byt
         bytes.at(writeIndex + 1) = rem;
     }
 }
+
+int16_t ConvertByteArray_ToInt16(const uint8_t* bytes, unsigned int start_position) {
+    return static_cast<int16_t>((bytes[start_position + 1] << 8) + bytes[start_position]);
+}
+
+int32_t ConvertByteArray_ToInt32(const uint8_t* bytes, unsigned int start_position) {
+    uint32_t result = static_cast<uint32_t>(bytes[start_position]) |
+                      (static_cast<uint32_t>(bytes[start_position + 1]) << 8) |
+                      (static_cast<uint32_t>(bytes[start_position + 2]) << 16) |
+                      (static_cast<uint32_t>(bytes[start_position + 3]) << 24);
+
+    return static_cast<int32_t>(result);
+}
+
+void ConvertAndWriteInt16ToByteArray(int inputValue, uint8_t* bytes, unsigned int writeIndex) {
+    int16_t inValue = static_cast<int16_t>(inputValue);
+
+    bytes[writeIndex + 1] = static_cast<uint8_t>((inValue & 0xFF00) >> 8);
+    bytes[writeIndex] = static_cast<uint8_t>(inValue & 0x00FF);
+}
+
+void ConvertAndWriteFloatToByteArray(float inputValue, uint8_t* bytes, unsigned int writeIndex, bool dividerHighByte) {
+    //truncate to round down to next lower integer number
+    int lowInteger = (int)(inputValue);
+    uint8_t div = static_cast<uint8_t>(lowInteger);
+
+    float remainder = (inputValue - float(div)) * 256.0f;
+    int otherInt = (int)(remainder);
+    uint8_t rem = static_cast<uint8_t>(otherInt);
+
+    if (!dividerHighByte) {
+        bytes[writeIndex] = rem;
+        bytes[writeIndex + 1] = div;
+    } else {
+        bytes[writeIndex] = div;
+        bytes[writeIndex + 1] = rem;
+    }
+}
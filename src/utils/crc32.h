@@ -40,23 +40,47 @@
 
 #define CRC32_TABLELEN 256
 
+//number of lookup tables for the slice-by-8 algorithm
+//which processes 8 bytes in each loop iteration
+#define CRC32_NRSLICES 8
+
 #include <vector>
 #include <cstdint>
+#include <cstddef>
 
-int32_t ConvertByteArray_ToInt32(std::vector<uint8_t> bytes, unsigned int start_position);
-int16_t ConvertByteArray_ToInt16(std::vector<uint8_t> bytes, unsigned int start_position);
+int32_t ConvertByteArray_ToInt32(const std::vector<uint8_t> &bytes, unsigned int start_position);
+int16_t ConvertByteArray_ToInt16(const std::vector<uint8_t> &bytes, unsigned int start_position);
 void ConvertAndWriteInt16ToByteArray(int inputValue, std::vector<uint8_t> &bytes, unsigned int writeIndex);
 void ConvertAndWriteFloatToByteArray(float inputValue, std::vector<uint8_t> &bytes, unsigned int writeIndex, bool dividerHighByte = false);
 
+//same as above, but work directly on a larger buffer (for example the whole
+//level file data) without a range check, the caller has to make sure the bytes exist
+int32_t ConvertByteArray_ToInt32(const uint8_t* bytes, unsigned int start_position);
+int16_t ConvertByteArray_ToInt16(const uint8_t* bytes, unsigned int start_position);
+void ConvertAndWriteInt16ToByteArray(int inputValue, uint8_t* bytes, unsigned int writeIndex);
+void ConvertAndWriteFloatToByteArray(float inputValue, uint8_t* bytes, unsigned int writeIndex, bool dividerHighByte = false);
+
 class Crc32 {
 private:
-    uint32_t m_table[CRC32_TABLELEN];
+    //m_table[0] is the classic byte wise table, the other tables
+    //are derived from it for slice-by-8
+    uint32_t m_table[CRC32_NRSLICES][CRC32_TABLELEN];
 
 public:
     Crc32();
     ~Crc32();
 
-    uint32_t ComputeChecksum(std::vector<uint8_t> bytes);
+    uint32_t ComputeChecksum(const std::vector<uint8_t>& bytes);
+    uint32_t ComputeChecksum(const uint8_t* data, size_t len);
+
+    //continues the checksum calculation of data that is split into multiple parts;
+    //start with crc = 0, the result for all parts is the same as the checksum
+    //over all the data at once
+    uint32_t UpdateChecksum(uint32_t crc, const uint8_t* data, size_t len);
+
+    //computes the checksum of the whole file content, returns false if the file
+    //could not be read; If startCrc is specified the calculation continues from this value
+    bool ComputeFileChecksum(const char* fileName, uint32_t& checksum, uint32_t startCrc = 0);
 };
 
 #endif // CRC32_H
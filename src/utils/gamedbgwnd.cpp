@@ -11,6 +11,9 @@
 #include "../race.h"
 #include "../models/player.h"
 #include "../game.h"
+#include "../draw/drawdebug.h"
+#include "occlusion.h"
+#include "visgrid.h"
 #include <iostream>
 
 GameDbgWnd::GameDbgWnd(Race* parentRace) {
@@ -65,6 +68,14 @@ GameDbgWnd::~GameDbgWnd() {
         mGuiGameDbgWnd.ShowCloneRecording->remove();
     }
 
+    if (mGuiGameDbgWnd.OcclusionCulling != nullptr) {
+        mGuiGameDbgWnd.OcclusionCulling->remove();
+    }
+
+    if (mGuiGameDbgWnd.OcclusionCullingStats != nullptr) {
+        mGuiGameDbgWnd.OcclusionCullingStats->remove();
+    }
+
     if (mGuiGameDbgWnd.ShowCurrWayPointLink != nullptr) {
         mGuiGameDbgWnd.ShowCurrWayPointLink->remove();
     }
@@ -85,6 +96,26 @@ GameDbgWnd::~GameDbgWnd() {
         mGuiGameDbgWnd.ShowPlayerFreeSpace->remove();
     }
 
+    if (mGuiGameDbgWnd.DrawCatGeneral != nullptr) {
+        mGuiGameDbgWnd.DrawCatGeneral->remove();
+    }
+
+    if (mGuiGameDbgWnd.DrawCatWaypoints != nullptr) {
+        mGuiGameDbgWnd.DrawCatWaypoints->remove();
+    }
+
+    if (mGuiGameDbgWnd.DrawCatLevel != nullptr) {
+        mGuiGameDbgWnd.DrawCatLevel->remove();
+    }
+
+    if (mGuiGameDbgWnd.DrawCatPhysics != nullptr) {
+        mGuiGameDbgWnd.DrawCatPhysics->remove();
+    }
+
+    if (mGuiGameDbgWnd.DrawCatAIPath != nullptr) {
+        mGuiGameDbgWnd.DrawCatAIPath->remove();
+    }
+
     if (mGuiGameDbgWnd.LevelTab != nullptr) {
         mGuiGameDbgWnd.LevelTab->remove();
     }
@@ -93,6 +124,10 @@ GameDbgWnd::~GameDbgWnd() {
         mGuiGameDbgWnd.MovementTab->remove();
     }
 
+    if (mGuiGameDbgWnd.DrawTab != nullptr) {
+        mGuiGameDbgWnd.DrawTab->remove();
+    }
+
     if (mGuiGameDbgWnd.tabCntrl != nullptr) {
         mGuiGameDbgWnd.tabCntrl->remove();
     }
@@ -115,6 +150,7 @@ void GameDbgWnd::CreateWindow() {
 
     mGuiGameDbgWnd.LevelTab = mGuiGameDbgWnd.tabCntrl->addTab(L"Level");
     mGuiGameDbgWnd.MovementTab = mGuiGameDbgWnd.tabCntrl->addTab(L"Movement");
+    mGuiGameDbgWnd.DrawTab = mGuiGameDbgWnd.tabCntrl->addTab(L"Draw");
 
     /********************************
      * Create the Level Tab items   *
@@ -180,6 +216,15 @@ void GameDbgWnd::CreateWindow() {
     mGuiGameDbgWnd.ShowCloneRecording = mParentRace->mGame->mGuienv->addCheckBox(currState, rect<s32> ( pos.X, pos.Y, pos.X + width, pos.Y + height),
                                                                                            mGuiGameDbgWnd.LevelTab, GUI_ID_LEVEL_SHOWCLONERECORDING_CHECKBOX, L"Clone Recording");
 
+    pos.Y += height;
+    currState = mParentRace->GetDebugFlag(DEF_RACE_DBG_OCCLUSIONCULLING);
+    mGuiGameDbgWnd.OcclusionCulling = mParentRace->mGame->mGuienv->addCheckBox(currState, rect<s32> ( pos.X, pos.Y, pos.X + width, pos.Y + height),
+                                                                                           mGuiGameDbgWnd.LevelTab, GUI_ID_LEVEL_OCCLUSIONCULLING_CHECKBOX, L"Occl. Culling");
+
+    pos.Y += height;
+    mGuiGameDbgWnd.OcclusionCullingStats = mParentRace->mGame->mGuienv->addStaticText(L"", rect<s32> ( pos.X, pos.Y, pos.X + width + columnSpacing, pos.Y + height),
+                                                                                           false, false, mGuiGameDbgWnd.LevelTab);
+
     /***********************************
      * Create the Movement Tab items   *
      ***********************************/
@@ -210,6 +255,39 @@ void GameDbgWnd::CreateWindow() {
     mGuiGameDbgWnd.ShowPlayerFreeSpace = mParentRace->mGame->mGuienv->addCheckBox(currState, rect<s32> ( pos.X, pos.Y, pos.X + width, pos.Y + height),
                                                                                          mGuiGameDbgWnd.MovementTab, GUI_ID_MOVEMENT_CPU_FREESPACE_CHECKBOX, L"Free Space");
 
+    /*******************************
+     * Create the Draw Tab items   *
+     *******************************/
+
+    //primitives of disabled categories are not
+    //collected by DrawDebug at all
+    pos = initialPos;
+    DrawDebug* drawDbg = mParentRace->mGame->mDrawDebug;
+
+    currState = drawDbg->IsCategoryEnabled(DEF_DRAWDEBUG_CAT_GENERAL);
+    mGuiGameDbgWnd.DrawCatGeneral = mParentRace->mGame->mGuienv->addCheckBox(currState, rect<s32> ( pos.X, pos.Y, pos.X + width, pos.Y + height),
+                                                                                         mGuiGameDbgWnd.DrawTab, GUI_ID_DRAW_CAT_GENERAL_CHECKBOX, L"General");
+
+    pos.Y += height;
+    currState = drawDbg->IsCategoryEnabled(DEF_DRAWDEBUG_CAT_WAYPOINTS);
+    mGuiGameDbgWnd.DrawCatWaypoints = mParentRace->mGame->mGuienv->addCheckBox(currState, rect<s32> ( pos.X, pos.Y, pos.X + width, pos.Y + height),
+                                                                                         mGuiGameDbgWnd.DrawTab, GUI_ID_DRAW_CAT_WAYPOINTS_CHECKBOX, L"Waypoints");
+
+    pos.Y += height;
+    currState = drawDbg->IsCategoryEnabled(DEF_DRAWDEBUG_CAT_LEVEL);
+    mGuiGameDbgWnd.DrawCatLevel = mParentRace->mGame->mGuienv->addCheckBox(currState, rect<s32> ( pos.X, pos.Y, pos.X + width, pos.Y + height),
+                                                                                         mGuiGameDbgWnd.DrawTab, GUI_ID_DRAW_CAT_LEVEL_CHECKBOX, L"Level");
+
+    pos.Y += height;
+    currState = drawDbg->IsCategoryEnabled(DEF_DRAWDEBUG_CAT_PHYSICS);
+    mGuiGameDbgWnd.DrawCatPhysics = mParentRace->mGame->mGuienv->addCheckBox(currState, rect<s32> ( pos.X, pos.Y, pos.X + width, pos.Y + height),
+                                                                                         mGuiGameDbgWnd.DrawTab, GUI_ID_DRAW_CAT_PHYSICS_CHECKBOX, L"Physics");
+
+    pos.Y += height;
+    currState = drawDbg->IsCategoryEnabled(DEF_DRAWDEBUG_CAT_AIPATH);
+    mGuiGameDbgWnd.DrawCatAIPath = mParentRace->mGame->mGuienv->addCheckBox(currState, rect<s32> ( pos.X, pos.Y, pos.X + width, pos.Y + height),
+                                                                                         mGuiGameDbgWnd.DrawTab, GUI_ID_DRAW_CAT_AIPATH_CHECKBOX, L"AI Path");
+
     //move window to a better start location
     Window->move(irr::core::vector2d<irr::s32>(250,50));
 }
@@ -277,6 +355,8 @@ void GameDbgWnd::OnCheckBoxChanged(irr::s32 checkboxId) {
         mParentRace->SetDebugFlag(DEF_RACE_DBG_LOGTRIGGEREVENTS, mGuiGameDbgWnd.LogTriggerEvents->isChecked());
     } else if (checkboxId == GUI_ID_LEVEL_ACTIVATEMORPHKEYTRG_CHECKBOX) {
         mParentRace->SetDebugFlag(DEF_RACE_DBG_ACTIVATEMORPHKEYTRG, mGuiGameDbgWnd.ActivateMorphKeyTrg->isChecked());
+    } else if (checkboxId == GUI_ID_LEVEL_OCCLUSIONCULLING_CHECKBOX) {
+        mParentRace->SetDebugFlag(DEF_RACE_DBG_OCCLUSIONCULLING, mGuiGameDbgWnd.OcclusionCulling->isChecked());
     } else if (checkboxId == GUI_ID_LEVEL_SHOWCHARGINGSTATIONINFO_CHECKBOX) {
         mParentRace->SetDebugFlag(DEF_RACE_DBG_CHARGINGSTATIONINFO, mGuiGameDbgWnd.ShowChargingStationInfo->isChecked());
     } else if (checkboxId == GUI_ID_MOVEMENT_CURRWAYPOINTLINK_CHECKBOX) {
@@ -289,5 +369,38 @@ void GameDbgWnd::OnCheckBoxChanged(irr::s32 checkboxId) {
         mParentRace->UpdatePlayersDbgFlag(DEF_PLAYER_DBG_CPU_PATHHISTORY, mGuiGameDbgWnd.ShowPlayerCPUPathHistory->isChecked());
     } else if (checkboxId == GUI_ID_MOVEMENT_CPU_FREESPACE_CHECKBOX) {
         mParentRace->UpdatePlayersDbgFlag(DEF_PLAYER_DBG_FREESPACE, mGuiGameDbgWnd.ShowPlayerFreeSpace->isChecked());
+    } else if (checkboxId == GUI_ID_DRAW_CAT_GENERAL_CHECKBOX) {
+        mParentRace->mGame->mDrawDebug->SetCategoryEnabled(DEF_DRAWDEBUG_CAT_GENERAL, mGuiGameDbgWnd.DrawCatGeneral->isChecked());
+    } else if (checkboxId == GUI_ID_DRAW_CAT_WAYPOINTS_CHECKBOX) {
+        mParentRace->mGame->mDrawDebug->SetCategoryEnabled(DEF_DRAWDEBUG_CAT_WAYPOINTS, mGuiGameDbgWnd.DrawCatWaypoints->isChecked());
+    } else if (checkboxId == GUI_ID_DRAW_CAT_LEVEL_CHECKBOX) {
+        mParentRace->mGame->mDrawDebug->SetCategoryEnabled(DEF_DRAWDEBUG_CAT_LEVEL, mGuiGameDbgWnd.DrawCatLevel->isChecked());
+    } else if (checkboxId == GUI_ID_DRAW_CAT_PHYSICS_CHECKBOX) {
+        mParentRace->mGame->mDrawDebug->SetCategoryEnabled(DEF_DRAWDEBUG_CAT_PHYSICS, mGuiGameDbgWnd.DrawCatPhysics->isChecked());
+    } else if (checkboxId == GUI_ID_DRAW_CAT_AIPATH_CHECKBOX) {
+        mParentRace->mGame->mDrawDebug->SetCategoryEnabled(DEF_DRAWDEBUG_CAT_AIPATH, mGuiGameDbgWnd.DrawCatAIPath->isChecked());
     }
 }
+
+void GameDbgWnd::UpdateStatistics() {
+    if (mGuiGameDbgWnd.OcclusionCullingStats == nullptr)
+        return;
+
+    OcclusionCulling* occl = mParentRace->mOcclusionCulling;
+
+    if (occl == nullptr)
+        return;
+
+    //entities outside of the camera view are already
+    //hidden by the visibility grid before
+    irr::u32 nrGridCulled = 0;
+
+    if (mParentRace->mVisibilityGrid != nullptr) {
+        nrGridCulled = mParentRace->mVisibilityGrid->mNrCulledLastFrame;
+    }
+
+    wchar_t text[100];
+    swprintf(text, 100, L"Culled %u / %u View %u", occl->mNrCulledLastFrame, occl->mNrTestedLastFrame, nrGridCulled);
+
+    mGuiGameDbgWnd.OcclusionCullingStats->setText(text);
+}
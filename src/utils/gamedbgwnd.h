@@ -30,6 +30,7 @@ struct GUIGameDbgWnd
     irr::gui::IGUITabControl* tabCntrl;
     irr::gui::IGUITab* LevelTab;
     irr::gui::IGUITab* MovementTab;
+    irr::gui::IGUITab* DrawTab;
 
     //Level Tab items
     irr::gui::IGUICheckBox* ShowWallsegmentLines;
@@ -43,6 +44,8 @@ struct GUIGameDbgWnd
     irr::gui::IGUICheckBox* ActivateMorphKeyTrg;
     irr::gui::IGUICheckBox* ShowChargingStationInfo;
     irr::gui::IGUICheckBox* ShowCloneRecording;
+    irr::gui::IGUICheckBox* OcclusionCulling;
+    irr::gui::IGUIStaticText* OcclusionCullingStats;
 
     //Movement Tab items
     irr::gui::IGUICheckBox* ShowCurrWayPointLink;
@@ -50,6 +53,13 @@ struct GUIGameDbgWnd
     irr::gui::IGUICheckBox* ShowPlayerCPUCurrentSegment;
     irr::gui::IGUICheckBox* ShowPlayerCPUPathHistory;
     irr::gui::IGUICheckBox* ShowPlayerFreeSpace;
+
+    //Draw Tab items
+    irr::gui::IGUICheckBox* DrawCatGeneral;
+    irr::gui::IGUICheckBox* DrawCatWaypoints;
+    irr::gui::IGUICheckBox* DrawCatLevel;
+    irr::gui::IGUICheckBox* DrawCatPhysics;
+    irr::gui::IGUICheckBox* DrawCatAIPath;
 };
 
 class GameDbgWnd {
@@ -73,6 +83,9 @@ public:
 
     void OnCheckBoxChanged(irr::s32 checkboxId);
 
+    //updates the shown per frame statistics
+    void UpdateStatistics();
+
     GUIGameDbgWnd mGuiGameDbgWnd;
 };
 
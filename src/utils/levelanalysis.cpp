@@ -0,0 +1,709 @@
+/*
+ ----------------------------------------------------------------------------------------------------------------------------
+ Function CastRayDDA was initially taken from the great project/tutorial (and later modified slightly by me)
+ For license also see worldaware-CastRayDDA-OLC3-LICENCE.md
+ 
+ Fast Ray Casting Using DDA
+//  "Itchy Eyes... Not blinking enough..." - javidx9
+
+ Video: https://youtu.be/NbSee-XM7WA
+
+ License (OLC-3)
+ ~~~~~~~~~~~~~~~
+
+    Copyright 2018 - 2021 OneLoneCoder.com
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+
+    1. Redistributions or derivations of source code must retain the above
+    copyright notice, this list of conditions and the following disclaimer.
+
+    2. Redistributions or derivative works in binary form must reproduce
+    the above copyright notice. This list of conditions and the following
+    disclaimer must be reproduced in the documentation and/or other
+    materials provided with the distribution.
+
+    3. Neither the name of the copyright holder nor the names of its
+    contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+    A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+    HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+    SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+    LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+    DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+    THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+    Links
+    ~~~~~
+    YouTube:	https://www.youtube.com/javidx9
+                https://www.youtube.com/javidx9extra
+    Discord:	https://discord.gg/WhwHUMV
+    Twitter:	https://www.twitter.com/javidx9
+    Twitch:		https://www.twitch.tv/javidx9
+    GitHub:		https://www.github.com/onelonecoder
+    Homepage:	https://www.onelonecoder.com
+
+    Author
+    ~~~~~~
+    David Barr, aka javidx9, ©OneLoneCoder 2019, 2020, 2021
+    
+ ----------------------------------------------------------------------------------------------------------------------------
+ Function DrawLine source code taken from great article from Josh Beam
+ https://joshbeam.com/articles/simple_line_drawing/
+ He also has a GitHub repo for this
+ https://github.com/joshb/linedrawing
+ 
+ For the license please see the following file:
+ worldaware-DrawLine-README.md
+ 
+ ----------------------------------------------------------------------------------------------------------------------------
+ 
+ Other source code in this file:
+    
+ Copyright (C) 2024-2026 Wolf Alexander
+
+ This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.                                          */
+
+
+#include "levelanalysis.h"
+#include "path.h"
+#include "../definitions.h"
+#include "../resources/levelfile.h"
+#include "../resources/levelcache.h"
+#include "../resources/entityitem.h"
+#include "../resources/mapentry.h"
+#include "../resources/columndefinition.h"
+#include <cfloat>
+#include <cstdio>
+
+//definition of road texture elements
+//most important textures for auto generation of
+//minimap
+static const std::vector<irr::s32> roadTexIdsVec = {31, 60, 61, 62, 63, 64, 65, 67, 69, 76,
+                                        77, 78, 79, 81, 82, 86, 116, 117, 118, 119,
+                                       122, 124, 125, 126, 127, 128, 129, 130, 131, 132, 136, 137, 138, 139, 140,
+                                       141, 142, 143, 144, 145, 148, 149, 150, 151, 152, 154, 155,
+                                       96, 4};
+
+//some more additional texture IDs for roads which would disturb
+//the minimap creation if we would add them to roadTexIdsVec directly
+//but we need them in worldaware to properly detect the local width of the race track
+static const std::vector<irr::s32> roadTexIdsVecExtendedForWorldAware = {
+    43, 47, 51, 120, 121,             123, 134, 135, 146, 147, 153 };
+
+LevelAnalysis::LevelAnalysis(LevelFile* levelRes) {
+    mLevelRes = levelRes;
+
+    mWidth = mLevelRes->Width();
+    mHeight = mLevelRes->Height();
+}
+
+LevelAnalysis::~LevelAnalysis() {
+}
+
+bool LevelAnalysis::IsRoadTexture(irr::s32 texture, bool addExtendedTextures) {
+    std::vector<irr::s32>::const_iterator itTex;
+
+    for (itTex = roadTexIdsVec.begin(); itTex != roadTexIdsVec.end(); ++itTex) {
+        if ((*itTex) == texture) {
+            //texture found, exit
+            return true;
+        }
+    }
+
+    if (addExtendedTextures) {
+        for (itTex = roadTexIdsVecExtendedForWorldAware.begin(); itTex != roadTexIdsVecExtendedForWorldAware.end(); ++itTex) {
+            if ((*itTex) == texture) {
+                //texture found, exit
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+MapEntry* LevelAnalysis::GetMapEntry(int x, int y) {
+    if (x < 0) x = 0;
+    if (y < 0) y = 0;
+    if (x > mWidth - 1) x = mWidth - 1;
+    if (y > mHeight - 1) y = mHeight - 1;
+    return mLevelRes->pMap[x][y];
+}
+
+void LevelAnalysis::SetPixel(irr::f32 x, irr::f32 y) {
+    //same as setting a pixel in an Irrlicht image with the size of the
+    //level times LEVELANALYSIS_PIXELSCALEFACTOR: pixels outside are ignored
+    if ((x <= -1.0f) || (y <= -1.0f))
+        return;
+
+    irr::u32 px = (irr::u32)(x);
+    irr::u32 py = (irr::u32)(y);
+
+    if ((px >= (irr::u32)(mWidth * LEVELANALYSIS_PIXELSCALEFACTOR)) ||
+        (py >= (irr::u32)(mHeight * LEVELANALYSIS_PIXELSCALEFACTOR)))
+        return;
+
+    //a tile contains an obstacle if there is
+    //any pixel set in its pixel square
+    mStaticWorldMap[(px / LEVELANALYSIS_PIXELSCALEFACTOR) + (py / LEVELANALYSIS_PIXELSCALEFACTOR) * mWidth] = 1;
+}
+
+//DrawLine source code taken from https://joshbeam.com/articles/simple_line_drawing/
+void LevelAnalysis::DrawRectangle(irr::f32 x1, irr::f32 y1, irr::f32 x2, irr::f32 y2)
+{
+    DrawLine(x1, y1, x2, y1);
+    DrawLine(x2, y1, x2, y2);
+    DrawLine(x2, y2, x1, y2);
+    DrawLine(x1, y2, x1, y1);
+}
+
+//DrawLine source code taken from https://joshbeam.com/articles/simple_line_drawing/
+void LevelAnalysis::DrawLine(irr::f32 x1, irr::f32 y1, irr::f32 x2, irr::f32 y2)
+{
+    irr::f32 xdiff = (x2 - x1);
+    irr::f32 ydiff = (y2 - y1);
+
+    if(xdiff == 0.0f && ydiff == 0.0f) {
+        SetPixel(x1, y1);
+        return;
+    }
+
+    if(fabs(xdiff) > fabs(ydiff)) {
+            irr::f32 xmin, xmax;
+
+            // set xmin to the lower x value given
+            // and xmax to the higher value
+            if(x1 < x2) {
+                xmin = x1;
+                xmax = x2;
+            } else {
+                xmin = x2;
+                xmax = x1;
+            }
+
+            // draw line in terms of y slope
+            irr::f32 slope = ydiff / xdiff;
+            for(irr::f32 x = xmin; x <= xmax; x += 1.0f) {
+                irr::f32 y = y1 + ((x - x1) * slope);
+                SetPixel(x, y);
+            }
+        } else {
+            irr::f32 ymin, ymax;
+
+            // set ymin to the lower y value given
+            // and ymax to the higher value
+            if(y1 < y2) {
+                ymin = y1;
+                ymax = y2;
+            } else {
+                ymin = y2;
+                ymax = y1;
+            }
+
+            // draw line in terms of x slope
+            irr::f32 slope = xdiff / ydiff;
+            for(irr::f32 y = ymin; y <= ymax; y += 1.0f) {
+                irr::f32 x = x1 + ((y - y1) * slope);
+                SetPixel(x, y);
+            }
+        }
+}
+
+void LevelAnalysis::CreateStaticWorldMap(const std::vector<LineStruct*> &wallSegmentLines) {
+    mStaticWorldMap.clear();
+    mStaticWorldMap.resize(mWidth * mHeight, 0);
+
+    //draw all wallsegments
+    //This will be used to derive craft distances to
+    //the outside of the race track
+    //we need this current distances for turning
+    //decisions, so that we do not turn into a wall
+    std::vector<LineStruct*>::const_iterator it;
+
+    for (it = wallSegmentLines.begin(); it != wallSegmentLines.end(); ++it) {
+        //our universe X axis is mirrored!
+        //therefore the - in X coordinate
+        DrawLine(-(*it)->A.X * LEVELANALYSIS_PIXELSCALEFACTOR, (*it)->A.Z * LEVELANALYSIS_PIXELSCALEFACTOR,
+                 -(*it)->B.X * LEVELANALYSIS_PIXELSCALEFACTOR, (*it)->B.Z * LEVELANALYSIS_PIXELSCALEFACTOR);
+    }
+
+    irr::core::vector3df vert1;
+    irr::core::vector3df vert3;
+
+    std::vector<ColumnsStruct>::iterator itCol;
+    for (itCol = mLevelRes->Columns.begin(); itCol != mLevelRes->Columns.end(); ++itCol) {
+        //check if lowest block (block A, index 0) is in collision mesh or not (value 0 is not part of collision mesh, -1 means no block exists there)
+        //if it is part of collision mesh, draw rectangle where lowest block sits in world
+        if ((*itCol).Columns->mInCollisionMesh[0] == 1) {
+            //X and Z coordinate of vertice 1 and 3 of the bottom face of the lowest block,
+            //as Column::CreateGeometryBlock and Column::MoveColumnVertex calculate them
+            vert1.X = 0.0f - ((*itCol).Vector3.X + 1);
+            vert1.Z = DEF_SEGMENTSIZE + (*itCol).Vector3.Z;
+            vert3.X = DEF_SEGMENTSIZE - ((*itCol).Vector3.X + 1);
+            vert3.Z = 0.0f + (*itCol).Vector3.Z;
+
+            //our universe X axis is mirrored!
+            //therefore the - in X coordinate
+            DrawRectangle(-vert1.X * LEVELANALYSIS_PIXELSCALEFACTOR,
+                          vert1.Z * LEVELANALYSIS_PIXELSCALEFACTOR,
+                          -vert3.X * LEVELANALYSIS_PIXELSCALEFACTOR,
+                          vert3.Z * LEVELANALYSIS_PIXELSCALEFACTOR);
+        }
+    }
+}
+
+bool LevelAnalysis::LoadStaticWorldMapFromCache(LevelCache* levelCache) {
+    if (levelCache == nullptr)
+        return false;
+
+    std::vector<uint8_t> data;
+
+    if (!levelCache->GetSection(LEVELCACHE_SECTION_STATICWORLDMAP, data))
+        return false;
+
+    uint32_t maxX = (uint32_t)(mWidth);
+    uint32_t maxY = (uint32_t)(mHeight);
+
+    size_t readIdx = 0;
+    uint32_t cachedX = LevelCache::ReadUInt32(data, readIdx);
+    uint32_t cachedY = LevelCache::ReadUInt32(data, readIdx);
+
+    //does the cached map have the expected size?
+    if ((cachedX != maxX) || (cachedY != maxY) || (data.size() != readIdx + maxX * maxY))
+        return false;
+
+    mStaticWorldMap.assign(data.begin() + readIdx, data.end());
+
+    return true;
+}
+
+void LevelAnalysis::StoreStaticWorldMapInCache(LevelCache* levelCache) {
+    if ((levelCache == nullptr) || mStaticWorldMap.empty())
+        return;
+
+    std::vector<uint8_t> data;
+    data.reserve(2 * sizeof(uint32_t) + mStaticWorldMap.size());
+
+    LevelCache::AppendUInt32(data, (uint32_t)(mWidth));
+    LevelCache::AppendUInt32(data, (uint32_t)(mHeight));
+    data.insert(data.end(), mStaticWorldMap.begin(), mStaticWorldMap.end());
+
+    levelCache->SetSection(LEVELCACHE_SECTION_STATICWORLDMAP, data);
+}
+
+//returns true if a track end was identified
+bool LevelAnalysis::FindTrackEndAlongCastRay(std::vector<irr::core::vector2di> cells,
+                                              irr::core::vector3df rayStartPoint3D, irr::f32 &distanceToEnd) {
+
+    irr::s16 nrCells;
+    bool isRoadTexture;
+    MapEntry* mapEntry;
+    irr::core::vector3df endRoadTextureID3DPos;
+
+    nrCells = (irr::s16)(cells.size());
+
+    for (irr::s16 cellIdx = 0; cellIdx < nrCells; cellIdx++) {
+        mapEntry = GetMapEntry(cells.at(cellIdx).X, cells.at(cellIdx).Y);
+
+        //you must enable extended texture IDs here, to make it work correctly
+        isRoadTexture = IsRoadTexture(mapEntry->m_TextureId, true);
+
+        if (!isRoadTexture) {
+            endRoadTextureID3DPos.X = -cells.at(cellIdx).X * DEF_SEGMENTSIZE;
+            endRoadTextureID3DPos.Y = rayStartPoint3D.Y; //just take Y the same as of starting point, so that
+                                                         //Y coordinate does not affect the calculated length
+            endRoadTextureID3DPos.Z = cells.at(cellIdx).Y * DEF_SEGMENTSIZE;
+
+            distanceToEnd = (endRoadTextureID3DPos - rayStartPoint3D).getLength();
+
+            break;
+        }
+    }
+
+    //no road end found
+    return false;
+}
+
+void LevelAnalysis::AnalyzeWaypointLinksOffsetRange(std::vector<WayPointLinkInfoStruct*> &wayPointLinks) {
+    std::vector<WayPointLinkInfoStruct*>::iterator it;
+
+    irr::f32 distStartEntity = FLT_MAX;
+    irr::f32 distEndEntity = FLT_MAX;
+    irr::f32 hitDistance;
+    irr::core::vector3df coord3D;
+    std::vector<irr::core::vector2di> cells;
+    irr::f32 minVal;
+
+    irr::f32 distStartEntityTextureId = FLT_MAX;
+    irr::f32 distEndEntityTextureId = FLT_MAX;
+
+    //process one waypoint link after each other
+    for (it = wayPointLinks.begin(); it != wayPointLinks.end(); ++it) {
+        //shoot one 2D ray from start entity towards right side
+        //to see how far we can go until we hit a terrain/block obstacle
+        coord3D = (*it)->pLineStruct->A;
+
+        cells.clear();
+        if (CastRayDDA(coord3D, (*it)->offsetDirVec, 1000.0f, cells, hitDistance)) {
+            distStartEntity = hitDistance;
+        }
+
+        //at some map locations from the original game (for example level 3, shortly after the race finish line on the right side) there
+        //are the wallsegments missing towards the lower areas). This means at this location we need another solution again to be able
+        //to properly detect the road there, and the area where we can move freely as a computer player
+        //As a solution I decided to use the CastRayDDA visited cells from the last function call, revisit all of this cells, and check when we
+        //leave the valid textureID range of "roads" in the game
+        //This should help for this locations
+        FindTrackEndAlongCastRay(cells, coord3D, distStartEntityTextureId);
+
+        //do the same from the end entity
+        coord3D = (*it)->pLineStruct->B;
+
+        cells.clear();
+        if (CastRayDDA(coord3D, (*it)->offsetDirVec, 1000.0f, cells, hitDistance)) {
+            distEndEntity = hitDistance;
+        }
+
+        FindTrackEndAlongCastRay(cells, coord3D, distEndEntityTextureId);
+
+        //which is the minimum of the results?
+        minVal = distStartEntity;
+
+        if (distStartEntityTextureId < minVal) {
+            minVal = distStartEntityTextureId;
+        }
+
+        minVal -= WA_CP_PLAYER_NAVIGATIONAREASAFETYDISTANCE;
+        if (minVal < 0.0f)
+            minVal = 0.0f;
+
+        (*it)->maxOffsetShiftStart = minVal;
+
+        minVal = distEndEntity;
+
+        if (distEndEntityTextureId < minVal) {
+            minVal = distEndEntityTextureId;
+        }
+
+        minVal -= WA_CP_PLAYER_NAVIGATIONAREASAFETYDISTANCE;
+        if (minVal < 0.0f)
+            minVal = 0.0f;
+
+        (*it)->maxOffsetShiftEnd = minVal;
+
+        /**************************************************************/
+        /* repeat everything, but this time for direction to the left */
+        /**************************************************************/
+
+        coord3D = (*it)->pLineStruct->A;
+
+        cells.clear();
+        if (CastRayDDA(coord3D, -(*it)->offsetDirVec, 1000.0f, cells, hitDistance)) {
+            distStartEntity = hitDistance;
+        }
+
+        FindTrackEndAlongCastRay(cells, coord3D, distStartEntityTextureId);
+
+        //do the same from the end entity
+        coord3D = (*it)->pLineStruct->B;
+
+        cells.clear();
+        if (CastRayDDA(coord3D, -(*it)->offsetDirVec, 1000.0f, cells, hitDistance)) {
+            distEndEntity = hitDistance;
+        }
+
+        FindTrackEndAlongCastRay(cells, coord3D, distEndEntityTextureId);
+
+        //which is the minimum of the results?
+        minVal = distStartEntity;
+
+        if (distStartEntityTextureId < minVal) {
+            minVal = distStartEntityTextureId;
+        }
+
+        minVal -= WA_CP_PLAYER_NAVIGATIONAREASAFETYDISTANCE;
+        if (minVal < 0.0f)
+            minVal = 0.0f;
+
+        //a movement towards the left is negative for us later
+        //for reverse the sign
+        (*it)->minOffsetShiftStart = -minVal;
+
+        minVal = distEndEntity;
+
+        if (distEndEntityTextureId < minVal) {
+            minVal = distEndEntityTextureId;
+        }
+
+        minVal -= WA_CP_PLAYER_NAVIGATIONAREASAFETYDISTANCE;
+        if (minVal < 0.0f)
+            minVal = 0.0f;
+
+        (*it)->minOffsetShiftEnd = -minVal;
+    }
+}
+
+bool LevelAnalysis::LoadWaypointLinksOffsetRangeFromCache(LevelCache* levelCache, std::vector<WayPointLinkInfoStruct*> &wayPointLinks) {
+    if (levelCache == nullptr)
+        return false;
+
+    std::vector<uint8_t> data;
+
+    if (!levelCache->GetSection(LEVELCACHE_SECTION_WAYPOINTOFFSETRANGE, data))
+        return false;
+
+    size_t readIdx = 0;
+    uint32_t nrLinks = LevelCache::ReadUInt32(data, readIdx);
+
+    //does the cached data fit to the current waypoint links?
+    if ((nrLinks != wayPointLinks.size()) ||
+         (data.size() != sizeof(uint32_t) + nrLinks * 4 * sizeof(float)))
+        return false;
+
+    std::vector<WayPointLinkInfoStruct*>::iterator it;
+
+    for (it = wayPointLinks.begin(); it != wayPointLinks.end(); ++it) {
+        (*it)->minOffsetShiftStart = LevelCache::ReadFloat(data, readIdx);
+        (*it)->maxOffsetShiftStart = LevelCache::ReadFloat(data, readIdx);
+        (*it)->minOffsetShiftEnd = LevelCache::ReadFloat(data, readIdx);
+        (*it)->maxOffsetShiftEnd = LevelCache::ReadFloat(data, readIdx);
+    }
+
+    return true;
+}
+
+void LevelAnalysis::StoreWaypointLinksOffsetRangeInCache(LevelCache* levelCache, const std::vector<WayPointLinkInfoStruct*> &wayPointLinks) {
+    if (levelCache == nullptr)
+        return;
+
+    std::vector<uint8_t> data;
+    data.reserve(sizeof(uint32_t) + wayPointLinks.size() * 4 * sizeof(float));
+
+    LevelCache::AppendUInt32(data, (uint32_t)(wayPointLinks.size()));
+
+    std::vector<WayPointLinkInfoStruct*>::const_iterator it;
+
+    for (it = wayPointLinks.begin(); it != wayPointLinks.end(); ++it) {
+        LevelCache::AppendFloat(data, (*it)->minOffsetShiftStart);
+        LevelCache::AppendFloat(data, (*it)->maxOffsetShiftStart);
+        LevelCache::AppendFloat(data, (*it)->minOffsetShiftEnd);
+        LevelCache::AppendFloat(data, (*it)->maxOffsetShiftEnd);
+    }
+
+    levelCache->SetSection(LEVELCACHE_SECTION_WAYPOINTOFFSETRANGE, data);
+}
+
+void LevelAnalysis::CreateWallSegmentLines(LevelFile* levelRes, std::vector<LineStruct*> &outLines) {
+    std::vector<EntityItem*>::iterator it;
+    EntityItem* next;
+
+    for (it = levelRes->Entities.begin(); it != levelRes->Entities.end(); ++it) {
+        if ((*it)->getEntityType() != Entity::EntityType::WallSegment)
+            continue;
+
+        next = nullptr;
+
+        if ((*it)->getNextID() != 0) {
+            levelRes->ReturnEntityItemWithId((*it)->getNextID(), &next);
+        }
+
+        if (next != nullptr) {
+            LineStruct *line = new LineStruct;
+            line->A = (*it)->getCenter();
+            line->B = next->getCenter();
+
+            outLines.push_back(line);
+        }
+    }
+}
+
+void LevelAnalysis::CreateWayPointLinks(LevelFile* levelRes, std::vector<WayPointLinkInfoStruct*> &outLinks) {
+    std::vector<EntityItem*>::iterator it;
+    EntityItem* next;
+
+    for (it = levelRes->Entities.begin(); it != levelRes->Entities.end(); ++it) {
+        switch ((*it)->getEntityType()) {
+            case Entity::EntityType::WaypointAmmo:
+            case Entity::EntityType::WaypointFuel:
+            case Entity::EntityType::WaypointShield:
+            case Entity::EntityType::WaypointShortcut:
+            case Entity::EntityType::WaypointSpecial1:
+            case Entity::EntityType::WaypointSpecial2:
+            case Entity::EntityType::WaypointSpecial3:
+            case Entity::EntityType::WaypointFast:
+            case Entity::EntityType::WaypointSlow: {
+                break;
+            }
+
+            default: {
+                continue;
+            }
+        }
+
+        next = nullptr;
+
+        if ((*it)->getNextID() != 0) {
+            levelRes->ReturnEntityItemWithId((*it)->getNextID(), &next);
+        }
+
+        //only a waypoint with a next element
+        //creates a waypoint link, see Race::AddWayPoint
+        if (next == nullptr)
+            continue;
+
+        WayPointLinkInfoStruct* newStruct = new WayPointLinkInfoStruct();
+
+        newStruct->pStartEntity = (*it);
+        newStruct->pEndEntity = next;
+
+        LineStruct *line = new LineStruct;
+
+        line->A = (*it)->getCenter();
+        line->B = next->getCenter();
+
+        irr::core::vector3df vec3D = (line->B - line->A);
+
+        newStruct->length3D = vec3D.getLength();
+        vec3D.normalize();
+
+        newStruct->pLineStruct = line;
+        newStruct->LinkDirectionVec = vec3D;
+
+        //points to the right side when looking into race direction
+        newStruct->offsetDirVec = newStruct->LinkDirectionVec.crossProduct(irr::core::vector3df(0.0f, -1.0f, 0.0f)).normalize();
+
+        outLinks.push_back(newStruct);
+    }
+}
+
+void LevelAnalysis::CleanUpWallSegmentLines(std::vector<LineStruct*> &lines) {
+    std::vector<LineStruct*>::iterator it;
+
+    for (it = lines.begin(); it != lines.end(); ++it) {
+        delete (*it);
+    }
+
+    lines.clear();
+}
+
+void LevelAnalysis::CleanUpWayPointLinks(std::vector<WayPointLinkInfoStruct*> &links) {
+    std::vector<WayPointLinkInfoStruct*>::iterator it;
+
+    for (it = links.begin(); it != links.end(); ++it) {
+        delete (*it)->pLineStruct;
+        delete (*it);
+    }
+
+    links.clear();
+}
+
+//The following code (idea) was taken and modified from
+/*
+    Fast Ray Casting Using DDA
+    "Itchy Eyes... Not blinking enough..." - javidx9
+
+    Video: https://youtu.be/NbSee-XM7WA
+
+    For the license see the top of this file
+*/
+bool LevelAnalysis::CastRayDDA(irr::core::vector3df startPos, irr::core::vector3df dirVec, irr::f32 maxRange,
+                               std::vector<irr::core::vector2di> &visitedCells, irr::f32 &hitDistance) {
+   irr::core::vector2df vRayStart;
+   irr::core::vector2df vRayDir;
+
+   //in our world x coordinate is negative! (swapped!)
+   vRayStart.X = -startPos.X;
+   vRayStart.Y = startPos.Z;
+
+   vRayDir.X = -dirVec.X;
+   vRayDir.Y = dirVec.Z;
+
+   vRayDir.normalize();
+
+   irr::core::vector2df vRayUnitStepSize =
+   { sqrt(1 + (vRayDir.Y / vRayDir.X) * (vRayDir.Y / vRayDir.X)), sqrt(1 + (vRayDir.X / vRayDir.Y) * (vRayDir.X / vRayDir.Y)) };
+   irr::core::vector2di vMapCheck;
+
+   vMapCheck.X = (irr::s32)(vRayStart.X);   //truncates to integer
+   vMapCheck.Y = (irr::s32)(vRayStart.Y);   //truncates to integer
+
+   irr::core::vector2df vRayLength1D;
+   irr::core::vector2di vStep;
+
+   // Establish Starting Conditions
+   if (vRayDir.X < 0)
+     {
+       vStep.X = -1;
+       vRayLength1D.X = (vRayStart.X - float(vMapCheck.X)) * vRayUnitStepSize.X;
+      } else
+         {
+           vStep.X = 1;
+           vRayLength1D.X = (float(vMapCheck.X + 1) - vRayStart.X) * vRayUnitStepSize.X;
+         }
+
+   if (vRayDir.Y < 0)
+     {
+      vStep.Y = -1;
+      vRayLength1D.Y = (vRayStart.Y - float(vMapCheck.Y)) * vRayUnitStepSize.Y;
+     }
+      else
+     {
+       vStep.Y = 1;
+       vRayLength1D.Y = (float(vMapCheck.Y + 1) - vRayStart.Y) * vRayUnitStepSize.Y;
+    }
+
+   // Perform "Walk" until collision or range check
+   bool bTileFound = false;
+   float fDistance = 0.0f;
+   bool bOutsideMap = false;
+
+   while (!bTileFound && !bOutsideMap && (fDistance < maxRange))
+    {
+      // Walk along shortest path
+      if (vRayLength1D.X < vRayLength1D.Y)
+        {
+          vMapCheck.X += vStep.X;
+          fDistance = vRayLength1D.X;
+          vRayLength1D.X += vRayUnitStepSize.X;
+        }
+         else {
+              vMapCheck.Y += vStep.Y;
+              fDistance = vRayLength1D.Y;
+              vRayLength1D.Y += vRayUnitStepSize.Y;
+           }
+
+       // Test tile at new test point
+       if (vMapCheck.X >= 0 && vMapCheck.X < mWidth && vMapCheck.Y >= 0 && vMapCheck.Y < mHeight)
+        {
+           //remember that we visited this cell
+           visitedCells.push_back(irr::core::vector2di(vMapCheck.X, vMapCheck.Y));
+
+           if (mStaticWorldMap.at(vMapCheck.Y * mWidth + vMapCheck.X) == 1)
+            {
+              bTileFound = true;
+            }
+        } else {
+           //we exited valid map region
+           bOutsideMap = true;
+       }
+   }
+
+   if (bTileFound) {
+       hitDistance = fDistance;
+   }
+
+   return bTileFound;
+}
@@ -0,0 +1,103 @@
+/*
+ Copyright (C) 2026 Wolf Alexander
+
+ This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.                                          */
+
+#ifndef LEVELANALYSIS_H
+#define LEVELANALYSIS_H
+
+#include "irrlicht.h"
+#include <vector>
+#include <cstdint>
+
+//how many pixels the world pictures of WorldAwareness
+//have per unit length in the 3D world
+#define LEVELANALYSIS_PIXELSCALEFACTOR 5
+
+//safety distance that is kept to the track
+//end when the waypoint links are shifted sideways
+const irr::f32 WA_CP_PLAYER_NAVIGATIONAREASAFETYDISTANCE = 0.0f;
+
+/************************
+ * Forward declarations *
+ ************************/
+
+class LevelFile;
+class LevelCache;
+class MapEntry;
+struct LineStruct;
+struct WayPointLinkInfoStruct;
+
+//Derives the static data of a level that the computer players need, and that only depends
+//on the level file: the static world map (which tiles contain a wall or a column) and the
+//possible sideways offset range of each waypoint link. Does not need the Irrlicht device,
+//so that the level compiler hi-levelc derives exactly the same level cache sections as the game
+class LevelAnalysis {
+public:
+    LevelAnalysis(LevelFile* levelRes);
+    ~LevelAnalysis();
+
+    //draws the wall segment lines, and the columns which are part of the
+    //collision mesh, into the static world map
+    void CreateStaticWorldMap(const std::vector<LineStruct*> &wallSegmentLines);
+
+    //calculates the min/max offset shift values of all waypoint links; The static
+    //world map must be created (or loaded from the level cache) before
+    void AnalyzeWaypointLinksOffsetRange(std::vector<WayPointLinkInfoStruct*> &wayPointLinks);
+
+    //Returns true if the static world map could be
+    //taken from the level cache, false otherwise
+    bool LoadStaticWorldMapFromCache(LevelCache* levelCache);
+    void StoreStaticWorldMapInCache(LevelCache* levelCache);
+
+    //Returns true if the waypoint link offset ranges could be
+    //taken from the level cache, false otherwise
+    bool LoadWaypointLinksOffsetRangeFromCache(LevelCache* levelCache, std::vector<WayPointLinkInfoStruct*> &wayPointLinks);
+    void StoreWaypointLinksOffsetRangeInCache(LevelCache* levelCache, const std::vector<WayPointLinkInfoStruct*> &wayPointLinks);
+
+    //the level compiler has no race which creates the wall segment lines and waypoint links
+    //out of the level entities; The following functions create them in the same way as the
+    //race does (but only the data that is needed for the analysis)
+    static void CreateWallSegmentLines(LevelFile* levelRes, std::vector<LineStruct*> &outLines);
+    static void CreateWayPointLinks(LevelFile* levelRes, std::vector<WayPointLinkInfoStruct*> &outLinks);
+    static void CleanUpWallSegmentLines(std::vector<LineStruct*> &lines);
+    static void CleanUpWayPointLinks(std::vector<WayPointLinkInfoStruct*> &links);
+
+    //returns true if the texture Id is one of the road textures; with addExtendedTextures
+    //also some more road textures are accepted, which we can not use for the minimap creation
+    static bool IsRoadTexture(irr::s32 texture, bool addExtendedTextures = false);
+
+    //static world map contains info about static
+    //Terrain and Cubes; 0 means in the tile there is no obstacle
+    //1 means there is an obstacle
+    std::vector<uint8_t> mStaticWorldMap;
+
+private:
+    LevelFile* mLevelRes = nullptr;
+
+    irr::s32 mWidth;
+    irr::s32 mHeight;
+
+    MapEntry* GetMapEntry(int x, int y);
+
+    //marks the tile which contains the specified pixel of the
+    //(not existing) static world picture as obstacle
+    void SetPixel(irr::f32 x, irr::f32 y);
+    void DrawLine(irr::f32 x1, irr::f32 y1, irr::f32 x2, irr::f32 y2);
+    void DrawRectangle(irr::f32 x1, irr::f32 y1, irr::f32 x2, irr::f32 y2);
+
+    //casts a 2D ray through the static world map, returns true
+    //if an obstacle was hit
+    bool CastRayDDA(irr::core::vector3df startPos, irr::core::vector3df dirVec, irr::f32 maxRange,
+                    std::vector<irr::core::vector2di> &visitedCells, irr::f32 &hitDistance);
+
+    //returns true if a track end was identified
+    bool FindTrackEndAlongCastRay(std::vector<irr::core::vector2di> cells,
+                                  irr::core::vector3df rayStartPoint3D, irr::f32 &distanceToEnd);
+};
+
+#endif // LEVELANALYSIS_H
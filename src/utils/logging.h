@@ -8,6 +8,7 @@
 #include <iostream>
 #include <fstream>
 #include <ios>
+#include <mutex>
 #include "irrlicht.h"
 
 namespace logging {
@@ -22,7 +23,13 @@ namespace logging {
     inline bool LogFileExists = false;
     inline bool PrintOnlyIssues = false;
 
+    //messages can also be written from worker threads
+    //(for example during game data extraction)
+    inline std::mutex LogMutex;
+
     inline void Message(const char* level, const char* color, bool isIssue, const char* message) {
+        std::lock_guard<std::mutex> lock(LogMutex);
+
         if (LogFileExists) {
             LogFile << level << message << std::endl;
         }
@@ -35,6 +42,8 @@ namespace logging {
     }
 
     inline void Message(const char* level, const char* color, bool isIssue, const std::string &message) {
+        std::lock_guard<std::mutex> lock(LogMutex);
+
         if (LogFileExists) {
             LogFile << level << message << std::endl;
         }
@@ -0,0 +1,497 @@
+/*
+ Copyright (C) 2026 Wolf Alexander
+
+ This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.                                          */
+
+#include "occlusion.h"
+#include "../definitions.h"
+#include "../models/levelterrain.h"
+#include "../models/levelblocks.h"
+#include "../models/column.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+OcclusionCulling::OcclusionCulling(irr::u32 bufferWidth, irr::u32 bufferHeight) {
+    mBufferWidth = bufferWidth;
+    mBufferHeight = bufferHeight;
+
+    mDepthBuffer.resize(mBufferWidth * mBufferHeight, std::numeric_limits<irr::f32>::max());
+
+    mOccluderVec.clear();
+    mCulledSceneNodeVec.clear();
+}
+
+OcclusionCulling::~OcclusionCulling() {
+    //make sure we do not leave any scene node
+    //hidden behind
+    RestoreCulledSceneNodes();
+
+    mOccluderVec.clear();
+}
+
+void OcclusionCulling::SetEnabled(bool enabled) {
+    mEnabled = enabled;
+
+    if (!mEnabled) {
+        RestoreCulledSceneNodes();
+
+        mNrTestedLastFrame = 0;
+        mNrCulledLastFrame = 0;
+        mNrOccludersRasterizedLastFrame = 0;
+    }
+}
+
+bool OcclusionCulling::IsEnabled() {
+    return mEnabled;
+}
+
+irr::u32 OcclusionCulling::GetBufferWidth() {
+    return mBufferWidth;
+}
+
+irr::u32 OcclusionCulling::GetBufferHeight() {
+    return mBufferHeight;
+}
+
+irr::f32 OcclusionCulling::GetDepthValue(irr::u32 x, irr::u32 y) {
+    if ((x >= mBufferWidth) || (y >= mBufferHeight))
+        return std::numeric_limits<irr::f32>::max();
+
+    return mDepthBuffer[y * mBufferWidth + x];
+}
+
+void OcclusionCulling::ClearOccluders() {
+    mOccluderVec.clear();
+    mNrOccluders = 0;
+}
+
+void OcclusionCulling::AddOccluderBox(irr::core::aabbox3df box) {
+    OccluderBoxStruct newOccluder;
+
+    newOccluder.box = box;
+    newOccluder.center = box.getCenter();
+
+    mOccluderVec.push_back(newOccluder);
+    mNrOccluders = (irr::u32)(mOccluderVec.size());
+}
+
+void OcclusionCulling::AddOccludersFromTerrain(LevelTerrain* terrain) {
+    if (terrain == nullptr)
+        return;
+
+    int width = terrain->get_width();
+    int height = terrain->get_heigth();
+
+    TerrainTileData* tile;
+
+    for (int x0 = 0; x0 < width; x0 += DEF_OCCLUSION_TERRAIN_BLOCKSIZE) {
+        for (int z0 = 0; z0 < height; z0 += DEF_OCCLUSION_TERRAIN_BLOCKSIZE) {
+            int x1 = std::min(x0 + DEF_OCCLUSION_TERRAIN_BLOCKSIZE, width);
+            int z1 = std::min(z0 + DEF_OCCLUSION_TERRAIN_BLOCKSIZE, height);
+
+            bool validBlock = true;
+            irr::f32 minHeight = std::numeric_limits<irr::f32>::max();
+
+            for (int x = x0; (x < x1) && validBlock; x++) {
+                for (int z = z0; z < z1; z++) {
+                    tile = &terrain->pTerrainTiles[x][z];
+
+                    //tiles that are not rendered, or that are able to
+                    //morph must not be used as occluders
+                    if (!tile->m_draw_in_mesh || tile->dynamicMesh) {
+                        validBlock = false;
+                        break;
+                    }
+
+                    //vertice Y coordinates of the terrain tiles are stored
+                    //inverted, because the terrain scene node is rotated by 180 degrees
+                    const irr::f32* vertHeight = terrain->mTileStore->GetVertexHeights(x, z);
+
+                    minHeight = std::min(minHeight, -vertHeight[0]);
+                    minHeight = std::min(minHeight, -vertHeight[1]);
+                    minHeight = std::min(minHeight, -vertHeight[2]);
+                    minHeight = std::min(minHeight, -vertHeight[3]);
+                }
+            }
+
+            if (!validBlock)
+                continue;
+
+            //the whole box is below the terrain surface of all covered
+            //tiles, therefore the box is for sure solid
+            //our X axis is swapped compared to level file
+            irr::core::aabbox3df box(-x1 * DEF_SEGMENTSIZE, minHeight - DEF_OCCLUSION_TERRAIN_BOXDEPTH, z0 * DEF_SEGMENTSIZE,
+                                     -x0 * DEF_SEGMENTSIZE, minHeight, z1 * DEF_SEGMENTSIZE);
+
+            AddOccluderBox(box);
+        }
+    }
+}
+
+void OcclusionCulling::AddOccludersFromColumns(LevelBlocks* levelBlocks, std::vector<Column*> &excludeColumns) {
+    if (levelBlocks == nullptr)
+        return;
+
+    std::vector<ColumnsByPositionStruct>::iterator it;
+    std::vector<BlockInfoStruct*>::iterator itBlock;
+    Column* column;
+
+    for (it = levelBlocks->ColumnsByPosition.begin(); it != levelBlocks->ColumnsByPosition.end(); ++it) {
+        column = (*it).pColumn;
+
+        if (column == nullptr)
+            continue;
+
+        if (column->Hidden || column->DestroyOnMorph || (column->MorphSource != nullptr))
+            continue;
+
+        if (std::find(excludeColumns.begin(), excludeColumns.end(), column) != excludeColumns.end())
+            continue;
+
+        //the column base follows the terrain, and can therefore be
+        //tilted; only use the region in Y direction which is solid
+        //for sure over the whole column footprint
+        irr::f32 baseMin = std::min(std::min(column->mBaseVert1Coord.Y, column->mBaseVert2Coord.Y),
+                                    std::min(column->mBaseVert3Coord.Y, column->mBaseVert4Coord.Y));
+        irr::f32 baseMax = std::max(std::max(column->mBaseVert1Coord.Y, column->mBaseVert2Coord.Y),
+                                    std::max(column->mBaseVert3Coord.Y, column->mBaseVert4Coord.Y));
+
+        //a too steep column base does not leave a usable
+        //solid box inside of a single block
+        if ((baseMax - baseMin) >= DEF_SEGMENTSIZE)
+            continue;
+
+        //collect all existing block indices of this column
+        std::vector<irr::u8> blockIdxVec;
+
+        for (itBlock = column->mBlockInfoVec.begin(); itBlock != column->mBlockInfoVec.end(); ++itBlock) {
+            blockIdxVec.push_back((*itBlock)->idxBlockFromBaseCnt);
+        }
+
+        if (blockIdxVec.size() < 1)
+            continue;
+
+        std::sort(blockIdxVec.begin(), blockIdxVec.end());
+
+        irr::f32 minX = std::min(std::min(column->mBaseVert1Coord.X, column->mBaseVert2Coord.X),
+                                 std::min(column->mBaseVert3Coord.X, column->mBaseVert4Coord.X));
+        irr::f32 maxX = std::max(std::max(column->mBaseVert1Coord.X, column->mBaseVert2Coord.X),
+                                 std::max(column->mBaseVert3Coord.X, column->mBaseVert4Coord.X));
+        irr::f32 minZ = std::min(std::min(column->mBaseVert1Coord.Z, column->mBaseVert2Coord.Z),
+                                 std::min(column->mBaseVert3Coord.Z, column->mBaseVert4Coord.Z));
+        irr::f32 maxZ = std::max(std::max(column->mBaseVert1Coord.Z, column->mBaseVert2Coord.Z),
+                                 std::max(column->mBaseVert3Coord.Z, column->mBaseVert4Coord.Z));
+
+        //combine contiguous blocks into one single
+        //occluder box
+        size_t runStart = 0;
+
+        for (size_t idx = 1; idx <= blockIdxVec.size(); idx++) {
+            if ((idx < blockIdxVec.size()) && (blockIdxVec[idx] == blockIdxVec[idx - 1] + 1))
+                continue;
+
+            irr::f32 runBottom = baseMax + blockIdxVec[runStart] * DEF_SEGMENTSIZE;
+            irr::f32 runTop = baseMin + (blockIdxVec[idx - 1] + 1) * DEF_SEGMENTSIZE;
+
+            if (runTop > runBottom) {
+                AddOccluderBox(irr::core::aabbox3df(minX, runBottom, minZ, maxX, runTop, maxZ));
+            }
+
+            runStart = idx;
+        }
+    }
+}
+
+void OcclusionCulling::TransformToClipSpace(const irr::core::vector3df& pnt, irr::f32* outClip) {
+    outClip[0] = pnt.X;
+    outClip[1] = pnt.Y;
+    outClip[2] = pnt.Z;
+    outClip[3] = 1.0f;
+
+    mViewProjMatrix.multiplyWith1x4Float(outClip);
+}
+
+//outScreen receives screen X, screen Y and 1/W
+void OcclusionCulling::ClipSpaceToScreen(const irr::f32* clip, irr::f32* outScreen) {
+    irr::f32 invW = 1.0f / clip[3];
+
+    outScreen[0] = (clip[0] * invW * 0.5f + 0.5f) * (irr::f32)(mBufferWidth);
+    outScreen[1] = (0.5f - clip[1] * invW * 0.5f) * (irr::f32)(mBufferHeight);
+    outScreen[2] = invW;
+}
+
+void OcclusionCulling::RasterizeScreenTriangle(const irr::f32* v1, const irr::f32* v2, const irr::f32* v3) {
+    irr::f32 area = (v2[0] - v1[0]) * (v3[1] - v1[1]) - (v2[1] - v1[1]) * (v3[0] - v1[0]);
+
+    //skip degenerated triangles
+    if (fabs(area) < 0.0001f)
+        return;
+
+    irr::f32 invArea = 1.0f / area;
+
+    irr::s32 minX = (irr::s32)(floor(std::min(std::min(v1[0], v2[0]), v3[0])));
+    irr::s32 maxX = (irr::s32)(ceil(std::max(std::max(v1[0], v2[0]), v3[0])));
+    irr::s32 minY = (irr::s32)(floor(std::min(std::min(v1[1], v2[1]), v3[1])));
+    irr::s32 maxY = (irr::s32)(ceil(std::max(std::max(v1[1], v2[1]), v3[1])));
+
+    minX = std::max(minX, 0);
+    minY = std::max(minY, 0);
+    maxX = std::min(maxX, (irr::s32)(mBufferWidth) - 1);
+    maxY = std::min(maxY, (irr::s32)(mBufferHeight) - 1);
+
+    if ((minX > maxX) || (minY > maxY))
+        return;
+
+    for (irr::s32 py = minY; py <= maxY; py++) {
+        irr::f32 sy = (irr::f32)(py) + 0.5f;
+        irr::f32* depthRow = &mDepthBuffer[py * mBufferWidth];
+
+        for (irr::s32 px = minX; px <= maxX; px++) {
+            irr::f32 sx = (irr::f32)(px) + 0.5f;
+
+            //barycentric weights multiplied with the triangle area,
+            //multiplying with invArea normalizes them, and also
+            //makes the test independent of the triangle winding
+            irr::f32 w1 = ((v3[0] - v2[0]) * (sy - v2[1]) - (v3[1] - v2[1]) * (sx - v2[0])) * invArea;
+            irr::f32 w2 = ((v1[0] - v3[0]) * (sy - v3[1]) - (v1[1] - v3[1]) * (sx - v3[0])) * invArea;
+            irr::f32 w3 = 1.0f - w1 - w2;
+
+            if ((w1 < 0.0f) || (w2 < 0.0f) || (w3 < 0.0f))
+                continue;
+
+            //1/W is linear in screen space
+            irr::f32 invW = w1 * v1[2] + w2 * v2[2] + w3 * v3[2];
+
+            if (invW <= 0.0f)
+                continue;
+
+            irr::f32 depth = 1.0f / invW;
+
+            if (depth < depthRow[px]) {
+                depthRow[px] = depth;
+            }
+        }
+    }
+}
+
+void OcclusionCulling::RasterizeClipSpaceTriangle(const irr::f32* v1, const irr::f32* v2, const irr::f32* v3) {
+    const irr::f32* inVert[3] = {v1, v2, v3};
+
+    //clip the triangle at the near plane (W = near)
+    //the result has max 4 vertices
+    irr::f32 clipped[4][4];
+    irr::u32 nrClipped = 0;
+
+    for (irr::u32 i = 0; i < 3; i++) {
+        const irr::f32* curr = inVert[i];
+        const irr::f32* next = inVert[(i + 1) % 3];
+
+        irr::f32 dCurr = curr[3] - DEF_OCCLUSION_NEAR_PLANE;
+        irr::f32 dNext = next[3] - DEF_OCCLUSION_NEAR_PLANE;
+
+        if (dCurr >= 0.0f) {
+            for (irr::u32 c = 0; c < 4; c++) {
+                clipped[nrClipped][c] = curr[c];
+            }
+            nrClipped++;
+        }
+
+        if ((dCurr >= 0.0f) != (dNext >= 0.0f)) {
+            irr::f32 t = dCurr / (dCurr - dNext);
+
+            for (irr::u32 c = 0; c < 4; c++) {
+                clipped[nrClipped][c] = curr[c] + (next[c] - curr[c]) * t;
+            }
+            nrClipped++;
+        }
+    }
+
+    if (nrClipped < 3)
+        return;
+
+    irr::f32 screen[4][3];
+
+    for (irr::u32 i = 0; i < nrClipped; i++) {
+        ClipSpaceToScreen(clipped[i], screen[i]);
+    }
+
+    RasterizeScreenTriangle(screen[0], screen[1], screen[2]);
+
+    if (nrClipped == 4) {
+        RasterizeScreenTriangle(screen[0], screen[2], screen[3]);
+    }
+}
+
+void OcclusionCulling::RasterizeBox(const irr::core::aabbox3df& box) {
+    irr::core::vector3df edges[8];
+    box.getEdges(edges);
+
+    irr::f32 clip[8][4];
+
+    //outcodes to reject boxes that are completely
+    //outside of the view frustum
+    irr::u32 outCodeAnd = 0x1F;
+
+    for (irr::u32 i = 0; i < 8; i++) {
+        TransformToClipSpace(edges[i], clip[i]);
+
+        irr::u32 outCode = 0;
+
+        if (clip[i][0] < -clip[i][3]) outCode |= 0x01;
+        if (clip[i][0] > clip[i][3]) outCode |= 0x02;
+        if (clip[i][1] < -clip[i][3]) outCode |= 0x04;
+        if (clip[i][1] > clip[i][3]) outCode |= 0x08;
+        if (clip[i][3] < DEF_OCCLUSION_NEAR_PLANE) outCode |= 0x10;
+
+        outCodeAnd &= outCode;
+    }
+
+    if (outCodeAnd != 0)
+        return;
+
+    mNrOccludersRasterizedLastFrame++;
+
+    //the 6 box faces, vertex indices as returned by
+    //aabbox3d::getEdges
+    static const irr::u8 faceIdx[6][4] = {
+        {0, 1, 3, 2},  //X min
+        {4, 5, 7, 6},  //X max
+        {0, 1, 5, 4},  //Z min
+        {2, 3, 7, 6},  //Z max
+        {0, 2, 6, 4},  //Y min
+        {1, 3, 7, 5}   //Y max
+    };
+
+    for (irr::u32 f = 0; f < 6; f++) {
+        RasterizeClipSpaceTriangle(clip[faceIdx[f][0]], clip[faceIdx[f][1]], clip[faceIdx[f][2]]);
+        RasterizeClipSpaceTriangle(clip[faceIdx[f][0]], clip[faceIdx[f][2]], clip[faceIdx[f][3]]);
+    }
+}
+
+void OcclusionCulling::RasterizeOccluders(const irr::core::matrix4& viewMatrix, const irr::core::matrix4& projMatrix,
+                                          irr::core::vector3df cameraPosition) {
+    mNrOccludersRasterizedLastFrame = 0;
+    mNrTestedLastFrame = 0;
+    mNrCulledLastFrame = 0;
+
+    if (!mEnabled) {
+        mDepthBufferValid = false;
+        return;
+    }
+
+    mViewProjMatrix = projMatrix;
+    mViewProjMatrix *= viewMatrix;
+
+    std::fill(mDepthBuffer.begin(), mDepthBuffer.end(), std::numeric_limits<irr::f32>::max());
+
+    std::vector<OccluderBoxStruct>::iterator it;
+    irr::f32 maxDistSQ = DEF_OCCLUSION_MAX_OCCLUDER_DIST * DEF_OCCLUSION_MAX_OCCLUDER_DIST;
+
+    for (it = mOccluderVec.begin(); it != mOccluderVec.end(); ++it) {
+        if ((*it).center.getDistanceFromSQ(cameraPosition) > maxDistSQ)
+            continue;
+
+        RasterizeBox((*it).box);
+    }
+
+    mDepthBufferValid = true;
+}
+
+bool OcclusionCulling::IsBoxVisible(const irr::core::aabbox3df& box) {
+    if (!mEnabled || !mDepthBufferValid)
+        return true;
+
+    irr::core::vector3df edges[8];
+    box.getEdges(edges);
+
+    irr::f32 clip[4];
+    irr::f32 screen[3];
+
+    irr::f32 minSX = std::numeric_limits<irr::f32>::max();
+    irr::f32 minSY = std::numeric_limits<irr::f32>::max();
+    irr::f32 maxSX = -std::numeric_limits<irr::f32>::max();
+    irr::f32 maxSY = -std::numeric_limits<irr::f32>::max();
+    irr::f32 minDepth = std::numeric_limits<irr::f32>::max();
+
+    for (irr::u32 i = 0; i < 8; i++) {
+        TransformToClipSpace(edges[i], clip);
+
+        //box intersects the near plane, we need to
+        //treat it as visible
+        if (clip[3] < DEF_OCCLUSION_NEAR_PLANE)
+            return true;
+
+        ClipSpaceToScreen(clip, screen);
+
+        minSX = std::min(minSX, screen[0]);
+        maxSX = std::max(maxSX, screen[0]);
+        minSY = std::min(minSY, screen[1]);
+        maxSY = std::max(maxSY, screen[1]);
+        minDepth = std::min(minDepth, clip[3]);
+    }
+
+    irr::s32 x0 = std::max((irr::s32)(floor(minSX)), 0);
+    irr::s32 y0 = std::max((irr::s32)(floor(minSY)), 0);
+    irr::s32 x1 = std::min((irr::s32)(ceil(maxSX)), (irr::s32)(mBufferWidth) - 1);
+    irr::s32 y1 = std::min((irr::s32)(ceil(maxSY)), (irr::s32)(mBufferHeight) - 1);
+
+    //completely outside of the screen; This is the job of
+    //the frustum culling of Irrlicht, not ours
+    if ((x0 > x1) || (y0 > y1))
+        return true;
+
+    irr::f32 testDepth = minDepth - DEF_OCCLUSION_DEPTH_BIAS;
+
+    for (irr::s32 py = y0; py <= y1; py++) {
+        const irr::f32* depthRow = &mDepthBuffer[py * mBufferWidth];
+
+        for (irr::s32 px = x0; px <= x1; px++) {
+            //if there is at least one pixel where the occluder is
+            //further away than the closest point of the box, the box can be seen
+            if (depthRow[px] >= testDepth)
+                return true;
+        }
+    }
+
+    return false;
+}
+
+void OcclusionCulling::CullSceneNodes(std::vector<irr::scene::ISceneNode*> &nodes) {
+    if (!mEnabled || !mDepthBufferValid)
+        return;
+
+    std::vector<irr::scene::ISceneNode*>::iterator it;
+
+    for (it = nodes.begin(); it != nodes.end(); ++it) {
+        if ((*it) == nullptr)
+            continue;
+
+        //do not touch nodes that are hidden by the
+        //game logic itself
+        if (!(*it)->isVisible())
+            continue;
+
+        mNrTestedLastFrame++;
+
+        if (!IsBoxVisible((*it)->getTransformedBoundingBox())) {
+            (*it)->setVisible(false);
+            mCulledSceneNodeVec.push_back(*it);
+            mNrCulledLastFrame++;
+        }
+    }
+}
+
+void OcclusionCulling::RestoreCulledSceneNodes() {
+    std::vector<irr::scene::ISceneNode*>::iterator it;
+
+    for (it = mCulledSceneNodeVec.begin(); it != mCulledSceneNodeVec.end(); ++it) {
+        (*it)->setVisible(true);
+    }
+
+    mCulledSceneNodeVec.clear();
+}
@@ -0,0 +1,150 @@
+/*
+ Copyright (C) 2026 Wolf Alexander
+
+ This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.                                          */
+
+#ifndef OCCLUSION_H
+#define OCCLUSION_H
+
+#include "irrlicht.h"
+#include <vector>
+#include <cstdint>
+
+//resolution of the CPU side depth buffer used for
+//occlusion culling; The buffer is deliberately very small,
+//we only want to find out which objects are hidden behind
+//big walls, terrain hills and columns
+#define DEF_OCCLUSION_BUFFER_WIDTH 160
+#define DEF_OCCLUSION_BUFFER_HEIGHT 96
+
+//size (in number of terrain cells) of the terrain
+//occluder boxes in X and Z direction
+#define DEF_OCCLUSION_TERRAIN_BLOCKSIZE 4
+
+//depth of terrain occluder boxes below
+//the lowest terrain vertex of the box region
+#define DEF_OCCLUSION_TERRAIN_BOXDEPTH 2.0f
+
+//an object is only culled if it is at least this far behind the
+//closest occluder (in world units); protects us from
+//culling objects that are touching a wall
+#define DEF_OCCLUSION_DEPTH_BIAS 0.25f
+
+//occluders closer than this to the camera are
+//clipped at this plane
+#define DEF_OCCLUSION_NEAR_PLANE 0.1f
+
+//occluders further away than this distance to the camera
+//are not rasterized anymore, because they would only
+//cover very few pixels anyway
+#define DEF_OCCLUSION_MAX_OCCLUDER_DIST 120.0f
+
+/************************
+ * Forward declarations *
+ ************************/
+
+class LevelTerrain;
+class LevelBlocks;
+class Column;
+
+//an occluder is always a solid box, which means
+//everything inside the box is guaranteed to be not
+//transparent (inside of a column, below the terrain surface...)
+struct OccluderBoxStruct {
+    irr::core::aabbox3df box;
+
+    //middle of the box, precalculated to be
+    //able to quickly skip far away occluders
+    irr::core::vector3df center;
+};
+
+class OcclusionCulling {
+public:
+    OcclusionCulling(irr::u32 bufferWidth = DEF_OCCLUSION_BUFFER_WIDTH, irr::u32 bufferHeight = DEF_OCCLUSION_BUFFER_HEIGHT);
+    ~OcclusionCulling();
+
+    //removes all currently registered occluders
+    void ClearOccluders();
+
+    //adds a solid box occluder, box is specified in
+    //world coordinates
+    void AddOccluderBox(irr::core::aabbox3df box);
+
+    //Creates terrain occluder boxes from the current terrain height
+    //Tiles that can be morphed, and tiles that were optimized away
+    //(are not rendered) are never used as occluder
+    void AddOccludersFromTerrain(LevelTerrain* terrain);
+
+    //Creates occluder boxes for all solid block runs of all columns
+    //Columns inside excludeColumns (for example because they
+    //are morphed later), hidden columns, and columns that are
+    //destroyed by morphs are skipped
+    void AddOccludersFromColumns(LevelBlocks* levelBlocks, std::vector<Column*> &excludeColumns);
+
+    //Clears the depth buffer, and rasterizes all registered occluders
+    //using the specified camera view and projection matrix
+    void RasterizeOccluders(const irr::core::matrix4& viewMatrix, const irr::core::matrix4& projMatrix,
+                            irr::core::vector3df cameraPosition);
+
+    //Returns true if the specified world axis aligned bounding box is (maybe)
+    //visible, returns false if the box is for sure hidden behind occluders
+    //RasterizeOccluders needs to be called once before in the current frame
+    bool IsBoxVisible(const irr::core::aabbox3df& box);
+
+    //Tests all specified scene nodes that are currently visible against the
+    //depth buffer, and hides the ones that are occluded; Nodes that were hidden
+    //are remembered, and made visible again with RestoreCulledSceneNodes
+    void CullSceneNodes(std::vector<irr::scene::ISceneNode*> &nodes);
+
+    //needs to be called after the scene was rendered
+    void RestoreCulledSceneNodes();
+
+    void SetEnabled(bool enabled);
+    bool IsEnabled();
+
+    //statistics of the last frame
+    irr::u32 mNrOccluders = 0;
+    irr::u32 mNrOccludersRasterizedLastFrame = 0;
+    irr::u32 mNrTestedLastFrame = 0;
+    irr::u32 mNrCulledLastFrame = 0;
+
+    irr::u32 GetBufferWidth();
+    irr::u32 GetBufferHeight();
+
+    //Returns the current depth value of the specified pixel
+    //of the depth buffer; Is mainly useful for debugging
+    irr::f32 GetDepthValue(irr::u32 x, irr::u32 y);
+
+private:
+    bool mEnabled = true;
+
+    irr::u32 mBufferWidth;
+    irr::u32 mBufferHeight;
+
+    //the depth buffer itself, stores for each pixel the
+    //closest occluder distance to the camera (clip space W value)
+    std::vector<irr::f32> mDepthBuffer;
+
+    std::vector<OccluderBoxStruct> mOccluderVec;
+
+    //scene nodes hidden by us in the current frame
+    std::vector<irr::scene::ISceneNode*> mCulledSceneNodeVec;
+
+    irr::core::matrix4 mViewProjMatrix;
+    bool mDepthBufferValid = false;
+
+    //Rasterizes one triangle with clip space vertices (x, y, z, w) into
+    //the depth buffer, performs near plane clipping if necessary
+    void RasterizeClipSpaceTriangle(const irr::f32* v1, const irr::f32* v2, const irr::f32* v3);
+    void RasterizeScreenTriangle(const irr::f32* v1, const irr::f32* v2, const irr::f32* v3);
+    void RasterizeBox(const irr::core::aabbox3df& box);
+
+    void TransformToClipSpace(const irr::core::vector3df& pnt, irr::f32* outClip);
+    void ClipSpaceToScreen(const irr::f32* clip, irr::f32* outScreen);
+};
+
+#endif // OCCLUSION_H
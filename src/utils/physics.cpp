@@ -363,9 +363,9 @@ void PhysicsObject::DebugDrawCurrentWorldCoordForces(DrawDebug* drawDebugObj, Co
      //draw all currently active force vectors with arrows
      for (it = debugForceVectorWorldCoord.begin(); it != debugForceVectorWorldCoord.end(); ++it) {
          if ((dbgForceClassification == PHYSIC_DBG_FORCETYPE_GENERICALL) || (dbgForceClassification == (*it).DbgForceType)) {
-            drawDebugObj->Draw3DLine((*it).DbgLastArmVecStart, (*it).DbgLastArmVecEnd, drawDebugObj->pink);
-            drawDebugObj->Draw3DLine((*it).DbgFTorqueStart, (*it).DbgFTorqueEnd, drawDebugObj->brown);
-            drawDebugObj->Draw3DArrow((*it).ForceStartPoint, (*it).ForceEndPoint, 0.0f, Color, 0.1f);
+            drawDebugObj->Draw3DLine((*it).DbgLastArmVecStart, (*it).DbgLastArmVecEnd, drawDebugObj->pink, DEF_DRAWDEBUG_CAT_PHYSICS);
+            drawDebugObj->Draw3DLine((*it).DbgFTorqueStart, (*it).DbgFTorqueEnd, drawDebugObj->brown, DEF_DRAWDEBUG_CAT_PHYSICS);
+            drawDebugObj->Draw3DArrow((*it).ForceStartPoint, (*it).ForceEndPoint, 0.0f, Color, 0.1f, DEF_DRAWDEBUG_CAT_PHYSICS);
          }
      }
 }
@@ -895,7 +895,7 @@ void Physics::DrawSelectedCollisionMeshTriangles(const PhysicsCollisionArea& col
 
     for ( int i=0; i < collArea.mCollisionTrianglesSize; i++ )
     {
-      this->mDebugObj->Draw3DTriangle(&collArea.mCollisionTriangles[i], mDebugObj->pink);
+      this->mDebugObj->Draw3DTriangle(&collArea.mCollisionTriangles[i], mDebugObj->pink, DEF_DRAWDEBUG_CAT_PHYSICS);
     }
 }
 
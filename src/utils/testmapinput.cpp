@@ -0,0 +1,67 @@
+/*
+ Copyright (C) 2026 Wolf Alexander
+
+ This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.                                          */
+
+#include "testmapinput.h"
+#include <iostream>
+#include <thread>
+
+TestMapInput::TestMapInput() {
+    mState = std::make_shared<TestMapInputState>();
+}
+
+TestMapInput::~TestMapInput() {
+}
+
+void TestMapInput::Start() {
+    if (mStarted)
+        return;
+
+    std::thread reader(&TestMapInput::ReaderThread, mState);
+    reader.detach();
+
+    mStarted = true;
+}
+
+void TestMapInput::ReaderThread(std::shared_ptr<TestMapInputState> state) {
+    std::string line;
+
+    while (std::getline(std::cin, line)) {
+        //remove the carriage return of Windows line endings
+        if (!line.empty() && (line.back() == '\r')) {
+            line.pop_back();
+        }
+
+        if (line.empty())
+            continue;
+
+        std::lock_guard<std::mutex> lock(state->mutex);
+        state->commandVec.push_back(line);
+    }
+
+    std::lock_guard<std::mutex> lock(state->mutex);
+    state->closed = true;
+}
+
+bool TestMapInput::GetNextCommand(std::string& command) {
+    std::lock_guard<std::mutex> lock(mState->mutex);
+
+    if (mState->commandVec.size() == 0)
+        return false;
+
+    command = mState->commandVec.front();
+    mState->commandVec.erase(mState->commandVec.begin());
+
+    return true;
+}
+
+bool TestMapInput::IsClosed() {
+    std::lock_guard<std::mutex> lock(mState->mutex);
+
+    return (mState->closed && (mState->commandVec.size() == 0));
+}
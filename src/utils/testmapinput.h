@@ -0,0 +1,64 @@
+/*
+ Copyright (C) 2026 Wolf Alexander
+
+ This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.                                          */
+
+#ifndef TESTMAPINPUT_H
+#define TESTMAPINPUT_H
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <mutex>
+
+//Command line the level editor sends to start a map test:
+//  test [nocpu] <level folder>
+//the level folder is the remaining part of the line
+#define DEF_TESTMAP_CMD_TEST "test"
+#define DEF_TESTMAP_OPTION_NOCPU "nocpu"
+
+//line the game writes to stdout as soon as it waits for
+//the next map test command
+#define DEF_TESTMAP_MSG_READY "hi-octane202x: ready for map test"
+
+//state that is shared with the reader thread
+struct TestMapInputState {
+    std::mutex mutex;
+    std::vector<std::string> commandVec;
+
+    //true as soon as stdin was closed
+    bool closed = false;
+};
+
+//Reads the map test commands the level editor writes into stdin of the game (one command per line)
+//on a separate thread, so that the game loop never blocks. The reader thread is detached, because
+//it can not be interrupted while it waits for the next line; it only uses the shared state, which
+//stays alive until the thread ends
+class TestMapInput {
+public:
+    TestMapInput();
+    ~TestMapInput();
+
+    //starts the reader thread
+    void Start();
+
+    //Returns true and the oldest received command line if there
+    //is one, false otherwise
+    bool GetNextCommand(std::string& command);
+
+    //true if stdin was closed (the level editor
+    //ended), and all commands were taken
+    bool IsClosed();
+
+private:
+    std::shared_ptr<TestMapInputState> mState;
+    bool mStarted = false;
+
+    static void ReaderThread(std::shared_ptr<TestMapInputState> state);
+};
+
+#endif // TESTMAPINPUT_H
@@ -0,0 +1,275 @@
+/*
+ Copyright (C) 2026 Wolf Alexander
+
+ This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.                                          */
+
+#include "threadpool.h"
+#include "logging.h"
+#include <algorithm>
+#include <exception>
+
+ThreadPool::ThreadPool(irr::u32 nrThreads) {
+    if (nrThreads == 0) {
+        //can return 0 if the number is not known
+        nrThreads = std::thread::hardware_concurrency();
+
+        if (nrThreads == 0) {
+            nrThreads = 1;
+        }
+    }
+
+    for (irr::u32 idx = 0; idx < nrThreads; idx++) {
+        mWorkerVec.push_back(std::thread(&ThreadPool::WorkerThread, this));
+    }
+
+    char hlpstr[100];
+    snprintf(hlpstr, 100, "Thread pool started with %u worker threads", nrThreads);
+    logging::Info(hlpstr);
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mShutdown = true;
+    }
+
+    mWakeUpCondition.notify_all();
+
+    std::vector<std::thread>::iterator itThread;
+
+    for (itThread = mWorkerVec.begin(); itThread != mWorkerVec.end(); ++itThread) {
+        (*itThread).join();
+    }
+
+    mWorkerVec.clear();
+
+    std::vector<ThreadPoolJob*>::iterator it;
+
+    for (it = mJobVec.begin(); it != mJobVec.end(); ++it) {
+        delete (*it);
+    }
+
+    mJobVec.clear();
+}
+
+ThreadPoolJob* ThreadPool::AddJob(const std::string& description, std::function<void()> work,
+                                  std::vector<ThreadPoolJob*> dependencies) {
+    ThreadPoolJob* newJob = new ThreadPoolJob();
+    newJob->description = description;
+    newJob->work = work;
+    newJob->dependencies = dependencies;
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mJobVec.push_back(newJob);
+    }
+
+    mWakeUpCondition.notify_one();
+
+    return newJob;
+}
+
+bool ThreadPool::IsJobFinished(ThreadPoolJob* job) {
+    irr::u8 state = job->state;
+
+    return ((state == DEF_THREADPOOL_JOB_DONE) || (state == DEF_THREADPOOL_JOB_FAILED));
+}
+
+void ThreadPool::WaitForJob(ThreadPoolJob* job) {
+    std::unique_lock<std::mutex> lock(mMutex);
+
+    while (!IsJobFinished(job)) {
+        mJobFinishedCondition.wait(lock);
+    }
+}
+
+bool ThreadPool::CancelJob(ThreadPoolJob* job) {
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        if (job->state != DEF_THREADPOOL_JOB_WAITING)
+            return false;
+
+        job->errorMsg = "canceled";
+        job->state = DEF_THREADPOOL_JOB_FAILED;
+    }
+
+    //jobs that depend on this job can fail now as well
+    mWakeUpCondition.notify_all();
+    mJobFinishedCondition.notify_all();
+
+    return true;
+}
+
+void ThreadPool::ReleaseJob(ThreadPoolJob* job) {
+    WaitForJob(job);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    std::vector<ThreadPoolJob*>::iterator it = std::find(mJobVec.begin(), mJobVec.end(), job);
+
+    if (it != mJobVec.end()) {
+        mJobVec.erase(it);
+    }
+
+    delete job;
+}
+
+void ThreadPool::RunParallel(irr::u32 nrTasks, std::function<void(irr::u32 taskIdx)> task) {
+    if (nrTasks == 0)
+        return;
+
+    //every thread takes the next task that is not taken yet,
+    //until no task is left
+    std::atomic<irr::u32> nextTaskIdx{0};
+
+    std::function<void()> work = [&nextTaskIdx, nrTasks, &task]() {
+        irr::u32 taskIdx;
+
+        while ((taskIdx = nextTaskIdx++) < nrTasks) {
+            task(taskIdx);
+        }
+    };
+
+    //the calling thread is one of the
+    //threads that works on the tasks
+    irr::u32 nrHelpers = std::min(nrTasks - 1, GetNrThreads());
+    std::vector<ThreadPoolJob*> helperVec;
+
+    for (irr::u32 idx = 0; idx < nrHelpers; idx++) {
+        helperVec.push_back(AddJob("RunParallel helper", work));
+    }
+
+    std::string errorMsg("");
+    bool failed = !ExecuteWork(work, errorMsg);
+
+    //all tasks are taken now; Helpers that were not started yet
+    //(because all workers are busy) are not needed anymore
+    std::vector<ThreadPoolJob*>::iterator it;
+
+    for (it = helperVec.begin(); it != helperVec.end(); ++it) {
+        bool canceled = CancelJob(*it);
+
+        WaitForJob(*it);
+
+        if (!canceled && !failed && ((*it)->state == DEF_THREADPOOL_JOB_FAILED)) {
+            failed = true;
+            errorMsg = (*it)->errorMsg;
+        }
+
+        ReleaseJob(*it);
+    }
+
+    if (failed) {
+        throw errorMsg;
+    }
+}
+
+irr::u32 ThreadPool::GetNrThreads() {
+    return (irr::u32)(mWorkerVec.size());
+}
+
+ThreadPoolJob* ThreadPool::FindReadyJob() {
+    std::vector<ThreadPoolJob*>::iterator itDep;
+    size_t idx = 0;
+
+    while (idx < mJobVec.size()) {
+        ThreadPoolJob* job = mJobVec[idx];
+        idx++;
+
+        if (job->state != DEF_THREADPOOL_JOB_WAITING)
+            continue;
+
+        bool ready = true;
+        ThreadPoolJob* failedDep = nullptr;
+
+        for (itDep = job->dependencies.begin(); itDep != job->dependencies.end(); ++itDep) {
+            if ((*itDep)->state == DEF_THREADPOOL_JOB_FAILED) {
+                failedDep = (*itDep);
+                break;
+            }
+
+            if ((*itDep)->state != DEF_THREADPOOL_JOB_DONE) {
+                ready = false;
+            }
+        }
+
+        if (failedDep != nullptr) {
+            //this job can never be started
+            job->errorMsg = "Required job '" + failedDep->description + "' failed: " + failedDep->errorMsg;
+            job->state = DEF_THREADPOOL_JOB_FAILED;
+            mJobFinishedCondition.notify_all();
+
+            //jobs in front of us could depend on this job, therefore
+            //we need to start the search again
+            idx = 0;
+            continue;
+        }
+
+        if (ready) {
+            return job;
+        }
+    }
+
+    return nullptr;
+}
+
+bool ThreadPool::ExecuteWork(const std::function<void()>& work, std::string& errorMsg) {
+    try {
+        work();
+    }
+    catch (const std::string &msg) {
+        errorMsg = msg;
+        return false;
+    }
+    catch (const char* msg) {
+        errorMsg = msg;
+        return false;
+    }
+    catch (const std::exception &e) {
+        errorMsg = e.what();
+        return false;
+    }
+    catch (...) {
+        errorMsg = "Unknown exception";
+        return false;
+    }
+
+    return true;
+}
+
+void ThreadPool::WorkerThread() {
+    std::unique_lock<std::mutex> lock(mMutex);
+
+    while (true) {
+        ThreadPoolJob* job = nullptr;
+
+        while (!mShutdown && ((job = FindReadyJob()) == nullptr)) {
+            mWakeUpCondition.wait(lock);
+        }
+
+        if (mShutdown)
+            return;
+
+        job->state = DEF_THREADPOOL_JOB_RUNNING;
+
+        //do the work without holding the lock
+        lock.unlock();
+
+        std::string errorMsg("");
+        bool failed = !ExecuteWork(job->work, errorMsg);
+
+        lock.lock();
+
+        job->errorMsg = errorMsg;
+        job->state = failed ? DEF_THREADPOOL_JOB_FAILED : DEF_THREADPOOL_JOB_DONE;
+
+        //other jobs could be ready to start now
+        mWakeUpCondition.notify_all();
+        mJobFinishedCondition.notify_all();
+    }
+}
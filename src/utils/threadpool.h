@@ -0,0 +1,111 @@
+/*
+ Copyright (C) 2026 Wolf Alexander
+
+ This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.                                          */
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include "irrlicht.h"
+#include <vector>
+#include <string>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+//states of a job
+#define DEF_THREADPOOL_JOB_WAITING 0
+#define DEF_THREADPOOL_JOB_RUNNING 1
+#define DEF_THREADPOOL_JOB_DONE 2
+#define DEF_THREADPOOL_JOB_FAILED 3
+
+//one unit of work for the thread pool
+struct ThreadPoolJob {
+    std::string description;
+    std::function<void()> work;
+
+    //the job is only started after all of these
+    //jobs are done; if one of them fails, this job
+    //fails as well without being started
+    std::vector<ThreadPoolJob*> dependencies;
+
+    std::atomic<irr::u8> state{DEF_THREADPOOL_JOB_WAITING};
+
+    //contains the error message if the job failed
+    //only valid after the job is finished
+    std::string errorMsg;
+};
+
+//Runs jobs on a fixed number of worker threads. Jobs can depend on other jobs,
+//the workers always pick the first job (in the order they were added) whose
+//dependencies are all done. Exceptions thrown by a job (the std::string error messages used
+//everywhere in this project) are caught and stored in the job, so that the thread
+//that owns the job can pass them on.
+//The pool owns all jobs, a job stays available until ReleaseJob is called for it
+class ThreadPool {
+public:
+    //nrThreads = 0 means one worker for each hardware thread of the machine
+    ThreadPool(irr::u32 nrThreads = 0);
+
+    //waits for all running jobs, jobs that were not started yet are dropped
+    ~ThreadPool();
+
+    ThreadPoolJob* AddJob(const std::string& description, std::function<void()> work,
+                          std::vector<ThreadPoolJob*> dependencies = {});
+
+    //returns true if the job is done or failed
+    bool IsJobFinished(ThreadPoolJob* job);
+
+    //blocks until the job is done or failed
+    void WaitForJob(ThreadPoolJob* job);
+
+    //if the job was not started yet it fails with the error message
+    //"canceled", a running job can not be canceled
+    //returns true if the job was canceled
+    bool CancelJob(ThreadPoolJob* job);
+
+    //waits for the job and deletes it afterwards; all jobs that
+    //depend on this job have to be finished already
+    void ReleaseJob(ThreadPoolJob* job);
+
+    //Executes task(0) up to task(nrTasks - 1) on the worker threads, and returns after all
+    //tasks are finished. The calling thread works on the tasks as well and only waits for tasks that
+    //are already running, so this can also be called from inside of a job, even when all other
+    //workers are busy. The error message of a failed task is thrown again in the calling thread
+    void RunParallel(irr::u32 nrTasks, std::function<void(irr::u32 taskIdx)> task);
+
+    irr::u32 GetNrThreads();
+
+private:
+    std::vector<std::thread> mWorkerVec;
+    std::vector<ThreadPoolJob*> mJobVec;
+
+    std::mutex mMutex;
+
+    //signaled when a new job was added, or a job finished
+    //(dependencies of other jobs could be fulfilled now)
+    std::condition_variable mWakeUpCondition;
+
+    //signaled when a job finished
+    std::condition_variable mJobFinishedCondition;
+
+    bool mShutdown = false;
+
+    void WorkerThread();
+
+    //executes work, and catches all exceptions
+    //returns false and the error message if an exception was thrown
+    static bool ExecuteWork(const std::function<void()>& work, std::string& errorMsg);
+
+    //needs to be called with mMutex locked
+    //returns nullptr if there is currently no job that can be started
+    ThreadPoolJob* FindReadyJob();
+};
+
+#endif // THREADPOOL_H
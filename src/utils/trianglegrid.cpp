@@ -0,0 +1,341 @@
+/*
+ Copyright (C) 2026 Wolf Alexander
+
+ This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.                                          */
+
+#include "trianglegrid.h"
+#include "../resources/levelcache.h"
+#include <cmath>
+
+//bytes per triangle and per cell in the level cache
+#define TRIANGLEGRID_CACHEDTRIANGLESIZE (9 * sizeof(uint32_t))
+#define TRIANGLEGRID_CACHEDCELLSIZE (8 * sizeof(uint32_t))
+
+//upper limit for the number of cells, only used to
+//reject invalid cache data
+#define TRIANGLEGRID_MAXCELLS (1024 * 1024)
+
+TriangleGrid::TriangleGrid() {
+}
+
+TriangleGrid::~TriangleGrid() {
+}
+
+void TriangleGrid::CleanUp() {
+    mTriangleVec.clear();
+    mCellVec.clear();
+
+    mNrCellsX = 0;
+    mNrCellsZ = 0;
+
+    mOriginX = 0.0f;
+    mOriginZ = 0.0f;
+
+    mMaxHalfSizeX = 0.0f;
+    mMaxHalfSizeZ = 0.0f;
+}
+
+irr::u32 TriangleGrid::GetTriangleCount() const {
+    return (irr::u32)(mTriangleVec.size());
+}
+
+irr::s32 TriangleGrid::GetCellCoord(irr::f32 coord, irr::f32 origin, irr::s32 nrCells) const {
+    irr::s32 cellCoord = (irr::s32)(floorf((coord - origin) / TRIANGLEGRID_CELLSIZE));
+
+    if (cellCoord < 0)
+        return 0;
+
+    if (cellCoord > nrCells - 1)
+        return (nrCells - 1);
+
+    return cellCoord;
+}
+
+bool TriangleGrid::GetCellRange(const irr::core::aabbox3df& box, irr::s32 &xMin, irr::s32 &zMin, irr::s32 &xMax, irr::s32 &zMax) const {
+    if (mCellVec.empty())
+        return false;
+
+    //a triangle touches box only if the center of its bounding box (and therefore its
+    //cell) is at most mMaxHalfSize away from box
+    irr::f32 minX = box.MinEdge.X - mMaxHalfSizeX;
+    irr::f32 maxX = box.MaxEdge.X + mMaxHalfSizeX;
+    irr::f32 minZ = box.MinEdge.Z - mMaxHalfSizeZ;
+    irr::f32 maxZ = box.MaxEdge.Z + mMaxHalfSizeZ;
+
+    //box completely outside of the grid?
+    if ((maxX < mOriginX) || (maxZ < mOriginZ) ||
+            (minX > mOriginX + mNrCellsX * TRIANGLEGRID_CELLSIZE) || (minZ > mOriginZ + mNrCellsZ * TRIANGLEGRID_CELLSIZE))
+        return false;
+
+    xMin = GetCellCoord(minX, mOriginX, mNrCellsX);
+    xMax = GetCellCoord(maxX, mOriginX, mNrCellsX);
+    zMin = GetCellCoord(minZ, mOriginZ, mNrCellsZ);
+    zMax = GetCellCoord(maxZ, mOriginZ, mNrCellsZ);
+
+    return true;
+}
+
+void TriangleGrid::Build(const std::vector<irr::core::triangle3df> &triangles) {
+    CleanUp();
+
+    if (triangles.empty())
+        return;
+
+    size_t nrTriangles = triangles.size();
+
+    //first find the grid size out of the
+    //triangle bounding box centers
+    std::vector<irr::core::vector3df> centerVec(nrTriangles);
+
+    irr::f32 maxX = 0.0f;
+    irr::f32 maxZ = 0.0f;
+
+    for (size_t idx = 0; idx < nrTriangles; idx++) {
+        irr::core::aabbox3df triBox = triangles[idx].getBoundingBox();
+        irr::core::vector3df halfSize = triBox.getExtent() * 0.5f;
+
+        centerVec[idx] = triBox.getCenter();
+
+        if (idx == 0) {
+            mOriginX = centerVec[idx].X;
+            mOriginZ = centerVec[idx].Z;
+            maxX = centerVec[idx].X;
+            maxZ = centerVec[idx].Z;
+        }
+
+        if (centerVec[idx].X < mOriginX) mOriginX = centerVec[idx].X;
+        if (centerVec[idx].Z < mOriginZ) mOriginZ = centerVec[idx].Z;
+        if (centerVec[idx].X > maxX) maxX = centerVec[idx].X;
+        if (centerVec[idx].Z > maxZ) maxZ = centerVec[idx].Z;
+
+        if (halfSize.X > mMaxHalfSizeX) mMaxHalfSizeX = halfSize.X;
+        if (halfSize.Z > mMaxHalfSizeZ) mMaxHalfSizeZ = halfSize.Z;
+    }
+
+    mNrCellsX = (irr::s32)(floorf((maxX - mOriginX) / TRIANGLEGRID_CELLSIZE)) + 1;
+    mNrCellsZ = (irr::s32)(floorf((maxZ - mOriginZ) / TRIANGLEGRID_CELLSIZE)) + 1;
+
+    mCellVec.resize(mNrCellsX * mNrCellsZ);
+
+    //count the triangles per cell
+    std::vector<irr::u32> cellIdxVec(nrTriangles);
+
+    for (size_t idx = 0; idx < nrTriangles; idx++) {
+        irr::s32 x = GetCellCoord(centerVec[idx].X, mOriginX, mNrCellsX);
+        irr::s32 z = GetCellCoord(centerVec[idx].Z, mOriginZ, mNrCellsZ);
+
+        cellIdxVec[idx] = (irr::u32)(z * mNrCellsX + x);
+        mCellVec[cellIdxVec[idx]].nrTriangles++;
+    }
+
+    //each cell gets its own range of
+    //the triangle array
+    irr::u32 firstIdx = 0;
+
+    std::vector<TriangleGridCellStruct>::iterator it;
+
+    for (it = mCellVec.begin(); it != mCellVec.end(); ++it) {
+        (*it).firstTriangleIdx = firstIdx;
+        firstIdx += (*it).nrTriangles;
+    }
+
+    //now copy the triangles to their cell, the order of the
+    //triangles inside of one cell stays the same
+    std::vector<irr::u32> nextIdxVec(mCellVec.size());
+
+    for (size_t cellIdx = 0; cellIdx < mCellVec.size(); cellIdx++) {
+        nextIdxVec[cellIdx] = mCellVec[cellIdx].firstTriangleIdx;
+    }
+
+    mTriangleVec.resize(nrTriangles);
+
+    for (size_t idx = 0; idx < nrTriangles; idx++) {
+        TriangleGridCellStruct& cell = mCellVec[cellIdxVec[idx]];
+
+        if (nextIdxVec[cellIdxVec[idx]] == cell.firstTriangleIdx) {
+            cell.box.reset(triangles[idx].pointA);
+        }
+
+        cell.box.addInternalPoint(triangles[idx].pointA);
+        cell.box.addInternalPoint(triangles[idx].pointB);
+        cell.box.addInternalPoint(triangles[idx].pointC);
+
+        mTriangleVec[nextIdxVec[cellIdxVec[idx]]] = triangles[idx];
+        nextIdxVec[cellIdxVec[idx]]++;
+    }
+}
+
+void TriangleGrid::AppendMeshTriangles(irr::scene::IMesh* mesh, std::vector<irr::core::triangle3df> &outTriangles) {
+    if (mesh == nullptr)
+        return;
+
+    irr::u32 nrMeshBuffers = mesh->getMeshBufferCount();
+
+    for (irr::u32 bufIdx = 0; bufIdx < nrMeshBuffers; bufIdx++) {
+        irr::scene::IMeshBuffer* meshBuf = mesh->getMeshBuffer(bufIdx);
+
+        //all level meshes use standard vertices
+        //and 16 bit indices
+        if ((meshBuf->getVertexType() != irr::video::EVT_STANDARD) || (meshBuf->getIndexType() != irr::video::EIT_16BIT))
+            continue;
+
+        const irr::video::S3DVertex* vertices = (const irr::video::S3DVertex*)(meshBuf->getVertices());
+        const irr::u16* indices = meshBuf->getIndices();
+        irr::u32 nrIndices = meshBuf->getIndexCount();
+
+        for (irr::u32 idx = 0; idx + 2 < nrIndices; idx += 3) {
+            outTriangles.push_back(irr::core::triangle3df(vertices[indices[idx]].Pos,
+                                                          vertices[indices[idx + 1]].Pos,
+                                                          vertices[indices[idx + 2]].Pos));
+        }
+    }
+}
+
+irr::u32 TriangleGrid::GetMeshTriangleCount(irr::scene::IMesh* mesh) {
+    if (mesh == nullptr)
+        return 0;
+
+    irr::u32 nrTriangles = 0;
+    irr::u32 nrMeshBuffers = mesh->getMeshBufferCount();
+
+    for (irr::u32 bufIdx = 0; bufIdx < nrMeshBuffers; bufIdx++) {
+        irr::scene::IMeshBuffer* meshBuf = mesh->getMeshBuffer(bufIdx);
+
+        if ((meshBuf->getVertexType() != irr::video::EVT_STANDARD) || (meshBuf->getIndexType() != irr::video::EIT_16BIT))
+            continue;
+
+        nrTriangles += meshBuf->getIndexCount() / 3;
+    }
+
+    return nrTriangles;
+}
+
+//Layout of a triangle grid inside a cache section:
+//  uint32 number of cells in X direction, uint32 number of cells in Z direction
+//  float origin X, float origin Z, float max half size X, float max half size Z
+//  uint32 number of triangles
+//  for each triangle: 3 points (3 floats each)
+//  for each cell: uint32 first triangle index, uint32 number of triangles, bounding box (6 floats)
+void TriangleGrid::AppendToCacheData(std::vector<uint8_t> &data) {
+    LevelCache::AppendUInt32(data, (uint32_t)(mNrCellsX));
+    LevelCache::AppendUInt32(data, (uint32_t)(mNrCellsZ));
+
+    LevelCache::AppendFloat(data, mOriginX);
+    LevelCache::AppendFloat(data, mOriginZ);
+    LevelCache::AppendFloat(data, mMaxHalfSizeX);
+    LevelCache::AppendFloat(data, mMaxHalfSizeZ);
+
+    LevelCache::AppendUInt32(data, (uint32_t)(mTriangleVec.size()));
+
+    data.reserve(data.size() + mTriangleVec.size() * TRIANGLEGRID_CACHEDTRIANGLESIZE +
+                 mCellVec.size() * TRIANGLEGRID_CACHEDCELLSIZE);
+
+    std::vector<irr::core::triangle3df>::iterator itTri;
+
+    for (itTri = mTriangleVec.begin(); itTri != mTriangleVec.end(); ++itTri) {
+        LevelCache::AppendFloat(data, (*itTri).pointA.X);
+        LevelCache::AppendFloat(data, (*itTri).pointA.Y);
+        LevelCache::AppendFloat(data, (*itTri).pointA.Z);
+        LevelCache::AppendFloat(data, (*itTri).pointB.X);
+        LevelCache::AppendFloat(data, (*itTri).pointB.Y);
+        LevelCache::AppendFloat(data, (*itTri).pointB.Z);
+        LevelCache::AppendFloat(data, (*itTri).pointC.X);
+        LevelCache::AppendFloat(data, (*itTri).pointC.Y);
+        LevelCache::AppendFloat(data, (*itTri).pointC.Z);
+    }
+
+    std::vector<TriangleGridCellStruct>::iterator itCell;
+
+    for (itCell = mCellVec.begin(); itCell != mCellVec.end(); ++itCell) {
+        LevelCache::AppendUInt32(data, (*itCell).firstTriangleIdx);
+        LevelCache::AppendUInt32(data, (*itCell).nrTriangles);
+
+        LevelCache::AppendFloat(data, (*itCell).box.MinEdge.X);
+        LevelCache::AppendFloat(data, (*itCell).box.MinEdge.Y);
+        LevelCache::AppendFloat(data, (*itCell).box.MinEdge.Z);
+        LevelCache::AppendFloat(data, (*itCell).box.MaxEdge.X);
+        LevelCache::AppendFloat(data, (*itCell).box.MaxEdge.Y);
+        LevelCache::AppendFloat(data, (*itCell).box.MaxEdge.Z);
+    }
+}
+
+bool TriangleGrid::ReadFromCacheData(const std::vector<uint8_t> &data, size_t &readIdx) {
+    CleanUp();
+
+    if (readIdx + 7 * sizeof(uint32_t) > data.size())
+        return false;
+
+    uint32_t nrCellsX = LevelCache::ReadUInt32(data, readIdx);
+    uint32_t nrCellsZ = LevelCache::ReadUInt32(data, readIdx);
+
+    irr::f32 originX = LevelCache::ReadFloat(data, readIdx);
+    irr::f32 originZ = LevelCache::ReadFloat(data, readIdx);
+    irr::f32 maxHalfSizeX = LevelCache::ReadFloat(data, readIdx);
+    irr::f32 maxHalfSizeZ = LevelCache::ReadFloat(data, readIdx);
+
+    uint32_t nrTriangles = LevelCache::ReadUInt32(data, readIdx);
+
+    //an empty grid has no cells, otherwise there
+    //is at least one cell
+    if ((nrCellsX > TRIANGLEGRID_MAXCELLS) || (nrCellsZ > TRIANGLEGRID_MAXCELLS) ||
+            ((uint64_t)(nrCellsX) * (uint64_t)(nrCellsZ) > TRIANGLEGRID_MAXCELLS) ||
+            ((nrTriangles == 0) != (nrCellsX * nrCellsZ == 0)))
+        return false;
+
+    size_t nrCells = (size_t)(nrCellsX) * (size_t)(nrCellsZ);
+
+    if (readIdx + (size_t)(nrTriangles) * TRIANGLEGRID_CACHEDTRIANGLESIZE + nrCells * TRIANGLEGRID_CACHEDCELLSIZE > data.size())
+        return false;
+
+    mTriangleVec.resize(nrTriangles);
+
+    for (uint32_t idx = 0; idx < nrTriangles; idx++) {
+        irr::core::triangle3df& tri = mTriangleVec[idx];
+
+        tri.pointA.X = LevelCache::ReadFloat(data, readIdx);
+        tri.pointA.Y = LevelCache::ReadFloat(data, readIdx);
+        tri.pointA.Z = LevelCache::ReadFloat(data, readIdx);
+        tri.pointB.X = LevelCache::ReadFloat(data, readIdx);
+        tri.pointB.Y = LevelCache::ReadFloat(data, readIdx);
+        tri.pointB.Z = LevelCache::ReadFloat(data, readIdx);
+        tri.pointC.X = LevelCache::ReadFloat(data, readIdx);
+        tri.pointC.Y = LevelCache::ReadFloat(data, readIdx);
+        tri.pointC.Z = LevelCache::ReadFloat(data, readIdx);
+    }
+
+    mCellVec.resize(nrCells);
+
+    for (size_t idx = 0; idx < nrCells; idx++) {
+        TriangleGridCellStruct& cell = mCellVec[idx];
+
+        cell.firstTriangleIdx = LevelCache::ReadUInt32(data, readIdx);
+        cell.nrTriangles = LevelCache::ReadUInt32(data, readIdx);
+
+        cell.box.MinEdge.X = LevelCache::ReadFloat(data, readIdx);
+        cell.box.MinEdge.Y = LevelCache::ReadFloat(data, readIdx);
+        cell.box.MinEdge.Z = LevelCache::ReadFloat(data, readIdx);
+        cell.box.MaxEdge.X = LevelCache::ReadFloat(data, readIdx);
+        cell.box.MaxEdge.Y = LevelCache::ReadFloat(data, readIdx);
+        cell.box.MaxEdge.Z = LevelCache::ReadFloat(data, readIdx);
+
+        if ((uint64_t)(cell.firstTriangleIdx) + (uint64_t)(cell.nrTriangles) > (uint64_t)(nrTriangles)) {
+            CleanUp();
+            return false;
+        }
+    }
+
+    mNrCellsX = (irr::s32)(nrCellsX);
+    mNrCellsZ = (irr::s32)(nrCellsZ);
+
+    mOriginX = originX;
+    mOriginZ = originZ;
+
+    mMaxHalfSizeX = maxHalfSizeX;
+    mMaxHalfSizeZ = maxHalfSizeZ;
+
+    return true;
+}
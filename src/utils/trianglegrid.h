@@ -0,0 +1,117 @@
+/*
+ Copyright (C) 2026 Wolf Alexander
+
+ This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.                                          */
+
+#ifndef TRIANGLEGRID_H
+#define TRIANGLEGRID_H
+
+#include "irrlicht.h"
+#include <vector>
+#include <cstdint>
+
+//size of one grid cell in X and Z direction
+//in mesh coordinates (a terrain tile has size 1)
+#define TRIANGLEGRID_CELLSIZE 4.0f
+
+struct TriangleGridCellStruct {
+    //the triangles of this cell are stored in mTriangleVec
+    //from firstTriangleIdx up to firstTriangleIdx + nrTriangles - 1
+    irr::u32 firstTriangleIdx;
+    irr::u32 nrTriangles;
+
+    //bounding box of all triangles
+    //of this cell
+    irr::core::aabbox3df box;
+};
+
+//Collision triangle set of a level mesh, sorted into a uniform grid of cells in the X/Z plane.
+//Each triangle is stored in the cell which contains the center of its bounding box. The grid
+//is only a plain array, therefore it can be stored in the level cache and restored without
+//building it again (unlike the Irrlicht octree triangle selector); Does not need the Irrlicht
+//device. TriangleGridSelector makes it available as Irrlicht triangle selector
+class TriangleGrid {
+public:
+    TriangleGrid();
+    ~TriangleGrid();
+
+    //sorts the specified triangles (in mesh coordinates) into the grid,
+    //replaces all triangles that were added before
+    void Build(const std::vector<irr::core::triangle3df> &triangles);
+
+    //appends the triangles of all meshbuffers of an Irrlicht mesh to outTriangles
+    static void AppendMeshTriangles(irr::scene::IMesh* mesh, std::vector<irr::core::triangle3df> &outTriangles);
+
+    //returns the number of triangles AppendMeshTriangles
+    //would append for an Irrlicht mesh
+    static irr::u32 GetMeshTriangleCount(irr::scene::IMesh* mesh);
+
+    //serialization for the level cache; ReadFromCacheData returns false if the
+    //data is invalid, the grid is empty afterwards in this case
+    void AppendToCacheData(std::vector<uint8_t> &data);
+    bool ReadFromCacheData(const std::vector<uint8_t> &data, size_t &readIdx);
+
+    irr::u32 GetTriangleCount() const;
+
+    //calls triangleFunc(const triangle3df& triangle) for each triangle that is not completely
+    //outside of box (same test as the Irrlicht octree triangle selector does), stops as soon
+    //as triangleFunc returns false
+    template <typename TriangleFunc>
+    void ForEachTriangleInBox(const irr::core::aabbox3df& box, TriangleFunc triangleFunc) const {
+        irr::s32 xMin, zMin, xMax, zMax;
+
+        if (!GetCellRange(box, xMin, zMin, xMax, zMax))
+            return;
+
+        for (irr::s32 z = zMin; z <= zMax; z++) {
+            for (irr::s32 x = xMin; x <= xMax; x++) {
+                const TriangleGridCellStruct& cell = mCellVec[z * mNrCellsX + x];
+
+                if ((cell.nrTriangles == 0) || !box.intersectsWithBox(cell.box))
+                    continue;
+
+                irr::u32 lastIdx = cell.firstTriangleIdx + cell.nrTriangles;
+
+                for (irr::u32 idx = cell.firstTriangleIdx; idx < lastIdx; idx++) {
+                    if (mTriangleVec[idx].isTotalOutsideBox(box))
+                        continue;
+
+                    if (!triangleFunc(mTriangleVec[idx]))
+                        return;
+                }
+            }
+        }
+    }
+
+    //all triangles, sorted by cell
+    std::vector<irr::core::triangle3df> mTriangleVec;
+
+private:
+    std::vector<TriangleGridCellStruct> mCellVec;
+
+    irr::s32 mNrCellsX = 0;
+    irr::s32 mNrCellsZ = 0;
+
+    //mesh coordinate of the corner of cell 0
+    irr::f32 mOriginX = 0.0f;
+    irr::f32 mOriginZ = 0.0f;
+
+    //the largest half size of all triangle bounding boxes in X and Z
+    //direction; a triangle can reach up to this distance out of its cell
+    irr::f32 mMaxHalfSizeX = 0.0f;
+    irr::f32 mMaxHalfSizeZ = 0.0f;
+
+    irr::s32 GetCellCoord(irr::f32 coord, irr::f32 origin, irr::s32 nrCells) const;
+
+    //returns the range of cells which can contain triangles that touch box,
+    //returns false if there is no such cell
+    bool GetCellRange(const irr::core::aabbox3df& box, irr::s32 &xMin, irr::s32 &zMin, irr::s32 &xMax, irr::s32 &zMax) const;
+
+    void CleanUp();
+};
+
+#endif // TRIANGLEGRID_H
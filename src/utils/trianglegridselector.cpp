@@ -0,0 +1,117 @@
+/*
+ Copyright (C) 2026 Wolf Alexander
+
+ This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.                                          */
+
+#include "trianglegridselector.h"
+#include "trianglegrid.h"
+
+TriangleGridSelector::TriangleGridSelector(TriangleGrid* grid, irr::scene::ISceneNode* node) {
+    mGrid = grid;
+    mSceneNode = node;
+}
+
+TriangleGridSelector::~TriangleGridSelector() {
+    delete mGrid;
+}
+
+irr::core::matrix4 TriangleGridSelector::GetTransformation(const irr::core::matrix4* transform) const {
+    irr::core::matrix4 mat;
+
+    if (transform != nullptr)
+        mat = *transform;
+
+    if (mSceneNode != nullptr)
+        mat *= mSceneNode->getAbsoluteTransformation();
+
+    return mat;
+}
+
+irr::s32 TriangleGridSelector::getTriangleCount() const {
+    return (irr::s32)(mGrid->GetTriangleCount());
+}
+
+void TriangleGridSelector::getTriangles(irr::core::triangle3df* triangles, irr::s32 arraySize, irr::s32& outTriangleCount,
+                                        const irr::core::matrix4* transform) const {
+    irr::core::matrix4 mat = GetTransformation(transform);
+
+    irr::s32 cnt = (irr::s32)(mGrid->mTriangleVec.size());
+    if (cnt > arraySize)
+        cnt = arraySize;
+
+    for (irr::s32 idx = 0; idx < cnt; idx++) {
+        mat.transformVect(triangles[idx].pointA, mGrid->mTriangleVec[idx].pointA);
+        mat.transformVect(triangles[idx].pointB, mGrid->mTriangleVec[idx].pointB);
+        mat.transformVect(triangles[idx].pointC, mGrid->mTriangleVec[idx].pointC);
+    }
+
+    outTriangleCount = cnt;
+}
+
+void TriangleGridSelector::getTriangles(irr::core::triangle3df* triangles, irr::s32 arraySize, irr::s32& outTriangleCount,
+                                        const irr::core::aabbox3d<irr::f32>& box, const irr::core::matrix4* transform) const {
+    //the box is in world coordinates, the grid
+    //triangles are in mesh coordinates
+    irr::core::aabbox3df meshBox(box);
+
+    if (mSceneNode != nullptr) {
+        irr::core::matrix4 invMat;
+        mSceneNode->getAbsoluteTransformation().getInverse(invMat);
+        invMat.transformBoxEx(meshBox);
+    }
+
+    irr::core::matrix4 mat = GetTransformation(transform);
+
+    irr::s32 cnt = 0;
+
+    if (arraySize > 0) {
+        mGrid->ForEachTriangleInBox(meshBox, [&](const irr::core::triangle3df& triangle) {
+            mat.transformVect(triangles[cnt].pointA, triangle.pointA);
+            mat.transformVect(triangles[cnt].pointB, triangle.pointB);
+            mat.transformVect(triangles[cnt].pointC, triangle.pointC);
+
+            cnt++;
+
+            //stop if the output array is full
+            return (cnt < arraySize);
+        });
+    }
+
+    outTriangleCount = cnt;
+}
+
+void TriangleGridSelector::getTriangles(irr::core::triangle3df* triangles, irr::s32 arraySize, irr::s32& outTriangleCount,
+                                        const irr::core::line3d<irr::f32>& line, const irr::core::matrix4* transform) const {
+    //same as the Irrlicht octree triangle selector, return
+    //all triangles inside of the bounding box of the line
+    irr::core::aabbox3df box(line.start);
+    box.addInternalPoint(line.end);
+
+    getTriangles(triangles, arraySize, outTriangleCount, box, transform);
+}
+
+irr::scene::ISceneNode* TriangleGridSelector::getSceneNodeForTriangle(irr::u32 triangleIndex) const {
+    return mSceneNode;
+}
+
+irr::u32 TriangleGridSelector::getSelectorCount() const {
+    return 1;
+}
+
+irr::scene::ITriangleSelector* TriangleGridSelector::getSelector(irr::u32 index) {
+    if (index >= 1)
+        return nullptr;
+
+    return this;
+}
+
+const irr::scene::ITriangleSelector* TriangleGridSelector::getSelector(irr::u32 index) const {
+    if (index >= 1)
+        return nullptr;
+
+    return this;
+}
@@ -0,0 +1,55 @@
+/*
+ Copyright (C) 2026 Wolf Alexander
+
+ This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.                                          */
+
+#ifndef TRIANGLEGRIDSELECTOR_H
+#define TRIANGLEGRIDSELECTOR_H
+
+#include "irrlicht.h"
+
+/************************
+ * Forward declarations *
+ ************************/
+
+class TriangleGrid;
+
+//Irrlicht triangle selector for the triangles of a TriangleGrid, returns the same triangles
+//as the octree triangle selector Irrlicht creates for the same mesh and scene node, but
+//does not need to build the octree first. The selector takes ownership of the grid
+class TriangleGridSelector : public irr::scene::ITriangleSelector {
+public:
+    TriangleGridSelector(TriangleGrid* grid, irr::scene::ISceneNode* node);
+    virtual ~TriangleGridSelector();
+
+    virtual irr::s32 getTriangleCount() const;
+
+    virtual void getTriangles(irr::core::triangle3df* triangles, irr::s32 arraySize, irr::s32& outTriangleCount,
+                              const irr::core::matrix4* transform = 0) const;
+
+    virtual void getTriangles(irr::core::triangle3df* triangles, irr::s32 arraySize, irr::s32& outTriangleCount,
+                              const irr::core::aabbox3d<irr::f32>& box, const irr::core::matrix4* transform = 0) const;
+
+    virtual void getTriangles(irr::core::triangle3df* triangles, irr::s32 arraySize, irr::s32& outTriangleCount,
+                              const irr::core::line3d<irr::f32>& line, const irr::core::matrix4* transform = 0) const;
+
+    virtual irr::scene::ISceneNode* getSceneNodeForTriangle(irr::u32 triangleIndex) const;
+
+    virtual irr::u32 getSelectorCount() const;
+    virtual irr::scene::ITriangleSelector* getSelector(irr::u32 index);
+    virtual const irr::scene::ITriangleSelector* getSelector(irr::u32 index) const;
+
+private:
+    TriangleGrid* mGrid = nullptr;
+    irr::scene::ISceneNode* mSceneNode = nullptr;
+
+    //returns the transformation from mesh coordinates
+    //into the coordinates the caller wants
+    irr::core::matrix4 GetTransformation(const irr::core::matrix4* transform) const;
+};
+
+#endif // TRIANGLEGRIDSELECTOR_H
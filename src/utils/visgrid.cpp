@@ -0,0 +1,284 @@
+/*
+ Copyright (C) 2026 Wolf Alexander
+
+ This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.                                          */
+
+#include "visgrid.h"
+#include <algorithm>
+#include <cmath>
+
+VisibilityGrid::VisibilityGrid(irr::core::aabbox3df worldArea, irr::f32 cellSize) {
+    mWorldArea = worldArea;
+    mCellSize = cellSize;
+
+    irr::core::vector3df extent = mWorldArea.getExtent();
+
+    mNrCellsX = (irr::s32)(ceilf(extent.X / mCellSize));
+    mNrCellsZ = (irr::s32)(ceilf(extent.Z / mCellSize));
+
+    if (mNrCellsX < 1)
+        mNrCellsX = 1;
+
+    if (mNrCellsZ < 1)
+        mNrCellsZ = 1;
+
+    mCellVec.resize(mNrCellsX * mNrCellsZ);
+}
+
+VisibilityGrid::~VisibilityGrid() {
+    //make sure no scene node stays hidden
+    RestoreCulledSceneNodes();
+
+    std::vector<VisGridEntryStruct*>::iterator it;
+
+    for (it = mEntryVec.begin(); it != mEntryVec.end(); ++it) {
+        delete (*it);
+    }
+
+    mEntryVec.clear();
+    mCellVec.clear();
+}
+
+irr::s32 VisibilityGrid::GetCellIdx(const irr::core::aabbox3df& box) {
+    irr::core::vector3df center = box.getCenter();
+
+    irr::s32 cellX = (irr::s32)(floorf((center.X - mWorldArea.MinEdge.X) / mCellSize));
+    irr::s32 cellZ = (irr::s32)(floorf((center.Z - mWorldArea.MinEdge.Z) / mCellSize));
+
+    cellX = irr::core::clamp(cellX, 0, mNrCellsX - 1);
+    cellZ = irr::core::clamp(cellZ, 0, mNrCellsZ - 1);
+
+    return (cellZ * mNrCellsX + cellX);
+}
+
+void VisibilityGrid::AddEntryToCell(VisGridEntryStruct* entry, irr::s32 cellIdx) {
+    VisGridCellStruct& cell = mCellVec[cellIdx];
+
+    if (cell.entries.size() == 0) {
+        cell.box = entry->box;
+        mUsedCellVec.push_back(cellIdx);
+    } else {
+        cell.box.addInternalBox(entry->box);
+    }
+
+    cell.entries.push_back(entry);
+    entry->cellIdx = cellIdx;
+}
+
+void VisibilityGrid::RemoveEntryFromCell(VisGridEntryStruct* entry) {
+    if (entry->cellIdx < 0)
+        return;
+
+    VisGridCellStruct& cell = mCellVec[entry->cellIdx];
+
+    std::vector<VisGridEntryStruct*>::iterator it = std::find(cell.entries.begin(), cell.entries.end(), entry);
+
+    if (it != cell.entries.end()) {
+        cell.entries.erase(it);
+    }
+
+    if (cell.entries.size() == 0) {
+        std::vector<irr::s32>::iterator itUsed = std::find(mUsedCellVec.begin(), mUsedCellVec.end(), entry->cellIdx);
+
+        if (itUsed != mUsedCellVec.end()) {
+            mUsedCellVec.erase(itUsed);
+        }
+    } else {
+        RecalculateCellBox(entry->cellIdx);
+    }
+
+    entry->cellIdx = -1;
+}
+
+void VisibilityGrid::RecalculateCellBox(irr::s32 cellIdx) {
+    VisGridCellStruct& cell = mCellVec[cellIdx];
+
+    if (cell.entries.size() == 0)
+        return;
+
+    std::vector<VisGridEntryStruct*>::iterator it = cell.entries.begin();
+    cell.box = (*it)->box;
+
+    for (++it; it != cell.entries.end(); ++it) {
+        cell.box.addInternalBox((*it)->box);
+    }
+}
+
+VisGridEntryStruct* VisibilityGrid::AddEntity(irr::core::aabbox3df box, irr::scene::ISceneNode* node) {
+    VisGridEntryStruct* newEntry = new VisGridEntryStruct();
+    newEntry->box = box;
+    newEntry->node = node;
+
+    AddEntryToCell(newEntry, GetCellIdx(box));
+
+    mEntryVec.push_back(newEntry);
+
+    return newEntry;
+}
+
+void VisibilityGrid::RemoveEntity(VisGridEntryStruct* entry) {
+    if (entry == nullptr)
+        return;
+
+    //if we hid the scene node in this frame, forget it
+    if (entry->node != nullptr) {
+        std::vector<irr::scene::ISceneNode*>::iterator itNode =
+                std::find(mCulledSceneNodeVec.begin(), mCulledSceneNodeVec.end(), entry->node);
+
+        if (itNode != mCulledSceneNodeVec.end()) {
+            (*itNode)->setVisible(true);
+            mCulledSceneNodeVec.erase(itNode);
+        }
+    }
+
+    RemoveEntryFromCell(entry);
+
+    std::vector<VisGridEntryStruct*>::iterator it = std::find(mEntryVec.begin(), mEntryVec.end(), entry);
+
+    if (it != mEntryVec.end()) {
+        mEntryVec.erase(it);
+    }
+
+    delete entry;
+}
+
+void VisibilityGrid::UpdateEntity(VisGridEntryStruct* entry, irr::core::aabbox3df newBox) {
+    if (entry == nullptr)
+        return;
+
+    entry->box = newBox;
+
+    irr::s32 newCellIdx = GetCellIdx(newBox);
+
+    if (newCellIdx != entry->cellIdx) {
+        RemoveEntryFromCell(entry);
+        AddEntryToCell(entry, newCellIdx);
+    } else {
+        RecalculateCellBox(newCellIdx);
+    }
+}
+
+//Irrlicht frustum plane normals point out of the frustum, therefore
+//a box is outside if even its corner that is furthest against the
+//plane normal is still in front of the plane
+irr::u8 VisibilityGrid::ClassifyBox(const irr::core::aabbox3df& box, const irr::scene::SViewFrustum& frustum) {
+    irr::u8 result = DEF_VISGRID_INSIDE;
+
+    for (irr::u32 i = 0; i < irr::scene::SViewFrustum::VF_PLANE_COUNT; i++) {
+        const irr::core::plane3df& plane = frustum.planes[i];
+
+        irr::core::vector3df nearCorner(
+                    (plane.Normal.X > 0.0f) ? box.MinEdge.X : box.MaxEdge.X,
+                    (plane.Normal.Y > 0.0f) ? box.MinEdge.Y : box.MaxEdge.Y,
+                    (plane.Normal.Z > 0.0f) ? box.MinEdge.Z : box.MaxEdge.Z);
+
+        if (plane.getDistanceTo(nearCorner) > 0.0f) {
+            return DEF_VISGRID_OUTSIDE;
+        }
+
+        irr::core::vector3df farCorner(
+                    (plane.Normal.X > 0.0f) ? box.MaxEdge.X : box.MinEdge.X,
+                    (plane.Normal.Y > 0.0f) ? box.MaxEdge.Y : box.MinEdge.Y,
+                    (plane.Normal.Z > 0.0f) ? box.MaxEdge.Z : box.MinEdge.Z);
+
+        if (plane.getDistanceTo(farCorner) > 0.0f) {
+            result = DEF_VISGRID_INTERSECT;
+        }
+    }
+
+    return result;
+}
+
+void VisibilityGrid::SetEntryInView(VisGridEntryStruct* entry, bool inView) {
+    entry->inView = inView;
+
+    if (inView || (entry->node == nullptr))
+        return;
+
+    //only hide nodes that are currently visible, nodes that are
+    //hidden by the game logic (picked up collectables...) must stay hidden
+    if (entry->node->isVisible()) {
+        entry->node->setVisible(false);
+        mCulledSceneNodeVec.push_back(entry->node);
+        mNrCulledLastFrame++;
+    }
+}
+
+void VisibilityGrid::Cull(const irr::scene::SViewFrustum& frustum) {
+    mNrCellsTestedLastFrame = 0;
+    mNrCellsInViewLastFrame = 0;
+    mNrCulledLastFrame = 0;
+
+    if (!mEnabled)
+        return;
+
+    std::vector<irr::s32>::iterator itCell;
+    std::vector<VisGridEntryStruct*>::iterator itEntry;
+
+    for (itCell = mUsedCellVec.begin(); itCell != mUsedCellVec.end(); ++itCell) {
+        VisGridCellStruct& cell = mCellVec[(*itCell)];
+
+        mNrCellsTestedLastFrame++;
+
+        irr::u8 cellResult = ClassifyBox(cell.box, frustum);
+
+        if (cellResult != DEF_VISGRID_OUTSIDE) {
+            mNrCellsInViewLastFrame++;
+        }
+
+        for (itEntry = cell.entries.begin(); itEntry != cell.entries.end(); ++itEntry) {
+            bool inView;
+
+            if (cellResult == DEF_VISGRID_INTERSECT) {
+                //only part of the cell is visible, we need to test this entity
+                inView = (ClassifyBox((*itEntry)->box, frustum) != DEF_VISGRID_OUTSIDE);
+            } else {
+                //the whole cell is inside or outside
+                inView = (cellResult == DEF_VISGRID_INSIDE);
+            }
+
+            SetEntryInView((*itEntry), inView);
+        }
+    }
+}
+
+void VisibilityGrid::RestoreCulledSceneNodes() {
+    std::vector<irr::scene::ISceneNode*>::iterator it;
+
+    for (it = mCulledSceneNodeVec.begin(); it != mCulledSceneNodeVec.end(); ++it) {
+        (*it)->setVisible(true);
+    }
+
+    mCulledSceneNodeVec.clear();
+}
+
+void VisibilityGrid::SetEnabled(bool enabled) {
+    mEnabled = enabled;
+
+    if (!mEnabled) {
+        RestoreCulledSceneNodes();
+
+        //without culling everything is in view
+        std::vector<VisGridEntryStruct*>::iterator it;
+
+        for (it = mEntryVec.begin(); it != mEntryVec.end(); ++it) {
+            (*it)->inView = true;
+        }
+    }
+}
+
+bool VisibilityGrid::IsEnabled() {
+    return mEnabled;
+}
+
+irr::u32 VisibilityGrid::GetNrCells() {
+    return (irr::u32)(mCellVec.size());
+}
+
+irr::u32 VisibilityGrid::GetNrEntities() {
+    return (irr::u32)(mEntryVec.size());
+}
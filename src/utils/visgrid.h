@@ -0,0 +1,126 @@
+/*
+ Copyright (C) 2026 Wolf Alexander
+
+ This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.                                          */
+
+#ifndef VISGRID_H
+#define VISGRID_H
+
+#include "irrlicht.h"
+#include <vector>
+
+//size of one grid cell in X and Z direction
+//in world units; One terrain tile is 1 unit wide
+#define DEF_VISGRID_CELLSIZE 16.0f
+
+//results of a box versus view frustum test
+#define DEF_VISGRID_OUTSIDE 0
+#define DEF_VISGRID_INSIDE 1
+#define DEF_VISGRID_INTERSECT 2
+
+//one renderable entity inside the grid
+struct VisGridEntryStruct {
+    //world space bounding box of the entity
+    irr::core::aabbox3df box;
+
+    //scene node of the entity, can be nullptr for entities
+    //that do not have an own scene node (for example steam fountains)
+    //then the grid only keeps track of inView
+    irr::scene::ISceneNode* node = nullptr;
+
+    //index of the cell the entity is currently stored in
+    irr::s32 cellIdx = -1;
+
+    //result of the last Cull call, entities outside of the view can
+    //skip their per frame update work (animation, particles...)
+    bool inView = true;
+};
+
+struct VisGridCellStruct {
+    //bounding box of all entities in this cell; Is not the
+    //area of the cell itself, because entities can be bigger than
+    //the cell, and empty space of the cell must not be tested
+    irr::core::aabbox3df box;
+
+    std::vector<VisGridEntryStruct*> entries;
+};
+
+//Sorts renderable race entities (collectables, cones, steam fountains...) into a
+//uniform grid over the XZ plane of the level; Each frame the grid cells are tested against
+//the camera view frustum, and all entities of cells that are outside are marked as not in view,
+//and their scene nodes are hidden at once. Only entities inside of cells that intersect the frustum
+//border are tested individually. Hidden scene nodes are remembered, and made visible again with
+//RestoreCulledSceneNodes (same as for the OcclusionCulling)
+class VisibilityGrid {
+public:
+    //worldArea is the area that is covered by the grid, entities outside
+    //of this area are stored in the closest border cell
+    VisibilityGrid(irr::core::aabbox3df worldArea, irr::f32 cellSize = DEF_VISGRID_CELLSIZE);
+    ~VisibilityGrid();
+
+    //Adds a new entity with the specified world bounding box, returns the new grid entry
+    //node can be nullptr; The entry is owned by the grid
+    VisGridEntryStruct* AddEntity(irr::core::aabbox3df box, irr::scene::ISceneNode* node);
+
+    //Removes the entity from the grid, entry is deleted
+    void RemoveEntity(VisGridEntryStruct* entry);
+
+    //needs to be called for entities that move, moves the
+    //entry into the correct cell if necessary
+    void UpdateEntity(VisGridEntryStruct* entry, irr::core::aabbox3df newBox);
+
+    //Tests all grid cells against the view frustum, updates inView of all entries,
+    //and hides all scene nodes that are currently visible but outside of the view
+    void Cull(const irr::scene::SViewFrustum& frustum);
+
+    //needs to be called after the scene was rendered
+    void RestoreCulledSceneNodes();
+
+    //if disabled all entities are always in view
+    void SetEnabled(bool enabled);
+    bool IsEnabled();
+
+    irr::u32 GetNrCells();
+    irr::u32 GetNrEntities();
+
+    //statistics of the last frame
+    irr::u32 mNrCellsTestedLastFrame = 0;
+    irr::u32 mNrCellsInViewLastFrame = 0;
+    irr::u32 mNrCulledLastFrame = 0;
+
+private:
+    bool mEnabled = true;
+
+    irr::core::aabbox3df mWorldArea;
+    irr::f32 mCellSize;
+
+    irr::s32 mNrCellsX;
+    irr::s32 mNrCellsZ;
+
+    std::vector<VisGridCellStruct> mCellVec;
+    std::vector<VisGridEntryStruct*> mEntryVec;
+
+    //indices of all cells that contain at least one entity
+    //only these cells need to be tested during culling
+    std::vector<irr::s32> mUsedCellVec;
+
+    //scene nodes hidden by us in the current frame
+    std::vector<irr::scene::ISceneNode*> mCulledSceneNodeVec;
+
+    //returns the cell index for the center of the box
+    irr::s32 GetCellIdx(const irr::core::aabbox3df& box);
+
+    void AddEntryToCell(VisGridEntryStruct* entry, irr::s32 cellIdx);
+    void RemoveEntryFromCell(VisGridEntryStruct* entry);
+    void RecalculateCellBox(irr::s32 cellIdx);
+
+    irr::u8 ClassifyBox(const irr::core::aabbox3df& box, const irr::scene::SViewFrustum& frustum);
+
+    void SetEntryInView(VisGridEntryStruct* entry, bool inView);
+};
+
+#endif // VISGRID_H
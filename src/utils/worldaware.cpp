@@ -87,267 +87,17 @@
 #include "../resources/columndefinition.h"
 #include "../resources/mapentry.h"
 
-//returns true if a track end was identified
-bool WorldAwareness::FindTrackEndAlongCastRay(std::vector<irr::core::vector2di> cells,
-                                              irr::core::vector3df rayStartPoint3D, irr::f32 &distanceToEnd) {
-
-    irr::s16 nrCells;
-    bool isRoadTexture;
-    MapEntry* mapEntry;
-    irr::core::vector3df endRoadTextureID3DPos;
-
-    nrCells = (irr::s16)(cells.size());
-
-    for (irr::s16 cellIdx = 0; cellIdx < nrCells; cellIdx++) {
-        mapEntry = this->mRace->mLevelTerrain->GetMapEntry(cells.at(cellIdx).X, cells.at(cellIdx).Y);
-
-        //you must enable extended texture IDs here, to make it work correctly
-        isRoadTexture = this->mRace->mLevelTerrain->IsRoadTexture(mapEntry->m_TextureId, true);
-
-        if (!isRoadTexture) {
-            endRoadTextureID3DPos.X = -cells.at(cellIdx).X * DEF_SEGMENTSIZE;
-            endRoadTextureID3DPos.Y = rayStartPoint3D.Y; //just take Y the same as of starting point, so that
-                                                         //Y coordinate does not affect the calculated length
-            endRoadTextureID3DPos.Z = cells.at(cellIdx).Y * DEF_SEGMENTSIZE;
-
-            distanceToEnd = (endRoadTextureID3DPos - rayStartPoint3D).getLength();
-
-            break;
-        }
-    }
-
-    //no road end found
-    return false;
-}
-
 void WorldAwareness::PreAnalyzeWaypointLinksOffsetRange() {
     if (mRace->wayPointLinkVec ->size() <= 0)
         return;
 
-    std::vector<WayPointLinkInfoStruct*>::iterator it;
-
-    //because CastRayDDA we will reuse here also looks at the dynamic map (which we do not want)
-    //first fill dynamic world map with all zeros
-    //to remove all existing player locations
-    //so dynamic map is empty and does not interfere when casting the ray
-    std::fill(mDynamicWorldMap->begin(), mDynamicWorldMap->end(), 0);
-
-    irr::f32 distStartEntity = FLT_MAX;
-    irr::f32 distEndEntity = FLT_MAX;
-    RayHitInfoStruct rayInfo;
-    irr::core::vector3df coord3D;
-    std::vector<irr::core::vector2di> cells;
-    irr::f32 minVal;
-    //irr::f32 testOffset;
-    irr::f32 resolution = 0.2f;
-
-    irr::f32 distStartEntityTextureId = FLT_MAX;
-    irr::f32 distEndEntityTextureId = FLT_MAX;
-
-    //process one waypoint link after each other
-    for (it = mRace->wayPointLinkVec->begin(); it != mRace->wayPointLinkVec->end(); ++it) {
-        //use world aware to shoot one 2D ray from start entity towards right side
-        //to see how far we can go until we hit a terrain/block obstacle
-        coord3D = (*it)->pLineStruct->A;
-
-        cells.clear();
-        rayInfo = this->CastRayDDA(*dynamicWorld, coord3D, (*it)->offsetDirVec, 1000.0f, cells);
-        if (rayInfo.HitType == RAY_HIT_TERRAIN) {
-            distStartEntity = rayInfo.HitDistance;
-        }
-
-        //at some map locations from the original game (for example level 3, shortly after the race finish line on the right side) there
-        //are the wallsegments missing towards the lower areas). This means at this location we need another solution again to be able
-        //to properly detect the road there, and the area where we can move freely as a computer player
-        //As a solution I decided to use the CastRayDDA visited cells from the last function call, revisit all of this cells, and check when we
-        //leave the valid textureID range of "roads" in the game
-        //This should help for this locations
-        FindTrackEndAlongCastRay(cells, coord3D, distStartEntityTextureId);
-
-        //do the same from the end entity
-        coord3D = (*it)->pLineStruct->B;
-
-        cells.clear();
-        rayInfo = this->CastRayDDA(*dynamicWorld, coord3D, (*it)->offsetDirVec, 1000.0f, cells);
-        if (rayInfo.HitType == RAY_HIT_TERRAIN) {
-            distEndEntity = rayInfo.HitDistance;
-        }
-
-        FindTrackEndAlongCastRay(cells, coord3D, distEndEntityTextureId);
-
-        //which is the minimum of the results?
-        minVal = distStartEntity;
-        //minVal = FLT_MAX;
-
-        if (distStartEntityTextureId < minVal) {
-            minVal = distStartEntityTextureId;
-        }
-
-        minVal -= WA_CP_PLAYER_NAVIGATIONAREASAFETYDISTANCE;
-        if (minVal < 0.0f)
-            minVal = 0.0f;
-
-        (*it)->maxOffsetShiftStart = minVal;
-
-        minVal = distEndEntity;
-        //minVal = FLT_MAX;
-
-        /*if (distEndEntity < minVal) {
-            minVal = distEndEntity;
-        }*/
-
-        if (distEndEntityTextureId < minVal) {
-            minVal = distEndEntityTextureId;
-        }
-
-        minVal -= WA_CP_PLAYER_NAVIGATIONAREASAFETYDISTANCE;
-        if (minVal < 0.0f)
-            minVal = 0.0f;
-
-        (*it)->maxOffsetShiftEnd = minVal;
-
-        //now check if there is any obstacle from the side pointing towards the waypoint link
-        //we can find out by shooting rays in parallel to the original waypoint link, but with
-        //changing positive offset shifts (in steps)
-        //for each iteration we determine after which distance we hit something
-        //if we hit something in a distance less then the original length of the waypoint link, then
-        //hit hit an obstacle on the way
-      /*  testOffset = resolution;
-
-        coord3D = (*it)->pLineStruct->A;
-        bool hitEnd = false;
-
-        while ((testOffset < minVal) && (!hitEnd)) {
-            rayInfo = this->CastRayDDA(*dynamicWorld, coord3D + testOffset * (*it)->offsetDirVec,
-                                       (*it)->LinkDirectionVec, 1000.0f, cells);
-
-            if (rayInfo.HitType == RAY_HIT_TERRAIN) {
-                //ray hit distance significantly shorter then original waypoint link
-                //distance
-                if (rayInfo.HitDistance < (0.9 * (*it)->length3D)) {
-                    //we seem to have hit an obstacle on the way -> we can not
-                    //go further to the right
-                    hitEnd = true;
-                }
-            }
-
-            if (!hitEnd) {
-                testOffset += resolution;
-            }
-        }
-
-        //if we found an additional obstacle from the side
-        //and its making the available space smaller, then
-        //make it the new limitiation
-        if (hitEnd && (testOffset < minVal)) {
-            minVal = testOffset;
-        }
-
-        //minVal has now the minimum we found inside
-        (*it)->maxOffsetShift = minVal;*/
-
-        //*************************************************************/
-        /* repeat everything, but this time for direction to the left */
-        /* use world aware to shoot one 2D ray from start entity      */
-        /* towards right side to see how far we can go                */
-        /**************************************************************/
-
-        coord3D = (*it)->pLineStruct->A;
-
-        cells.clear();
-        rayInfo = this->CastRayDDA(*dynamicWorld, coord3D, -(*it)->offsetDirVec, 1000.0f, cells);
-        if (rayInfo.HitType == RAY_HIT_TERRAIN) {
-            distStartEntity = rayInfo.HitDistance;
-        }
-
-        FindTrackEndAlongCastRay(cells, coord3D, distStartEntityTextureId);
-
-        //do the same from the end entity
-        coord3D = (*it)->pLineStruct->B;
-
-        cells.clear();
-        rayInfo = this->CastRayDDA(*dynamicWorld, coord3D, -(*it)->offsetDirVec, 1000.0f, cells);
-        if (rayInfo.HitType == RAY_HIT_TERRAIN) {
-            distEndEntity = rayInfo.HitDistance;
-        }
-
-        FindTrackEndAlongCastRay(cells, coord3D, distEndEntityTextureId);
-
-        //which is the minimum of the results?
-        minVal = distStartEntity;
-        //  minVal = FLT_MAX;
-
-        if (distStartEntityTextureId < minVal) {
-            minVal = distStartEntityTextureId;
-        }
-
-        minVal -= WA_CP_PLAYER_NAVIGATIONAREASAFETYDISTANCE;
-        if (minVal < 0.0f)
-            minVal = 0.0f;
-
-        (*it)->minOffsetShiftStart = -minVal;
-
-        minVal = distEndEntity;
-        //  minVal = FLT_MAX;
-
-
-        /*if (distEndEntity < minVal) {
-            minVal = distEndEntity;
-        }*/
-
-        if (distEndEntityTextureId < minVal) {
-            minVal = distEndEntityTextureId;
-        }
-
-        minVal -= WA_CP_PLAYER_NAVIGATIONAREASAFETYDISTANCE;
-        if (minVal < 0.0f)
-            minVal = 0.0f;
-
-        (*it)->minOffsetShiftEnd = -minVal;
-
-        //now check if there is any obstacle from the side pointing towards the waypoint link
-        //we can find out by shooting rays in parallel to the original waypoint link, but with
-        //changing negative offset shifts (in steps)
-        //for each iteration we determine after which distance we hit something
-        //if we hit something in a distance less then the original length of the waypoint link, then
-        //hit hit an obstacle on the way
-       /* testOffset = resolution;
-
-        coord3D = (*it)->pLineStruct->A;
-        hitEnd = false;
-
-        while ((testOffset < minVal) && (!hitEnd)) {
-            rayInfo = this->CastRayDDA(*dynamicWorld, coord3D - testOffset * (*it)->offsetDirVec,
-                                       (*it)->LinkDirectionVec, 1000.0f, cells);
-
-            if (rayInfo.HitType == RAY_HIT_TERRAIN) {
-                //ray hit distance significantly shorter then original waypoint link
-                //distance
-                if (rayInfo.HitDistance < (0.9 * (*it)->length3D)) {
-                    //we seem to have hit an obstacle on the way -> we can not
-                    //go further to the left
-                    hitEnd = true;
-                }
-            }
-
-            if (!hitEnd) {
-                testOffset += resolution;
-            }
-
-
-        //if we found an additional obstacle from the side
-        //and its making the available space smaller, then
-        //make it the new limitiation
-        if (hitEnd && (testOffset < minVal)) {
-            minVal = testOffset;
-        }
+    //the result only depends on the level file, and is maybe already
+    //available in the level cache (for example written by hi-levelc)
+    if (mLevelAnalysis->LoadWaypointLinksOffsetRangeFromCache(mRace->mLevelCache, *mRace->wayPointLinkVec))
+        return;
 
-        //minVal has now the minimum we found inside
-        //a movement towards the left is negative for us later
-        //for reverse the sign
-        (*it)->minOffsetShift = -minVal;
-        */
-    }
+    mLevelAnalysis->AnalyzeWaypointLinksOffsetRange(*mRace->wayPointLinkVec);
+    mLevelAnalysis->StoreWaypointLinksOffsetRangeInCache(mRace->mLevelCache, *mRace->wayPointLinkVec);
 }
 
 void WorldAwareness::CreateStaticWorld() {
@@ -426,9 +176,14 @@ void WorldAwareness::CreateStaticWorld() {
    //only for debugging, save picture on disk
    //DebugSavePicture((char*)"dbgStaticWorld.png", staticWorld);
 
-   //create vector with obstacle information for DDA out
-   //of this picture
-   CreateStaticWorldMap();
+   //create vector with obstacle information for DDA; it contains the same
+   //obstacles as this picture, and is taken from the level cache if possible
+   if (!mLevelAnalysis->LoadStaticWorldMapFromCache(mRace->mLevelCache)) {
+       mLevelAnalysis->CreateStaticWorldMap(*mRace->ENTWallsegmentsLine_List);
+       mLevelAnalysis->StoreStaticWorldMapInCache(mRace->mLevelCache);
+   }
+
+   mStaticWorldMap = &mLevelAnalysis->mStaticWorldMap;
 
    //create dynamic world map variable
    mDynamicWorldMap = new std::vector<uint8_t>();
@@ -459,61 +214,6 @@ void WorldAwareness::UpdateDynamicWorldMap(Player* whichPlayer) {
   }
 }
 
-void WorldAwareness::CreateStaticWorldMap() {
-    mStaticWorldMap = new std::vector<uint8_t>();
-
-    int currIdxX;
-    int currIdxY = 0;
-    int maxX = mRace->mLevelTerrain->get_width();
-    int maxY = mRace->mLevelTerrain->get_heigth();
-
-    int sqrIdxX;
-    int sqrIdxY;
-    int sqrIdxEx;
-    int sqrIdxEy;
-
-    //resize vector correctly
-    mStaticWorldMap->resize(maxX * maxY);
-
-    irr::video::SColor currCol;
-    bool oF;
-
-    //go through all map entry coordinates, too see if we have an obstacle
-    //in the square with PixelScaleFactor pixels times PixelScaleFactor pixels
-    for (currIdxX = 0; currIdxX < maxX; currIdxX++)
-      for (currIdxY = 0; currIdxY < maxY; currIdxY++) {
-
-          //which is the last pixel we need to check
-          sqrIdxEx = (currIdxX + 1) * PixelScaleFactor;
-          sqrIdxEy = (currIdxY + 1) * PixelScaleFactor;
-
-          oF = false;
-
-          //check the current locations pixel square for obstacle
-          for (sqrIdxX = currIdxX * PixelScaleFactor; sqrIdxX < sqrIdxEx; sqrIdxX++)
-            for (sqrIdxY = currIdxY * PixelScaleFactor; sqrIdxY < sqrIdxEy; sqrIdxY++) {
-               currCol = staticWorld->getPixel(sqrIdxX, sqrIdxY);
-
-               if (currCol != *colorEmptySpace) {
-                   //we found an obstacle
-                   mStaticWorldMap->at(currIdxX + currIdxY * maxX) = 1;
-                   oF = true;
-
-                   //we can break out of this two innermost nested loops
-                   sqrIdxX = sqrIdxEx;
-                   break;
-               }
-            }
-
-          if (!oF) {
-              //no obstacle found withhin PixelScaleFactor x PixelScaleFactor area
-              mStaticWorldMap->at(currIdxX + currIdxY * maxX) = 0;
-          }
-       }
-
-    //map creation finished
-}
-
 RayHitInfoStruct WorldAwareness::CastRay(IImage &image, irr::core::vector3df startPos, irr::core::vector3df dirVec) {
    RayHitInfoStruct result;
 
@@ -1252,6 +952,8 @@ WorldAwareness::WorldAwareness(irr::IrrlichtDevice* device, irr::video::IVideoDr
    mDriver = driver;
    mDevice = device;
 
+   mLevelAnalysis = new LevelAnalysis(mRace->mLevelRes);
+
    worldSizeX = mRace->mLevelTerrain->get_width() * PixelScaleFactor;
    worldSizeY = mRace->mLevelTerrain->get_heigth() * PixelScaleFactor;
    
@@ -1301,7 +1003,8 @@ WorldAwareness::~WorldAwareness() {
     //delete XZPlane;
     staticWorld->drop();
 
-    delete mStaticWorldMap;
+    //mStaticWorldMap is owned by mLevelAnalysis
+    delete mLevelAnalysis;
     delete mDynamicWorldMap;
 
     delete colorRed;
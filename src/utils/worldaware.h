@@ -82,6 +82,7 @@
 #include "irrlicht.h"
 #include "stdint.h"
 #include <vector>
+#include "levelanalysis.h"
 
 #define RAY_HIT_NOTHING 0
 #define RAY_HIT_TERRAIN 1
@@ -91,8 +92,6 @@
 //(means a debugging picture is created in the background)
 #define WA_ALLOW_DEBUGGING false
 
-const irr::f32 WA_CP_PLAYER_NAVIGATIONAREASAFETYDISTANCE = 0.0f;
-
 /************************
  * Forward declarations *
  ************************/
@@ -158,7 +157,7 @@ private:
 
     //how many pixels we want per unit length in
     //3D world
-    uint8_t PixelScaleFactor = 5;
+    uint8_t PixelScaleFactor = LEVELANALYSIS_PIXELSCALEFACTOR;
 
     irr::video::SColor* colorEmptySpace = nullptr;
     irr::video::SColor* colorRed = nullptr;
@@ -166,9 +165,13 @@ private:
     //predefined vector with colors for max 8 players
     std::vector<irr::video::SColor*> mColorPlayerVec;
 
+    //derives the static world map and the waypoint
+    //link offset ranges without the Irrlicht device
+    LevelAnalysis* mLevelAnalysis = nullptr;
+
     //static world map contains info about static
     //Terrain and Cubes; 0 means in the tile there is no obstacle
-    //1 means there is an obstacle
+    //1 means there is an obstacle; points to the map of mLevelAnalysis
     std::vector<uint8_t>* mStaticWorldMap = nullptr;
 
     //dynamic world map contains info about moving players
@@ -177,12 +180,7 @@ private:
     //player in this tile;
     std::vector<uint8_t>* mDynamicWorldMap = nullptr;
 
-    void CreateStaticWorldMap();
     void UpdateDynamicWorldMap(Player* whichPlayer);
-
-    //returns true if a track end was identified
-    bool FindTrackEndAlongCastRay(std::vector<irr::core::vector2di> cells,
-                                  irr::core::vector3df rayStartPoint3D, irr::f32 &distanceToEnd);
     
 public:
     WorldAwareness(irr::IrrlichtDevice* device, irr::video::IVideoDriver *driver, Race* race);
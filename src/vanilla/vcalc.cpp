@@ -368,12 +368,9 @@ irr::f32 VCalculations::collide_map(irr::f32 posX, irr::f32 posZ)  //06.04.2026:
         return 0.0f;
     }
 
-    //get pntr to this tile
-    TerrainTileData *pntr = &mLevelTerrain->pTerrainTiles[intX][intY];
-
-    if (pntr == nullptr) {
-        return (0.0f);
-    }
+    //get the 4 vertex heights of this tile
+    //index 0 is vertex 1, index 3 is vertex 4
+    const irr::f32* pntr = mLevelTerrain->mTileStore->GetVertexHeights(intX, intY);
 
     int16_t idx = intX + intY;
     irr::s32 rem = (idx % 2);
@@ -386,35 +383,35 @@ irr::f32 VCalculations::collide_map(irr::f32 posX, irr::f32 posZ)  //06.04.2026:
     if (rem == 0) {
        if (fracY >= fracX) {
            //Sequence case 1 (Helpful for unit test and debugging)
-           slopeX = -pntr->vert3CurrPositionY + pntr->vert4CurrPositionY;
-           slopeZ = -pntr->vert4CurrPositionY + pntr->vert1CurrPositionY;
+           slopeX = -pntr[2] + pntr[3];
+           slopeZ = -pntr[3] + pntr[0];
 
-           yRes = -pntr->vert1CurrPositionY + slopeX * fracX + slopeZ * fracY;
+           yRes = -pntr[0] + slopeX * fracX + slopeZ * fracY;
            return yRes;
        }
 
        //Sequence case 2 (Helpful for unit test and debugging)
-       slopeX = -pntr->vert2CurrPositionY + pntr->vert1CurrPositionY;
-       slopeZ = -pntr->vert3CurrPositionY + pntr->vert2CurrPositionY;
+       slopeX = -pntr[1] + pntr[0];
+       slopeZ = -pntr[2] + pntr[1];
 
-       yRes = -pntr->vert1CurrPositionY + slopeX * fracX + slopeZ * fracY;
+       yRes = -pntr[0] + slopeX * fracX + slopeZ * fracY;
        return yRes;
     }
 
     if ((fracX + fracY) >= 1.0f) {
         //Sequence case 3 (Helpful for unit test and debugging)
-        slopeX = -pntr->vert3CurrPositionY + pntr->vert4CurrPositionY;
-        slopeZ = -pntr->vert2CurrPositionY + pntr->vert3CurrPositionY;
+        slopeX = -pntr[2] + pntr[3];
+        slopeZ = -pntr[1] + pntr[2];
 
-        yRes = -pntr->vert4CurrPositionY + slopeX * fracX + slopeZ * (1.0f - fracY);
+        yRes = -pntr[3] + slopeX * fracX + slopeZ * (1.0f - fracY);
         return yRes;
     }
 
     //Sequence case 4 (Helpful for unit test and debugging)
-    slopeX = -pntr->vert2CurrPositionY + pntr->vert1CurrPositionY;
-    slopeZ = -pntr->vert4CurrPositionY + pntr->vert1CurrPositionY;
+    slopeX = -pntr[1] + pntr[0];
+    slopeZ = -pntr[3] + pntr[0];
 
-    yRes = -pntr->vert1CurrPositionY + slopeX * fracX + slopeZ * fracY;
+    yRes = -pntr[0] + slopeX * fracX + slopeZ * fracY;
     return yRes;
 }
 
@@ -764,24 +761,24 @@ void VCalculations::move_displacement_slope(irr::core::vector3df position,
 
     mLevelTerrain->ForceTileGridCoordRange(cell);
 
-    //get pntr to this tile
-    TerrainTileData *pntr = &mLevelTerrain->pTerrainTiles[cell.X][cell.Y];
+    //get the 4 vertex heights of this tile
+    const irr::f32* pntr = mLevelTerrain->mTileStore->GetVertexHeights(cell.X, cell.Y);
 
     if (pntr != nullptr) {
         //we need to swap sign of all the current vertice coordinates
         //from Irrlicht
         //18.04.2026: not sure if the signs below are correct
-        displacement.X = pntr->vert1CurrPositionY;
-        displacement.Z = -pntr->vert1CurrPositionY;
+        displacement.X = pntr[0];
+        displacement.Z = -pntr[0];
 
-        displacement.X -= pntr->vert2CurrPositionY;
-        displacement.Z -= pntr->vert2CurrPositionY;
+        displacement.X -= pntr[1];
+        displacement.Z -= pntr[1];
 
-        displacement.X -= pntr->vert3CurrPositionY;
-        displacement.Z += pntr->vert3CurrPositionY;
+        displacement.X -= pntr[2];
+        displacement.Z += pntr[2];
 
-        displacement.X += pntr->vert4CurrPositionY;
-        displacement.Z += pntr->vert4CurrPositionY;
+        displacement.X += pntr[3];
+        displacement.Z += pntr[3];
     }
 }
 
@@ -113,7 +113,7 @@ VVehicle::VVehicle(Race* mParentRace, irr::core::vector3d<irr::f32> NewPosition,
    //TODO important: Preset Sensor Zpos values as in the original game!
    //See function initialiseVEHICLE_CAR
 
-   mCraftMesh = mRace->mGame->mSmgr->getMesh(irr::io::path("extract/models/car0-0.obj"));
+   mCraftMesh = mRace->mGame->mSmgr->getMesh(irr::io::path("extract/models/car0-0.hmesh"));
    mCraftNode = mRace->mGame->mSmgr->addMeshSceneNode(mCraftMesh);
 
    //set player model initial orientation and position, later player craft is only moved by physics engine
@@ -17,7 +17,7 @@ EffectHandler::EffectHandler(IrrlichtDevice* dev, const irr::core::dimension2du&
 : device(dev), smgr(dev->getSceneManager()), driver(dev->getVideoDriver()),
 ScreenRTTSize(screenRTTSize.getArea() == 0 ? dev->getVideoDriver()->getScreenSize() : screenRTTSize),
 ClearColour(0x0), shadowsUnsupported(false), DepthRTT(0), DepthPass(false), depthMC(0), shadowMC(0),
-AmbientColour(0x0), use32BitDepth(use32BitDepthBuffers), useVSM(useVSMShadows)
+AmbientColour(0x0), use32BitDepth(use32BitDepthBuffers), useVSM(useVSMShadows), ShadowCulling(true)
 {
 	bool tempTexFlagMipMaps = driver->getTextureCreationFlag(ETCF_CREATE_MIP_MAPS);
 	bool tempTexFlag32 = driver->getTextureCreationFlag(ETCF_ALWAYS_32_BIT);
@@ -218,6 +218,129 @@ void EffectHandler::addShadowToNode(irr::scene::ISceneNode *node, E_FILTER_TYPE
 }
 
 
+bool EffectHandler::isBoxOutsideFrustum(const irr::scene::SViewFrustum& frustum, const irr::core::aabbox3df& box) const
+{
+	core::vector3df edges[8];
+	box.getEdges(edges);
+
+	// The box is outside if all of its corners are in front of (outside) one of the frustum planes.
+	for(u32 i = 0;i < scene::SViewFrustum::VF_PLANE_COUNT;++i)
+	{
+		bool boxInFrontOfPlane = true;
+
+		for(u32 j = 0;j < 8;++j)
+		{
+			if(frustum.planes[i].classifyPointRelation(edges[j]) != core::ISREL3D_FRONT)
+			{
+				boxInFrontOfPlane = false;
+				break;
+			}
+		}
+
+		if(boxInFrontOfPlane)
+			return true;
+	}
+
+	return false;
+}
+
+
+bool EffectHandler::isNodeInsideLightFrustum(const irr::u32 lightIndex, irr::scene::ISceneNode* node)
+{
+	scene::SViewFrustum lightFrustum(LightList[lightIndex].getProjectionMatrix() * LightList[lightIndex].getViewMatrix());
+
+	return !isBoxOutsideFrustum(lightFrustum, node->getTransformedBoundingBox());
+}
+
+
+void EffectHandler::getShadowCasters(const irr::u32 lightIndex, irr::core::array<irr::scene::ISceneNode*>& casters)
+{
+	casters.set_used(0);
+
+	scene::SViewFrustum lightFrustum(LightList[lightIndex].getProjectionMatrix() * LightList[lightIndex].getViewMatrix());
+
+	const u32 ShadowNodeArraySize = ShadowNodeArray.size();
+	for(u32 i = 0;i < ShadowNodeArraySize;++i)
+	{
+		if(ShadowNodeArray[i].shadowMode == ESM_RECEIVE || ShadowNodeArray[i].shadowMode == ESM_EXCLUDE)
+			continue;
+
+		if(ShadowCulling && isBoxOutsideFrustum(lightFrustum, ShadowNodeArray[i].node->getTransformedBoundingBox()))
+		{
+			++ShadowStats.castersCulled;
+			continue;
+		}
+
+		casters.push_back(ShadowNodeArray[i].node);
+	}
+}
+
+
+void EffectHandler::renderShadowCasterDepth(irr::scene::ISceneNode* node)
+{
+	const u32 CurrentMaterialCount = node->getMaterialCount();
+	core::array<irr::s32> BufferMaterialList(CurrentMaterialCount);
+	BufferMaterialList.set_used(0);
+
+	for(u32 m = 0;m < CurrentMaterialCount;++m)
+	{
+		BufferMaterialList.push_back(node->getMaterial(m).MaterialType);
+		node->getMaterial(m).MaterialType = (E_MATERIAL_TYPE)
+			(BufferMaterialList[m] == video::EMT_TRANSPARENT_ALPHA_CHANNEL_REF ? DepthT : Depth);
+	}
+
+	node->OnAnimate(device->getTimer()->getTime());
+	node->render();
+
+	const u32 BufferMaterialListSize = BufferMaterialList.size();
+	for(u32 m = 0;m < BufferMaterialListSize;++m)
+		node->getMaterial(m).MaterialType = (E_MATERIAL_TYPE)BufferMaterialList[m];
+
+	++ShadowStats.castersRendered;
+}
+
+
+void EffectHandler::renderShadowMap(const irr::u32 lightIndex, irr::video::ITexture* shadowMapTexture)
+{
+	SShadowLight& light = LightList[lightIndex];
+
+	// Set max distance constant for depth shader.
+	depthMC->FarLink = light.getFarValue();
+
+	driver->setTransform(ETS_VIEW, light.getViewMatrix());
+	driver->setTransform(ETS_PROJECTION, light.getProjectionMatrix());
+
+	getShadowCasters(lightIndex, CasterList);
+
+	driver->setRenderTarget(shadowMapTexture, true, true, SColor(0xffffffff));
+
+	for(u32 i = 0;i < CasterList.size();++i)
+		renderShadowCasterDepth(CasterList[i]);
+
+	// Blur the shadow map texture if we're using VSM filtering.
+	if(useVSM)
+	{
+		ITexture* currentSecondaryShadowMap = getShadowMapTexture(light.getShadowMapResolution(), true);
+
+		driver->setRenderTarget(currentSecondaryShadowMap, true, true, SColor(0xffffffff));
+		ScreenQuad.getMaterial().setTexture(0, shadowMapTexture);
+		ScreenQuad.getMaterial().MaterialType = (E_MATERIAL_TYPE)VSMBlurH;
+		
+		ScreenQuad.render(driver);
+
+		driver->setRenderTarget(shadowMapTexture, true, true, SColor(0xffffffff));
+		ScreenQuad.getMaterial().setTexture(0, currentSecondaryShadowMap);
+		ScreenQuad.getMaterial().MaterialType = (E_MATERIAL_TYPE)VSMBlurV;
+		
+		ScreenQuad.render(driver);
+	}
+
+	light.shadowMapRendered = true;
+	light.shadowMapViewMat = light.getViewMatrix();
+	light.shadowMapProjMat = light.getProjectionMatrix();
+}
+
+
 void EffectHandler::addNodeToDepthPass(irr::scene::ISceneNode *node)
 {
 	if(DepthPassArray.binary_search(node) == -1)
@@ -248,59 +371,24 @@ void EffectHandler::update(irr::video::ITexture* outputTarget)
 		activeCam->OnRegisterSceneNode();
 		activeCam->render();
 
+		ShadowStats = SShadowStats();
+
 		const u32 ShadowNodeArraySize = ShadowNodeArray.size();
 		const u32 LightListSize = LightList.size();
 		for(u32 l = 0;l < LightListSize;++l)
 		{
-			// Set max distance constant for depth shader.
-			depthMC->FarLink = LightList[l].getFarValue();
-
-			driver->setTransform(ETS_VIEW, LightList[l].getViewMatrix());
-			driver->setTransform(ETS_PROJECTION, LightList[l].getProjectionMatrix());
-			
 			ITexture* currentShadowMapTexture = getShadowMapTexture(LightList[l].getShadowMapResolution());
-			driver->setRenderTarget(currentShadowMapTexture, true, true, SColor(0xffffffff));
-			
-			for(u32 i = 0;i < ShadowNodeArraySize;++i)
-			{
-				if(ShadowNodeArray[i].shadowMode == ESM_RECEIVE || ShadowNodeArray[i].shadowMode == ESM_EXCLUDE)
-					continue;
-
-				const u32 CurrentMaterialCount = ShadowNodeArray[i].node->getMaterialCount();
-				core::array<irr::s32> BufferMaterialList(CurrentMaterialCount);
-				BufferMaterialList.set_used(0);
-
-				for(u32 m = 0;m < CurrentMaterialCount;++m)
-				{
-					BufferMaterialList.push_back(ShadowNodeArray[i].node->getMaterial(m).MaterialType);
-					ShadowNodeArray[i].node->getMaterial(m).MaterialType = (E_MATERIAL_TYPE)
-						(BufferMaterialList[m] == video::EMT_TRANSPARENT_ALPHA_CHANNEL_REF ? DepthT : Depth);
-				}
 
-				ShadowNodeArray[i].node->OnAnimate(device->getTimer()->getTime());
-				ShadowNodeArray[i].node->render();
-
-				const u32 BufferMaterialListSize = BufferMaterialList.size();
-				for(u32 m = 0;m < BufferMaterialListSize;++m)
-					ShadowNodeArray[i].node->getMaterial(m).MaterialType = (E_MATERIAL_TYPE)BufferMaterialList[m];
+			// Lights with an update interval keep their shadow map for some frames.
+			if(!LightList[l].shadowMapRendered || LightList[l].framesUntilUpdate == 0)
+			{
+				renderShadowMap(l, currentShadowMapTexture);
+				LightList[l].framesUntilUpdate = LightList[l].getUpdateInterval() - 1;
 			}
-
-			// Blur the shadow map texture if we're using VSM filtering.
-			if(useVSM)
+			else
 			{
-				ITexture* currentSecondaryShadowMap = getShadowMapTexture(LightList[l].getShadowMapResolution(), true);
-
-				driver->setRenderTarget(currentSecondaryShadowMap, true, true, SColor(0xffffffff));
-				ScreenQuad.getMaterial().setTexture(0, currentShadowMapTexture);
-				ScreenQuad.getMaterial().MaterialType = (E_MATERIAL_TYPE)VSMBlurH;
-				
-				ScreenQuad.render(driver);
-
-				driver->setRenderTarget(currentShadowMapTexture, true, true, SColor(0xffffffff));
-				ScreenQuad.getMaterial().setTexture(0, currentSecondaryShadowMap);
-				ScreenQuad.getMaterial().MaterialType = (E_MATERIAL_TYPE)VSMBlurV;
-				
-				ScreenQuad.render(driver);
+				--LightList[l].framesUntilUpdate;
+				++ShadowStats.shadowMapsReused;
 			}
 
 			driver->setRenderTarget(ScreenQuad.rt[1], true, true, SColor(0xffffffff));
@@ -308,18 +396,32 @@ void EffectHandler::update(irr::video::ITexture* outputTarget)
 			driver->setTransform(ETS_VIEW, activeCam->getViewMatrix());
 			driver->setTransform(ETS_PROJECTION, activeCam->getProjectionMatrix());
 
+			// Use the matrices the shadow map was rendered with, the light could have
+			// moved in the meantime if the shadow map was not updated this frame.
+			core::matrix4 shadowMapViewInverse;
+			LightList[l].shadowMapViewMat.getInverse(shadowMapViewInverse);
+
 			shadowMC->LightColour = LightList[l].getLightColor();
-			shadowMC->LightLink = LightList[l].getPosition();
+			shadowMC->LightLink = shadowMapViewInverse.getTranslation();
 			shadowMC->FarLink = LightList[l].getFarValue();
-			shadowMC->ViewLink = LightList[l].getViewMatrix();
-			shadowMC->ProjLink = LightList[l].getProjectionMatrix();
+			shadowMC->ViewLink = LightList[l].shadowMapViewMat;
+			shadowMC->ProjLink = LightList[l].shadowMapProjMat;
 			shadowMC->MapRes = (f32)LightList[l].getShadowMapResolution();
 
+			const scene::SViewFrustum* camFrustum = activeCam->getViewFrustum();
+
 			for(u32 i = 0;i < ShadowNodeArraySize;++i)
 			{
 				if(ShadowNodeArray[i].shadowMode == ESM_CAST || ShadowNodeArray[i].shadowMode == ESM_EXCLUDE)
 						continue;
 
+				// Receivers outside of the camera view do not contribute to the light buffer.
+				if(ShadowCulling && isBoxOutsideFrustum(*camFrustum, ShadowNodeArray[i].node->getTransformedBoundingBox()))
+				{
+					++ShadowStats.receiversCulled;
+					continue;
+				}
+
 				const u32 CurrentMaterialCount = ShadowNodeArray[i].node->getMaterialCount();
 				core::array<irr::s32> BufferMaterialList(CurrentMaterialCount);
 				core::array<irr::video::ITexture*> BufferTextureList(CurrentMaterialCount);
@@ -47,7 +47,7 @@ struct SShadowLight
 					irr::f32 nearValue = 10.0, irr::f32 farValue = 100.0,
 					irr::f32 fov = 90.0 * irr::core::DEGTORAD64, bool directional = false)
 					:	pos(position), tar(target), farPlane(directional ? 1.0f : farValue), diffuseColour(lightColour), 
-						mapRes(shadowMapResolution)
+						mapRes(shadowMapResolution), updateInterval(1), framesUntilUpdate(0), shadowMapRendered(false)
 	{
 		nearValue = nearValue <= 0.0f ? 0.1f : nearValue;
 
@@ -142,8 +142,25 @@ struct SShadowLight
 		return mapRes;
 	}
 
+	/// Sets after how many frames the shadow map of this light is rendered again. The default of 1
+	/// renders it every frame. Higher values are meant for distant lights (cascades), where the casters
+	/// only move a few shadow map texels per frame. Only use this for lights with their own shadow map
+	/// resolution, as lights with the same resolution share one shadow map.
+	void setUpdateInterval(const irr::u32 frames)
+	{
+		updateInterval = frames < 1 ? 1 : frames;
+	}
+
+	/// Gets the shadow map update interval in frames.
+	const irr::u32 getUpdateInterval() const
+	{
+		return updateInterval;
+	}
+
 private:
 
+	friend class EffectHandler;
+
 	void updateViewMatrix()
 	{
 		viewMat.buildCameraLookAtMatrixLH(pos, tar,
@@ -156,6 +173,25 @@ private:
 	irr::f32 farPlane;
 	irr::core::matrix4 viewMat, projMat;
 	irr::u32 mapRes;
+
+	// State used by the EffectHandler. The matrices the current shadow map was rendered with are kept,
+	// so that receivers still sample it correctly in frames where the shadow map is not updated.
+	irr::u32 updateInterval;
+	irr::u32 framesUntilUpdate;
+	bool shadowMapRendered;
+	irr::core::matrix4 shadowMapViewMat, shadowMapProjMat;
+};
+
+/// Statistics of the shadow map passes of the last EffectHandler::update call.
+struct SShadowStats
+{
+	SShadowStats() : castersRendered(0), castersCulled(0), receiversCulled(0),
+		shadowMapsReused(0) {}
+
+	irr::u32 castersRendered;
+	irr::u32 castersCulled;
+	irr::u32 receiversCulled;
+	irr::u32 shadowMapsReused;
 };
 
 // This is a general interface that can be overidden if you want to perform operations before or after
@@ -272,6 +308,28 @@ public:
 	/// ESM_CAST only casts shadows, and is unaffected by shadows or lighting, and ESM_RECEIVE
 	/// only receives but does not cast shadows.
 	void addShadowToNode(irr::scene::ISceneNode* node, E_FILTER_TYPE filterType = EFT_NONE, E_SHADOW_MODE shadowMode = ESM_BOTH);
+
+	/// Enables/disables culling of shadow casters against the light frustum, and of shadow receivers
+	/// against the camera frustum. Enabled by default.
+	void enableShadowCulling(bool enableCulling)
+	{
+		ShadowCulling = enableCulling;
+	}
+
+	/// Returns true if the transformed bounding box of the node intersects the view frustum
+	/// of the specified shadow light.
+	bool isNodeInsideLightFrustum(const irr::u32 lightIndex, irr::scene::ISceneNode* node);
+
+	/// Fills the list of shadow casters which need to be rendered into the shadow map of the specified
+	/// light. Casters outside of the light frustum are not added if culling is enabled. Only uses the scene
+	/// node bounding boxes and the light matrices, and can therefore be called without rendering anything.
+	void getShadowCasters(const irr::u32 lightIndex, irr::core::array<irr::scene::ISceneNode*>& casters);
+
+	/// Returns the statistics of the shadow passes of the last update.
+	const SShadowStats& getShadowStats() const
+	{
+		return ShadowStats;
+	}
 	
 	/// Returns the device time divided by 100, for use with the shader callbacks.
 	irr::f32 getTime() 
@@ -450,6 +508,15 @@ private:
 		irr::s32 materialType;
 	};
 
+	/// Renders the shadow map of the specified light.
+	void renderShadowMap(const irr::u32 lightIndex, irr::video::ITexture* shadowMapTexture);
+
+	/// Renders the depth of a single shadow caster into the current render target.
+	void renderShadowCasterDepth(irr::scene::ISceneNode* node);
+
+	/// Returns true if the transformed bounding box is completely outside of the frustum.
+	bool isBoxOutsideFrustum(const irr::scene::SViewFrustum& frustum, const irr::core::aabbox3df& box) const;
+
 	SPostProcessingPair obtainScreenQuadMaterialFromFile(const irr::core::stringc& filename, 
 		irr::video::E_MATERIAL_TYPE baseMaterial = irr::video::EMT_SOLID);
 
@@ -482,6 +549,12 @@ private:
 	irr::core::array<SShadowNode> ShadowNodeArray;
 	irr::core::array<irr::scene::ISceneNode*> DepthPassArray;
 
+	// Caster list of the light which is currently rendered, kept as
+	// member to avoid memory allocations every frame.
+	irr::core::array<irr::scene::ISceneNode*> CasterList;
+
+	SShadowStats ShadowStats;
+
 	irr::core::dimension2du ScreenRTTSize;
 	irr::video::SColor ClearColour;
 	irr::video::SColor AmbientColour;
@@ -491,6 +564,7 @@ private:
 	bool use32BitDepth;
 	bool useVSM;
 	bool DepthPass;
+	bool ShadowCulling;
 };
 
 #endif
@@ -0,0 +1,249 @@
+/*
+ Copyright (C) 2026 Wolf Alexander
+
+ This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.                                          */
+
+#ifndef RNCPACK_H
+#define RNCPACK_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+//Minimal RNC (method 1) packer for the tests and benchmarks, so that they do not depend on the files
+//of the original game. It uses a greedy LZ77 search and the same fixed Huffman tables for all chunks;
+//The packing ratio is not important here, but the result must be a valid RNC stream with matches,
+//literal runs and more than one chunk
+
+//number of literal runs per chunk, small
+//enough to get several chunks
+#define RNCPACK_RUNSPERCHUNK 200
+
+#define RNCPACK_MAXDISTANCE 4096
+#define RNCPACK_MAXMATCH 255
+
+//the largest number the Huffman tables can encode
+#define RNCPACK_MAXLITERALS 32767
+
+//Huffman codes and values are read from bit 0 upwards, the bit stream consists of little
+//endian 16 bit words with the literal bytes in between; A new word is only started at
+//the current end of the output when the last word is full (the same the decoder expects)
+class RncBitWriter {
+public:
+    std::vector<unsigned char> out;
+
+    void WriteBits(uint32_t value, uint32_t nrBits) {
+        for (uint32_t bit = 0; bit < nrBits; bit++) {
+            if (mBitsInWord == 16) {
+                mWordPos = out.size();
+                out.push_back(0);
+                out.push_back(0);
+                mBitsInWord = 0;
+            }
+
+            if (value & (1U << bit)) {
+                out[mWordPos + mBitsInWord / 8] |= (unsigned char)(1 << (mBitsInWord % 8));
+            }
+
+            mBitsInWord++;
+        }
+    }
+
+    void WriteLiterals(const unsigned char* data, size_t len) {
+        out.insert(out.end(), data, data + len);
+    }
+
+private:
+    size_t mWordPos = 0;
+    uint32_t mBitsInWord = 16;
+};
+
+//all 16 values of a table have a code of length 4, the canonical code of
+//value j is therefore j with mirrored bits (see ReadHufTable)
+inline void RncPackWriteTable(RncBitWriter& bw) {
+    bw.WriteBits(16, 5);
+
+    for (uint32_t val = 0; val < 16; val++) {
+        bw.WriteBits(4, 4);
+    }
+}
+
+//writes a number with the fixed Huffman table
+inline void RncPackWriteNumber(RncBitWriter& bw, uint32_t number) {
+    uint32_t val = 0;
+    while ((number >> val) != 0) {
+        val++;
+    }
+
+    //the code is read bit by bit from the lowest bit, the canonical
+    //code of value val (4 bits) has to be written mirrored
+    uint32_t code = 0;
+    for (uint32_t bit = 0; bit < 4; bit++) {
+        if (val & (1U << (3 - bit))) {
+            code |= (1U << bit);
+        }
+    }
+
+    bw.WriteBits(code, 4);
+
+    //the highest bit is implicit
+    if (val >= 2) {
+        bw.WriteBits(number - (1U << (val - 1)), val - 1);
+    }
+}
+
+inline uint16_t RncPackCrc(const unsigned char* data, size_t len) {
+    uint16_t crctab[256];
+
+    for (uint32_t idx = 0; idx < 256; idx++) {
+        uint16_t val = (uint16_t)(idx);
+
+        for (uint32_t bit = 0; bit < 8; bit++) {
+            val = (val & 1) ? ((val >> 1) ^ 0xA001) : (val >> 1);
+        }
+
+        crctab[idx] = val;
+    }
+
+    uint16_t val = 0;
+    for (size_t idx = 0; idx < len; idx++) {
+        val ^= data[idx];
+        val = (val >> 8) ^ crctab[val & 0xFF];
+    }
+
+    return val;
+}
+
+inline void RncPackWriteBigEndian(std::vector<unsigned char>& out, size_t pos, uint32_t value, uint32_t nrBytes) {
+    for (uint32_t idx = 0; idx < nrBytes; idx++) {
+        out[pos + idx] = (unsigned char)(value >> (8 * (nrBytes - 1 - idx)));
+    }
+}
+
+//returns the packed data including the 18 byte header
+inline std::vector<unsigned char> RncPack(const std::vector<unsigned char>& data) {
+    //first find all matches: a literal run is followed by a match,
+    //a run without a match must be the last one of its chunk
+    struct Run {
+        size_t litStart;
+        size_t litLen;
+        size_t distance;
+        size_t matchLen;
+    };
+
+    std::vector<Run> runs;
+    size_t pos = 0;
+    size_t litStart = 0;
+
+    while (pos < data.size()) {
+        size_t bestLen = 0;
+        size_t bestDist = 0;
+        size_t maxLen = data.size() - pos;
+        if (maxLen > RNCPACK_MAXMATCH)
+            maxLen = RNCPACK_MAXMATCH;
+
+        for (size_t dist = 1; (dist <= RNCPACK_MAXDISTANCE) && (dist <= pos); dist++) {
+            size_t len = 0;
+            while ((len < maxLen) && (data[pos + len] == data[pos - dist + len])) {
+                len++;
+            }
+
+            if (len > bestLen) {
+                bestLen = len;
+                bestDist = dist;
+            }
+        }
+
+        if (bestLen >= 3) {
+            runs.push_back({litStart, pos - litStart, bestDist, bestLen});
+            pos += bestLen;
+            litStart = pos;
+        } else {
+            pos++;
+
+            if (pos - litStart == RNCPACK_MAXLITERALS) {
+                runs.push_back({litStart, pos - litStart, 0, 0});
+                litStart = pos;
+            }
+        }
+    }
+
+    //the last literal run has no match
+    runs.push_back({litStart, data.size() - litStart, 0, 0});
+
+    RncBitWriter bw;
+    bw.out.resize(18, 0);
+
+    //the decoder discards the first two bits
+    bw.WriteBits(0, 2);
+
+    size_t runIdx = 0;
+    uint32_t nrChunks = 0;
+
+    while (runIdx < runs.size()) {
+        size_t nrRuns = 0;
+        while (((runIdx + nrRuns) < runs.size()) && (nrRuns < RNCPACK_RUNSPERCHUNK)) {
+            nrRuns++;
+
+            if (runs[runIdx + nrRuns - 1].matchLen == 0)
+                break;
+        }
+
+        //tables for literal lengths, distances and match lengths
+        RncPackWriteTable(bw);
+        RncPackWriteTable(bw);
+        RncPackWriteTable(bw);
+
+        bw.WriteBits((uint32_t)(nrRuns), 16);
+
+        for (size_t idx = 0; idx < nrRuns; idx++) {
+            const Run& run = runs[runIdx + idx];
+
+            RncPackWriteNumber(bw, (uint32_t)(run.litLen));
+            if (run.litLen > 0) {
+                bw.WriteLiterals(&data[run.litStart], run.litLen);
+            }
+
+            //after the last literal run of the chunk
+            //there is no match
+            if (idx == nrRuns - 1)
+                break;
+
+            RncPackWriteNumber(bw, (uint32_t)(run.distance - 1));
+            RncPackWriteNumber(bw, (uint32_t)(run.matchLen - 2));
+        }
+
+        //the last run of a chunk has no match, if it has one
+        //anyway the next chunk starts with an empty literal run
+        const Run& last = runs[runIdx + nrRuns - 1];
+        if (last.matchLen > 0) {
+            runs.insert(runs.begin() + runIdx + nrRuns, {last.litStart + last.litLen, 0, last.distance, last.matchLen});
+            runs[runIdx + nrRuns - 1].matchLen = 0;
+        }
+
+        runIdx += nrRuns;
+        nrChunks++;
+    }
+
+    std::vector<unsigned char>& out = bw.out;
+    size_t packedLen = out.size() - 18;
+
+    out[0] = 'R';
+    out[1] = 'N';
+    out[2] = 'C';
+    out[3] = 1;
+    RncPackWriteBigEndian(out, 4, (uint32_t)(data.size()), 4);
+    RncPackWriteBigEndian(out, 8, (uint32_t)(packedLen), 4);
+    RncPackWriteBigEndian(out, 12, RncPackCrc(data.data(), data.size()), 2);
+    RncPackWriteBigEndian(out, 14, RncPackCrc(&out[18], packedLen), 2);
+    out[16] = 0;
+    out[17] = (unsigned char)(nrChunks);
+
+    return out;
+}
+
+#endif // RNCPACK_H
@@ -0,0 +1,105 @@
+/*
+ Copyright (C) 2026 Wolf Alexander
+
+ This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.                                          */
+
+//Compares the xBRZ upscaling in bands of rows on the thread pool with a single call of xbrz::scale
+//for the whole image; Different band sizes, scale factors and image sizes are used, also images
+//whose height is not a multiple of the band size, or that are smaller than one band
+
+#include "../src/resources/readgamedata/bandupscale.h"
+#include "../src/resources/xbrz-1-8/xbrz.h"
+#include "../src/utils/threadpool.h"
+#include "testutils.h"
+#include <vector>
+
+TEST_MAIN_FAILURECOUNTER
+
+//the target images are filled with this value before upscaling,
+//so that rows no band has written are found as well
+#define TEST_UNWRITTEN_PIXEL 0xDEADBEEF
+
+//simple deterministic random numbers, so
+//that a failure can be reproduced
+static uint32_t rndState = 0x2545F491;
+
+uint32_t NextRandom() {
+    rndState = rndState * 1664525 + 1013904223;
+    return (rndState >> 8);
+}
+
+//image similar to the sprites and textures of the game: a few colors in
+//blocks and diagonal lines, so that xBRZ finds a lot of edges to blend,
+//and some noise
+std::vector<uint32_t> CreateTestImage(irr::u32 sizex, irr::u32 sizey) {
+    const uint32_t palette[6] = {0xFF000000, 0xFFFFFFFF, 0xFF2040A0, 0xFFC08020, 0xFF10A010, 0x00000000};
+    std::vector<uint32_t> image(sizex * sizey);
+
+    for (irr::u32 y = 0; y < sizey; y++) {
+        for (irr::u32 x = 0; x < sizex; x++) {
+            uint32_t colorIdx = ((x / 5) + (y / 3)) % 4;
+
+            if (((x + y) % 11) == 0) {
+                colorIdx = 4;
+            }
+
+            if ((NextRandom() % 16) == 0) {
+                colorIdx = NextRandom() % 6;
+            }
+
+            image[y * sizex + x] = palette[colorIdx];
+        }
+    }
+
+    return image;
+}
+
+void TestImage(ThreadPool* threadPool, int scaleFactor, irr::u32 sizex, irr::u32 sizey, irr::u32 bandRows) {
+    std::vector<uint32_t> src = CreateTestImage(sizex, sizey);
+    size_t nrTargetPixels = (size_t)(sizex * scaleFactor) * (size_t)(sizey * scaleFactor);
+
+    std::vector<uint32_t> serial(nrTargetPixels, 0);
+    xbrz::scale(scaleFactor, src.data(), serial.data(), sizex, sizey, xbrz::ColorFormat::ARGB, xbrz::ScalerCfg(), 0, sizey);
+
+    std::vector<uint32_t> bands(nrTargetPixels, TEST_UNWRITTEN_PIXEL);
+    UpscaleImageBands(threadPool, scaleFactor, src.data(), bands.data(), sizex, sizey, bandRows);
+
+    if (bands != serial) {
+        printf("results differ: scale factor %d, image %ux%u, %u rows per band\n", scaleFactor, sizex, sizey, bandRows);
+    }
+
+    TEST_CHECK(bands == serial);
+}
+
+int main() {
+    ThreadPool* threadPool = new ThreadPool(4);
+
+    TEST_CHECK(GetNrUpscaleBands(64, 32) == 2);
+    TEST_CHECK(GetNrUpscaleBands(65, 32) == 3);
+    TEST_CHECK(GetNrUpscaleBands(31, 32) == 1);
+
+    const irr::u32 bandRows[] = {1, 2, 7, 16, DEF_BAND_UPSCALE_ROWS, 33};
+    const irr::u32 heights[] = {1, 2, 31, 32, 33, 64, 97, 200};
+    const irr::u32 widths[] = {1, 17, 112};
+
+    for (int scaleFactor = 2; scaleFactor <= 4; scaleFactor++) {
+        for (irr::u32 rows : bandRows) {
+            for (irr::u32 sizey : heights) {
+                for (irr::u32 sizex : widths) {
+                    TestImage(threadPool, scaleFactor, sizex, sizey, rows);
+                }
+            }
+        }
+    }
+
+    //without thread pool the image is scaled at once
+    TestImage(nullptr, 4, 112, 96, DEF_BAND_UPSCALE_ROWS);
+
+    delete threadPool;
+
+    return TestResult("test-bandupscale");
+}
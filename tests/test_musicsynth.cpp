@@ -0,0 +1,306 @@
+/*
+ Copyright (C) 2026 Wolf Alexander
+
+ This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.                                          */
+
+//Tests for the music synth thread:
+//  test-musicsynth ringbuffer
+//      checks the lock free ring buffer, also with a producer and a consumer thread
+//  test-musicsynth render <wOPL bank file> <XMI file> [seconds]
+//      renders the start of the music file with the synchronous ADLMIDI path the music stream
+//      used before, and via the synth thread and the ring buffer; both must be equal. The files
+//      are created by the game during the extraction of the original game data, if they
+//      do not exist the test is skipped
+
+#include "../src/audio/musicsynth.h"
+#include "testutils.h"
+#include <cstring>
+#include <cstdlib>
+#include <chrono>
+
+TEST_MAIN_FAILURECOUNTER
+
+//exit code for ctest if the data
+//files for the test are missing
+#define TEST_SKIPPED 77
+
+#define TEST_SAMPLERATE 44100
+
+//the same buffer size the music stream used before
+#define TEST_DIRECT_BUFSIZE 8192
+
+//number of samples the music stream requests
+//from the synth thread with one call
+#define TEST_STREAM_SAMPLES 4096
+
+//number of samples for the test with the two threads
+#define TEST_THREADED_SAMPLES 4000000
+
+void FillCounter(std::vector<int16_t>& buf, int16_t& counter) {
+    for (size_t idx = 0; idx < buf.size(); idx++) {
+        buf[idx] = counter++;
+    }
+}
+
+void TestRingBufferSingleThread() {
+    MusicRingBuffer ring;
+    std::vector<int16_t> src(1000);
+    std::vector<int16_t> dest(MUSICSYNTH_RINGBUFFER_SAMPLES);
+    int16_t counter = 0;
+
+    TEST_CHECK(ring.GetFreeSamples() == MUSICSYNTH_RINGBUFFER_SAMPLES);
+    TEST_CHECK(ring.GetAvailableSamples() == 0);
+    TEST_CHECK(ring.Read(dest.data(), 100) == 0);
+
+    //write over the end of the buffer a few times
+    int16_t expected = 0;
+    for (uint32_t loop = 0; loop < 100; loop++) {
+        FillCounter(src, counter);
+        ring.Write(src.data(), (uint32_t)(src.size()));
+
+        TEST_CHECK(ring.GetAvailableSamples() == src.size());
+        TEST_CHECK(ring.GetFreeSamples() == MUSICSYNTH_RINGBUFFER_SAMPLES - src.size());
+
+        //read in two parts
+        uint32_t nrRead = ring.Read(dest.data(), 300);
+        nrRead += ring.Read(dest.data() + nrRead, MUSICSYNTH_RINGBUFFER_SAMPLES);
+        TEST_CHECK(nrRead == src.size());
+
+        bool equal = true;
+        for (uint32_t idx = 0; idx < nrRead; idx++) {
+            equal &= (dest[idx] == expected++);
+        }
+
+        TEST_CHECK(equal);
+    }
+
+    //completely full
+    std::vector<int16_t> full(MUSICSYNTH_RINGBUFFER_SAMPLES, 1);
+    ring.Write(full.data(), MUSICSYNTH_RINGBUFFER_SAMPLES);
+    TEST_CHECK(ring.GetFreeSamples() == 0);
+
+    //discarded samples are not read anymore, but their space is
+    //only free again after the consumer skipped them
+    ring.DiscardWritten();
+    TEST_CHECK(ring.GetAvailableSamples() == 0);
+    TEST_CHECK(ring.GetFreeSamples() == 0);
+
+    TEST_CHECK(ring.Read(dest.data(), 100) == 0);
+    TEST_CHECK(ring.GetFreeSamples() == MUSICSYNTH_RINGBUFFER_SAMPLES);
+
+    //the samples after the discard position are read
+    std::vector<int16_t> oldSamples(500, 2);
+    ring.Write(oldSamples.data(), (uint32_t)(oldSamples.size()));
+    ring.DiscardWritten();
+
+    std::vector<int16_t> newSamples(700, 3);
+    ring.Write(newSamples.data(), (uint32_t)(newSamples.size()));
+
+    TEST_CHECK(ring.GetAvailableSamples() == newSamples.size());
+    TEST_CHECK(ring.GetFreeSamples() == MUSICSYNTH_RINGBUFFER_SAMPLES - oldSamples.size() - newSamples.size());
+    TEST_CHECK(ring.Read(dest.data(), MUSICSYNTH_RINGBUFFER_SAMPLES) == newSamples.size());
+    TEST_CHECK((dest[0] == 3) && (dest[newSamples.size() - 1] == 3));
+    TEST_CHECK(ring.GetFreeSamples() == MUSICSYNTH_RINGBUFFER_SAMPLES);
+}
+
+void TestRingBufferThreaded() {
+    MusicRingBuffer ring;
+
+    //the producer writes blocks of different size with an increasing
+    //counter, the consumer reads with another block size and checks that
+    //no sample is lost, doubled or overwritten before it was read
+    std::thread producer([&ring]() {
+        std::vector<int16_t> src(MUSICSYNTH_RENDER_SAMPLES);
+        int16_t counter = 0;
+        uint32_t nrWritten = 0;
+        uint32_t blockSize = 17;
+
+        while (nrWritten < TEST_THREADED_SAMPLES) {
+            blockSize = (blockSize * 7 + 13) % MUSICSYNTH_RENDER_SAMPLES + 1;
+            if (blockSize > TEST_THREADED_SAMPLES - nrWritten)
+                blockSize = TEST_THREADED_SAMPLES - nrWritten;
+
+            if (ring.GetFreeSamples() < blockSize) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            for (uint32_t idx = 0; idx < blockSize; idx++) {
+                src[idx] = counter++;
+            }
+
+            ring.Write(src.data(), blockSize);
+            nrWritten += blockSize;
+        }
+    });
+
+    std::vector<int16_t> dest(3001);
+    int16_t expected = 0;
+    uint32_t nrRead = 0;
+    bool equal = true;
+
+    while (nrRead < TEST_THREADED_SAMPLES) {
+        uint32_t nrNew = ring.Read(dest.data(), (uint32_t)(dest.size()));
+
+        for (uint32_t idx = 0; idx < nrNew; idx++) {
+            equal &= (dest[idx] == expected++);
+        }
+
+        nrRead += nrNew;
+    }
+
+    producer.join();
+
+    TEST_CHECK(equal);
+    TEST_CHECK(nrRead == TEST_THREADED_SAMPLES);
+    TEST_CHECK(ring.GetAvailableSamples() == 0);
+}
+
+//renders the samples the same way the music stream
+//callback did before the synth thread existed
+bool RenderDirect(const char* bankFile, const char* musicFile, uint32_t nrSamples, std::vector<int16_t>& result) {
+    struct ADL_MIDIPlayer* player = adl_init(TEST_SAMPLERATE);
+
+    if (player == nullptr) {
+        printf("Couldn't initialize ADLMIDI: %s\n", adl_errorString());
+        return false;
+    }
+
+    adl_switchEmulator(player, ADLMIDI_EMU_DOSBOX);
+
+    struct ADLMIDI_AudioFormat audioFormat;
+    audioFormat.type = ADLMIDI_SampleType_S16;
+    audioFormat.containerSize = sizeof(int16_t);
+    audioFormat.sampleOffset = sizeof(int16_t) * 2;
+
+    adl_setLoopEnabled(player, 1);
+
+    if ((adl_openBankFile(player, bankFile) < 0) || (adl_openFile(player, musicFile) < 0)) {
+        printf("ADLMIDI error: %s\n", adl_errorInfo(player));
+        adl_close(player);
+        return false;
+    }
+
+    uint8_t buffer[TEST_DIRECT_BUFSIZE];
+
+    while (result.size() < nrSamples) {
+        int samples_count = adl_playFormat(player, TEST_DIRECT_BUFSIZE / audioFormat.containerSize,
+                                           buffer, buffer + audioFormat.containerSize, &audioFormat);
+
+        if (samples_count <= 0)
+            break;
+
+        for (int idx = 0; idx < samples_count; idx++) {
+            result.push_back(int16_t(buffer[idx * 2]) + (((int16_t)(buffer[idx * 2 + 1])) << 8));
+        }
+    }
+
+    adl_close(player);
+
+    if (result.size() > nrSamples) {
+        result.resize(nrSamples);
+    }
+
+    return true;
+}
+
+void TestRendering(const char* bankFile, const char* musicFile, uint32_t seconds) {
+    std::vector<int16_t> direct;
+
+    TEST_CHECK(RenderDirect(bankFile, musicFile, TEST_SAMPLERATE * 2 * seconds, direct));
+    TEST_CHECK(!direct.empty());
+
+    MusicSynth* synth = new MusicSynth(TEST_SAMPLERATE);
+    std::string errorMsg("");
+
+    if (!synth->Init(bankFile, errorMsg)) {
+        printf("%s\n", errorMsg.c_str());
+        TEST_CHECK(false);
+        delete synth;
+        return;
+    }
+
+    synth->Start();
+
+    //load the file two times, the samples of the first load are discarded,
+    //and must not show up in the result; between the two loads read a few
+    //samples as the audio callback would do
+    std::vector<int16_t> threaded(direct.size(), 0);
+
+    TEST_CHECK(synth->LoadFile(musicFile, errorMsg));
+    TEST_CHECK(synth->ReadSamples(threaded.data(), 1000) == 1000);
+    TEST_CHECK(synth->LoadFile(musicFile, errorMsg));
+
+    size_t nrRead = 0;
+
+    while ((nrRead < threaded.size()) && !synth->HasEnded()) {
+        //the same amount of samples the music stream requests
+        uint32_t nrRequest = TEST_STREAM_SAMPLES;
+        if (nrRequest > threaded.size() - nrRead)
+            nrRequest = (uint32_t)(threaded.size() - nrRead);
+
+        uint32_t nrNew = synth->ReadSamples(&threaded[nrRead], nrRequest);
+
+        if (nrNew == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        nrRead += nrNew;
+    }
+
+    delete synth;
+
+    TEST_CHECK(nrRead == direct.size());
+
+    for (size_t idx = 0; idx < nrRead; idx++) {
+        if (direct[idx] != threaded[idx]) {
+            printf("First difference at sample %zu (%d instead of %d)\n", idx, threaded[idx], direct[idx]);
+            TEST_CHECK(direct[idx] == threaded[idx]);
+            break;
+        }
+    }
+}
+
+bool FileExists(const char* fileName) {
+    FILE* file = fopen(fileName, "rb");
+
+    if (file == nullptr)
+        return false;
+
+    fclose(file);
+    return true;
+}
+
+int main(int argc, char** argv) {
+    if ((argc >= 2) && (strcmp(argv[1], "ringbuffer") == 0)) {
+        TestRingBufferSingleThread();
+        TestRingBufferThreaded();
+
+        return TestResult("test-musicsynth ringbuffer");
+    }
+
+    if ((argc >= 4) && (strcmp(argv[1], "render") == 0)) {
+        if (!FileExists(argv[2]) || !FileExists(argv[3])) {
+            printf("test-musicsynth render: %s or %s not found, start the game once to extract them\n",
+                   argv[2], argv[3]);
+            return TEST_SKIPPED;
+        }
+
+        uint32_t seconds = 10;
+        if (argc >= 5) {
+            seconds = (uint32_t)(atoi(argv[4]));
+        }
+
+        TestRendering(argv[2], argv[3], seconds);
+
+        return TestResult("test-musicsynth render");
+    }
+
+    printf("usage: test-musicsynth ringbuffer\n");
+    printf("       test-musicsynth render <wOPL bank file> <XMI file> [seconds]\n");
+    return 1;
+}
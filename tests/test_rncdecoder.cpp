@@ -0,0 +1,260 @@
+/*
+ Copyright (C) 2026 Wolf Alexander
+
+ This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.                                          */
+
+//Compares RncDecoder with the decoder in dernc.cpp: for valid data, for data with randomly
+//changed bytes, and for truncated data. The packed data is followed by guard bytes that are
+//not part of the buffer given to RncDecoder, if it reads them its result differs from the
+//result of dernc.cpp, which gets zeros behind the data (or from its own result with
+//other guard bytes)
+
+#include "../src/resources/readgamedata/rncdecoder.h"
+#include "../src/resources/readgamedata/dernc.h"
+#include "rncpack.h"
+#include "testutils.h"
+#include <cstring>
+
+TEST_MAIN_FAILURECOUNTER
+
+//number of runs with randomly changed bytes per data set
+#define TEST_NRFUZZRUNS 300
+
+//value of the bytes behind the packed data
+#define TEST_GUARDBYTE 0xA5
+#define TEST_NRGUARDBYTES 16
+
+//simple deterministic random numbers, so
+//that a failure can be reproduced
+static uint32_t rndState = 0x2545F491;
+
+uint32_t NextRandom() {
+    rndState = rndState * 1664525 + 1013904223;
+    return (rndState >> 8);
+}
+
+//unpacks with the decoder in dernc.cpp; It needs 8 additional bytes behind the input
+//and output buffers, they are set to 0 so that the result is always the same
+long ReferenceUnpack(const std::vector<unsigned char>& packed, std::vector<unsigned char>& unpacked, unsigned int flags) {
+    std::vector<unsigned char> packedCopy(packed);
+    packedCopy.resize(packed.size() + 8, 0);
+
+    unsigned long retLen = ((unsigned long)(packed[4]) << 24) | ((unsigned long)(packed[5]) << 16) |
+                           ((unsigned long)(packed[6]) << 8) | packed[7];
+    unpacked.assign(retLen + 8, 0);
+
+    long result = rnc_unpack(packedCopy.data(), unpacked.data(), flags, nullptr);
+
+    unpacked.resize((result < 0) ? 0 : retLen);
+
+    return result;
+}
+
+//unpacks with RncDecoder, the packed data is
+//followed by guard bytes in memory
+long GuardedUnpack(const std::vector<unsigned char>& packed, std::vector<unsigned char>& unpacked, unsigned int flags,
+                   unsigned char guardByte = TEST_GUARDBYTE) {
+    std::vector<unsigned char> guarded(packed);
+    guarded.resize(packed.size() + TEST_NRGUARDBYTES, guardByte);
+
+    return RncDecoder::Unpack(guarded.data(), packed.size(), unpacked, flags);
+}
+
+//both decoders must fail, or return the same data; The error codes for broken
+//data are not always the same, as the original decoder detects some errors later
+bool SameResult(const std::vector<unsigned char>& packed, unsigned int flags) {
+    std::vector<unsigned char> result;
+    std::vector<unsigned char> refResult;
+
+    long res = GuardedUnpack(packed, result, flags);
+    long refRes = ReferenceUnpack(packed, refResult, flags);
+
+    if ((res < 0) && (refRes < 0))
+        return true;
+
+    if ((res == refRes) && (result == refResult))
+        return true;
+
+    printf("decoders differ: result %ld, reference result %ld, packed length %zu\n", res, refRes, packed.size());
+    return false;
+}
+
+//RncDecoder must return the same, no matter
+//which bytes follow the packed data
+bool SameResultForAllGuardBytes(const std::vector<unsigned char>& packed, unsigned int flags) {
+    std::vector<unsigned char> result;
+    std::vector<unsigned char> otherResult;
+
+    long res = GuardedUnpack(packed, result, flags, 0x00);
+
+    for (uint32_t guardByte = 0x55; guardByte <= 0xFF; guardByte += 0x55) {
+        long otherRes = GuardedUnpack(packed, otherResult, flags, (unsigned char)(guardByte));
+
+        if ((otherRes != res) || (otherResult != result)) {
+            printf("result depends on the bytes behind the data: packed length %zu\n", packed.size());
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void SetPackedLength(std::vector<unsigned char>& packed, uint32_t len) {
+    packed[8] = (unsigned char)(len >> 24);
+    packed[9] = (unsigned char)(len >> 16);
+    packed[10] = (unsigned char)(len >> 8);
+    packed[11] = (unsigned char)(len);
+}
+
+std::vector<std::vector<unsigned char>> CreateTestData() {
+    std::vector<std::vector<unsigned char>> testData;
+
+    //empty and very short data
+    testData.push_back(std::vector<unsigned char>());
+    testData.push_back(std::vector<unsigned char>(1, 42));
+    testData.push_back(std::vector<unsigned char>(7, 0));
+
+    //long runs of the same byte
+    testData.push_back(std::vector<unsigned char>(20000, 0));
+
+    //text, a lot of matches
+    const char* text = "The quick hover craft races through the level, and collects all the ammo. ";
+    std::vector<unsigned char> textData;
+    while (textData.size() < 30000) {
+        textData.insert(textData.end(), text, text + strlen(text) - (NextRandom() % 10));
+    }
+    testData.push_back(textData);
+
+    //mostly random bytes, only few matches and long literal runs
+    std::vector<unsigned char> randomData;
+    for (uint32_t idx = 0; idx < 40000; idx++) {
+        randomData.push_back((unsigned char)(NextRandom()));
+    }
+    testData.push_back(randomData);
+
+    //image like data with small values
+    std::vector<unsigned char> imageData;
+    for (uint32_t idx = 0; idx < 50000; idx++) {
+        imageData.push_back((unsigned char)(((idx % 320) / 16) + (NextRandom() % 3)));
+    }
+    testData.push_back(imageData);
+
+    return testData;
+}
+
+void TestValidData(const std::vector<unsigned char>& data) {
+    std::vector<unsigned char> packed = RncPack(data);
+    std::vector<unsigned char> result;
+    std::vector<unsigned char> refResult;
+
+    TEST_CHECK(RncDecoder::IsRncData(packed.data(), packed.size()));
+    TEST_CHECK(RncDecoder::GetUnpackedLength(packed.data(), packed.size()) == (long)(data.size()));
+
+    TEST_CHECK(GuardedUnpack(packed, result, 0) == (long)(data.size()));
+    TEST_CHECK(result == data);
+
+    TEST_CHECK(ReferenceUnpack(packed, refResult, 0) == (long)(data.size()));
+    TEST_CHECK(refResult == data);
+
+    TEST_CHECK(RncDecoder::Crc(data.data(), data.size()) == (uint16_t)(rnc_crc((void*)(data.data()), data.size())));
+
+    //the output buffer is too small
+    if (!data.empty()) {
+        std::vector<unsigned char> small(data.size() - 1);
+        TEST_CHECK(RncDecoder::Unpack(packed.data(), packed.size(), small.data(), small.size()) < 0);
+    }
+}
+
+void TestCorruptData(const std::vector<unsigned char>& data) {
+    std::vector<unsigned char> packed = RncPack(data);
+    size_t streamLen = packed.size() - DEF_RNC_HEADERSIZE;
+
+    for (uint32_t run = 0; run < TEST_NRFUZZRUNS; run++) {
+        std::vector<unsigned char> corrupt(packed);
+        uint32_t nrChanges = 1 + (NextRandom() % 4);
+
+        for (uint32_t change = 0; change < nrChanges; change++) {
+            size_t pos = DEF_RNC_HEADERSIZE + (NextRandom() % streamLen);
+            corrupt[pos] ^= (unsigned char)(1 + (NextRandom() % 255));
+        }
+
+        //without the check of the packed data CRC, so that
+        //the decoding of the broken stream is compared
+        TEST_CHECK(SameResult(corrupt, RNC_IGNORE_PACKED_CRC_ERROR));
+
+        //the same with the CRC check, both decoders must fail
+        std::vector<unsigned char> result;
+        TEST_CHECK(GuardedUnpack(corrupt, result, 0) < 0);
+    }
+
+    //a broken header
+    std::vector<unsigned char> corrupt(packed);
+    corrupt[0] = 'X';
+    std::vector<unsigned char> result;
+    TEST_CHECK(GuardedUnpack(corrupt, result, 0) < 0);
+    TEST_CHECK(!RncDecoder::IsRncData(corrupt.data(), corrupt.size()));
+
+    corrupt = packed;
+    SetPackedLength(corrupt, (uint32_t)(1UL << 31));
+    TEST_CHECK(GuardedUnpack(corrupt, result, 0) == RNC_HEADER_VAL_ERROR);
+}
+
+void TestTruncatedData(const std::vector<unsigned char>& data) {
+    std::vector<unsigned char> packed = RncPack(data);
+    size_t streamLen = packed.size() - DEF_RNC_HEADERSIZE;
+    std::vector<unsigned char> result;
+
+    //a header that is not complete
+    for (size_t len = 0; len < DEF_RNC_HEADERSIZE; len++) {
+        std::vector<unsigned char> truncated(packed.begin(), packed.begin() + len);
+        TEST_CHECK(GuardedUnpack(truncated, result, 0) < 0);
+        TEST_CHECK(!RncDecoder::IsRncData(truncated.data(), truncated.size()));
+    }
+
+    //every length near the end of the data, where the 64 bit buffer
+    //is filled with words behind the end, and some lengths before
+    for (size_t cut = 1; cut <= streamLen; cut++) {
+        if ((cut > 40) && ((cut % 97) != 0))
+            continue;
+
+        std::vector<unsigned char> truncated(packed.begin(), packed.end() - cut);
+
+        //the header still contains the original length, the
+        //data is not complete and must not be decoded at all
+        TEST_CHECK(GuardedUnpack(truncated, result, RNC_IGNORE_PACKED_CRC_ERROR) == RNC_FILE_SIZE_MISMATCH);
+
+        //the header contains the new length, the stream ends
+        //somewhere in the middle of a chunk
+        SetPackedLength(truncated, (uint32_t)(streamLen - cut));
+        TEST_CHECK(SameResult(truncated, RNC_IGNORE_PACKED_CRC_ERROR));
+
+        //also with all stream errors ignored, so that the decoding continues until the end of
+        //the data; dernc.cpp can loop forever with these flags, therefore RncDecoder is only
+        //compared with itself, with different bytes behind the data
+        TEST_CHECK(SameResultForAllGuardBytes(truncated, RNC_IGNORE_PACKED_CRC_ERROR | RNC_IGNORE_HUF_DECODE_ERROR |
+                                              RNC_IGNORE_HUF_EXCEEDS_RANGE | RNC_IGNORE_FILE_SIZE_MISMATCH |
+                                              RNC_IGNORE_UNPACKED_CRC_ERROR));
+    }
+}
+
+int main() {
+    std::vector<std::vector<unsigned char>> testData = CreateTestData();
+
+    for (size_t idx = 0; idx < testData.size(); idx++) {
+        TestValidData(testData[idx]);
+
+        //corrupt and truncated data needs a stream
+        //with at least one chunk
+        if (testData[idx].size() < 100)
+            continue;
+
+        TestCorruptData(testData[idx]);
+        TestTruncatedData(testData[idx]);
+    }
+
+    return TestResult("test-rncdecoder");
+}
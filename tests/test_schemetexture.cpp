@@ -0,0 +1,407 @@
+/*
+ Copyright (C) 2026 Wolf Alexander
+
+ This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.                                          */
+
+//Checks the baked color scheme textures of the crafts against the way the game drew the color schemes before:
+//the mesh of color scheme i, which samples the model texture atlas with its own texture coordinates. The craft
+//models are built like the ones of the original game: rectangles of the atlas on the faces (also rotated and
+//mirrored, and the same rectangle on several faces), split into triangles, and triangles without texture.
+//At sample points inside of every triangle the mesh of the first color scheme with the baked texture has to
+//show exactly the same texel as the mesh of color scheme i with the atlas
+
+#include "../src/resources/readgamedata/schemetexture.h"
+#include "testutils.h"
+#include <cmath>
+#include <vector>
+
+TEST_MAIN_FAILURECOUNTER
+
+//same size as the model texture atlas of the game
+#define TEST_ATLAS_WIDTH 256
+#define TEST_ATLAS_HEIGHT 128
+
+//the atlas is split into cells of this size, the left half
+//is used by the first color scheme, the right half by the others
+#define TEST_CELLSIZE 16
+
+#define TEST_NRSCHEMES 8
+
+//simple deterministic random numbers, so
+//that a failure can be reproduced
+static uint32_t rndState = 0x2545F491;
+
+uint32_t NextRandom() {
+    rndState = rndState * 1664525 + 1013904223;
+    return (rndState >> 8);
+}
+
+//a point in the atlas in texels
+typedef struct TestPointStruct {
+    double x;
+    double y;
+} TestPointStruct;
+
+//a rectangle of the atlas that is shown on a face of the model
+typedef struct TestRectStruct {
+    int x;
+    int y;
+    int width;
+    int height;
+
+    //how the rectangle is put on the face: 0 unchanged, 1 mirrored in x, 2 mirrored
+    //in y, 3 rotated by 180 degrees, 4 and 5 rotated by 90 degrees (only square rectangles)
+    int orientation;
+} TestRectStruct;
+
+typedef struct TestSchemeStruct {
+    //6 values per triangle, like ObjectDatFile::uvCoordVec
+    std::vector<float> uvCoords;
+} TestSchemeStruct;
+
+//returns the position in the atlas of the point (u, v) of a face, u and
+//v in the range 0 up to 1, for the rectangle rect shown on this face
+TestPointStruct GetRectPoint(const TestRectStruct& rect, double u, double v) {
+    double ru = u;
+    double rv = v;
+
+    switch (rect.orientation) {
+        case 1: ru = 1.0 - u; break;
+        case 2: rv = 1.0 - v; break;
+        case 3: ru = 1.0 - u; rv = 1.0 - v; break;
+        case 4: ru = v; rv = 1.0 - u; break;
+        case 5: ru = 1.0 - v; rv = u; break;
+        default: break;
+    }
+
+    TestPointStruct point;
+    point.x = rect.x + ru * rect.width;
+    point.y = rect.y + rv * rect.height;
+
+    return point;
+}
+
+void AddUvCoord(TestSchemeStruct& scheme, const TestPointStruct& point) {
+    scheme.uvCoords.push_back((float)(point.x / TEST_ATLAS_WIDTH));
+    scheme.uvCoords.push_back((float)(point.y / TEST_ATLAS_HEIGHT));
+}
+
+//adds a face with the corners (u, v) of the face, split into triangles, to all
+//color schemes; rects contains the atlas rectangle of each color scheme
+void AddFace(std::vector<TestSchemeStruct>& schemes, const std::vector<TestRectStruct>& rects,
+             const std::vector<TestPointStruct>& faceTriangles) {
+    for (size_t schemeIdx = 0; schemeIdx < schemes.size(); schemeIdx++) {
+        for (const TestPointStruct& corner : faceTriangles) {
+            AddUvCoord(schemes[schemeIdx], GetRectPoint(rects[schemeIdx], corner.x, corner.y));
+        }
+    }
+}
+
+//corners of the triangles of a face, in face coordinates; the face is
+//split in 2 triangles along one of the diagonals, or in 4 triangles
+//around a point inside of the face
+std::vector<TestPointStruct> CreateFaceTriangles(int splitMode, const TestRectStruct& rect) {
+    std::vector<TestPointStruct> tri;
+
+    switch (splitMode) {
+        case 0: {
+            tri = {{0, 0}, {1, 0}, {1, 1}, {0, 0}, {1, 1}, {0, 1}};
+            break;
+        }
+        case 1: {
+            tri = {{1, 0}, {1, 1}, {0, 1}, {1, 0}, {0, 1}, {0, 0}};
+            break;
+        }
+        default: {
+            //the inner point is located at a texel corner, as
+            //all the corners of the atlas rectangles
+            TestPointStruct mid = {(double)(rect.width / 2) / rect.width, (double)(rect.height / 2) / rect.height};
+            tri = {{0, 0}, {1, 0}, mid, {1, 0}, {1, 1}, mid, {1, 1}, {0, 1}, mid, {0, 1}, {0, 0}, mid};
+            break;
+        }
+    }
+
+    return tri;
+}
+
+//returns the rectangle in cell cellIdx of the left (first color scheme)
+//or right half (all other color schemes) of the atlas
+TestRectStruct CreateRect(int cellIdx, bool rightHalf, int width, int height, int orientation) {
+    int nrCellsX = TEST_ATLAS_WIDTH / TEST_CELLSIZE / 2;
+
+    TestRectStruct rect;
+
+    //the cells start at texel 1, so that texel (0, 0) is only
+    //used by the triangles without texture
+    rect.x = (cellIdx % nrCellsX) * TEST_CELLSIZE + 1;
+    rect.y = (cellIdx / nrCellsX) * TEST_CELLSIZE + 1;
+    rect.width = width;
+    rect.height = height;
+    rect.orientation = orientation;
+
+    if (rightHalf) {
+        rect.x += TEST_ATLAS_WIDTH / 2;
+    }
+
+    return rect;
+}
+
+int RandomOrientation(int width, int height) {
+    if (width == height)
+        return (int)(NextRandom() % 6);
+
+    return (int)(NextRandom() % 4);
+}
+
+//creates the texture coordinates of all color schemes of a model; with a conflict, one
+//rectangle of the first color scheme shows different rectangles in another color scheme
+std::vector<TestSchemeStruct> CreateModel(bool conflict) {
+    int nrCells = (TEST_ATLAS_WIDTH / TEST_CELLSIZE / 2) * (TEST_ATLAS_HEIGHT / TEST_CELLSIZE);
+    std::vector<TestSchemeStruct> schemes(TEST_NRSCHEMES);
+
+    //the rectangles of each color scheme, for each cell of the first color scheme
+    std::vector<std::vector<TestRectStruct>> cellRects(nrCells);
+
+    for (int cellIdx = 0; cellIdx < nrCells; cellIdx++) {
+        int width = 2 + (int)(NextRandom() % (TEST_CELLSIZE - 2));
+        int height = 2 + (int)(NextRandom() % (TEST_CELLSIZE - 2));
+
+        cellRects[cellIdx].push_back(CreateRect(cellIdx, false, width, height, 0));
+    }
+
+    //every other color scheme places the rectangles into
+    //other cells, and in another orientation
+    for (int schemeIdx = 1; schemeIdx < TEST_NRSCHEMES; schemeIdx++) {
+        std::vector<int> cellOrder(nrCells);
+
+        for (int idx = 0; idx < nrCells; idx++) {
+            cellOrder[idx] = idx;
+        }
+
+        for (int idx = nrCells - 1; idx > 0; idx--) {
+            std::swap(cellOrder[idx], cellOrder[NextRandom() % (idx + 1)]);
+        }
+
+        for (int cellIdx = 0; cellIdx < nrCells; cellIdx++) {
+            const TestRectStruct& first = cellRects[cellIdx][0];
+
+            cellRects[cellIdx].push_back(CreateRect(cellOrder[cellIdx], true, first.width, first.height,
+                                                    RandomOrientation(first.width, first.height)));
+        }
+    }
+
+    for (int cellIdx = 0; cellIdx < nrCells; cellIdx++) {
+        AddFace(schemes, cellRects[cellIdx], CreateFaceTriangles((int)(NextRandom() % 3), cellRects[cellIdx][0]));
+    }
+
+    //some rectangles are shown on more than one face, the faces
+    //can be split into triangles in another way
+    for (int idx = 0; idx < nrCells / 4; idx++) {
+        int cellIdx = (int)(NextRandom() % nrCells);
+
+        AddFace(schemes, cellRects[cellIdx], CreateFaceTriangles((int)(NextRandom() % 3), cellRects[cellIdx][0]));
+    }
+
+    //triangles without texture, all texture coordinates of the first
+    //color scheme are 0, the other color schemes use a single texel
+    for (int schemeIdx = 0; schemeIdx < TEST_NRSCHEMES; schemeIdx++) {
+        TestPointStruct point = {0.0, 0.0};
+
+        if (schemeIdx > 0) {
+            point.x = TEST_ATLAS_WIDTH / 2 + 0.5;
+            point.y = (TEST_ATLAS_HEIGHT - 1) + 0.5;
+        }
+
+        for (int k = 0; k < 6; k++) {
+            AddUvCoord(schemes[schemeIdx], point);
+        }
+    }
+
+    if (conflict) {
+        //the rectangle of cell 0 is shown with the rectangles of
+        //cell 1 in the other color schemes
+        std::vector<TestRectStruct> rects = cellRects[1];
+        rects[0] = cellRects[0][0];
+
+        if ((rects[0].width != rects[1].width) || (rects[0].height != rects[1].height)) {
+            for (int schemeIdx = 1; schemeIdx < TEST_NRSCHEMES; schemeIdx++) {
+                rects[schemeIdx].width = rects[0].width;
+                rects[schemeIdx].height = rects[0].height;
+                rects[schemeIdx].orientation = 0;
+            }
+        }
+
+        AddFace(schemes, rects, CreateFaceTriangles(0, rects[0]));
+    }
+
+    return schemes;
+}
+
+std::vector<uint32_t> CreateAtlas() {
+    std::vector<uint32_t> atlas(TEST_ATLAS_WIDTH * TEST_ATLAS_HEIGHT);
+
+    //every texel gets its own color, so that
+    //each wrong texel is found
+    for (size_t idx = 0; idx < atlas.size(); idx++) {
+        atlas[idx] = 0xFF000000 | (uint32_t)(idx * 2654435761u >> 8) | (uint32_t)(idx & 0xFF);
+    }
+
+    return atlas;
+}
+
+//the texel a mesh shows at an atlas position in texels, with nearest texture
+//filtering (as the game renders the crafts), clamped to the texture
+uint32_t SampleNearest(const std::vector<uint32_t>& texture, double x, double y) {
+    int texelX = (int)(floor(x));
+    int texelY = (int)(floor(y));
+
+    texelX = std::max(0, std::min(texelX, TEST_ATLAS_WIDTH - 1));
+    texelY = std::max(0, std::min(texelY, TEST_ATLAS_HEIGHT - 1));
+
+    return texture[texelY * TEST_ATLAS_WIDTH + texelX];
+}
+
+TestPointStruct GetTrianglePoint(const std::vector<float>& uvCoords, size_t triIdx, double b0, double b1, double b2) {
+    TestPointStruct point;
+
+    point.x = (b0 * uvCoords[triIdx * 6] + b1 * uvCoords[triIdx * 6 + 2] + b2 * uvCoords[triIdx * 6 + 4]) * TEST_ATLAS_WIDTH;
+    point.y = (b0 * uvCoords[triIdx * 6 + 1] + b1 * uvCoords[triIdx * 6 + 3] + b2 * uvCoords[triIdx * 6 + 5]) * TEST_ATLAS_HEIGHT;
+
+    return point;
+}
+
+//Compares the first color scheme mesh with the baked texture to the mesh of color scheme other with the atlas.
+//The sample points are located at a quarter texel from the texel borders of the first color scheme, and because
+//the corners of all atlas rectangles are located at texel corners, also of the other color scheme; So there is
+//no doubt which texel the graphics card shows at a sample point. Returns the number of compared sample points,
+//-1 if a sample point shows different texels
+int CompareWithAtlasMesh(const TestSchemeStruct& first, const TestSchemeStruct& other,
+                         const std::vector<uint32_t>& atlas, const std::vector<uint32_t>& schemeTex) {
+    int nrSamples = 0;
+    size_t nrTriangles = first.uvCoords.size() / 6;
+
+    for (size_t triIdx = 0; triIdx < nrTriangles; triIdx++) {
+        TestPointStruct p[3];
+
+        for (int k = 0; k < 3; k++) {
+            p[k].x = first.uvCoords[triIdx * 6 + k * 2] * (double)(TEST_ATLAS_WIDTH);
+            p[k].y = first.uvCoords[triIdx * 6 + k * 2 + 1] * (double)(TEST_ATLAS_HEIGHT);
+        }
+
+        double area = (p[1].x - p[0].x) * (p[2].y - p[0].y) - (p[2].x - p[0].x) * (p[1].y - p[0].y);
+
+        if (fabs(area) < 1e-9) {
+            //triangle without texture, shows a single texel
+            TestPointStruct q = GetTrianglePoint(other.uvCoords, triIdx, 1.0, 0.0, 0.0);
+
+            if (SampleNearest(schemeTex, p[0].x, p[0].y) != SampleNearest(atlas, q.x, q.y)) {
+                printf("triangle %u without texture shows a different texel\n", (unsigned int)(triIdx));
+                return -1;
+            }
+
+            nrSamples++;
+            continue;
+        }
+
+        int minX = (int)(floor(std::min(p[0].x, std::min(p[1].x, p[2].x))));
+        int maxX = (int)(ceil(std::max(p[0].x, std::max(p[1].x, p[2].x))));
+        int minY = (int)(floor(std::min(p[0].y, std::min(p[1].y, p[2].y))));
+        int maxY = (int)(ceil(std::max(p[0].y, std::max(p[1].y, p[2].y))));
+
+        for (int y = minY; y < maxY; y++) {
+            for (int x = minX; x < maxX; x++) {
+                for (int sample = 0; sample < 4; sample++) {
+                    double sx = x + ((sample & 1) ? 0.75 : 0.25);
+                    double sy = y + ((sample & 2) ? 0.75 : 0.25);
+
+                    double b1 = ((sx - p[0].x) * (p[2].y - p[0].y) - (p[2].x - p[0].x) * (sy - p[0].y)) / area;
+                    double b2 = ((p[1].x - p[0].x) * (sy - p[0].y) - (sx - p[0].x) * (p[1].y - p[0].y)) / area;
+                    double b0 = 1.0 - b1 - b2;
+
+                    //only sample points inside of the triangle
+                    if ((b0 <= 0.0) || (b1 <= 0.0) || (b2 <= 0.0))
+                        continue;
+
+                    TestPointStruct q = GetTrianglePoint(other.uvCoords, triIdx, b0, b1, b2);
+
+                    if (SampleNearest(schemeTex, sx, sy) != SampleNearest(atlas, q.x, q.y)) {
+                        printf("triangle %u: sample point (%.2lf, %.2lf) shows a different texel than (%.2lf, %.2lf) of the atlas\n",
+                               (unsigned int)(triIdx), sx, sy, q.x, q.y);
+                        return -1;
+                    }
+
+                    nrSamples++;
+                }
+            }
+        }
+    }
+
+    return nrSamples;
+}
+
+void TestColorSchemes() {
+    std::vector<uint32_t> atlas = CreateAtlas();
+    std::vector<TestSchemeStruct> schemes = CreateModel(false);
+
+    for (int schemeIdx = 1; schemeIdx < TEST_NRSCHEMES; schemeIdx++) {
+        std::vector<uint32_t> schemeTex(atlas.size(), 0);
+
+        bool baked = BakeSchemeTexture(schemes[0].uvCoords, schemes[schemeIdx].uvCoords, atlas.data(), schemeTex.data(),
+                                       TEST_ATLAS_WIDTH, TEST_ATLAS_HEIGHT);
+        TEST_CHECK(baked);
+
+        if (!baked)
+            continue;
+
+        int nrSamples = CompareWithAtlasMesh(schemes[0], schemes[schemeIdx], atlas, schemeTex);
+
+        if (nrSamples < 0) {
+            printf("color scheme %d differs\n", schemeIdx);
+        }
+
+        //otherwise the comparison does not
+        //tell us anything
+        TEST_CHECK(nrSamples > 10000);
+
+        TEST_CHECK(VerifySchemeTexture(schemes[0].uvCoords, schemes[schemeIdx].uvCoords, atlas.data(), schemeTex.data(),
+                                       TEST_ATLAS_WIDTH, TEST_ATLAS_HEIGHT));
+
+        //a texel that no triangle uses keeps the content of the atlas (the
+        //rectangles start at texel 1 of the cells)
+        int unusedIdx = (TEST_ATLAS_HEIGHT - 1) * TEST_ATLAS_WIDTH;
+        TEST_CHECK(schemeTex[unusedIdx] == atlas[unusedIdx]);
+
+        //the first color scheme itself gives the atlas again
+        std::vector<uint32_t> firstTex(atlas.size(), 0);
+        TEST_CHECK(BakeSchemeTexture(schemes[0].uvCoords, schemes[0].uvCoords, atlas.data(), firstTex.data(),
+                                     TEST_ATLAS_WIDTH, TEST_ATLAS_HEIGHT));
+        TEST_CHECK(firstTex == atlas);
+
+        //with the atlas itself the first color scheme
+        //does not look like the other color scheme
+        TEST_CHECK(!VerifySchemeTexture(schemes[0].uvCoords, schemes[schemeIdx].uvCoords, atlas.data(), atlas.data(),
+                                        TEST_ATLAS_WIDTH, TEST_ATLAS_HEIGHT));
+    }
+}
+
+void TestConflict() {
+    std::vector<uint32_t> atlas = CreateAtlas();
+    std::vector<TestSchemeStruct> schemes = CreateModel(true);
+    std::vector<uint32_t> schemeTex(atlas.size(), 0);
+
+    //the same texel of the first color scheme would need to show two
+    //different texels, such a color scheme keeps its own mesh
+    TEST_CHECK(!BakeSchemeTexture(schemes[0].uvCoords, schemes[1].uvCoords, atlas.data(), schemeTex.data(),
+                                  TEST_ATLAS_WIDTH, TEST_ATLAS_HEIGHT));
+}
+
+int main() {
+    TestColorSchemes();
+    TestConflict();
+
+    return TestResult("test-schemetexture");
+}
@@ -0,0 +1,293 @@
+/*
+ Copyright (C) 2026 Wolf Alexander
+
+ This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.                                          */
+
+//Checks the terrain normal and illumination calculation for tile regions:
+//  - a full map update gives the same result as the old per tile calculation,
+//    which calculated the 4 corners of every tile on its own
+//  - after random edits (rectangles of map entries at the map edges and corners, and in the
+//    interior) only updating the tiles whose corners depend on the edited map entries, as the
+//    game does it, gives bit for bit the same normals and colors as a full map update
+
+#include "../src/models/terrainregion.h"
+#include "testutils.h"
+#include <cstring>
+
+TEST_MAIN_FAILURECOUNTER
+
+//the same size as the level files
+#define TEST_MAPWIDTH 256
+#define TEST_MAPHEIGHT 160
+
+#define TEST_NREDITS 400
+
+//the results for one tile, the same values LevelTerrain
+//stores in TerrainTileData
+typedef struct TestTileStruct {
+    irr::core::vector3df normal[4];
+    irr::video::SColor color[4];
+} TestTileStruct;
+
+typedef struct TestMapStruct {
+    TerrainTileStore* tileStore;
+
+    //one illumination value per map entry, [x * height + z]
+    std::vector<int16_t> illumination;
+
+    //results, [x * height + z]
+    std::vector<TestTileStruct> tiles;
+} TestMapStruct;
+
+//simple deterministic random numbers, so
+//that a failure can be reproduced
+static uint32_t rndState = 0x2545F491;
+
+uint32_t NextRandom() {
+    rndState = rndState * 1664525 + 1013904223;
+    return (rndState >> 8);
+}
+
+int16_t GetIllumination(TestMapStruct& map, int x, int z) {
+    return map.illumination[x * TEST_MAPHEIGHT + z];
+}
+
+//every illumination value gets another color, so that any difference
+//in the averaged corner values shows up in the result
+irr::video::SColor CalcColor(int16_t illuminationValue) {
+    irr::u32 val = (irr::u32)(illuminationValue) & 0xFFFF;
+
+    return irr::video::SColor(255, val >> 8, val & 0xFF, (val * 7) & 0xFF);
+}
+
+//the game sets vertex 1 of tile (x, z), vertex 2 of tile (x - 1, z), vertex 3 of tile
+//(x - 1, z - 1) and vertex 4 of tile (x, z - 1) to the height of map entry (x, z)
+void SetEntryHeight(TestMapStruct& map, int x, int z, irr::f32 height) {
+    map.tileStore->SetVertexHeight(x, z, 1, -height);
+
+    if (x > 0)
+        map.tileStore->SetVertexHeight(x - 1, z, 2, -height);
+
+    if ((x > 0) && (z > 0))
+        map.tileStore->SetVertexHeight(x - 1, z - 1, 3, -height);
+
+    if (z > 0)
+        map.tileStore->SetVertexHeight(x, z - 1, 4, -height);
+}
+
+irr::f32 RandomHeight() {
+    return (irr::f32)(NextRandom() % 4096) / 256.0f;
+}
+
+int16_t RandomIllumination() {
+    return (int16_t)(6144 + (NextRandom() % 6657));
+}
+
+void CreateMap(TestMapStruct& map) {
+    map.tileStore = new TerrainTileStore(TEST_MAPWIDTH, TEST_MAPHEIGHT);
+    map.illumination.resize(TEST_MAPWIDTH * TEST_MAPHEIGHT);
+    map.tiles.resize(TEST_MAPWIDTH * TEST_MAPHEIGHT);
+
+    for (int x = 0; x < TEST_MAPWIDTH; x++) {
+        for (int z = 0; z < TEST_MAPHEIGHT; z++) {
+            SetEntryHeight(map, x, z, RandomHeight());
+            map.illumination[x * TEST_MAPHEIGHT + z] = RandomIllumination();
+        }
+    }
+}
+
+//normals and colors are updated for separate tile rectangles, as the normals
+//depend on more map entries than the colors
+void UpdateRegion(TestMapStruct& map, int xMin, int zMin, int xMax, int zMax,
+                  int xMinColor, int zMinColor, int xMaxColor, int zMaxColor) {
+    CalcTerrainNormalsRegion(map.tileStore, xMin, zMin, xMax, zMax,
+        [&map](int x, int z, const irr::core::vector3df& normal1, const irr::core::vector3df& normal2,
+               const irr::core::vector3df& normal3, const irr::core::vector3df& normal4) {
+            TestTileStruct& tile = map.tiles[x * TEST_MAPHEIGHT + z];
+
+            tile.normal[0] = normal1;
+            tile.normal[1] = normal2;
+            tile.normal[2] = normal3;
+            tile.normal[3] = normal4;
+        });
+
+    CalcTerrainIlluminationRegion(TEST_MAPWIDTH, TEST_MAPHEIGHT, xMinColor, zMinColor, xMaxColor, zMaxColor,
+        [&map](int x, int z) {
+            return GetIllumination(map, x, z);
+        },
+        CalcColor,
+        [&map](int x, int z, const irr::video::SColor& color1, const irr::video::SColor& color2,
+               const irr::video::SColor& color3, const irr::video::SColor& color4) {
+            TestTileStruct& tile = map.tiles[x * TEST_MAPHEIGHT + z];
+
+            tile.color[0] = color1;
+            tile.color[1] = color2;
+            tile.color[2] = color3;
+            tile.color[3] = color4;
+        });
+}
+
+void UpdateFullMap(TestMapStruct& map) {
+    UpdateRegion(map, 0, 0, TEST_MAPWIDTH - 1, TEST_MAPHEIGHT - 1, 0, 0, TEST_MAPWIDTH - 1, TEST_MAPHEIGHT - 1);
+}
+
+//illumination value of a map entry, clamped to the map
+//the same way LevelTerrain::GetMapEntry does it
+int16_t GetIlluminationClamped(TestMapStruct& map, int x, int z) {
+    if (x < 0) x = 0;
+    if (z < 0) z = 0;
+    if (x > TEST_MAPWIDTH - 1) x = TEST_MAPWIDTH - 1;
+    if (z > TEST_MAPHEIGHT - 1) z = TEST_MAPHEIGHT - 1;
+
+    return GetIllumination(map, x, z);
+}
+
+//the calculation before the region functions existed: the 4 corner normals and
+//the 4 corner illumination values (GetIlluminationValueVertice1 up to 4) of each
+//tile were calculated on their own
+void UpdateFullMapPerTile(TestMapStruct& map) {
+    for (int x = 0; x < TEST_MAPWIDTH; x++) {
+        for (int z = 0; z < TEST_MAPHEIGHT; z++) {
+            TestTileStruct& tile = map.tiles[x * TEST_MAPHEIGHT + z];
+
+            tile.normal[0] = ComputeTerrainCornerNormal(map.tileStore, x, z, 1.0f);
+            tile.normal[1] = ComputeTerrainCornerNormal(map.tileStore, x + 1, z, 1.0f);
+            tile.normal[2] = ComputeTerrainCornerNormal(map.tileStore, x + 1, z + 1, 1.0f);
+            tile.normal[3] = ComputeTerrainCornerNormal(map.tileStore, x, z + 1, 1.0f);
+
+            int16_t illumnVertex1 = (GetIlluminationClamped(map, x, z) + GetIlluminationClamped(map, x - 1, z) +
+                                     GetIlluminationClamped(map, x - 1, z - 1) + GetIlluminationClamped(map, x, z - 1)) / 4;
+            int16_t illumnVertex2 = (GetIlluminationClamped(map, x, z) + GetIlluminationClamped(map, x, z - 1) +
+                                     GetIlluminationClamped(map, x + 1, z - 1) + GetIlluminationClamped(map, x + 1, z)) / 4;
+            int16_t illumnVertex3 = (GetIlluminationClamped(map, x, z) + GetIlluminationClamped(map, x + 1, z) +
+                                     GetIlluminationClamped(map, x + 1, z + 1) + GetIlluminationClamped(map, x, z + 1)) / 4;
+            int16_t illumnVertex4 = (GetIlluminationClamped(map, x, z) + GetIlluminationClamped(map, x - 1, z) +
+                                     GetIlluminationClamped(map, x, z + 1) + GetIlluminationClamped(map, x - 1, z + 1)) / 4;
+
+            tile.color[0] = CalcColor(illumnVertex1);
+            tile.color[1] = CalcColor(illumnVertex2);
+            tile.color[2] = CalcColor(illumnVertex3);
+            tile.color[3] = CalcColor(illumnVertex4);
+        }
+    }
+}
+
+//compares the bits of the normals, and the colors of all tiles
+bool SameResults(const std::vector<TestTileStruct>& tiles, const std::vector<TestTileStruct>& otherTiles,
+                 bool printDifference = true) {
+    for (size_t idx = 0; idx < tiles.size(); idx++) {
+        for (int vert = 0; vert < 4; vert++) {
+            if ((memcmp(&tiles[idx].normal[vert], &otherTiles[idx].normal[vert], sizeof(irr::core::vector3df)) != 0) ||
+                (tiles[idx].color[vert] != otherTiles[idx].color[vert])) {
+                if (!printDifference)
+                    return false;
+
+                printf("tile x = %d, z = %d, vertex %d differs\n", (int)(idx / TEST_MAPHEIGHT), (int)(idx % TEST_MAPHEIGHT),
+                       vert + 1);
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+//returns a coordinate for the start of an edit rectangle with size
+//entries, close to the map edges in half of the cases
+int RandomEditStart(int mapSize, int size) {
+    switch (NextRandom() % 4) {
+        case 0:
+            return 0;
+        case 1:
+            return mapSize - size;
+        case 2:
+            return (int)(NextRandom() % 3);
+        default:
+            return (int)(NextRandom() % (mapSize - size + 1));
+    }
+}
+
+void TestFullMap() {
+    TestMapStruct map;
+    CreateMap(map);
+
+    UpdateFullMapPerTile(map);
+    std::vector<TestTileStruct> perTile = map.tiles;
+
+    UpdateFullMap(map);
+    TEST_CHECK(SameResults(map.tiles, perTile));
+
+    delete map.tileStore;
+}
+
+void TestRandomEdits() {
+    TestMapStruct map;
+    CreateMap(map);
+    UpdateFullMap(map);
+
+    TestMapStruct fullMap;
+    fullMap.tileStore = new TerrainTileStore(TEST_MAPWIDTH, TEST_MAPHEIGHT);
+    fullMap.tiles.resize(TEST_MAPWIDTH * TEST_MAPHEIGHT);
+
+    uint32_t nrChanged = 0;
+
+    for (uint32_t edit = 0; edit < TEST_NREDITS; edit++) {
+        //a rectangle of map entries
+        int sizeX = 1 + (int)(NextRandom() % 8);
+        int sizeZ = 1 + (int)(NextRandom() % 8);
+        int xMin = RandomEditStart(TEST_MAPWIDTH, sizeX);
+        int zMin = RandomEditStart(TEST_MAPHEIGHT, sizeZ);
+        int xMax = xMin + sizeX - 1;
+        int zMax = zMin + sizeZ - 1;
+
+        for (int x = xMin; x <= xMax; x++) {
+            for (int z = zMin; z <= zMax; z++) {
+                SetEntryHeight(map, x, z, RandomHeight());
+                map.illumination[x * TEST_MAPHEIGHT + z] = RandomIllumination();
+            }
+        }
+
+        std::vector<TestTileStruct> beforeUpdate = map.tiles;
+
+        //the corner normals x - 1 up to x + 1 depend on map entry x, and are used by the
+        //tiles x - 2 up to x + 1, as in LevelTerrain::RecalculateNormals (ApplyMorph only
+        //changes the entries xTarget + 1 and higher, and therefore starts at xTarget - 1);
+        //The corner colors x and x + 1 depend on map entry x, and are used by the tiles
+        //x - 1 up to x + 1
+        UpdateRegion(map, xMin - 2, zMin - 2, xMax + 1, zMax + 1, xMin - 1, zMin - 1, xMax + 1, zMax + 1);
+
+        //the full map update starts from scratch
+        *fullMap.tileStore = *map.tileStore;
+        fullMap.illumination = map.illumination;
+        std::fill(fullMap.tiles.begin(), fullMap.tiles.end(), TestTileStruct());
+        UpdateFullMap(fullMap);
+
+        if (!SameResults(map.tiles, fullMap.tiles)) {
+            printf("edit %u: entries x = %d - %d, z = %d - %d\n", edit, xMin, xMax, zMin, zMax);
+            TEST_CHECK(false);
+            break;
+        }
+
+        if (!SameResults(beforeUpdate, map.tiles, false)) {
+            nrChanged++;
+        }
+    }
+
+    //otherwise the test above does not
+    //tell us anything
+    TEST_CHECK(nrChanged == TEST_NREDITS);
+
+    delete fullMap.tileStore;
+    delete map.tileStore;
+}
+
+int main() {
+    TestFullMap();
+    TestRandomEdits();
+
+    return TestResult("test-terrainregion");
+}
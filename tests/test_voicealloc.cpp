@@ -0,0 +1,268 @@
+/*
+ Copyright (C) 2026 Wolf Alexander
+
+ This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.                                          */
+
+//Checks the allocation decisions of the VoiceAllocator without an audio device:
+//per category limits, the reserved voices of the critical sounds, the choice of
+//the stolen voice and that handles of stolen sounds become stale
+
+#include "../src/audio/voicealloc.h"
+#include "testutils.h"
+#include <vector>
+
+TEST_MAIN_FAILURECOUNTER
+
+//same voice and category setup as the SoundEngine
+#define TEST_NRVOICES 20
+#define TEST_NRRESERVED 2
+
+#define TEST_CAT_AMBIENT 0
+#define TEST_CAT_WEAPON 1
+#define TEST_CAT_PLAYER 2
+#define TEST_CAT_MENUE 3
+#define TEST_CAT_CRITICAL 4
+
+VoiceAllocator* CreateAllocator() {
+    VoiceAllocator* alloc = new VoiceAllocator(TEST_NRVOICES, TEST_NRRESERVED);
+
+    alloc->SetCategory(TEST_CAT_AMBIENT, 0, 3, false);
+    alloc->SetCategory(TEST_CAT_WEAPON, 1, 8, false);
+    alloc->SetCategory(TEST_CAT_PLAYER, 2, 6, false);
+    alloc->SetCategory(TEST_CAT_MENUE, 3, TEST_NRVOICES, false);
+    alloc->SetCategory(TEST_CAT_CRITICAL, 4, TEST_NRVOICES, true);
+
+    return alloc;
+}
+
+int32_t Play(VoiceAllocator* alloc, uint8_t category, float gain, bool allowSteal, bool& stolen) {
+    return alloc->Allocate(category, gain, allowSteal, stolen);
+}
+
+int32_t Play(VoiceAllocator* alloc, uint8_t category, float gain) {
+    bool stolen;
+    return alloc->Allocate(category, gain, true, stolen);
+}
+
+void TestFreeList() {
+    VoiceAllocator* alloc = CreateAllocator();
+    bool stolen;
+
+    TEST_CHECK(alloc->GetNrFreeVoices() == TEST_NRVOICES);
+
+    int32_t first = Play(alloc, TEST_CAT_MENUE, 1.0f, false, stolen);
+    int32_t second = Play(alloc, TEST_CAT_MENUE, 1.0f, false, stolen);
+
+    TEST_CHECK(first == 0);
+    TEST_CHECK(second == 1);
+    TEST_CHECK(!stolen);
+    TEST_CHECK(alloc->GetNrFreeVoices() == TEST_NRVOICES - 2);
+    TEST_CHECK(alloc->GetNrActiveVoices(TEST_CAT_MENUE) == 2);
+
+    //a released voice is the next one that is used
+    alloc->Release(first);
+    TEST_CHECK(!alloc->IsActive(first));
+    TEST_CHECK(alloc->GetNrFreeVoices() == TEST_NRVOICES - 1);
+    TEST_CHECK(Play(alloc, TEST_CAT_MENUE, 1.0f, false, stolen) == first);
+
+    //releasing twice must not corrupt the free list
+    alloc->Release(second);
+    alloc->Release(second);
+    TEST_CHECK(alloc->GetNrFreeVoices() == TEST_NRVOICES - 1);
+    TEST_CHECK(alloc->GetNrActiveVoices(TEST_CAT_MENUE) == 1);
+
+    alloc->ReleaseAll();
+    TEST_CHECK(alloc->GetNrFreeVoices() == TEST_NRVOICES);
+    TEST_CHECK(alloc->GetNrActiveVoices(TEST_CAT_MENUE) == 0);
+
+    delete alloc;
+}
+
+void TestCategoryLimit() {
+    VoiceAllocator* alloc = CreateAllocator();
+    bool stolen;
+
+    int32_t loud1 = Play(alloc, TEST_CAT_AMBIENT, 0.5f);
+    int32_t quiet = Play(alloc, TEST_CAT_AMBIENT, 0.3f);
+    int32_t loud2 = Play(alloc, TEST_CAT_AMBIENT, 0.5f);
+
+    TEST_CHECK((loud1 != VOICEALLOC_NOVOICE) && (quiet != VOICEALLOC_NOVOICE) && (loud2 != VOICEALLOC_NOVOICE));
+    TEST_CHECK(alloc->GetNrActiveVoices(TEST_CAT_AMBIENT) == 3);
+
+    //the category is full, even though there are free voices
+    TEST_CHECK(Play(alloc, TEST_CAT_AMBIENT, 1.0f, false, stolen) == VOICEALLOC_NOVOICE);
+
+    //a more quiet sound of the same category does not steal
+    TEST_CHECK(Play(alloc, TEST_CAT_AMBIENT, 0.2f, true, stolen) == VOICEALLOC_NOVOICE);
+    TEST_CHECK(!stolen);
+    TEST_CHECK(alloc->GetNrDropped() == 1);
+
+    //a louder one replaces the most quiet sound of the category
+    TEST_CHECK(Play(alloc, TEST_CAT_AMBIENT, 0.4f, true, stolen) == quiet);
+    TEST_CHECK(stolen);
+    TEST_CHECK(alloc->GetNrStolen() == 1);
+    TEST_CHECK(alloc->GetNrActiveVoices(TEST_CAT_AMBIENT) == 3);
+
+    //other categories are not affected by the limit
+    TEST_CHECK(Play(alloc, TEST_CAT_WEAPON, 0.1f, false, stolen) != VOICEALLOC_NOVOICE);
+
+    delete alloc;
+}
+
+void TestReservedVoices() {
+    VoiceAllocator* alloc = CreateAllocator();
+    bool stolen;
+    std::vector<int32_t> menueVoices;
+
+    //all voices except the reserved ones
+    for (uint32_t idx = 0; idx < TEST_NRVOICES - TEST_NRRESERVED; idx++) {
+        menueVoices.push_back(Play(alloc, TEST_CAT_MENUE, 1.0f, false, stolen));
+        TEST_CHECK(menueVoices.back() != VOICEALLOC_NOVOICE);
+    }
+
+    //the reserved voices are not available for other categories
+    TEST_CHECK(alloc->GetNrFreeVoices() == TEST_NRRESERVED);
+    TEST_CHECK(Play(alloc, TEST_CAT_MENUE, 1.0f, false, stolen) == VOICEALLOC_NOVOICE);
+
+    //but the critical sounds get them without stealing
+    for (uint32_t idx = 0; idx < TEST_NRRESERVED; idx++) {
+        TEST_CHECK(Play(alloc, TEST_CAT_CRITICAL, 1.0f, true, stolen) != VOICEALLOC_NOVOICE);
+        TEST_CHECK(!stolen);
+    }
+
+    TEST_CHECK(alloc->GetNrFreeVoices() == 0);
+
+    //all voices are used now, a critical sound steals the
+    //oldest sound of the lower priority, and is never dropped
+    int32_t voice = Play(alloc, TEST_CAT_CRITICAL, 1.0f, true, stolen);
+    TEST_CHECK(stolen);
+    TEST_CHECK(voice == menueVoices.at(0));
+    TEST_CHECK(alloc->GetNrActiveVoices(TEST_CAT_CRITICAL) == TEST_NRRESERVED + 1);
+    TEST_CHECK(alloc->GetNrActiveVoices(TEST_CAT_MENUE) == TEST_NRVOICES - TEST_NRRESERVED - 1);
+
+    //even a critical sound that is far away
+    voice = Play(alloc, TEST_CAT_CRITICAL, 0.0f, true, stolen);
+    TEST_CHECK(stolen);
+    TEST_CHECK(voice == menueVoices.at(1));
+
+    //a menue sound can not steal a critical one
+    TEST_CHECK(alloc->GetNrActiveVoices(TEST_CAT_MENUE) == TEST_NRVOICES - TEST_NRRESERVED - 2);
+    for (uint32_t idx = 0; idx < TEST_NRVOICES; idx++) {
+        voice = Play(alloc, TEST_CAT_MENUE, 1.0f, true, stolen);
+    }
+    TEST_CHECK(alloc->GetNrActiveVoices(TEST_CAT_CRITICAL) == TEST_NRRESERVED + 2);
+
+    delete alloc;
+}
+
+void TestVictimChoice() {
+    VoiceAllocator* alloc = CreateAllocator();
+    bool stolen;
+
+    //use all not reserved voices
+    int32_t ambient = Play(alloc, TEST_CAT_AMBIENT, 0.9f);
+    Play(alloc, TEST_CAT_AMBIENT, 0.9f);
+    Play(alloc, TEST_CAT_AMBIENT, 0.9f);
+
+    std::vector<int32_t> weaponVoices;
+    for (uint32_t idx = 0; idx < 7; idx++) {
+        weaponVoices.push_back(Play(alloc, TEST_CAT_WEAPON, (idx == 3) ? 0.2f : 0.5f));
+    }
+
+    for (uint32_t idx = 0; idx < 6; idx++) {
+        Play(alloc, TEST_CAT_PLAYER, 0.1f);
+    }
+
+    Play(alloc, TEST_CAT_MENUE, 1.0f);
+    Play(alloc, TEST_CAT_MENUE, 1.0f);
+
+    TEST_CHECK(alloc->GetNrFreeVoices() == TEST_NRRESERVED);
+
+    //the lowest priority is stolen first, even if it is louder,
+    //and with the same gain the oldest voice
+    TEST_CHECK(Play(alloc, TEST_CAT_WEAPON, 0.5f, true, stolen) == ambient);
+    TEST_CHECK(stolen);
+    TEST_CHECK(alloc->GetNrActiveVoices(TEST_CAT_AMBIENT) == 2);
+    TEST_CHECK(alloc->GetNrActiveVoices(TEST_CAT_WEAPON) == 8);
+
+    //the weapon category is full now, a new weapon sound
+    //replaces the most quiet weapon sound
+    TEST_CHECK(Play(alloc, TEST_CAT_WEAPON, 0.5f, true, stolen) == weaponVoices.at(3));
+    TEST_CHECK(stolen);
+
+    //a sound of lower priority can not steal from a higher priority, the
+    //remaining ambient voices have a higher gain than the new one
+    TEST_CHECK(Play(alloc, TEST_CAT_AMBIENT, 0.5f, true, stolen) == VOICEALLOC_NOVOICE);
+
+    //the player category is full, a more quiet player sound is dropped
+    TEST_CHECK(Play(alloc, TEST_CAT_PLAYER, 0.05f, true, stolen) == VOICEALLOC_NOVOICE);
+
+    //with a higher limit a player sound steals the remaining
+    //ambient voices first, and then the voices of the weapons
+    alloc->SetCategory(TEST_CAT_PLAYER, 2, 10, false);
+    Play(alloc, TEST_CAT_PLAYER, 0.1f, true, stolen);
+    Play(alloc, TEST_CAT_PLAYER, 0.1f, true, stolen);
+    TEST_CHECK(alloc->GetNrActiveVoices(TEST_CAT_AMBIENT) == 0);
+    TEST_CHECK(Play(alloc, TEST_CAT_PLAYER, 0.1f, true, stolen) == weaponVoices.at(0));
+
+    delete alloc;
+}
+
+void TestHandles() {
+    VoiceAllocator* alloc = new VoiceAllocator(2, 0);
+    alloc->SetCategory(TEST_CAT_WEAPON, 1, 2, false);
+    bool stolen;
+
+    //a handle that was never assigned is always stale
+    VoiceHandleStruct noSound;
+    TEST_CHECK(!alloc->IsCurrent(noSound));
+
+    int32_t voice1 = Play(alloc, TEST_CAT_WEAPON, 0.5f, true, stolen);
+    VoiceHandleStruct handle1 = alloc->GetHandle(voice1);
+    int32_t voice2 = Play(alloc, TEST_CAT_WEAPON, 0.6f, true, stolen);
+    VoiceHandleStruct handle2 = alloc->GetHandle(voice2);
+
+    TEST_CHECK(alloc->IsCurrent(handle1));
+    TEST_CHECK(alloc->IsCurrent(handle2));
+
+    //the first sound is stolen, its owner must
+    //notice this through the handle
+    int32_t voice3 = Play(alloc, TEST_CAT_WEAPON, 0.7f, true, stolen);
+    VoiceHandleStruct handle3 = alloc->GetHandle(voice3);
+
+    TEST_CHECK(stolen);
+    TEST_CHECK(voice3 == voice1);
+    TEST_CHECK(!alloc->IsCurrent(handle1));
+    TEST_CHECK(alloc->IsCurrent(handle3));
+    TEST_CHECK(alloc->IsCurrent(handle2));
+
+    //released voices, and voices that are
+    //reused later, do not match either
+    alloc->Release(voice2);
+    TEST_CHECK(!alloc->IsCurrent(handle2));
+
+    int32_t voice4 = Play(alloc, TEST_CAT_WEAPON, 0.1f, true, stolen);
+    TEST_CHECK(!stolen);
+    TEST_CHECK(voice4 == voice2);
+    TEST_CHECK(!alloc->IsCurrent(handle2));
+    TEST_CHECK(alloc->IsCurrent(alloc->GetHandle(voice4)));
+
+    alloc->ReleaseAll();
+    TEST_CHECK(!alloc->IsCurrent(handle3));
+
+    delete alloc;
+}
+
+int main() {
+    TestFreeList();
+    TestCategoryLimit();
+    TestReservedVoices();
+    TestVictimChoice();
+    TestHandles();
+
+    return TestResult("test-voicealloc");
+}
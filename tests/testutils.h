@@ -0,0 +1,44 @@
+/*
+ Copyright (C) 2026 Wolf Alexander
+
+ This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 3.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.                                          */
+
+#ifndef TESTUTILS_H
+#define TESTUTILS_H
+
+#include <cstdio>
+
+//Minimal helpers for the test programs: Every test is a small executable that is run by ctest,
+//failed checks are printed with file and line, and main returns the number of failed checks
+
+extern int testNrFailed;
+
+#define TEST_CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            testNrFailed++; \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+        } \
+    } while (0)
+
+//defines the failure counter, use once in
+//every test program
+#define TEST_MAIN_FAILURECOUNTER int testNrFailed = 0;
+
+//prints the result of the test program, returns
+//the exit code for main
+inline int TestResult(const char* testName) {
+    if (testNrFailed == 0) {
+        printf("%s: all checks passed\n", testName);
+        return 0;
+    }
+
+    printf("%s: %d check(s) failed\n", testName, testNrFailed);
+    return 1;
+}
+
+#endif // TESTUTILS_H